@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "common/mm/arena.h"
+
+namespace common {
+
+static thread_local Arena *current_arena = nullptr;
+
+Arena::Arena(size_t limit, size_t block_size) : limit_(limit), block_size_(block_size) {
+}
+
+Arena::~Arena() {
+  reset();
+}
+
+void *Arena::alloc_block(size_t size) {
+  char *data = (char *)malloc(size);
+  if (data == nullptr) {
+    throw std::bad_alloc();
+  }
+  blocks_.push_back(Block{data, size});
+  reserved_ += size;
+  return data;
+}
+
+void *Arena::alloc(size_t size, size_t align) {
+  alloc_count_++;
+  used_ += size;
+
+  uintptr_t aligned = ((uintptr_t)pos_ + align - 1) & ~(uintptr_t)(align - 1);
+  if (pos_ != nullptr && aligned + size <= (uintptr_t)end_) {
+    pos_ = (char *)(aligned + size);
+    return (void *)aligned;
+  }
+
+  // 大的分配单独占一个块，不影响当前块中剩余的空间
+  if (size + align > block_size_ / 4) {
+    return (void *)(((uintptr_t)alloc_block(size + align) + align - 1) & ~(uintptr_t)(align - 1));
+  }
+
+  char *data = (char *)alloc_block(block_size_);
+  aligned = ((uintptr_t)data + align - 1) & ~(uintptr_t)(align - 1);
+  pos_ = (char *)(aligned + size);
+  end_ = data + block_size_;
+  return (void *)aligned;
+}
+
+char *Arena::strdup(const char *s) {
+  const size_t len = strlen(s) + 1;
+  char *p = (char *)alloc(len, 1);
+  memcpy(p, s, len);
+  return p;
+}
+
+int Arena::size_class(size_t size) {
+  int index = 0;
+  while (((size_t)1 << (index + MIN_CLASS_SHIFT)) < size) {
+    index++;
+  }
+  return index;
+}
+
+void *Arena::alloc_reusable(size_t size) {
+  const int index = size_class(size);
+  if (index >= CLASS_NUM) {
+    return alloc(size);
+  }
+  void *p = free_lists_[index];
+  if (p != nullptr) {
+    alloc_count_++;
+    free_lists_[index] = *(void **)p;
+    return p;
+  }
+  return alloc((size_t)1 << (index + MIN_CLASS_SHIFT));
+}
+
+void Arena::free_reusable(void *p, size_t size) {
+  const int index = size_class(size);
+  if (p == nullptr || index >= CLASS_NUM) {
+    return;
+  }
+  *(void **)p = free_lists_[index];
+  free_lists_[index] = p;
+}
+
+void Arena::reset() {
+  for (Block &block : blocks_) {
+    free(block.data);
+  }
+  blocks_.clear();
+  pos_ = end_ = nullptr;
+  for (void *&free_list : free_lists_) {
+    free_list = nullptr;
+  }
+  used_ = 0;
+  reserved_ = 0;
+  alloc_count_ = 0;
+}
+
+Arena *Arena::current() {
+  return current_arena;
+}
+
+ArenaGuard::ArenaGuard(Arena *arena) : prev_(current_arena) {
+  current_arena = arena;
+}
+
+ArenaGuard::~ArenaGuard() {
+  current_arena = prev_;
+}
+
+}  // namespace common
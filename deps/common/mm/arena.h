@@ -0,0 +1,187 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __COMMON_MM_ARENA_H__
+#define __COMMON_MM_ARENA_H__
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace common {
+
+/**
+ * 按块分配的内存区域。分配只是在当前块中移动指针，单独的释放不做任何事情，
+ * 所有内存在reset或者析构时一次释放。
+ * 用于生命周期与一次请求相同的内存，比如一条SQL解析出来的字符串和执行过程中产生的元组。
+ * 不是线程安全的，一个Arena同时只能被一个线程使用
+ */
+class Arena {
+public:
+  static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  /**
+   * @param limit 内存上限，0表示不限制。超过上限之后仍然可以分配，只是exceeded()返回true，
+   *              由使用者在合适的时机检查并终止请求
+   */
+  explicit Arena(size_t limit = 0, size_t block_size = DEFAULT_BLOCK_SIZE);
+  ~Arena();
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void *alloc(size_t size, size_t align = alignof(max_align_t));
+  char *strdup(const char *s);
+
+  /**
+   * 可以回收的分配，给容器使用。释放的内存按大小分级放到空闲链表中，之后相同级别的分配可以复用，
+   * 这样逐行创建和销毁的元组不会让使用的内存随扫描的行数一直增长。
+   * 超过最大级别的分配释放后不复用，仍然在reset时释放
+   */
+  void *alloc_reusable(size_t size);
+  void free_reusable(void *p, size_t size);
+
+  /**
+   * 释放所有分配的内存，统计信息清零
+   */
+  void reset();
+
+  void set_limit(size_t limit) {
+    limit_ = limit;
+  }
+  size_t limit() const {
+    return limit_;
+  }
+  bool exceeded() const {
+    return limit_ != 0 && used_ > limit_;
+  }
+
+  size_t used() const {       /// 分配出去的字节数，复用的内存不重复计算
+    return used_;
+  }
+  size_t reserved() const {   /// 向系统申请的字节数
+    return reserved_;
+  }
+  size_t alloc_count() const {
+    return alloc_count_;
+  }
+
+  /**
+   * 当前线程正在使用的Arena，没有时返回nullptr
+   */
+  static Arena *current();
+
+private:
+  void *alloc_block(size_t size);
+  static int size_class(size_t size);
+
+private:
+  static const int MIN_CLASS_SHIFT = 4;  // 最小的级别16字节，放得下空闲链表的指针
+  static const int CLASS_NUM = 11;       // 最大的级别16KB
+
+private:
+  struct Block {
+    char *data;
+    size_t size;
+  };
+
+  size_t limit_;
+  size_t block_size_;
+  std::vector<Block> blocks_;
+  char *pos_ = nullptr;
+  char *end_ = nullptr;
+  size_t used_ = 0;
+  size_t reserved_ = 0;
+  size_t alloc_count_ = 0;
+  void *free_lists_[CLASS_NUM] = {nullptr};
+};
+
+/**
+ * 在作用域内把一个Arena设置为当前线程的Arena，退出作用域时恢复原来的Arena
+ */
+class ArenaGuard {
+public:
+  explicit ArenaGuard(Arena *arena);
+  ~ArenaGuard();
+
+  ArenaGuard(const ArenaGuard &) = delete;
+  ArenaGuard &operator=(const ArenaGuard &) = delete;
+
+private:
+  Arena *prev_;
+};
+
+/**
+ * STL容器使用的分配器。构造时记下当前线程的Arena，从中分配内存；
+ * 没有Arena时使用malloc。同一个容器中的内存总是由同一个分配器释放。
+ * 复制赋值时保留自己的分配器，不会让一个长期存在的容器引用请求的Arena
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() : arena_(Arena::current()) {
+  }
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {
+  }
+
+  /**
+   * 复制容器时使用当前线程的Arena，而不是原来容器的
+   */
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  T *allocate(size_t n) {
+    if (arena_ != nullptr) {
+      return (T *)arena_->alloc_reusable(n * sizeof(T));
+    }
+    T *p = (T *)malloc(n * sizeof(T));
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (arena_ == nullptr) {
+      free(p);
+    } else {
+      arena_->free_reusable(p, n * sizeof(T));
+    }
+  }
+
+  Arena *arena() const {
+    return arena_;
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return arena_ == other.arena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  Arena *arena_;
+};
+
+}  // namespace common
+
+#endif  // __COMMON_MM_ARENA_H__
@@ -0,0 +1,25 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_EVENT_ANALYZE_EVENT_H__
+#define __OBSERVER_EVENT_ANALYZE_EVENT_H__
+
+#include "common/seda/stage_event.h"
+
+/**
+ * 后台更新过期统计信息的定时事件。由DefaultStorageStage通过TimerStage周期性地触发
+ */
+class AnalyzeEvent : public common::StageEvent {
+public:
+  AnalyzeEvent() = default;
+  virtual ~AnalyzeEvent() = default;
+};
+
+#endif // __OBSERVER_EVENT_ANALYZE_EVENT_H__
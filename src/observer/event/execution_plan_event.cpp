@@ -17,13 +17,19 @@ See the Mulan PSL v2 for more details. */
 
 ExecutionPlanEvent::ExecutionPlanEvent(SQLStageEvent *sql_event, Query *sqls) : sql_event_(sql_event), sqls_(sqls) {
 }
+ExecutionPlanEvent::ExecutionPlanEvent(SQLStageEvent *sql_event, Query *sqls, CachedPlan *cached_plan)
+    : sql_event_(sql_event), sqls_(sqls), cached_plan_(cached_plan) {
+}
 ExecutionPlanEvent::~ExecutionPlanEvent() {
   sql_event_ = nullptr;
   // if (sql_event_) {
   //   sql_event_->doneImmediate();
   // }
 
-  query_destroy(sqls_);
+  if (cached_plan_ == nullptr) {
+    query_destroy(sqls_);
+  }
   sqls_ = nullptr;
+  cached_plan_ = nullptr;
 }
 
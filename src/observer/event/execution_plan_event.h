@@ -17,12 +17,18 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/seda/stage_event.h"
 #include "sql/parser/parse.h"
+#include "sql/optimizer/join_planner.h"
 
 class SQLStageEvent;
+class CachedPlan;
 
 class ExecutionPlanEvent : public common::StageEvent {
 public:
   ExecutionPlanEvent(SQLStageEvent *sql_event, Query *sqls);
+  /**
+   * 执行缓存中的计划。sqls和cached_plan由调用者持有，在事件处理完之前保持有效
+   */
+  ExecutionPlanEvent(SQLStageEvent *sql_event, Query *sqls, CachedPlan *cached_plan);
   virtual ~ExecutionPlanEvent();
 
   Query * sqls() const {
@@ -32,9 +38,29 @@ public:
   SQLStageEvent * sql_event() const {
     return sql_event_;
   }
+
+  /**
+   * 语句来自计划缓存时是缓存中的计划，否则是nullptr
+   */
+  CachedPlan * cached_plan() const {
+    return cached_plan_;
+  }
+
+  /**
+   * 优化阶段为多表查询选择的连接顺序和连接方法，没有时返回nullptr
+   */
+  const JoinPlan * join_plan() const {
+    return join_plan_.steps.empty() ? nullptr : &join_plan_;
+  }
+
+  void set_join_plan(JoinPlan &&join_plan) {
+    join_plan_ = std::move(join_plan);
+  }
 private:
   SQLStageEvent *      sql_event_;
   Query *             sqls_;
+  JoinPlan            join_plan_;
+  CachedPlan *        cached_plan_ = nullptr;
 };
 
 #endif // __OBSERVER_EVENT_EXECUTION_PLAN_EVENT_H__
\ No newline at end of file
@@ -13,8 +13,14 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "session_event.h"
+#include "net/server.h"
 
-SessionEvent::SessionEvent(ConnectionContext *client) : client_(client) {
+static int send_to_client(void *context, const char *data, int len) {
+  return Server::send((ConnectionContext *)context, data, len);
+}
+
+SessionEvent::SessionEvent(ConnectionContext *client)
+    : client_(client), output_buffer_(send_to_client, client), response_stream_(&output_buffer_) {
 }
 
 SessionEvent::~SessionEvent() {
@@ -41,6 +47,20 @@ void SessionEvent::set_response(std::string &&response) {
 
 int SessionEvent::get_response_len() const { return response_.size(); }
 
+bool SessionEvent::copy_response(std::string &response) const {
+  const OutputBuffer &output = output_buffer_;
+  if (output.written_bytes() == 0) {
+    response = response_;
+    return true;
+  }
+  // 缓冲区中还有没有发送的数据时，副本不完整
+  if (!output.captured() || output.failed() || (int64_t)output.captured_data().size() != output.written_bytes()) {
+    return false;
+  }
+  response = output.captured_data() + response_;
+  return true;
+}
+
 char *SessionEvent::get_request_buf() { return client_->buf; }
 
 int SessionEvent::get_request_buf_len() { return SOCKET_BUFFER_SIZE; }
\ No newline at end of file
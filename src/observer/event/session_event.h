@@ -16,10 +16,14 @@ See the Mulan PSL v2 for more details. */
 #define __OBSERVER_SESSION_SESSIONEVENT_H__
 
 #include <string.h>
+#include <ostream>
 #include <string>
 
+#include "sql/query_cache/query_cache.h"
 #include "common/seda/stage_event.h"
+#include "common/mm/arena.h"
 #include "net/connection_context.h"
+#include "net/output_buffer.h"
 
 class SessionEvent : public common::StageEvent {
 public:
@@ -33,13 +37,57 @@ public:
   void set_response(const char *response, int len);
   void set_response(std::string &&response);
   int get_response_len() const;
+
+  /**
+   * 直接发送给客户端的输出流，用于输出很大的查询结果。写满固定大小的缓冲区就发送一次，
+   * 剩余的数据在请求结束时先于response发送
+   */
+  std::ostream &response_stream() {
+    return response_stream_;
+  }
+  OutputBuffer &output_buffer() {
+    return output_buffer_;
+  }
+
+  /**
+   * 本次请求返回给客户端的完整数据，包括response_stream输出的和response。
+   * response_stream输出的数据超过output_buffer().capture的限制时返回false
+   */
+  bool copy_response(std::string &response) const;
+
   char *get_request_buf();
   int get_request_buf_len();
 
+  /**
+   * 这条SQL使用的内存区域，解析出来的字符串和执行过程中的元组都从这里分配，请求结束时一起释放
+   */
+  common::Arena &query_arena() {
+    return query_arena_;
+  }
+
+  /**
+   * 执行阶段在查询结果可以缓存时设置查询涉及的表和它们的数据版本
+   */
+  void set_result_tables(TableVersions &&tables) {
+    result_tables_ = std::move(tables);
+    result_cacheable_ = true;
+  }
+  bool result_cacheable() const {
+    return result_cacheable_;
+  }
+  TableVersions &result_tables() {
+    return result_tables_;
+  }
+
 private:
   ConnectionContext *client_;
+  common::Arena query_arena_;
 
   std::string response_;
+  OutputBuffer output_buffer_;
+  std::ostream response_stream_;
+  bool result_cacheable_ = false;
+  TableVersions result_tables_;
 };
 
 #endif //__OBSERVER_SESSION_SESSIONEVENT_H__
@@ -26,6 +26,7 @@ typedef struct _ConnectionContext {
   struct event read_event;
   pthread_mutex_t mutex;
   char addr[24];
+  bool send_failed;                   /// 发送失败，当前的SQL执行完成之后关闭连接
   char buf[SOCKET_BUFFER_SIZE];
 } ConnectionContext;
 
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "net/output_buffer.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "common/log/log.h"
+
+OutputBuffer::OutputBuffer(Sender sender, void *context, int capacity)
+    : sender_(sender), context_(context), capacity_(capacity) {
+}
+
+RC OutputBuffer::flush() {
+  if (failed_) {
+    return RC::IOERR_WRITE;
+  }
+  if (pbase() == pptr()) {
+    return RC::SUCCESS;
+  }
+  RC rc = send(pbase(), (int)(pptr() - pbase()));
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+  return rc;
+}
+
+bool OutputBuffer::discard() {
+  if (sent_bytes_ > 0 || failed_) {
+    return false;
+  }
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+  return true;
+}
+
+void OutputBuffer::capture(size_t limit) {
+  capture_limit_ = limit;
+  capture_overflow_ = false;
+  captured_data_.clear();
+}
+
+int64_t OutputBuffer::written_bytes() const {
+  return sent_bytes_ + (pptr() - pbase());
+}
+
+RC OutputBuffer::send(const char *data, int len) {
+  if (capture_limit_ > 0 && !capture_overflow_) {
+    if (captured_data_.size() + len > capture_limit_) {
+      capture_overflow_ = true;
+      std::string().swap(captured_data_);
+    } else {
+      captured_data_.append(data, len);
+    }
+  }
+
+  if (sender_(context_, data, len) != 0) {
+    LOG_WARN("Failed to send %d bytes to client", len);
+    failed_ = true;
+    return RC::IOERR_WRITE;
+  }
+  sent_bytes_ += len;
+  return RC::SUCCESS;
+}
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch) {
+  if (failed_) {
+    return traits_type::eof();
+  }
+  if (buffer_.empty()) {
+    buffer_.resize(capacity_);
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  } else if (flush() != RC::SUCCESS) {
+    return traits_type::eof();
+  }
+
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return traits_type::not_eof(ch);
+  }
+  *pptr() = traits_type::to_char_type(ch);
+  pbump(1);
+  return ch;
+}
+
+std::streamsize OutputBuffer::xsputn(const char *data, std::streamsize len) {
+  std::streamsize written = 0;
+  while (written < len) {
+    if (pptr() == epptr() && traits_type::eq_int_type(overflow(traits_type::eof()), traits_type::eof())) {
+      break;
+    }
+    const std::streamsize n = std::min(len - written, (std::streamsize)(epptr() - pptr()));
+    memcpy(pptr(), data + written, n);
+    pbump((int)n);
+    written += n;
+  }
+  return written;
+}
@@ -0,0 +1,93 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_NET_OUTPUT_BUFFER_H__
+#define __OBSERVER_NET_OUTPUT_BUFFER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "rc.h"
+
+/**
+ * 发送给客户端的输出缓冲区。写入的数据先放在固定大小的缓冲区中，满了就交给sender发送，
+ * 很大的查询结果不需要全部放在内存里，客户端也能尽早收到前面的数据。
+ * 缓冲区在第一次写入时才分配
+ */
+class OutputBuffer : public std::streambuf {
+public:
+  static const int DEFAULT_CAPACITY = 64 * 1024;
+
+  /**
+   * 发送数据，成功返回0。发送失败之后不会再调用
+   */
+  typedef int (*Sender)(void *context, const char *data, int len);
+
+  OutputBuffer(Sender sender, void *context, int capacity = DEFAULT_CAPACITY);
+  ~OutputBuffer() override = default;
+
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+  /**
+   * 发送缓冲区中剩余的数据
+   */
+  RC flush();
+
+  /**
+   * 丢弃缓冲区中还没有发送的数据，用于执行出错时改为返回错误信息。
+   * 已经有数据发送给客户端时无法撤回，返回false
+   */
+  bool discard();
+
+  /**
+   * 之后发送的数据同时保存一份副本，总大小超过limit时丢弃副本
+   */
+  void capture(size_t limit);
+  bool captured() const {
+    return capture_limit_ > 0 && !capture_overflow_;
+  }
+  const std::string &captured_data() const {
+    return captured_data_;
+  }
+
+  /**
+   * 写入的总字节数，包括还在缓冲区中没有发送的
+   */
+  int64_t written_bytes() const;
+  bool failed() const {
+    return failed_;
+  }
+
+protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char *data, std::streamsize len) override;
+
+private:
+  RC send(const char *data, int len);
+
+private:
+  Sender sender_;
+  void *context_;
+  int capacity_;
+  std::vector<char> buffer_;
+
+  int64_t sent_bytes_ = 0;
+  bool failed_ = false;
+
+  size_t capture_limit_ = 0;
+  bool capture_overflow_ = false;
+  std::string captured_data_;
+};
+
+#endif // __OBSERVER_NET_OUTPUT_BUFFER_H__
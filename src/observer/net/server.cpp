@@ -19,6 +19,7 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +39,8 @@ See the Mulan PSL v2 for more details. */
 using namespace common;
 static const std::string READ_SOCKET_METRIC_TAG = "SessionStage.readsocket";
 static const std::string WRITE_SOCKET_METRIC_TAG = "SessionStage.writesocket";
+// 发送缓冲区满时每次最多等待客户端接收的时间，超时就放弃这条SQL的结果
+static const int SEND_TIMEOUT_MS = 1000;
 
 Stage *Server::session_stage_ = nullptr;
 common::SimpleTimer *Server::read_socket_metric_ = nullptr;
@@ -172,32 +175,53 @@ void Server::recv(int fd, short ev, void *arg) {
   session_stage_->add_event(sev);
 }
 
-// 这个函数仅负责发送数据，至于是否是一个完整的消息，由调用者控制
+// 这个函数仅负责发送数据，至于是否是一个完整的消息，由调用者控制。
+// 发送失败时只标记连接，SQL还在执行，会话还在使用，由SessionStage在这条SQL执行完成之后关闭连接
 int Server::send(ConnectionContext *client, const char *buf, int data_len) {
   if (buf == nullptr || data_len == 0) {
     return 0;
   }
+  if (client->send_failed) {
+    return -STATUS_FAILED_NETWORK;
+  }
 
   TimerStat writeStat(*write_socket_metric_);
 
-  MUTEX_LOCK(&client->mutex);
+  // socket是非阻塞的，大的查询结果会分多次发送，发送缓冲区满的时候等待客户端接收。
+  // 等待时不持有连接的锁，每次最多等待SEND_TIMEOUT_MS，客户端不接收数据时不会一直占用执行线程
   int wlen = 0;
-  for (int i = 0; i < 3 && wlen < data_len; i++) {
+  while (wlen < data_len) {
+    MUTEX_LOCK(&client->mutex);
     int len = write(client->fd, buf + wlen, data_len - wlen);
-    if (len < 0) {
-      LOG_ERROR("Failed to send data back to client\n");
-      MUTEX_UNLOCK(&client->mutex);
+    const int write_errno = errno;
+    MUTEX_UNLOCK(&client->mutex);
+    if (len > 0) {
+      wlen += len;
+      continue;
+    }
+    if (len < 0 && write_errno == EINTR) {
+      continue;
+    }
 
-      close_connection(client);
-      return -STATUS_FAILED_NETWORK;
+    if (len < 0 && (write_errno == EAGAIN || write_errno == EWOULDBLOCK)) {
+      struct pollfd poll_fd;
+      poll_fd.fd = client->fd;
+      poll_fd.events = POLLOUT;
+      poll_fd.revents = 0;
+      int ret = 0;
+      do {
+        ret = poll(&poll_fd, 1, SEND_TIMEOUT_MS);
+      } while (ret < 0 && errno == EINTR);
+      if (ret > 0) {
+        continue;
+      }
+      LOG_ERROR("Timeout to send data back to client %s\n", client->addr);
+    } else {
+      LOG_ERROR("Failed to send data back to client %s, %s\n", client->addr, strerror(write_errno));
     }
-    wlen += len;
-  }
-  if (wlen < data_len) {
-    LOG_WARN("Not all data has been send back to client");
+    client->send_failed = true;
+    return -STATUS_FAILED_NETWORK;
   }
-
-  MUTEX_UNLOCK(&client->mutex);
   return 0;
 }
 
@@ -29,6 +29,8 @@ public:
 public:
   static void init();
   static int send(ConnectionContext *client, const char *buf, int data_len);
+  // close connection
+  static void close_connection(ConnectionContext *client_context);
 
 public:
   int serve();
@@ -36,8 +38,6 @@ public:
 
 private:
   static void accept(int fd, short ev, void *arg);
-  // close connection
-  static void close_connection(ConnectionContext *client_context);
   static void recv(int fd, short ev, void *arg);
 
 private:
@@ -12,7 +12,11 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2021/5/12.
 //
 
+#include <string.h>
+#include <strings.h>
+
 #include "session/session.h"
+#include "common/log/log.h"
 #include "storage/trx/trx.h"
 
 Session &Session::default_session() {
@@ -49,3 +53,39 @@ Trx *Session::current_trx() {
   }
   return trx_;
 }
+
+PreparedStatement *Session::find_prepared_statement(const std::string &name) {
+  auto iter = prepared_statements_.find(name);
+  return iter == prepared_statements_.end() ? nullptr : &iter->second;
+}
+
+void Session::set_prepared_statement(const std::string &name, PreparedStatement &&statement) {
+  prepared_statements_[name] = std::move(statement);
+}
+
+bool Session::remove_prepared_statement(const std::string &name) {
+  return prepared_statements_.erase(name) > 0;
+}
+
+static bool parse_switch(const char *value, bool &on) {
+  if (strcasecmp(value, "on") == 0 || strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+    on = true;
+  } else if (strcasecmp(value, "off") == 0 || strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+    on = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+RC Session::set_variable(const char *name, const char *value) {
+  if (strcasecmp(name, "query_cache") == 0) {
+    if (!parse_switch(value, query_cache_enabled_)) {
+      LOG_WARN("Invalid value of %s: %s", name, value);
+      return RC::INVALID_ARGUMENT;
+    }
+    return RC::SUCCESS;
+  }
+  LOG_WARN("No such variable: %s", name);
+  return RC::INVALID_ARGUMENT;
+}
@@ -15,8 +15,12 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_SESSION_SESSION_H__
 #define __OBSERVER_SESSION_SESSION_H__
 
+#include <map>
 #include <string>
 
+#include "rc.h"
+#include "sql/plan_cache/plan_cache.h"
+
 class Trx;
 
 class Session {
@@ -39,10 +43,36 @@ public:
 
   Trx * current_trx();
 
+  /**
+   * 会话自己的计划缓存，先于全局的计划缓存查找，不与其它会话竞争锁
+   */
+  PlanCache &plan_cache() {
+    return plan_cache_;
+  }
+
+  PreparedStatement *find_prepared_statement(const std::string &name);
+  void set_prepared_statement(const std::string &name, PreparedStatement &&statement);
+  bool remove_prepared_statement(const std::string &name);
+
+  /**
+   * set name = value设置的会话变量，目前只有query_cache(on/off)
+   */
+  RC set_variable(const char *name, const char *value);
+
+  bool query_cache_enabled() const {
+    return query_cache_enabled_;
+  }
+
+public:
+  static const size_t PLAN_CACHE_CAPACITY = 64;
+
 private:
   std::string  current_db_;
   Trx         *trx_ = nullptr;
   bool         trx_multi_operation_mode_ = false; // 当前事务的模式，是否多语句模式. 单语句模式自动提交
+  PlanCache    plan_cache_{PLAN_CACHE_CAPACITY};
+  std::map<std::string, PreparedStatement> prepared_statements_;
+  bool         query_cache_enabled_ = true;
 };
 
 #endif // __OBSERVER_SESSION_SESSION_H__
\ No newline at end of file
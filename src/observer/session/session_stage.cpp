@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/mutex.h"
 #include "common/metrics/metrics_registry.h"
+#include "common/mm/arena.h"
 #include "common/seda/callback.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
@@ -32,6 +33,7 @@ See the Mulan PSL v2 for more details. */
 using namespace common;
 
 const std::string SessionStage::SQL_METRIC_TAG = "SessionStage.sql";
+const char * CONF_QUERY_MEMORY_LIMIT = "QueryMemoryLimit";
 
 // Constructor
 SessionStage::SessionStage(const char *tag)
@@ -53,14 +55,15 @@ Stage *SessionStage::make_stage(const std::string &tag) {
 
 // Set properties for this object set in stage specific properties
 bool SessionStage::set_properties() {
-  //  std::string stageNameStr(stage_name_);
-  //  std::map<std::string, std::string> section = g_properties()->get(
-  //    stageNameStr);
-  //
-  //  std::map<std::string, std::string>::iterator it;
-  //
-  //  std::string key;
-
+  std::string stageNameStr(stage_name_);
+  std::map<std::string, std::string> section = get_properties()->get(stageNameStr);
+
+  std::map<std::string, std::string>::iterator iter = section.find(CONF_QUERY_MEMORY_LIMIT);
+  if (iter != section.end()) {
+    long limit_mb = atol(iter->second.c_str());
+    query_memory_limit_ = limit_mb > 0 ? (size_t)limit_mb * 1024 * 1024 : 0;
+    LOG_INFO("Memory limit of each query is %ld MB", limit_mb);
+  }
   return true;
 }
 
@@ -111,13 +114,28 @@ void SessionStage::callback_event(StageEvent *event, CallbackContext *context) {
     return;
   }
 
+  // 查询结果可能已经通过response_stream发送了一部分，先发送缓冲区中剩余的数据。
+  // 发送失败时连接在handle_request结束时关闭
+  OutputBuffer &output_buffer = sev->output_buffer();
+  const bool streamed = output_buffer.written_bytes() > 0;
+  if (streamed && output_buffer.flush() != RC::SUCCESS) {
+    LOG_TRACE("Exit\n");
+    return;
+  }
+
   const char *response = sev->get_response();
   int len = sev->get_response_len();
-  if (len <= 0 || response == nullptr) {
+  if (streamed && len <= 0) {
+    response = "";
+    len = 1;
+  } else if (len <= 0 || response == nullptr) {
     response = "No data\n";
     len = strlen(response) + 1;
   }
-  Server::send(sev->get_client(), response, len);
+  if (Server::send(sev->get_client(), response, len) != 0) {
+    LOG_TRACE("Exit\n");
+    return;
+  }
 	if ('\0' != response[len - 1]) {
 		// 这里强制性的给发送一个消息终结符，如果需要发送多条消息，需要调整
 		char end = 0;
@@ -160,6 +178,24 @@ void SessionStage::handle_request(StageEvent *event) {
 
   sev->push_callback(cb);
 
-  SQLStageEvent *sql_event = new SQLStageEvent(sev, sql);
-  resolve_stage_->handle_event(sql_event);
+  // 后续的stage都在当前线程中同步执行，返回时这条SQL已经执行完成，可以释放它使用的内存
+  Arena &arena = sev->query_arena();
+  arena.set_limit(query_memory_limit_);
+  {
+    ArenaGuard arena_guard(&arena);
+    SQLStageEvent *sql_event = new SQLStageEvent(sev, sql);
+    resolve_stage_->handle_event(sql_event);
+  }
+  if (arena.exceeded()) {
+    LOG_WARN("Query exceeded memory limit. used=%lu, limit=%lu, sql=%s", arena.used(), arena.limit(), sql.c_str());
+  } else {
+    LOG_DEBUG("Query memory: used=%lu, reserved=%lu, allocations=%lu",
+              arena.used(), arena.reserved(), arena.alloc_count());
+  }
+  arena.reset();
+
+  // 发送结果失败的连接在SQL执行完成之后才关闭，执行过程中还在使用连接上的会话
+  if (sev->get_client()->send_failed) {
+    Server::close_connection(sev->get_client());
+  }
 }
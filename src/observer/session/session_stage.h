@@ -51,6 +51,7 @@ protected:
 private:
   Stage *resolve_stage_;
   common::SimpleTimer *sql_metric_;
+  size_t query_memory_limit_ = 0;   /// 单条SQL的内存上限，0表示不限制
   static const std::string SQL_METRIC_TAG;
 
 };
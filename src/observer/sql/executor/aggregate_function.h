@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_EXECUTOR_AGGREGATE_FUNCTION_H_
+#define __OBSERVER_SQL_EXECUTOR_AGGREGATE_FUNCTION_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+
+/**
+ * 数值列上的COUNT/SUM/AVG/MIN/MAX，直接处理列的原始值。
+ * T是列的类型，SumT是累加的类型：整数用int64_t，浮点数用double，不会溢出int或者丢失float的精度。
+ * 可以逐个值更新，也可以按列批量更新。批量更新的循环中没有分支和函数调用，
+ * 几个聚合函数在一次遍历中同时计算，编译器可以把循环向量化
+ */
+template <typename T, typename SumT>
+class NumericAggregate {
+public:
+  void update(T value) {
+    count_++;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  void update_batch(const T *values, int num) {
+    SumT sum = 0;
+    T min_value = min_;
+    T max_value = max_;
+    for (int i = 0; i < num; i++) {
+      sum += values[i];
+      min_value = std::min(min_value, values[i]);
+      max_value = std::max(max_value, values[i]);
+    }
+    count_ += num;
+    sum_ += sum;
+    min_ = min_value;
+    max_ = max_value;
+  }
+
+  /**
+   * @param nulls 每个值是否为null，非0表示null。null不参与聚合
+   */
+  void update_batch(const T *values, const uint8_t *nulls, int num) {
+    int64_t count = 0;
+    SumT sum = 0;
+    T min_value = min_;
+    T max_value = max_;
+    for (int i = 0; i < num; i++) {
+      const bool valid = nulls[i] == 0;
+      count += valid;
+      sum += valid ? values[i] : 0;
+      min_value = std::min(min_value, valid ? values[i] : std::numeric_limits<T>::max());
+      max_value = std::max(max_value, valid ? values[i] : std::numeric_limits<T>::lowest());
+    }
+    count_ += count;
+    sum_ += sum;
+    min_ = min_value;
+    max_ = max_value;
+  }
+
+  void merge(const NumericAggregate &other) {
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  /**
+   * 没有非null的值时，SUM/AVG/MIN/MAX的结果都是null
+   */
+  bool empty() const {
+    return count_ == 0;
+  }
+  int64_t count() const {
+    return count_;
+  }
+  SumT sum() const {
+    return sum_;
+  }
+  double avg() const {
+    return count_ == 0 ? 0 : (double)sum_ / count_;
+  }
+  T min() const {
+    return min_;
+  }
+  T max() const {
+    return max_;
+  }
+
+private:
+  int64_t count_ = 0;
+  SumT sum_ = 0;
+  T min_ = std::numeric_limits<T>::max();
+  T max_ = std::numeric_limits<T>::lowest();
+};
+
+typedef NumericAggregate<int, int64_t> IntAggregate;
+typedef NumericAggregate<float, double> FloatAggregate;
+
+#endif //__OBSERVER_SQL_EXECUTOR_AGGREGATE_FUNCTION_H_
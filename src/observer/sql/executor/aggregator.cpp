@@ -0,0 +1,249 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sql/executor/aggregator.h"
+#include "common/log/log.h"
+
+// 分区仍然超过内存预算时最多再分区的层数，超过之后不再限制内存
+static const int MAX_SPILL_LEVEL = 4;
+
+/**
+ * 把分组字段的值拼成hash表的key。值前面加上类型，null也是一个分组
+ */
+static void append_group_key(const TupleValue &value, std::string &key) {
+  switch (value.type()) {
+    case INTS: {
+      int int_value = value.int_value();
+      key.push_back('i');
+      key.append((const char *)&int_value, sizeof(int_value));
+    }
+    break;
+    case FLOATS: {
+      float float_value = value.float_value();
+      key.push_back('f');
+      key.append((const char *)&float_value, sizeof(float_value));
+    }
+    break;
+    case IS_NULL: {
+      key.push_back('n');
+    }
+    break;
+    default: {
+      key.push_back('s');
+      key.append(value.string_value(), value.length());
+      key.push_back('\0');
+    }
+    break;
+  }
+}
+
+static size_t partition_of(const std::string &key, int level) {
+  // 每一层使用不同的hash，同一个分区中的分组在下一层可以继续分开
+  size_t hash = std::hash<std::string>()(key);
+  hash ^= (size_t)(level + 1) * 0x9e3779b97f4a7c15ULL;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash % HashAggregator::PARTITION_NUM;
+}
+
+HashAggregator::HashAggregator(const AggregationDesc &desc, size_t memory_budget, int level)
+    : desc_(desc), memory_budget_(memory_budget), level_(level), partitions_(PARTITION_NUM, nullptr) {
+}
+
+HashAggregator::~HashAggregator() {
+  for (FILE *&file : partitions_) {
+    if (file != nullptr) {
+      fclose(file);
+      file = nullptr;
+    }
+  }
+}
+
+void HashAggregator::update(Group &group, const Tuple &tuple) {
+  for (size_t i = 0; i < desc_.types.size(); i++) {
+    AggregateState &state = group.states[i];
+    const int index = desc_.indexes[i];
+    if (index < 0) {
+      // COUNT(*)
+      state.count++;
+      continue;
+    }
+    const TupleValue value = tuple.get(index);
+    switch (value.type()) {
+      case IS_NULL: {
+      }
+      break;
+      case INTS: {
+        state.ints.update(value.int_value());
+      }
+      break;
+      case FLOATS: {
+        state.floats.update(value.float_value());
+      }
+      break;
+      default: {
+        const AGGREGATION_TYPE type = desc_.types[i];
+        if (type == SUM || type == AVG) {
+          // 字符串按照数字的前缀参与计算
+          state.floats.update(strtof(value.string_value(), nullptr));
+          break;
+        }
+        state.count++;
+        if ((type == MAX && (state.value.size() == 0 || state.value.get(0).compare(value) < 0)) ||
+            (type == MIN && (state.value.size() == 0 || state.value.get(0).compare(value) > 0))) {
+          state.value.clear();
+          state.value.add(value);
+        }
+      }
+      break;
+    }
+  }
+}
+
+void HashAggregator::output(const Group &group, Tuple &tuple) const {
+  const size_t aggregation_num = desc_.types.size();
+  for (int output : desc_.outputs) {
+    if (output >= (int)aggregation_num) {
+      tuple.add(group.keys.get(output - aggregation_num));
+      continue;
+    }
+    const AggregateState &state = group.states[output];
+    const int64_t count = state.ints.count() + state.floats.count() + state.count;
+    switch (desc_.types[output]) {
+      case MAX:
+      case MIN: {
+        const bool is_max = desc_.types[output] == MAX;
+        if (!state.ints.empty()) {
+          tuple.add(is_max ? state.ints.max() : state.ints.min());
+        } else if (!state.floats.empty()) {
+          tuple.add(is_max ? state.floats.max() : state.floats.min());
+        } else if (state.value.size() != 0) {
+          tuple.add(state.value.get(0));
+        } else {
+          tuple.add();
+        }
+      }
+      break;
+      case COUNT: {
+        tuple.add((int)count);
+      }
+      break;
+      case SUM: {
+        const int64_t int_sum = state.ints.sum();
+        if (count == 0) {
+          tuple.add();
+        } else if (state.floats.empty() && int_sum >= INT32_MIN && int_sum <= INT32_MAX) {
+          tuple.add((int)int_sum);
+        } else {
+          tuple.add((float)(state.floats.sum() + int_sum));
+        }
+      }
+      break;
+      case AVG: {
+        if (count == 0) {
+          tuple.add();
+        } else {
+          tuple.add((float)((state.floats.sum() + state.ints.sum()) / count));
+        }
+      }
+      break;
+      default: {
+        tuple.add();
+      }
+      break;
+    }
+  }
+}
+
+RC HashAggregator::spill(const std::string &key, const Tuple &tuple) {
+  FILE *&file = partitions_[partition_of(key, level_)];
+  if (file == nullptr) {
+    file = tmpfile();
+    if (file == nullptr) {
+      LOG_ERROR("Failed to create temporary file for aggregation. errno=%d:%s", errno, strerror(errno));
+      return RC::IOERR;
+    }
+    spilled_partitions_++;
+  }
+  return write_tuple(file, tuple);
+}
+
+RC HashAggregator::add(const Tuple &tuple) {
+  std::string key;
+  for (int index : desc_.group_by) {
+    append_group_key(tuple.get(index), key);
+  }
+
+  std::unordered_map<std::string, int>::iterator iter = group_index_.find(key);
+  if (iter != group_index_.end()) {
+    update(groups_[iter->second], tuple);
+    return RC::SUCCESS;
+  }
+  if (memory_usage_ >= memory_budget_ && level_ < MAX_SPILL_LEVEL) {
+    return spill(key, tuple);
+  }
+
+  Group group;
+  for (int index : desc_.group_by) {
+    group.keys.add(tuple.get(index));
+  }
+  group.states.resize(desc_.types.size());
+  update(group, tuple);
+  group_index_.emplace(key, (int)groups_.size());
+  groups_.push_back(std::move(group));
+  // 粗略估算：hash表的节点、分组本身以及各个聚合状态
+  memory_usage_ += key.size() * 2 + sizeof(Group) + 64 +
+                   desc_.group_by.size() * 32 + desc_.types.size() * sizeof(AggregateState);
+  return RC::SUCCESS;
+}
+
+RC HashAggregator::finish(std::vector<Tuple> &results) {
+  for (const Group &group : groups_) {
+    Tuple tuple;
+    output(group, tuple);
+    results.push_back(std::move(tuple));
+  }
+  groups_.clear();
+  group_index_.clear();
+  memory_usage_ = 0;
+
+  for (FILE *&file : partitions_) {
+    if (file == nullptr) {
+      continue;
+    }
+    rewind(file);
+    HashAggregator aggregator(desc_, memory_budget_, level_ + 1);
+    RC rc = RC::SUCCESS;
+    Tuple tuple;
+    while (RC::SUCCESS == (rc = read_tuple(file, tuple))) {
+      rc = aggregator.add(tuple);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    if (rc != RC::RECORD_EOF) {
+      LOG_ERROR("Failed to read spilled tuples of aggregation. rc=%d:%s", rc, strrc(rc));
+      return rc;
+    }
+    fclose(file);
+    file = nullptr;
+
+    rc = aggregator.finish(results);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    spilled_partitions_ += aggregator.spilled_partitions();
+  }
+  return RC::SUCCESS;
+}
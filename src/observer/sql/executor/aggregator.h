@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_EXECUTOR_AGGREGATOR_H_
+#define __OBSERVER_SQL_EXECUTOR_AGGREGATOR_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rc.h"
+#include "sql/executor/tuple.h"
+#include "sql/executor/aggregate_function.h"
+
+enum AGGREGATION_TYPE {
+  MAX, MIN, COUNT, AVG, SUM, NOT_KNOWN
+};
+
+/**
+ * 聚合查询的描述，由查询语句和输入的schema解析得到
+ */
+struct AggregationDesc {
+  std::vector<AGGREGATION_TYPE> types;  /// 各个聚合函数
+  std::vector<int> indexes;             /// 聚合函数的参数在输入元组中的位置，COUNT(*)是-1
+  std::vector<int> group_by;            /// group by字段在输入元组中的位置
+  std::vector<int> outputs;             /// 输出的各列：小于types.size()时是聚合函数的下标，否则减去types.size()是group_by中的下标
+  TupleSchema schema;                   /// 输出元组的schema
+};
+
+/**
+ * 基于hash的分组聚合。每个分组保存各个聚合函数的状态，输入的元组逐条就地更新所在分组的状态，不需要缓存输入。
+ * 分组占用的内存超过预算之后，已有的分组继续在内存中聚合，新分组的元组按照hash分区写到临时文件中，
+ * 内存中的分组输出之后再逐个分区聚合。分区仍然放不下时用不同的hash继续分区
+ */
+class HashAggregator {
+public:
+  static const size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+  static const int PARTITION_NUM = 16;
+
+  explicit HashAggregator(const AggregationDesc &desc, size_t memory_budget = DEFAULT_MEMORY_BUDGET, int level = 0);
+  ~HashAggregator();
+
+  RC add(const Tuple &tuple);
+
+  /**
+   * 输入结束后取出所有分组的聚合结果。内存中的分组在前，按照分组第一次出现的顺序排列
+   */
+  RC finish(std::vector<Tuple> &results);
+
+  /**
+   * 写过临时文件的分区个数，包括递归分区中写过的
+   */
+  int spilled_partitions() const {
+    return spilled_partitions_;
+  }
+
+private:
+  /**
+   * 一个分组上一个聚合函数的状态。一列中只会有一种类型的值(以及null)，整数和浮点数按原始值聚合
+   */
+  struct AggregateState {
+    IntAggregate ints;
+    FloatAggregate floats;
+    int64_t count = 0;                  /// 其他类型的值的个数
+    Tuple value;                        /// 其他类型的值的MAX/MIN，只有一个值
+  };
+
+  struct Group {
+    Tuple keys;
+    std::vector<AggregateState> states;
+  };
+
+private:
+  void update(Group &group, const Tuple &tuple);
+  void output(const Group &group, Tuple &tuple) const;
+  RC spill(const std::string &key, const Tuple &tuple);
+
+private:
+  const AggregationDesc &desc_;
+  size_t memory_budget_;
+  int level_;
+  size_t memory_usage_ = 0;
+  std::vector<Group> groups_;
+  std::unordered_map<std::string, int> group_index_;  /// 分组键 -> groups_中的下标
+  std::vector<FILE *> partitions_;
+  int spilled_partitions_ = 0;
+};
+
+#endif //__OBSERVER_SQL_EXECUTOR_AGGREGATOR_H_
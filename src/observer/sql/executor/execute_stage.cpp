@@ -12,6 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <unordered_map>
@@ -28,6 +31,10 @@ See the Mulan PSL v2 for more details. */
 #include "event/session_event.h"
 #include "event/execution_plan_event.h"
 #include "sql/executor/execution_node.h"
+#include "sql/executor/aggregator.h"
+#include "sql/optimizer/join_planner.h"
+#include "sql/optimizer/predicate_rewriter.h"
+#include "sql/plan_cache/plan_cache.h"
 #include "sql/executor/tuple.h"
 #include "storage/common/table.h"
 #include "storage/default/default_handler.h"
@@ -36,8 +43,29 @@ See the Mulan PSL v2 for more details. */
 
 using namespace common;
 
-RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, const char *table_name, SelectExeNode &select_node);
-RC create_join_selection_executor(Trx *trx, const Selects &selects, const char *db, std::vector<TupleSet> *tuple_sets, std::unordered_map<std::string,int> *table_map, JoinSelectExeNode &join_select_node);
+/**
+ * 一条select语句中子查询的结果。子查询都是不相关的，每个子查询条件只执行一次，扫描各张表时共享结果。
+ * 过滤器在init时已经把结果集转换成哈希集合或者标量，执行计划生成之后结果集就可以释放
+ */
+class SubqueryResults {
+public:
+  RC get(const char *db, Trx *trx, const Condition &condition, const Condition *&normal_condition);
+
+private:
+  std::map<const Condition *, Condition> conditions_;
+  std::vector<std::unique_ptr<TupleSet>> tuple_sets_;
+};
+
+RC create_selection_executor(Trx *trx, const Selects &selects, const std::vector<Condition> &derived, const char *db,
+                             const char *table_name, SubqueryResults &subqueries, SelectExeNode &select_node);
+RC create_join_filters(const Selects &selects, const std::vector<Condition> &derived, const char *db,
+                       std::vector<DefaultConditionFilter *> &condition_filters);
+RC create_select_plan(Trx *trx, const Selects &selects, const char *db, const JoinPlan *join_plan, ExecutionNode *&plan);
+RC do_select_by_selects(const char *db, Trx *trx, const Selects &selects, TupleSet &re_tuple_set,
+                        const JoinPlan *join_plan = nullptr);
+RC explain_select(const char *db, Trx *trx, const Selects &selects, const JoinPlan *join_plan, bool analyze,
+                  std::ostream &os);
+static bool collect_result_tables(SessionEvent *session_event, const Query &query, TableVersions &tables);
 //! Constructor
 ExecuteStage::ExecuteStage(const char *tag) : Stage(tag) {}
 
@@ -124,7 +152,13 @@ void ExecuteStage::handle_request(common::StageEvent *event) {
 
   switch (sql->flag) {
     case SCF_SELECT: { // select
-      do_select(current_db, sql, exe_event->sql_event()->session_event());
+      // 执行之前记下表的数据版本，执行期间表被修改时缓存的结果在下次使用时就会被认为已经过期
+      TableVersions result_tables;
+      const bool cacheable = collect_result_tables(session_event, *sql, result_tables);
+      RC rc = do_select(current_db, sql, exe_event->sql_event()->session_event(), exe_event->join_plan());
+      if (rc == RC::SUCCESS && cacheable) {
+        session_event->set_result_tables(std::move(result_tables));
+      }
       exe_event->done_immediate();
     }
     break;
@@ -135,6 +169,7 @@ void ExecuteStage::handle_request(common::StageEvent *event) {
     case SCF_CREATE_TABLE:
     case SCF_SHOW_TABLES:
     case SCF_DESC_TABLE:
+    case SCF_ANALYZE_TABLE:
     case SCF_DROP_TABLE:
     case SCF_CREATE_INDEX:
     case SCF_DROP_INDEX: 
@@ -177,6 +212,13 @@ void ExecuteStage::handle_request(common::StageEvent *event) {
       exe_event->done_immediate();
     }
     break;
+    case SCF_SET_VARIABLE: {
+      const SetVariable &set_variable = sql->sstr.set_variable;
+      RC rc = session_event->get_client()->session->set_variable(set_variable.name, set_variable.value);
+      session_event->set_response(rc == RC::SUCCESS ? "SUCCESS\n" : "FAILURE\n");
+      exe_event->done_immediate();
+    }
+    break;
     case SCF_HELP: {
       const char *response = "show tables;\n"
           "desc `table name`;\n"
@@ -204,6 +246,27 @@ void ExecuteStage::handle_request(common::StageEvent *event) {
   }
 }
 
+/**
+ * 查询结果可以缓存时返回true，并给出查询涉及的表和它们当前的数据版本。
+ * 子查询会修改语句，多语句事务中的查询能看到未提交的修改，这两种结果都不缓存
+ */
+static bool collect_result_tables(SessionEvent *session_event, const Query &query, TableVersions &tables) {
+  Session *session = session_event->get_client()->session;
+  if (query.explain != EXPLAIN_NONE || !query_cacheable(query) || session->is_trx_multi_operation_mode()) {
+    return false;
+  }
+  const char *db = session->get_current_db().c_str();
+  const Selects &selects = query.sstr.selection;
+  for (size_t i = 0; i < selects.relation_num; i++) {
+    Table *table = DefaultHandler::get_default().find_table(db, selects.relations[i]);
+    if (table == nullptr) {
+      return false;
+    }
+    tables.emplace_back(selects.relations[i], table->data_version());
+  }
+  return true;
+}
+
 void end_trx_if_need(Session *session, Trx *trx, bool all_right) {
   if (!session->is_trx_multi_operation_mode()) {
     if (all_right) {
@@ -224,10 +287,11 @@ RC ExecuteStage::do_select2(const char *db, Query *sql, SessionEvent *session_ev
   const Selects &selects = sql->sstr.selection;
   // 把所有的表和只跟这张表关联的condition都拿出来，生成最底层的select 执行节点
   std::vector<SelectExeNode *> select_nodes;
+  SubqueryResults subqueries;
   for (size_t i = 0; i < selects.relation_num; i++) {
     const char *table_name = selects.relations[i];
     SelectExeNode *select_node = new SelectExeNode;
-    rc = create_selection_executor(trx, selects, db, table_name, *select_node);
+    rc = create_selection_executor(trx, selects, std::vector<Condition>(), db, table_name, subqueries, *select_node);
     if (rc != RC::SUCCESS) {
       delete select_node;
       for (SelectExeNode *& tmp_node: select_nodes) {
@@ -279,101 +343,6 @@ RC ExecuteStage::do_select2(const char *db, Query *sql, SessionEvent *session_ev
   return rc;
 }
 
-void dfs_helper(std::vector<TupleSet> &tuple_sets, size_t depth, std::string str, std::vector<std::string> &result) {
-  if (depth == tuple_sets.size()) {
-    
-    result.push_back(str);
-    return;
-  }
-  if (depth != 0) {
-    str += " | ";
-  }
-  TupleSet &tuple_set = tuple_sets[depth];
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    std::string tuple_str = str + tuple_set.to_string(i);
-    dfs_helper(tuple_sets, depth+1, tuple_str, result);
-  }
-}
-
-
-void dfs(std::vector<TupleSet> &tuple_sets, std::vector<std::string> &result) {
-  dfs_helper(tuple_sets, 0, "", result);
-}
-
-
-void dfs_helper(std::vector<TupleSet> &tuple_sets, size_t depth, Tuple &tuple, TupleSet &join_tuple_set) {
-  if (depth == tuple_sets.size()) {
-    join_tuple_set.add(std::move(tuple));
-    return;
-  }
-  TupleSet &tuple_set = tuple_sets[depth];
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    Tuple tuple_(std::move(tuple));
-    const Tuple &tuple_tmp = tuple_set.get(i);
-    for (size_t j=0; j<tuple_tmp.size(); j++) {
-      tuple_.add(tuple_tmp.get_pointer(j));
-    }
-    dfs_helper(tuple_sets, depth+1, tuple_, join_tuple_set);
-  }
-}
-
-void dfs(std::vector<TupleSet> &tuple_sets, TupleSet &join_tuple_set) {
-  TupleSchema schema;
-  for (TupleSet &tuple_set: tuple_sets) {
-    schema.append(tuple_set.get_schema());
-  }
-  join_tuple_set.set_schema(schema);
-  Tuple tuple;
-  dfs_helper(tuple_sets, 0, tuple, join_tuple_set);
-}
-
-void dfs_helper(std::vector<TupleSet> &tuple_sets, size_t depth, std::vector<std::shared_ptr<TupleValue>> &values, TupleSet &join_tuple_set) {
-  if (depth == tuple_sets.size()) {
-    Tuple tuple;
-    for (std::shared_ptr<TupleValue> tuple_value: values) {
-      tuple.add(tuple_value);
-    }
-    join_tuple_set.add(std::move(tuple));
-    return;
-  }
-  TupleSet &tuple_set = tuple_sets[depth];
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    // Tuple tuple_(std::move(tuple));
-    const Tuple &tuple_tmp = tuple_set.get(i);
-    for (size_t j=0; j<tuple_tmp.size(); j++) {
-      // tuple_.add(tuple_tmp.get_pointer(j));
-      values.push_back(tuple_tmp.get_pointer(j));
-    }
-    dfs_helper(tuple_sets, depth+1, values, join_tuple_set);
-    for (size_t j=0; j<tuple_tmp.size(); j++) {
-      // tuple_.add(tuple_tmp.get_pointer(j));
-      values.pop_back();
-    }
-  }
-}
-
-void dfs2(std::vector<TupleSet> &tuple_sets, TupleSet &join_tuple_set) {
-  TupleSchema schema;
-  for (TupleSet &tuple_set: tuple_sets) {
-    schema.append(tuple_set.get_schema());
-  }
-  join_tuple_set.set_schema(schema);
-  std::vector<std::shared_ptr<TupleValue>>  values;
-  dfs_helper(tuple_sets, 0, values, join_tuple_set);
-}
-
-std::string create_header(std::vector<TupleSet> tuple_sets, bool printTableName) {
-  std::string header;
-
-  for (const TupleSet &tuple_set: tuple_sets) {
-    header += tuple_set.header_to_string(printTableName);
-  }
-}
-
-enum AGGREGATION_TYPE {
-  MAX, MIN, COUNT, AVG, NOT_KNOWN
-};
-
 AGGREGATION_TYPE is_aggregation_select(const char * attribute_name, char * &real_attribute_name) {
   if (attribute_name == nullptr) {
     return NOT_KNOWN;
@@ -418,171 +387,19 @@ AGGREGATION_TYPE is_aggregation_select(const char * attribute_name, char * &real
     strcpy(real_attribute_name, attribute_name+4);
     real_attribute_name[len-2] = '\0';
     return AVG;
+  } else if ((attribute_name[0] == 'S' || attribute_name[0] == 's') 
+      && (attribute_name[1] == 'U' || attribute_name[1] == 'u')
+      && (attribute_name[2] == 'M' || attribute_name[2] == 'm') 
+      && attribute_name[3] == '(') {
+    size_t len = strlen(attribute_name) + 1 - 4;
+    real_attribute_name = new char[len];
+    strcpy(real_attribute_name, attribute_name+4);
+    real_attribute_name[len-2] = '\0';
+    return SUM;
   }
   return NOT_KNOWN;
 }
 
-void get_tuple_value(TupleSet &tuple_set, Tuple &tuple, AGGREGATION_TYPE type, int index, std::vector<int> &group_by_list, bool add_group_by_value) {
-  // const TupleValue &value_
-  // std::ostringstream os;
-  // tuple_set.print_tuple(os);
-  // os << std::endl;
-  // tuple_set.print_tuple(os);
-
-  // std::cout << os.str() << std::endl;
-  if (type == MAX) {
-    const std::shared_ptr<TupleValue> *p_value = nullptr;
-    bool has_null = false;
-    for (size_t i=0; i<tuple_set.size(); i++) {
-      const Tuple &tuple_ = tuple_set.get(i);
-      const std::shared_ptr<TupleValue> &value_ = tuple_.get_pointer(index);
-      if (value_->type() == IS_NULL) {
-        has_null = true;
-        continue;
-      }
-      if (p_value == nullptr) {
-        p_value = &value_;
-        continue;
-      }
-      int cmp = (*p_value)->compare(*value_);
-      if (cmp < 0) {
-        p_value = &value_;
-      }
-    }
-    if (p_value == nullptr) {
-      // todo: 使用null类型
-      tuple.add();
-    } else {
-      tuple.add(*p_value);
-    }
-  } else if (type == MIN) {
-    bool has_null = false;
-    const std::shared_ptr<TupleValue> *p_value = nullptr;
-    for (size_t i=0; i<tuple_set.size(); i++) {
-      const Tuple &tuple_ = tuple_set.get(i);
-      const std::shared_ptr<TupleValue> &value_ = tuple_.get_pointer(index);
-      if (value_->type() == IS_NULL) {
-        has_null = true;
-        // break;
-        continue;
-      }
-      if (p_value == nullptr) {
-        
-        p_value = &value_;
-        continue;
-      }
-      int cmp = (*p_value)->compare(*value_);
-      if (cmp > 0) {
-        p_value = &value_;
-      }
-    }
-    if (p_value == nullptr) {
-      tuple.add();
-      // todo: 使用null类型
-    } else {
-      tuple.add(*p_value);
-    }
-  } else if (type == COUNT) {
-    const std::shared_ptr<TupleValue> *p_value = nullptr;
-    std::unordered_map<std::string, bool> value_exist_map;
-    int count = 0;
-    if (index == -1) {
-      count = tuple_set.size();
-    } else {
-      for (size_t i=0; i<tuple_set.size(); i++) {
-        const Tuple &tuple_ = tuple_set.get(i);
-        const std::shared_ptr<TupleValue> &value_ = tuple_.get_pointer(index);
-        if (value_->type() == IS_NULL) {
-          continue;
-        }
-        std::string str = value_->to_string();
-        count++;
-        value_exist_map[str] = true;
-      }
-    }
-    tuple.add(new IntValue(count));
-  } else if (type == AVG) {
-    if (tuple_set.size() == 0) {
-      // todo: 使用null类型
-      return;
-    }
-    bool all_null = false;
-    bool not_all_null = false;
-    const std::shared_ptr<TupleValue> *p_value = &(tuple_set.get(0).get_pointer(index));
-    AttrType type = (*p_value)->type();
-    float avg = 0;
-    size_t div_count = 0;
-    for (size_t i=0; i<tuple_set.size(); i++) {
-      const Tuple &tuple_ = tuple_set.get(i);
-      const std::shared_ptr<TupleValue> &value_ = tuple_.get_pointer(index);
-      // std::cout << value_->to_string() << std::endl;
-      if (value_->type() == IS_NULL) {
-        if (not_all_null) {
-          all_null = false;
-        } else {
-          all_null = true;
-        }
-        continue;
-        // break;
-      }
-      not_all_null = true;
-      avg += std::stof(value_->to_string());
-      div_count++;
-    }
-    if (all_null) {
-      tuple.add();
-    } else {
-      if (div_count != 0) {
-      avg /= div_count;
-      }
-      tuple.add(new FloatValue(avg));
-    }
-    
-  }
-  if (group_by_list.size() > 0 && tuple_set.size() > 0 && add_group_by_value) {
-    const Tuple &tuple_ = tuple_set.get(0);
-    // tuple.add(tuple_.get_pointer)
-    for (int i=0; i<group_by_list.size(); i++) {
-      tuple.add(tuple_.get_pointer(group_by_list[i]));
-    }
-  }
-}
-
-bool same_tuple(const Tuple &tuple_1, const Tuple &tuple_2, std::vector<int> &indexs) {
-  if (indexs.size() == 0) {
-    return true;
-  }
-  for (int i = 0; i<indexs.size(); i++) {
-    int cmp = tuple_1.get_pointer(indexs[i])->compare(*(tuple_2.get_pointer(indexs[i])));
-    if (cmp != 0) {
-      return false;
-    }
-  }
-  return true;
-}
-
-void split_tuple_set(TupleSet &tuple_set, std::vector<int> &group_by_list, std::vector<TupleSet> &split_tuple_sets) {
-  const std::vector<Tuple> &tuples = tuple_set.tuples();
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    // const Tuple *tuple = &(tuples[i]);
-    const Tuple &tuple = tuple_set.get(i);
-    bool flag = true;
-    for (size_t j=0; j<split_tuple_sets.size(); j++) {
-      TupleSet &tuple_set_ = split_tuple_sets[j];
-      const Tuple &tuple_ = tuple_set_.get(0);
-      if (same_tuple(tuple, tuple_, group_by_list) == true) {
-        tuple_set_.add_(tuple);
-        flag = false;
-      }
-    }
-    if (flag) {
-      TupleSet tuple_set_;
-      tuple_set_.add_(tuple);
-      split_tuple_sets.push_back(std::move(tuple_set_));
-    }
-  }
-}
-
 bool has_aggregation_select(const Selects &selects) {
   for (int i = selects.attr_num - 1; i >= 0; i--) {
     const RelAttr &attr = selects.attributes[i];
@@ -605,58 +422,200 @@ const char *get_attribute_name_from_aggregation(const char *aggregation_str) {
   return str.c_str();
 }
 
-RC projection(const char *db, TupleSet &tuple_set, const Selects &selects, TupleSet &re_tuple_set) {
-  re_tuple_set.clear();
+/**
+ * 解析聚合查询：各个聚合函数的参数和group by字段在输入中的位置，以及输出的schema
+ */
+RC resolve_aggregation(const char *db, const TupleSchema &schema_all, const Selects &selects, AggregationDesc &desc) {
   TupleSchema schema;
-  const TupleSchema &schema_all = tuple_set.get_schema();
-  std::map<std::string, bool> skip_flag;
-  std::vector <size_t> indexs; // 需要取出的属性下标集合
-  bool aggregation_flag = false;
+  std::vector <size_t> indexs; // 聚合函数的参数在输入中的下标
   std::vector <AGGREGATION_TYPE> aggreations;
-  if (has_aggregation_select(selects)) {
-    aggregation_flag = true;
-    for (int i = selects.attr_num - 1; i >= 0; i--) {
-      // char *table_name = selects.relations[0];
-      // Table * table = DefaultHandler::get_default().find_table(db, table_name);
-      const RelAttr &attr = selects.attributes[i];
-      // 多表中COUNT(ID)这种聚合语句应该报错
-      if (attr.relation_name == nullptr && selects.relation_num != 1 && 0 != strcmp(attr.attribute_name, "COUNT(*)")) {
+  for (int i = selects.attr_num - 1; i >= 0; i--) {
+    // char *table_name = selects.relations[0];
+    // Table * table = DefaultHandler::get_default().find_table(db, table_name);
+    const RelAttr &attr = selects.attributes[i];
+    // 多表中COUNT(ID)这种聚合语句应该报错
+    if (attr.relation_name == nullptr && selects.relation_num != 1 && 0 != strcmp(attr.attribute_name, "COUNT(*)")) {
+      return RC::GENERIC_ERROR;
+    }
+    Table * table = nullptr;
+    if (attr.relation_name != nullptr) {
+      table = DefaultHandler::get_default().find_table(db, attr.relation_name);
+      if (table == nullptr) {
         return RC::GENERIC_ERROR;
       }
-      Table * table = nullptr;
-      if (attr.relation_name != nullptr) {
-        table = DefaultHandler::get_default().find_table(db, attr.relation_name);
-        if (table == nullptr) {
-          return RC::GENERIC_ERROR;
-        }
+    } else {
+      table = DefaultHandler::get_default().find_table(db, selects.relations[0]);
+      if (table == nullptr) {
+        return RC::GENERIC_ERROR;
+      }
+    }
+    // if (table == nullptr && )
+    char *real_attribute_name;
+    AGGREGATION_TYPE aggreation = is_aggregation_select(attr.attribute_name, real_attribute_name);
+    if (aggreation != NOT_KNOWN) {
+      aggreations.push_back(aggreation);
+      if (strcmp(real_attribute_name, "*") == 0) {
+        indexs.push_back(-1);
+        schema.add_if_not_exists(INTS, "*", attr.attribute_name);
       } else {
-        table = DefaultHandler::get_default().find_table(db, selects.relations[0]);
-        if (table == nullptr) {
-          return RC::GENERIC_ERROR;
+        const FieldMeta *field_meta = table->table_meta().field(real_attribute_name);
+        if (nullptr == field_meta) {
+          LOG_WARN("No such field. %s.%s", table->name(), real_attribute_name);
+          return RC::SCHEMA_FIELD_MISSING;
         }
+        indexs.push_back(schema_all.index_of_field(table->name(), real_attribute_name));
+        schema.add_if_not_exists(field_meta->type(), table->name(), attr.attribute_name);
       }
-      // if (table == nullptr && )
-      char *real_attribute_name;
-      AGGREGATION_TYPE aggreation = is_aggregation_select(attr.attribute_name, real_attribute_name);
-      if (aggreation != NOT_KNOWN) {
-        
-        aggreations.push_back(aggreation);
-        if (strcmp(real_attribute_name, "*") == 0) {
-          indexs.push_back(-1);
-          schema.add_if_not_exists(INTS, "*", attr.attribute_name);
+    }
+  }
+  std::vector<int> group_by_list;
+  std::vector<int> group_by_list_pos;
+  for (int i=selects.condition_num-1; i>=0; i--) {
+    const Condition &condition = selects.conditions[i];
+    CompOp compop = condition.comp;
+    if (compop == GROUP_BY) {
+      const RelAttr &left_attr = condition.left_attr;
+      int group_by_index = -1;
+      if (left_attr.relation_name == nullptr) {
+        if (selects.relation_num != 1) {
+          return RC::SCHEMA_FIELD_MISSING;
+        }
+        group_by_index = schema_all.index_of_field(selects.relations[0], left_attr.attribute_name);
+      } else {
+        group_by_index = schema_all.index_of_field(left_attr.relation_name, left_attr.attribute_name);
+      }
+      if (group_by_index == -1) {
+        return RC::SCHEMA_FIELD_MISSING;
+      }
+      group_by_list.push_back(group_by_index);
+      int pos = -1;
+      for (int j=selects.attr_num-1; j>=0; j--) {
+        RelAttr attr = selects.attributes[j];
+        if (attr.relation_name == nullptr && selects.relation_num != 1) {
+          return RC::SCHEMA_FIELD_MISSING;
+        }
+        // char *table_name;
+        Table * table = nullptr;
+        if (attr.relation_name == nullptr) {
+          table = DefaultHandler::get_default().find_table(db, selects.relations[0]);
         } else {
-          const FieldMeta *field_meta = table->table_meta().field(real_attribute_name);
-          if (nullptr == field_meta) {
-            LOG_WARN("No such field. %s.%s", table->name(), real_attribute_name);
-            return RC::SCHEMA_FIELD_MISSING;
-          }
-          indexs.push_back(schema_all.index_of_field(table->name(), real_attribute_name));
-          schema.add_if_not_exists(field_meta->type(), table->name(), attr.attribute_name);
+          table = DefaultHandler::get_default().find_table(db, attr.relation_name);
+        }
+        char *real_attribute_name;
+        AGGREGATION_TYPE aggreation = is_aggregation_select(attr.attribute_name, real_attribute_name);
+        if (aggreation != NOT_KNOWN) {
+          continue;
+        }
+        const FieldMeta *field_meta = table->table_meta().field(attr.attribute_name);
+        if (nullptr == field_meta) {
+          LOG_WARN("No such field. %s.%s", table->name(), attr.attribute_name);
+          return RC::SCHEMA_FIELD_MISSING;
+        }
+        if ((selects.relation_num == 1) 
+          && (left_attr.relation_name == nullptr)
+          && (attr.relation_name == nullptr) 
+          && (strcmp(left_attr.attribute_name, attr.attribute_name) == 0)) {
+          pos = selects.attr_num-1-j;
+          break;
+        } else if (((left_attr.relation_name != nullptr) 
+          && (attr.relation_name != nullptr) 
+          && (strcmp(left_attr.relation_name, attr.relation_name) == 0))
+          && (strcmp(left_attr.attribute_name, attr.attribute_name) == 0)) {
+          pos = selects.attr_num-1-j;
+          break;
         }
       }
-      
+      group_by_list_pos.push_back(pos);
+    }
+  }
+  int schema_num = indexs.size();
+  for (int i=0; i<group_by_list.size(); i++) {
+    const TupleField &field = schema_all.field(group_by_list[i]);
+    if (group_by_list_pos[i] != -1) {
+      schema.add_if_not_exists(field.type(), field.table_name(), field.field_name());
+      schema_num++;
+    }
+  }
+  std::vector<int> schema_map;
+  for (int i=0; i<schema_num; i++) {
+    schema_map.push_back(-1);
+  }
+  int offset = indexs.size(); // 第一个非聚合项的列在schema中的位置
+  for (int i=0; i<group_by_list_pos.size(); i++) {
+    int pos = group_by_list_pos[i];
+    if (pos != -1) {
+      schema_map[pos] = offset++;
+    }
+  }
+  offset = 0;
+  for (int i=0; i<schema_num; i++) {
+    if (schema_map[i] == -1) {
+      schema_map[i] = offset++;
+    }
+  }
+  TupleSchema schema_;
+  for (int i=0; i<schema_num; i++) {
+    int pos = schema_map[i];
+    const TupleField &field = schema.field(pos);
+    schema_.add(field.type(), field.table_name(), field.field_name());
+  }
+
+  desc.types = aggreations;
+  for (size_t index : indexs) {
+    desc.indexes.push_back((int)index);
+  }
+  desc.group_by = group_by_list;
+  // 选出的group by字段在schema中排在聚合函数之后
+  std::vector<int> selected_group_by;
+  for (int i=0; i<group_by_list_pos.size(); i++) {
+    if (group_by_list_pos[i] != -1) {
+      selected_group_by.push_back(i);
+    }
+  }
+  for (int i=0; i<schema_num; i++) {
+    int pos = schema_map[i];
+    if (pos < (int)indexs.size()) {
+      desc.outputs.push_back(pos);
+    } else {
+      desc.outputs.push_back(indexs.size() + selected_group_by[pos - indexs.size()]);
+    }
+  }
+  desc.schema = schema_;
+  return RC::SUCCESS;
+}
+
+RC projection(const char *db, TupleSet &tuple_set, const Selects &selects, TupleSet &re_tuple_set) {
+  re_tuple_set.clear();
+  if (has_aggregation_select(selects)) {
+    AggregationDesc desc;
+    RC rc = resolve_aggregation(db, tuple_set.get_schema(), selects, desc);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    re_tuple_set.set_schema(desc.schema);
+    HashAggregator aggregator(desc);
+    for (const Tuple &tuple : tuple_set.tuples()) {
+      rc = aggregator.add(tuple);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
     }
-  } else if (selects.relation_num == 1) {
+    std::vector<Tuple> results;
+    rc = aggregator.finish(results);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    for (Tuple &tuple : results) {
+      re_tuple_set.add(std::move(tuple));
+    }
+    return RC::SUCCESS;
+  }
+
+  TupleSchema schema;
+  const TupleSchema &schema_all = tuple_set.get_schema();
+  std::map<std::string, bool> skip_flag;
+  std::vector <size_t> indexs; // 需要取出的属性下标集合
+  if (selects.relation_num == 1) {
     char *table_name = selects.relations[0];
     Table * table = DefaultHandler::get_default().find_table(db, table_name);
     for (int i = selects.attr_num - 1; i >= 0; i--) {
@@ -669,26 +628,6 @@ RC projection(const char *db, TupleSet &tuple_set, const Selects &selects, Tuple
       if (search != skip_flag.end() && search->second == true) {
         continue;
       }
-      char *real_attribute_name;
-      AGGREGATION_TYPE aggreation = is_aggregation_select(attr.attribute_name, real_attribute_name);
-      if (aggreation != NOT_KNOWN) {
-        aggregation_flag = true;
-        aggreations.push_back(aggreation);
-        if (strcmp(real_attribute_name, "*") == 0) {
-          indexs.push_back(-1);
-          schema.add_if_not_exists(INTS, "*", attr.attribute_name);
-        } else {
-          const FieldMeta *field_meta = table->table_meta().field(real_attribute_name);
-          if (nullptr == field_meta) {
-            LOG_WARN("No such field. %s.%s", table->name(), real_attribute_name);
-            return RC::SCHEMA_FIELD_MISSING;
-          }
-          indexs.push_back(schema_all.index_of_field(table_name, real_attribute_name));
-          schema.add_if_not_exists(field_meta->type(), table_name, attr.attribute_name);
-        }
-        
-        continue;
-      }
       if (strcmp(attr.attribute_name, "*") == 0) {
         skip_flag[table_name] = true;
         const TableMeta &table_meta = table->table_meta();
@@ -731,7 +670,7 @@ RC projection(const char *db, TupleSet &tuple_set, const Selects &selects, Tuple
       if (strcmp(attr.attribute_name, "*") == 0) {
         skip_flag[attr.relation_name] = true;
         const TableMeta &table_meta = table->table_meta();
-        for (int i=0; i<table_meta.field_num()-table_meta.sys_field_num(); i++) {
+        for (int i=table_meta.sys_field_num(); i<table_meta.field_num(); i++) {
           const FieldMeta * field_meta = table_meta.field(i);
           indexs.push_back(schema_all.index_of_field(table->name(), field_meta->name()));
           schema.add_if_not_exists(field_meta->type(), table->name(), field_meta->name());
@@ -748,134 +687,12 @@ RC projection(const char *db, TupleSet &tuple_set, const Selects &selects, Tuple
       
     }
   }
-  if (aggregation_flag) {
-    std::vector<int> group_by_list;
-    std::vector<int> group_by_list_pos;
-    for (int i=selects.condition_num-1; i>=0; i--) {
-      const Condition &condition = selects.conditions[i];
-      CompOp compop = condition.comp;
-      if (compop == GROUP_BY) {
-        const RelAttr &left_attr = condition.left_attr;
-        int group_by_index = -1;
-        if (left_attr.relation_name == nullptr) {
-          if (selects.relation_num != 1) {
-            return RC::SCHEMA_FIELD_MISSING;
-          }
-          group_by_index = schema_all.index_of_field(selects.relations[0], left_attr.attribute_name);
-        } else {
-          group_by_index = schema_all.index_of_field(left_attr.relation_name, left_attr.attribute_name);
-        }
-        if (group_by_index == -1) {
-          return RC::SCHEMA_FIELD_MISSING;
-        }
-        group_by_list.push_back(group_by_index);
-        int pos = -1;
-        for (int j=selects.attr_num-1; j>=0; j--) {
-          RelAttr attr = selects.attributes[j];
-          if (attr.relation_name == nullptr && selects.relation_num != 1) {
-            return RC::SCHEMA_FIELD_MISSING;
-          }
-          // char *table_name;
-          Table * table = nullptr;
-          if (attr.relation_name == nullptr) {
-            table = DefaultHandler::get_default().find_table(db, selects.relations[0]);
-          } else {
-            table = DefaultHandler::get_default().find_table(db, attr.relation_name);
-          }
-          char *real_attribute_name;
-          AGGREGATION_TYPE aggreation = is_aggregation_select(attr.attribute_name, real_attribute_name);
-          if (aggreation != NOT_KNOWN) {
-            continue;
-          }
-          const FieldMeta *field_meta = table->table_meta().field(attr.attribute_name);
-          if (nullptr == field_meta) {
-            LOG_WARN("No such field. %s.%s", table->name(), attr.attribute_name);
-            return RC::SCHEMA_FIELD_MISSING;
-          }
-          if ((selects.relation_num == 1) 
-            && (left_attr.relation_name == nullptr)
-            && (attr.relation_name == nullptr) 
-            && (strcmp(left_attr.attribute_name, attr.attribute_name) == 0)) {
-            pos = selects.attr_num-1-j;
-            break;
-          } else if (((left_attr.relation_name != nullptr) 
-            && (attr.relation_name != nullptr) 
-            && (strcmp(left_attr.relation_name, attr.relation_name) == 0))
-            && (strcmp(left_attr.attribute_name, attr.attribute_name) == 0)) {
-            pos = selects.attr_num-1-j;
-            break;
-          }
-        }
-        group_by_list_pos.push_back(pos);
-      }
-    }
-    std::vector<TupleSet> split_tuple_sets;
-    split_tuple_set(tuple_set, group_by_list, split_tuple_sets);
-    // std::ostringstream os;
-    // tuple_set.print_tuple(os);
-    // os << std::endl;
-    // for (TupleSet &tuple_set_:split_tuple_sets) {
-    //   tuple_set_.print_tuple(os);
-    //   os << std::endl;
-    // }
-
-    // std::cout << os.str() << std::endl;
-    // group_by_list_pos
-    int schema_num = indexs.size();
-    for (int i=0; i<group_by_list.size(); i++) {
-      const TupleField &field = schema_all.field(group_by_list[i]);
-      if (group_by_list_pos[i] != -1) {
-        schema.add_if_not_exists(field.type(), field.table_name(), field.field_name());
-        schema_num++;
-      }
-    }
-    std::vector<int> schema_map;
-    for (int i=0; i<schema_num; i++) {
-      schema_map.push_back(-1);
-    }
-    int offset = indexs.size(); // 第一个非聚合项的列在schema中的位置
-    for (int i=0; i<group_by_list_pos.size(); i++) {
-      int pos = group_by_list_pos[i];
-      if (pos != -1) {
-        schema_map[pos] = offset++;
-      }
-    }
-    offset = 0;
-    for (int i=0; i<schema_num; i++) {
-      if (schema_map[i] == -1) {
-        schema_map[i] = offset++;
-      }
-    }
-    TupleSchema schema_;
-    for (int i=0; i<schema_num; i++) {
-      int pos = schema_map[i];
-      const TupleField &field = schema.field(pos);
-      schema_.add(field.type(), field.table_name(), field.field_name());
-    }
-
-    re_tuple_set.set_schema(schema_);
-    for (int i=0; i<split_tuple_sets.size(); i++) {
-      Tuple tuple_, tuple__;
-      for (size_t j=0; j<indexs.size(); j++) {
-        int index = indexs[j];
-        AGGREGATION_TYPE type = aggreations[j];
-        get_tuple_value(split_tuple_sets[i], tuple_, type, index, group_by_list, j==indexs.size()-1);
-      }
-      for (int j=0; j<schema_num; j++) {
-        int pos = schema_map[j];
-        tuple__.add(tuple_.get_pointer(pos));
-      }
-      re_tuple_set.add(std::move(tuple__));
-    }
-    
-    return RC::SUCCESS;
-  }
   re_tuple_set.set_schema(schema);
   const std::vector<Tuple> &tuples = tuple_set.tuples();
   for (const Tuple &tuple: tuples) {
     Tuple tuple_;
     for (int index:indexs) {
-      tuple_.add(tuple.get_pointer(index));
+      tuple_.add(tuple.get(index));
     }
     re_tuple_set.add(std::move(tuple_));
   }
@@ -896,222 +713,457 @@ bool has_order_by(const Selects &selects) {
 
 }
 
+bool has_group_by(const Selects &selects) {
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    if (selects.conditions[i].comp == GROUP_BY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * 从计划中逐个拉取元组，直接格式化到发送给客户端的输出流。输出流的缓冲区满了就发送，
+ * 结果不在内存中物化，客户端在查询结束之前就能收到前面的行
+ */
+static RC print_select_result(ExecutionNode &plan, bool print_table_name, std::ostream &os) {
+  RC rc = plan.open();
+  if (rc != RC::SUCCESS) {
+    plan.close();
+    return rc;
+  }
+
+  const TupleSchema &schema = plan.schema();
+  if (schema.fields().empty()) {
+    LOG_WARN("Got empty schema");
+    plan.close();
+    return RC::SUCCESS;
+  }
+  schema.print(os, print_table_name);
+
+  Tuple tuple;
+  std::string line;
+  while (RC::SUCCESS == (rc = plan.next(tuple))) {
+    tuple.print(os, line);
+    if (!os) {
+      // 发送失败，客户端已经断开或者长时间不接收数据，不再继续执行
+      rc = RC::IOERR_WRITE;
+      break;
+    }
+  }
+  plan.close();
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
 // 这里没有对输入的某些信息做合法性校验，比如查询的列名、where条件中的列名等，没有做必要的合法性校验
 // 需要补充上这一部分. 校验部分也可以放在resolve，不过跟execution放一起也没有关系
-RC ExecuteStage::do_select(const char *db, Query *sql, SessionEvent *session_event) {
-
-  RC rc = RC::SUCCESS;
+RC ExecuteStage::do_select(const char *db, Query *sql, SessionEvent *session_event, const JoinPlan *join_plan) {
   Session *session = session_event->get_client()->session;
   Trx *trx = session->current_trx();
   const Selects &selects = sql->sstr.selection;
-  // 把所有的表和只跟这张表关联的condition都拿出来，生成最底层的select 执行节点
-  std::vector<SelectExeNode *> select_nodes;
-  std::unordered_map<std::string,int> table_map;
-  for (size_t i = 0; i < selects.relation_num; i++) {
-    const char *table_name = selects.relations[i];
-    Table * table = DefaultHandler::get_default().find_table(db, table_name);
-    if (nullptr == table) {
-      LOG_WARN("No such table [%s] in db [%s]", table_name, db);
-      end_trx_if_need(session, trx, false);
-      char response[256];
-      snprintf(response, sizeof(response), "%s\n", "FAILURE");
-      session_event->set_response(response);
-      return RC::SCHEMA_TABLE_NOT_EXIST;
-    }
-    SelectExeNode *select_node = new SelectExeNode;
-    rc = create_selection_executor(trx, selects, db, table_name, *select_node);
-    if (rc != RC::SUCCESS) {
-      delete select_node;
-      for (SelectExeNode *& tmp_node: select_nodes) {
-        delete tmp_node;
-      }
-      end_trx_if_need(session, trx, false);
-      char response[256];
-      snprintf(response, sizeof(response), "%s\n", "FAILURE");
-      session_event->set_response(response);
-      return rc;
-    }
-    select_nodes.push_back(select_node);
-    table_map[table_name] = selects.relation_num - 1 - i;
+
+  if (sql->explain != EXPLAIN_NONE) {
+    std::stringstream ss;
+    RC rc = explain_select(db, trx, selects, join_plan, sql->explain == EXPLAIN_ANALYZE, ss);
+    end_trx_if_need(session, trx, rc == RC::SUCCESS);
+    session_event->set_response(rc == RC::SUCCESS ? ss.str() : std::string("FAILURE\n"));
+    return rc;
   }
-  if (table_map.empty()) {
-    LOG_ERROR("No table given");
+
+  ExecutionNode *plan = nullptr;
+  RC rc = create_select_plan(trx, selects, db, join_plan, plan);
+  if (rc == RC::SUCCESS) {
+    // 多表查询时输出的列名需要带上表名
+    rc = print_select_result(*plan, selects.relation_num > 1, session_event->response_stream());
+    delete plan;
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to execute select. rc=%d:%s", rc, strrc(rc));
     end_trx_if_need(session, trx, false);
-    return RC::SQL_SYNTAX;
+    // 已经发送给客户端的部分结果无法撤回，错误信息跟在后面
+    session_event->output_buffer().discard();
+    session_event->set_response("FAILURE\n");
+    return rc;
   }
+  end_trx_if_need(session, trx, true);
+  return rc;
+}
 
-  std::vector<TupleSet> tuple_sets;
-  for (std::vector<SelectExeNode *>::reverse_iterator iter=select_nodes.rbegin(); iter!=select_nodes.rend(); iter++) {
-    SelectExeNode *&node = *iter;
-    TupleSet tuple_set;
-    rc = node->execute(tuple_set);
-    if (rc != RC::SUCCESS) {
-      for (SelectExeNode *& tmp_node: select_nodes) {
-        delete tmp_node;
-      }
-      end_trx_if_need(session, trx, false);
-      char response[256];
-      snprintf(response, sizeof(response), "%s\n", "FAILURE");
-      session_event->set_response(response);
+RC do_select_by_selects(const char *db, Trx *trx, const Selects &selects, TupleSet &re_tuple_set,
+                        const JoinPlan *join_plan) {
+  ExecutionNode *plan = nullptr;
+  RC rc = create_select_plan(trx, selects, db, join_plan, plan);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = plan->execute(re_tuple_set);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to execute select. rc=%d:%s", rc, strrc(rc));
+  }
+  delete plan;
+  return rc;
+}
+
+/**
+ * 输出查询的执行计划树。analyze为true时先执行一遍查询(丢弃结果)，再输出每个节点的执行统计
+ */
+RC explain_select(const char *db, Trx *trx, const Selects &selects, const JoinPlan *join_plan, bool analyze,
+                  std::ostream &os) {
+  ExecutionNode *plan = nullptr;
+  RC rc = create_select_plan(trx, selects, db, join_plan, plan);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (analyze) {
+    plan->enable_analyze();
+    rc = plan->open();
+    Tuple tuple;
+    while (rc == RC::SUCCESS) {
+      rc = plan->next(tuple);
+    }
+    plan->close();
+    if (rc != RC::RECORD_EOF) {
+      LOG_ERROR("Failed to execute select. rc=%d:%s", rc, strrc(rc));
+      delete plan;
       return rc;
-    } else {
-      tuple_sets.push_back(std::move(tuple_set));
     }
   }
 
-  std::stringstream ss;
-  if (tuple_sets.size() > 1) {
-    // 本次查询了多张表，需要做join操作
-    TupleSet join_tuple_set;
-    TupleSet re_tuple_set, re_tuple_set_;
-    // dfs2(tuple_sets, join_tuple_set);
-    JoinSelectExeNode join_select_node;
-    rc = create_join_selection_executor(trx, selects, db, &tuple_sets, &table_map, join_select_node);
-    join_select_node.execute(re_tuple_set);
-    if (has_order_by(selects)) {
-      rc = re_tuple_set.sort(selects);
-      if (rc != RC::SUCCESS) {
-        LOG_ERROR("sort error");
-        char response[256];
-        snprintf(response, sizeof(response), "%s\n", "FAILURE");
-        session_event->set_response(response);
-        return RC::GENERIC_ERROR;
+  if (join_plan != nullptr) {
+    os << "estimated cost=" << join_plan->cost << " rows=" << join_plan->cardinality << std::endl;
+  }
+  plan->explain(os, analyze);
+  delete plan;
+  return RC::SUCCESS;
+}
+
+static void delete_filters(std::vector<DefaultConditionFilter *> &condition_filters) {
+  for (DefaultConditionFilter * &filter : condition_filters) {
+    delete filter;
+  }
+  condition_filters.clear();
+}
+
+static bool table_in(const std::vector<std::string> &table_names, const char *table_name) {
+  return std::find(table_names.begin(), table_names.end(), table_name) != table_names.end();
+}
+
+/**
+ * 在连接条件中找出作为连接键的等值条件：一侧是已连接的outer_table.outer_field，另一侧是新表的inner_field
+ */
+static bool is_join_key(const DefaultConditionFilter &filter, const char *outer_table, const std::string &outer_field,
+                        const char *inner_table, const std::string &inner_field) {
+  if (filter.comp_op() != EQUAL_TO) {
+    return false;
+  }
+  const ConDesc &left = filter.left();
+  const ConDesc &right = filter.right();
+  return (0 == strcmp(left.table_name, outer_table) && outer_field == left.attr_name &&
+          0 == strcmp(right.table_name, inner_table) && inner_field == right.attr_name) ||
+         (0 == strcmp(right.table_name, outer_table) && outer_field == right.attr_name &&
+          0 == strcmp(left.table_name, inner_table) && inner_field == left.attr_name);
+}
+
+/**
+ * 按照优化阶段选择的连接顺序和连接方法，把各表的扫描节点组成左深的连接树。
+ * 输出的列仍然按照from中表的顺序排列
+ */
+static RC create_join_tree(const JoinPlan &join_plan, std::vector<SelectExeNode *> &scans,
+                           std::vector<DefaultConditionFilter *> &join_filters, ExecutionNode *&plan) {
+  const int table_num = (int)scans.size();
+  std::vector<bool> used(table_num, false);
+  std::vector<std::string> joined_tables;
+  RC rc = RC::SUCCESS;
+  plan = nullptr;
+  for (const JoinStep &join_step : join_plan.steps) {
+    used[join_step.table] = true;
+    SelectExeNode *scan = scans[join_step.table];
+    const char *table_name = scan->table()->name();
+    if (plan == nullptr) {
+      plan = scan;
+      joined_tables.push_back(table_name);
+      continue;
+    }
+
+    const char *outer_table = join_step.outer_table >= 0 ? scans[join_step.outer_table]->table()->name() : "";
+    JoinMethod method = join_step.method;
+
+    // 两边分别在已连接的表和新表上的等值条件作为连接键，其余的条件在连接之后过滤
+    DefaultConditionFilter *key_filter = nullptr;
+    std::vector<int> left_keys;
+    std::vector<int> right_keys;
+    std::vector<DefaultConditionFilter *> node_filters;
+    for (std::vector<DefaultConditionFilter *>::iterator iter = join_filters.begin(); iter != join_filters.end(); ) {
+      DefaultConditionFilter *filter = *iter;
+      const ConDesc &left = filter->left();
+      const ConDesc &right = filter->right();
+      const bool left_joined = table_in(joined_tables, left.table_name);
+      const bool right_joined = table_in(joined_tables, right.table_name);
+      const bool left_new = 0 == strcmp(left.table_name, table_name);
+      const bool right_new = 0 == strcmp(right.table_name, table_name);
+      if (!(left_joined || left_new) || !(right_joined || right_new)) {
+        ++iter;
+        continue;
+      }
+      iter = join_filters.erase(iter);
+      if (method == HASH_JOIN && filter->comp_op() == EQUAL_TO && left_joined && right_new) {
+        left_keys.push_back(plan->schema().index_of_field(left.table_name, left.attr_name));
+        right_keys.push_back(scan->schema().index_of_field(right.table_name, right.attr_name));
+        delete filter;
+      } else if (method == HASH_JOIN && filter->comp_op() == EQUAL_TO && right_joined && left_new) {
+        left_keys.push_back(plan->schema().index_of_field(right.table_name, right.attr_name));
+        right_keys.push_back(scan->schema().index_of_field(left.table_name, left.attr_name));
+        delete filter;
+      } else if (key_filter == nullptr && (method == SORT_MERGE_JOIN || method == INDEX_NESTED_LOOP_JOIN) &&
+                 is_join_key(*filter, outer_table, join_step.outer_field, table_name, join_step.inner_field)) {
+        key_filter = filter;
+      } else {
+        node_filters.push_back(filter);
       }
     }
-    // re_tuple_set.sort(selects);
-    rc = projection(db, re_tuple_set, selects, re_tuple_set_);
+    joined_tables.push_back(table_name);
+    if (key_filter != nullptr) {
+      delete key_filter;
+    } else if (method == SORT_MERGE_JOIN || method == INDEX_NESTED_LOOP_JOIN) {
+      LOG_ERROR("Join key of %s is missing. table=%s", join_method_name(method), table_name);
+      rc = RC::INVALID_ARGUMENT;
+    }
+
+    const int outer_key = plan->schema().index_of_field(outer_table, join_step.outer_field.c_str());
+    ExecutionNode *join_node = nullptr;
     if (rc != RC::SUCCESS) {
-      LOG_ERROR("projection error");
-      // end_trx_if_need(session, trx, false);
-      char response[256];
-      snprintf(response, sizeof(response), "%s\n", "FAILURE");
-      session_event->set_response(response);
-      return RC::GENERIC_ERROR;
+      delete_filters(node_filters);
+      delete scan;
+    } else if (method == INDEX_NESTED_LOOP_JOIN) {
+      IndexNestedLoopJoinExeNode *node = new IndexNestedLoopJoinExeNode;
+      rc = node->init(plan, scan, outer_key, join_step.inner_field.c_str(), std::move(node_filters));
+      join_node = node;
+    } else if (method == SORT_MERGE_JOIN) {
+      // 两侧都按连接字段上的索引顺序扫描，不需要再排序
+      static_cast<SelectExeNode *>(plan)->set_index_order(join_step.outer_field.c_str());
+      scan->set_index_order(join_step.inner_field.c_str());
+      const int inner_key = scan->schema().index_of_field(table_name, join_step.inner_field.c_str());
+      SortMergeJoinExeNode *node = new SortMergeJoinExeNode;
+      rc = node->init(plan, scan, outer_key, inner_key, std::move(node_filters));
+      join_node = node;
+    } else if (!left_keys.empty()) {
+      HashJoinExeNode *node = new HashJoinExeNode;
+      rc = node->init(plan, scan, std::move(left_keys), std::move(right_keys), join_step.build_left,
+                      std::move(node_filters));
+      join_node = node;
+    } else {
+      NestedLoopJoinExeNode *node = new NestedLoopJoinExeNode;
+      rc = node->init(plan, scan, std::move(node_filters));
+      join_node = node;
     }
-    re_tuple_set_.print(ss, true);
-  } else {
-    // 当前只查询一张表，直接返回结果即可
-    TupleSet re_tuple_set;
-    TupleSet &tuple_set = tuple_sets.front();
-    if (has_order_by(selects)) {
-      rc = tuple_set.sort(selects);
-      if (rc != RC::SUCCESS) {
-        session_event->set_response(session_event->get_request_buf());
-        return RC::GENERIC_ERROR;
-        LOG_ERROR("sort error");
-        char response[256];
-        snprintf(response, sizeof(response), "%s\n", "FAILURE");
-        session_event->set_response(response);
-        return RC::GENERIC_ERROR;
+    if (rc != RC::SUCCESS) {
+      delete (join_node != nullptr ? join_node : plan);
+      plan = nullptr;
+      break;
+    }
+    plan = join_node;
+  }
+
+  if (rc != RC::SUCCESS) {
+    for (int i = 0; i < table_num; i++) {
+      if (!used[i]) {
+        delete scans[i];
       }
     }
-    
-    rc = projection(db, tuple_set, selects, re_tuple_set);
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("projection error");
-      char response[256];
-      snprintf(response, sizeof(response), "%s\n", "FAILURE");
-      session_event->set_response(response);
-      return RC::GENERIC_ERROR;
+    return rc;
+  }
+
+  bool reordered = false;
+  for (int i = 0; i < table_num; i++) {
+    reordered = reordered || join_plan.steps[i].table != i;
+  }
+  if (!reordered) {
+    return RC::SUCCESS;
+  }
+  TupleSchema schema;
+  std::vector<int> indexes;
+  for (SelectExeNode *scan : scans) {
+    for (const TupleField &field : scan->schema().fields()) {
+      schema.add(field.type(), field.table_name(), field.field_name());
+      indexes.push_back(plan->schema().index_of_field(field.table_name(), field.field_name()));
     }
-    re_tuple_set.print(ss, false);
   }
+  ProjectExeNode *project_node = new ProjectExeNode;
+  project_node->init(plan, std::move(schema), std::move(indexes));
+  plan = project_node;
+  return RC::SUCCESS;
+}
 
-  for (SelectExeNode *& tmp_node: select_nodes) {
-    delete tmp_node;
+/**
+ * 单表上没有条件和分组、只选择聚合函数的查询，聚合函数都能用页头中的记录数和索引计算时，
+ * 生成不扫描记录的聚合节点，否则返回nullptr
+ */
+static ExecutionNode *create_metadata_aggregate(Trx *trx, const Selects &selects, const char *db, SelectExeNode &scan) {
+  for (size_t i = 0; i < selects.attr_num; i++) {
+    char *real_attribute_name = nullptr;
+    if (is_aggregation_select(selects.attributes[i].attribute_name, real_attribute_name) == NOT_KNOWN) {
+      return nullptr;
+    }
+    delete[] real_attribute_name;
   }
-  session_event->set_response(ss.str());
-  end_trx_if_need(session, trx, true);
-  return rc;
+  AggregationDesc desc;
+  if (resolve_aggregation(db, scan.schema(), selects, desc) != RC::SUCCESS ||
+      !MetadataAggregateExeNode::applicable(scan.table(), scan.schema(), desc)) {
+    return nullptr;
+  }
+  MetadataAggregateExeNode *node = new MetadataAggregateExeNode;
+  node->init(trx, scan.table(), scan.schema(), std::move(desc));
+  return node;
 }
 
-RC do_select_by_selects(const char *db, Trx *trx, const Selects &selects, TupleSet &re_tuple_set) {
+/**
+ * 为select语句生成执行计划：
+ * 每张表一个扫描节点，按选择的连接顺序和连接方法组成左深的连接树，之后依次是排序，聚合或投影
+ */
+RC create_select_plan(Trx *trx, const Selects &selects, const char *db, const JoinPlan *join_plan, ExecutionNode *&plan) {
+  plan = nullptr;
+  if (selects.relation_num == 0) {
+    LOG_ERROR("No table given");
+    return RC::SQL_SYNTAX;
+  }
+
+  // 由等值连接推导出的条件与原来的条件一样下推到扫描或者作为连接条件，优化阶段已经按照同样的条件选择了计划
+  std::vector<Condition> derived;
+  derive_predicates(selects, derived);
+
+  std::vector<DefaultConditionFilter *> join_filters;
   RC rc = RC::SUCCESS;
-  // 把所有的表和只跟这张表关联的condition都拿出来，生成最底层的select 执行节点
-  std::vector<SelectExeNode *> select_nodes;
-  std::unordered_map<std::string,int> table_map;
-  for (size_t i = 0; i < selects.relation_num; i++) {
-    const char *table_name = selects.relations[i];
-    Table * table = DefaultHandler::get_default().find_table(db, table_name);
-    if (nullptr == table) {
-      LOG_WARN("No such table [%s] in db [%s]", table_name, db);
-      return RC::SCHEMA_TABLE_NOT_EXIST;
+  if (selects.relation_num > 1) {
+    rc = create_join_filters(selects, derived, db, join_filters);
+    if (rc != RC::SUCCESS) {
+      delete_filters(join_filters);
+      return rc;
     }
+  }
+
+  // 语法解析得到的表是逆序的
+  std::vector<SelectExeNode *> scans;
+  std::vector<std::string> table_names;
+  SubqueryResults subqueries;
+  for (int i = selects.relation_num - 1; i >= 0; i--) {
+    const char *table_name = selects.relations[i];
     SelectExeNode *select_node = new SelectExeNode;
-    rc = create_selection_executor(trx, selects, db, table_name, *select_node);
+    rc = create_selection_executor(trx, selects, derived, db, table_name, subqueries, *select_node);
     if (rc != RC::SUCCESS) {
       delete select_node;
-      for (SelectExeNode *& tmp_node: select_nodes) {
-        delete tmp_node;
+      for (SelectExeNode *scan : scans) {
+        delete scan;
       }
+      delete_filters(join_filters);
       return rc;
     }
-    select_nodes.push_back(select_node);
-    table_map[table_name] = selects.relation_num - 1 - i;
+    scans.push_back(select_node);
+    table_names.push_back(table_name);
   }
-  if (table_map.empty()) {
-    LOG_ERROR("No table given");
-    return RC::SQL_SYNTAX;
+  for (DefaultConditionFilter *filter : join_filters) {
+    if (!table_in(table_names, filter->left().table_name) || !table_in(table_names, filter->right().table_name)) {
+      LOG_WARN("Join condition refers to a table not in from list");
+      for (SelectExeNode *scan : scans) {
+        delete scan;
+      }
+      delete_filters(join_filters);
+      return RC::SCHEMA_TABLE_NOT_EXIST;
+    }
   }
 
-  std::vector<TupleSet> tuple_sets;
-  for (std::vector<SelectExeNode *>::reverse_iterator iter=select_nodes.rbegin(); iter!=select_nodes.rend(); iter++) {
-    SelectExeNode *&node = *iter;
-    TupleSet tuple_set;
-    rc = node->execute(tuple_set);
-    if (rc != RC::SUCCESS) {
-      for (SelectExeNode *& tmp_node: select_nodes) {
-        delete tmp_node;
+  // 单表查询没有排序和聚合时，扫描够了LIMIT需要的行数就可以结束
+  const bool aggregation = has_aggregation_select(selects);
+  if (aggregation && scans.size() == 1 && selects.condition_num == 0) {
+    plan = create_metadata_aggregate(trx, selects, db, *scans.front());
+    if (plan != nullptr) {
+      delete scans.front();
+      if (selects.has_limit) {
+        LimitExeNode *limit_node = new LimitExeNode;
+        limit_node->init(plan, selects.limit, selects.offset);
+        plan = limit_node;
       }
-      return rc;
-    } else {
-      tuple_sets.push_back(std::move(tuple_set));
+      return RC::SUCCESS;
     }
   }
+  const int64_t limit_rows = selects.has_limit ? (int64_t)selects.limit + selects.offset : -1;
+  if (limit_rows >= 0 && scans.size() == 1 && !aggregation && !has_order_by(selects) && !has_group_by(selects)) {
+    scans.front()->set_limit(limit_rows);
+  }
 
-  std::stringstream ss;
-  if (tuple_sets.size() > 1) {
-    // 本次查询了多张表，需要做join操作
-    TupleSet join_tuple_set;
-    JoinSelectExeNode join_select_node;
-    rc = create_join_selection_executor(trx, selects, db, &tuple_sets, &table_map, join_select_node);
-    join_select_node.execute(join_tuple_set);
-    if (has_order_by(selects)) {
-      rc = join_tuple_set.sort(selects);
-      if (rc != RC::SUCCESS) {
-        LOG_ERROR("sort error");
-        return RC::GENERIC_ERROR;
-      }
+  // 子查询等没有经过优化阶段的查询，在这里选择连接顺序和连接方法
+  JoinPlan local_join_plan;
+  if (join_plan == nullptr || join_plan->steps.size() != scans.size()) {
+    std::vector<Table *> tables;
+    for (SelectExeNode *scan : scans) {
+      tables.push_back(scan->table());
     }
-    // re_tuple_set.sort(selects);
-    rc = projection(db, join_tuple_set, selects, re_tuple_set);
+    plan_join(tables, selects, local_join_plan);
+    join_plan = &local_join_plan;
+  }
+  for (size_t i = 0; i < join_plan->access_paths.size() && i < scans.size(); i++) {
+    const AccessPath &access_path = join_plan->access_paths[i];
+    if (!access_path.index_field.empty()) {
+      scans[i]->set_index_scan(access_path.index_field.c_str(), access_path.comp_op, access_path.value);
+    }
+  }
+  rc = create_join_tree(*join_plan, scans, join_filters, plan);
+  delete_filters(join_filters);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (has_order_by(selects)) {
+    std::vector<int> indexes;
+    std::vector<int> orders;
+    rc = resolve_order_by(selects, plan->schema(), indexes, orders);
     if (rc != RC::SUCCESS) {
-      LOG_ERROR("projection error");
-      return RC::GENERIC_ERROR;
+      LOG_ERROR("sort error");
+      delete plan;
+      plan = nullptr;
+      return rc;
     }
-    // re_tuple_set.print(ss, true);
+    // 排序之后没有聚合时，只需要排序结果的前limit+offset个元组
+    SortExeNode *sort_node = new SortExeNode;
+    sort_node->init(plan, std::move(indexes), std::move(orders), aggregation ? -1 : limit_rows);
+    plan = sort_node;
+  }
+
+  if (aggregation) {
+    AggregateExeNode *aggregate_node = new AggregateExeNode;
+    rc = aggregate_node->init(plan, db, &selects);
+    plan = aggregate_node;
   } else {
-    // 当前只查询一张表，直接返回结果即可
-    // TupleSet re_tuple_set;
-    TupleSet &tuple_set = tuple_sets.front();
-    if (has_order_by(selects)) {
-      rc = tuple_set.sort(selects);
-      if (rc != RC::SUCCESS) {    
-        LOG_ERROR("sort error");
-        return RC::GENERIC_ERROR;
+    // 投影的列只与schema有关，用空的输入计算出输出的schema
+    TupleSet empty_set(plan->schema());
+    TupleSet projected_set;
+    rc = projection(db, empty_set, selects, projected_set);
+    if (rc == RC::SUCCESS) {
+      TupleSchema schema = projected_set.get_schema();
+      std::vector<int> indexes;
+      for (const TupleField &field : schema.fields()) {
+        indexes.push_back(plan->schema().index_of_field(field.table_name(), field.field_name()));
+        if (indexes.back() < 0) {
+          LOG_WARN("No such field. %s.%s", field.table_name(), field.field_name());
+          rc = RC::SCHEMA_FIELD_MISSING;
+        }
       }
+      ProjectExeNode *project_node = new ProjectExeNode;
+      project_node->init(plan, std::move(schema), std::move(indexes));
+      plan = project_node;
     }
-    
-    rc = projection(db, tuple_set, selects, re_tuple_set);
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("projection error");
-      return RC::GENERIC_ERROR;
-    }
-    // re_tuple_set.print(ss, false);
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("projection error");
+    delete plan;
+    plan = nullptr;
+    return rc;
   }
 
-  for (SelectExeNode *& tmp_node: select_nodes) {
-    delete tmp_node;
+  if (selects.has_limit) {
+    LimitExeNode *limit_node = new LimitExeNode;
+    limit_node->init(plan, selects.limit, selects.offset);
+    plan = limit_node;
   }
   return rc;
 }
@@ -1202,149 +1254,61 @@ bool is_aggregation_schema_(const char *attribute_name, char *&aggregation_filed
   return false;
 }
 
-// RC select_condition_to_normal_condition(const char *db, Trx *trx, const Condition &select_condition, Condition &re_condition) {
-//   Selects *selects = select_condition.selects;
-//   Selects *selects_left = select_condition.selects_left;
-//   TupleSet re_tuple_set;
-//   RC rc;
-//   if (selects_left != nullptr) {
-//     Condition normal_condition_left;
-//     Condition normal_condition_right;
-//     if (has_no_sub_query(selects)) {
-
-//     }
-//   }
-//   if (has_no_sub_query(selects)) {
-//     if (selects_left != nullptr) {
-//       if (selects->attr_num != 1 || selects_left->attr_num != 1) {
-//         return RC::GENERIC_ERROR;
-//       }
-//       rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
-//       if (rc != RC::SUCCESS) {
-//         return rc;
-//       }
-//       re_condition = select_condition;
-//       re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-//       rc = do_select_by_selects(db, trx, *selects_left, re_tuple_set);
-//       if (rc != RC::SUCCESS) {
-//         return rc;
-//       }
-//       // re_condition = select_condition;
-//       re_condition.tuple_set_left_ = new TupleSet(std::move(re_tuple_set));
-//     } else {
-//       if (selects->attr_num != 1) {
-//         return RC::GENERIC_ERROR;
-//       }
-//       rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
-//       if (rc != RC::SUCCESS) {
-//         return rc;
-//       }
-//       re_condition = select_condition;
-//       re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-//       return RC::SUCCESS;
-//     }
-    
-//     // re_condition
-//   } else {
-//     char *aggregation_filed, *field_name;
-//     bool flag = is_aggregation_schema_(selects->attributes[0].attribute_name, aggregation_filed, field_name);
-//     if ((!flag && select_condition.comp != IN) &&
-//         (!flag && select_condition.comp != NOT_IN)) {
-//       return RC::GENERIC_ERROR;
-//     }
-//     for (int i=0; i<selects->condition_num; i++) {
-//       if (selects->conditions[i].is_select) {
-//         Condition normal_condition;
-//         RC rc = select_condition_to_normal_condition(db, trx, selects->conditions[i], normal_condition);
-        
-//         if (rc != RC::SUCCESS) {
-//           return RC::GENERIC_ERROR;
-//         }
-//         selects->conditions[i] = normal_condition;
-//       }
-//     }
-//     if (selects->attr_num != 1) {
-//       return RC::GENERIC_ERROR;
-//     }
-//     rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
-//     if (rc != RC::SUCCESS) {
-//       return rc;
-//     }
-//     re_condition = select_condition;
-//     re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-//     return RC::SUCCESS;
-//   }
-// }
-
-RC select_condition_to_normal_condition(const char *db, Trx *trx, const Condition &select_condition, Condition &re_condition) {
+/**
+ * 执行条件中的子查询，结果集放到re_condition的tuple_set_和tuple_set_left_中，由tuple_sets持有。
+ * 子查询中嵌套的子查询在执行子查询时处理
+ */
+RC select_condition_to_normal_condition(const char *db, Trx *trx, const Condition &select_condition,
+                                        Condition &re_condition, std::vector<std::unique_ptr<TupleSet>> &tuple_sets) {
   Selects *selects = select_condition.selects;
   Selects *selects_left = select_condition.selects_left;
-  TupleSet re_tuple_set;
-  RC rc;
-  if (has_no_sub_query(selects)) {
-    if (selects_left != nullptr) {
-      if (selects->attr_num != 1 || selects_left->attr_num != 1) {
-        return RC::GENERIC_ERROR;
-      }
-      rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
-      if (rc != RC::SUCCESS) {
-        return rc;
-      }
-      re_condition = select_condition;
-      re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-      rc = do_select_by_selects(db, trx, *selects_left, re_tuple_set);
-      if (rc != RC::SUCCESS) {
-        return rc;
-      }
-      // re_condition = select_condition;
-      re_condition.tuple_set_left_ = new TupleSet(std::move(re_tuple_set));
-    } else {
-      if (selects->attr_num != 1) {
-        return RC::GENERIC_ERROR;
-      }
-      rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
-      if (rc != RC::SUCCESS) {
-        return rc;
-      }
-      re_condition = select_condition;
-      re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-      return RC::SUCCESS;
-    }
-    
-    // re_condition
-  } else {
+  if (!has_no_sub_query(selects)) {
     char *aggregation_filed, *field_name;
     bool flag = is_aggregation_schema_(selects->attributes[0].attribute_name, aggregation_filed, field_name);
     if ((!flag && select_condition.comp != IN) &&
         (!flag && select_condition.comp != NOT_IN)) {
       return RC::GENERIC_ERROR;
     }
-    for (int i=0; i<selects->condition_num; i++) {
-      if (selects->conditions[i].is_select) {
-        Condition normal_condition;
-        RC rc = select_condition_to_normal_condition(db, trx, selects->conditions[i], normal_condition);
-        
-        if (rc != RC::SUCCESS) {
-          return RC::GENERIC_ERROR;
-        }
-        selects->conditions[i] = normal_condition;
-      }
-    }
-    if (selects->attr_num != 1) {
-      return RC::GENERIC_ERROR;
+  }
+  if (selects->attr_num != 1 || (selects_left != nullptr && selects_left->attr_num != 1)) {
+    return RC::GENERIC_ERROR;
+  }
+
+  re_condition = select_condition;
+  tuple_sets.emplace_back(new TupleSet);
+  RC rc = do_select_by_selects(db, trx, *selects, *tuple_sets.back());
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  re_condition.tuple_set_ = tuple_sets.back().get();
+  if (selects_left != nullptr) {
+    tuple_sets.emplace_back(new TupleSet);
+    rc = do_select_by_selects(db, trx, *selects_left, *tuple_sets.back());
+    if (rc != RC::SUCCESS) {
+      return rc;
     }
-    rc = do_select_by_selects(db, trx, *selects, re_tuple_set);
+    re_condition.tuple_set_left_ = tuple_sets.back().get();
+  }
+  return RC::SUCCESS;
+}
+
+RC SubqueryResults::get(const char *db, Trx *trx, const Condition &condition, const Condition *&normal_condition) {
+  auto iter = conditions_.find(&condition);
+  if (iter == conditions_.end()) {
+    Condition result;
+    RC rc = select_condition_to_normal_condition(db, trx, condition, result, tuple_sets_);
     if (rc != RC::SUCCESS) {
       return rc;
     }
-    re_condition = select_condition;
-    re_condition.tuple_set_ = new TupleSet(std::move(re_tuple_set));
-    return RC::SUCCESS;
+    iter = conditions_.emplace(&condition, result).first;
   }
+  normal_condition = &iter->second;
+  return RC::SUCCESS;
 }
 
 // 把所有的表和只跟这张表关联的condition都拿出来，生成最底层的select 执行节点
-RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, const char *table_name, SelectExeNode &select_node) {
+RC create_selection_executor(Trx *trx, const Selects &selects, const std::vector<Condition> &derived, const char *db,
+                             const char *table_name, SubqueryResults &subqueries, SelectExeNode &select_node) {
   // 列出跟这张表关联的Attr
   TupleSchema schema;
   Table * table = DefaultHandler::get_default().find_table(db, table_name);
@@ -1356,8 +1320,8 @@ RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, c
 
   // 找出仅与此表相关的过滤条件, 或者都是值的过滤条件
   std::vector<DefaultConditionFilter *> condition_filters;
-  for (size_t i = 0; i < selects.condition_num; i++) {
-    const Condition &condition = selects.conditions[i];
+  for (size_t i = 0; i < selects.condition_num + derived.size(); i++) {
+    const Condition &condition = i < selects.condition_num ? selects.conditions[i] : derived[i - selects.condition_num];
     if ((condition.left_is_attr == 0 && condition.right_is_attr == 0) || // 两边都是值
         (condition.left_is_attr == 1 && condition.right_is_attr == 0 && match_table(selects, condition.left_attr.relation_name, table_name)) ||  // 左边是属性右边是值
         (condition.left_is_attr == 0 && condition.right_is_attr == 1 && match_table(selects, condition.right_attr.relation_name, table_name)) ||  // 左边是值，右边是属性名
@@ -1376,16 +1340,15 @@ RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, c
         //     (condition.selects->attr_num != 1 || condition.selects_left->attr_num != 1)) {
         //       return RC::GENERIC_ERROR;
         // }
-        Condition normal_condition;
-        // Condition normal_condition_;
-        RC rc = select_condition_to_normal_condition(db, trx, condition, normal_condition);
+        const Condition *normal_condition = nullptr;
+        RC rc = subqueries.get(db, trx, condition, normal_condition);
         if (rc != RC::SUCCESS) {
           for (DefaultConditionFilter * &filter : condition_filters) {
             delete filter;
           }
           return rc;
         }
-        rc = condition_filter->init(*table, normal_condition);
+        rc = condition_filter->init(*table, *normal_condition);
         if (rc != RC::SUCCESS) {
           delete condition_filter;
           for (DefaultConditionFilter * &filter : condition_filters) {
@@ -1402,15 +1365,15 @@ RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, c
             (!flag && condition.comp != NOT_IN)) {
           return RC::GENERIC_ERROR;
         }
-        Condition normal_condition;
-        RC rc = select_condition_to_normal_condition(db, trx, condition, normal_condition);
+        const Condition *normal_condition = nullptr;
+        RC rc = subqueries.get(db, trx, condition, normal_condition);
         if (rc != RC::SUCCESS) {
           for (DefaultConditionFilter * &filter : condition_filters) {
             delete filter;
           }
           return rc;
         }
-        rc = condition_filter->init(*table, normal_condition);
+        rc = condition_filter->init(*table, *normal_condition);
         if (rc != RC::SUCCESS) {
           delete condition_filter;
           for (DefaultConditionFilter * &filter : condition_filters) {
@@ -1437,30 +1400,24 @@ RC create_selection_executor(Trx *trx, const Selects &selects, const char *db, c
   return select_node.init(trx, table, std::move(schema), std::move(condition_filters));
 }
 
-bool same_table(char *left_table_name, char * right_table_name) {
-  if (left_table_name != nullptr && right_table_name != nullptr) {
-    return 0 == strcmp(left_table_name, right_table_name);
-  }
-
-  return false;
-}
-
-// 把所有的表和只跟这张表关联的condition都拿出来，生成最底层的select 执行节点
-RC create_join_selection_executor(Trx *trx, const Selects &selects, const char *db, std::vector<TupleSet> *tuple_sets, std::unordered_map<std::string,int> *table_map, JoinSelectExeNode &join_select_node) {
-  // 列出跟这张表关联的Attr
-  TupleSchema schema;
-
-  // 找出与两个表相关的过滤条件
-  std::vector<DefaultConditionFilter *> condition_filters;
-  for (size_t i = 0; i < selects.condition_num; i++) {
-    const Condition &condition = selects.conditions[i];
-    if (
-        (condition.left_is_attr == 1 && condition.right_is_attr == 1 &&
-            !same_table(condition.left_attr.relation_name, condition.right_attr.relation_name)) // 左右都是属性名，并且表名都符合
-        ) {
+// 找出与两个表相关的过滤条件，生成连接条件
+RC create_join_filters(const Selects &selects, const std::vector<Condition> &derived, const char *db,
+                       std::vector<DefaultConditionFilter *> &condition_filters) {
+  for (size_t i = 0; i < selects.condition_num + derived.size(); i++) {
+    const Condition &condition = i < selects.condition_num ? selects.conditions[i] : derived[i - selects.condition_num];
+    const PredicateClass predicate_class = classify_predicate(selects, condition);
+    if (predicate_class == PREDICATE_EQUI_JOIN || predicate_class == PREDICATE_RESIDUAL) { // 左右是不同表的属性
+      if (condition.left_attr.relation_name == nullptr || condition.right_attr.relation_name == nullptr) {
+        LOG_WARN("Table name of join condition is missing");
+        return RC::SCHEMA_FIELD_MISSING;
+      }
       Table * table_left = DefaultHandler::get_default().find_table(db, condition.left_attr.relation_name);
-      const TableMeta &table_meta_left = table_left->table_meta();
       Table * table_right = DefaultHandler::get_default().find_table(db, condition.right_attr.relation_name);
+      if (table_left == nullptr || table_right == nullptr) {
+        LOG_WARN("No such table in join condition. %s, %s", condition.left_attr.relation_name, condition.right_attr.relation_name);
+        return RC::SCHEMA_TABLE_NOT_EXIST;
+      }
+      const TableMeta &table_meta_left = table_left->table_meta();
       const TableMeta &table_meta_right = table_right->table_meta();
       ConDesc left;
       ConDesc right;
@@ -1516,5 +1473,5 @@ RC create_join_selection_executor(Trx *trx, const Selects &selects, const char *
     }
   }
 
-  return join_select_node.init(trx, tuple_sets, table_map, std::move(condition_filters));
+  return RC::SUCCESS;
 }
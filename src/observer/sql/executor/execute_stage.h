@@ -20,6 +20,7 @@ See the Mulan PSL v2 for more details. */
 #include "rc.h"
 
 class SessionEvent;
+struct JoinPlan;
 
 class ExecuteStage : public common::Stage {
 public:
@@ -38,7 +39,7 @@ protected:
                      common::CallbackContext *context) override;
 
   void handle_request(common::StageEvent *event);
-  RC do_select(const char *db, Query *sql, SessionEvent *session_event);
+  RC do_select(const char *db, Query *sql, SessionEvent *session_event, const JoinPlan *join_plan);
   RC do_select2(const char *db, Query *sql, SessionEvent *session_event);
   // RC do_select_by_selects(const char *db, Trx *trx, const Selects &selects, TupleSet &tuple_set);
 protected:
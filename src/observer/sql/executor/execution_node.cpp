@@ -15,8 +15,177 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/execution_node.h"
 #include "storage/common/table.h"
 #include "sql/executor/tuple.h"
+#include "storage/common/mydate.h"
 #include "common/log/log.h"
-#include <iostream>
+#include "common/mm/arena.h"
+#include "storage/default/disk_buffer_pool.h"
+#include "sql/optimizer/join_planner.h"
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+// 定义在execute_stage.cpp中
+RC resolve_aggregation(const char *db, const TupleSchema &schema_all, const Selects &selects, AggregationDesc &desc);
+
+/**
+ * 当前请求使用的内存是否超过了上限。在物化元组的循环中检查，超过时返回NOMEM终止查询
+ */
+static bool query_memory_exceeded() {
+  common::Arena *arena = common::Arena::current();
+  if (arena != nullptr && arena->exceeded()) {
+    LOG_WARN("Query memory exceeded limit. used=%lu, limit=%lu", arena->used(), arena->limit());
+    return true;
+  }
+  return false;
+}
+
+RC ExecutionNode::execute(TupleSet &tuple_set) {
+  tuple_set.clear();
+  tuple_set.set_schema(schema());
+  RC rc = open();
+  if (rc != RC::SUCCESS) {
+    close();
+    return rc;
+  }
+
+  Tuple tuple;
+  while (RC::SUCCESS == (rc = next(tuple))) {
+    tuple_set.add(std::move(tuple));
+    if (query_memory_exceeded()) {
+      rc = RC::NOMEM;
+      break;
+    }
+  }
+  close();
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+/**
+ * 在节点的open/next/close期间计时，并统计访问的缓冲区页面。只有enable_analyze之后才统计
+ */
+class ExecutionNode::StatsGuard {
+public:
+  explicit StatsGuard(ExecutionNode &node) : node_(node) {
+    if (node_.analyze_) {
+      start_ = std::chrono::steady_clock::now();
+      start_bp_ = thread_bp_access_stat();
+    }
+  }
+  ~StatsGuard() {
+    if (node_.analyze_) {
+      const BPAccessStat &bp = thread_bp_access_stat();
+      node_.stats_.time_us += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_).count();
+      node_.stats_.page_hits += bp.hits - start_bp_.hits;
+      node_.stats_.page_misses += bp.misses - start_bp_.misses;
+    }
+  }
+
+private:
+  ExecutionNode &node_;
+  std::chrono::steady_clock::time_point start_;
+  BPAccessStat start_bp_;
+};
+
+RC ExecutionNode::open() {
+  StatsGuard guard(*this);
+  stats_.loops++;
+  return do_open();
+}
+
+RC ExecutionNode::next(Tuple &tuple) {
+  StatsGuard guard(*this);
+  RC rc = do_next(tuple);
+  if (rc == RC::SUCCESS) {
+    stats_.rows++;
+  }
+  return rc;
+}
+
+RC ExecutionNode::close() {
+  StatsGuard guard(*this);
+  return do_close();
+}
+
+void ExecutionNode::enable_analyze() {
+  analyze_ = true;
+  for (ExecutionNode *child : children()) {
+    child->enable_analyze();
+  }
+}
+
+void ExecutionNode::explain(std::ostream &os, bool analyze, int depth) const {
+  const std::vector<ExecutionNode *> child_nodes = children();
+  os << std::string(depth * 2, ' ') << (depth > 0 ? "-> " : "") << description();
+  if (analyze) {
+    int64_t rows_in = 0;
+    for (const ExecutionNode *child : child_nodes) {
+      rows_in += child->stats_.rows;
+    }
+    os << " (rows in=" << rows_in << " out=" << stats_.rows << " loops=" << stats_.loops
+       << " time=" << stats_.time_us / 1000.0 << "ms pages=" << stats_.page_hits + stats_.page_misses
+       << " hits=" << stats_.page_hits << " misses=" << stats_.page_misses << ")";
+  }
+  os << std::endl;
+  for (const ExecutionNode *child : child_nodes) {
+    child->explain(os, analyze, depth + 1);
+  }
+}
+
+static const char *comp_op_name(CompOp comp_op) {
+  switch (comp_op) {
+    case EQUAL_TO:
+      return "=";
+    case LESS_EQUAL:
+      return "<=";
+    case NOT_EQUAL:
+      return "<>";
+    case LESS_THAN:
+      return "<";
+    case GREAT_EQUAL:
+      return ">=";
+    case GREAT_THAN:
+      return ">";
+    default:
+      return "?";
+  }
+}
+
+/**
+ * 把与记录中字段格式相同的值转换成可读的字符串
+ */
+static std::string field_value_string(const FieldMeta *field, const std::string &value) {
+  if (field == nullptr || value.size() < sizeof(int)) {
+    return "?";
+  }
+  switch (field->type()) {
+    case INTS: {
+      int int_value;
+      memcpy(&int_value, value.data(), sizeof(int_value));
+      return std::to_string(int_value);
+    }
+    case FLOATS: {
+      float float_value;
+      memcpy(&float_value, value.data(), sizeof(float_value));
+      std::stringstream ss;
+      ss << float_value;
+      return ss.str();
+    }
+    case DATES: {
+      int date_value;
+      memcpy(&date_value, value.data(), sizeof(date_value));
+      char buf[16];
+      snprintf(buf, sizeof(buf), "%04d-%02d-%02d", date_value / 10000, date_value / 100 % 100, date_value % 100);
+      return buf;
+    }
+    case CHARS: {
+      return "'" + std::string(value.data(), strnlen(value.data(), value.size())) + "'";
+    }
+    default:
+      return "?";
+  }
+}
 
 SelectExeNode::SelectExeNode() : table_(nullptr) {
 }
@@ -34,252 +203,938 @@ SelectExeNode::init(Trx *trx, Table *table, TupleSchema &&tuple_schema, std::vec
   table_ = table;
   tuple_schema_ = tuple_schema;
   condition_filters_ = std::move(condition_filters);
+  return condition_filter_.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
+}
+
+RC SelectExeNode::do_open() {
+  count_ = 0;
+  if (order_field_.empty() && !scan_field_.empty()) {
+    RC rc = scanner_.open_scan(table_, trx_, &condition_filter_, scan_field_.c_str(), scan_comp_op_,
+                               scan_value_.data(), false);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to scan table by index. table=%s, field=%s", table_->name(), scan_field_.c_str());
+    }
+    return rc;
+  }
+  if (order_field_.empty()) {
+    return scanner_.open_scan(table_, trx_, &condition_filter_);
+  }
+  // 查找条件就在排序的字段上时，按索引顺序只读取范围内的记录
+  const bool range = order_field_ == scan_field_;
+  RC rc = scanner_.open_scan(table_, trx_, &condition_filter_, order_field_.c_str(), range ? scan_comp_op_ : NO_OP,
+                             range ? scan_value_.data() : nullptr, true);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to scan table by index. table=%s, field=%s", table_->name(), order_field_.c_str());
+  }
+  return rc;
+}
+
+RC SelectExeNode::open_index_lookup(const char *field_name, const char *value) {
+  StatsGuard guard(*this);
+  stats_.loops++;
+  count_ = 0;
+  RC rc = scanner_.open_scan(table_, trx_, &condition_filter_, field_name, EQUAL_TO, value, false);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to lookup table by index. table=%s, field=%s", table_->name(), field_name);
+  }
+  return rc;
+}
+
+RC SelectExeNode::do_next(Tuple &tuple) {
+  if (limit_ >= 0 && count_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+  Record record;
+  RC rc = scanner_.next_record(&record);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  count_++;
+  Tuple out;
+  TupleRecordConverter::record_to_tuple(table_, tuple_schema_, record.data, out);
+  tuple = std::move(out);
   return RC::SUCCESS;
 }
 
-void record_reader(const char *data, void *context) {
-  TupleRecordConverter *converter = (TupleRecordConverter *)context;
-  converter->add_record(data);
+RC SelectExeNode::do_close() {
+  return scanner_.close_scan();
 }
-RC SelectExeNode::execute(TupleSet &tuple_set) {
-  CompositeConditionFilter condition_filter;
-  condition_filter.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
 
-  tuple_set.clear();
-  tuple_set.set_schema(tuple_schema_);
-  TupleRecordConverter converter(table_, tuple_set);
-  return table_->scan_record(trx_, &condition_filter, -1, (void *)&converter, record_reader);
+std::string SelectExeNode::description() const {
+  std::stringstream ss;
+  if (!scan_field_.empty() && (order_field_.empty() || order_field_ == scan_field_)) {
+    ss << (order_field_.empty() ? "INDEX SCAN " : "INDEX ORDER SCAN ") << table_->name() << " (" << scan_field_
+       << " " << comp_op_name(scan_comp_op_) << " "
+       << field_value_string(table_->table_meta().field(scan_field_.c_str()), scan_value_) << ")";
+  } else if (!order_field_.empty()) {
+    ss << "INDEX ORDER SCAN " << table_->name() << " (" << order_field_ << ")";
+  } else {
+    ss << "TABLE SCAN " << table_->name();
+  }
+  if (!condition_filters_.empty()) {
+    ss << " filters=" << condition_filters_.size();
+  }
+  if (limit_ >= 0) {
+    ss << " limit=" << limit_;
+  }
+  return ss.str();
+}
+
+NestedLoopJoinExeNode::~NestedLoopJoinExeNode() {
+  for (DefaultConditionFilter * &filter : condition_filters_) {
+    delete filter;
+  }
+  condition_filters_.clear();
+  delete left_;
+  delete right_;
+}
+
+RC NestedLoopJoinExeNode::init(ExecutionNode *left, ExecutionNode *right, std::vector<DefaultConditionFilter *> &&condition_filters) {
+  left_ = left;
+  right_ = right;
+  tuple_schema_.clear();
+  tuple_schema_.append(left->schema());
+  tuple_schema_.append(right->schema());
+  condition_filters_ = std::move(condition_filters);
+  return condition_filter_.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
+}
+
+RC NestedLoopJoinExeNode::do_open() {
+  RC rc = right_->open();
+  if (rc != RC::SUCCESS) {
+    right_->close();
+    return rc;
+  }
+  Tuple tuple;
+  while (RC::SUCCESS == (rc = right_->next(tuple))) {
+    right_tuples_.push_back(std::move(tuple));
+    if (query_memory_exceeded()) {
+      rc = RC::NOMEM;
+      break;
+    }
+  }
+  right_->close();
+  if (rc != RC::RECORD_EOF) {
+    LOG_ERROR("Failed to read inner side of join. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+
+  left_valid_ = false;
+  right_pos_ = 0;
+  return left_->open();
+}
+
+RC NestedLoopJoinExeNode::do_next(Tuple &tuple) {
+  if (right_tuples_.empty()) {
+    return RC::RECORD_EOF;
+  }
+  while (true) {
+    if (!left_valid_ || right_pos_ >= right_tuples_.size()) {
+      RC rc = left_->next(left_tuple_);
+      if (rc != RC::SUCCESS) {
+        left_valid_ = false;
+        return rc;
+      }
+      left_valid_ = true;
+      right_pos_ = 0;
+    }
+
+    const Tuple &right_tuple = right_tuples_[right_pos_++];
+    Tuple out(left_tuple_);
+    out.append(right_tuple);
+    if (condition_filter_.filter(tuple_schema_, out)) {
+      tuple = std::move(out);
+      return RC::SUCCESS;
+    }
+  }
+}
+
+RC NestedLoopJoinExeNode::do_close() {
+  right_tuples_.clear();
+  left_valid_ = false;
+  return left_->close();
 }
 
+std::string NestedLoopJoinExeNode::description() const {
+  std::stringstream ss;
+  ss << join_method_name(NESTED_LOOP_JOIN);
+  if (!condition_filters_.empty()) {
+    ss << " filters=" << condition_filters_.size();
+  }
+  return ss.str();
+}
 
-JoinSelectExeNode::JoinSelectExeNode() {
+std::vector<ExecutionNode *> NestedLoopJoinExeNode::children() const {
+  return std::vector<ExecutionNode *>{left_, right_};
 }
 
-JoinSelectExeNode::~JoinSelectExeNode() {
+/**
+ * 把连接键拼成hash表的key。连接键中有null时返回false，null和任何值都连接不上
+ */
+static bool make_join_key(const Tuple &tuple, const std::vector<int> &keys, std::string &key) {
+  key.clear();
+  for (int index : keys) {
+    const TupleValue value = tuple.get(index);
+    if (value.type() == IS_NULL) {
+      return false;
+    }
+    key += value.to_string();
+    key.push_back('\0');
+  }
+  return true;
+}
+
+HashJoinExeNode::~HashJoinExeNode() {
   for (DefaultConditionFilter * &filter : condition_filters_) {
     delete filter;
   }
   condition_filters_.clear();
+  delete left_;
+  delete right_;
 }
 
-RC
-JoinSelectExeNode::init(Trx *trx, std::vector<TupleSet> *tuple_sets, std::unordered_map<std::string,int> *table_map, std::vector<DefaultConditionFilter *> &&condition_filters) {
-  trx_ = trx;
-  tuple_sets_ = tuple_sets;
-  table_map_ = table_map;
+RC HashJoinExeNode::init(ExecutionNode *left, ExecutionNode *right, std::vector<int> &&left_keys,
+                         std::vector<int> &&right_keys, bool build_left,
+                         std::vector<DefaultConditionFilter *> &&condition_filters) {
+  left_ = left;
+  right_ = right;
+  left_keys_ = std::move(left_keys);
+  right_keys_ = std::move(right_keys);
+  build_left_ = build_left;
+  tuple_schema_.clear();
+  tuple_schema_.append(left->schema());
+  tuple_schema_.append(right->schema());
+  condition_filters_ = std::move(condition_filters);
+  return condition_filter_.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
+}
+
+RC HashJoinExeNode::do_open() {
+  ExecutionNode *build = build_left_ ? left_ : right_;
+  ExecutionNode *probe = build_left_ ? right_ : left_;
+  const std::vector<int> &build_keys = build_left_ ? left_keys_ : right_keys_;
+
+  RC rc = build->open();
+  if (rc != RC::SUCCESS) {
+    build->close();
+    return rc;
+  }
+  Tuple tuple;
+  std::string key;
+  while (RC::SUCCESS == (rc = build->next(tuple))) {
+    if (!make_join_key(tuple, build_keys, key)) {
+      continue;
+    }
+    hash_table_[key].push_back((int)build_tuples_.size());
+    build_tuples_.push_back(std::move(tuple));
+    if (query_memory_exceeded()) {
+      rc = RC::NOMEM;
+      break;
+    }
+  }
+  build->close();
+  if (rc != RC::RECORD_EOF) {
+    LOG_ERROR("Failed to build hash table of join. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+
+  matches_ = nullptr;
+  match_pos_ = 0;
+  return probe->open();
+}
+
+bool HashJoinExeNode::keys_equal(const Tuple &build_tuple, const Tuple &probe_tuple) const {
+  const std::vector<int> &build_keys = build_left_ ? left_keys_ : right_keys_;
+  const std::vector<int> &probe_keys = build_left_ ? right_keys_ : left_keys_;
+  for (size_t i = 0; i < build_keys.size(); i++) {
+    if (build_tuple.get(build_keys[i]).compare(probe_tuple.get(probe_keys[i])) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RC HashJoinExeNode::do_next(Tuple &tuple) {
+  if (build_tuples_.empty()) {
+    return RC::RECORD_EOF;
+  }
+  ExecutionNode *probe = build_left_ ? right_ : left_;
+  const std::vector<int> &probe_keys = build_left_ ? right_keys_ : left_keys_;
+  std::string key;
+  while (true) {
+    if (matches_ == nullptr || match_pos_ >= matches_->size()) {
+      RC rc = probe->next(probe_tuple_);
+      if (rc != RC::SUCCESS) {
+        matches_ = nullptr;
+        return rc;
+      }
+      matches_ = nullptr;
+      match_pos_ = 0;
+      if (make_join_key(probe_tuple_, probe_keys, key)) {
+        auto iter = hash_table_.find(key);
+        if (iter != hash_table_.end()) {
+          matches_ = &iter->second;
+        }
+      }
+      continue;
+    }
+
+    const Tuple &build_tuple = build_tuples_[(*matches_)[match_pos_++]];
+    if (!keys_equal(build_tuple, probe_tuple_)) {
+      continue;
+    }
+    Tuple out(build_left_ ? build_tuple : probe_tuple_);
+    out.append(build_left_ ? probe_tuple_ : build_tuple);
+    if (condition_filter_.filter(tuple_schema_, out)) {
+      tuple = std::move(out);
+      return RC::SUCCESS;
+    }
+  }
+}
+
+RC HashJoinExeNode::do_close() {
+  hash_table_.clear();
+  build_tuples_.clear();
+  matches_ = nullptr;
+  return (build_left_ ? right_ : left_)->close();
+}
+
+std::string HashJoinExeNode::description() const {
+  std::stringstream ss;
+  ss << join_method_name(HASH_JOIN) << " (build " << (build_left_ ? "left" : "right") << ", keys=" << left_keys_.size()
+     << ")";
+  if (!condition_filters_.empty()) {
+    ss << " filters=" << condition_filters_.size();
+  }
+  return ss.str();
+}
+
+std::vector<ExecutionNode *> HashJoinExeNode::children() const {
+  return std::vector<ExecutionNode *>{left_, right_};
+}
+
+/**
+ * 把元组中的值转换成与记录中字段格式相同的索引查找值。值为null或者无法转换时返回false
+ */
+static bool make_index_key(const FieldMeta &field, const TupleValue &value, std::vector<char> &key) {
+  if (value.type() == IS_NULL) {
+    return false;
+  }
+  key.assign(field.len(), 0);
+  const std::string str = value.to_string();
+  switch (field.type()) {
+    case INTS: {
+      if (value.type() != INTS) {
+        return false;
+      }
+      int int_value = value.int_value();
+      memcpy(key.data(), &int_value, sizeof(int_value));
+    }
+    break;
+    case DATES: {
+      // 日期在元组中是字符串，在记录中是整数
+      if (str.size() != 10) {
+        return false;
+      }
+      int date_value = MyDate((char *)str.c_str()).toInt();
+      memcpy(key.data(), &date_value, sizeof(date_value));
+    }
+    break;
+    case CHARS: {
+      if (field.dict() != nullptr || str.size() > (size_t)field.len()) {
+        return false;
+      }
+      memcpy(key.data(), str.data(), str.size());
+    }
+    break;
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
+
+IndexNestedLoopJoinExeNode::~IndexNestedLoopJoinExeNode() {
+  for (DefaultConditionFilter * &filter : condition_filters_) {
+    delete filter;
+  }
+  condition_filters_.clear();
+  delete outer_;
+  delete inner_;
+}
+
+RC IndexNestedLoopJoinExeNode::init(ExecutionNode *outer, SelectExeNode *inner, int outer_key, const char *inner_field,
+                                    std::vector<DefaultConditionFilter *> &&condition_filters) {
+  outer_ = outer;
+  inner_ = inner;
+  outer_key_ = outer_key;
+  inner_field_ = inner_field;
+  inner_key_ = inner->schema().index_of_field(inner->table()->name(), inner_field);
+  tuple_schema_.clear();
+  tuple_schema_.append(outer->schema());
+  tuple_schema_.append(inner->schema());
   condition_filters_ = std::move(condition_filters);
+  if (outer_key_ < 0 || inner_key_ < 0 || inner->table()->find_single_field_index(inner_field) == nullptr) {
+    LOG_ERROR("Invalid join key of index nested loop join. inner field=%s", inner_field);
+    return RC::INVALID_ARGUMENT;
+  }
+  return condition_filter_.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
+}
+
+RC IndexNestedLoopJoinExeNode::do_open() {
+  inner_opened_ = false;
+  return outer_->open();
+}
+
+RC IndexNestedLoopJoinExeNode::do_next(Tuple &tuple) {
+  const FieldMeta *field = inner_->table()->table_meta().field(inner_field_.c_str());
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (!inner_opened_) {
+      rc = outer_->next(outer_tuple_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (!make_index_key(*field, outer_tuple_.get(outer_key_), key_)) {
+        continue;
+      }
+      rc = inner_->open_index_lookup(inner_field_.c_str(), key_.data());
+      if (rc != RC::SUCCESS) {
+        inner_->close();
+        return rc;
+      }
+      inner_opened_ = true;
+    }
+
+    Tuple inner_tuple;
+    rc = inner_->next(inner_tuple);
+    if (rc == RC::RECORD_EOF) {
+      inner_->close();
+      inner_opened_ = false;
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    // 字符串在转换成查找值时可能被截断，再比较一次
+    if (outer_tuple_.get(outer_key_).compare(inner_tuple.get(inner_key_)) != 0) {
+      continue;
+    }
+    Tuple out(outer_tuple_);
+    out.append(inner_tuple);
+    if (condition_filter_.filter(tuple_schema_, out)) {
+      tuple = std::move(out);
+      return RC::SUCCESS;
+    }
+  }
+}
+
+RC IndexNestedLoopJoinExeNode::do_close() {
+  if (inner_opened_) {
+    inner_->close();
+    inner_opened_ = false;
+  }
+  return outer_->close();
+}
+
+std::string IndexNestedLoopJoinExeNode::description() const {
+  std::stringstream ss;
+  ss << join_method_name(INDEX_NESTED_LOOP_JOIN) << " (" << inner_->table()->name() << "." << inner_field_ << ")";
+  if (!condition_filters_.empty()) {
+    ss << " filters=" << condition_filters_.size();
+  }
+  return ss.str();
+}
+
+std::vector<ExecutionNode *> IndexNestedLoopJoinExeNode::children() const {
+  return std::vector<ExecutionNode *>{outer_, inner_};
+}
+
+SortMergeJoinExeNode::~SortMergeJoinExeNode() {
+  for (DefaultConditionFilter * &filter : condition_filters_) {
+    delete filter;
+  }
+  condition_filters_.clear();
+  delete left_;
+  delete right_;
+}
+
+RC SortMergeJoinExeNode::init(ExecutionNode *left, ExecutionNode *right, int left_key, int right_key,
+                              std::vector<DefaultConditionFilter *> &&condition_filters) {
+  left_ = left;
+  right_ = right;
+  left_key_ = left_key;
+  right_key_ = right_key;
+  tuple_schema_.clear();
+  tuple_schema_.append(left->schema());
+  tuple_schema_.append(right->schema());
+  condition_filters_ = std::move(condition_filters);
+  return condition_filter_.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
+}
+
+RC SortMergeJoinExeNode::next_left() {
+  RC rc = RC::SUCCESS;
+  do {
+    rc = left_->next(left_tuple_);
+  } while (rc == RC::SUCCESS && left_tuple_.get(left_key_).type() == IS_NULL);
+  left_valid_ = rc == RC::SUCCESS;
+  return rc;
+}
+
+RC SortMergeJoinExeNode::next_right() {
+  RC rc = RC::SUCCESS;
+  do {
+    rc = right_->next(right_tuple_);
+  } while (rc == RC::SUCCESS && right_tuple_.get(right_key_).type() == IS_NULL);
+  right_valid_ = rc == RC::SUCCESS;
+  return rc;
+}
+
+RC SortMergeJoinExeNode::do_open() {
+  right_group_.clear();
+  group_pos_ = 0;
+  RC rc = left_->open();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = right_->open();
+  if (rc != RC::SUCCESS) {
+    left_->close();
+    return rc;
+  }
+  rc = next_left();
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  rc = next_right();
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    return rc;
+  }
   return RC::SUCCESS;
 }
 
-// void record_reader(const char *data, void *context) {
-//   TupleRecordConverter *converter = (TupleRecordConverter *)context;
-//   converter->add_record(data);
-// }
-
-// RC JoinSelectExeNode::execute(TupleSet &tuple_set) {
-//   CompositeConditionFilter condition_filter;
-//   condition_filter.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
-  
-//   tuple_set.clear();
-//   tuple_set.set_schema(tuple_set_->get_schema());
-//   for (size_t i=0; i<tuple_set_->size(); i++) {
-//     const Tuple &tuple = tuple_set_->get(i);
-//     if (condition_filter.filter(tuple_set_->get_schema(), tuple)) {
-//       Tuple tuple_tmp;
-//       for (size_t j=0; j<tuple.size(); j++) {
-//         tuple_tmp.add(tuple.get_pointer(j));
-//       }
-//       tuple_set.add(std::move(tuple_tmp));
-//     }
-//   }
-//   return RC::SUCCESS;
-// }
-
-void dfs_helper(std::vector<TupleSet> &tuple_sets, size_t depth, std::vector<std::shared_ptr<TupleValue>> &values, DefaultConditionFilter * condition_filter, TupleSet &join_tuple_set) {
-  if (depth == tuple_sets.size()) {
-    Tuple tuple;
-    for (std::shared_ptr<TupleValue> tuple_value: values) {
-      tuple.add(tuple_value);
-    }
-    if (condition_filter == nullptr || condition_filter->filter(join_tuple_set.get_schema(), tuple)) {
-      join_tuple_set.add(std::move(tuple));
-    }
-    return;
-  }
-  TupleSet &tuple_set = tuple_sets[depth];
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    // Tuple tuple_(std::move(tuple));
-    const Tuple &tuple_tmp = tuple_set.get(i);
-    for (size_t j=0; j<tuple_tmp.size(); j++) {
-      // tuple_.add(tuple_tmp.get_pointer(j));
-      values.push_back(tuple_tmp.get_pointer(j));
-    }
-    dfs_helper(tuple_sets, depth+1, values, condition_filter, join_tuple_set);
-    for (size_t j=0; j<tuple_tmp.size(); j++) {
-      // tuple_.add(tuple_tmp.get_pointer(j));
-      values.pop_back();
-    }
-  }
-}
-
-void tuple_set_filter(TupleSet &tuple_set, TupleSet &re_tuple_set, CompositeConditionFilter *condition_filter) {
-  for (size_t i=0; i<tuple_set.size(); i++) {
-    const Tuple &tuple_tmp = tuple_set.get(i);
-    if (condition_filter == nullptr || condition_filter->filter(tuple_set.get_schema(), tuple_tmp)) {
-      Tuple tuple;
-      for (size_t i=0; i<tuple_tmp.size(); i++) {
-        tuple.add(tuple_tmp.get_pointer(i));
+RC SortMergeJoinExeNode::do_next(Tuple &tuple) {
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (group_pos_ < right_group_.size()) {
+      const Tuple &right_tuple = right_group_[group_pos_++];
+      Tuple out(left_tuple_);
+      out.append(right_tuple);
+      if (condition_filter_.filter(tuple_schema_, out)) {
+        tuple = std::move(out);
+        return RC::SUCCESS;
+      }
+      continue;
+    }
+
+    if (!right_group_.empty()) {
+      // 左侧的下一个元组连接键不变时，与同一组右侧元组连接
+      rc = next_left();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (left_tuple_.get(left_key_).compare(right_group_.front().get(right_key_)) == 0) {
+        group_pos_ = 0;
+        continue;
+      }
+      right_group_.clear();
+      group_pos_ = 0;
+    }
+
+    if (!left_valid_ || !right_valid_) {
+      return RC::RECORD_EOF;
+    }
+    const int cmp = left_tuple_.get(left_key_).compare(right_tuple_.get(right_key_));
+    if (cmp < 0) {
+      rc = next_left();
+    } else if (cmp > 0) {
+      rc = next_right();
+    } else {
+      // 收集右侧连接键相同的一组元组
+      const Tuple &left_tuple = left_tuple_;
+      do {
+        right_group_.push_back(std::move(right_tuple_));
+        rc = next_right();
+      } while (rc == RC::SUCCESS &&
+               left_tuple.get(left_key_).compare(right_tuple_.get(right_key_)) == 0);
+      group_pos_ = 0;
+      if (rc == RC::RECORD_EOF) {
+        rc = RC::SUCCESS;
       }
-      re_tuple_set.add(std::move(tuple));
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
     }
   }
 }
 
-void inner_join(std::vector<TupleSet> &tuple_sets, TupleSet &join_tuple_set, DefaultConditionFilter * condition_filter) {
-  if (tuple_sets.size() == 0) {
-    join_tuple_set = std::move(tuple_sets[0]);
-    return;
+RC SortMergeJoinExeNode::do_close() {
+  right_group_.clear();
+  group_pos_ = 0;
+  left_valid_ = false;
+  right_valid_ = false;
+  right_->close();
+  return left_->close();
+}
+
+std::string SortMergeJoinExeNode::description() const {
+  std::stringstream ss;
+  ss << join_method_name(SORT_MERGE_JOIN);
+  if (!condition_filters_.empty()) {
+    ss << " filters=" << condition_filters_.size();
   }
-  TupleSchema schema;
-  for (TupleSet &tuple_set: tuple_sets) {
-    schema.append(tuple_set.get_schema());
-  }
-  join_tuple_set.set_schema(schema);
-  // Tuple tuple;
-  std::vector<std::shared_ptr<TupleValue>>  values;
-  dfs_helper(tuple_sets, 0, values, condition_filter, join_tuple_set);
-}
-// step1:
-// 遍历所有选择条件，如果要选择的两个关系之前没有都没有出现过，则将选择结果放入新的tuple_set，然后加入re_tuple_sets中
-// 如果一个关系之前出现过，一个没出现过，则将连接结果放入之前出现过的关系的tuple_set在re_tuple_sets的对应位置，
-// 如果两个关系在re_tuple_sets中出现，且处在一个tuple_set中，则直接根据condition_filter过滤对应集合，将结果替换到原来位置
-// 如果两个关系在re_tuple_sets中出现，且不处在一个tuple_set中，则根据condition_filter连接两个集合，连接后的集合替换到原来的较低的位置
-// step2:
-// 将没有选择过的表格加入re_tuple_sets
-// step3:
-// 最后，在re_tuple_sets上做笛卡尔积
-RC JoinSelectExeNode::execute(TupleSet &re_tuple_set) {
-  CompositeConditionFilter condition_filter;
-  condition_filter.init((const ConditionFilter **)condition_filters_.data(), condition_filters_.size());
-  
-  re_tuple_set.clear();
-  // tuple_set.set_schema(tuple_set_->get_schema());
-  // TupleSet tuple_set;
-  int joined[tuple_sets_->size()] = {0, };
-  
-  std::vector<TupleSet> re_tuple_sets;
-  std::unordered_map<int, int> table_index_to_re_tuple_set_index_map;  // 记录下标为index的关系目前在re_tuple_sets的第几个元素中
-  std::unordered_map<int, std::vector<int> > re_tuple_set_index_to_table_indexs_map; // 上面map的反向map
-
-  for (DefaultConditionFilter * condition_filter_tmp:condition_filters_) {
-    const ConDesc &left = condition_filter_tmp->left();
-    const ConDesc &right = condition_filter_tmp->right();
-    int index_left = (*table_map_)[left.table_name];
-    int index_right = (*table_map_)[right.table_name];
-    if (joined[index_left] && joined[index_right]) {
-      int re_tuple_set_index_left = table_index_to_re_tuple_set_index_map[index_left];
-      int re_tuple_set_index_right = table_index_to_re_tuple_set_index_map[index_right];
-      if (re_tuple_set_index_left == re_tuple_set_index_right) {
-        TupleSet tuple_set;
-        tuple_set_filter(re_tuple_sets[re_tuple_set_index_left], tuple_set, &condition_filter);
-        // 修改re_tuple_sets，删除旧集合，放入过滤后的新元组集合
-        re_tuple_sets.erase(re_tuple_sets.begin() + re_tuple_set_index_left);
-        re_tuple_sets.insert(re_tuple_sets.begin() + re_tuple_set_index_left, std::move(tuple_set));
-      } else {
-        TupleSet &tuple_set_left = re_tuple_sets[re_tuple_set_index_left];
-        TupleSet &tuple_set_right = re_tuple_sets[re_tuple_set_index_right];
-        std::vector<TupleSet> tuple_sets_for_join;
-        tuple_sets_for_join.push_back(std::move(tuple_set_left));
-        tuple_sets_for_join.push_back(std::move(tuple_set_right));
-        TupleSet tuple_set;
-        inner_join(tuple_sets_for_join, tuple_set, condition_filter_tmp);
-        // 修改re_tuple_sets，删除旧集合，放入过滤后的新元组集合
-        int index_low = index_left < index_right ? index_left : index_right;
-        int index_high = index_left > index_right ? index_left : index_right;
-        re_tuple_sets.erase(re_tuple_sets.begin() + index_low);
-        re_tuple_sets.erase(re_tuple_sets.begin() + index_high);
-        re_tuple_sets.insert(re_tuple_sets.begin() + index_low, std::move(tuple_set));
-
-        // 修改map
-        // int index_low = index_left < index_right ? index_left : index_right;
-        // int index_up = index_left > index_right ? index_left : index_right;
-        std::vector<int> indexs_left = re_tuple_set_index_to_table_indexs_map[re_tuple_set_index_left];
-        std::vector<int> indexs_right = re_tuple_set_index_to_table_indexs_map[re_tuple_set_index_left];
-        std::unordered_map<int, bool> flag;
-        for (int i:indexs_left) {
-          flag[i] = true;
-        }
-        for (int i:indexs_right) {
-          if (flag.find(i) != flag.end()) {
-            re_tuple_set_index_to_table_indexs_map[index_low].push_back(i);
-          }
+  return ss.str();
+}
+
+std::vector<ExecutionNode *> SortMergeJoinExeNode::children() const {
+  return std::vector<ExecutionNode *>{left_, right_};
+}
+
+SortExeNode::~SortExeNode() {
+  delete sorter_;
+  delete child_;
+}
+
+RC SortExeNode::init(ExecutionNode *child, std::vector<int> &&indexes, std::vector<int> &&orders, int64_t limit) {
+  child_ = child;
+  indexes_ = std::move(indexes);
+  orders_ = std::move(orders);
+  limit_ = limit;
+  return RC::SUCCESS;
+}
+
+RC SortExeNode::do_open() {
+  RC rc = child_->open();
+  if (rc != RC::SUCCESS) {
+    child_->close();
+    return rc;
+  }
+
+  // 超过内存预算的部分排好序写到临时文件中，所有输入结束后再归并
+  delete sorter_;
+  sorter_ = new ExternalSorter(indexes_, orders_, ExternalSorter::DEFAULT_MEMORY_BUDGET, limit_);
+  Tuple tuple;
+  while (RC::SUCCESS == (rc = child_->next(tuple))) {
+    rc = sorter_->add(std::move(tuple));
+    if (rc == RC::SUCCESS && query_memory_exceeded()) {
+      rc = RC::NOMEM;
+    }
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+  child_->close();
+  if (rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  rc = sorter_->finish();
+  spilled_runs_ = sorter_->spilled_runs();
+  if (rc == RC::SUCCESS && sorter_->spilled_runs() > 0) {
+    LOG_INFO("Sort spilled %d runs to temporary files", sorter_->spilled_runs());
+  }
+  return rc;
+}
+
+RC SortExeNode::do_next(Tuple &tuple) {
+  return sorter_->next(tuple);
+}
+
+RC SortExeNode::do_close() {
+  delete sorter_;
+  sorter_ = nullptr;
+  return RC::SUCCESS;
+}
+
+std::string SortExeNode::description() const {
+  std::stringstream ss;
+  ss << "SORT (keys=" << indexes_.size() << ")";
+  if (limit_ >= 0) {
+    ss << " limit=" << limit_;
+  }
+  if (analyze_) {
+    ss << " spilled runs=" << spilled_runs_;
+  }
+  return ss.str();
+}
+
+std::vector<ExecutionNode *> SortExeNode::children() const {
+  return std::vector<ExecutionNode *>{child_};
+}
+
+AggregateExeNode::~AggregateExeNode() {
+  delete child_;
+}
+
+RC AggregateExeNode::init(ExecutionNode *child, const char *db, const Selects *selects) {
+  child_ = child;
+  // 解析聚合函数和group by字段，得到输出的schema，同时校验查询的字段
+  return resolve_aggregation(db, child->schema(), *selects, desc_);
+}
+
+RC AggregateExeNode::do_open() {
+  results_.clear();
+  pos_ = 0;
+  RC rc = child_->open();
+  if (rc != RC::SUCCESS) {
+    child_->close();
+    return rc;
+  }
+
+  // 子节点的元组逐条聚合，不需要先全部取出
+  HashAggregator aggregator(desc_);
+  Tuple tuple;
+  while (RC::SUCCESS == (rc = child_->next(tuple))) {
+    rc = aggregator.add(tuple);
+    if (rc == RC::SUCCESS && query_memory_exceeded()) {
+      rc = RC::NOMEM;
+    }
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+  child_->close();
+  if (rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  return aggregator.finish(results_);
+}
+
+RC AggregateExeNode::do_next(Tuple &tuple) {
+  if (pos_ >= results_.size()) {
+    return RC::RECORD_EOF;
+  }
+  tuple = std::move(results_[pos_++]);
+  return RC::SUCCESS;
+}
+
+RC AggregateExeNode::do_close() {
+  results_.clear();
+  return RC::SUCCESS;
+}
+
+std::string AggregateExeNode::description() const {
+  return "AGGREGATE";
+}
+
+std::vector<ExecutionNode *> AggregateExeNode::children() const {
+  return std::vector<ExecutionNode *>{child_};
+}
+
+bool MetadataAggregateExeNode::applicable(const Table *table, const TupleSchema &input_schema,
+                                          const AggregationDesc &desc) {
+  if (!desc.group_by.empty()) {
+    return false;
+  }
+  for (size_t i = 0; i < desc.types.size(); i++) {
+    const FieldMeta *field = nullptr;
+    if (desc.indexes[i] >= 0) {
+      field = table->table_meta().field(input_schema.field(desc.indexes[i]).field_name());
+      if (field == nullptr) {
+        return false;
+      }
+    }
+    switch (desc.types[i]) {
+      case COUNT: {
+        if (field != nullptr && field->nullable()) {
+          return false;
         }
-        std::vector<int> &indexs = re_tuple_set_index_to_table_indexs_map[index_high];
-        for (int index : indexs)
-        {
-          table_index_to_re_tuple_set_index_map[index] = index_low;
+      } break;
+      case MIN:
+      case MAX: {
+        // 浮点数在索引中按误差比较，字典编码的字段在索引中是编码的顺序，都与聚合的结果可能不同
+        if (field == nullptr || field->dict() != nullptr ||
+            (field->type() != INTS && field->type() != DATES && field->type() != CHARS) ||
+            table->find_single_field_index(field->name()) == nullptr) {
+          return false;
         }
-        for (int i=index_high+1; i<re_tuple_sets.size(); i++) {
-          std::vector<int> &indexs = re_tuple_set_index_to_table_indexs_map[i];
-          for (int index : indexs)
-          {
-            table_index_to_re_tuple_set_index_map[index]--;
-          }
-          re_tuple_set_index_to_table_indexs_map[i-1] = re_tuple_set_index_to_table_indexs_map[i];
+      } break;
+      default: {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+RC MetadataAggregateExeNode::init(Trx *trx, Table *table, const TupleSchema &input_schema, AggregationDesc &&desc) {
+  trx_ = trx;
+  table_ = table;
+  input_schema_ = input_schema;
+  desc_ = std::move(desc);
+  return RC::SUCCESS;
+}
+
+/**
+ * 把找到的最小或者最大值所在的记录转换成只有这个字段的元组
+ */
+struct ExtremeValueReader {
+  const Table *table;
+  TupleSchema schema;
+  Tuple tuple;
+};
+
+static void extreme_value_reader(const char *data, void *context) {
+  ExtremeValueReader &reader = *(ExtremeValueReader *)context;
+  TupleRecordConverter::record_to_tuple(reader.table, reader.schema, data, reader.tuple);
+}
+
+RC MetadataAggregateExeNode::do_open() {
+  result_.clear();
+  output_ = false;
+
+  int64_t count = -1;
+  bool found = false;
+  Tuple values;
+  for (size_t i = 0; i < desc_.types.size(); i++) {
+    if (desc_.types[i] == COUNT) {
+      if (count < 0) {
+        RC rc = table_->count_record(trx_, &count);
+        if (rc != RC::SUCCESS) {
+          LOG_WARN("Failed to count records of table %s. rc=%d:%s", table_->name(), rc, strrc(rc));
+          return rc;
         }
-        re_tuple_set_index_to_table_indexs_map.erase(re_tuple_sets.size());
       }
-    } else if (!joined[index_left] && !joined[index_right]) {
-      TupleSet &tuple_set_left = (*tuple_sets_)[index_left];
-      TupleSet &tuple_set_right = (*tuple_sets_)[index_right];
-      std::vector<TupleSet> tuple_sets_for_join;
-      tuple_sets_for_join.push_back(std::move(tuple_set_left));
-      tuple_sets_for_join.push_back(std::move(tuple_set_right));
-      TupleSet tuple_set;
-      inner_join(tuple_sets_for_join, tuple_set, condition_filter_tmp);
-      re_tuple_sets.push_back(std::move(tuple_set));
-      int re_tuple_set_index = re_tuple_sets.size() - 1;
-      table_index_to_re_tuple_set_index_map[index_left] = re_tuple_set_index;
-      table_index_to_re_tuple_set_index_map[index_right] = re_tuple_set_index;
-      std::vector<int> tmp{index_left, index_right};
-      re_tuple_set_index_to_table_indexs_map[re_tuple_set_index] = tmp;
-      joined[index_left] = 1;
-      joined[index_right] = 1;
-    } else if (joined[index_left] && !joined[index_right]) {
-      int re_tuple_set_left_index = table_index_to_re_tuple_set_index_map[index_left];
-      TupleSet &tuple_set_left = re_tuple_sets[re_tuple_set_left_index];
-      TupleSet &tuple_set_right = (*tuple_sets_)[index_right];
-      std::vector<TupleSet> tuple_sets_for_join;
-      tuple_sets_for_join.push_back(std::move(tuple_set_left));
-      tuple_sets_for_join.push_back(std::move(tuple_set_right));
-      TupleSet tuple_set;
-      inner_join(tuple_sets_for_join, tuple_set, condition_filter_tmp);
-      re_tuple_sets.erase(re_tuple_sets.begin() + re_tuple_set_left_index);
-      re_tuple_sets.insert(re_tuple_sets.begin() + re_tuple_set_left_index, std::move(tuple_set));
-      table_index_to_re_tuple_set_index_map[index_right] = re_tuple_set_left_index;
-      re_tuple_set_index_to_table_indexs_map[re_tuple_set_left_index].push_back(index_right);
-      joined[index_right] = 1;
-    } else { // !joined[index_left] && joined[index_right]
-      int re_tuple_set_right_index = table_index_to_re_tuple_set_index_map[index_right];
-      TupleSet &tuple_set_left = (*tuple_sets_)[index_left];
-      TupleSet &tuple_set_right = re_tuple_sets[re_tuple_set_right_index];
-      std::vector<TupleSet> tuple_sets_for_join;
-      tuple_sets_for_join.push_back(std::move(tuple_set_right));
-      tuple_sets_for_join.push_back(std::move(tuple_set_left));
-      TupleSet tuple_set;
-      inner_join(tuple_sets_for_join, tuple_set, condition_filter_tmp);
-      re_tuple_sets.erase(re_tuple_sets.begin() + re_tuple_set_right_index);
-      re_tuple_sets.insert(re_tuple_sets.begin() + re_tuple_set_right_index, std::move(tuple_set));
-      table_index_to_re_tuple_set_index_map[index_right] = re_tuple_set_right_index;
-      re_tuple_set_index_to_table_indexs_map[re_tuple_set_right_index].push_back(index_left);
-      joined[index_left] = 1;
-    }
-  }
-  for (int i=0; i<tuple_sets_->size(); i++) {
-    if (table_index_to_re_tuple_set_index_map.find(i) == table_index_to_re_tuple_set_index_map.end()) {
-      re_tuple_sets.push_back(std::move((*tuple_sets_)[i]));
-    }
-  }
-  inner_join(re_tuple_sets, re_tuple_set, nullptr);
-  return RC::SUCCESS; 
-}
\ No newline at end of file
+      values.add((int)count);
+      continue;
+    }
+
+    const TupleField &field = input_schema_.field(desc_.indexes[i]);
+    ExtremeValueReader reader;
+    reader.table = table_;
+    reader.schema.add(field.type(), field.table_name(), field.field_name());
+    RC rc = table_->find_extreme_record(trx_, field.field_name(), desc_.types[i] == MAX, &reader, extreme_value_reader);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("Failed to find %s of %s.%s by index. rc=%d:%s", desc_.types[i] == MAX ? "max" : "min",
+               table_->name(), field.field_name(), rc, strrc(rc));
+      return rc;
+    }
+    if (reader.tuple.size() == 0) {
+      values.add();
+    } else {
+      values.add(reader.tuple.get(0));
+      found = true;
+    }
+  }
+
+  // 与AggregateExeNode一样，没有记录时没有分组，不输出结果
+  if (!found && count < 0) {
+    RC rc = table_->count_record(trx_, &count);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("Failed to count records of table %s. rc=%d:%s", table_->name(), rc, strrc(rc));
+      return rc;
+    }
+  }
+  if (!found && count == 0) {
+    output_ = true;
+    return RC::SUCCESS;
+  }
+  for (int output : desc_.outputs) {
+    result_.add(values.get(output));
+  }
+  return RC::SUCCESS;
+}
+
+RC MetadataAggregateExeNode::do_next(Tuple &tuple) {
+  if (output_) {
+    return RC::RECORD_EOF;
+  }
+  output_ = true;
+  tuple = std::move(result_);
+  return RC::SUCCESS;
+}
+
+RC MetadataAggregateExeNode::do_close() {
+  result_.clear();
+  return RC::SUCCESS;
+}
+
+std::string MetadataAggregateExeNode::description() const {
+  std::stringstream ss;
+  ss << "METADATA AGGREGATE " << table_->name();
+  return ss.str();
+}
+
+ProjectExeNode::~ProjectExeNode() {
+  delete child_;
+}
+
+RC ProjectExeNode::init(ExecutionNode *child, TupleSchema &&tuple_schema, std::vector<int> &&indexes) {
+  child_ = child;
+  tuple_schema_ = std::move(tuple_schema);
+  indexes_ = std::move(indexes);
+  return RC::SUCCESS;
+}
+
+RC ProjectExeNode::do_open() {
+  return child_->open();
+}
+
+RC ProjectExeNode::do_next(Tuple &tuple) {
+  Tuple child_tuple;
+  RC rc = child_->next(child_tuple);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  Tuple out;
+  for (int index : indexes_) {
+    out.add(child_tuple.get(index));
+  }
+  tuple = std::move(out);
+  return RC::SUCCESS;
+}
+
+RC ProjectExeNode::do_close() {
+  return child_->close();
+}
+
+std::string ProjectExeNode::description() const {
+  return "PROJECT (columns=" + std::to_string(indexes_.size()) + ")";
+}
+
+std::vector<ExecutionNode *> ProjectExeNode::children() const {
+  return std::vector<ExecutionNode *>{child_};
+}
+
+LimitExeNode::~LimitExeNode() {
+  delete child_;
+}
+
+RC LimitExeNode::init(ExecutionNode *child, int limit, int offset) {
+  child_ = child;
+  limit_ = limit;
+  offset_ = offset;
+  return RC::SUCCESS;
+}
+
+RC LimitExeNode::do_open() {
+  count_ = 0;
+  skipped_ = 0;
+  return child_->open();
+}
+
+RC LimitExeNode::do_next(Tuple &tuple) {
+  if (limit_ >= 0 && count_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = child_->next(tuple))) {
+    if (skipped_ < offset_) {
+      skipped_++;
+      continue;
+    }
+    count_++;
+    return RC::SUCCESS;
+  }
+  return rc;
+}
+
+RC LimitExeNode::do_close() {
+  return child_->close();
+}
+
+std::string LimitExeNode::description() const {
+  return "LIMIT " + std::to_string(limit_) + " OFFSET " + std::to_string(offset_);
+}
+
+std::vector<ExecutionNode *> LimitExeNode::children() const {
+  return std::vector<ExecutionNode *>{child_};
+}
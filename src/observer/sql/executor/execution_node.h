@@ -15,22 +15,94 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_SQL_EXECUTOR_EXECUTION_NODE_H_
 #define __OBSERVER_SQL_EXECUTOR_EXECUTION_NODE_H_
 
+#include <ostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "storage/common/condition_filter.h"
+#include "storage/common/table.h"
 #include "sql/executor/tuple.h"
-#include <unordered_map>
+#include "sql/executor/aggregator.h"
+#include "sql/executor/sorter.h"
 
-class Table;
 class Trx;
 
+/**
+ * 火山模型(Volcano)的执行节点。上层节点通过open/next/close逐条拉取下层节点产生的元组，
+ * 元组在节点之间流动，不需要把每一步的中间结果都物化到内存中。
+ * 节点拥有它的子节点，析构时一并释放
+ */
 class ExecutionNode {
 public:
   ExecutionNode() = default;
   virtual ~ExecutionNode() = default;
 
-  virtual RC execute(TupleSet &tuple_set) = 0;
+  RC open();
+
+  /**
+   * 获取下一个元组
+   * @return 没有更多元组时返回RECORD_EOF
+   */
+  RC next(Tuple &tuple);
+
+  RC close();
+
+  /**
+   * 节点输出的元组格式，在init之后就可以获取
+   */
+  virtual const TupleSchema &schema() const = 0;
+
+  /**
+   * 节点的简短描述，比如访问的表、连接方法和连接键，explain时输出
+   */
+  virtual std::string description() const = 0;
+
+  virtual std::vector<ExecutionNode *> children() const {
+    return std::vector<ExecutionNode *>();
+  }
+
+  /**
+   * 拉取节点输出的所有元组，放到tuple_set中
+   */
+  RC execute(TupleSet &tuple_set);
+
+  /**
+   * 在open之前调用，让这个节点和所有子节点记录执行耗时和访问的页面，用于explain analyze
+   */
+  void enable_analyze();
+
+  /**
+   * 按树形输出以这个节点为根的执行计划，每个节点一行，子节点缩进。
+   * analyze为true时在每个节点后面输出执行的统计
+   */
+  void explain(std::ostream &os, bool analyze, int depth = 0) const;
+
+protected:
+  virtual RC do_open() = 0;
+  virtual RC do_next(Tuple &tuple) = 0;
+  virtual RC do_close() = 0;
+
+protected:
+  /**
+   * 节点执行的统计。耗时和页面包括在子节点中花费的部分
+   */
+  struct ExecutionStats {
+    int64_t loops = 0;       /// open的次数
+    int64_t rows = 0;        /// 输出的元组数
+    int64_t time_us = 0;
+    uint64_t page_hits = 0;
+    uint64_t page_misses = 0;
+  };
+
+  class StatsGuard;
+
+  bool analyze_ = false;
+  ExecutionStats stats_;
 };
 
+/**
+ * 表扫描，输出一张表中满足本表过滤条件的记录
+ */
 class SelectExeNode : public ExecutionNode {
 public:
   SelectExeNode();
@@ -38,28 +110,389 @@ public:
 
   RC init(Trx *trx, Table *table, TupleSchema && tuple_schema, std::vector<DefaultConditionFilter *> &&condition_filters);
 
-  RC execute(TupleSet &tuple_set) override;
+  std::string description() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+
+  Table *table() const {
+    return table_;
+  }
+
+  /**
+   * 按field_name上的单字段索引的顺序输出记录，在open之前调用。
+   * 同时设置了同一个字段上的索引查找时，只按顺序输出查找到的记录，否则不再使用索引查找
+   */
+  void set_index_order(const char *field_name) {
+    order_field_ = field_name;
+  }
+
+  /**
+   * 在field_name的单字段索引上查找满足"字段 comp_op value"的记录，代替顺序扫描。在open之前调用
+   * @param value 与记录中字段格式相同的值
+   */
+  void set_index_scan(const char *field_name, CompOp comp_op, const std::string &value) {
+    scan_field_ = field_name;
+    scan_comp_op_ = comp_op;
+    scan_value_ = value;
+  }
+
+  /**
+   * 最多输出limit条记录，输出够了就不再读取后面的页面。小于0表示不限制
+   */
+  void set_limit(int64_t limit) {
+    limit_ = limit;
+  }
+
+  /**
+   * 代替open，在field_name的单字段索引上查找字段等于value的记录
+   * @param value 与记录中字段格式相同的值
+   */
+  RC open_index_lookup(const char *field_name, const char *value);
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
 private:
   Trx *trx_ = nullptr;
   Table  * table_;
+  std::string order_field_;
+  std::string scan_field_;
+  CompOp scan_comp_op_ = NO_OP;
+  std::string scan_value_;
+  int64_t limit_ = -1;
+  int64_t count_ = 0;
   TupleSchema  tuple_schema_;
   std::vector<DefaultConditionFilter *> condition_filters_;
+  CompositeConditionFilter condition_filter_;
+  TableScanner scanner_;
 };
 
-class JoinSelectExeNode : public ExecutionNode {
+/**
+ * 嵌套循环连接。左子节点逐条拉取，右子节点在open时缓存下来，
+ * 每个左元组与右侧所有元组拼接后，用连接条件过滤
+ */
+class NestedLoopJoinExeNode : public ExecutionNode {
 public:
-  JoinSelectExeNode();
-  virtual ~JoinSelectExeNode();
+  NestedLoopJoinExeNode() = default;
+  virtual ~NestedLoopJoinExeNode();
+
+  RC init(ExecutionNode *left, ExecutionNode *right, std::vector<DefaultConditionFilter *> &&condition_filters);
 
-  RC init(Trx *trx, std::vector<TupleSet> *tuple_sets_, std::unordered_map<std::string,int> *table_map, std::vector<DefaultConditionFilter *> &&condition_filters);
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
 
-  RC execute(TupleSet &tuple_set) override;
 private:
-  Trx *trx_ = nullptr;
-  // TupleSet *tuple_set_;
-  std::vector<TupleSet> *tuple_sets_;
-  std::unordered_map<std::string,int> *table_map_;
+  ExecutionNode *left_ = nullptr;
+  ExecutionNode *right_ = nullptr;
+  TupleSchema tuple_schema_;
+  std::vector<DefaultConditionFilter *> condition_filters_;
+  CompositeConditionFilter condition_filter_;
+
+  std::vector<Tuple> right_tuples_;
+  Tuple left_tuple_;
+  bool left_valid_ = false;
+  size_t right_pos_ = 0;
+};
+
+/**
+ * 等值连接的hash join。在较小的一侧建立hash表，逐条拉取另一侧去探测，
+ * 连接键可以有多列。等值条件之外的连接条件在拼接后的元组上过滤。
+ * 不论在哪一侧建立hash表，输出的元组都是左侧在前，右侧在后
+ */
+class HashJoinExeNode : public ExecutionNode {
+public:
+  HashJoinExeNode() = default;
+  virtual ~HashJoinExeNode();
+
+  /**
+   * @param left_keys 连接键在左子节点输出中的位置
+   * @param right_keys 与left_keys一一对应，连接键在右子节点输出中的位置
+   * @param build_left 是否在左侧建立hash表
+   * @param condition_filters 等值条件之外的连接条件
+   */
+  RC init(ExecutionNode *left, ExecutionNode *right, std::vector<int> &&left_keys, std::vector<int> &&right_keys,
+          bool build_left, std::vector<DefaultConditionFilter *> &&condition_filters);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  bool keys_equal(const Tuple &build_tuple, const Tuple &probe_tuple) const;
+
+private:
+  ExecutionNode *left_ = nullptr;
+  ExecutionNode *right_ = nullptr;
+  std::vector<int> left_keys_;
+  std::vector<int> right_keys_;
+  bool build_left_ = false;
+  TupleSchema tuple_schema_;
   std::vector<DefaultConditionFilter *> condition_filters_;
+  CompositeConditionFilter condition_filter_;
+
+  std::vector<Tuple> build_tuples_;
+  std::unordered_map<std::string, std::vector<int>> hash_table_;  /// 连接键 -> build_tuples_中的下标
+  Tuple probe_tuple_;
+  const std::vector<int> *matches_ = nullptr;
+  size_t match_pos_ = 0;
+};
+
+/**
+ * 索引嵌套循环连接。对外侧的每个元组，用连接键在内表的索引上做等值查找，
+ * 内表不需要全表扫描。适合外侧较小、内表较大并且连接字段上有索引的情况
+ */
+class IndexNestedLoopJoinExeNode : public ExecutionNode {
+public:
+  IndexNestedLoopJoinExeNode() = default;
+  virtual ~IndexNestedLoopJoinExeNode();
+
+  /**
+   * @param outer_key 连接键在外侧输出中的位置
+   * @param inner_field 内表上的连接字段，这个字段上有单字段索引
+   * @param condition_filters 用来查找的等值条件之外的连接条件
+   */
+  RC init(ExecutionNode *outer, SelectExeNode *inner, int outer_key, const char *inner_field,
+          std::vector<DefaultConditionFilter *> &&condition_filters);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  ExecutionNode *outer_ = nullptr;
+  SelectExeNode *inner_ = nullptr;
+  int outer_key_ = -1;
+  std::string inner_field_;
+  int inner_key_ = -1;
+  TupleSchema tuple_schema_;
+  std::vector<DefaultConditionFilter *> condition_filters_;
+  CompositeConditionFilter condition_filter_;
+
+  Tuple outer_tuple_;
+  bool inner_opened_ = false;
+  std::vector<char> key_;
+};
+
+/**
+ * 等值连接的sort-merge join。两侧的输入都已经按连接键升序排列(比如按索引顺序扫描)，
+ * 同时向前推进两侧，只需要缓存右侧连接键相同的一组元组。连接键为null的元组被跳过
+ */
+class SortMergeJoinExeNode : public ExecutionNode {
+public:
+  SortMergeJoinExeNode() = default;
+  virtual ~SortMergeJoinExeNode();
+
+  /**
+   * @param left_key 连接键在左子节点输出中的位置
+   * @param right_key 连接键在右子节点输出中的位置
+   * @param condition_filters 等值条件之外的连接条件
+   */
+  RC init(ExecutionNode *left, ExecutionNode *right, int left_key, int right_key,
+          std::vector<DefaultConditionFilter *> &&condition_filters);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  RC next_left();
+  RC next_right();
+
+private:
+  ExecutionNode *left_ = nullptr;
+  ExecutionNode *right_ = nullptr;
+  int left_key_ = -1;
+  int right_key_ = -1;
+  TupleSchema tuple_schema_;
+  std::vector<DefaultConditionFilter *> condition_filters_;
+  CompositeConditionFilter condition_filter_;
+
+  Tuple left_tuple_;
+  Tuple right_tuple_;
+  bool left_valid_ = false;
+  bool right_valid_ = false;
+  std::vector<Tuple> right_group_;   /// 右侧连接键相同的一组元组
+  size_t group_pos_ = 0;
+};
+
+/**
+ * 排序。需要拿到子节点的全部元组之后才能输出第一个元组，超过内存预算时写临时文件做外部排序
+ */
+class SortExeNode : public ExecutionNode {
+public:
+  SortExeNode() = default;
+  virtual ~SortExeNode();
+
+  /**
+   * @param indexes 排序字段在子节点输出中的位置，按优先级排列
+   * @param orders 与indexes对应，大于0表示升序，否则是降序
+   * @param limit 大于等于0时只需要输出前limit个元组
+   */
+  RC init(ExecutionNode *child, std::vector<int> &&indexes, std::vector<int> &&orders, int64_t limit = -1);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return child_->schema();
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  ExecutionNode *child_ = nullptr;
+  std::vector<int> indexes_;
+  std::vector<int> orders_;
+  int64_t limit_ = -1;
+  ExternalSorter *sorter_ = nullptr;
+  int spilled_runs_ = 0;
+};
+
+/**
+ * 聚合(包括group by)。子节点的元组逐条放入hash表中按分组聚合，全部输入结束后输出各个分组的结果
+ */
+class AggregateExeNode : public ExecutionNode {
+public:
+  AggregateExeNode() = default;
+  virtual ~AggregateExeNode();
+
+  RC init(ExecutionNode *child, const char *db, const Selects *selects);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return desc_.schema;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  ExecutionNode *child_ = nullptr;
+  AggregationDesc desc_;
+  std::vector<Tuple> results_;
+  size_t pos_ = 0;
+};
+
+/**
+ * 不扫描记录的聚合。单表上没有过滤和分组时，COUNT(*)和非空字段的COUNT由页头中的记录数得到，
+ * 单字段索引上字段的MIN/MAX取索引两端第一条可见的记录。输出一行，与AggregateExeNode的结果相同
+ */
+class MetadataAggregateExeNode : public ExecutionNode {
+public:
+  MetadataAggregateExeNode() = default;
+  virtual ~MetadataAggregateExeNode() = default;
+
+  /**
+   * 是否所有的聚合函数都可以这样计算
+   * @param input_schema 解析desc时使用的表扫描的schema
+   */
+  static bool applicable(const Table *table, const TupleSchema &input_schema, const AggregationDesc &desc);
+
+  RC init(Trx *trx, Table *table, const TupleSchema &input_schema, AggregationDesc &&desc);
+
+  std::string description() const override;
+  const TupleSchema &schema() const override {
+    return desc_.schema;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  Trx *trx_ = nullptr;
+  Table *table_ = nullptr;
+  TupleSchema input_schema_;
+  AggregationDesc desc_;
+  Tuple result_;
+  bool output_ = false;
+};
+
+/**
+ * 投影，从子节点的元组中取出需要输出的列
+ */
+class ProjectExeNode : public ExecutionNode {
+public:
+  ProjectExeNode() = default;
+  virtual ~ProjectExeNode();
+
+  /**
+   * @param indexes 输出的每一列在子节点输出中的位置
+   */
+  RC init(ExecutionNode *child, TupleSchema &&tuple_schema, std::vector<int> &&indexes);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return tuple_schema_;
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  ExecutionNode *child_ = nullptr;
+  TupleSchema tuple_schema_;
+  std::vector<int> indexes_;
+};
+
+/**
+ * 跳过前offset个元组，最多输出limit个元组。输出够了就不再从子节点拉取
+ */
+class LimitExeNode : public ExecutionNode {
+public:
+  LimitExeNode() = default;
+  virtual ~LimitExeNode();
+
+  RC init(ExecutionNode *child, int limit, int offset);
+
+  std::string description() const override;
+  std::vector<ExecutionNode *> children() const override;
+  const TupleSchema &schema() const override {
+    return child_->schema();
+  }
+protected:
+  RC do_open() override;
+  RC do_next(Tuple &tuple) override;
+  RC do_close() override;
+
+private:
+  ExecutionNode *child_ = nullptr;
+  int limit_ = -1;
+  int offset_ = 0;
+  int skipped_ = 0;
+  int count_ = 0;
 };
 
 #endif //__OBSERVER_SQL_EXECUTOR_EXECUTION_NODE_H_
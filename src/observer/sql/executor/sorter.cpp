@@ -0,0 +1,385 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+#include "sql/executor/sorter.h"
+#include "common/log/log.h"
+
+/**
+ * 一个值的排序键：null在前，数值统一转换成double后按IEEE754的位模式调整成无符号大端序，
+ * 字符串以'\0'结尾。降序时把这个值的所有字节取反
+ */
+static void append_sort_key(const TupleValue &value, bool desc, std::string &key) {
+  const size_t start = key.size();
+  switch (value.type()) {
+    case IS_NULL: {
+      key.push_back(0);
+    }
+    break;
+    case INTS:
+    case FLOATS: {
+      double number = value.type() == INTS ? (double)value.int_value() : (double)value.float_value();
+      if (number == 0) {
+        number = 0; // -0和0相等
+      }
+      uint64_t bits = 0;
+      memcpy(&bits, &number, sizeof(bits));
+      bits = (bits >> 63) ? ~bits : (bits | (1ULL << 63));
+      key.push_back(1);
+      for (int shift = 56; shift >= 0; shift -= 8) {
+        key.push_back((char)(bits >> shift));
+      }
+    }
+    break;
+    default: {
+      key.push_back(1);
+      key.append(value.string_value(), value.length());
+      key.push_back(0);
+    }
+    break;
+  }
+
+  if (desc) {
+    for (size_t i = start; i < key.size(); i++) {
+      key[i] = ~key[i];
+    }
+  }
+}
+
+static bool entry_key_less(const std::string &key_1, const std::string &key_2) {
+  return key_1 < key_2;
+}
+
+/**
+ * 写在临时文件中的一个有序段。每个元组前面是它的排序键
+ */
+class ExternalSorter::Run {
+public:
+  ~Run() {
+    if (file_ != nullptr) {
+      fclose(file_);
+      file_ = nullptr;
+    }
+  }
+
+  RC open() {
+    file_ = tmpfile();
+    if (file_ == nullptr) {
+      LOG_ERROR("Failed to create temporary file for sort. errno=%d:%s", errno, strerror(errno));
+      return RC::IOERR;
+    }
+    return RC::SUCCESS;
+  }
+
+  RC write(const Entry &entry) {
+    const uint32_t key_len = entry.key.size();
+    if (fwrite(&key_len, sizeof(key_len), 1, file_) != 1 ||
+        fwrite(entry.key.data(), key_len, 1, file_) != 1) {
+      return RC::IOERR_WRITE;
+    }
+    return write_tuple(file_, entry.tuple);
+  }
+
+  /**
+   * 从头开始读，读出第一个元组
+   */
+  RC rewind_read() {
+    rewind(file_);
+    eof_ = false;
+    return read_next();
+  }
+
+  /**
+   * 读出下一个元组放在current()中，段结束时eof()为true
+   */
+  RC read_next() {
+    uint32_t key_len = 0;
+    if (fread(&key_len, sizeof(key_len), 1, file_) != 1) {
+      if (feof(file_)) {
+        eof_ = true;
+        return RC::SUCCESS;
+      }
+      return RC::IOERR_READ;
+    }
+    current_.key.resize(key_len);
+    if (fread(&current_.key[0], key_len, 1, file_) != 1) {
+      return RC::IOERR_SHORT_READ;
+    }
+    RC rc = read_tuple(file_, current_.tuple);
+    return rc == RC::RECORD_EOF ? RC::IOERR_SHORT_READ : rc;
+  }
+
+  bool eof() const {
+    return eof_;
+  }
+  Entry &current() {
+    return current_;
+  }
+
+private:
+  FILE *file_ = nullptr;
+  Entry current_;
+  bool eof_ = false;
+};
+
+/**
+ * 败者树。内部节点记录比较中输掉的段，tree_[0]是最终的胜者，即当前键最小的段。
+ * 取走胜者的元组之后只需要沿着它到根的路径重新比较，每个元组的比较次数是log(段数)
+ */
+class ExternalSorter::LoserTree {
+public:
+  explicit LoserTree(const std::vector<Run *> &runs) : runs_(runs), tree_(runs.size(), -1) {
+    for (int i = (int)runs_.size() - 1; i >= 0; i--) {
+      adjust(i);
+    }
+  }
+
+  Run *winner() const {
+    return runs_[tree_[0]];
+  }
+
+  /**
+   * 胜者的段读出下一个元组之后，重新选出胜者
+   */
+  void replay() {
+    adjust(tree_[0]);
+  }
+
+private:
+  void adjust(int run) {
+    const int run_num = runs_.size();
+    for (int node = (run + run_num) / 2; node > 0; node /= 2) {
+      if (beats(tree_[node], run)) {
+        std::swap(run, tree_[node]);
+      }
+    }
+    tree_[0] = run;
+  }
+
+  /**
+   * 段run_1是否排在段run_2之前。-1只在建树时出现，比任何段都小；结束的段比任何段都大
+   */
+  bool beats(int run_1, int run_2) const {
+    if (run_1 < 0 || run_2 < 0) {
+      return run_1 < 0;
+    }
+    if (runs_[run_1]->eof() || runs_[run_2]->eof()) {
+      return runs_[run_2]->eof() && !runs_[run_1]->eof();
+    }
+    return entry_key_less(runs_[run_1]->current().key, runs_[run_2]->current().key);
+  }
+
+private:
+  const std::vector<Run *> &runs_;
+  std::vector<int> tree_;
+};
+
+ExternalSorter::ExternalSorter(const std::vector<int> &indexes, const std::vector<int> &orders,
+                               size_t memory_budget, int64_t limit)
+    : indexes_(indexes), orders_(orders), memory_budget_(memory_budget), limit_(limit), top_n_(limit >= 0) {
+}
+
+ExternalSorter::~ExternalSorter() {
+  delete loser_tree_;
+  loser_tree_ = nullptr;
+  for (Run *run : runs_) {
+    delete run;
+  }
+  runs_.clear();
+}
+
+static size_t entry_memory_size(const std::string &key, const Tuple &tuple) {
+  return sizeof(std::string) + key.capacity() + tuple.memory_size();
+}
+
+void ExternalSorter::make_key(const Tuple &tuple, std::string &key) {
+  key.clear();
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    append_sort_key(tuple.get(indexes_[i]), orders_[i] <= 0, key);
+  }
+  // 输入序号作为最后的比较条件，相等的元组保持输入的顺序
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    key.push_back((char)(sequence_ >> shift));
+  }
+  sequence_++;
+}
+
+void ExternalSorter::add_top_n(Entry &&entry) {
+  // entries_是按排序键的大顶堆，堆顶是目前保留的元组中排在最后的
+  auto less = [](const Entry &entry_1, const Entry &entry_2) {
+    return entry_key_less(entry_1.key, entry_2.key);
+  };
+  if ((int64_t)entries_.size() < limit_) {
+    memory_usage_ += entry_memory_size(entry.key, entry.tuple);
+    entries_.push_back(std::move(entry));
+    std::push_heap(entries_.begin(), entries_.end(), less);
+  } else if (limit_ > 0 && entry_key_less(entry.key, entries_.front().key)) {
+    std::pop_heap(entries_.begin(), entries_.end(), less);
+    memory_usage_ -= entry_memory_size(entries_.back().key, entries_.back().tuple);
+    memory_usage_ += entry_memory_size(entry.key, entry.tuple);
+    entries_.back() = std::move(entry);
+    std::push_heap(entries_.begin(), entries_.end(), less);
+  }
+
+  if (memory_usage_ >= memory_budget_) {
+    // limit太大，堆放不下时改为外部排序，只是每个段只需要写前limit个元组
+    top_n_ = false;
+  }
+}
+
+RC ExternalSorter::add(Tuple &&tuple) {
+  Entry entry;
+  make_key(tuple, entry.key);
+  entry.tuple = std::move(tuple);
+  if (top_n_) {
+    add_top_n(std::move(entry));
+    return RC::SUCCESS;
+  }
+
+  memory_usage_ += entry_memory_size(entry.key, entry.tuple);
+  entries_.push_back(std::move(entry));
+  if (memory_usage_ >= memory_budget_) {
+    return spill();
+  }
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::spill() {
+  std::sort(entries_.begin(), entries_.end(), [](const Entry &entry_1, const Entry &entry_2) {
+    return entry_key_less(entry_1.key, entry_2.key);
+  });
+
+  Run *run = new Run;
+  runs_.push_back(run);
+  spilled_runs_++;
+  RC rc = run->open();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  size_t num = entries_.size();
+  if (limit_ >= 0 && (size_t)limit_ < num) {
+    num = limit_;
+  }
+  for (size_t i = 0; i < num; i++) {
+    rc = run->write(entries_[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to write sorted run. rc=%d:%s", rc, strrc(rc));
+      return rc;
+    }
+  }
+  entries_.clear();
+  memory_usage_ = 0;
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::merge(std::vector<Run *> &runs, Run *output) {
+  for (Run *run : runs) {
+    RC rc = run->rewind_read();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  LoserTree loser_tree(runs);
+  for (int64_t num = 0; limit_ < 0 || num < limit_; num++) {
+    Run *winner = loser_tree.winner();
+    if (winner->eof()) {
+      break;
+    }
+    RC rc = output->write(winner->current());
+    if (rc == RC::SUCCESS) {
+      rc = winner->read_next();
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    loser_tree.replay();
+  }
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::finish() {
+  if (runs_.empty()) {
+    std::sort(entries_.begin(), entries_.end(), [](const Entry &entry_1, const Entry &entry_2) {
+      return entry_key_less(entry_1.key, entry_2.key);
+    });
+    pos_ = 0;
+    return RC::SUCCESS;
+  }
+
+  RC rc = RC::SUCCESS;
+  if (!entries_.empty()) {
+    rc = spill();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  // 段太多时先把前面的段归并成更长的段，避免同时打开太多文件
+  while (runs_.size() > (size_t)MERGE_WAYS) {
+    std::vector<Run *> inputs(runs_.begin(), runs_.begin() + MERGE_WAYS);
+    runs_.erase(runs_.begin(), runs_.begin() + MERGE_WAYS);
+    Run *output = new Run;
+    runs_.push_back(output);
+    spilled_runs_++;
+    rc = output->open();
+    if (rc == RC::SUCCESS) {
+      rc = merge(inputs, output);
+    }
+    for (Run *run : inputs) {
+      delete run;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to merge sorted runs. rc=%d:%s", rc, strrc(rc));
+      return rc;
+    }
+  }
+
+  for (Run *run : runs_) {
+    rc = run->rewind_read();
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to read sorted run. rc=%d:%s", rc, strrc(rc));
+      return rc;
+    }
+  }
+  loser_tree_ = new LoserTree(runs_);
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::next(Tuple &tuple) {
+  if (limit_ >= 0 && output_num_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  if (loser_tree_ == nullptr) {
+    if (pos_ >= entries_.size()) {
+      return RC::RECORD_EOF;
+    }
+    tuple = std::move(entries_[pos_++].tuple);
+    output_num_++;
+    return RC::SUCCESS;
+  }
+
+  Run *winner = loser_tree_->winner();
+  if (winner->eof()) {
+    return RC::RECORD_EOF;
+  }
+  tuple = std::move(winner->current().tuple);
+  RC rc = winner->read_next();
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to read sorted run. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+  loser_tree_->replay();
+  output_num_++;
+  return RC::SUCCESS;
+}
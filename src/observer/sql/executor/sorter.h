@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_EXECUTOR_SORTER_H_
+#define __OBSERVER_SQL_EXECUTOR_SORTER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "rc.h"
+#include "sql/executor/tuple.h"
+
+/**
+ * 有内存预算的排序。
+ * 每个元组按排序字段生成一个规范化的二进制排序键，直接按字节比较就是要求的顺序(包括降序和null)，
+ * 键的最后是元组的输入序号，所以排序是稳定的。
+ * 内存中的元组超过预算时排好序写到临时文件中成为一个有序段，输入结束后用败者树多路归并所有的段。
+ * 知道只需要前limit个元组时，用大小为limit的堆保留最小的元组，不需要排序全部输入
+ */
+class ExternalSorter {
+public:
+  static const size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+  static const int MERGE_WAYS = 64;  /// 一次最多归并的段数，段更多时先归并成更长的段
+
+  /**
+   * @param indexes 排序字段在元组中的位置，按优先级排列
+   * @param orders 与indexes对应，大于0表示升序，否则是降序
+   * @param limit 大于等于0时只输出排序结果的前limit个元组
+   */
+  ExternalSorter(const std::vector<int> &indexes, const std::vector<int> &orders,
+                 size_t memory_budget = DEFAULT_MEMORY_BUDGET, int64_t limit = -1);
+  ~ExternalSorter();
+
+  RC add(Tuple &&tuple);
+
+  /**
+   * 输入结束，准备按顺序输出
+   */
+  RC finish();
+
+  /**
+   * @return 没有更多元组时返回RECORD_EOF
+   */
+  RC next(Tuple &tuple);
+
+  /**
+   * 写到临时文件中的有序段个数，包括多轮归并中生成的
+   */
+  int spilled_runs() const {
+    return spilled_runs_;
+  }
+
+private:
+  struct Entry {
+    std::string key;
+    Tuple tuple;
+  };
+
+  class Run;
+  class LoserTree;
+
+private:
+  void make_key(const Tuple &tuple, std::string &key);
+  void add_top_n(Entry &&entry);
+  RC spill();
+  RC merge(std::vector<Run *> &runs, Run *output);
+
+private:
+  std::vector<int> indexes_;
+  std::vector<int> orders_;
+  size_t memory_budget_;
+  int64_t limit_;
+  bool top_n_;                 /// 用堆保留前limit个元组
+  uint64_t sequence_ = 0;
+  size_t memory_usage_ = 0;
+
+  std::vector<Entry> entries_;
+  size_t pos_ = 0;             /// 没有写临时文件时下一个输出的元组
+  int64_t output_num_ = 0;
+
+  std::vector<Run *> runs_;
+  LoserTree *loser_tree_ = nullptr;
+  int spilled_runs_ = 0;
+};
+
+#endif //__OBSERVER_SQL_EXECUTOR_SORTER_H_
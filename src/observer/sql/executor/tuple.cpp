@@ -12,17 +12,13 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2021/5/14.
 //
 
+#include <algorithm>
+
 #include "sql/executor/tuple.h"
 #include "storage/common/table.h"
 #include "common/log/log.h"
-#include "storage/common/mydate.h"
-
-Tuple::Tuple(const Tuple &other) {
-  LOG_PANIC("Copy constructor of tuple is not supported");
-  exit(1);
-}
 
-Tuple::Tuple(Tuple &&other) noexcept : values_(std::move(other.values_)) {
+Tuple::Tuple(Tuple &&other) noexcept : cells_(std::move(other.cells_)), data_(std::move(other.data_)) {
 }
 
 Tuple & Tuple::operator=(Tuple &&other) noexcept {
@@ -30,35 +26,100 @@ Tuple & Tuple::operator=(Tuple &&other) noexcept {
     return *this;
   }
 
-  values_.clear();
-  values_.swap(other.values_);
+  cells_.clear();
+  cells_.swap(other.cells_);
+  data_.clear();
+  data_.swap(other.data_);
   return *this;
 }
 
 Tuple::~Tuple() {
 }
 
-// add (Value && value)
-void Tuple::add(TupleValue *value) {
-  values_.emplace_back(value);
-}
-void Tuple::add(const std::shared_ptr<TupleValue> &other) {
-  values_.emplace_back(other);
-}
 void Tuple::add(int value) {
-  add(new IntValue(value));
+  Cell cell;
+  cell.type = INTS;
+  cell.int_value = value;
+  cells_.push_back(cell);
 }
 
 void Tuple::add(float value) {
-  add(new FloatValue(value));
+  Cell cell;
+  cell.type = FLOATS;
+  cell.float_value = value;
+  cells_.push_back(cell);
 }
 
 void Tuple::add(const char *s, int len) {
-  add(new StringValue(s, len));
+  Cell cell;
+  cell.type = CHARS;
+  cell.offset = data_.size();
+  cell.length = len;
+  cells_.push_back(cell);
+  data_.insert(data_.end(), s, s + len);
+  data_.push_back('\0');
+}
+
+void Tuple::print(std::ostream &os, std::string &line) const {
+  line.clear();
+  const int value_num = size();
+  for (int i = 0; i < value_num - 1; i++) {
+    get(i).append_to(line);
+    line.append(" | ", 3);
+  }
+  get(value_num - 1).append_to(line);
+  line.push_back('\n');
+  os.write(line.data(), line.size());
 }
 
 void Tuple::add() {
-  add(new NullValue());
+  Cell cell;
+  cell.type = IS_NULL;
+  cell.int_value = 0;
+  cells_.push_back(cell);
+}
+
+void Tuple::add(const TupleValue &value) {
+  switch (value.type()) {
+    case INTS:
+      add(value.int_value());
+      break;
+    case FLOATS:
+      add(value.float_value());
+      break;
+    case IS_NULL:
+      add();
+      break;
+    default:
+      add(value.string_value(), value.length());
+      break;
+  }
+}
+
+void Tuple::append(const Tuple &other) {
+  const size_t cell_num = cells_.size();
+  const uint32_t data_offset = data_.size();
+  cells_.insert(cells_.end(), other.cells_.begin(), other.cells_.end());
+  data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+  if (data_offset == 0 || other.data_.empty()) {
+    return;
+  }
+  for (size_t i = cell_num; i < cells_.size(); i++) {
+    Cell &cell = cells_[i];
+    if (cell.type != INTS && cell.type != FLOATS && cell.type != IS_NULL) {
+      cell.offset += data_offset;
+    }
+  }
+}
+
+void Tuple::reserve(int value_num, int data_size) {
+  cells_.reserve(value_num);
+  data_.reserve(data_size);
+}
+
+void Tuple::clear() {
+  cells_.clear();
+  data_.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -151,7 +212,7 @@ void TupleSchema::print(std::ostream &os) const {
   if ((table_names.size() > 1) && (strcmp("*", fields_.back().table_name()) != 0)) {
     os << fields_.back().table_name() << ".";
   }
-  os << fields_.back().field_name() << std::endl;
+  os << fields_.back().field_name() << '\n';
 }
 
 bool is_aggregation_schema(const char *attribute_name, char *&aggregation_filed, char *&field_name) {
@@ -237,14 +298,14 @@ void TupleSchema::print(std::ostream &os, bool print_table_name) const {
     if (print_table_name) {
       os << fields_.back().table_name() << ".";
     } 
-    os << field_name << ")" << std::endl;
+    os << field_name << ")" << '\n';
   }
   else
   {
     if (print_table_name && (strcmp("*", fields_.back().table_name()) != 0)) {
       os << fields_.back().table_name() << ".";
     }
-    os << fields_.back().field_name() << std::endl;
+    os << fields_.back().field_name() << '\n';
   }
 }
 
@@ -274,11 +335,7 @@ void TupleSet::add(Tuple &&tuple) {
 }
 
 void TupleSet::add_(const Tuple &tuple) {
-  Tuple tuple_;
-  for (int i=0; i<tuple.size(); i++) {
-    tuple_.add(tuple.get_pointer(i));
-  }
-  tuples_.emplace_back(std::move(tuple_));
+  tuples_.emplace_back(tuple);
 }
 
 void TupleSet::clear() {
@@ -296,30 +353,13 @@ void TupleSet::print(std::ostream &os) const {
     return;
   }
   schema_.print(os);
-  
-  for (const Tuple &item : tuples_) {
-    const std::vector<std::shared_ptr<TupleValue>> &values = item.values();
-    for (std::vector<std::shared_ptr<TupleValue>>::const_iterator iter = values.begin(), end = --values.end();
-          iter != end; ++iter) {
-      (*iter)->to_string(os);
-      os << " | ";
-    }
-    values.back()->to_string(os);
-    os << std::endl;
-  }
+  print_tuple(os);
 }
 
 void TupleSet::print_tuple(std::ostream &os) const {
-  
+  std::string line;
   for (const Tuple &item : tuples_) {
-    const std::vector<std::shared_ptr<TupleValue>> &values = item.values();
-    for (std::vector<std::shared_ptr<TupleValue>>::const_iterator iter = values.begin(), end = --values.end();
-          iter != end; ++iter) {
-      (*iter)->to_string(os);
-      os << " | ";
-    }
-    values.back()->to_string(os);
-    os << std::endl;
+    item.print(os, line);
   }
 }
 
@@ -330,17 +370,7 @@ void TupleSet::print(std::ostream &os, bool print_table_name) const{
   }
 
   schema_.print(os, print_table_name);
-
-  for (const Tuple &item : tuples_) {
-    const std::vector<std::shared_ptr<TupleValue>> &values = item.values();
-    for (std::vector<std::shared_ptr<TupleValue>>::const_iterator iter = values.begin(), end = --values.end();
-          iter != end; ++iter) {
-      (*iter)->to_string(os);
-      os << " | ";
-    }
-    values.back()->to_string(os);
-    os << std::endl;
-  }
+  print_tuple(os);
 }
 
 void TupleSet::set_schema(const TupleSchema &schema) {
@@ -368,13 +398,12 @@ std::string TupleSet::to_string(char *table_name) const {
   }
   
   for (const Tuple &item : tuples_) {
-    const std::vector<std::shared_ptr<TupleValue>> &values = item.values();
-    for (std::vector<std::shared_ptr<TupleValue>>::const_iterator iter = values.begin(), end = --values.end();
-          iter != end; ++iter) {
-      re += (*iter)->to_string();
+    const int value_num = item.size();
+    for (int i = 0; i < value_num - 1; i++) {
+      re += item.get(i).to_string();
       re += " | ";
     }
-    re += values.back()->to_string() + "\n";
+    re += item.get(value_num - 1).to_string() + "\n";
     // re += std::endl;
   }
   return re;
@@ -390,99 +419,62 @@ std::string TupleSet::header_to_string(bool printTableName) const {
   return re;
 }
 
-bool compare_tuple( Tuple *tuple_p1, Tuple *tuple_p2, std::vector<int> &indexs, std::vector<int> &orders) {
-  for (int i = 0; i<indexs.size(); i++) {
-    if (tuple_p1->get_pointer(indexs[i])->type() == IS_NULL || tuple_p2->get_pointer(indexs[i])->type() == IS_NULL) {
-      return false;
+RC resolve_order_by(const Selects &selects, const TupleSchema &schema, std::vector<int> &indexes, std::vector<int> &orders) {
+  for (int i = selects.condition_num - 1; i >= 0; i--) {
+    const Condition &condition = selects.conditions[i];
+    CompOp compop = condition.comp;
+    if (compop != ORDER_BY_ASC && compop != ORDER_BY_DESC) {
+      continue;
     }
-    int cmp = tuple_p1->get_pointer(indexs[i])->compare(*(tuple_p2->get_pointer(indexs[i])));
-    if (orders[i] > 0) {
-      if (cmp > 0) {
-        return true;
-      } else if (cmp < 0) {
-        return false;
-      } else {
-        continue;
+
+    const RelAttr &left_attr = condition.left_attr;
+    int compare_index = -1;
+    if (left_attr.relation_name == nullptr) {
+      if (selects.relation_num != 1) {
+        return RC::SCHEMA_FIELD_MISSING;
       }
+      compare_index = schema.index_of_field(selects.relations[0], left_attr.attribute_name);
     } else {
-      if (cmp < 0) {
-        return true;
-      } else if (cmp > 0) {
-        return false;
-      } else {
-        continue;
-      }
+      compare_index = schema.index_of_field(left_attr.relation_name, left_attr.attribute_name);
+    }
+    if (compare_index == -1) {
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    indexes.push_back(compare_index);
+    orders.push_back(compop == ORDER_BY_ASC ? 1 : -1);
+  }
+  return RC::SUCCESS;
+}
+
+bool tuple_order_less(const Tuple &tuple_1, const Tuple &tuple_2, const std::vector<int> &indexes, const std::vector<int> &orders) {
+  for (size_t i = 0; i < indexes.size(); i++) {
+    const TupleValue &value_1 = tuple_1.get(indexes[i]);
+    const TupleValue &value_2 = tuple_2.get(indexes[i]);
+    const bool null_1 = value_1.type() == IS_NULL;
+    const bool null_2 = value_2.type() == IS_NULL;
+    int cmp = 0;
+    if (null_1 || null_2) {
+      cmp = (int)null_2 - (int)null_1;
+    } else {
+      cmp = value_1.compare(value_2);
+    }
+    if (cmp != 0) {
+      return orders[i] > 0 ? cmp < 0 : cmp > 0;
     }
   }
   return false;
 }
 
 RC TupleSet::sort(const Selects &selects) {
-  std::vector<int> indexs;
+  std::vector<int> indexes;
   std::vector<int> orders;
-
-  for (int i = selects.condition_num - 1; i >= 0; i--)
-  {
-    const Condition &condition = selects.conditions[i];
-    CompOp compop = condition.comp;
-
-    if (compop == ORDER_BY_ASC) {
-      /* code */
-      const RelAttr &left_attr = condition.left_attr;
-      int compare_index = -1;
-      if (left_attr.relation_name == nullptr) {
-        if (selects.relation_num != 1) {
-          return RC::SCHEMA_FIELD_MISSING;
-        }
-        compare_index = schema_.index_of_field(selects.relations[0], left_attr.attribute_name);
-      } else {
-        compare_index = schema_.index_of_field(left_attr.relation_name, left_attr.attribute_name);
-      }
-      if (compare_index == -1) {
-        return RC::SCHEMA_FIELD_MISSING;
-      }
-      indexs.push_back(compare_index);
-      orders.push_back(1);
-    } else if (compop == ORDER_BY_DESC) {
-      const RelAttr &left_attr = condition.left_attr;
-      int compare_index = -1;
-      if (left_attr.relation_name == nullptr) {
-        if (selects.relation_num != 1) {
-          return RC::SCHEMA_FIELD_MISSING;
-        }
-        compare_index = schema_.index_of_field(selects.relations[0], left_attr.attribute_name);
-      } else {
-        compare_index = schema_.index_of_field(left_attr.relation_name, left_attr.attribute_name);
-      }
-      
-      if (compare_index == -1) {
-        return RC::GENERIC_ERROR;
-      }
-      indexs.push_back(compare_index);
-      orders.push_back(-1);
-    }
-  }
-  for (size_t j = 0; j < tuples_.size(); j++) {
-    size_t min = j;
-    Tuple *tuple_p1 = &tuples_[min];
-    Tuple *tuple_p2 = nullptr;
-    for (size_t k = j + 1; k < tuples_.size(); k++)
-    {
-      tuple_p2 = &tuples_[k];
-      if (compare_tuple(tuple_p1, tuple_p2, indexs, orders))
-      {
-        min = k;
-        tuple_p1 = &tuples_[min];
-      }
-    }
-    if (min != j)
-    {
-      tuple_p2 = &tuples_[j];
-      Tuple tmp = std::move(tuples_[min]);
-      tuples_[min] = std::move(tuples_[j]);
-      tuples_[j] = std::move(tmp);
-    }
+  RC rc = resolve_order_by(selects, schema_, indexes, orders);
+  if (rc != RC::SUCCESS) {
+    return rc;
   }
+  std::stable_sort(tuples_.begin(), tuples_.end(), [&indexes, &orders](const Tuple &tuple_1, const Tuple &tuple_2) {
+    return tuple_order_less(tuple_1, tuple_2, indexes, orders);
+  });
   return RC::SUCCESS;
 }
 
@@ -507,6 +499,90 @@ const std::vector<Tuple> &TupleSet::tuples() const {
 }
 
 /////////////////////////////////////////////////////////////////////////////
+RC write_tuple(FILE *file, const Tuple &tuple) {
+  bool ok = true;
+  const int32_t value_num = tuple.size();
+  ok = ok && fwrite(&value_num, sizeof(value_num), 1, file) == 1;
+  for (int i = 0; ok && i < value_num; i++) {
+    const TupleValue value = tuple.get(i);
+    const char type = (char)value.type();
+    ok = ok && fwrite(&type, sizeof(type), 1, file) == 1;
+    switch (value.type()) {
+      case INTS: {
+        int int_value = value.int_value();
+        ok = ok && fwrite(&int_value, sizeof(int_value), 1, file) == 1;
+      }
+      break;
+      case FLOATS: {
+        float float_value = value.float_value();
+        ok = ok && fwrite(&float_value, sizeof(float_value), 1, file) == 1;
+      }
+      break;
+      case IS_NULL: {
+      }
+      break;
+      default: {
+        const int32_t len = value.length();
+        ok = ok && fwrite(&len, sizeof(len), 1, file) == 1;
+        ok = ok && (len == 0 || fwrite(value.string_value(), len, 1, file) == 1);
+      }
+      break;
+    }
+  }
+  return ok ? RC::SUCCESS : RC::IOERR_WRITE;
+}
+
+RC read_tuple(FILE *file, Tuple &tuple) {
+  int32_t value_num = 0;
+  if (fread(&value_num, sizeof(value_num), 1, file) != 1) {
+    return feof(file) ? RC::RECORD_EOF : RC::IOERR_READ;
+  }
+  Tuple out;
+  std::string str;
+  for (int i = 0; i < value_num; i++) {
+    char type = 0;
+    if (fread(&type, sizeof(type), 1, file) != 1) {
+      return RC::IOERR_SHORT_READ;
+    }
+    switch ((AttrType)type) {
+      case INTS: {
+        int int_value = 0;
+        if (fread(&int_value, sizeof(int_value), 1, file) != 1) {
+          return RC::IOERR_SHORT_READ;
+        }
+        out.add(int_value);
+      }
+      break;
+      case FLOATS: {
+        float float_value = 0;
+        if (fread(&float_value, sizeof(float_value), 1, file) != 1) {
+          return RC::IOERR_SHORT_READ;
+        }
+        out.add(float_value);
+      }
+      break;
+      case IS_NULL: {
+        out.add();
+      }
+      break;
+      default: {
+        int32_t len = 0;
+        if (fread(&len, sizeof(len), 1, file) != 1) {
+          return RC::IOERR_SHORT_READ;
+        }
+        str.resize(len);
+        if (len > 0 && fread(&str[0], len, 1, file) != 1) {
+          return RC::IOERR_SHORT_READ;
+        }
+        out.add(str.data(), len);
+      }
+      break;
+    }
+  }
+  tuple = std::move(out);
+  return RC::SUCCESS;
+}
+
 TupleRecordConverter::TupleRecordConverter(Table *table, TupleSet &tuple_set) :
       table_(table), tuple_set_(tuple_set){
 }
@@ -525,12 +601,20 @@ TupleRecordConverter::TupleRecordConverter(Table *table, TupleSet &tuple_set) :
 // }
 
 void TupleRecordConverter::add_record(const char *record) {
-  const TupleSchema &schema = tuple_set_.schema();
   Tuple tuple;
-  const TableMeta &table_meta = table_->table_meta();
+  record_to_tuple(table_, tuple_set_.schema(), record, tuple);
+  tuple_set_.add(std::move(tuple));
+}
+
+void TupleRecordConverter::record_to_tuple(const Table *table, const TupleSchema &schema, const char *record, Tuple &tuple) {
+  const TableMeta &table_meta = table->table_meta();
   for (const TupleField &field : schema.fields()) {
     const FieldMeta *field_meta = table_meta.field(field.field_name());
     assert(field_meta != nullptr);
+    if (field_meta->is_null(record)) {
+      tuple.add();
+      continue;
+    }
     switch (field_meta->type()) {
       case TEXT: {
         const char *s = record + field_meta->offset();
@@ -548,32 +632,19 @@ void TupleRecordConverter::add_record(const char *record) {
         tuple.add(value);
       }
       break;
-      case INTS_NULLABLE: {
-        int is_null = *(int*)(record + field_meta->offset() + field_meta->len());
-        if (is_null == 1) {
-          tuple.add();
-        } else {
-          int value = *(int*)(record + field_meta->offset());
-          tuple.add(value);
-        }
-      }
-      break;
       case FLOATS: {
         float value = *(float *)(record + field_meta->offset());
         tuple.add(value);
       }
       break;
-      case FLOATS_NULLABLE: {
-        int is_null = *(int*)(record + field_meta->offset() + field_meta->len());
-        if (is_null == 1) {
-          tuple.add();
-        } else {
-          int value = *(float*)(record + field_meta->offset());
-          tuple.add(value);
-        }
-      }
-      break;
       case CHARS: {
+        if (field_meta->dict() != nullptr) {
+          // 字典编码的字段，记录中保存的是编码
+          int code = *(int *)(record + field_meta->offset());
+          const char *s = field_meta->dict()->value(code);
+          tuple.add(s, strlen(s));
+          break;
+        }
         const char *s = record + field_meta->offset();  // 现在当做Cstring来处理
         int length = field_meta->len();
         if(length < strlen(s))
@@ -582,44 +653,11 @@ void TupleRecordConverter::add_record(const char *record) {
           tuple.add(s, strlen(s));
       }
       break;
-      case CHARS_NULLABLE: {
-        int is_null = *(int*)(record + field_meta->offset() + field_meta->len());
-        if (is_null == 1) {
-          tuple.add();
-        } else {
-          const char *s = record + field_meta->offset();  // 现在当做Cstring来处理
-          int length = field_meta->len();
-          if(length < strlen(s))
-            tuple.add(s, length);
-          else  
-            tuple.add(s, strlen(s));
-        }
-      }
-      break;
       case DATES: {
-        // Xing 待修改
+        // 记录中是YYYYMMDD的整数，元组中是字符串
         int date_int = *(int*)(record + field_meta->offset());
-        // tuple.add(value);
-        // char date_str[11] = {0, };
-        // int2date(date, date_str);
-        MyDate date(date_int);
-        const char *date_cstr = date.toCStr();
-        tuple.add(date_cstr, strlen(date_cstr));
-      }
-      break;
-      case DATES_NULLABLE: {
-        int is_null = *(int*)(record + field_meta->offset() + field_meta->len());
-        if (is_null == 1) {
-          tuple.add();
-        } else {
-          int date_int = *(int*)(record + field_meta->offset());
-          // tuple.add(value);
-          // char date_str[11] = {0, };
-          // int2date(date, date_str);
-          MyDate date(date_int);
-          const char *date_cstr = date.toCStr();
-          tuple.add(date_cstr, strlen(date_cstr));
-        }
+        char date_str[DATE_FORMAT_SIZE];
+        tuple.add(date_str, format_date(date_int, date_str));
       }
       break;
       default: {
@@ -628,9 +666,6 @@ void TupleRecordConverter::add_record(const char *record) {
     }
   }
 
-  // for ()
-
-  tuple_set_.add(std::move(tuple));
 }
 
 
@@ -15,54 +15,96 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_SQL_EXECUTOR_TUPLE_H_
 #define __OBSERVER_SQL_EXECUTOR_TUPLE_H_
 
+#include <stdint.h>
+#include <stdio.h>
 #include <memory>
 #include <vector>
+#include "common/mm/arena.h"
 #include "sql/parser/parse_defs.h"
 #include "sql/parser/parse.h"
 #include "sql/executor/value.h"
 
 class Table;
 
+/**
+ * 一行数据。所有的值放在一个连续的数组中，整数和浮点数直接保存在数组里，
+ * 字符串统一放在一个缓冲区中，数组中只记录偏移和长度。
+ * 构造一个元组只需要两次内存分配，复制元组就是复制两块连续的内存。
+ * 内存从构造时当前线程的Arena中分配，随请求一起释放
+ */
 class Tuple {
 public:
   Tuple() = default;
 
-  Tuple(const Tuple &other);
+  Tuple(const Tuple &other) = default;
+  Tuple & operator=(const Tuple &other) = default;
 
   ~Tuple();
 
   Tuple(Tuple &&other) noexcept ;
   Tuple & operator=(Tuple &&other) noexcept ;
 
-  void add(TupleValue *value);
-  void add(const std::shared_ptr<TupleValue> &other);
   void add(int value);
   void add(float value);
   void add(const char *s, int len);
   void add();
+  void add(const TupleValue &value);
 
-  const std::vector<std::shared_ptr<TupleValue>> &values() const {
-    return values_;
-  }
+  /**
+   * 把另一个元组的所有值追加到当前元组后面
+   */
+  void append(const Tuple &other);
+
+  /**
+   * 按输出给客户端的格式输出一行。line是调用者复用的缓冲区，一行先拼到line中再一次写给os
+   */
+  void print(std::ostream &os, std::string &line) const;
+
+  void reserve(int value_num, int data_size);
+  void clear();
 
   int size() const {
-    return values_.size();
+    return cells_.size();
   }
 
-  const TupleValue &get(int index) const {
-    return *values_[index];
+  TupleValue get(int index) const {
+    const Cell &cell = cells_[index];
+    switch (cell.type) {
+      case INTS:
+        return TupleValue(cell.int_value);
+      case FLOATS:
+        return TupleValue(cell.float_value);
+      case IS_NULL:
+        return TupleValue();
+      default:
+        return TupleValue(data_.data() + cell.offset, cell.length);
+    }
   }
 
-  // TupleValue &get_unsafe(int index) const {
-  //   return *values_[index];
-  // }
+  AttrType type(int index) const {
+    return cells_[index].type;
+  }
 
-  const std::shared_ptr<TupleValue> &get_pointer(int index) const {
-    return values_[index];
+  /**
+   * 元组占用的内存，用于算子估算自己使用的内存
+   */
+  size_t memory_size() const {
+    return sizeof(Tuple) + cells_.capacity() * sizeof(Cell) + data_.capacity();
   }
 
 private:
-  std::vector<std::shared_ptr<TupleValue>>  values_;
+  struct Cell {
+    AttrType type;
+    union {
+      int int_value;
+      float float_value;
+      uint32_t offset;   /// 字符串在data_中的偏移
+    };
+    uint32_t length = 0; /// 字符串的长度，不包括结尾的'\0'
+  };
+
+  std::vector<Cell, common::ArenaAllocator<Cell>> cells_;
+  std::vector<char, common::ArenaAllocator<char>> data_;
 };
 
 class TupleField {
@@ -171,11 +213,35 @@ private:
   // bool aggregation_flag;
 };
 
+/**
+ * 找出order by的字段在schema中的位置
+ * @param indexes 排序字段的位置，按优先级排列
+ * @param orders 与indexes对应，1表示升序，-1表示降序
+ */
+RC resolve_order_by(const Selects &selects, const TupleSchema &schema, std::vector<int> &indexes, std::vector<int> &orders);
+
+/**
+ * 按照排序字段比较两个元组，tuple_1排在tuple_2之前时返回true。null小于任何值
+ */
+bool tuple_order_less(const Tuple &tuple_1, const Tuple &tuple_2, const std::vector<int> &indexes, const std::vector<int> &orders);
+
+/**
+ * 把元组写到临时文件中，或者读出write_tuple写入的元组。用于算子把超过内存预算的数据写到磁盘上
+ * @return read_tuple在没有更多元组时返回RECORD_EOF
+ */
+RC write_tuple(FILE *file, const Tuple &tuple);
+RC read_tuple(FILE *file, Tuple &tuple);
+
 class TupleRecordConverter {
 public:
   TupleRecordConverter(Table *table, TupleSet &tuple_set);
 
   void add_record(const char *record);
+
+  /**
+   * 按照schema把一条记录转换成元组
+   */
+  static void record_to_tuple(const Table *table, const TupleSchema &schema, const char *record, Tuple &tuple);
 private:
   Table *table_;
   TupleSet &tuple_set_;
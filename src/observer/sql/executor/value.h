@@ -16,187 +16,129 @@ See the Mulan PSL v2 for more details. */
 #define __OBSERVER_SQL_EXECUTOR_VALUE_H_
 
 #include <string.h>
-#include <iomanip>
 #include <string>
 #include <ostream>
 #include "sql/parser/parse_defs.h"
+#include "sql/executor/value_format.h"
 
+/**
+ * 元组中的一个值。整数和浮点数直接保存；字符串指向元组中保存字符串的缓冲区(以'\0'结尾)，
+ * 只在元组存在并且没有再添加值时有效。按值传递，不需要单独分配内存
+ */
 class TupleValue {
 public:
-  TupleValue() = default;
-  virtual ~TupleValue() = default;
-
-  virtual void to_string(std::ostream &os) const = 0;
-  virtual std::string to_string() const = 0;
-  virtual int compare(const TupleValue &other) const = 0;
-  virtual void add(const TupleValue &other) = 0;
-  virtual void divide(const size_t x) = 0;
-  virtual AttrType type() const = 0;
-private:
-};
-
-class IntValue : public TupleValue {
-public:
-  explicit IntValue(int value) : value_(value) {
+  TupleValue() : type_(IS_NULL), length_(0), string_value_(nullptr) {
+    int_value_ = 0;
   }
-
-  void to_string(std::ostream &os) const override {
-    os << value_;
+  explicit TupleValue(int value) : type_(INTS), length_(0), string_value_(nullptr) {
+    int_value_ = value;
   }
-
-  std::string to_string() const override {
-    return std::to_string(value_);
+  explicit TupleValue(float value) : type_(FLOATS), length_(0), string_value_(nullptr) {
+    float_value_ = value;
   }
-
-  int compare(const TupleValue &other) const override {
-    const IntValue & int_other = (const IntValue &)other;
-    return value_ - int_other.value_;
+  TupleValue(const char *value, int len) : type_(CHARS), length_(len), string_value_(value) {
+    int_value_ = 0;
   }
 
-  virtual void add(const TupleValue &other) override {
-    value_ += std::stoi(other.to_string());
+  AttrType type() const {
+    return type_;
   }
 
-  virtual void divide(const size_t x) override {
-    if (x == 0) {
-      return;
-    }
-    value_ /= x;
+  int int_value() const {
+    return int_value_;
   }
-  
-  virtual AttrType type() const override {
-    return INTS;
+  float float_value() const {
+    return float_value_;
   }
- 
-private:
-  int value_;
-};
-
-class FloatValue : public TupleValue {
-public:
-  explicit FloatValue(float value) : value_(value) {
+  const char *string_value() const {
+    return string_value_;
   }
-
-  void to_string(std::ostream &os) const override {
-    std::string str = this->to_string();
-    size_t dot_pos = str.find('.');
-    if (dot_pos == std::string::npos) {
-      os << str;
-      return;
-    }
-    std::string zhengshu = str.substr(0, dot_pos);
-    // std::string xiaoshu = str.substr(dot_pos);
-    // if (xiaoshu.size() <= 2) {
-    //   if (xiaoshu[0] == '0' && xiaoshu[1] == '0') {
-    //     os << zhengshu;
-    //     return;
-    //   }
-    //   os << zhengshu << '.' << xiaoshu;
-    //   return;
-    // }
-
-    os << std::setprecision(zhengshu.size() + 2) << value_;
+  int length() const {
+    return length_;
   }
 
-  std::string to_string() const override {
-    return std::to_string(value_);
+  void to_string(std::ostream &os) const {
+    std::string str;
+    append_to(str);
+    os.write(str.data(), str.size());
   }
 
-  int compare(const TupleValue &other) const override {
-    const FloatValue & float_other = (const FloatValue &)other;
-    float result = value_ - float_other.value_;
-    if (result > 0) { // 浮点数没有考虑精度问题
-      return 1;
+  /**
+   * 把输出给客户端的文本追加到out后面，数值直接格式化，不经过ostream
+   */
+  void append_to(std::string &out) const {
+    switch (type_) {
+      case INTS: {
+        char buf[INT_FORMAT_SIZE];
+        out.append(buf, format_int(int_value_, buf));
+      }
+      break;
+      case FLOATS: {
+        char buf[FLOAT_FORMAT_SIZE];
+        out.append(buf, format_float(float_value_, buf));
+      }
+      break;
+      case IS_NULL: {
+        out.append("NULL", 4);
+      }
+      break;
+      default: {
+        out.append(string_value_, length_);
+      }
+      break;
     }
-    if (result < 0) {
-      return -1;
-    }
-    return 0;
   }
 
-  virtual void add(const TupleValue &other) override {
-    value_ += std::stoi(other.to_string());
+  std::string to_string() const {
+    switch (type_) {
+      case INTS:
+        return std::to_string(int_value_);
+      case FLOATS:
+        return std::to_string(float_value_);
+      case IS_NULL:
+        return std::string("NULL");
+      default:
+        return std::string(string_value_, length_);
+    }
   }
 
-  virtual void divide(const size_t x) override {
-    if (x == 0) {
-      return;
+  /**
+   * 与另一个值比较。整数和浮点数之间按数值比较，null比任何值都大
+   */
+  int compare(const TupleValue &other) const {
+    switch (type_) {
+      case INTS: {
+        if (other.type_ == FLOATS) {
+          return compare_float(int_value_, other.float_value_);
+        }
+        return int_value_ < other.int_value_ ? -1 : (int_value_ > other.int_value_ ? 1 : 0);
+      }
+      case FLOATS: {
+        // 浮点数没有考虑精度问题
+        return compare_float(float_value_, other.type_ == INTS ? other.int_value_ : other.float_value_);
+      }
+      case IS_NULL: {
+        return 1;
+      }
+      default: {
+        return strcmp(string_value_, other.string_value_);
+      }
     }
-    value_ /= x;
   }
 
-  virtual AttrType type() const override {
-    return FLOATS;
-  }
 private:
-  float value_;
-};
-
-class StringValue : public TupleValue {
-public:
-  StringValue(const char *value, int len) : value_(value, len){
-  }
-  explicit StringValue(const char *value) : value_(value) {
-  }
-
-  void to_string(std::ostream &os) const override {
-    os << value_;
+  static int compare_float(float left, float right) {
+    return left < right ? -1 : (left > right ? 1 : 0);
   }
 
-  std::string to_string() const override {
-    return value_;
-  }
-
-  int compare(const TupleValue &other) const override {
-    const StringValue &string_other = (const StringValue &)other;
-    return strcmp(value_.c_str(), string_other.value_.c_str());
-  }
-
-  virtual void add(const TupleValue &other) override {
-    value_ += std::stoi(other.to_string());
-  }
-
-  virtual void divide(const size_t x) override {
-    return;
-  }
-
-  virtual AttrType type() const override {
-    return CHARS;
-  }
 private:
-  std::string value_;
+  AttrType type_;
+  int length_;
+  union {
+    int int_value_;
+    float float_value_;
+  };
+  const char *string_value_;
 };
 
-class NullValue : public TupleValue {
-public:
-  explicit NullValue() {
-  }
-
-  void to_string(std::ostream &os) const override {
-    os << "NULL";
-  }
-
-  std::string to_string() const override {
-    return std::string("NULL");
-  }
-
-  int compare(const TupleValue &other) const override {
-    return 1;
-  }
-
-  virtual void add(const TupleValue &other) override {
-    
-  }
-
-  virtual void divide(const size_t x) override {
-    
-  }
-  
-  virtual AttrType type() const override {
-    return IS_NULL;
-  }
- 
-private:
-  // int value_;
-};
 #endif //__OBSERVER_SQL_EXECUTOR_VALUE_H_
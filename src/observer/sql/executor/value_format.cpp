@@ -0,0 +1,153 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/executor/value_format.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint64_t POW10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+};
+
+/**
+ * 从后往前每次写两位数字
+ */
+static int format_uint64(uint64_t value, char *buf) {
+  char tmp[20];
+  char *p = tmp + sizeof(tmp);
+  while (value >= 100) {
+    const int pair = (int)(value % 100) * 2;
+    value /= 100;
+    *--p = DIGIT_PAIRS[pair + 1];
+    *--p = DIGIT_PAIRS[pair];
+  }
+  if (value >= 10) {
+    const int pair = (int)value * 2;
+    *--p = DIGIT_PAIRS[pair + 1];
+    *--p = DIGIT_PAIRS[pair];
+  } else {
+    *--p = (char)('0' + value);
+  }
+  const int len = (int)(tmp + sizeof(tmp) - p);
+  memcpy(buf, p, len);
+  return len;
+}
+
+static int digit_num(uint64_t value) {
+  int num = 1;
+  while (value >= 10) {
+    value /= 10;
+    num++;
+  }
+  return num;
+}
+
+int format_int(int value, char *buf) {
+  if (value < 0) {
+    buf[0] = '-';
+    return 1 + format_uint64((uint64_t)(-(int64_t)value), buf + 1);
+  }
+  return format_uint64((uint64_t)value, buf);
+}
+
+/**
+ * 原来通过ostream的做法：std::to_string得到整数部分的长度，再按setprecision输出
+ */
+static int format_float_slow(float value, char *buf) {
+  const std::string str = std::to_string(value);
+  const size_t dot_pos = str.find('.');
+  if (dot_pos == std::string::npos) {
+    const int len = (int)str.size() < FLOAT_FORMAT_SIZE ? (int)str.size() : FLOAT_FORMAT_SIZE;
+    memcpy(buf, str.data(), len);
+    return len;
+  }
+  const int len = snprintf(buf, FLOAT_FORMAT_SIZE, "%.*g", (int)dot_pos + 2, (double)value);
+  return len < FLOAT_FORMAT_SIZE ? len : FLOAT_FORMAT_SIZE - 1;
+}
+
+int format_float(float value, char *buf) {
+  const double abs_value = fabs((double)value);
+  if (!(abs_value < 1e9) || (abs_value != 0 && abs_value < 1e-3)) {
+    return format_float_slow(value, buf);
+  }
+
+  int len = 0;
+  if (signbit(value)) {
+    buf[len++] = '-';
+  }
+  if (abs_value == 0) {
+    buf[len++] = '0';
+    return len;
+  }
+
+  // float只有24位有效位，乘以不超过10^6的10的幂在double中是精确的，
+  // nearbyint按默认的舍入方式向偶数舍入，与printf对精确值的舍入相同
+  const uint64_t fixed = (uint64_t)nearbyint(abs_value * 1e6);
+  const int precision = digit_num(fixed / 1000000) + len + 2;
+  int exponent = 0;
+  if (abs_value >= 1) {
+    exponent = digit_num((uint64_t)abs_value) - 1;
+  } else {
+    exponent = abs_value >= 0.1 ? -1 : (abs_value >= 0.01 ? -2 : -3);
+  }
+
+  // 保留precision位有效数字。进位后多出一位时，小数位数减少一位
+  int decimals = precision - 1 - exponent;
+  uint64_t digits = (uint64_t)nearbyint(abs_value * (double)POW10[decimals]);
+  if (digits >= POW10[precision]) {
+    digits /= 10;
+    decimals--;
+  }
+  while (decimals > 0 && digits % 10 == 0) {
+    digits /= 10;
+    decimals--;
+  }
+
+  len += format_uint64(digits / POW10[decimals], buf + len);
+  if (decimals > 0) {
+    buf[len++] = '.';
+    uint64_t fraction = digits % POW10[decimals];
+    for (int i = decimals - 1; i >= 0; i--) {
+      buf[len + i] = (char)('0' + fraction % 10);
+      fraction /= 10;
+    }
+    len += decimals;
+  }
+  return len;
+}
+
+int format_date(int date, char *buf) {
+  for (int i = DATE_FORMAT_SIZE - 1; i >= 0; i--) {
+    if (i == 7 || i == 4) {
+      buf[i] = '-';
+      continue;
+    }
+    buf[i] = (char)('0' + date % 10);
+    date /= 10;
+  }
+  return DATE_FORMAT_SIZE;
+}
@@ -0,0 +1,36 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_EXECUTOR_VALUE_FORMAT_H__
+#define __OBSERVER_SQL_EXECUTOR_VALUE_FORMAT_H__
+
+/**
+ * 输出查询结果时把值直接格式化到字符缓冲区，不经过ostream。
+ * 返回写入的字节数，不写结尾的'\0'。buf至少要有对应的*_FORMAT_SIZE个字节
+ */
+static const int INT_FORMAT_SIZE = 11;     /// "-2147483648"
+static const int FLOAT_FORMAT_SIZE = 64;
+static const int DATE_FORMAT_SIZE = 10;    /// "YYYY-MM-DD"
+
+int format_int(int value, char *buf);
+
+/**
+ * 有效数字的个数是std::to_string结果中整数部分的长度加2，即按"%.*g"输出，
+ * 绝对值不小于1时最多保留两位小数，末尾的0和小数点都去掉。
+ * 常见范围内的值用整数运算得到与printf相同的舍入结果，其它的值(很大、很小、inf、nan)仍然用snprintf
+ */
+int format_float(float value, char *buf);
+
+/**
+ * 日期在记录中按YYYYMMDD的整数保存
+ */
+int format_date(int date, char *buf);
+
+#endif // __OBSERVER_SQL_EXECUTOR_VALUE_FORMAT_H__
@@ -0,0 +1,526 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+
+#include "sql/optimizer/join_planner.h"
+#include "sql/optimizer/predicate_rewriter.h"
+#include "storage/common/table.h"
+#include "storage/common/mydate.h"
+#include "common/log/log.h"
+
+const char *join_method_name(JoinMethod method) {
+  switch (method) {
+    case NESTED_LOOP_JOIN:
+      return "NESTED LOOP JOIN";
+    case HASH_JOIN:
+      return "HASH JOIN";
+    case SORT_MERGE_JOIN:
+      return "SORT MERGE JOIN";
+    case INDEX_NESTED_LOOP_JOIN:
+      return "INDEX NESTED LOOP JOIN";
+  }
+  return "UNKNOWN JOIN";
+}
+
+// 代价的单位是顺序读取一条记录
+static const double SEQ_ROW_COST = 1.0;
+static const double INDEX_ROW_COST = 4.0;   // 按索引查到的记录随机读取
+static const double HASH_BUILD_COST = 1.0;
+static const double HASH_PROBE_COST = 0.5;
+static const double COMPARE_COST = 0.1;     // 嵌套循环连接中比较一对元组
+static const int DP_MAX_TABLES = 10;        // 超过这个数目的表用贪心算法选择连接顺序
+
+typedef uint64_t TableSet;
+
+/**
+ * 两张表之间的连接条件
+ */
+struct JoinCondition {
+  int left_table;
+  std::string left_field;
+  int right_table;
+  std::string right_field;
+  CompOp comp;
+};
+
+/**
+ * 一张表的访问路径和过滤后的估算结果
+ */
+struct TableInfo {
+  Table *table = nullptr;
+  double rows = 1;           /// 表中的记录数
+  double cardinality = 1;    /// 经过表上的条件过滤后的记录数
+  double access_cost = 0;
+  AccessPath access_path;
+  std::shared_ptr<const TableStats> stats;  /// analyze收集的统计信息，可能为空
+};
+
+/**
+ * 字段的不同值个数。没有统计信息时，当作每条记录的值都不同
+ */
+static double field_ndv(const TableInfo &info, const std::string &field_name) {
+  if (info.stats != nullptr) {
+    const ColumnStats *column = info.stats->column(field_name.c_str());
+    if (column != nullptr && column->ndv >= 1) {
+      return std::min(column->ndv, info.rows);
+    }
+  }
+  return info.rows;
+}
+
+/**
+ * 一个表集合的左深连接树
+ */
+struct PartialPlan {
+  bool valid = false;
+  bool connected = true;     /// 每一步都用到了连接条件，没有笛卡尔积
+  double cost = 0;
+  double cardinality = 0;
+  std::vector<JoinStep> steps;
+};
+
+static int table_index(const std::vector<Table *> &tables, const char *table_name) {
+  for (size_t i = 0; i < tables.size(); i++) {
+    if (0 == strcmp(tables[i]->name(), table_name)) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * 字段上的单字段索引能否按值查找或者按顺序读取。
+ * 字典编码的字段在索引中按编码排序，与字符串的顺序无关
+ */
+static bool index_usable(Table *table, const std::string &field_name, bool ordered) {
+  const FieldMeta *field = table->table_meta().field(field_name.c_str());
+  if (field == nullptr || table->find_single_field_index(field_name.c_str()) == nullptr) {
+    return false;
+  }
+  switch (field->type()) {
+    case INTS:
+    case DATES:
+      return true;
+    case FLOATS:
+      // 浮点数在元组中只能以字符串取出，转换成查找值时会丢失精度
+      return ordered;
+    case CHARS:
+      return field->dict() == nullptr;
+    default:
+      return false;
+  }
+}
+
+static bool same_type(Table *left_table, const std::string &left_field, Table *right_table, const std::string &right_field) {
+  const FieldMeta *left = left_table->table_meta().field(left_field.c_str());
+  const FieldMeta *right = right_table->table_meta().field(right_field.c_str());
+  return left != nullptr && right != nullptr && left->type() == right->type();
+}
+
+/**
+ * 没有统计信息时，属性与常量比较的条件默认的选择率
+ */
+static double default_selectivity(CompOp comp) {
+  switch (comp) {
+    case EQUAL_TO:
+    case IS:
+      return 0.1;
+    case NOT_EQUAL:
+    case IS_NOT:
+      return 0.9;
+    case LESS_EQUAL:
+    case LESS_THAN:
+    case GREAT_EQUAL:
+    case GREAT_THAN:
+      return 1.0 / 3;
+    default:
+      return 0.5;
+  }
+}
+
+/**
+ * 常量在左侧时交换比较的方向，得到"属性 比较符号 常量"的形式
+ */
+static CompOp swap_comp(CompOp comp) {
+  switch (comp) {
+    case LESS_EQUAL:
+      return GREAT_EQUAL;
+    case LESS_THAN:
+      return GREAT_THAN;
+    case GREAT_EQUAL:
+      return LESS_EQUAL;
+    case GREAT_THAN:
+      return LESS_THAN;
+    default:
+      return comp;
+  }
+}
+
+/**
+ * 把条件中的常量转换成记录中字段的格式，作为索引的查找值
+ */
+static bool index_key(const FieldMeta *field, const Value &value, std::string &key) {
+  key.assign(field->len(), 0);
+  switch (field->type()) {
+    case INTS:
+    case FLOATS: {
+      if (value.type != field->type() || value.data == nullptr) {
+        return false;
+      }
+      memcpy(&key[0], value.data, field->len());
+    } break;
+    case DATES: {
+      if (value.type != CHARS || value.data == nullptr) {
+        return false;
+      }
+      MyDate date((char *)value.data);
+      int date_int = date.toInt();
+      if (date_int == -1) {
+        return false;
+      }
+      memcpy(&key[0], &date_int, sizeof(date_int));
+    } break;
+    case CHARS: {
+      // 常量比字段长时与字段的比较不能转换成索引上的查找
+      if (value.type != CHARS || value.data == nullptr || strlen((const char *)value.data) > (size_t)field->len()) {
+        return false;
+      }
+      memcpy(&key[0], value.data, strlen((const char *)value.data));
+    } break;
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * 条件中属性所在的表。单表查询的属性可以不写表名
+ */
+static int attr_table(const std::vector<Table *> &tables, const RelAttr &attr) {
+  if (attr.relation_name == nullptr) {
+    return tables.size() == 1 ? 0 : -1;
+  }
+  return table_index(tables, attr.relation_name);
+}
+
+/**
+ * 用表上属性与常量比较的条件估算过滤后的记录数，并在顺序扫描和各个可用的索引之间选择代价最低的访问路径
+ */
+static void choose_access_path(const std::vector<Table *> &tables, const std::vector<const Condition *> &conditions,
+                               int index, TableInfo &info) {
+  Table *table = tables[index];
+  info.table = table;
+  info.rows = std::max(1, table->estimate_record_num());
+  info.access_cost = info.rows * SEQ_ROW_COST;
+  info.stats = table->stats();
+
+  double selectivity = 1;
+  for (const Condition *condition_ptr : conditions) {
+    const Condition &condition = *condition_ptr;
+    if (condition.is_select || condition.left_is_attr == condition.right_is_attr) {
+      continue;
+    }
+    const RelAttr &attr = condition.left_is_attr ? condition.left_attr : condition.right_attr;
+    const Value &value = condition.left_is_attr ? condition.right_value : condition.left_value;
+    const CompOp comp = condition.left_is_attr ? condition.comp : swap_comp(condition.comp);
+    if (comp == ORDER_BY_ASC || comp == ORDER_BY_DESC || comp == GROUP_BY || attr_table(tables, attr) != index) {
+      continue;
+    }
+    const FieldMeta *field = table->table_meta().field(attr.attribute_name);
+    const ColumnStats *column = info.stats == nullptr ? nullptr : info.stats->column(attr.attribute_name);
+    const double condition_selectivity = field != nullptr && column != nullptr ?
+        column->selectivity(*field, comp, value) : default_selectivity(comp);
+    selectivity *= condition_selectivity;
+
+    if (comp != EQUAL_TO && comp != LESS_EQUAL && comp != LESS_THAN && comp != GREAT_EQUAL && comp != GREAT_THAN) {
+      continue;
+    }
+    std::string key;
+    if (field == nullptr || !index_usable(table, attr.attribute_name, true) || !index_key(field, value, key)) {
+      continue;
+    }
+    const double index_cost = log2(info.rows + 1) + info.rows * condition_selectivity * INDEX_ROW_COST;
+    if (index_cost < info.access_cost) {
+      info.access_cost = index_cost;
+      info.access_path.index_field = attr.attribute_name;
+      info.access_path.comp_op = comp;
+      info.access_path.value = std::move(key);
+    }
+  }
+  info.cardinality = std::max(1.0, info.rows * selectivity);
+}
+
+/**
+ * 按连接字段上的索引顺序读取一张表的代价。选择的访问路径就在这个字段上时，只需要按顺序读取范围内的记录，
+ * 否则按索引顺序读取整张表。按索引顺序读取的记录在数据文件中是随机分布的
+ */
+static double index_order_cost(const TableInfo &info, const std::string &field_name) {
+  if (info.access_path.index_field == field_name) {
+    return info.access_cost;
+  }
+  return log2(info.rows + 1) + info.rows * INDEX_ROW_COST;
+}
+
+/**
+ * 计算把表pick连接到outer上的最优方法，结果放到result中
+ */
+static void plan_join_step(const std::vector<TableInfo> &infos, const std::vector<JoinCondition> &conditions,
+                           const PartialPlan &outer, TableSet outer_tables, int pick, PartialPlan &result) {
+  const TableInfo &inner = infos[pick];
+  const double outer_card = outer.cardinality;
+
+  // 已连接的表与新表之间的条件，统一成(已连接的表, 新表)的方向
+  std::vector<JoinCondition> equal_conditions;
+  double selectivity = 1;
+  bool connected = false;
+  for (const JoinCondition &condition : conditions) {
+    JoinCondition oriented = condition;
+    if ((outer_tables >> condition.right_table & 1) && condition.left_table == pick) {
+      oriented = JoinCondition{condition.right_table, condition.right_field,
+                               condition.left_table, condition.left_field, swap_comp(condition.comp)};
+    } else if (!((outer_tables >> condition.left_table & 1) && condition.right_table == pick)) {
+      continue;
+    }
+    connected = true;
+    if (oriented.comp == EQUAL_TO) {
+      // 较少不同值一侧的每个值都能在另一侧找到匹配
+      selectivity /= std::max(field_ndv(infos[oriented.left_table], oriented.left_field),
+                              field_ndv(infos[oriented.right_table], oriented.right_field));
+      equal_conditions.push_back(oriented);
+    } else {
+      selectivity *= default_selectivity(oriented.comp);
+    }
+  }
+
+  JoinStep join_step;
+  join_step.table = pick;
+  double cost = 0;
+  if (equal_conditions.empty()) {
+    join_step.method = NESTED_LOOP_JOIN;
+    cost = outer.cost + inner.access_cost + outer_card * inner.cardinality * COMPARE_COST;
+  } else {
+    // hash join在较小的一侧建立hash表，用另一侧探查
+    join_step.method = HASH_JOIN;
+    join_step.build_left = outer_card < inner.cardinality;
+    cost = outer.cost + inner.access_cost + std::min(outer_card, inner.cardinality) * HASH_BUILD_COST +
+           std::max(outer_card, inner.cardinality) * HASH_PROBE_COST;
+
+    // 索引嵌套循环对外侧每个元组在索引上查找一次，不需要扫描新表
+    for (const JoinCondition &condition : equal_conditions) {
+      Table *outer_table = infos[condition.left_table].table;
+      Table *inner_table = inner.table;
+      if (!same_type(outer_table, condition.left_field, inner_table, condition.right_field) ||
+          !index_usable(inner_table, condition.right_field, false)) {
+        continue;
+      }
+      const double matches = inner.rows / std::max(field_ndv(infos[condition.left_table], condition.left_field),
+                                                   field_ndv(inner, condition.right_field));
+      const double index_cost = outer.cost + outer_card * (log2(inner.rows + 1) + matches * INDEX_ROW_COST);
+      if (index_cost < cost) {
+        cost = index_cost;
+        join_step.method = INDEX_NESTED_LOOP_JOIN;
+        join_step.outer_table = condition.left_table;
+        join_step.outer_field = condition.left_field;
+        join_step.inner_field = condition.right_field;
+      }
+    }
+
+    // 前两张表都可以按连接字段的索引顺序读取时，归并即可，不需要建立hash表
+    if (outer.steps.size() == 1) {
+      for (const JoinCondition &condition : equal_conditions) {
+        const TableInfo &outer_info = infos[condition.left_table];
+        if (!same_type(outer_info.table, condition.left_field, inner.table, condition.right_field) ||
+            !index_usable(outer_info.table, condition.left_field, true) ||
+            !index_usable(inner.table, condition.right_field, true)) {
+          continue;
+        }
+        const double merge_cost = index_order_cost(outer_info, condition.left_field) +
+                                  index_order_cost(inner, condition.right_field) +
+                                  (outer_card + inner.cardinality) * COMPARE_COST;
+        if (merge_cost < cost) {
+          cost = merge_cost;
+          join_step.method = SORT_MERGE_JOIN;
+          join_step.outer_table = condition.left_table;
+          join_step.outer_field = condition.left_field;
+          join_step.inner_field = condition.right_field;
+        }
+        break;
+      }
+    }
+  }
+
+  result.valid = true;
+  result.connected = outer.connected && connected;
+  result.cost = cost;
+  result.cardinality = std::max(1.0, outer_card * inner.cardinality * selectivity);
+  result.steps = outer.steps;
+  result.steps.push_back(join_step);
+}
+
+/**
+ * 没有笛卡尔积的计划优先，其次是代价低的计划
+ */
+static bool better_plan(const PartialPlan &plan, const PartialPlan &best) {
+  if (!best.valid) {
+    return true;
+  }
+  if (plan.connected != best.connected) {
+    return plan.connected;
+  }
+  return plan.cost < best.cost;
+}
+
+static PartialPlan single_table_plan(const std::vector<TableInfo> &infos, int table) {
+  PartialPlan plan;
+  plan.valid = true;
+  plan.cost = infos[table].access_cost;
+  plan.cardinality = infos[table].cardinality;
+  JoinStep join_step;
+  join_step.table = table;
+  plan.steps.push_back(join_step);
+  return plan;
+}
+
+/**
+ * 按表集合从小到大计算每个集合的最优左深连接树，集合S的最优计划由S去掉一张表的最优计划再连接这张表得到
+ */
+static PartialPlan plan_by_dynamic_programming(const std::vector<TableInfo> &infos,
+                                               const std::vector<JoinCondition> &conditions) {
+  const int table_num = (int)infos.size();
+  const TableSet all_tables = ((TableSet)1 << table_num) - 1;
+  std::vector<PartialPlan> best_plans(all_tables + 1);
+  for (int i = 0; i < table_num; i++) {
+    best_plans[(TableSet)1 << i] = single_table_plan(infos, i);
+  }
+  for (TableSet tables = 1; tables <= all_tables; tables++) {
+    if ((tables & (tables - 1)) == 0) {
+      continue;
+    }
+    PartialPlan &best = best_plans[tables];
+    // 从编号大的表开始尝试，代价相同时保留先连接编号小的表的计划
+    for (int pick = table_num - 1; pick >= 0; pick--) {
+      if (!(tables >> pick & 1)) {
+        continue;
+      }
+      const TableSet outer_tables = tables & ~((TableSet)1 << pick);
+      PartialPlan plan;
+      plan_join_step(infos, conditions, best_plans[outer_tables], outer_tables, pick, plan);
+      if (better_plan(plan, best)) {
+        best = std::move(plan);
+      }
+    }
+  }
+  return std::move(best_plans[all_tables]);
+}
+
+/**
+ * 从过滤后记录数最少的表开始，每次连接使代价增加最少的表
+ */
+static PartialPlan plan_by_greedy(const std::vector<TableInfo> &infos, const std::vector<JoinCondition> &conditions) {
+  const int table_num = (int)infos.size();
+  int first = 0;
+  for (int i = 1; i < table_num; i++) {
+    if (infos[i].cardinality < infos[first].cardinality) {
+      first = i;
+    }
+  }
+  PartialPlan plan = single_table_plan(infos, first);
+  TableSet joined = (TableSet)1 << first;
+  for (int step = 1; step < table_num; step++) {
+    PartialPlan best;
+    for (int pick = 0; pick < table_num; pick++) {
+      if (joined >> pick & 1) {
+        continue;
+      }
+      PartialPlan candidate;
+      plan_join_step(infos, conditions, plan, joined, pick, candidate);
+      if (better_plan(candidate, best)) {
+        best = std::move(candidate);
+      }
+    }
+    joined |= (TableSet)1 << best.steps.back().table;
+    plan = std::move(best);
+  }
+  return plan;
+}
+
+RC plan_join(const std::vector<Table *> &tables, const Selects &selects, JoinPlan &join_plan) {
+  join_plan.steps.clear();
+  join_plan.access_paths.clear();
+  const int table_num = (int)tables.size();
+  if (table_num == 0 || table_num > (int)sizeof(TableSet) * 8) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 推导出的条件和原来的条件一起估算选择率、选择访问路径和连接键
+  std::vector<Condition> derived;
+  derive_predicates(selects, derived);
+  std::vector<const Condition *> all_conditions;
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    all_conditions.push_back(&selects.conditions[i]);
+  }
+  for (const Condition &condition : derived) {
+    all_conditions.push_back(&condition);
+  }
+
+  std::vector<JoinCondition> conditions;
+  for (const Condition *condition_ptr : all_conditions) {
+    const Condition &condition = *condition_ptr;
+    const PredicateClass predicate_class = classify_predicate(selects, condition);
+    if ((predicate_class != PREDICATE_EQUI_JOIN && predicate_class != PREDICATE_RESIDUAL) ||
+        condition.left_attr.relation_name == nullptr || condition.right_attr.relation_name == nullptr) {
+      continue;
+    }
+    const int left_table = table_index(tables, condition.left_attr.relation_name);
+    const int right_table = table_index(tables, condition.right_attr.relation_name);
+    if (left_table < 0 || right_table < 0 || left_table == right_table) {
+      continue;
+    }
+    conditions.push_back(JoinCondition{left_table, condition.left_attr.attribute_name,
+                                       right_table, condition.right_attr.attribute_name, condition.comp});
+  }
+
+  std::vector<TableInfo> infos(table_num);
+  for (int i = 0; i < table_num; i++) {
+    choose_access_path(tables, all_conditions, i, infos[i]);
+  }
+
+  PartialPlan plan = table_num <= DP_MAX_TABLES ? plan_by_dynamic_programming(infos, conditions)
+                                                : plan_by_greedy(infos, conditions);
+
+  // 索引嵌套循环连接的新表在索引上查找连接键，不再使用选择的访问路径。
+  // sort-merge join的两侧按连接字段上的索引顺序读取，访问路径在连接字段上时按顺序读取范围内的记录，否则不再使用。
+  // 访问路径对应的条件仍然在扫描时过滤
+  for (const TableInfo &info : infos) {
+    join_plan.access_paths.push_back(info.access_path);
+  }
+  for (size_t i = 1; i < plan.steps.size(); i++) {
+    const JoinStep &join_step = plan.steps[i];
+    AccessPath &inner_path = join_plan.access_paths[join_step.table];
+    if (join_step.method == INDEX_NESTED_LOOP_JOIN ||
+        (join_step.method == SORT_MERGE_JOIN && inner_path.index_field != join_step.inner_field)) {
+      inner_path = AccessPath();
+    }
+    if (join_step.method == SORT_MERGE_JOIN &&
+        join_plan.access_paths[join_step.outer_table].index_field != join_step.outer_field) {
+      join_plan.access_paths[join_step.outer_table] = AccessPath();
+    }
+    LOG_DEBUG("Join table %s with %s", tables[join_step.table]->name(), join_method_name(join_step.method));
+  }
+  join_plan.steps = std::move(plan.steps);
+  join_plan.cost = plan.cost;
+  join_plan.cardinality = plan.cardinality;
+  return RC::SUCCESS;
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_OPTIMIZER_JOIN_PLANNER_H__
+#define __OBSERVER_SQL_OPTIMIZER_JOIN_PLANNER_H__
+
+#include <string>
+#include <vector>
+
+#include "rc.h"
+#include "sql/parser/parse_defs.h"
+
+class Table;
+
+enum JoinMethod {
+  NESTED_LOOP_JOIN,
+  HASH_JOIN,
+  SORT_MERGE_JOIN,
+  INDEX_NESTED_LOOP_JOIN,
+};
+
+const char *join_method_name(JoinMethod method);
+
+/**
+ * 左深连接树中的一步：把一张表连接到已经连接的结果上。
+ * 第一步只有一张表，没有连接方法
+ */
+struct JoinStep {
+  int table = -1;                    /// 新连接的表在from中的位置，按照from中的顺序
+  JoinMethod method = NESTED_LOOP_JOIN;
+  bool build_left = false;           /// hash join是否在已连接的一侧建立hash表
+  int outer_table = -1;              /// sort-merge和索引嵌套循环连接：连接键所在的已连接的表
+  std::string outer_field;           /// 连接键在已连接的表上的字段
+  std::string inner_field;           /// 连接键在新表上的字段，这个字段上有单字段索引
+};
+
+/**
+ * 表的访问路径。条件中的字段上有索引并且估算的代价更低时在索引上查找，否则顺序扫描
+ */
+struct AccessPath {
+  std::string index_field;           /// 在这个字段的单字段索引上查找，为空表示顺序扫描
+  CompOp comp_op = NO_OP;
+  std::string value;                 /// 查找值，与记录中字段的格式相同
+};
+
+struct JoinPlan {
+  std::vector<JoinStep> steps;
+  std::vector<AccessPath> access_paths; /// 每张表的访问路径，按照from中的顺序
+  double cost = 0;                   /// 估算的代价，单位是顺序读取一条记录
+  double cardinality = 0;            /// 估算的输出元组个数
+};
+
+/**
+ * 为查询选择每张表的访问路径、连接顺序和每一步的连接方法。
+ * 表较少时用动态规划枚举所有左深连接树，表较多时每次贪心地连接增加代价最少的表，
+ * 两种方法都优先连接与已连接的表有连接条件的表，避免笛卡尔积。
+ * 等值连接可以用hash join，新表的连接字段上有索引时可以用索引嵌套循环连接，
+ * 前两张表的连接字段上都有索引时可以按索引顺序读取后归并，选择估算代价最低的方法。
+ * 没有等值连接条件时用嵌套循环连接
+ * @param tables from中的表，按照from中的顺序
+ */
+RC plan_join(const std::vector<Table *> &tables, const Selects &selects, JoinPlan &join_plan);
+
+#endif // __OBSERVER_SQL_OPTIMIZER_JOIN_PLANNER_H__
@@ -16,6 +16,13 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 
 #include "optimize_stage.h"
+#include "sql/optimizer/join_planner.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "event/execution_plan_event.h"
+#include "event/sql_event.h"
+#include "event/session_event.h"
+#include "session/session.h"
+#include "storage/default/default_handler.h"
 
 #include "common/conf/ini.h"
 #include "common/io/io.h"
@@ -76,13 +83,54 @@ void OptimizeStage::cleanup() {
 void OptimizeStage::handle_event(StageEvent *event) {
   LOG_TRACE("Enter\n");
 
-  // optimize sql plan, here just pass the event to the next stage
+  ExecutionPlanEvent *exe_event = static_cast<ExecutionPlanEvent *>(event);
+  Query *sql = exe_event->sqls();
+  if (sql->flag == SCF_SELECT) {
+    optimize_select(exe_event);
+  }
   execute_stage->handle_event(event);
 
   LOG_TRACE("Exit\n");
   return;
 }
 
+void OptimizeStage::optimize_select(ExecutionPlanEvent *exe_event) {
+  SessionEvent *session_event = exe_event->sql_event()->session_event();
+  const char *db = session_event->get_client()->session->get_current_db().c_str();
+  const Selects &selects = exe_event->sqls()->sstr.selection;
+
+  // 没有参数时查询条件不变，缓存中的连接计划在统计信息变化之前都可以直接使用
+  CachedPlan *cached_plan = exe_event->cached_plan();
+  const bool reuse_plan = cached_plan != nullptr && cached_plan->param_num() == 0;
+  JoinPlan join_plan;
+  if (reuse_plan && cached_plan->get_join_plan(join_plan)) {
+    exe_event->set_join_plan(std::move(join_plan));
+    return;
+  }
+
+  // 语法解析得到的表是逆序的。找不到的表留给执行阶段报错
+  std::vector<Table *> tables;
+  for (int i = selects.relation_num - 1; i >= 0; i--) {
+    Table *table = DefaultHandler::get_default().find_table(db, selects.relations[i]);
+    if (table == nullptr) {
+      return;
+    }
+    tables.push_back(table);
+  }
+
+  RC rc = plan_join(tables, selects, join_plan);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to plan join. rc=%d:%s", rc, strrc(rc));
+    return;
+  }
+  LOG_DEBUG("Choose plan for %d tables. cost=%.1f, cardinality=%.1f", (int)tables.size(), join_plan.cost,
+            join_plan.cardinality);
+  if (reuse_plan) {
+    cached_plan->set_join_plan(join_plan);
+  }
+  exe_event->set_join_plan(std::move(join_plan));
+}
+
 void OptimizeStage::callback_event(StageEvent *event, CallbackContext *context) {
   LOG_TRACE("Enter\n");
 
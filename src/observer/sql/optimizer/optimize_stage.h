@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/seda/stage.h"
 
+class ExecutionPlanEvent;
+
 class OptimizeStage : public common::Stage {
 public:
   ~OptimizeStage();
@@ -34,6 +36,12 @@ protected:
                      common::CallbackContext *context);
 
 protected:
+private:
+  /**
+   * 为查询选择每张表的访问路径、连接顺序和连接方法，保存在事件中交给执行阶段
+   */
+  void optimize_select(ExecutionPlanEvent *exe_event);
+
 private:
   Stage *execute_stage = nullptr;
 };
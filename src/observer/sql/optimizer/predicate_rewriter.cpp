@@ -0,0 +1,259 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include <string.h>
+#include <string>
+
+#include "sql/optimizer/predicate_rewriter.h"
+
+static bool qualified(const RelAttr &attr) {
+  return attr.relation_name != nullptr && attr.attribute_name != nullptr;
+}
+
+static bool same_attr(const RelAttr &left, const RelAttr &right) {
+  return 0 == strcmp(left.relation_name, right.relation_name) && 0 == strcmp(left.attribute_name, right.attribute_name);
+}
+
+static bool same_table(const Selects &selects, const RelAttr &left, const RelAttr &right) {
+  if (selects.relation_num == 1) {
+    return true;
+  }
+  return qualified(left) && qualified(right) && 0 == strcmp(left.relation_name, right.relation_name);
+}
+
+PredicateClass classify_predicate(const Selects &selects, const Condition &condition) {
+  if (condition.comp == ORDER_BY_ASC || condition.comp == ORDER_BY_DESC || condition.comp == GROUP_BY) {
+    return PREDICATE_NOT_FILTER;
+  }
+  if (condition.is_select) {
+    return PREDICATE_SUBQUERY;
+  }
+  if (condition.left_is_attr != 1 || condition.right_is_attr != 1 ||
+      same_table(selects, condition.left_attr, condition.right_attr)) {
+    return PREDICATE_FILTER;
+  }
+  return condition.comp == EQUAL_TO ? PREDICATE_EQUI_JOIN : PREDICATE_RESIDUAL;
+}
+
+namespace {
+
+/**
+ * 字段的等价类，用并查集维护
+ */
+class AttrClasses {
+public:
+  int find_or_add(const RelAttr &attr) {
+    for (size_t i = 0; i < attrs_.size(); i++) {
+      if (same_attr(attrs_[i], attr)) {
+        return find((int)i);
+      }
+    }
+    attrs_.push_back(attr);
+    parents_.push_back((int)parents_.size());
+    return parents_.back();
+  }
+
+  int find(int index) {
+    while (parents_[index] != index) {
+      parents_[index] = parents_[parents_[index]];
+      index = parents_[index];
+    }
+    return index;
+  }
+
+  void merge(const RelAttr &left, const RelAttr &right) {
+    const int left_root = find_or_add(left);
+    const int right_root = find_or_add(right);
+    parents_[left_root] = right_root;
+  }
+
+  /**
+   * attr所在等价类中的其它字段，attr不在任何等价类中时返回空
+   */
+  std::vector<RelAttr> others(const RelAttr &attr) {
+    std::vector<RelAttr> result;
+    int index = -1;
+    for (size_t i = 0; i < attrs_.size() && index < 0; i++) {
+      if (same_attr(attrs_[i], attr)) {
+        index = (int)i;
+      }
+    }
+    if (index < 0) {
+      return result;
+    }
+    const int root = find(index);
+    for (size_t i = 0; i < attrs_.size(); i++) {
+      if ((int)i != index && find((int)i) == root) {
+        result.push_back(attrs_[i]);
+      }
+    }
+    return result;
+  }
+
+  size_t size() const {
+    return attrs_.size();
+  }
+  const RelAttr &attr(int index) const {
+    return attrs_[index];
+  }
+
+private:
+  std::vector<RelAttr> attrs_;
+  std::vector<int> parents_;
+};
+
+}  // namespace
+
+/**
+ * 与常量比较的条件可以传递给等价的字段。IS、IN和LIKE之类的条件不传递
+ */
+static bool transferable(const Condition &condition) {
+  if (condition.left_is_attr == condition.right_is_attr) {
+    return false;
+  }
+  const RelAttr &attr = condition.left_is_attr ? condition.left_attr : condition.right_attr;
+  const Value &value = condition.left_is_attr ? condition.right_value : condition.left_value;
+  switch (condition.comp) {
+    case EQUAL_TO:
+    case NOT_EQUAL:
+    case LESS_THAN:
+    case LESS_EQUAL:
+    case GREAT_THAN:
+    case GREAT_EQUAL:
+      return qualified(attr) && value.data != nullptr && value.type != IS_NULL && value.type != PARAMETER;
+    default:
+      return false;
+  }
+}
+
+static bool same_value(const Value &left, const Value &right) {
+  if (left.data == right.data) {
+    return true;
+  }
+  if (left.type != right.type || left.data == nullptr || right.data == nullptr) {
+    return false;
+  }
+  switch (left.type) {
+    case INTS:
+    case FLOATS:
+    case DATES:
+      return memcmp(left.data, right.data, sizeof(int)) == 0;
+    case CHARS:
+    case TEXT:
+      return strcmp((const char *)left.data, (const char *)right.data) == 0;
+    default:
+      return false;
+  }
+}
+
+static bool same_condition(const Condition &left, const Condition &right) {
+  if (left.comp != right.comp || left.left_is_attr != right.left_is_attr || left.right_is_attr != right.right_is_attr ||
+      left.is_select || right.is_select) {
+    return false;
+  }
+  if (left.left_is_attr) {
+    if (!qualified(left.left_attr) || !qualified(right.left_attr) || !same_attr(left.left_attr, right.left_attr)) {
+      return false;
+    }
+  } else if (!same_value(left.left_value, right.left_value)) {
+    return false;
+  }
+  if (left.right_is_attr) {
+    return qualified(left.right_attr) && qualified(right.right_attr) && same_attr(left.right_attr, right.right_attr);
+  }
+  return same_value(left.right_value, right.right_value);
+}
+
+/**
+ * 两个字段的等值条件，不考虑左右的顺序
+ */
+static bool same_equality(const Condition &condition, const RelAttr &left, const RelAttr &right) {
+  if (condition.comp != EQUAL_TO || condition.left_is_attr != 1 || condition.right_is_attr != 1 ||
+      condition.is_select || !qualified(condition.left_attr) || !qualified(condition.right_attr)) {
+    return false;
+  }
+  return (same_attr(condition.left_attr, left) && same_attr(condition.right_attr, right)) ||
+         (same_attr(condition.left_attr, right) && same_attr(condition.right_attr, left));
+}
+
+static void add_derived(const Selects &selects, const Condition &condition, std::vector<Condition> &derived) {
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    if (same_condition(selects.conditions[i], condition)) {
+      return;
+    }
+  }
+  for (const Condition &existing : derived) {
+    if (same_condition(existing, condition)) {
+      return;
+    }
+  }
+  derived.push_back(condition);
+}
+
+void derive_predicates(const Selects &selects, std::vector<Condition> &derived) {
+  if (selects.relation_num < 2) {
+    return;
+  }
+
+  AttrClasses classes;
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    const Condition &condition = selects.conditions[i];
+    if (classify_predicate(selects, condition) == PREDICATE_EQUI_JOIN && qualified(condition.left_attr) &&
+        qualified(condition.right_attr)) {
+      classes.merge(condition.left_attr, condition.right_attr);
+    }
+  }
+  if (classes.size() == 0) {
+    return;
+  }
+
+  // 与常量的比较传递给等价类中的其它字段
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    const Condition &condition = selects.conditions[i];
+    if (condition.is_select || !transferable(condition)) {
+      continue;
+    }
+    const RelAttr &attr = condition.left_is_attr ? condition.left_attr : condition.right_attr;
+    for (const RelAttr &other : classes.others(attr)) {
+      Condition transferred = condition;
+      (condition.left_is_attr ? transferred.left_attr : transferred.right_attr) = other;
+      add_derived(selects, transferred, derived);
+    }
+  }
+
+  // 等价类中不同表的字段两两相等
+  for (size_t i = 0; i < classes.size(); i++) {
+    for (size_t j = i + 1; j < classes.size(); j++) {
+      const RelAttr &left = classes.attr((int)i);
+      const RelAttr &right = classes.attr((int)j);
+      if (classes.find((int)i) != classes.find((int)j) || 0 == strcmp(left.relation_name, right.relation_name)) {
+        continue;
+      }
+      bool exists = false;
+      for (size_t k = 0; k < selects.condition_num && !exists; k++) {
+        exists = same_equality(selects.conditions[k], left, right);
+      }
+      for (size_t k = 0; k < derived.size() && !exists; k++) {
+        exists = same_equality(derived[k], left, right);
+      }
+      if (!exists) {
+        Condition equality;
+        memset(&equality, 0, sizeof(equality));
+        equality.left_is_attr = 1;
+        equality.left_attr = left;
+        equality.comp = EQUAL_TO;
+        equality.right_is_attr = 1;
+        equality.right_attr = right;
+        derived.push_back(equality);
+      }
+    }
+  }
+}
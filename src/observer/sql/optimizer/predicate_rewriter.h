@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#ifndef __OBSERVER_SQL_OPTIMIZER_PREDICATE_REWRITER_H__
+#define __OBSERVER_SQL_OPTIMIZER_PREDICATE_REWRITER_H__
+
+#include <vector>
+
+#include "sql/parser/parse_defs.h"
+
+/**
+ * where中条件的分类，决定条件在执行计划中的位置
+ */
+enum PredicateClass {
+  PREDICATE_FILTER,      /// 只涉及一张表的字段或者只有常量，下推到表的扫描
+  PREDICATE_EQUI_JOIN,   /// 两张表上字段的等值条件，可以作为连接键
+  PREDICATE_RESIDUAL,    /// 两张表上字段的其它比较，在两张表都连接之后过滤
+  PREDICATE_SUBQUERY,    /// 带子查询的条件，子查询的结果物化之后在扫描时过滤
+  PREDICATE_NOT_FILTER,  /// order by和group by也保存在条件中，不是过滤条件
+};
+
+PredicateClass classify_predicate(const Selects &selects, const Condition &condition);
+
+/**
+ * 由等值连接条件推导出新的条件，结果追加到derived中：
+ * 等值连接把字段分成若干个等价类，一个字段与常量的比较对同一个等价类中的其它字段也成立
+ * (a.x = b.x AND b.x = 5 => a.x = 5)，推导出的过滤条件下推到其它表的扫描；
+ * 等价类中不同表的字段两两相等(a.x = b.x AND b.x = c.x => a.x = c.x)，连接顺序有更多的选择。
+ * 推导出的条件与原来的条件共享字符串和常量，只在语句的生命周期内有效。
+ * 优化阶段和执行阶段都调用这个函数，对同一条语句得到相同的结果
+ */
+void derive_predicates(const Selects &selects, std::vector<Condition> &derived);
+
+#endif // __OBSERVER_SQL_OPTIMIZER_PREDICATE_REWRITER_H__
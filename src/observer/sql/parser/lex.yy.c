@@ -607,6 +607,9 @@ static yyconst flex_int16_t yy_chk[423] =
 
 struct ParserContext;
 
+// 解析出来的字符串从当前请求的内存区域分配，见parse.cpp
+char *parse_strdup(const char *s);
+
 #include "yacc_sql.tab.h"
 extern int atoi();
 extern double atof();
@@ -1215,27 +1218,27 @@ RETURN_TOKEN(IN_T);
 case 52:
 YY_RULE_SETUP
 #line 88 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(MAX);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(MAX);
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
 #line 89 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(MIN);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(MIN);
 	YY_BREAK
 case 54:
 YY_RULE_SETUP
 #line 90 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(COUNT);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(COUNT);
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
 #line 91 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(AVG);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(AVG);
 	YY_BREAK
 case 56:
 YY_RULE_SETUP
 #line 92 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(ID);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(ID);
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
@@ -1285,12 +1288,12 @@ RETURN_TOKEN(GT);
 case 66:
 YY_RULE_SETUP
 #line 103 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(SSS);
+yylval->string=parse_strdup(yytext); RETURN_TOKEN(SSS);
 	YY_BREAK
 case 67:
 YY_RULE_SETUP
 #line 105 "lex_sql.l"
-printf("Unknown character [%c]\n",yytext[0]); return yytext[0];
+if (yytext[0] != '?') printf("Unknown character [%c]\n",yytext[0]); return yytext[0]; /* ?是预编译语句的参数 */
 	YY_BREAK
 case 68:
 YY_RULE_SETUP
@@ -16,51 +16,77 @@ See the Mulan PSL v2 for more details. */
 #include "sql/parser/parse.h"
 #include "rc.h"
 #include "common/log/log.h"
+#include "common/mm/arena.h"
 
 RC parse(char *st, Query *sqln);
 
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
+/**
+ * 解析出来的字符串和值从当前请求的内存区域分配，请求结束时统一释放，不需要逐个free。
+ * 没有内存区域时(比如在单元测试中)使用malloc。分配和释放必须在同一个请求中进行
+ */
+char *parse_strdup(const char *s) {
+  common::Arena *arena = common::Arena::current();
+  return arena != nullptr ? arena->strdup(s) : strdup(s);
+}
+
+void *parse_malloc(size_t size) {
+  common::Arena *arena = common::Arena::current();
+  return arena != nullptr ? arena->alloc(size) : malloc(size);
+}
+
+void parse_free(void *p) {
+  if (common::Arena::current() == nullptr) {
+    free(p);
+  }
+}
+
 void relation_attr_init(RelAttr *relation_attr, const char *relation_name, const char *attribute_name) {
   if (relation_name != nullptr) {
-    relation_attr->relation_name = strdup(relation_name);
+    relation_attr->relation_name = parse_strdup(relation_name);
   } else {
     relation_attr->relation_name = nullptr;
   }
-  relation_attr->attribute_name = strdup(attribute_name);
+  relation_attr->attribute_name = parse_strdup(attribute_name);
   // printf("%s %s\n",relation_attr->relation_name, relation_attr->attribute_name);
 }
 
 void relation_attr_destroy(RelAttr *relation_attr) {
-  free(relation_attr->relation_name);
-  free(relation_attr->attribute_name);
+  parse_free(relation_attr->relation_name);
+  parse_free(relation_attr->attribute_name);
   relation_attr->relation_name = nullptr;
   relation_attr->attribute_name = nullptr;
 }
 
 void value_init_integer(Value *value, int v) {
   value->type = INTS;
-  value->data = malloc(sizeof(v));
+  value->data = parse_malloc(sizeof(v));
   memcpy(value->data, &v, sizeof(v));
 }
 void value_init_float(Value *value, float v) {
   value->type = FLOATS;
-  value->data = malloc(sizeof(v));
+  value->data = parse_malloc(sizeof(v));
   memcpy(value->data, &v, sizeof(v));
 }
 void value_init_string(Value *value, const char *v) {
   value->type = CHARS;
-  value->data = strdup(v);
+  value->data = parse_strdup(v);
 }
 void value_init_null(Value *value) {
   value->type = IS_NULL;
   value->data = nullptr;
 }
+void value_init_parameter(Value *value, int index) {
+  value->type = PARAMETER;
+  value->data = parse_malloc(sizeof(index));
+  memcpy(value->data, &index, sizeof(index));
+}
 
 void value_destroy(Value *value) {
   value->type = UNDEFINED;
-  free(value->data);
+  parse_free(value->data);
   value->data = nullptr;
 }
 
@@ -102,6 +128,9 @@ void select_condition_init(Condition *condition, CompOp comp,
     condition->right_is_attr = 0;
     condition->is_select = true;
     condition->selects = right_select;
+  // 子查询一侧没有值，置空之后condition_destroy可以统一释放
+  condition->right_value.type = UNDEFINED;
+  condition->right_value.data = nullptr;
   condition->tuple_set_ = nullptr;
   condition->tuple_set_left_ = nullptr;
   condition->selects_left = nullptr;
@@ -115,6 +144,10 @@ void select_condition_init_(Condition *condition, CompOp comp,
     condition->right_is_attr = 0;
     condition->is_select = true;
     condition->selects = right_select;
+  condition->left_value.type = UNDEFINED;
+  condition->left_value.data = nullptr;
+  condition->right_value.type = UNDEFINED;
+  condition->right_value.data = nullptr;
   condition->tuple_set_ = nullptr;
   condition->tuple_set_left_ = nullptr;
   condition->selects_left = left_select;
@@ -143,12 +176,14 @@ void condition_list_append_condition(Condition *condition_list, int list_length,
 }
 
 void attr_info_init(AttrInfo *attr_info, const char *name, AttrType type, size_t length) {
-  attr_info->name = strdup(name);
+  attr_info->name = parse_strdup(name);
   attr_info->type = type;
   attr_info->length = length;
+  attr_info->nullable = false;
+  attr_info->dict = false;
 }
 void attr_info_destroy(AttrInfo *attr_info) {
-  free(attr_info->name);
+  parse_free(attr_info->name);
   attr_info->name = nullptr;
 }
 
@@ -156,6 +191,9 @@ void selects_init_(Selects *selects){
   selects->attr_num = 0;
   selects->relation_num = 0;
   selects->condition_num = 0;
+  selects->has_limit = 0;
+  selects->limit = 0;
+  selects->offset = 0;
   for (int i=0; i<MAX_NUM; i++) {
     selects->relations[i] = nullptr;
   }
@@ -165,6 +203,9 @@ void selects_move__(Selects *des, Selects *src) {
   des->attr_num = src->attr_num;
   des->relation_num = src->relation_num;
   des->condition_num = src->condition_num;
+  des->has_limit = src->has_limit;
+  des->limit = src->limit;
+  des->offset = src->offset;
   for (int i=0; i<des->attr_num; i++) {
     des->attributes[i] = src->attributes[i];
   }
@@ -196,7 +237,7 @@ void selects_append_attributes(Selects *selects, RelAttr *rel_attr_list, int att
 }
 
 void selects_append_relation(Selects *selects, const char *relation_name) {
-  selects->relations[selects->relation_num++] = strdup(relation_name);
+  selects->relations[selects->relation_num++] = parse_strdup(relation_name);
 }
 
 void selects_append_conditions(Selects *selects, Condition conditions[], size_t condition_num) {
@@ -207,6 +248,12 @@ void selects_append_conditions(Selects *selects, Condition conditions[], size_t
   selects->condition_num = condition_num;
 }
 
+void selects_set_limit(Selects *selects, int limit, int offset) {
+  selects->has_limit = 1;
+  selects->limit = limit;
+  selects->offset = offset;
+}
+
 void selects_destroy(Selects *selects) {
   for (size_t i = 0; i < selects->attr_num; i++) {
     relation_attr_destroy(&selects->attributes[i]);
@@ -214,7 +261,7 @@ void selects_destroy(Selects *selects) {
   selects->attr_num = 0;
 
   for (size_t i = 0; i < selects->relation_num; i++) {
-    free(selects->relations[i]);
+    parse_free(selects->relations[i]);
     selects->relations[i] = NULL;
   }
   selects->relation_num = 0;
@@ -223,6 +270,7 @@ void selects_destroy(Selects *selects) {
     condition_destroy(&selects->conditions[i]);
   }
   selects->condition_num = 0;
+  selects->has_limit = 0;
 }
 
 
@@ -230,7 +278,7 @@ void selects_destroy(Selects *selects) {
 void inserts_init(Inserts *inserts, const char *relation_name, Value values[], size_t value_num, size_t data_num) {
   assert(value_num <= sizeof(inserts->values)/sizeof(inserts->values[0]));
 
-  inserts->relation_name = strdup(relation_name);
+  inserts->relation_name = parse_strdup(relation_name);
   for (size_t i = 0; i < value_num; i++) {
     inserts->values[i] = values[i];
   }
@@ -238,7 +286,7 @@ void inserts_init(Inserts *inserts, const char *relation_name, Value values[], s
   inserts->insert_num = data_num;
 }
 void inserts_destroy(Inserts *inserts) {
-  free(inserts->relation_name);
+  parse_free(inserts->relation_name);
   inserts->relation_name = nullptr;
 
   for (size_t i = 0; i < inserts->value_num; i++) {
@@ -248,7 +296,7 @@ void inserts_destroy(Inserts *inserts) {
 }
 
 void deletes_init_relation(Deletes *deletes, const char *relation_name) {
-  deletes->relation_name = strdup(relation_name);
+  deletes->relation_name = parse_strdup(relation_name);
 }
 
 void deletes_set_conditions(Deletes *deletes, Condition conditions[], size_t condition_num) {
@@ -263,14 +311,14 @@ void deletes_destroy(Deletes *deletes) {
     condition_destroy(&deletes->conditions[i]);
   }
   deletes->condition_num = 0;
-  free(deletes->relation_name);
+  parse_free(deletes->relation_name);
   deletes->relation_name = nullptr;
 }
 
 void updates_init(Updates *updates, const char *relation_name, const char *attribute_name,
                   Value *value, Condition conditions[], size_t condition_num) {
-  updates->relation_name = strdup(relation_name);
-  updates->attribute_name = strdup(attribute_name);
+  updates->relation_name = parse_strdup(relation_name);
+  updates->attribute_name = parse_strdup(attribute_name);
   updates->value = *value;
 
   assert(condition_num <= sizeof(updates->conditions)/sizeof(updates->conditions[0]));
@@ -281,8 +329,8 @@ void updates_init(Updates *updates, const char *relation_name, const char *attri
 }
 
 void updates_destroy(Updates *updates) {
-  free(updates->relation_name);
-  free(updates->attribute_name);
+  parse_free(updates->relation_name);
+  parse_free(updates->attribute_name);
   updates->relation_name = nullptr;
   updates->attribute_name = nullptr;
 
@@ -298,77 +346,87 @@ void create_table_append_attribute(CreateTable *create_table, AttrInfo *attr_inf
   create_table->attributes[create_table->attribute_count++] = *attr_info;
 }
 void create_table_init_name(CreateTable *create_table, const char *relation_name) {
-  create_table->relation_name = strdup(relation_name);
+  create_table->relation_name = parse_strdup(relation_name);
 }
 void create_table_destroy(CreateTable *create_table) {
   for (size_t i = 0; i < create_table->attribute_count; i++) {
     attr_info_destroy(&create_table->attributes[i]);
   }
   create_table->attribute_count = 0;
-  free(create_table->relation_name);
+  create_table->storage_format = ROW_FORMAT;
+  parse_free(create_table->relation_name);
   create_table->relation_name = nullptr;
 }
 
 void drop_table_init(DropTable *drop_table, const char *relation_name) {
-  drop_table->relation_name = strdup(relation_name);
+  drop_table->relation_name = parse_strdup(relation_name);
 }
 void drop_table_destroy(DropTable *drop_table) {
-  free(drop_table->relation_name);
+  parse_free(drop_table->relation_name);
   drop_table->relation_name = nullptr;
 }
 
 void create_index_append_attribute(CreateIndex *create_index, const char *attr_name) {
-  create_index->attribute_name[create_index->attribute_count++] = strdup(attr_name);
+  create_index->attribute_name[create_index->attribute_count++] = parse_strdup(attr_name);
 }
 void create_index_init(CreateIndex *create_index, const char *index_name, 
                        const char *relation_name) {
-  create_index->index_name = strdup(index_name);
-  create_index->relation_name = strdup(relation_name);
+  create_index->index_name = parse_strdup(index_name);
+  create_index->relation_name = parse_strdup(relation_name);
   create_index->unique = false;
 }
 void create_unique_index_init(CreateIndex *create_index, const char *index_name, 
                        const char *relation_name) {
-  create_index->index_name = strdup(index_name);
-  create_index->relation_name = strdup(relation_name);
+  create_index->index_name = parse_strdup(index_name);
+  create_index->relation_name = parse_strdup(relation_name);
   create_index->unique = true;
 }
 void create_index_destroy(CreateIndex *create_index) {
-  free(create_index->index_name);
-  free(create_index->relation_name);
+  parse_free(create_index->index_name);
+  parse_free(create_index->relation_name);
 
   create_index->index_name = nullptr;
   create_index->relation_name = nullptr;
   for (size_t i = 0; i < create_index->attribute_count; i++) {
-    free(create_index->attribute_name[i]);
+    parse_free(create_index->attribute_name[i]);
     create_index->attribute_name[i] = nullptr;
   }
   create_index->attribute_count = 0;
 }
 
 void drop_index_init(DropIndex *drop_index, const char *index_name) {
-  drop_index->index_name = strdup(index_name);
+  drop_index->index_name = parse_strdup(index_name);
 }
 void drop_index_destroy(DropIndex *drop_index) {
-  free((char *)drop_index->index_name);
+  parse_free((char *)drop_index->index_name);
   drop_index->index_name = nullptr;
 }
 
 void desc_table_init(DescTable *desc_table, const char *relation_name) {
-  desc_table->relation_name = strdup(relation_name);
+  desc_table->relation_name = parse_strdup(relation_name);
 }
 
 void desc_table_destroy(DescTable *desc_table) {
-  free((char *)desc_table->relation_name);
+  parse_free((char *)desc_table->relation_name);
   desc_table->relation_name = nullptr;
 }
 
+void analyze_table_init(AnalyzeTable *analyze_table, const char *relation_name) {
+  analyze_table->relation_name = parse_strdup(relation_name);
+}
+
+void analyze_table_destroy(AnalyzeTable *analyze_table) {
+  parse_free((char *)analyze_table->relation_name);
+  analyze_table->relation_name = nullptr;
+}
+
 void load_data_init(LoadData *load_data, const char *relation_name, const char *file_name) {
-  load_data->relation_name = strdup(relation_name);
+  load_data->relation_name = parse_strdup(relation_name);
 
   if (file_name[0] == '\'' || file_name[0] == '\"') {
     file_name++;
   }
-  char *dup_file_name = strdup(file_name);
+  char *dup_file_name = parse_strdup(file_name);
   int len = strlen(dup_file_name);
   if (dup_file_name[len - 1] == '\'' || dup_file_name[len - 1] == '\"') {
     dup_file_name[len - 1] = 0;
@@ -377,15 +435,62 @@ void load_data_init(LoadData *load_data, const char *relation_name, const char *
 }
 
 void load_data_destroy(LoadData *load_data) {
-  free((char *)load_data->relation_name);
-  free((char *)load_data->file_name);
+  parse_free((char *)load_data->relation_name);
+  parse_free((char *)load_data->file_name);
   load_data->relation_name = nullptr;
   load_data->file_name = nullptr;
 }
 
+void execute_prepared_init(ExecutePrepared *execution, const char *name, Value values[], size_t value_num) {
+  assert(value_num <= sizeof(execution->values)/sizeof(execution->values[0]));
+
+  execution->name = parse_strdup(name);
+  for (size_t i = 0; i < value_num; i++) {
+    execution->values[i] = values[i];
+  }
+  execution->value_num = value_num;
+}
+
+void execute_prepared_destroy(ExecutePrepared *execution) {
+  parse_free(execution->name);
+  execution->name = nullptr;
+
+  for (size_t i = 0; i < execution->value_num; i++) {
+    value_destroy(&execution->values[i]);
+  }
+  execution->value_num = 0;
+}
+
+void deallocate_prepared_init(DeallocatePrepared *deallocation, const char *name) {
+  deallocation->name = parse_strdup(name);
+}
+
+void deallocate_prepared_destroy(DeallocatePrepared *deallocation) {
+  parse_free(deallocation->name);
+  deallocation->name = nullptr;
+}
+
+void set_variable_init(SetVariable *set_variable, const char *name, const char *value) {
+  set_variable->name = parse_strdup(name);
+  set_variable->value = parse_strdup(value);
+}
+
+void set_variable_destroy(SetVariable *set_variable) {
+  parse_free(set_variable->name);
+  parse_free(set_variable->value);
+  set_variable->name = nullptr;
+  set_variable->value = nullptr;
+}
+
+void query_set_prepare_name(Query *query, const char *name) {
+  query->prepare_name = parse_strdup(name);
+}
+
 void query_init(Query *query) {
   query->flag = SCF_ERROR;
   memset(&query->sstr, 0, sizeof(query->sstr));
+  query->explain = EXPLAIN_NONE;
+  query->prepare_name = nullptr;
 }
 
 Query *query_create() {
@@ -449,6 +554,22 @@ void query_reset(Query *query) {
       load_data_destroy(&query->sstr.load_data);
     }
     break;
+    case SCF_ANALYZE_TABLE: {
+      analyze_table_destroy(&query->sstr.analyze_table);
+    }
+    break;
+    case SCF_EXECUTE: {
+      execute_prepared_destroy(&query->sstr.execution);
+    }
+    break;
+    case SCF_DEALLOCATE: {
+      deallocate_prepared_destroy(&query->sstr.deallocation);
+    }
+    break;
+    case SCF_SET_VARIABLE: {
+      set_variable_destroy(&query->sstr.set_variable);
+    }
+    break;
     case SCF_BEGIN:
     case SCF_COMMIT:
     case SCF_ROLLBACK:
@@ -457,6 +578,9 @@ void query_reset(Query *query) {
     case SCF_ERROR:
     break;
   }
+  query->explain = EXPLAIN_NONE;
+  parse_free(query->prepare_name);
+  query->prepare_name = nullptr;
 }
 
 void query_destroy(Query *query) {
@@ -49,16 +49,17 @@ typedef enum {
 } CompOp;
 
 //属性值类型
+// 字段是否可为null记录在AttrInfo/FieldMeta中，不再区分类型
 typedef enum { 
   UNDEFINED, 
-  CHARS, CHARS_NULLABLE,
-  INTS, INTS_NULLABLE,
-  FLOATS, FLOATS_NULLABLE,
-  DATES, DATES_NULLABLE,
-  IF_NULL,
+  CHARS,
+  INTS,
+  FLOATS,
+  DATES,
   IS_NULL,
   NOT_NULL,
-  TEXT
+  TEXT,
+  PARAMETER     // 预编译语句中的参数?，data是参数的序号，执行前替换成execute中的值
    } AttrType;
 
 //属性值
@@ -94,6 +95,9 @@ typedef struct Selects_{
   char *    relations[MAX_NUM];     // relations in From clause
   size_t    condition_num;          // Length of conditions in Where clause
   Condition conditions[MAX_NUM];    // conditions in Where clause
+  int       has_limit;              // 是否有LIMIT子句，结构体清零时就是没有
+  int       limit;                  // 最多输出的行数
+  int       offset;                 // 输出前跳过的行数
   
   // struct Selects_ *subselect[MAX_NUM];  
 } Selects;
@@ -126,13 +130,22 @@ typedef struct {
   char *name;     // Attribute name
   AttrType type;  // Type of attribute
   size_t length;  // Length of attribute
+  bool nullable;  // Whether the attribute can be null
+  bool dict;      // Whether the attribute is dictionary encoded
 } AttrInfo;
 
+//表的存储格式
+typedef enum {
+  ROW_FORMAT,  // 整条记录连续存放
+  PAX_FORMAT   // 页面内按列存放(PAX)，适合只访问少数几列的分析查询
+} StorageFormat;
+
 // struct of craete_table
 typedef struct {
   char *relation_name;           // Relation name
   size_t attribute_count;        // Length of attribute
   AttrInfo attributes[MAX_NUM];  // attributes
+  StorageFormat storage_format;  // storage format of records
 } CreateTable;
 
 // struct of drop_table
@@ -158,11 +171,33 @@ typedef struct {
   const char *relation_name;
 } DescTable;
 
+typedef struct {
+  const char *relation_name;
+} AnalyzeTable;
+
 typedef struct {
   const char *relation_name;
   const char *file_name;
 } LoadData;
 
+// execute name [using value, ...]
+typedef struct {
+  char *name;             // prepare时指定的语句名字
+  size_t value_num;       // Length of values
+  Value values[MAX_NUM];  // 按顺序替换语句中的参数?
+} ExecutePrepared;
+
+// deallocate prepare name
+typedef struct {
+  char *name;
+} DeallocatePrepared;
+
+// set name = value，设置会话变量
+typedef struct {
+  char *name;
+  char *value;
+} SetVariable;
+
 union Queries {
   Selects selection;
   Inserts insertion;
@@ -173,7 +208,11 @@ union Queries {
   CreateIndex create_index;
   DropIndex drop_index;
   DescTable desc_table;
+  AnalyzeTable analyze_table;
   LoadData load_data;
+  ExecutePrepared execution;
+  DeallocatePrepared deallocation;
+  SetVariable set_variable;
   char *errors;
 };
 
@@ -195,19 +234,34 @@ enum SqlCommandFlag {
   SCF_COMMIT,
   SCF_ROLLBACK,
   SCF_LOAD_DATA,
+  SCF_ANALYZE_TABLE,
+  SCF_EXECUTE,
+  SCF_DEALLOCATE,
+  SCF_SET_VARIABLE,
   SCF_HELP,
   SCF_EXIT
 };
+enum ExplainMode {
+  EXPLAIN_NONE = 0,
+  EXPLAIN_PLAN,
+  EXPLAIN_ANALYZE
+};
 // struct of flag and sql_struct
 typedef struct Query {
   enum SqlCommandFlag flag;
   union Queries sstr;
+  int explain;  // 查询语句前面有explain时为EXPLAIN_PLAN，有explain analyze时为EXPLAIN_ANALYZE
+  char *prepare_name;  // prepare name from 语句时是语句的名字，语句本身照常解析，其中的值可以是参数?
 } Query;
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
+char *parse_strdup(const char *s);
+void *parse_malloc(size_t size);
+void parse_free(void *p);
+
 void relation_attr_init(RelAttr *relation_attr, const char *relation_name, const char *attribute_name);
 void relation_attr_destroy(RelAttr *relation_attr);
 
@@ -215,6 +269,7 @@ void value_init_integer(Value *value, int v);
 void value_init_float(Value *value, float v);
 void value_init_string(Value *value, const char *v);
 void value_init_null(Value *value);
+void value_init_parameter(Value *value, int index);
 void value_destroy(Value *value);
 
 void condition_init(Condition *condition, CompOp comp, int left_is_attr, RelAttr *left_attr, Value *left_value,
@@ -238,6 +293,7 @@ void selects_append_attribute(Selects *selects, RelAttr *rel_attr);
 void selects_append_attributes(Selects *selects, RelAttr *rel_attr_list, int attr_list_length);
 void selects_append_relation(Selects *selects, const char *relation_name);
 void selects_append_conditions(Selects *selects, Condition conditions[], size_t condition_num);
+void selects_set_limit(Selects *selects, int limit, int offset);
 void selects_destroy(Selects *selects);
 
 void inserts_init(Inserts *inserts, const char *relation_name, Value values[], size_t value_num, size_t data_num);
@@ -271,9 +327,23 @@ void drop_index_destroy(DropIndex *drop_index);
 void desc_table_init(DescTable *desc_table, const char *relation_name);
 void desc_table_destroy(DescTable *desc_table);
 
+void analyze_table_init(AnalyzeTable *analyze_table, const char *relation_name);
+void analyze_table_destroy(AnalyzeTable *analyze_table);
+
 void load_data_init(LoadData *load_data, const char *relation_name, const char *file_name);
 void load_data_destroy(LoadData *load_data);
 
+void execute_prepared_init(ExecutePrepared *execution, const char *name, Value values[], size_t value_num);
+void execute_prepared_destroy(ExecutePrepared *execution);
+
+void deallocate_prepared_init(DeallocatePrepared *deallocation, const char *name);
+void deallocate_prepared_destroy(DeallocatePrepared *deallocation);
+
+void set_variable_init(SetVariable *set_variable, const char *name, const char *value);
+void set_variable_destroy(SetVariable *set_variable);
+
+void query_set_prepare_name(Query *query, const char *name);
+
 void query_init(Query *query);
 Query *query_create();  // create and init
 void query_reset(Query *query);
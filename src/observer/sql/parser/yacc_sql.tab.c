@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 2 "yacc_sql.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 2 "yacc_sql.y"
 
 
 #include "sql/parser/parse_defs.h"
@@ -73,6 +78,7 @@
 #include<stdio.h>
 #include<stdlib.h>
 #include<string.h>
+#include<strings.h>
 
 typedef struct ParserContext {
   Query * ssql;
@@ -98,6 +104,8 @@ typedef struct ParserContext {
   size_t condition_list_length_stack[MAX_NUM];
   size_t condition_list_stack_top;
  size_t comp_length;
+  int nullable;       // 最近一次归约的type是否可为null
+  int param_num;      // 已经出现的参数?个数
 
 //   Selects *cur_select;
 } ParserContext;
@@ -105,7 +113,7 @@ typedef struct ParserContext {
 //获取子串
 char *substr(const char *s,int n1,int n2)/*从s中提取下标为n1~n2的字符组成一个新字符串，然后返回这个新串的首地址*/
 {
-  char *sp = malloc(sizeof(char) * (n2 - n1 + 2));
+  char *sp = parse_malloc(sizeof(char) * (n2 - n1 + 2));
   int i, j = 0;
   for (i = n1; i <= n2; i++) {
     sp[j++] = s[i];
@@ -152,169 +160,248 @@ ParserContext *get_context(yyscan_t scanner)
 #define CONTEXT get_context(scanner)
 
 
-#line 156 "yacc_sql.tab.c" /* yacc.c:339  */
+#line 164 "yacc_sql.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "yacc_sql.tab.h".  */
-#ifndef YY_YY_YACC_SQL_TAB_H_INCLUDED
-# define YY_YY_YACC_SQL_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SEMICOLON = 258,
-    CREATE = 259,
-    DROP = 260,
-    TABLE = 261,
-    TABLES = 262,
-    INDEX = 263,
-    SELECT = 264,
-    ASC = 265,
-    DESC = 266,
-    SHOW = 267,
-    SYNC = 268,
-    INSERT = 269,
-    DELETE = 270,
-    UPDATE = 271,
-    LBRACE = 272,
-    RBRACE = 273,
-    COMMA = 274,
-    TRX_BEGIN = 275,
-    TRX_COMMIT = 276,
-    TRX_ROLLBACK = 277,
-    INT_T = 278,
-    STRING_T = 279,
-    FLOAT_T = 280,
-    DATE_T = 281,
-    HELP = 282,
-    EXIT = 283,
-    DOT = 284,
-    INTO = 285,
-    VALUES = 286,
-    FROM = 287,
-    WHERE = 288,
-    AND = 289,
-    SET = 290,
-    ON = 291,
-    LOAD = 292,
-    DATA = 293,
-    INFILE = 294,
-    EQ = 295,
-    LT = 296,
-    GT = 297,
-    LE = 298,
-    GE = 299,
-    NE = 300,
-    INNER = 301,
-    JOIN = 302,
-    ORDER = 303,
-    GROUP = 304,
-    BY = 305,
-    UNIQUE = 306,
-    TEXT_T = 307,
-    NOT = 308,
-    NULL_T = 309,
-    NULLABLE = 310,
-    IS_T = 311,
-    IN_T = 312,
-    NUMBER = 313,
-    FLOAT = 314,
-    ID = 315,
-    PATH = 316,
-    SSS = 317,
-    STAR = 318,
-    STRING_V = 319,
-    MAX = 320,
-    MIN = 321,
-    COUNT = 322,
-    AVG = 323
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "yacc_sql.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 153 "yacc_sql.y" /* yacc.c:355  */
-
-  struct _Attr *attr;
-  struct _Condition *condition1;
-  struct _Value *value1;
-  char *string;
-  int number;
-  float floats;
-	char *position;
-
-#line 275 "yacc_sql.tab.c" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SEMICOLON = 3,                  /* SEMICOLON  */
+  YYSYMBOL_CREATE = 4,                     /* CREATE  */
+  YYSYMBOL_DROP = 5,                       /* DROP  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_TABLES = 7,                     /* TABLES  */
+  YYSYMBOL_INDEX = 8,                      /* INDEX  */
+  YYSYMBOL_SELECT = 9,                     /* SELECT  */
+  YYSYMBOL_ASC = 10,                       /* ASC  */
+  YYSYMBOL_DESC = 11,                      /* DESC  */
+  YYSYMBOL_SHOW = 12,                      /* SHOW  */
+  YYSYMBOL_SYNC = 13,                      /* SYNC  */
+  YYSYMBOL_INSERT = 14,                    /* INSERT  */
+  YYSYMBOL_DELETE = 15,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 16,                    /* UPDATE  */
+  YYSYMBOL_LBRACE = 17,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 18,                    /* RBRACE  */
+  YYSYMBOL_COMMA = 19,                     /* COMMA  */
+  YYSYMBOL_TRX_BEGIN = 20,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 21,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 22,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 23,                     /* INT_T  */
+  YYSYMBOL_STRING_T = 24,                  /* STRING_T  */
+  YYSYMBOL_FLOAT_T = 25,                   /* FLOAT_T  */
+  YYSYMBOL_DATE_T = 26,                    /* DATE_T  */
+  YYSYMBOL_HELP = 27,                      /* HELP  */
+  YYSYMBOL_EXIT = 28,                      /* EXIT  */
+  YYSYMBOL_DOT = 29,                       /* DOT  */
+  YYSYMBOL_INTO = 30,                      /* INTO  */
+  YYSYMBOL_VALUES = 31,                    /* VALUES  */
+  YYSYMBOL_FROM = 32,                      /* FROM  */
+  YYSYMBOL_WHERE = 33,                     /* WHERE  */
+  YYSYMBOL_AND = 34,                       /* AND  */
+  YYSYMBOL_SET = 35,                       /* SET  */
+  YYSYMBOL_ON = 36,                        /* ON  */
+  YYSYMBOL_LOAD = 37,                      /* LOAD  */
+  YYSYMBOL_DATA = 38,                      /* DATA  */
+  YYSYMBOL_INFILE = 39,                    /* INFILE  */
+  YYSYMBOL_EQ = 40,                        /* EQ  */
+  YYSYMBOL_LT = 41,                        /* LT  */
+  YYSYMBOL_GT = 42,                        /* GT  */
+  YYSYMBOL_LE = 43,                        /* LE  */
+  YYSYMBOL_GE = 44,                        /* GE  */
+  YYSYMBOL_NE = 45,                        /* NE  */
+  YYSYMBOL_INNER = 46,                     /* INNER  */
+  YYSYMBOL_JOIN = 47,                      /* JOIN  */
+  YYSYMBOL_ORDER = 48,                     /* ORDER  */
+  YYSYMBOL_GROUP = 49,                     /* GROUP  */
+  YYSYMBOL_BY = 50,                        /* BY  */
+  YYSYMBOL_UNIQUE = 51,                    /* UNIQUE  */
+  YYSYMBOL_TEXT_T = 52,                    /* TEXT_T  */
+  YYSYMBOL_NOT = 53,                       /* NOT  */
+  YYSYMBOL_NULL_T = 54,                    /* NULL_T  */
+  YYSYMBOL_NULLABLE = 55,                  /* NULLABLE  */
+  YYSYMBOL_IS_T = 56,                      /* IS_T  */
+  YYSYMBOL_IN_T = 57,                      /* IN_T  */
+  YYSYMBOL_NUMBER = 58,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 59,                     /* FLOAT  */
+  YYSYMBOL_ID = 60,                        /* ID  */
+  YYSYMBOL_PATH = 61,                      /* PATH  */
+  YYSYMBOL_SSS = 62,                       /* SSS  */
+  YYSYMBOL_STAR = 63,                      /* STAR  */
+  YYSYMBOL_STRING_V = 64,                  /* STRING_V  */
+  YYSYMBOL_MAX = 65,                       /* MAX  */
+  YYSYMBOL_MIN = 66,                       /* MIN  */
+  YYSYMBOL_COUNT = 67,                     /* COUNT  */
+  YYSYMBOL_AVG = 68,                       /* AVG  */
+  YYSYMBOL_69_ = 69,                       /* '?'  */
+  YYSYMBOL_YYACCEPT = 70,                  /* $accept  */
+  YYSYMBOL_commands = 71,                  /* commands  */
+  YYSYMBOL_command = 72,                   /* command  */
+  YYSYMBOL_exit = 73,                      /* exit  */
+  YYSYMBOL_help = 74,                      /* help  */
+  YYSYMBOL_sync = 75,                      /* sync  */
+  YYSYMBOL_begin = 76,                     /* begin  */
+  YYSYMBOL_commit = 77,                    /* commit  */
+  YYSYMBOL_rollback = 78,                  /* rollback  */
+  YYSYMBOL_drop_table = 79,                /* drop_table  */
+  YYSYMBOL_show_tables = 80,               /* show_tables  */
+  YYSYMBOL_desc_table = 81,                /* desc_table  */
+  YYSYMBOL_explain = 82,                   /* explain  */
+  YYSYMBOL_prepare = 83,                   /* prepare  */
+  YYSYMBOL_prepared_statement = 84,        /* prepared_statement  */
+  YYSYMBOL_execute = 85,                   /* execute  */
+  YYSYMBOL_deallocate = 86,                /* deallocate  */
+  YYSYMBOL_set_variable = 87,              /* set_variable  */
+  YYSYMBOL_analyze_table = 88,             /* analyze_table  */
+  YYSYMBOL_create_index = 89,              /* create_index  */
+  YYSYMBOL_id_def_list = 90,               /* id_def_list  */
+  YYSYMBOL_id_def = 91,                    /* id_def  */
+  YYSYMBOL_drop_index = 92,                /* drop_index  */
+  YYSYMBOL_create_table = 93,              /* create_table  */
+  YYSYMBOL_create_table_body = 94,         /* create_table_body  */
+  YYSYMBOL_attr_def_list = 95,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 96,                  /* attr_def  */
+  YYSYMBOL_number = 97,                    /* number  */
+  YYSYMBOL_type = 98,                      /* type  */
+  YYSYMBOL_ID_get = 99,                    /* ID_get  */
+  YYSYMBOL_insert = 100,                   /* insert  */
+  YYSYMBOL_muti_value_list = 101,          /* muti_value_list  */
+  YYSYMBOL_muti_value = 102,               /* muti_value  */
+  YYSYMBOL_value_list = 103,               /* value_list  */
+  YYSYMBOL_value = 104,                    /* value  */
+  YYSYMBOL_delete = 105,                   /* delete  */
+  YYSYMBOL_update = 106,                   /* update  */
+  YYSYMBOL_select = 107,                   /* select  */
+  YYSYMBOL_join_list = 108,                /* join_list  */
+  YYSYMBOL_select_attr = 109,              /* select_attr  */
+  YYSYMBOL_attr_list = 110,                /* attr_list  */
+  YYSYMBOL_rel_list = 111,                 /* rel_list  */
+  YYSYMBOL_where = 112,                    /* where  */
+  YYSYMBOL_order_by = 113,                 /* order_by  */
+  YYSYMBOL_order_by_list = 114,            /* order_by_list  */
+  YYSYMBOL_group_by = 115,                 /* group_by  */
+  YYSYMBOL_limit = 116,                    /* limit  */
+  YYSYMBOL_group_by_list = 117,            /* group_by_list  */
+  YYSYMBOL_condition_list = 118,           /* condition_list  */
+  YYSYMBOL_condition = 119,                /* condition  */
+  YYSYMBOL_comOp = 120,                    /* comOp  */
+  YYSYMBOL_subselect = 121,                /* subselect  */
+  YYSYMBOL_load_data = 122                 /* load_data  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
 
 
-int yyparse (void *scanner);
+#ifdef short
+# undef short
+#endif
 
-#endif /* !YY_YY_YACC_SQL_TAB_H_INCLUDED  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#line 291 "yacc_sql.tab.c" /* yacc.c:358  */
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -322,15 +409,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -344,47 +444,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -397,8 +493,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -463,8 +573,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -473,17 +582,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -496,11 +605,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -512,12 +621,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -529,28 +638,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  2
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   387
+#define YYLAST   495
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  69
+#define YYNTOKENS  70
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  44
+#define YYNNTS  53
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  150
+#define YYNRULES  182
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  359
+#define YYNSTATES  421
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   323
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -558,7 +670,7 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    69,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -588,390 +700,444 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   184,   184,   186,   190,   191,   192,   193,   194,   195,
-     196,   197,   198,   199,   200,   201,   202,   203,   204,   205,
-     206,   210,   215,   220,   226,   232,   238,   244,   250,   256,
-     263,   268,   274,   276,   280,   287,   294,   303,   305,   309,
-     326,   342,   351,   354,   355,   356,   357,   358,   359,   360,
-     361,   362,   363,   364,   365,   368,   377,   394,   396,   401,
-     406,   408,   413,   416,   419,   423,   430,   445,   462,   507,
-     555,   559,   565,   578,   586,   594,   602,   615,   628,   641,
-     654,   667,   680,   692,   704,   720,   723,   733,   743,   753,
-     766,   779,   792,   805,   818,   826,   839,   853,   855,   860,
-     864,   869,   871,   884,   894,   904,   914,   924,   937,   941,
-     951,   961,   971,   981,   991,  1003,  1005,  1015,  1028,  1032,
-    1042,  1056,  1060,  1066,  1090,  1113,  1136,  1161,  1185,  1209,
-    1231,  1243,  1255,  1267,  1279,  1292,  1305,  1322,  1338,  1366,
-    1392,  1420,  1421,  1422,  1423,  1424,  1425,  1426,  1427,  1431,
-    1454
+       0,   187,   187,   189,   193,   194,   195,   196,   197,   198,
+     199,   200,   201,   202,   203,   204,   205,   206,   207,   208,
+     209,   210,   211,   212,   213,   214,   215,   219,   224,   229,
+     235,   241,   247,   253,   259,   265,   272,   280,   290,   301,
+     302,   303,   304,   308,   316,   328,   339,   343,   348,   357,
+     369,   374,   380,   382,   386,   393,   400,   403,   417,   426,
+     428,   432,   445,   459,   471,   480,   483,   484,   485,   486,
+     487,   488,   489,   490,   491,   492,   493,   494,   497,   506,
+     523,   525,   530,   535,   537,   542,   545,   548,   552,   557,
+     563,   578,   595,   640,   688,   692,   698,   711,   719,   727,
+     735,   748,   761,   774,   787,   800,   813,   825,   837,   849,
+     865,   884,   887,   897,   907,   917,   930,   943,   956,   969,
+     982,   990,  1003,  1016,  1031,  1047,  1049,  1054,  1058,  1063,
+    1065,  1078,  1088,  1098,  1108,  1118,  1131,  1135,  1145,  1155,
+    1165,  1175,  1185,  1197,  1199,  1209,  1221,  1223,  1231,  1239,
+    1250,  1254,  1264,  1278,  1282,  1288,  1312,  1335,  1358,  1383,
+    1407,  1431,  1453,  1465,  1477,  1489,  1501,  1514,  1527,  1544,
+    1560,  1588,  1614,  1642,  1643,  1644,  1645,  1646,  1647,  1648,
+    1649,  1653,  1676
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SEMICOLON", "CREATE", "DROP", "TABLE",
-  "TABLES", "INDEX", "SELECT", "ASC", "DESC", "SHOW", "SYNC", "INSERT",
-  "DELETE", "UPDATE", "LBRACE", "RBRACE", "COMMA", "TRX_BEGIN",
-  "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T", "FLOAT_T", "DATE_T",
-  "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM", "WHERE", "AND", "SET",
-  "ON", "LOAD", "DATA", "INFILE", "EQ", "LT", "GT", "LE", "GE", "NE",
-  "INNER", "JOIN", "ORDER", "GROUP", "BY", "UNIQUE", "TEXT_T", "NOT",
-  "NULL_T", "NULLABLE", "IS_T", "IN_T", "NUMBER", "FLOAT", "ID", "PATH",
-  "SSS", "STAR", "STRING_V", "MAX", "MIN", "COUNT", "AVG", "$accept",
-  "commands", "command", "exit", "help", "sync", "begin", "commit",
-  "rollback", "drop_table", "show_tables", "desc_table", "create_index",
-  "id_def_list", "id_def", "drop_index", "create_table", "attr_def_list",
+  "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "CREATE",
+  "DROP", "TABLE", "TABLES", "INDEX", "SELECT", "ASC", "DESC", "SHOW",
+  "SYNC", "INSERT", "DELETE", "UPDATE", "LBRACE", "RBRACE", "COMMA",
+  "TRX_BEGIN", "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T",
+  "FLOAT_T", "DATE_T", "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM",
+  "WHERE", "AND", "SET", "ON", "LOAD", "DATA", "INFILE", "EQ", "LT", "GT",
+  "LE", "GE", "NE", "INNER", "JOIN", "ORDER", "GROUP", "BY", "UNIQUE",
+  "TEXT_T", "NOT", "NULL_T", "NULLABLE", "IS_T", "IN_T", "NUMBER", "FLOAT",
+  "ID", "PATH", "SSS", "STAR", "STRING_V", "MAX", "MIN", "COUNT", "AVG",
+  "'?'", "$accept", "commands", "command", "exit", "help", "sync", "begin",
+  "commit", "rollback", "drop_table", "show_tables", "desc_table",
+  "explain", "prepare", "prepared_statement", "execute", "deallocate",
+  "set_variable", "analyze_table", "create_index", "id_def_list", "id_def",
+  "drop_index", "create_table", "create_table_body", "attr_def_list",
   "attr_def", "number", "type", "ID_get", "insert", "muti_value_list",
   "muti_value", "value_list", "value", "delete", "update", "select",
   "join_list", "select_attr", "attr_list", "rel_list", "where", "order_by",
-  "order_by_list", "group_by", "group_by_list", "condition_list",
+  "order_by_list", "group_by", "limit", "group_by_list", "condition_list",
   "condition", "comOp", "subselect", "load_data", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -249
+#define YYPACT_NINF (-370)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-249)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-    -249,   137,  -249,    19,   116,   171,   -36,    38,    61,    29,
-      59,    44,   120,   125,   129,   163,   179,    73,  -249,  -249,
-    -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,
-    -249,  -249,  -249,  -249,  -249,  -249,    94,   133,   191,   162,
-     164,     7,  -249,   208,   211,   213,   215,   212,   242,   243,
-    -249,   187,   188,   214,  -249,  -249,  -249,  -249,  -249,   216,
-     233,   217,   192,   248,   251,   175,    56,  -249,   196,   197,
-      84,   198,   199,  -249,  -249,   229,   228,   202,   201,   204,
-     205,   230,  -249,  -249,    69,   250,   252,   253,   254,   249,
-     249,     5,    10,    11,   255,    14,     3,   257,    -6,   269,
-     235,   246,  -249,   258,    -5,   261,   219,   100,  -249,   220,
-     221,   131,   222,  -249,  -249,   249,   223,   249,   224,   249,
-     225,  -249,   249,   226,   227,   241,   228,   228,   138,   270,
-     281,  -249,  -249,  -249,   127,  -249,   145,   259,   176,  -249,
-     138,   285,   204,   274,    85,    90,   150,   151,  -249,   277,
-     236,   278,   249,   249,    26,    33,   279,   280,    63,  -249,
-     282,  -249,   283,  -249,   284,  -249,   286,   287,   239,   300,
-     260,   288,   257,   302,   171,   256,  -249,  -249,  -249,  -249,
-    -249,  -249,   262,    30,  -249,    13,   108,   119,    -6,  -249,
-      -3,   228,   263,   258,   306,   264,  -249,   266,  -249,   267,
-    -249,   268,  -249,   271,  -249,   291,   236,  -249,  -249,   249,
-     265,   249,   272,   249,   249,   249,   273,   249,   249,   249,
-     249,  -249,   275,  -249,   276,   289,   138,   294,   270,  -249,
-     292,   170,  -249,   290,  -249,  -249,  -249,  -249,   293,  -249,
-     298,  -249,   259,   299,  -249,   310,   311,  -249,  -249,  -249,
-    -249,  -249,  -249,  -249,   297,   236,   312,   291,  -249,   313,
-    -249,   316,  -249,  -249,  -249,   317,  -249,  -249,  -249,  -249,
-      -6,   295,   296,   314,   288,  -249,  -249,   301,   122,    20,
-    -249,  -249,   303,  -249,   304,  -249,  -249,  -249,   291,   333,
-     319,   249,   249,   249,   259,    31,   305,  -249,  -249,   287,
-     308,  -249,   320,  -249,  -249,  -249,  -249,  -249,  -249,   336,
-    -249,  -249,  -249,   307,   321,   321,   309,   315,  -249,    80,
-     228,  -249,   318,  -249,  -249,  -249,  -249,    76,   102,   322,
-     323,  -249,   324,  -249,   321,   321,   325,  -249,   321,   321,
-    -249,    91,   326,  -249,  -249,  -249,   107,  -249,  -249,   327,
-    -249,  -249,   321,   321,  -249,   326,  -249,  -249,  -249
+    -370,   117,  -370,    14,   119,   225,   -26,    36,    46,    59,
+      74,    50,   112,   116,   163,   184,   197,    82,   171,     8,
+    -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,
+    -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,    12,
+    -370,  -370,  -370,  -370,  -370,    90,   148,   207,   164,   173,
+      18,  -370,   213,   226,   235,   240,   210,   273,   275,  -370,
+     219,   222,   249,  -370,  -370,  -370,  -370,  -370,   258,   260,
+     241,     9,  -370,  -370,   297,   285,   267,   244,   302,   303,
+     247,   229,   -18,  -370,   248,   250,     1,   251,   252,  -370,
+    -370,   278,   280,   254,     2,   253,   313,  -370,   212,    16,
+    -370,  -370,   257,   259,   282,  -370,  -370,    64,    27,   304,
+     305,   306,   307,   301,   301,    87,    89,    91,   308,    94,
+       5,   310,    42,   322,   288,   326,   327,   328,   309,  -370,
+    -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,
+    -370,   314,  -370,   315,     3,   318,   272,   301,   276,   277,
+     144,  -370,   281,   283,   150,   284,  -370,  -370,   301,   286,
+     301,   287,   301,   289,  -370,   301,   290,   291,   293,   280,
+     280,   137,   319,   333,   206,   224,   311,   128,  -370,   137,
+    -370,  -370,  -370,   342,   137,   349,   257,   335,   139,   170,
+     200,   203,  -370,   337,   295,   339,  -370,   340,   106,   301,
+     301,   122,   138,   341,   343,   147,  -370,   344,  -370,   345,
+    -370,   346,  -370,   347,   338,   300,   363,   320,   314,   310,
+     364,   225,   312,  -370,  -370,  -370,  -370,  -370,  -370,   316,
+      30,  -370,   124,    93,   160,    42,  -370,     6,   280,   317,
+     314,  -370,   315,  -370,   321,  -370,   324,  -370,   325,  -370,
+     329,  -370,   323,  -370,   350,   295,   301,   301,   330,  -370,
+    -370,   301,   331,   301,   332,   301,   301,   301,   334,   301,
+     301,   301,   301,  -370,   348,  -370,   336,   351,   352,   319,
+    -370,   353,   230,  -370,   354,  -370,  -370,  -370,  -370,   355,
+    -370,   358,  -370,   311,   359,  -370,   368,   371,  -370,  -370,
+    -370,  -370,  -370,  -370,  -370,   362,   295,   375,   350,  -370,
+    -370,   377,  -370,   378,  -370,   379,  -370,  -370,  -370,   380,
+    -370,  -370,  -370,  -370,    42,   356,   357,   360,  -370,  -370,
+     361,   121,   143,  -370,  -370,   365,  -370,   366,  -370,  -370,
+     367,   350,   373,   381,   301,   301,   301,   301,   311,    69,
+     369,   370,   386,   338,   376,  -370,   372,  -370,  -370,  -370,
+    -370,  -370,  -370,  -370,   399,  -370,  -370,  -370,  -370,   385,
+     384,   384,   374,   382,  -370,    11,    17,  -370,   280,  -370,
+     383,  -370,  -370,  -370,  -370,    84,   169,   387,   388,  -370,
+     391,   392,   393,  -370,   384,   384,   394,  -370,   384,   384,
+    -370,    68,   395,  -370,  -370,  -370,  -370,  -370,   179,  -370,
+    -370,   396,  -370,  -370,   384,   384,  -370,   395,  -370,  -370,
+    -370
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
        2,     0,     1,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     3,    20,
-      19,    14,    15,    16,    17,     9,    10,    11,    12,    13,
-       8,     5,     7,     6,     4,    18,     0,     0,     0,     0,
-       0,    85,    72,     0,     0,     0,     0,     0,     0,     0,
-      23,     0,     0,     0,    24,    25,    26,    22,    21,     0,
-       0,     0,     0,     0,     0,     0,     0,    73,     0,     0,
-       0,     0,     0,    29,    28,     0,    99,     0,     0,     0,
-       0,     0,    27,    35,    85,     0,     0,     0,     0,    85,
-      85,     0,     0,     0,     0,     0,    97,     0,     0,     0,
-       0,     0,    55,    37,     0,     0,     0,     0,    86,     0,
-       0,     0,     0,    74,    75,    85,     0,    85,     0,    85,
-       0,    82,    85,     0,     0,     0,    99,    99,     0,    57,
-       0,    65,    62,    63,     0,    64,     0,   121,     0,    66,
-       0,     0,     0,     0,    43,    46,    49,    52,    41,    40,
-       0,     0,    85,    85,     0,     0,     0,     0,     0,    76,
-       0,    78,     0,    80,     0,    83,     0,    97,     0,     0,
-     101,    60,     0,     0,     0,     0,   141,   142,   143,   144,
-     145,   146,     0,     0,   147,     0,     0,     0,     0,   100,
-       0,    99,     0,    37,     0,     0,    45,     0,    48,     0,
-      51,     0,    54,     0,    34,    32,     0,    87,    88,    85,
-       0,    85,     0,    85,    85,    85,     0,    85,    85,    85,
-      85,    98,     0,    69,     0,   115,     0,     0,    57,    56,
-       0,     0,   148,     0,   130,   125,   123,   136,     0,   134,
-     126,   124,   121,   138,   140,     0,     0,    38,    36,    44,
-      47,    50,    53,    42,     0,     0,     0,    32,    89,     0,
-      91,     0,    93,    94,    95,     0,    77,    79,    81,    84,
-       0,     0,     0,     0,    60,    59,    58,     0,     0,     0,
-     131,   135,     0,   122,     0,    67,   150,    39,    32,     0,
-       0,    85,    85,    85,   121,   108,     0,    68,    61,    97,
-       0,   132,     0,   127,   137,   128,   139,    33,    30,     0,
-      90,    92,    96,    70,   108,   108,     0,     0,   102,   118,
-      99,   133,     0,    31,    71,   103,   104,   108,   108,     0,
-       0,   116,     0,   129,   108,   108,     0,   109,   108,   108,
-     105,   118,   118,   149,   110,   111,   108,   106,   107,     0,
-     119,   117,   108,   108,   112,   118,   113,   114,   120
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       3,    26,    25,    20,    21,    22,    23,    14,    15,    16,
+       5,     6,     7,     8,     9,    17,    18,    19,    13,     0,
+      10,    12,    11,     4,    24,     0,     0,     0,     0,     0,
+     111,    96,     0,     0,     0,     0,     0,     0,     0,    29,
+       0,     0,     0,    30,    31,    32,    28,    27,     0,     0,
+       0,     0,    36,    56,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    97,     0,     0,     0,     0,     0,    35,
+      34,     0,   127,     0,     0,     0,     0,    43,     0,     0,
+      37,    57,     0,     0,     0,    33,    55,     0,   111,     0,
+       0,     0,     0,   111,   111,     0,     0,     0,     0,     0,
+     125,     0,     0,     0,     0,     0,     0,     0,     0,    49,
+      38,    40,    42,    41,    39,    45,    88,    85,    86,    87,
+      89,    83,    78,    59,     0,     0,     0,   111,     0,     0,
+       0,   112,     0,     0,     0,     0,    98,    99,   111,     0,
+     111,     0,   111,     0,   106,   111,     0,     0,     0,   127,
+     127,     0,    80,     0,     0,     0,   153,     0,    90,     0,
+      47,    48,    46,     0,     0,     0,     0,     0,    66,    69,
+      72,    75,    64,    63,     0,     0,   109,     0,     0,   111,
+     111,     0,     0,     0,     0,     0,   100,     0,   102,     0,
+     104,     0,   107,     0,   125,     0,     0,   129,    83,     0,
+       0,     0,     0,   173,   174,   175,   176,   177,   178,     0,
+       0,   179,     0,     0,     0,     0,   128,     0,   127,     0,
+      83,    44,    59,    58,     0,    68,     0,    71,     0,    74,
+       0,    77,     0,    54,    52,     0,   111,   111,     0,   113,
+     114,   111,     0,   111,     0,   111,   111,   111,     0,   111,
+     111,   111,   111,   126,     0,    93,     0,   143,     0,    80,
+      79,     0,     0,   180,     0,   162,   157,   155,   168,     0,
+     166,   158,   156,   153,   170,   172,     0,     0,    84,    60,
+      67,    70,    73,    76,    65,     0,     0,     0,    52,   110,
+     123,     0,   115,     0,   117,     0,   119,   120,   121,     0,
+     101,   103,   105,   108,     0,     0,     0,   146,    82,    81,
+       0,     0,     0,   163,   167,     0,   154,     0,    91,   182,
+      61,    52,     0,     0,   111,   111,   111,   111,   153,   136,
+       0,     0,     0,   125,     0,   164,     0,   159,   169,   160,
+     171,    62,    53,    50,     0,   124,   116,   118,   122,    94,
+     136,   136,     0,     0,   130,   150,   147,    92,   127,   165,
+       0,    51,    95,   131,   132,   136,   136,     0,     0,   144,
+       0,     0,     0,   161,   136,   136,     0,   137,   136,   136,
+     133,   150,   150,   149,   148,   181,   138,   139,   136,   134,
+     135,     0,   151,   145,   136,   136,   140,   150,   141,   142,
+     152
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,
-    -249,  -249,  -249,  -242,  -197,  -249,  -249,   148,   206,  -249,
-    -249,  -249,  -249,   115,   178,    77,  -124,  -249,  -249,  -249,
-      39,   180,   -84,  -160,  -125,  -249,  -238,  -249,  -248,  -229,
-    -185,  -128,  -173,  -249
+    -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,
+    -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,  -370,
+    -283,  -239,  -370,  -370,  -370,   140,   218,  -370,  -370,  -370,
+     389,   126,   187,  -187,   -98,   390,   397,    -8,    41,   191,
+    -108,  -210,  -167,  -370,  -154,  -370,  -370,  -369,  -272,  -225,
+    -168,  -224,  -370
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     1,    18,    19,    20,    21,    22,    23,    24,    25,
-      26,    27,    28,   256,   205,    29,    30,   143,   103,   254,
-     149,   104,    31,   173,   129,   227,   136,    32,    33,    34,
-     126,    47,    67,   127,    99,   225,   318,   273,   331,   189,
-     137,   185,   138,    35
+       0,     1,    20,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,   130,    32,    33,    34,    35,    36,
+     307,   254,    37,    38,    39,   187,   143,   305,   193,   144,
+      40,   220,   172,   185,   175,    41,    42,    43,   169,    56,
+      83,   170,   123,   277,   374,   327,   352,   389,   236,   176,
+     232,   177,    44
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint16 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-     108,   169,   170,   242,   171,   113,   114,   221,   187,   257,
-     190,   130,   237,   283,   130,   290,   191,   244,   144,   145,
-     146,   147,   124,   115,    48,    36,    65,    37,   117,   119,
-     130,   159,   122,   161,   116,   163,    66,   130,   165,   118,
-     120,   314,   315,   123,   209,    49,   307,   148,   131,   125,
-     316,   211,   132,   133,   134,   210,   135,   243,   288,    51,
-     317,   236,   212,   241,    50,   313,   245,   131,   207,   208,
-      38,   132,   133,   235,   131,   135,   325,   326,   132,   133,
-     302,   215,   135,   233,   234,   294,   334,   335,    65,   337,
-     340,    52,   216,   350,   351,   316,   344,   345,   107,   329,
-     347,   348,   274,   279,    53,   336,   304,   358,   354,   330,
-     329,    59,   338,   339,   356,   357,    89,   352,   353,    90,
-     349,   316,    39,    54,    40,   258,   316,   260,    55,   262,
-     263,   264,    56,   266,   267,   268,   269,     2,   195,   320,
-     196,     3,     4,   197,    93,   198,     5,    94,     6,     7,
-       8,     9,    10,    11,    60,   303,   175,    12,    13,    14,
-     152,   238,   239,   153,    15,    16,    57,   176,   177,   178,
-     179,   180,   181,   131,    17,   300,   301,   132,   133,   240,
-     182,   135,    58,   183,   184,   176,   177,   178,   179,   180,
-     181,   156,   131,    61,   157,   332,   132,   133,   182,    62,
-     135,   186,   184,   199,   201,   200,   202,   310,   311,   312,
-     176,   177,   178,   179,   180,   181,   176,   177,   178,   179,
-     180,   181,    63,   182,    64,    68,   278,   184,    69,   182,
-      70,    41,    71,   184,    42,    84,    43,    44,    45,    46,
-      85,    86,    87,    88,    72,    73,    74,    75,    76,    77,
-      79,    82,    81,    80,    83,    78,    91,    92,    95,    96,
-      97,    98,   100,   101,   102,   105,   106,   109,    65,   110,
-     111,   112,   139,   121,   128,   140,   141,   142,   150,   151,
-     154,   155,   158,   160,   162,   164,   166,   167,   168,   172,
-     174,   192,   194,   188,   203,   206,   204,   213,   214,   222,
-     217,   218,   219,   223,   220,   229,   124,   226,   224,   248,
-     255,   270,   275,   285,   286,   287,   231,   297,   249,   232,
-     250,   251,   252,   246,   277,   259,   271,   282,   284,   253,
-     289,   291,   261,   265,   292,   293,   308,   309,   272,   323,
-     316,   247,   343,   276,   280,   329,   296,   281,   193,   322,
-     228,   298,   324,   125,   230,   295,     0,     0,     0,     0,
-       0,   299,   321,   305,   306,   319,     0,     0,     0,   327,
-       0,     0,     0,     0,     0,   328,     0,     0,   333,     0,
-       0,     0,   341,   342,     0,   346,     0,   355
+     151,   141,   216,   217,   273,   156,   157,   234,   288,   237,
+     293,    72,    97,   295,    70,    73,   308,     5,     5,   135,
+      45,   336,    46,   173,   167,   343,   188,   189,   190,   191,
+     387,   278,   412,   413,    57,    80,   390,    81,   125,   196,
+     388,    98,   113,    58,   149,   114,    81,    82,   420,    59,
+     206,   168,   208,   298,   210,   192,   150,   212,   362,   173,
+     126,   117,   127,   100,   118,    47,   294,   341,    71,    99,
+     136,   296,    74,   218,   137,   138,   369,   391,   139,   370,
+     371,   238,   147,   284,   285,   140,   240,   387,   372,    60,
+     134,   259,   260,   148,   394,   395,   136,   411,   373,   348,
+     137,   138,   174,   372,   139,   158,    61,   160,   358,   162,
+      62,   140,   165,   396,   332,    63,   159,     2,   161,    64,
+     163,     3,     4,   166,   257,    48,     5,    49,     6,     7,
+       8,     9,    10,    11,   287,   258,   292,    12,    13,    14,
+     261,   173,    68,   378,    15,    16,   289,   290,   309,   310,
+      75,   262,    17,   312,    18,   314,   263,   316,   317,   318,
+     173,   320,   321,   322,   323,   267,    65,   264,   223,   224,
+     225,   226,   227,   228,   354,   355,   268,    19,   136,   398,
+     399,   229,   137,   138,   286,   231,   139,    66,   372,   414,
+     415,   136,   244,   140,   245,   137,   138,   136,   372,   139,
+      67,   137,   138,   356,   199,   139,   140,   200,    76,    69,
+     203,   392,   140,   204,   136,    77,   383,   384,   137,   138,
+     291,     5,   139,   246,    78,   247,     9,    10,    11,   140,
+      84,   397,   400,    79,   357,   222,   365,   366,   367,   368,
+     406,   407,    88,    85,   409,   410,   223,   224,   225,   226,
+     227,   228,    86,   248,   416,   249,   250,    87,   251,   229,
+     418,   419,   230,   231,   223,   224,   225,   226,   227,   228,
+     223,   224,   225,   226,   227,   228,    89,   229,    90,    91,
+     233,   231,    92,   229,    93,    50,   331,   231,    51,   108,
+      52,    53,    54,    55,   109,   110,   111,   112,    94,    95,
+     101,    96,   102,   103,   104,   105,   106,   107,   115,   121,
+     116,   119,   120,   122,   124,   128,   129,   142,   146,   145,
+      81,   152,   153,   154,   155,   178,   164,   171,   179,   180,
+     181,   182,   195,   184,   186,   194,   197,   198,   219,   183,
+     215,   201,   221,   202,   205,   235,   207,   209,   239,   211,
+     213,   214,   241,   243,   252,   253,   255,   167,   256,   265,
+     274,   266,   269,   270,   271,   272,   275,   280,   276,   306,
+     328,   338,   282,   283,   339,   300,   363,   297,   301,   302,
+     340,   304,   299,   303,   324,   330,   325,   335,   337,   377,
+     311,   313,   315,   342,   319,   344,   345,   346,   347,   364,
+     326,   380,   381,   372,   242,   329,   279,   350,   333,   334,
+     382,   405,   281,     0,   387,     0,   349,     0,     0,     0,
+     351,   353,     0,     0,     0,   359,   360,   361,   376,   375,
+     379,   168,     0,     0,   385,     0,     0,     0,     0,     0,
+       0,     0,   386,   393,     0,     0,     0,   401,   402,   403,
+     404,     0,     0,     0,   408,     0,   417,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   131,   132,     0,
+       0,     0,     0,     0,     0,   133
 };
 
 static const yytype_int16 yycheck[] =
 {
-      84,   126,   127,   188,   128,    89,    90,   167,   136,   206,
-     138,    17,   185,   242,    17,   257,   140,   190,    23,    24,
-      25,    26,    19,    18,    60,     6,    19,     8,    18,    18,
-      17,   115,    18,   117,    29,   119,    29,    17,   122,    29,
-      29,    10,    11,    29,    18,     7,   288,    52,    54,    46,
-      19,    18,    58,    59,    60,    29,    62,    60,   255,    30,
-      29,   185,    29,   187,     3,   294,   191,    54,   152,   153,
-      51,    58,    59,    60,    54,    62,   314,   315,    58,    59,
-      60,    18,    62,    53,    54,   270,    10,    11,    19,   327,
-     328,    32,    29,   341,   342,    19,   334,   335,    29,    19,
-     338,   339,   226,   231,    60,    29,   279,   355,   346,    29,
-      19,    38,    10,    11,   352,   353,    60,    10,    11,    63,
-      29,    19,     6,     3,     8,   209,    19,   211,     3,   213,
-     214,   215,     3,   217,   218,   219,   220,     0,    53,   299,
-      55,     4,     5,    53,    60,    55,     9,    63,    11,    12,
-      13,    14,    15,    16,    60,   279,    29,    20,    21,    22,
-      60,    53,    54,    63,    27,    28,     3,    40,    41,    42,
-      43,    44,    45,    54,    37,    53,    54,    58,    59,    60,
-      53,    62,     3,    56,    57,    40,    41,    42,    43,    44,
-      45,    60,    54,    60,    63,   320,    58,    59,    53,     8,
-      62,    56,    57,    53,    53,    55,    55,   291,   292,   293,
-      40,    41,    42,    43,    44,    45,    40,    41,    42,    43,
-      44,    45,    60,    53,    60,    17,    56,    57,    17,    53,
-      17,    60,    17,    57,    63,    60,    65,    66,    67,    68,
-      65,    66,    67,    68,    32,     3,     3,    60,    60,    35,
-      17,     3,    60,    36,     3,    39,    60,    60,    60,    60,
-      31,    33,    60,    62,    60,    60,    36,    17,    19,    17,
-      17,    17,     3,    18,    17,    40,    30,    19,    17,    60,
-      60,    60,    60,    60,    60,    60,    60,    60,    47,    19,
-       9,     6,    18,    34,    17,    17,    60,    18,    18,    60,
-      18,    18,    18,     3,    18,     3,    19,    19,    48,     3,
-      19,    36,    18,     3,     3,    18,    60,     3,    54,    57,
-      54,    54,    54,    60,    32,    60,    50,    29,    29,    58,
-      18,    18,    60,    60,    18,    18,     3,    18,    49,     3,
-      19,   193,    18,   228,    54,    19,    50,    54,   142,    29,
-     172,   274,   313,    46,   174,    60,    -1,    -1,    -1,    -1,
-      -1,    60,    54,    60,    60,    60,    -1,    -1,    -1,    60,
-      -1,    -1,    -1,    -1,    -1,    60,    -1,    -1,    60,    -1,
-      -1,    -1,    60,    60,    -1,    60,    -1,    60
+     108,    99,   169,   170,   214,   113,   114,   175,   232,   177,
+     235,    19,     3,   237,     6,     3,   255,     9,     9,     3,
+       6,   293,     8,    17,    19,   308,    23,    24,    25,    26,
+      19,   218,   401,   402,    60,    17,    19,    19,    36,   147,
+      29,    32,    60,     7,    17,    63,    19,    29,   417,     3,
+     158,    46,   160,   240,   162,    52,    29,   165,   341,    17,
+      58,    60,    60,    71,    63,    51,    60,   306,    60,    60,
+      54,   238,    60,   171,    58,    59,   348,    60,    62,    10,
+      11,   179,    18,    53,    54,    69,   184,    19,    19,    30,
+      98,   199,   200,    29,    10,    11,    54,    29,    29,   324,
+      58,    59,    60,    19,    62,    18,    32,    18,   332,    18,
+      60,    69,    18,    29,   282,     3,    29,     0,    29,     3,
+      29,     4,     5,    29,    18,     6,     9,     8,    11,    12,
+      13,    14,    15,    16,   232,    29,   234,    20,    21,    22,
+      18,    17,    60,   353,    27,    28,    53,    54,   256,   257,
+      60,    29,    35,   261,    37,   263,    18,   265,   266,   267,
+      17,   269,   270,   271,   272,    18,     3,    29,    40,    41,
+      42,    43,    44,    45,    53,    54,    29,    60,    54,    10,
+      11,    53,    58,    59,    60,    57,    62,     3,    19,    10,
+      11,    54,    53,    69,    55,    58,    59,    54,    19,    62,
+       3,    58,    59,    60,    60,    62,    69,    63,    60,    38,
+      60,   378,    69,    63,    54,     8,   370,   371,    58,    59,
+      60,     9,    62,    53,    60,    55,    14,    15,    16,    69,
+      17,   385,   386,    60,   332,    29,   344,   345,   346,   347,
+     394,   395,    32,    17,   398,   399,    40,    41,    42,    43,
+      44,    45,    17,    53,   408,    55,    53,    17,    55,    53,
+     414,   415,    56,    57,    40,    41,    42,    43,    44,    45,
+      40,    41,    42,    43,    44,    45,     3,    53,     3,    60,
+      56,    57,    60,    53,    35,    60,    56,    57,    63,    60,
+      65,    66,    67,    68,    65,    66,    67,    68,    40,    39,
+       3,    60,    17,    36,    60,     3,     3,    60,    60,    31,
+      60,    60,    60,    33,    60,    62,     3,    60,    36,    60,
+      19,    17,    17,    17,    17,     3,    18,    17,    40,     3,
+       3,     3,    60,    19,    19,    17,    60,    60,    19,    30,
+      47,    60,     9,    60,    60,    34,    60,    60,     6,    60,
+      60,    60,     3,    18,    17,    60,    17,    19,    18,    18,
+      60,    18,    18,    18,    18,    18,     3,     3,    48,    19,
+      18,     3,    60,    57,     3,    54,     3,    60,    54,    54,
+      18,    58,   242,    54,    36,    32,    50,    29,    29,     3,
+      60,    60,    60,    18,    60,    18,    18,    18,    18,    18,
+      49,    29,     3,    19,   186,   279,   219,    50,    54,    54,
+     369,    18,   221,    -1,    19,    -1,    60,    -1,    -1,    -1,
+      60,    60,    -1,    -1,    -1,    60,    60,    60,    58,    60,
+      54,    46,    -1,    -1,    60,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    60,    60,    -1,    -1,    -1,    60,    60,    58,
+      58,    -1,    -1,    -1,    60,    -1,    60,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    98,    98,    -1,
+      -1,    -1,    -1,    -1,    -1,    98
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-       0,    70,     0,     4,     5,     9,    11,    12,    13,    14,
-      15,    16,    20,    21,    22,    27,    28,    37,    71,    72,
-      73,    74,    75,    76,    77,    78,    79,    80,    81,    84,
-      85,    91,    96,    97,    98,   112,     6,     8,    51,     6,
-       8,    60,    63,    65,    66,    67,    68,   100,    60,     7,
-       3,    30,    32,    60,     3,     3,     3,     3,     3,    38,
-      60,    60,     8,    60,    60,    19,    29,   101,    17,    17,
-      17,    17,    32,     3,     3,    60,    60,    35,    39,    17,
-      36,    60,     3,     3,    60,    65,    66,    67,    68,    60,
-      63,    60,    60,    60,    63,    60,    60,    31,    33,   103,
-      60,    62,    60,    87,    90,    60,    36,    29,   101,    17,
-      17,    17,    17,   101,   101,    18,    29,    18,    29,    18,
-      29,    18,    18,    29,    19,    46,    99,   102,    17,    93,
-      17,    54,    58,    59,    60,    62,    95,   109,   111,     3,
-      40,    30,    19,    86,    23,    24,    25,    26,    52,    89,
-      17,    60,    60,    63,    60,    60,    60,    63,    60,   101,
-      60,   101,    60,   101,    60,   101,    60,    60,    47,   103,
-     103,    95,    19,    92,     9,    29,    40,    41,    42,    43,
-      44,    45,    53,    56,    57,   110,    56,   110,    34,   108,
-     110,    95,     6,    87,    18,    53,    55,    53,    55,    53,
-      55,    53,    55,    17,    60,    83,    17,   101,   101,    18,
-      29,    18,    29,    18,    18,    18,    29,    18,    18,    18,
-      18,   102,    60,     3,    48,   104,    19,    94,    93,     3,
-     100,    60,    57,    53,    54,    60,    95,   111,    53,    54,
-      60,    95,   109,    60,   111,   103,    60,    86,     3,    54,
-      54,    54,    54,    58,    88,    19,    82,    83,   101,    60,
-     101,    60,   101,   101,   101,    60,   101,   101,   101,   101,
-      36,    50,    49,   106,    95,    18,    92,    32,    56,   110,
-      54,    54,    29,   108,    29,     3,     3,    18,    83,    18,
-      82,    18,    18,    18,   109,    60,    50,     3,    94,    60,
-      53,    54,    60,    95,   111,    60,    60,    82,     3,    18,
-     101,   101,   101,   108,    10,    11,    19,    29,   105,    60,
-     102,    54,    29,     3,    99,   105,   105,    60,    60,    19,
-      29,   107,   103,    60,    10,    11,    29,   105,    10,    11,
-     105,    60,    60,    18,   105,   105,    60,   105,   105,    29,
-     107,   107,    10,    11,   105,    60,   105,   105,   107
+       0,    71,     0,     4,     5,     9,    11,    12,    13,    14,
+      15,    16,    20,    21,    22,    27,    28,    35,    37,    60,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
+      82,    83,    85,    86,    87,    88,    89,    92,    93,    94,
+     100,   105,   106,   107,   122,     6,     8,    51,     6,     8,
+      60,    63,    65,    66,    67,    68,   109,    60,     7,     3,
+      30,    32,    60,     3,     3,     3,     3,     3,    60,    38,
+       6,    60,   107,     3,    60,    60,    60,     8,    60,    60,
+      17,    19,    29,   110,    17,    17,    17,    17,    32,     3,
+       3,    60,    60,    35,    40,    39,    60,     3,    32,    60,
+     107,     3,    17,    36,    60,     3,     3,    60,    60,    65,
+      66,    67,    68,    60,    63,    60,    60,    60,    63,    60,
+      60,    31,    33,   112,    60,    36,    58,    60,    62,     3,
+      84,   100,   105,   106,   107,     3,    54,    58,    59,    62,
+      69,   104,    60,    96,    99,    60,    36,    18,    29,    17,
+      29,   110,    17,    17,    17,    17,   110,   110,    18,    29,
+      18,    29,    18,    29,    18,    18,    29,    19,    46,   108,
+     111,    17,   102,    17,    60,   104,   119,   121,     3,    40,
+       3,     3,     3,    30,    19,   103,    19,    95,    23,    24,
+      25,    26,    52,    98,    17,    60,   110,    60,    60,    60,
+      63,    60,    60,    60,    63,    60,   110,    60,   110,    60,
+     110,    60,   110,    60,    60,    47,   112,   112,   104,    19,
+     101,     9,    29,    40,    41,    42,    43,    44,    45,    53,
+      56,    57,   120,    56,   120,    34,   118,   120,   104,     6,
+     104,     3,    96,    18,    53,    55,    53,    55,    53,    55,
+      53,    55,    17,    60,    91,    17,    18,    18,    29,   110,
+     110,    18,    29,    18,    29,    18,    18,    18,    29,    18,
+      18,    18,    18,   111,    60,     3,    48,   113,   103,   102,
+       3,   109,    60,    57,    53,    54,    60,   104,   121,    53,
+      54,    60,   104,   119,    60,   121,   112,    60,   103,    95,
+      54,    54,    54,    54,    58,    97,    19,    90,    91,   110,
+     110,    60,   110,    60,   110,    60,   110,   110,   110,    60,
+     110,   110,   110,   110,    36,    50,    49,   115,    18,   101,
+      32,    56,   120,    54,    54,    29,   118,    29,     3,     3,
+      18,    91,    18,    90,    18,    18,    18,    18,   119,    60,
+      50,    60,   116,    60,    53,    54,    60,   104,   121,    60,
+      60,    60,    90,     3,    18,   110,   110,   110,   110,   118,
+      10,    11,    19,    29,   114,    60,    58,     3,   111,    54,
+      29,     3,   108,   114,   114,    60,    60,    19,    29,   117,
+      19,    60,   112,    60,    10,    11,    29,   114,    10,    11,
+     114,    60,    60,    58,    58,    18,   114,   114,    60,   114,
+     114,    29,   117,   117,    10,    11,   114,    60,   114,   114,
+     117
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    69,    70,    70,    71,    71,    71,    71,    71,    71,
-      71,    71,    71,    71,    71,    71,    71,    71,    71,    71,
-      71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
-      81,    81,    82,    82,    83,    84,    85,    86,    86,    87,
-      87,    87,    88,    89,    89,    89,    89,    89,    89,    89,
-      89,    89,    89,    89,    89,    90,    91,    92,    92,    93,
-      94,    94,    95,    95,    95,    95,    96,    97,    98,    98,
-      99,    99,   100,   100,   100,   100,   100,   100,   100,   100,
-     100,   100,   100,   100,   100,   101,   101,   101,   101,   101,
-     101,   101,   101,   101,   101,   101,   101,   102,   102,   103,
-     103,   104,   104,   104,   104,   104,   104,   104,   105,   105,
-     105,   105,   105,   105,   105,   106,   106,   106,   107,   107,
-     107,   108,   108,   109,   109,   109,   109,   109,   109,   109,
+       0,    70,    71,    71,    72,    72,    72,    72,    72,    72,
+      72,    72,    72,    72,    72,    72,    72,    72,    72,    72,
+      72,    72,    72,    72,    72,    72,    72,    73,    74,    75,
+      76,    77,    78,    79,    80,    81,    82,    82,    83,    84,
+      84,    84,    84,    85,    85,    86,    87,    87,    87,    88,
+      89,    89,    90,    90,    91,    92,    93,    93,    94,    95,
+      95,    96,    96,    96,    96,    97,    98,    98,    98,    98,
+      98,    98,    98,    98,    98,    98,    98,    98,    99,   100,
+     101,   101,   102,   103,   103,   104,   104,   104,   104,   104,
+     105,   106,   107,   107,   108,   108,   109,   109,   109,   109,
      109,   109,   109,   109,   109,   109,   109,   109,   109,   109,
-     109,   110,   110,   110,   110,   110,   110,   110,   110,   111,
-     112
+     109,   110,   110,   110,   110,   110,   110,   110,   110,   110,
+     110,   110,   110,   110,   110,   111,   111,   112,   112,   113,
+     113,   113,   113,   113,   113,   113,   114,   114,   114,   114,
+     114,   114,   114,   115,   115,   115,   116,   116,   116,   116,
+     117,   117,   117,   118,   118,   119,   119,   119,   119,   119,
+     119,   119,   119,   119,   119,   119,   119,   119,   119,   119,
+     119,   119,   119,   120,   120,   120,   120,   120,   120,   120,
+     120,   121,   122
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     2,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     2,     2,     2,     2,     2,     2,     4,     3,     3,
-      10,    11,     0,     3,     1,     4,     8,     0,     3,     5,
-       2,     2,     1,     1,     3,     2,     1,     3,     2,     1,
-       3,     2,     1,     3,     2,     1,     7,     0,     3,     4,
-       0,     3,     1,     1,     1,     1,     5,     8,     9,     7,
-       6,     7,     1,     2,     4,     4,     5,     7,     5,     7,
-       5,     7,     4,     5,     7,     0,     3,     5,     5,     6,
-       8,     6,     8,     6,     6,     6,     8,     0,     3,     0,
-       3,     0,     4,     5,     5,     6,     7,     7,     0,     3,
-       4,     4,     5,     6,     6,     0,     4,     6,     0,     3,
-       5,     0,     3,     3,     3,     3,     3,     5,     5,     7,
-       3,     4,     5,     6,     3,     4,     3,     5,     3,     5,
-       3,     1,     1,     1,     1,     1,     1,     1,     2,     8,
-       8
+       1,     1,     1,     1,     1,     1,     1,     2,     2,     2,
+       2,     2,     2,     4,     3,     3,     2,     3,     4,     1,
+       1,     1,     1,     3,     6,     4,     5,     5,     5,     4,
+      10,    11,     0,     3,     1,     4,     2,     3,     7,     0,
+       3,     5,     6,     2,     2,     1,     1,     3,     2,     1,
+       3,     2,     1,     3,     2,     1,     3,     2,     1,     7,
+       0,     3,     4,     0,     3,     1,     1,     1,     1,     1,
+       5,     8,    10,     7,     6,     7,     1,     2,     4,     4,
+       5,     7,     5,     7,     5,     7,     4,     5,     7,     5,
+       7,     0,     3,     5,     5,     6,     8,     6,     8,     6,
+       6,     6,     8,     6,     8,     0,     3,     0,     3,     0,
+       4,     5,     5,     6,     7,     7,     0,     3,     4,     4,
+       5,     6,     6,     0,     4,     6,     0,     2,     4,     4,
+       0,     3,     5,     0,     3,     3,     3,     3,     3,     5,
+       5,     7,     3,     4,     5,     6,     3,     4,     3,     5,
+       3,     5,     3,     1,     1,     1,     1,     1,     1,     1,
+       2,     8,     8
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (scanner, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -988,56 +1154,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, scanner); \
+                  Kind, Value, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *scanner)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (scanner);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *scanner)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, scanner);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1046,7 +1209,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, voi
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1069,21 +1232,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule, void *scanner)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void *scanner)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              , scanner);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1098,8 +1261,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1122,249 +1285,34 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *scanner)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void *scanner)
 {
-  YYUSE (yyvaluep);
-  YYUSE (scanner);
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1372,7 +1320,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *scanner)
 int
 yyparse (void *scanner)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1383,45 +1331,38 @@ YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
 YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1429,71 +1370,75 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1501,30 +1446,31 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1535,18 +1481,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1574,15 +1531,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1597,7 +1552,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1617,281 +1572,436 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 21:
-#line 210 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 27: /* exit: EXIT SEMICOLON  */
+#line 219 "yacc_sql.y"
+                   {
         CONTEXT->ssql->flag=SCF_EXIT;//"exit";
     }
-#line 1626 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1581 "yacc_sql.tab.c"
     break;
 
-  case 22:
-#line 215 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 28: /* help: HELP SEMICOLON  */
+#line 224 "yacc_sql.y"
+                   {
         CONTEXT->ssql->flag=SCF_HELP;//"help";
     }
-#line 1634 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1589 "yacc_sql.tab.c"
     break;
 
-  case 23:
-#line 220 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 29: /* sync: SYNC SEMICOLON  */
+#line 229 "yacc_sql.y"
+                   {
       CONTEXT->ssql->flag = SCF_SYNC;
     }
-#line 1642 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1597 "yacc_sql.tab.c"
     break;
 
-  case 24:
-#line 226 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 30: /* begin: TRX_BEGIN SEMICOLON  */
+#line 235 "yacc_sql.y"
+                        {
       CONTEXT->ssql->flag = SCF_BEGIN;
     }
-#line 1650 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1605 "yacc_sql.tab.c"
     break;
 
-  case 25:
-#line 232 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 31: /* commit: TRX_COMMIT SEMICOLON  */
+#line 241 "yacc_sql.y"
+                         {
       CONTEXT->ssql->flag = SCF_COMMIT;
     }
-#line 1658 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1613 "yacc_sql.tab.c"
     break;
 
-  case 26:
-#line 238 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 32: /* rollback: TRX_ROLLBACK SEMICOLON  */
+#line 247 "yacc_sql.y"
+                           {
       CONTEXT->ssql->flag = SCF_ROLLBACK;
     }
-#line 1666 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1621 "yacc_sql.tab.c"
     break;
 
-  case 27:
-#line 244 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 33: /* drop_table: DROP TABLE ID SEMICOLON  */
+#line 253 "yacc_sql.y"
+                            {
         CONTEXT->ssql->flag = SCF_DROP_TABLE;//"drop_table";
         drop_table_init(&CONTEXT->ssql->sstr.drop_table, (yyvsp[-1].string));
     }
-#line 1675 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1630 "yacc_sql.tab.c"
     break;
 
-  case 28:
-#line 250 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 34: /* show_tables: SHOW TABLES SEMICOLON  */
+#line 259 "yacc_sql.y"
+                          {
       CONTEXT->ssql->flag = SCF_SHOW_TABLES;
     }
-#line 1683 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1638 "yacc_sql.tab.c"
     break;
 
-  case 29:
-#line 256 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 35: /* desc_table: DESC ID SEMICOLON  */
+#line 265 "yacc_sql.y"
+                      {
       CONTEXT->ssql->flag = SCF_DESC_TABLE;
       desc_table_init(&CONTEXT->ssql->sstr.desc_table, (yyvsp[-1].string));
     }
-#line 1692 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1647 "yacc_sql.tab.c"
     break;
 
-  case 30:
-#line 264 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 36: /* explain: ID select  */
+#line 272 "yacc_sql.y"
+              {
+      // explain不是关键字，按ID解析
+      if (strcasecmp((yyvsp[-1].string), "explain") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->explain = EXPLAIN_PLAN;
+    }
+#line 1660 "yacc_sql.tab.c"
+    break;
+
+  case 37: /* explain: ID ID select  */
+#line 280 "yacc_sql.y"
+                   {
+      if (strcasecmp((yyvsp[-2].string), "explain") != 0 || strcasecmp((yyvsp[-1].string), "analyze") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->explain = EXPLAIN_ANALYZE;
+    }
+#line 1672 "yacc_sql.tab.c"
+    break;
+
+  case 38: /* prepare: ID ID FROM prepared_statement  */
+#line 290 "yacc_sql.y"
+                                  {
+      // prepare不是关键字，按ID解析。语句本身照常解析，只记下语句的名字
+      if (strcasecmp((yyvsp[-3].string), "prepare") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      query_set_prepare_name(CONTEXT->ssql, (yyvsp[-2].string));
+    }
+#line 1685 "yacc_sql.tab.c"
+    break;
+
+  case 43: /* execute: ID ID SEMICOLON  */
+#line 308 "yacc_sql.y"
+                    {
+      if (strcasecmp((yyvsp[-2].string), "execute") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_EXECUTE;
+      execute_prepared_init(&CONTEXT->ssql->sstr.execution, (yyvsp[-1].string), NULL, 0);
+    }
+#line 1698 "yacc_sql.tab.c"
+    break;
+
+  case 44: /* execute: ID ID ID value value_list SEMICOLON  */
+#line 316 "yacc_sql.y"
+                                          {
+      if (strcasecmp((yyvsp[-5].string), "execute") != 0 || strcasecmp((yyvsp[-3].string), "using") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_EXECUTE;
+      execute_prepared_init(&CONTEXT->ssql->sstr.execution, (yyvsp[-4].string), CONTEXT->values, CONTEXT->value_length);
+      CONTEXT->value_length = 0;
+    }
+#line 1712 "yacc_sql.tab.c"
+    break;
+
+  case 45: /* deallocate: ID ID ID SEMICOLON  */
+#line 328 "yacc_sql.y"
+                       {
+      if (strcasecmp((yyvsp[-3].string), "deallocate") != 0 || strcasecmp((yyvsp[-2].string), "prepare") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_DEALLOCATE;
+      deallocate_prepared_init(&CONTEXT->ssql->sstr.deallocation, (yyvsp[-1].string));
+    }
+#line 1725 "yacc_sql.tab.c"
+    break;
+
+  case 46: /* set_variable: SET ID EQ ID SEMICOLON  */
+#line 339 "yacc_sql.y"
+                           {
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, (yyvsp[-3].string), (yyvsp[-1].string));
+    }
+#line 1734 "yacc_sql.tab.c"
+    break;
+
+  case 47: /* set_variable: SET ID EQ ON SEMICOLON  */
+#line 343 "yacc_sql.y"
+                             {
+      // on是关键字
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, (yyvsp[-3].string), "on");
+    }
+#line 1744 "yacc_sql.tab.c"
+    break;
+
+  case 48: /* set_variable: SET ID EQ NUMBER SEMICOLON  */
+#line 348 "yacc_sql.y"
+                                 {
+      char value[16];
+      snprintf(value, sizeof(value), "%d", (yyvsp[-1].number));
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, (yyvsp[-3].string), value);
+    }
+#line 1755 "yacc_sql.tab.c"
+    break;
+
+  case 49: /* analyze_table: ID TABLE ID SEMICOLON  */
+#line 357 "yacc_sql.y"
+                          {
+      // analyze不是关键字，按ID解析
+      if (strcasecmp((yyvsp[-3].string), "analyze") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_ANALYZE_TABLE;
+      analyze_table_init(&CONTEXT->ssql->sstr.analyze_table, (yyvsp[-1].string));
+    }
+#line 1769 "yacc_sql.tab.c"
+    break;
+
+  case 50: /* create_index: CREATE INDEX ID ON ID LBRACE id_def id_def_list RBRACE SEMICOLON  */
+#line 370 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag = SCF_CREATE_INDEX;//"create_index";
 			create_index_init(&CONTEXT->ssql->sstr.create_index, (yyvsp[-7].string), (yyvsp[-5].string));
 		}
-#line 1701 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1778 "yacc_sql.tab.c"
     break;
 
-  case 31:
-#line 269 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 51: /* create_index: CREATE UNIQUE INDEX ID ON ID LBRACE id_def id_def_list RBRACE SEMICOLON  */
+#line 375 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag = SCF_CREATE_INDEX;//"create_index";
 			create_unique_index_init(&CONTEXT->ssql->sstr.create_index, (yyvsp[-7].string), (yyvsp[-5].string));
 		}
-#line 1710 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1787 "yacc_sql.tab.c"
     break;
 
-  case 33:
-#line 276 "yacc_sql.y" /* yacc.c:1646  */
-    {    }
-#line 1716 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 53: /* id_def_list: COMMA id_def id_def_list  */
+#line 382 "yacc_sql.y"
+                                   {    }
+#line 1793 "yacc_sql.tab.c"
     break;
 
-  case 34:
-#line 281 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 54: /* id_def: ID  */
+#line 387 "yacc_sql.y"
+                {
 			create_index_append_attribute(&CONTEXT->ssql->sstr.create_index,(yyvsp[0].string));
 		}
-#line 1724 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1801 "yacc_sql.tab.c"
     break;
 
-  case 35:
-#line 288 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 55: /* drop_index: DROP INDEX ID SEMICOLON  */
+#line 394 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag=SCF_DROP_INDEX;//"drop_index";
 			drop_index_init(&CONTEXT->ssql->sstr.drop_index, (yyvsp[-1].string));
 		}
-#line 1733 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1810 "yacc_sql.tab.c"
     break;
 
-  case 36:
-#line 295 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 56: /* create_table: create_table_body SEMICOLON  */
+#line 401 "yacc_sql.y"
+                {
+		}
+#line 1817 "yacc_sql.tab.c"
+    break;
+
+  case 57: /* create_table: create_table_body ID SEMICOLON  */
+#line 404 "yacc_sql.y"
+                {
+			// 指定存储格式: create table t(...) pax
+			if (strcasecmp((yyvsp[-1].string), "pax") == 0) {
+				CONTEXT->ssql->sstr.create_table.storage_format = PAX_FORMAT;
+			} else if (strcasecmp((yyvsp[-1].string), "row") == 0) {
+				CONTEXT->ssql->sstr.create_table.storage_format = ROW_FORMAT;
+			} else {
+				yyerror(scanner, "unsupported storage format");
+				YYABORT;
+			}
+		}
+#line 1833 "yacc_sql.tab.c"
+    break;
+
+  case 58: /* create_table_body: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
+#line 418 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag=SCF_CREATE_TABLE;//"create_table";
 			// CONTEXT->ssql->sstr.create_table.attribute_count = CONTEXT->value_length;
-			create_table_init_name(&CONTEXT->ssql->sstr.create_table, (yyvsp[-5].string));
+			create_table_init_name(&CONTEXT->ssql->sstr.create_table, (yyvsp[-4].string));
 			//临时变量清零	
 			CONTEXT->value_length = 0;
 		}
-#line 1745 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1845 "yacc_sql.tab.c"
     break;
 
-  case 38:
-#line 305 "yacc_sql.y" /* yacc.c:1646  */
-    {    }
-#line 1751 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 60: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 428 "yacc_sql.y"
+                                   {    }
+#line 1851 "yacc_sql.tab.c"
     break;
 
-  case 39:
-#line 310 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 61: /* attr_def: ID_get type LBRACE number RBRACE  */
+#line 433 "yacc_sql.y"
+                {
 			AttrInfo attribute;
 			attr_info_init(&attribute, CONTEXT->id, (yyvsp[-3].number), (yyvsp[-1].number));
+			attribute.nullable = CONTEXT->nullable;
 			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
 			CONTEXT->value_length++;
-			if ((yyvsp[-3].number) == INTS_NULLABLE || (yyvsp[-3].number) == FLOATS_NULLABLE || (yyvsp[-3].number) == CHARS_NULLABLE || (yyvsp[-3].number) == DATES_NULLABLE) {
-				attr_info_init(&attribute, "NULL", IF_NULL, 4);
-				create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
-				CONTEXT->value_length++;
-			}
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name =(char*)malloc(sizeof(char));
 			// strcpy(CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name, CONTEXT->id); 
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].type = $2;  
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].length = $4;
 			
 		}
-#line 1772 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1868 "yacc_sql.tab.c"
     break;
 
-  case 40:
-#line 327 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 62: /* attr_def: ID_get type LBRACE number RBRACE ID  */
+#line 446 "yacc_sql.y"
+                {
+			// 字典编码的字符串字段: name char(n) dict
+			if ((yyvsp[-4].number) != CHARS || strcasecmp((yyvsp[0].string), "dict") != 0) {
+				yyerror(scanner, "unsupported column option");
+				YYABORT;
+			}
+			AttrInfo attribute;
+			attr_info_init(&attribute, CONTEXT->id, (yyvsp[-4].number), (yyvsp[-2].number));
+			attribute.nullable = CONTEXT->nullable;
+			attribute.dict = true;
+			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
+			CONTEXT->value_length++;
+		}
+#line 1886 "yacc_sql.tab.c"
+    break;
+
+  case 63: /* attr_def: ID_get type  */
+#line 460 "yacc_sql.y"
+                {
 			AttrInfo attribute;
 			attr_info_init(&attribute, CONTEXT->id, (yyvsp[0].number), 4);
+			attribute.nullable = CONTEXT->nullable;
 			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name=(char*)malloc(sizeof(char));
 			// strcpy(CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name, CONTEXT->id); 
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].type=$2;  
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].length=4; // default attribute length
 			CONTEXT->value_length++;
-			if ((yyvsp[0].number) == INTS_NULLABLE || (yyvsp[0].number) == FLOATS_NULLABLE || (yyvsp[0].number) == CHARS_NULLABLE || (yyvsp[0].number) == DATES_NULLABLE) {
-				attr_info_init(&attribute, "NULL", IF_NULL, 4);
-				create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
-				CONTEXT->value_length++;
-			}
 		}
-#line 1792 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1902 "yacc_sql.tab.c"
     break;
 
-  case 41:
-#line 343 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 64: /* attr_def: ID_get TEXT_T  */
+#line 472 "yacc_sql.y"
+                {
 			AttrInfo attribute;
 			attr_info_init(&attribute, CONTEXT->id, CHARS, 4096);
 			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
 			CONTEXT->value_length++;
 		}
-#line 1803 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 1913 "yacc_sql.tab.c"
     break;
 
-  case 42:
-#line 351 "yacc_sql.y" /* yacc.c:1646  */
-    {(yyval.number) = (yyvsp[0].number);}
-#line 1809 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 65: /* number: NUMBER  */
+#line 480 "yacc_sql.y"
+                       {(yyval.number) = (yyvsp[0].number);}
+#line 1919 "yacc_sql.tab.c"
     break;
 
-  case 43:
-#line 354 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=INTS; }
-#line 1815 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 66: /* type: INT_T  */
+#line 483 "yacc_sql.y"
+              { (yyval.number)=INTS; CONTEXT->nullable=0; }
+#line 1925 "yacc_sql.tab.c"
     break;
 
-  case 44:
-#line 355 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=INTS; }
-#line 1821 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 67: /* type: INT_T NOT NULL_T  */
+#line 484 "yacc_sql.y"
+                           { (yyval.number)=INTS; CONTEXT->nullable=0; }
+#line 1931 "yacc_sql.tab.c"
     break;
 
-  case 45:
-#line 356 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=INTS_NULLABLE; }
-#line 1827 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 68: /* type: INT_T NULLABLE  */
+#line 485 "yacc_sql.y"
+                         { (yyval.number)=INTS; CONTEXT->nullable=1; }
+#line 1937 "yacc_sql.tab.c"
     break;
 
-  case 46:
-#line 357 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=CHARS; }
-#line 1833 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 69: /* type: STRING_T  */
+#line 486 "yacc_sql.y"
+               { (yyval.number)=CHARS; CONTEXT->nullable=0; }
+#line 1943 "yacc_sql.tab.c"
     break;
 
-  case 47:
-#line 358 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=CHARS; }
-#line 1839 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 70: /* type: STRING_T NOT NULL_T  */
+#line 487 "yacc_sql.y"
+                              { (yyval.number)=CHARS; CONTEXT->nullable=0; }
+#line 1949 "yacc_sql.tab.c"
     break;
 
-  case 48:
-#line 359 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=CHARS_NULLABLE; }
-#line 1845 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 71: /* type: STRING_T NULLABLE  */
+#line 488 "yacc_sql.y"
+                            { (yyval.number)=CHARS; CONTEXT->nullable=1; }
+#line 1955 "yacc_sql.tab.c"
     break;
 
-  case 49:
-#line 360 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=FLOATS; }
-#line 1851 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 72: /* type: FLOAT_T  */
+#line 489 "yacc_sql.y"
+              { (yyval.number)=FLOATS; CONTEXT->nullable=0; }
+#line 1961 "yacc_sql.tab.c"
     break;
 
-  case 50:
-#line 361 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=FLOATS; }
-#line 1857 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 73: /* type: FLOAT_T NOT NULL_T  */
+#line 490 "yacc_sql.y"
+                             { (yyval.number)=FLOATS; CONTEXT->nullable=0; }
+#line 1967 "yacc_sql.tab.c"
     break;
 
-  case 51:
-#line 362 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=FLOATS_NULLABLE; }
-#line 1863 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 74: /* type: FLOAT_T NULLABLE  */
+#line 491 "yacc_sql.y"
+                           { (yyval.number)=FLOATS; CONTEXT->nullable=1; }
+#line 1973 "yacc_sql.tab.c"
     break;
 
-  case 52:
-#line 363 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=DATES; }
-#line 1869 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 75: /* type: DATE_T  */
+#line 492 "yacc_sql.y"
+                 { (yyval.number)=DATES; CONTEXT->nullable=0; }
+#line 1979 "yacc_sql.tab.c"
     break;
 
-  case 53:
-#line 364 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=DATES; }
-#line 1875 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 76: /* type: DATE_T NOT NULL_T  */
+#line 493 "yacc_sql.y"
+                            { (yyval.number)=DATES; CONTEXT->nullable=0; }
+#line 1985 "yacc_sql.tab.c"
     break;
 
-  case 54:
-#line 365 "yacc_sql.y" /* yacc.c:1646  */
-    { (yyval.number)=DATES_NULLABLE; }
-#line 1881 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 77: /* type: DATE_T NULLABLE  */
+#line 494 "yacc_sql.y"
+                          { (yyval.number)=DATES; CONTEXT->nullable=1; }
+#line 1991 "yacc_sql.tab.c"
     break;
 
-  case 55:
-#line 369 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 78: /* ID_get: ID  */
+#line 498 "yacc_sql.y"
+        {
 		char *temp=(yyvsp[0].string); 
 		snprintf(CONTEXT->id, sizeof(CONTEXT->id), "%s", temp);
 	}
-#line 1890 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2000 "yacc_sql.tab.c"
     break;
 
-  case 56:
-#line 378 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 79: /* insert: INSERT INTO ID VALUES muti_value muti_value_list SEMICOLON  */
+#line 507 "yacc_sql.y"
+                {
 			// CONTEXT->values[CONTEXT->value_length++] = *$6;
 
 			CONTEXT->ssql->flag=SCF_INSERT;//"insert";
@@ -1906,71 +2016,80 @@ yyreduce:
       CONTEXT->value_length=0;
 	  CONTEXT->data_num=0;
     }
-#line 1910 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2020 "yacc_sql.tab.c"
     break;
 
-  case 58:
-#line 396 "yacc_sql.y" /* yacc.c:1646  */
-    { 
+  case 81: /* muti_value_list: COMMA muti_value muti_value_list  */
+#line 525 "yacc_sql.y"
+                                        { 
   		// CONTEXT->values[CONTEXT->value_length++] = *$2;
 	  }
-#line 1918 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2028 "yacc_sql.tab.c"
     break;
 
-  case 59:
-#line 401 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 82: /* muti_value: LBRACE value value_list RBRACE  */
+#line 530 "yacc_sql.y"
+                                       {
 		CONTEXT->data_num++;
 	}
-#line 1926 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2036 "yacc_sql.tab.c"
     break;
 
-  case 61:
-#line 408 "yacc_sql.y" /* yacc.c:1646  */
-    { 
+  case 84: /* value_list: COMMA value value_list  */
+#line 537 "yacc_sql.y"
+                              { 
   		// CONTEXT->values[CONTEXT->value_length++] = *$2;
 	  }
-#line 1934 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2044 "yacc_sql.tab.c"
     break;
 
-  case 62:
-#line 413 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 85: /* value: NUMBER  */
+#line 542 "yacc_sql.y"
+          {	
   		value_init_integer(&CONTEXT->values[CONTEXT->value_length++], (yyvsp[0].number));
 		}
-#line 1942 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2052 "yacc_sql.tab.c"
     break;
 
-  case 63:
-#line 416 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 86: /* value: FLOAT  */
+#line 545 "yacc_sql.y"
+          {
   		value_init_float(&CONTEXT->values[CONTEXT->value_length++], (yyvsp[0].floats));
 		}
-#line 1950 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2060 "yacc_sql.tab.c"
     break;
 
-  case 64:
-#line 419 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 87: /* value: SSS  */
+#line 548 "yacc_sql.y"
+         {
 			(yyvsp[0].string) = substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
   		value_init_string(&CONTEXT->values[CONTEXT->value_length++], (yyvsp[0].string));
 		}
-#line 1959 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2069 "yacc_sql.tab.c"
     break;
 
-  case 65:
-#line 423 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 88: /* value: NULL_T  */
+#line 552 "yacc_sql.y"
+            {
 		// $1 = substr($1,1,strlen($1)-2);
   		// value_init_string(&CONTEXT->values[CONTEXT->value_length++], "null");
 		  value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
 	}
-#line 1969 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2079 "yacc_sql.tab.c"
     break;
 
-  case 66:
-#line 431 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 89: /* value: '?'  */
+#line 557 "yacc_sql.y"
+         {
+		  // 预编译语句的参数，按出现的顺序编号
+		  value_init_parameter(&CONTEXT->values[CONTEXT->value_length++], CONTEXT->param_num++);
+	}
+#line 2088 "yacc_sql.tab.c"
+    break;
+
+  case 90: /* delete: DELETE FROM ID where SEMICOLON  */
+#line 564 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag = SCF_DELETE;//"delete";
 			deletes_init_relation(&CONTEXT->ssql->sstr.deletion, (yyvsp[-2].string));
 			// deletes_set_conditions(&CONTEXT->ssql->sstr.deletion, 
@@ -1982,12 +2101,12 @@ yyreduce:
 			CONTEXT->condition_list_stack_top--;
 			CONTEXT->condition_length = 0;	
     }
-#line 1986 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2105 "yacc_sql.tab.c"
     break;
 
-  case 67:
-#line 446 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 91: /* update: UPDATE ID SET ID EQ value where SEMICOLON  */
+#line 579 "yacc_sql.y"
+                {
 			CONTEXT->ssql->flag = SCF_UPDATE;//"update";
 			Value *value = &CONTEXT->values[0];
 			// updates_init(&CONTEXT->ssql->sstr.update, $2, $4, value, 
@@ -2001,12 +2120,12 @@ yyreduce:
 			CONTEXT->condition_list_stack_top--;
 			CONTEXT->condition_length = 0;
 		}
-#line 2005 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2124 "yacc_sql.tab.c"
     break;
 
-  case 68:
-#line 463 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 92: /* select: SELECT select_attr FROM ID rel_list where order_by group_by limit SEMICOLON  */
+#line 596 "yacc_sql.y"
+                {
 			printf("do select\n");
 			// CONTEXT->ssql->sstr.selection.relations[CONTEXT->from_length++]=$4;
 			// selects_append_attributes(&CONTEXT->ssql->sstr.selection, CONTEXT->attr_list, CONTEXT->attr_list_length);
@@ -2017,7 +2136,7 @@ yyreduce:
 			selects_append_attributes(&CONTEXT->ssql->sstr.selection, CONTEXT->attr_list_stack[stack_top], CONTEXT->attr_list_length_stack[stack_top]);
 			CONTEXT->attr_list_stack_top--;
 			
-			selects_append_relation(&CONTEXT->ssql->sstr.selection, (yyvsp[-5].string));
+			selects_append_relation(&CONTEXT->ssql->sstr.selection, (yyvsp[-6].string));
 			stack_top = CONTEXT->condition_list_stack_top;
 			printf("select:stack_top:%d\n", stack_top);
 			selects_append_conditions(&CONTEXT->ssql->sstr.selection, CONTEXT->condition_list_stack[stack_top], CONTEXT->condition_list_length_stack[stack_top]);
@@ -2050,12 +2169,12 @@ yyreduce:
 			CONTEXT->comp_length=0;
 			printf("do select end\n");
 	}
-#line 2054 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2173 "yacc_sql.tab.c"
     break;
 
-  case 69:
-#line 508 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 93: /* select: SELECT select_attr FROM ID join_list where SEMICOLON  */
+#line 641 "yacc_sql.y"
+        {
 		printf("do select end\n");
 		int stack_top = CONTEXT->attr_list_stack_top;
 			selects_append_attributes(&CONTEXT->ssql->sstr.selection, CONTEXT->attr_list_stack[stack_top], CONTEXT->attr_list_length_stack[stack_top]);
@@ -2099,30 +2218,30 @@ yyreduce:
 			}
 			CONTEXT->comp_length=0;
 	}
-#line 2103 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2222 "yacc_sql.tab.c"
     break;
 
-  case 70:
-#line 555 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 94: /* join_list: INNER JOIN ID ON condition condition_list  */
+#line 688 "yacc_sql.y"
+                                                  {
 		// CONTEXT->condition_list_stack_top--;
 		selects_append_relation(&CONTEXT->ssql->sstr.selection, (yyvsp[-3].string));
 	}
-#line 2112 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2231 "yacc_sql.tab.c"
     break;
 
-  case 71:
-#line 559 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 95: /* join_list: INNER JOIN ID ON condition condition_list join_list  */
+#line 692 "yacc_sql.y"
+                                                              {
 		// CONTEXT->condition_list_stack_top--;
 		selects_append_relation(&CONTEXT->ssql->sstr.selection, (yyvsp[-4].string));
 	}
-#line 2121 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2240 "yacc_sql.tab.c"
     break;
 
-  case 72:
-#line 565 "yacc_sql.y" /* yacc.c:1646  */
-    {  
+  case 96: /* select_attr: STAR  */
+#line 698 "yacc_sql.y"
+         {  
 		printf("select *\n");
 			RelAttr attr;
 			relation_attr_init(&attr, NULL, "*");
@@ -2135,12 +2254,12 @@ yyreduce:
 			
 		// printf("select * end\n");
 		}
-#line 2139 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2258 "yacc_sql.tab.c"
     break;
 
-  case 73:
-#line 578 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 97: /* select_attr: ID attr_list  */
+#line 711 "yacc_sql.y"
+                  {
 			RelAttr attr;
 			relation_attr_init(&attr, NULL, (yyvsp[-1].string));
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2148,12 +2267,12 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 		}
-#line 2152 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2271 "yacc_sql.tab.c"
     break;
 
-  case 74:
-#line 586 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 98: /* select_attr: ID DOT ID attr_list  */
+#line 719 "yacc_sql.y"
+                              {
 			RelAttr attr;
 			relation_attr_init(&attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2161,12 +2280,12 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 		}
-#line 2165 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2284 "yacc_sql.tab.c"
     break;
 
-  case 75:
-#line 594 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 99: /* select_attr: ID DOT STAR attr_list  */
+#line 727 "yacc_sql.y"
+                                {
 			RelAttr attr;
 			relation_attr_init(&attr, (yyvsp[-3].string), "*");
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2174,14 +2293,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 		}
-#line 2178 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2297 "yacc_sql.tab.c"
     break;
 
-  case 76:
-#line 602 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 100: /* select_attr: MAX LBRACE ID RBRACE attr_list  */
+#line 735 "yacc_sql.y"
+                                        {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2192,14 +2311,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2196 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2315 "yacc_sql.tab.c"
     break;
 
-  case 77:
-#line 615 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 101: /* select_attr: MAX LBRACE ID DOT ID RBRACE attr_list  */
+#line 748 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2210,14 +2329,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2214 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2333 "yacc_sql.tab.c"
     break;
 
-  case 78:
-#line 628 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 102: /* select_attr: MIN LBRACE ID RBRACE attr_list  */
+#line 761 "yacc_sql.y"
+                                        {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2228,14 +2347,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2232 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2351 "yacc_sql.tab.c"
     break;
 
-  case 79:
-#line 641 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 103: /* select_attr: MIN LBRACE ID DOT ID RBRACE attr_list  */
+#line 774 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2246,14 +2365,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2250 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2369 "yacc_sql.tab.c"
     break;
 
-  case 80:
-#line 654 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 104: /* select_attr: COUNT LBRACE ID RBRACE attr_list  */
+#line 787 "yacc_sql.y"
+                                          {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2264,14 +2383,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2268 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2387 "yacc_sql.tab.c"
     break;
 
-  case 81:
-#line 667 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 105: /* select_attr: COUNT LBRACE ID DOT ID RBRACE attr_list  */
+#line 800 "yacc_sql.y"
+                                                 {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2282,14 +2401,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2286 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2405 "yacc_sql.tab.c"
     break;
 
-  case 82:
-#line 680 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 106: /* select_attr: COUNT LBRACE STAR RBRACE  */
+#line 813 "yacc_sql.y"
+                                   {
 			RelAttr attr;
-			// char* s=malloc(sizeof(char)*(strlen($1)+4));
+			// char* s=parse_malloc(sizeof(char)*(strlen($1)+4));
 			// strcpy(s, $1);
 			// strcat(s, "(*)");
 			// strcat(s, $3);
@@ -2299,14 +2418,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2303 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2422 "yacc_sql.tab.c"
     break;
 
-  case 83:
-#line 692 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 107: /* select_attr: AVG LBRACE ID RBRACE attr_list  */
+#line 825 "yacc_sql.y"
+                                        {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "AVG(");
 			strcat(s, (yyvsp[-2].string));
 			strcat(s, ")");
@@ -2316,14 +2435,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2320 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2439 "yacc_sql.tab.c"
     break;
 
-  case 84:
-#line 704 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 108: /* select_attr: AVG LBRACE ID DOT ID RBRACE attr_list  */
+#line 837 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "AVG(");
 			strcat(s, (yyvsp[-2].string));
 			strcat(s, ")");
@@ -2333,20 +2452,61 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2337 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2456 "yacc_sql.tab.c"
     break;
 
-  case 85:
-#line 720 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 109: /* select_attr: ID LBRACE ID RBRACE attr_list  */
+#line 849 "yacc_sql.y"
+                                       {
+			// sum不是关键字，函数名按ID解析
+			if (strcasecmp((yyvsp[-4].string), "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			strcpy(s, "SUM(");
+			strcat(s, (yyvsp[-2].string));
+			strcat(s, ")");
+			relation_attr_init(&attr, NULL, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+#line 2477 "yacc_sql.tab.c"
+    break;
+
+  case 110: /* select_attr: ID LBRACE ID DOT ID RBRACE attr_list  */
+#line 865 "yacc_sql.y"
+                                              {
+			if (strcasecmp((yyvsp[-6].string), "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			strcpy(s, "SUM(");
+			strcat(s, (yyvsp[-2].string));
+			strcat(s, ")");
+			relation_attr_init(&attr, (yyvsp[-4].string), s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+#line 2497 "yacc_sql.tab.c"
+    break;
+
+  case 111: /* attr_list: %empty  */
+#line 884 "yacc_sql.y"
+                {
 		CONTEXT->attr_list_stack_top++;
 	}
-#line 2345 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2505 "yacc_sql.tab.c"
     break;
 
-  case 86:
-#line 723 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 112: /* attr_list: COMMA ID attr_list  */
+#line 887 "yacc_sql.y"
+                         {
 			RelAttr attr;
 			relation_attr_init(&attr, NULL, (yyvsp[-1].string));
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2356,12 +2516,12 @@ yyreduce:
      	  // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length].relation_name = NULL;
         // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length++].attribute_name=$2;
       }
-#line 2360 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2520 "yacc_sql.tab.c"
     break;
 
-  case 87:
-#line 733 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 113: /* attr_list: COMMA ID DOT ID attr_list  */
+#line 897 "yacc_sql.y"
+                                {
 			RelAttr attr;
 			relation_attr_init(&attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2371,12 +2531,12 @@ yyreduce:
         // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length].attribute_name=$4;
         // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length++].relation_name=$2;
   	  }
-#line 2375 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2535 "yacc_sql.tab.c"
     break;
 
-  case 88:
-#line 743 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 114: /* attr_list: COMMA ID DOT STAR attr_list  */
+#line 907 "yacc_sql.y"
+                                      {
 			RelAttr attr;
 			relation_attr_init(&attr, (yyvsp[-3].string), "*");
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2386,14 +2546,14 @@ yyreduce:
         // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length].attribute_name=$4;
         // CONTEXT->ssql->sstr.selection.attributes[CONTEXT->select_length++].relation_name=$2;
   	  }
-#line 2390 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2550 "yacc_sql.tab.c"
     break;
 
-  case 89:
-#line 753 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 115: /* attr_list: COMMA MAX LBRACE ID RBRACE attr_list  */
+#line 917 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2404,14 +2564,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2408 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2568 "yacc_sql.tab.c"
     break;
 
-  case 90:
-#line 766 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 116: /* attr_list: COMMA MAX LBRACE ID DOT ID RBRACE attr_list  */
+#line 930 "yacc_sql.y"
+                                                      {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2422,14 +2582,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2426 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2586 "yacc_sql.tab.c"
     break;
 
-  case 91:
-#line 779 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 117: /* attr_list: COMMA MIN LBRACE ID RBRACE attr_list  */
+#line 943 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2440,14 +2600,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2444 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2604 "yacc_sql.tab.c"
     break;
 
-  case 92:
-#line 792 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 118: /* attr_list: COMMA MIN LBRACE ID DOT ID RBRACE attr_list  */
+#line 956 "yacc_sql.y"
+                                                      {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2458,14 +2618,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2462 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2622 "yacc_sql.tab.c"
     break;
 
-  case 93:
-#line 805 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 119: /* attr_list: COMMA COUNT LBRACE ID RBRACE attr_list  */
+#line 969 "yacc_sql.y"
+                                                 {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2476,12 +2636,12 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2480 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2640 "yacc_sql.tab.c"
     break;
 
-  case 94:
-#line 818 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 120: /* attr_list: COMMA COUNT LBRACE STAR RBRACE attr_list  */
+#line 982 "yacc_sql.y"
+                                                   {
 			RelAttr attr;
 			relation_attr_init(&attr, NULL, "COUNT(*)");
 			// selects_append_attribute(&CONTEXT->ssql->sstr.selection, &attr);
@@ -2489,14 +2649,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2493 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2653 "yacc_sql.tab.c"
     break;
 
-  case 95:
-#line 826 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 121: /* attr_list: COMMA AVG LBRACE ID RBRACE attr_list  */
+#line 990 "yacc_sql.y"
+                                               {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "AVG(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2507,14 +2667,14 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2511 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2671 "yacc_sql.tab.c"
     break;
 
-  case 96:
-#line 839 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 122: /* attr_list: COMMA AVG LBRACE ID DOT ID RBRACE attr_list  */
+#line 1003 "yacc_sql.y"
+                                                      {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
 			strcpy(s, "AVG(");
 			// strcat(s, "(");
 			strcat(s, (yyvsp[-2].string));
@@ -2525,37 +2685,77 @@ yyreduce:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
-#line 2529 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2689 "yacc_sql.tab.c"
+    break;
+
+  case 123: /* attr_list: COMMA ID LBRACE ID RBRACE attr_list  */
+#line 1016 "yacc_sql.y"
+                                              {
+			if (strcasecmp((yyvsp[-4].string), "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			strcpy(s, "SUM(");
+			strcat(s, (yyvsp[-2].string));
+			strcat(s, ")");
+			relation_attr_init(&attr, NULL, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+#line 2709 "yacc_sql.tab.c"
     break;
 
-  case 98:
-#line 855 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 124: /* attr_list: COMMA ID LBRACE ID DOT ID RBRACE attr_list  */
+#line 1031 "yacc_sql.y"
+                                                     {
+			if (strcasecmp((yyvsp[-6].string), "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen((yyvsp[-2].string))+3));
+			strcpy(s, "SUM(");
+			strcat(s, (yyvsp[-2].string));
+			strcat(s, ")");
+			relation_attr_init(&attr, (yyvsp[-4].string), s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+#line 2729 "yacc_sql.tab.c"
+    break;
+
+  case 126: /* rel_list: COMMA ID rel_list  */
+#line 1049 "yacc_sql.y"
+                        {	
 				selects_append_relation(&CONTEXT->ssql->sstr.selection, (yyvsp[-1].string));
 		  }
-#line 2537 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2737 "yacc_sql.tab.c"
     break;
 
-  case 99:
-#line 860 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 127: /* where: %empty  */
+#line 1054 "yacc_sql.y"
+                {
 		CONTEXT->condition_list_stack_top++;
 		printf("condition_list: condition_list_stack_top++: %d\n", CONTEXT->condition_list_stack_top);
 	}
-#line 2546 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2746 "yacc_sql.tab.c"
     break;
 
-  case 100:
-#line 864 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 128: /* where: WHERE condition condition_list  */
+#line 1058 "yacc_sql.y"
+                                     {	
 				// CONTEXT->conditions[CONTEXT->condition_length++]=*$2;
 			}
-#line 2554 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2754 "yacc_sql.tab.c"
     break;
 
-  case 102:
-#line 871 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 130: /* order_by: ORDER BY ID order_by_list  */
+#line 1065 "yacc_sql.y"
+                                {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-1].string));
 			Condition condition;
@@ -2568,12 +2768,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2572 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2772 "yacc_sql.tab.c"
     break;
 
-  case 103:
-#line 884 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 131: /* order_by: ORDER BY ID ASC order_by_list  */
+#line 1078 "yacc_sql.y"
+                                        {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			Condition condition;
@@ -2583,12 +2783,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2587 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2787 "yacc_sql.tab.c"
     break;
 
-  case 104:
-#line 894 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 132: /* order_by: ORDER BY ID DESC order_by_list  */
+#line 1088 "yacc_sql.y"
+                                         {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			Condition condition;
@@ -2598,12 +2798,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2602 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2802 "yacc_sql.tab.c"
     break;
 
-  case 105:
-#line 904 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 133: /* order_by: ORDER BY ID DOT ID order_by_list  */
+#line 1098 "yacc_sql.y"
+                                           {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			Condition condition;
@@ -2613,12 +2813,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 			}
-#line 2617 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2817 "yacc_sql.tab.c"
     break;
 
-  case 106:
-#line 914 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 134: /* order_by: ORDER BY ID DOT ID ASC order_by_list  */
+#line 1108 "yacc_sql.y"
+                                               {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			Condition condition;
@@ -2628,12 +2828,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 			}
-#line 2632 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2832 "yacc_sql.tab.c"
     break;
 
-  case 107:
-#line 924 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 135: /* order_by: ORDER BY ID DOT ID DESC order_by_list  */
+#line 1118 "yacc_sql.y"
+                                                {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			Condition condition;
@@ -2643,21 +2843,21 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 			}
-#line 2647 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2847 "yacc_sql.tab.c"
     break;
 
-  case 108:
-#line 937 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 136: /* order_by_list: %empty  */
+#line 1131 "yacc_sql.y"
+                    {
 		// CONTEXT->condition_list_stack_top++;
 		// printf("condition_list: condition_list_stack_top++: %d\n", CONTEXT->condition_list_stack_top);
 	}
-#line 2656 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2856 "yacc_sql.tab.c"
     break;
 
-  case 109:
-#line 941 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 137: /* order_by_list: COMMA ID order_by_list  */
+#line 1135 "yacc_sql.y"
+                           {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-1].string));
 			Condition condition;
@@ -2667,12 +2867,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2671 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2871 "yacc_sql.tab.c"
     break;
 
-  case 110:
-#line 951 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 138: /* order_by_list: COMMA ID ASC order_by_list  */
+#line 1145 "yacc_sql.y"
+                                   {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			Condition condition;
@@ -2682,12 +2882,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2686 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2886 "yacc_sql.tab.c"
     break;
 
-  case 111:
-#line 961 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 139: /* order_by_list: COMMA ID DESC order_by_list  */
+#line 1155 "yacc_sql.y"
+                                    {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			Condition condition;
@@ -2697,12 +2897,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2701 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2901 "yacc_sql.tab.c"
     break;
 
-  case 112:
-#line 971 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 140: /* order_by_list: COMMA ID DOT ID order_by_list  */
+#line 1165 "yacc_sql.y"
+                                      {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			Condition condition;
@@ -2712,12 +2912,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2716 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2916 "yacc_sql.tab.c"
     break;
 
-  case 113:
-#line 981 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 141: /* order_by_list: COMMA ID DOT ID ASC order_by_list  */
+#line 1175 "yacc_sql.y"
+                                          {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			Condition condition;
@@ -2727,12 +2927,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2731 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2931 "yacc_sql.tab.c"
     break;
 
-  case 114:
-#line 991 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 142: /* order_by_list: COMMA ID DOT ID DESC order_by_list  */
+#line 1185 "yacc_sql.y"
+                                           {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			Condition condition;
@@ -2742,12 +2942,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2746 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2946 "yacc_sql.tab.c"
     break;
 
-  case 116:
-#line 1005 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 144: /* group_by: GROUP BY ID group_by_list  */
+#line 1199 "yacc_sql.y"
+                                {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-1].string));
 			Condition condition;
@@ -2757,12 +2957,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2761 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2961 "yacc_sql.tab.c"
     break;
 
-  case 117:
-#line 1015 "yacc_sql.y" /* yacc.c:1646  */
-    {	
+  case 145: /* group_by: GROUP BY ID DOT ID group_by_list  */
+#line 1209 "yacc_sql.y"
+                                           {	
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			Condition condition;
@@ -2772,21 +2972,60 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 			}
-#line 2776 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 2976 "yacc_sql.tab.c"
     break;
 
-  case 118:
-#line 1028 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 147: /* limit: ID NUMBER  */
+#line 1223 "yacc_sql.y"
+                    {
+			// limit不是关键字，按ID解析: limit n
+			if (strcasecmp((yyvsp[-1].string), "limit") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, (yyvsp[0].number), 0);
+	}
+#line 2989 "yacc_sql.tab.c"
+    break;
+
+  case 148: /* limit: ID NUMBER ID NUMBER  */
+#line 1231 "yacc_sql.y"
+                              {
+			// limit n offset m
+			if (strcasecmp((yyvsp[-3].string), "limit") != 0 || strcasecmp((yyvsp[-1].string), "offset") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, (yyvsp[-2].number), (yyvsp[0].number));
+	}
+#line 3002 "yacc_sql.tab.c"
+    break;
+
+  case 149: /* limit: ID NUMBER COMMA NUMBER  */
+#line 1239 "yacc_sql.y"
+                                 {
+			// limit m, n: 跳过m行后输出n行
+			if (strcasecmp((yyvsp[-3].string), "limit") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, (yyvsp[0].number), (yyvsp[-2].number));
+	}
+#line 3015 "yacc_sql.tab.c"
+    break;
+
+  case 150: /* group_by_list: %empty  */
+#line 1250 "yacc_sql.y"
+                    {
 		// CONTEXT->condition_list_stack_top++;
 		// printf("condition_list: condition_list_stack_top++: %d\n", CONTEXT->condition_list_stack_top);
 	}
-#line 2785 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3024 "yacc_sql.tab.c"
     break;
 
-  case 119:
-#line 1032 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 151: /* group_by_list: COMMA ID group_by_list  */
+#line 1254 "yacc_sql.y"
+                           {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-1].string));
 			Condition condition;
@@ -2796,12 +3035,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2800 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3039 "yacc_sql.tab.c"
     break;
 
-  case 120:
-#line 1042 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 152: /* group_by_list: COMMA ID DOT ID group_by_list  */
+#line 1264 "yacc_sql.y"
+                                      {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-3].string), (yyvsp[-1].string));
 			Condition condition;
@@ -2811,29 +3050,29 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 2815 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3054 "yacc_sql.tab.c"
     break;
 
-  case 121:
-#line 1056 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 153: /* condition_list: %empty  */
+#line 1278 "yacc_sql.y"
+                {
 		// CONTEXT->condition_list_stack_top++;
 		// printf("condition_list: condition_list_stack_top++: %d\n", CONTEXT->condition_list_stack_top);
 	}
-#line 2824 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3063 "yacc_sql.tab.c"
     break;
 
-  case 122:
-#line 1060 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 154: /* condition_list: AND condition condition_list  */
+#line 1282 "yacc_sql.y"
+                                   {
 				// CONTEXT->conditions[CONTEXT->condition_length++]=*$2;
 			}
-#line 2832 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3071 "yacc_sql.tab.c"
     break;
 
-  case 123:
-#line 1067 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 155: /* condition: ID comOp value  */
+#line 1289 "yacc_sql.y"
+                {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 
@@ -2856,12 +3095,12 @@ yyreduce:
 			// $$->right_value = *$3;
 
 		}
-#line 2860 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3099 "yacc_sql.tab.c"
     break;
 
-  case 124:
-#line 1091 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 156: /* condition: value comOp value  */
+#line 1313 "yacc_sql.y"
+                {
 			Value *left_value = &CONTEXT->values[CONTEXT->value_length - 2];
 			Value *right_value = &CONTEXT->values[CONTEXT->value_length - 1];
 
@@ -2883,12 +3122,12 @@ yyreduce:
 			// $$->right_value = *$3;
 
 		}
-#line 2887 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3126 "yacc_sql.tab.c"
     break;
 
-  case 125:
-#line 1114 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 157: /* condition: ID comOp ID  */
+#line 1336 "yacc_sql.y"
+                {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			RelAttr right_attr;
@@ -2910,12 +3149,12 @@ yyreduce:
 			// $$->right_attr.attribute_name=$3;
 
 		}
-#line 2914 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3153 "yacc_sql.tab.c"
     break;
 
-  case 126:
-#line 1137 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 158: /* condition: value comOp ID  */
+#line 1359 "yacc_sql.y"
+                {
 			Value *left_value = &CONTEXT->values[CONTEXT->value_length - 1];
 			RelAttr right_attr;
 			relation_attr_init(&right_attr, NULL, (yyvsp[0].string));
@@ -2939,12 +3178,12 @@ yyreduce:
 			// $$->right_attr.attribute_name=$3;
 		
 		}
-#line 2943 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3182 "yacc_sql.tab.c"
     break;
 
-  case 127:
-#line 1162 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 159: /* condition: ID DOT ID comOp value  */
+#line 1384 "yacc_sql.y"
+                {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			Value *right_value = &CONTEXT->values[CONTEXT->value_length - 1];
@@ -2967,12 +3206,12 @@ yyreduce:
 			// $$->right_value =*$5;			
 							
     }
-#line 2971 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3210 "yacc_sql.tab.c"
     break;
 
-  case 128:
-#line 1186 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 160: /* condition: value comOp ID DOT ID  */
+#line 1408 "yacc_sql.y"
+                {
 			Value *left_value = &CONTEXT->values[CONTEXT->value_length - 1];
 
 			RelAttr right_attr;
@@ -2995,12 +3234,12 @@ yyreduce:
 			// $$->right_attr.attribute_name = $5;
 									
     }
-#line 2999 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3238 "yacc_sql.tab.c"
     break;
 
-  case 129:
-#line 1210 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 161: /* condition: ID DOT ID comOp ID DOT ID  */
+#line 1432 "yacc_sql.y"
+                {
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-6].string), (yyvsp[-4].string));
 			RelAttr right_attr;
@@ -3021,12 +3260,12 @@ yyreduce:
 			// $$->right_attr.relation_name=$5;
 			// $$->right_attr.attribute_name=$7;
     }
-#line 3025 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3264 "yacc_sql.tab.c"
     break;
 
-  case 130:
-#line 1231 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 162: /* condition: ID IS_T NULL_T  */
+#line 1453 "yacc_sql.y"
+                     {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
@@ -3038,12 +3277,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 3042 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3281 "yacc_sql.tab.c"
     break;
 
-  case 131:
-#line 1243 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 163: /* condition: ID IS_T NOT NULL_T  */
+#line 1465 "yacc_sql.y"
+                             {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-3].string));
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
@@ -3055,12 +3294,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 3059 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3298 "yacc_sql.tab.c"
     break;
 
-  case 132:
-#line 1255 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 164: /* condition: ID DOT ID IS_T NULL_T  */
+#line 1477 "yacc_sql.y"
+                                {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
@@ -3072,12 +3311,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 3076 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3315 "yacc_sql.tab.c"
     break;
 
-  case 133:
-#line 1267 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 165: /* condition: ID DOT ID IS_T NOT NULL_T  */
+#line 1489 "yacc_sql.y"
+                                   {
 		RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-5].string), (yyvsp[-3].string));
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
@@ -3089,12 +3328,12 @@ yyreduce:
 									CONTEXT->condition_list_length_stack[CONTEXT->condition_list_stack_top]++,
 									&condition);
 	}
-#line 3093 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3332 "yacc_sql.tab.c"
     break;
 
-  case 134:
-#line 1280 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 166: /* condition: value IS_T NULL_T  */
+#line 1502 "yacc_sql.y"
+                {
 			Value *left_value = &CONTEXT->values[CONTEXT->value_length - 1];
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
 			Value *right_value = &CONTEXT->values[CONTEXT->value_length - 1];
@@ -3106,12 +3345,12 @@ yyreduce:
 									&condition);
 		
 		}
-#line 3110 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3349 "yacc_sql.tab.c"
     break;
 
-  case 135:
-#line 1293 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 167: /* condition: value IS_T NOT NULL_T  */
+#line 1515 "yacc_sql.y"
+                {
 			Value *left_value = &CONTEXT->values[CONTEXT->value_length - 1];
 			value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
 			Value *right_value = &CONTEXT->values[CONTEXT->value_length - 1];
@@ -3123,12 +3362,12 @@ yyreduce:
 									&condition);
 		
 		}
-#line 3127 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3366 "yacc_sql.tab.c"
     break;
 
-  case 136:
-#line 1306 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 168: /* condition: ID comOp subselect  */
+#line 1528 "yacc_sql.y"
+                {
 			// printf("where sub\n");
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[-2].string));
@@ -3144,12 +3383,12 @@ yyreduce:
 			// printf("where sub end\n");
 
 		}
-#line 3148 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3387 "yacc_sql.tab.c"
     break;
 
-  case 137:
-#line 1323 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 169: /* condition: ID DOT ID comOp subselect  */
+#line 1545 "yacc_sql.y"
+                {
 			// printf("where sub\n");
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-4].string), (yyvsp[-2].string));
@@ -3164,12 +3403,12 @@ yyreduce:
 									&condition);
 
 		}
-#line 3168 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3407 "yacc_sql.tab.c"
     break;
 
-  case 138:
-#line 1339 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 170: /* condition: subselect comOp ID  */
+#line 1561 "yacc_sql.y"
+                {
 			printf("where sub\n");
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, NULL, (yyvsp[0].string));
@@ -3196,12 +3435,12 @@ yyreduce:
 			// printf("where sub end\n");
 
 		}
-#line 3200 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3439 "yacc_sql.tab.c"
     break;
 
-  case 139:
-#line 1367 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 171: /* condition: subselect comOp ID DOT ID  */
+#line 1589 "yacc_sql.y"
+                {
 			// printf("where sub\n");
 			RelAttr left_attr;
 			relation_attr_init(&left_attr, (yyvsp[-2].string), (yyvsp[0].string));
@@ -3226,12 +3465,12 @@ yyreduce:
 									&condition);
 
 		}
-#line 3230 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3469 "yacc_sql.tab.c"
     break;
 
-  case 140:
-#line 1393 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 172: /* condition: subselect comOp subselect  */
+#line 1615 "yacc_sql.y"
+                {
 			// printf("where sub\n");
 			// RelAttr left_attr;
 			// relation_attr_init(&left_attr, $3, $5);
@@ -3255,60 +3494,60 @@ yyreduce:
 									&condition);
 
 		}
-#line 3259 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3498 "yacc_sql.tab.c"
     break;
 
-  case 141:
-#line 1420 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = EQUAL_TO; }
-#line 3265 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 173: /* comOp: EQ  */
+#line 1642 "yacc_sql.y"
+             { CONTEXT->comp[CONTEXT->comp_length++] = EQUAL_TO; }
+#line 3504 "yacc_sql.tab.c"
     break;
 
-  case 142:
-#line 1421 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = LESS_THAN; }
-#line 3271 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 174: /* comOp: LT  */
+#line 1643 "yacc_sql.y"
+         { CONTEXT->comp[CONTEXT->comp_length++] = LESS_THAN; }
+#line 3510 "yacc_sql.tab.c"
     break;
 
-  case 143:
-#line 1422 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = GREAT_THAN; }
-#line 3277 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 175: /* comOp: GT  */
+#line 1644 "yacc_sql.y"
+         { CONTEXT->comp[CONTEXT->comp_length++] = GREAT_THAN; }
+#line 3516 "yacc_sql.tab.c"
     break;
 
-  case 144:
-#line 1423 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = LESS_EQUAL; }
-#line 3283 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 176: /* comOp: LE  */
+#line 1645 "yacc_sql.y"
+         { CONTEXT->comp[CONTEXT->comp_length++] = LESS_EQUAL; }
+#line 3522 "yacc_sql.tab.c"
     break;
 
-  case 145:
-#line 1424 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = GREAT_EQUAL; }
-#line 3289 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 177: /* comOp: GE  */
+#line 1646 "yacc_sql.y"
+         { CONTEXT->comp[CONTEXT->comp_length++] = GREAT_EQUAL; }
+#line 3528 "yacc_sql.tab.c"
     break;
 
-  case 146:
-#line 1425 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = NOT_EQUAL; }
-#line 3295 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 178: /* comOp: NE  */
+#line 1647 "yacc_sql.y"
+         { CONTEXT->comp[CONTEXT->comp_length++] = NOT_EQUAL; }
+#line 3534 "yacc_sql.tab.c"
     break;
 
-  case 147:
-#line 1426 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = IN; }
-#line 3301 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 179: /* comOp: IN_T  */
+#line 1648 "yacc_sql.y"
+               { CONTEXT->comp[CONTEXT->comp_length++] = IN; }
+#line 3540 "yacc_sql.tab.c"
     break;
 
-  case 148:
-#line 1427 "yacc_sql.y" /* yacc.c:1646  */
-    { CONTEXT->comp[CONTEXT->comp_length++] = NOT_IN; }
-#line 3307 "yacc_sql.tab.c" /* yacc.c:1646  */
+  case 180: /* comOp: NOT IN_T  */
+#line 1649 "yacc_sql.y"
+                   { CONTEXT->comp[CONTEXT->comp_length++] = NOT_IN; }
+#line 3546 "yacc_sql.tab.c"
     break;
 
-  case 149:
-#line 1431 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 181: /* subselect: LBRACE SELECT select_attr FROM ID rel_list where RBRACE  */
+#line 1653 "yacc_sql.y"
+                                                                {
 		printf("sub select\n");
 		// selects_init_(&(CONTEXT->sub_selects[CONTEXT->sub_select_num]));
 		// selects_move__(&(CONTEXT->sub_selects[CONTEXT->sub_select_num]), &CONTEXT->ssql->sstr.selection);
@@ -3328,20 +3567,21 @@ yyreduce:
 		CONTEXT->sub_select_num++;
 		// printf("subselect end\n");
 	}
-#line 3332 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3571 "yacc_sql.tab.c"
     break;
 
-  case 150:
-#line 1455 "yacc_sql.y" /* yacc.c:1646  */
-    {
+  case 182: /* load_data: LOAD DATA INFILE SSS INTO TABLE ID SEMICOLON  */
+#line 1677 "yacc_sql.y"
+                {
 		  CONTEXT->ssql->flag = SCF_LOAD_DATA;
 			load_data_init(&CONTEXT->ssql->sstr.load_data, (yyvsp[-1].string), (yyvsp[-4].string));
 		}
-#line 3341 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3580 "yacc_sql.tab.c"
     break;
 
 
-#line 3345 "yacc_sql.tab.c" /* yacc.c:1646  */
+#line 3584 "yacc_sql.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -3355,25 +3595,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3384,50 +3622,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (scanner, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (scanner, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -3456,12 +3658,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -3478,13 +3679,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3498,7 +3700,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, scanner);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3510,7 +3712,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3521,26 +3723,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -3556,20 +3762,18 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, scanner);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 1460 "yacc_sql.y" /* yacc.c:1906  */
+
+#line 1682 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
@@ -9,6 +9,7 @@
 #include<stdio.h>
 #include<stdlib.h>
 #include<string.h>
+#include<strings.h>
 
 typedef struct ParserContext {
   Query * ssql;
@@ -34,6 +35,8 @@ typedef struct ParserContext {
   size_t condition_list_length_stack[MAX_NUM];
   size_t condition_list_stack_top;
  size_t comp_length;
+  int nullable;       // 最近一次归约的type是否可为null
+  int param_num;      // 已经出现的参数?个数
 
 //   Selects *cur_select;
 } ParserContext;
@@ -41,7 +44,7 @@ typedef struct ParserContext {
 //获取子串
 char *substr(const char *s,int n1,int n2)/*从s中提取下标为n1~n2的字符组成一个新字符串，然后返回这个新串的首地址*/
 {
-  char *sp = malloc(sizeof(char) * (n2 - n1 + 2));
+  char *sp = parse_malloc(sizeof(char) * (n2 - n1 + 2));
   int i, j = 0;
   for (i = n1; i <= n2; i++) {
     sp[j++] = s[i];
@@ -188,6 +191,11 @@ commands:		//commands or sqls. parser starts here.
 
 command:
 	  select  
+	| explain
+	| prepare
+	| execute
+	| deallocate
+	| set_variable
 	| insert
 	| update
 	| delete
@@ -195,6 +203,7 @@ command:
 	| drop_table
 	| show_tables
 	| desc_table
+	| analyze_table
 	| create_index	
 	| drop_index
 	| sync
@@ -259,6 +268,103 @@ desc_table:
     }
     ;
 
+explain:
+    ID select {
+      // explain不是关键字，按ID解析
+      if (strcasecmp($1, "explain") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->explain = EXPLAIN_PLAN;
+    }
+    | ID ID select {
+      if (strcasecmp($1, "explain") != 0 || strcasecmp($2, "analyze") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->explain = EXPLAIN_ANALYZE;
+    }
+    ;
+
+prepare:
+    ID ID FROM prepared_statement {
+      // prepare不是关键字，按ID解析。语句本身照常解析，只记下语句的名字
+      if (strcasecmp($1, "prepare") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      query_set_prepare_name(CONTEXT->ssql, $2);
+    }
+    ;
+
+prepared_statement:
+    select
+    | insert
+    | update
+    | delete
+    ;
+
+execute:
+    ID ID SEMICOLON {
+      if (strcasecmp($1, "execute") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_EXECUTE;
+      execute_prepared_init(&CONTEXT->ssql->sstr.execution, $2, NULL, 0);
+    }
+    | ID ID ID value value_list SEMICOLON {
+      if (strcasecmp($1, "execute") != 0 || strcasecmp($3, "using") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_EXECUTE;
+      execute_prepared_init(&CONTEXT->ssql->sstr.execution, $2, CONTEXT->values, CONTEXT->value_length);
+      CONTEXT->value_length = 0;
+    }
+    ;
+
+deallocate:
+    ID ID ID SEMICOLON {
+      if (strcasecmp($1, "deallocate") != 0 || strcasecmp($2, "prepare") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_DEALLOCATE;
+      deallocate_prepared_init(&CONTEXT->ssql->sstr.deallocation, $3);
+    }
+    ;
+
+set_variable:
+    SET ID EQ ID SEMICOLON {
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, $2, $4);
+    }
+    | SET ID EQ ON SEMICOLON {
+      // on是关键字
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, $2, "on");
+    }
+    | SET ID EQ NUMBER SEMICOLON {
+      char value[16];
+      snprintf(value, sizeof(value), "%d", $4);
+      CONTEXT->ssql->flag = SCF_SET_VARIABLE;
+      set_variable_init(&CONTEXT->ssql->sstr.set_variable, $2, value);
+    }
+    ;
+
+analyze_table:
+    ID TABLE ID SEMICOLON {
+      // analyze不是关键字，按ID解析
+      if (strcasecmp($1, "analyze") != 0) {
+        yyerror(scanner, "syntax error");
+        YYABORT;
+      }
+      CONTEXT->ssql->flag = SCF_ANALYZE_TABLE;
+      analyze_table_init(&CONTEXT->ssql->sstr.analyze_table, $3);
+    }
+    ;
+
 create_index:		/*create index 语句的语法解析树*/
 	CREATE INDEX ID ON ID LBRACE id_def id_def_list RBRACE SEMICOLON  
 		{
@@ -291,7 +397,24 @@ drop_index:			/*drop index 语句的语法解析树*/
 		}
     ;
 create_table:		/*create table 语句的语法解析树*/
-    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE SEMICOLON 
+    create_table_body SEMICOLON
+		{
+		}
+    | create_table_body ID SEMICOLON
+		{
+			// 指定存储格式: create table t(...) pax
+			if (strcasecmp($2, "pax") == 0) {
+				CONTEXT->ssql->sstr.create_table.storage_format = PAX_FORMAT;
+			} else if (strcasecmp($2, "row") == 0) {
+				CONTEXT->ssql->sstr.create_table.storage_format = ROW_FORMAT;
+			} else {
+				yyerror(scanner, "unsupported storage format");
+				YYABORT;
+			}
+		}
+    ;
+create_table_body:
+    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE
 		{
 			CONTEXT->ssql->flag=SCF_CREATE_TABLE;//"create_table";
 			// CONTEXT->ssql->sstr.create_table.attribute_count = CONTEXT->value_length;
@@ -310,34 +433,40 @@ attr_def:
 		{
 			AttrInfo attribute;
 			attr_info_init(&attribute, CONTEXT->id, $2, $4);
+			attribute.nullable = CONTEXT->nullable;
 			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
 			CONTEXT->value_length++;
-			if ($2 == INTS_NULLABLE || $2 == FLOATS_NULLABLE || $2 == CHARS_NULLABLE || $2 == DATES_NULLABLE) {
-				attr_info_init(&attribute, "NULL", IF_NULL, 4);
-				create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
-				CONTEXT->value_length++;
-			}
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name =(char*)malloc(sizeof(char));
 			// strcpy(CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name, CONTEXT->id); 
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].type = $2;  
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].length = $4;
 			
 		}
+    |ID_get type LBRACE number RBRACE ID
+		{
+			// 字典编码的字符串字段: name char(n) dict
+			if ($2 != CHARS || strcasecmp($6, "dict") != 0) {
+				yyerror(scanner, "unsupported column option");
+				YYABORT;
+			}
+			AttrInfo attribute;
+			attr_info_init(&attribute, CONTEXT->id, $2, $4);
+			attribute.nullable = CONTEXT->nullable;
+			attribute.dict = true;
+			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
+			CONTEXT->value_length++;
+		}
     |ID_get type
 		{
 			AttrInfo attribute;
 			attr_info_init(&attribute, CONTEXT->id, $2, 4);
+			attribute.nullable = CONTEXT->nullable;
 			create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name=(char*)malloc(sizeof(char));
 			// strcpy(CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].name, CONTEXT->id); 
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].type=$2;  
 			// CONTEXT->ssql->sstr.create_table.attributes[CONTEXT->value_length].length=4; // default attribute length
 			CONTEXT->value_length++;
-			if ($2 == INTS_NULLABLE || $2 == FLOATS_NULLABLE || $2 == CHARS_NULLABLE || $2 == DATES_NULLABLE) {
-				attr_info_init(&attribute, "NULL", IF_NULL, 4);
-				create_table_append_attribute(&CONTEXT->ssql->sstr.create_table, &attribute);
-				CONTEXT->value_length++;
-			}
 		}
 	|ID_get TEXT_T
 		{
@@ -351,18 +480,18 @@ number:
 		NUMBER {$$ = $1;}
 		;
 type:
-	INT_T { $$=INTS; }
-	| INT_T NOT NULL_T { $$=INTS; }
-	| INT_T NULLABLE { $$=INTS_NULLABLE; }
-    | STRING_T { $$=CHARS; }
-	| STRING_T NOT NULL_T { $$=CHARS; }
-	| STRING_T NULLABLE { $$=CHARS_NULLABLE; }
-    | FLOAT_T { $$=FLOATS; }
-	| FLOAT_T NOT NULL_T { $$=FLOATS; }
-	| FLOAT_T NULLABLE { $$=FLOATS_NULLABLE; }
-	| DATE_T { $$=DATES; }
-	| DATE_T NOT NULL_T { $$=DATES; }
-	| DATE_T NULLABLE { $$=DATES_NULLABLE; }
+	INT_T { $$=INTS; CONTEXT->nullable=0; }
+	| INT_T NOT NULL_T { $$=INTS; CONTEXT->nullable=0; }
+	| INT_T NULLABLE { $$=INTS; CONTEXT->nullable=1; }
+    | STRING_T { $$=CHARS; CONTEXT->nullable=0; }
+	| STRING_T NOT NULL_T { $$=CHARS; CONTEXT->nullable=0; }
+	| STRING_T NULLABLE { $$=CHARS; CONTEXT->nullable=1; }
+    | FLOAT_T { $$=FLOATS; CONTEXT->nullable=0; }
+	| FLOAT_T NOT NULL_T { $$=FLOATS; CONTEXT->nullable=0; }
+	| FLOAT_T NULLABLE { $$=FLOATS; CONTEXT->nullable=1; }
+	| DATE_T { $$=DATES; CONTEXT->nullable=0; }
+	| DATE_T NOT NULL_T { $$=DATES; CONTEXT->nullable=0; }
+	| DATE_T NULLABLE { $$=DATES; CONTEXT->nullable=1; }
     ;
 ID_get:
 	ID 
@@ -424,6 +553,10 @@ value:
 		// $1 = substr($1,1,strlen($1)-2);
   		// value_init_string(&CONTEXT->values[CONTEXT->value_length++], "null");
 		  value_init_null(&CONTEXT->values[CONTEXT->value_length++]);
+	}
+    |'?' {
+		  // 预编译语句的参数，按出现的顺序编号
+		  value_init_parameter(&CONTEXT->values[CONTEXT->value_length++], CONTEXT->param_num++);
 	};
     
 delete:		/*  delete 语句的语法解析树*/
@@ -459,7 +592,7 @@ update:			/*  update 语句的语法解析树*/
 		}
     ;
 select:				/*  select 语句的语法解析树*/
-    SELECT select_attr FROM ID rel_list where order_by group_by SEMICOLON
+    SELECT select_attr FROM ID rel_list where order_by group_by limit SEMICOLON
 		{
 			printf("do select\n");
 			// CONTEXT->ssql->sstr.selection.relations[CONTEXT->from_length++]=$4;
@@ -601,7 +734,7 @@ select_attr:
 		}
 	| MAX LBRACE ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($3)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($3)+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, $3);
@@ -614,7 +747,7 @@ select_attr:
 	}
 	| MAX LBRACE ID DOT ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($5)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($5)+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, $5);
@@ -627,7 +760,7 @@ select_attr:
 	}
 	| MIN LBRACE ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($3)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($3)+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, $3);
@@ -640,7 +773,7 @@ select_attr:
 	}
 	| MIN LBRACE ID DOT ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($5)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($5)+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, $5);
@@ -653,7 +786,7 @@ select_attr:
 	}
 	| COUNT LBRACE ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen($3)+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen($3)+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, $3);
@@ -666,7 +799,7 @@ select_attr:
 	}
 	| COUNT LBRACE ID DOT ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen($5)+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen($5)+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, $5);
@@ -679,7 +812,7 @@ select_attr:
 	}
 	| COUNT LBRACE STAR RBRACE {
 			RelAttr attr;
-			// char* s=malloc(sizeof(char)*(strlen($1)+4));
+			// char* s=parse_malloc(sizeof(char)*(strlen($1)+4));
 			// strcpy(s, $1);
 			// strcat(s, "(*)");
 			// strcat(s, $3);
@@ -691,7 +824,7 @@ select_attr:
 	}
 	| AVG LBRACE ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($3)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($3)+3));
 			strcpy(s, "AVG(");
 			strcat(s, $3);
 			strcat(s, ")");
@@ -703,7 +836,7 @@ select_attr:
 	}
 	| AVG LBRACE ID DOT ID RBRACE attr_list{
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($5)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($5)+3));
 			strcpy(s, "AVG(");
 			strcat(s, $5);
 			strcat(s, ")");
@@ -713,6 +846,37 @@ select_attr:
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
 	}
+	| ID LBRACE ID RBRACE attr_list{
+			// sum不是关键字，函数名按ID解析
+			if (strcasecmp($1, "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen($3)+3));
+			strcpy(s, "SUM(");
+			strcat(s, $3);
+			strcat(s, ")");
+			relation_attr_init(&attr, NULL, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+	| ID LBRACE ID DOT ID RBRACE attr_list{
+			if (strcasecmp($1, "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen($5)+3));
+			strcpy(s, "SUM(");
+			strcat(s, $5);
+			strcat(s, ")");
+			relation_attr_init(&attr, $3, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
     ; 
 
 
@@ -752,7 +916,7 @@ attr_list:
   	  }
 	| COMMA MAX LBRACE ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($4)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($4)+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, $4);
@@ -765,7 +929,7 @@ attr_list:
 	}
 	| COMMA MAX LBRACE ID DOT ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($6)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($6)+3));
 			strcpy(s, "MAX(");
 			// strcat(s, "(");
 			strcat(s, $6);
@@ -778,7 +942,7 @@ attr_list:
 	}
 	| COMMA MIN LBRACE ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($4)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($4)+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, $4);
@@ -791,7 +955,7 @@ attr_list:
 	}
 	| COMMA MIN LBRACE ID DOT ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($6)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($6)+3));
 			strcpy(s, "MIN(");
 			// strcat(s, "(");
 			strcat(s, $6);
@@ -804,7 +968,7 @@ attr_list:
 	}
 	| COMMA COUNT LBRACE ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(5+strlen($4)+3));
+			char* s=parse_malloc(sizeof(char)*(5+strlen($4)+3));
 			strcpy(s, "COUNT(");
 			// strcat(s, "(");
 			strcat(s, $4);
@@ -825,7 +989,7 @@ attr_list:
 	}
 	| COMMA AVG LBRACE ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($4)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($4)+3));
 			strcpy(s, "AVG(");
 			// strcat(s, "(");
 			strcat(s, $4);
@@ -838,7 +1002,7 @@ attr_list:
 	}
 	| COMMA AVG LBRACE ID DOT ID RBRACE attr_list {
 			RelAttr attr;
-			char* s=malloc(sizeof(char)*(3+strlen($6)+3));
+			char* s=parse_malloc(sizeof(char)*(3+strlen($6)+3));
 			strcpy(s, "AVG(");
 			// strcat(s, "(");
 			strcat(s, $6);
@@ -848,6 +1012,36 @@ attr_list:
 			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
 									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
 									&attr);
+	}
+	| COMMA ID LBRACE ID RBRACE attr_list {
+			if (strcasecmp($2, "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen($4)+3));
+			strcpy(s, "SUM(");
+			strcat(s, $4);
+			strcat(s, ")");
+			relation_attr_init(&attr, NULL, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
+	}
+	| COMMA ID LBRACE ID DOT ID RBRACE attr_list {
+			if (strcasecmp($2, "sum") != 0) {
+				yyerror(scanner, "unsupported aggregation");
+				YYABORT;
+			}
+			RelAttr attr;
+			char* s=parse_malloc(sizeof(char)*(3+strlen($6)+3));
+			strcpy(s, "SUM(");
+			strcat(s, $6);
+			strcat(s, ")");
+			relation_attr_init(&attr, $4, s);
+			attr_list_append_attribute(CONTEXT->attr_list_stack[CONTEXT->attr_list_stack_top], 
+									CONTEXT->attr_list_length_stack[CONTEXT->attr_list_stack_top]++,
+									&attr);
 	};
 
 rel_list:
@@ -1024,6 +1218,34 @@ group_by:
 			}
     ;
 
+limit:
+	/* empty */
+	| ID NUMBER {
+			// limit不是关键字，按ID解析: limit n
+			if (strcasecmp($1, "limit") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, $2, 0);
+	}
+	| ID NUMBER ID NUMBER {
+			// limit n offset m
+			if (strcasecmp($1, "limit") != 0 || strcasecmp($3, "offset") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, $2, $4);
+	}
+	| ID NUMBER COMMA NUMBER {
+			// limit m, n: 跳过m行后输出n行
+			if (strcasecmp($1, "limit") != 0) {
+				yyerror(scanner, "syntax error");
+				YYABORT;
+			}
+			selects_set_limit(&CONTEXT->ssql->sstr.selection, $4, $2);
+	}
+	;
+
 group_by_list:
 	/* empty */ {
 		// CONTEXT->condition_list_stack_top++;
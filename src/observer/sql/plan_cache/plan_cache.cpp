@@ -0,0 +1,263 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <ctype.h>
+#include <atomic>
+#include <vector>
+
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/parser/parse.h"
+#include "common/log/log.h"
+#include "common/mm/arena.h"
+
+static std::atomic<uint64_t> plan_version(0);
+
+/**
+ * 语句中所有可能是参数的值，按照它们在结构体中的位置
+ */
+static void collect_values(Query &query, std::vector<Value *> &values) {
+  Condition *conditions = nullptr;
+  size_t condition_num = 0;
+  switch (query.flag) {
+    case SCF_SELECT: {
+      conditions = query.sstr.selection.conditions;
+      condition_num = query.sstr.selection.condition_num;
+    } break;
+    case SCF_INSERT: {
+      for (size_t i = 0; i < query.sstr.insertion.value_num; i++) {
+        values.push_back(&query.sstr.insertion.values[i]);
+      }
+    } break;
+    case SCF_UPDATE: {
+      values.push_back(&query.sstr.update.value);
+      conditions = query.sstr.update.conditions;
+      condition_num = query.sstr.update.condition_num;
+    } break;
+    case SCF_DELETE: {
+      conditions = query.sstr.deletion.conditions;
+      condition_num = query.sstr.deletion.condition_num;
+    } break;
+    case SCF_EXECUTE: {
+      for (size_t i = 0; i < query.sstr.execution.value_num; i++) {
+        values.push_back(&query.sstr.execution.values[i]);
+      }
+    } break;
+    default: {
+    } break;
+  }
+  for (size_t i = 0; i < condition_num; i++) {
+    if (!conditions[i].left_is_attr) {
+      values.push_back(&conditions[i].left_value);
+    }
+    if (!conditions[i].right_is_attr) {
+      values.push_back(&conditions[i].right_value);
+    }
+  }
+}
+
+CachedPlan::CachedPlan(Query *query, uint64_t version) : query_(query), version_(version) {
+  param_num_ = query_param_num(*query);
+}
+
+CachedPlan::~CachedPlan() {
+  heap_query_destroy(query_);
+  query_ = nullptr;
+}
+
+bool CachedPlan::stale() const {
+  return version_ != PlanCache::version();
+}
+
+bool CachedPlan::get_join_plan(JoinPlan &join_plan) const {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  if (!planned_) {
+    return false;
+  }
+  join_plan = join_plan_;
+  return true;
+}
+
+void CachedPlan::set_join_plan(const JoinPlan &join_plan) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  join_plan_ = join_plan;
+  planned_ = true;
+}
+
+PlanCache::PlanCache(size_t capacity) : capacity_(capacity) {
+}
+
+void PlanCache::set_capacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  capacity_ = capacity;
+  while (lru_list_.size() > capacity_) {
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+  }
+}
+
+std::shared_ptr<CachedPlan> PlanCache::get(const std::string &key) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return nullptr;
+  }
+  if (iter->second->second->stale()) {
+    lru_list_.erase(iter->second);
+    entries_.erase(iter);
+    return nullptr;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+  return iter->second->second;
+}
+
+void PlanCache::put(const std::string &key, const std::shared_ptr<CachedPlan> &plan) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  if (capacity_ == 0) {
+    return;
+  }
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    iter->second->second = plan;
+    lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+    return;
+  }
+  lru_list_.emplace_front(key, plan);
+  entries_[key] = lru_list_.begin();
+  if (lru_list_.size() > capacity_) {
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+  }
+}
+
+void PlanCache::clear() {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  entries_.clear();
+  lru_list_.clear();
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  return lru_list_.size();
+}
+
+uint64_t PlanCache::version() {
+  return plan_version.load();
+}
+
+void PlanCache::invalidate() {
+  plan_version++;
+}
+
+std::string PlanCache::make_key(const std::string &db, const std::string &sql) {
+  std::string key;
+  key.reserve(db.size() + 1 + sql.size());
+  key.append(db);
+  key.push_back('\n');
+
+  const size_t prefix = key.size();
+  char quote = 0;
+  bool space = false;
+  for (char c : sql) {
+    if (quote == 0 && isspace((unsigned char)c)) {
+      space = true;
+      continue;
+    }
+    if (space && key.size() > prefix) {
+      key.push_back(' ');
+    }
+    space = false;
+    if (quote == 0 && (c == '\'' || c == '\"')) {
+      quote = c;
+    } else if (c == quote) {
+      quote = 0;
+    }
+    key.push_back(c);
+  }
+  return key;
+}
+
+bool query_cacheable(const Query &query) {
+  const Condition *conditions = nullptr;
+  size_t condition_num = 0;
+  switch (query.flag) {
+    case SCF_SELECT: {
+      conditions = query.sstr.selection.conditions;
+      condition_num = query.sstr.selection.condition_num;
+    } break;
+    case SCF_INSERT: {
+    } break;
+    case SCF_UPDATE: {
+      conditions = query.sstr.update.conditions;
+      condition_num = query.sstr.update.condition_num;
+    } break;
+    case SCF_DELETE: {
+      conditions = query.sstr.deletion.conditions;
+      condition_num = query.sstr.deletion.condition_num;
+    } break;
+    default: {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < condition_num; i++) {
+    if (conditions[i].is_select) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int query_param_num(const Query &query) {
+  std::vector<Value *> values;
+  collect_values(const_cast<Query &>(query), values);
+  int param_num = 0;
+  for (const Value *value : values) {
+    param_num += value->type == PARAMETER;
+  }
+  return param_num;
+}
+
+RC bind_parameters(const Query &prepared, const ExecutePrepared &execution, Query &bound) {
+  bound = prepared;
+  std::vector<Value *> values;
+  collect_values(bound, values);
+  for (Value *value : values) {
+    if (value->type != PARAMETER) {
+      continue;
+    }
+    const int index = *(const int *)value->data;
+    if (index < 0 || index >= (int)execution.value_num || execution.values[index].type == PARAMETER) {
+      LOG_WARN("No value for parameter %d. value num=%d", index, (int)execution.value_num);
+      return RC::INVALID_ARGUMENT;
+    }
+    *value = execution.values[index];
+  }
+  return RC::SUCCESS;
+}
+
+RC heap_query_parse(const char *sql, Query *&query) {
+  common::ArenaGuard arena_guard(nullptr);
+  query = query_create();
+  if (query == nullptr) {
+    return RC::NOMEM;
+  }
+  RC rc = parse(sql, query);
+  if (rc != RC::SUCCESS) {
+    query_destroy(query);
+    query = nullptr;
+  }
+  return rc;
+}
+
+void heap_query_destroy(Query *query) {
+  if (query != nullptr) {
+    common::ArenaGuard arena_guard(nullptr);
+    query_destroy(query);
+  }
+}
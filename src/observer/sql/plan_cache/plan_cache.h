@@ -0,0 +1,134 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_SQL_PLAN_CACHE_PLAN_CACHE_H__
+#define __OBSERVER_SQL_PLAN_CACHE_PLAN_CACHE_H__
+
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "rc.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/optimizer/join_planner.h"
+
+/**
+ * 缓存的执行计划。query是在堆上(不在请求的Arena中)解析出来的语句，被多个请求共享，执行时只读。
+ * 没有参数的查询第一次执行时记下优化器选择的连接计划，之后直接使用
+ */
+class CachedPlan {
+public:
+  /**
+   * @param query 接管这个语句，析构时释放
+   * @param version 解析语句之前的PlanCache::version()
+   */
+  CachedPlan(Query *query, uint64_t version);
+  ~CachedPlan();
+
+  CachedPlan(const CachedPlan &) = delete;
+  CachedPlan &operator=(const CachedPlan &) = delete;
+
+  Query *query() const {
+    return query_;
+  }
+  int param_num() const {
+    return param_num_;
+  }
+  bool stale() const;
+
+  bool get_join_plan(JoinPlan &join_plan) const;
+  void set_join_plan(const JoinPlan &join_plan);
+
+private:
+  Query *query_;
+  int param_num_ = 0;
+  uint64_t version_;
+
+  mutable std::mutex mutex_;
+  bool planned_ = false;
+  JoinPlan join_plan_;
+};
+
+/**
+ * prepare语句保存在会话中的语句
+ */
+struct PreparedStatement {
+  std::string sql;                    /// prepare语句的原文，计划失效后重新解析
+  std::shared_ptr<CachedPlan> plan;
+};
+
+/**
+ * 按规范化的SQL文本缓存执行计划，超过容量时淘汰最久没有使用的。
+ * 建表、删表、建索引和收集统计信息之后调用invalidate，之前缓存的计划都失效
+ */
+class PlanCache {
+public:
+  static const size_t DEFAULT_CAPACITY = 1024;
+
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY);
+
+  void set_capacity(size_t capacity);
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  /**
+   * @return 没有缓存或者计划已经失效时返回nullptr
+   */
+  std::shared_ptr<CachedPlan> get(const std::string &key);
+  void put(const std::string &key, const std::shared_ptr<CachedPlan> &plan);
+  void clear();
+  size_t size() const;
+
+  static uint64_t version();
+  static void invalidate();
+
+  /**
+   * 缓存的键：当前数据库加上规范化的SQL文本。
+   * 引号之外连续的空白合并成一个空格，去掉首尾的空白，不改变大小写
+   */
+  static std::string make_key(const std::string &db, const std::string &sql);
+
+private:
+  typedef std::list<std::pair<std::string, std::shared_ptr<CachedPlan>>> LruList;
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  LruList lru_list_;                  /// 最近使用的在前面
+  std::unordered_map<std::string, LruList::iterator> entries_;
+};
+
+/**
+ * 可以缓存计划的语句：没有子查询的select、insert、update和delete。
+ * 子查询的语句保存在解析器的上下文中，解析结束之后不能在多个请求之间共享
+ */
+bool query_cacheable(const Query &query);
+
+/**
+ * 语句中参数?的个数
+ */
+int query_param_num(const Query &query);
+
+/**
+ * 把execute中的值按顺序替换语句中的参数，结果是prepared的浅拷贝，与prepared和execution共享内存，
+ * 不能用query_destroy释放
+ */
+RC bind_parameters(const Query &prepared, const ExecutePrepared &execution, Query &bound);
+
+/**
+ * 在堆上解析语句，结果可以在请求结束后继续使用，用heap_query_destroy释放
+ */
+RC heap_query_parse(const char *sql, Query *&query);
+void heap_query_destroy(Query *query);
+
+#endif // __OBSERVER_SQL_PLAN_CACHE_PLAN_CACHE_H__
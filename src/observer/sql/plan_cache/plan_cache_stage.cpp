@@ -12,7 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 
+#include <ctype.h>
 #include <string.h>
+#include <strings.h>
 #include <string>
 
 #include "plan_cache_stage.h"
@@ -22,9 +24,38 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/seda/timer_stage.h"
+#include "event/execution_plan_event.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
 
 using namespace common;
 
+const char * CONF_PLAN_CACHE_CAPACITY = "PlanCacheCapacity";
+
+/**
+ * 只有这些语句会用到计划缓存，其它语句直接交给解析阶段
+ */
+static bool may_use_plan_cache(const std::string &sql) {
+  static const char *KEYWORDS[] = {"select", "insert", "update", "delete",
+                                   "explain", "prepare", "execute", "deallocate"};
+  size_t begin = 0;
+  while (begin < sql.size() && isspace((unsigned char)sql[begin])) {
+    begin++;
+  }
+  size_t end = begin;
+  while (end < sql.size() && isalpha((unsigned char)sql[end])) {
+    end++;
+  }
+  const std::string word = sql.substr(begin, end - begin);
+  for (const char *keyword : KEYWORDS) {
+    if (strcasecmp(word.c_str(), keyword) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //! Constructor
 PlanCacheStage::PlanCacheStage(const char *tag) : Stage(tag) {}
 
@@ -44,14 +75,15 @@ Stage *PlanCacheStage::make_stage(const std::string &tag) {
 
 //! Set properties for this object set in stage specific properties
 bool PlanCacheStage::set_properties() {
-  //  std::string stageNameStr(stage_name_);
-  //  std::map<std::string, std::string> section = g_properties()->get(
-  //    stageNameStr);
-  //
-  //  std::map<std::string, std::string>::iterator it;
-  //
-  //  std::string key;
+  std::string stageNameStr(stage_name_);
+  std::map<std::string, std::string> section = get_properties()->get(stageNameStr);
 
+  std::map<std::string, std::string>::iterator iter = section.find(CONF_PLAN_CACHE_CAPACITY);
+  if (iter != section.end()) {
+    long capacity = atol(iter->second.c_str());
+    plan_cache_.set_capacity(capacity > 0 ? (size_t)capacity : 0);
+    LOG_INFO("Plan cache capacity is %ld", capacity);
+  }
   return true;
 }
 
@@ -62,6 +94,7 @@ bool PlanCacheStage::initialize() {
   std::list<Stage *>::iterator stgp = next_stage_list_.begin();
   execute_stage = *(stgp++);
   parse_stage = *(stgp++);
+  optimize_stage = *(stgp++);
 
   LOG_TRACE("Exit");
   return true;
@@ -77,30 +110,173 @@ void PlanCacheStage::cleanup() {
 void PlanCacheStage::handle_event(StageEvent *event) {
   LOG_TRACE("Enter\n");
 
-  // Add callback to update plan cache
-  /*
-  CompletionCallback *cb = new (std::nothrow) CompletionCallback(this, nullptr);
-  if (cb == nullptr) {
-    LOG_ERROR("Failed to new callback for SQLStageEvent");
-    event->done_immediate();
+  SQLStageEvent *sql_event = static_cast<SQLStageEvent *>(event);
+  const std::string &sql = sql_event->get_sql();
+  if (!may_use_plan_cache(sql)) {
+    parse_stage->handle_event(event);
+    LOG_TRACE("Exit\n");
     return;
   }
 
-  event->push_callback(cb);
-   */
-  // do nothing here, pass the event to the next stage
-  parse_stage->handle_event(event);
+  Session *session = sql_event->session_event()->get_client()->session;
+  const std::string key = PlanCache::make_key(session->get_current_db(), sql);
+  std::shared_ptr<CachedPlan> plan = find_plan(session, key);
+  if (plan == nullptr) {
+    // 缓存的语句要在请求结束之后继续使用，不能解析到请求的Arena中
+    const uint64_t version = PlanCache::version();
+    Query *query = nullptr;
+    RC rc = heap_query_parse(sql.c_str(), query);
+    if (rc != RC::SUCCESS) {
+      // 由解析阶段报告语法错误
+      parse_stage->handle_event(event);
+      LOG_TRACE("Exit\n");
+      return;
+    }
+
+    if (query->flag == SCF_EXECUTE) {
+      execute_prepared(sql_event, query->sstr.execution);
+      heap_query_destroy(query);
+      LOG_TRACE("Exit\n");
+      return;
+    }
+    if (query->flag == SCF_DEALLOCATE) {
+      bool found = session->remove_prepared_statement(query->sstr.deallocation.name);
+      heap_query_destroy(query);
+      respond(sql_event, found ? "SUCCESS\n" : "FAILURE\n");
+      LOG_TRACE("Exit\n");
+      return;
+    }
+    if (!query_cacheable(*query)) {
+      // 有子查询的语句照常解析执行，但是不能prepare，也不能有参数
+      const bool prepared = query->prepare_name != nullptr || query_param_num(*query) > 0;
+      heap_query_destroy(query);
+      if (prepared) {
+        LOG_WARN("Statement cannot be prepared. sql=%s", sql.c_str());
+        respond(sql_event, "FAILURE\n");
+      } else {
+        parse_stage->handle_event(event);
+      }
+      LOG_TRACE("Exit\n");
+      return;
+    }
+
+    plan = std::make_shared<CachedPlan>(query, version);
+    if (plan->param_num() > 0 && query->prepare_name == nullptr) {
+      LOG_WARN("Parameters are only allowed in prepared statements. sql=%s", sql.c_str());
+      respond(sql_event, "FAILURE\n");
+      LOG_TRACE("Exit\n");
+      return;
+    }
+    if (query->flag != SCF_INSERT || query->prepare_name != nullptr) {
+      // 带常量的insert几乎不会重复执行，不放进缓存，免得挤掉其它语句
+      put_plan(session, key, plan);
+    }
+  }
+
+  Query *query = plan->query();
+  if (query->prepare_name != nullptr) {
+    PreparedStatement statement;
+    statement.sql = sql;
+    statement.plan = plan;
+    session->set_prepared_statement(query->prepare_name, std::move(statement));
+    respond(sql_event, "SUCCESS\n");
+  } else {
+    execute_plan(sql_event, plan.get(), query);
+  }
 
   LOG_TRACE("Exit\n");
   return;
 }
 
+std::shared_ptr<CachedPlan> PlanCacheStage::find_plan(Session *session, const std::string &key) {
+  if (plan_cache_.capacity() == 0) {
+    return nullptr;
+  }
+  std::shared_ptr<CachedPlan> plan = session->plan_cache().get(key);
+  if (plan == nullptr) {
+    plan = plan_cache_.get(key);
+    if (plan != nullptr) {
+      session->plan_cache().put(key, plan);
+    }
+  }
+  return plan;
+}
+
+void PlanCacheStage::put_plan(Session *session, const std::string &key, const std::shared_ptr<CachedPlan> &plan) {
+  if (plan_cache_.capacity() == 0) {
+    return;
+  }
+  session->plan_cache().put(key, plan);
+  plan_cache_.put(key, plan);
+}
+
+void PlanCacheStage::execute_prepared(SQLStageEvent *sql_event, const ExecutePrepared &execution) {
+  Session *session = sql_event->session_event()->get_client()->session;
+  PreparedStatement *statement = session->find_prepared_statement(execution.name);
+  if (statement == nullptr) {
+    LOG_WARN("No such prepared statement: %s", execution.name);
+    respond(sql_event, "FAILURE\n");
+    return;
+  }
+
+  if (statement->plan->stale()) {
+    // 表结构或者统计信息变化了，重新解析prepare的语句
+    const uint64_t version = PlanCache::version();
+    Query *query = nullptr;
+    RC rc = heap_query_parse(statement->sql.c_str(), query);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to prepare statement again. sql=%s", statement->sql.c_str());
+      respond(sql_event, "FAILURE\n");
+      return;
+    }
+    statement->plan = std::make_shared<CachedPlan>(query, version);
+  }
+
+  // 执行期间持有计划，即使同名的语句被重新prepare
+  std::shared_ptr<CachedPlan> plan = statement->plan;
+  if ((int)execution.value_num != plan->param_num()) {
+    LOG_WARN("Prepared statement %s needs %d parameters, but %d given",
+             execution.name, plan->param_num(), (int)execution.value_num);
+    respond(sql_event, "FAILURE\n");
+    return;
+  }
+
+  Query bound;
+  RC rc = bind_parameters(*plan->query(), execution, bound);
+  if (rc != RC::SUCCESS) {
+    respond(sql_event, "FAILURE\n");
+    return;
+  }
+  execute_plan(sql_event, plan.get(), &bound);
+}
+
+/**
+ * 跳过解析阶段，直接优化和执行。后续的stage在当前线程中同步执行，返回时query和plan已经不再使用
+ */
+void PlanCacheStage::execute_plan(SQLStageEvent *sql_event, CachedPlan *plan, Query *query) {
+  CompletionCallback *cb = new (std::nothrow) CompletionCallback(this, nullptr);
+  if (cb == nullptr) {
+    LOG_ERROR("Failed to new callback for SQLStageEvent");
+    callback_event(sql_event, nullptr);
+    sql_event->done_immediate();
+    return;
+  }
+  sql_event->push_callback(cb);
+  optimize_stage->handle_event(new ExecutionPlanEvent(sql_event, query, plan));
+}
+
+void PlanCacheStage::respond(SQLStageEvent *sql_event, const char *response) {
+  sql_event->session_event()->set_response(response);
+  callback_event(sql_event, nullptr);
+  sql_event->done_immediate();
+}
+
 void PlanCacheStage::callback_event(StageEvent *event,
                                    CallbackContext *context) {
   LOG_TRACE("Enter\n");
 
-  // update execute plan here
-  // event->done_immediate();
+  SQLStageEvent *sql_event = static_cast<SQLStageEvent *>(event);
+  sql_event->session_event()->done_immediate();
 
   LOG_TRACE("Exit\n");
   return;
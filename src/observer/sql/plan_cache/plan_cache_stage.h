@@ -15,7 +15,13 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_SQL_PLAN_CACHE_STAGE_H__
 #define __OBSERVER_SQL_PLAN_CACHE_STAGE_H__
 
+#include <memory>
+
 #include "common/seda/stage.h"
+#include "sql/plan_cache/plan_cache.h"
+
+class SQLStageEvent;
+class Session;
 
 class PlanCacheStage : public common::Stage {
 public:
@@ -34,9 +40,18 @@ protected:
                      common::CallbackContext *context);
 
 protected:
+private:
+  std::shared_ptr<CachedPlan> find_plan(Session *session, const std::string &key);
+  void put_plan(Session *session, const std::string &key, const std::shared_ptr<CachedPlan> &plan);
+  void execute_prepared(SQLStageEvent *sql_event, const ExecutePrepared &execution);
+  void execute_plan(SQLStageEvent *sql_event, CachedPlan *plan, Query *query);
+  void respond(SQLStageEvent *sql_event, const char *response);
+
 private:
   Stage *parse_stage = nullptr;
   Stage *execute_stage = nullptr;
+  Stage *optimize_stage = nullptr;
+  PlanCache plan_cache_;              /// 所有会话共享的计划缓存
 };
 
 #endif //__OBSERVER_SQL_PLAN_CACHE_STAGE_H__
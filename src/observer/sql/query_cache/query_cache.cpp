@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include "sql/query_cache/query_cache.h"
+
+size_t CachedResult::memory_size() const {
+  size_t size = sizeof(CachedResult) + response.size();
+  for (const auto &table : tables) {
+    size += sizeof(table) + table.first.size();
+  }
+  return size;
+}
+
+QueryCache::QueryCache(size_t memory_limit) : memory_limit_(memory_limit) {
+}
+
+void QueryCache::set_memory_limit(size_t memory_limit) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  memory_limit_ = memory_limit;
+  evict();
+}
+
+std::shared_ptr<const CachedResult> QueryCache::get(const std::string &key) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return nullptr;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+  return iter->second->second;
+}
+
+void QueryCache::put(const std::string &key, CachedResult &&result) {
+  const size_t size = entry_size(key, result);
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  if (size > max_result_size()) {
+    return;
+  }
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    erase(iter->second);
+  }
+  lru_list_.emplace_front(key, std::make_shared<const CachedResult>(std::move(result)));
+  entries_[key] = lru_list_.begin();
+  memory_usage_ += size;
+  evict();
+}
+
+void QueryCache::remove(const std::string &key) {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    erase(iter->second);
+  }
+}
+
+void QueryCache::clear() {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  entries_.clear();
+  lru_list_.clear();
+  memory_usage_ = 0;
+}
+
+size_t QueryCache::size() const {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  return lru_list_.size();
+}
+
+size_t QueryCache::memory_usage() const {
+  std::lock_guard<std::mutex> lock_guard(mutex_);
+  return memory_usage_;
+}
+
+void QueryCache::erase(LruList::iterator iter) {
+  memory_usage_ -= entry_size(iter->first, *iter->second);
+  entries_.erase(iter->first);
+  lru_list_.erase(iter);
+}
+
+void QueryCache::evict() {
+  while (memory_usage_ > memory_limit_ && !lru_list_.empty()) {
+    erase(std::prev(lru_list_.end()));
+  }
+}
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#ifndef __OBSERVER_SQL_QUERY_CACHE_QUERY_CACHE_H__
+#define __OBSERVER_SQL_QUERY_CACHE_QUERY_CACHE_H__
+
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * 查询涉及的表和执行查询之前这些表的数据版本(Table::data_version)
+ */
+typedef std::vector<std::pair<std::string, uint64_t>> TableVersions;
+
+/**
+ * 缓存的查询结果
+ */
+struct CachedResult {
+  std::string response;               /// 返回给客户端的完整结果
+  TableVersions tables;
+
+  size_t memory_size() const;
+};
+
+/**
+ * 按规范化的SQL文本缓存select的结果，总大小超过限制时淘汰最久没有使用的。
+ * 缓存本身不知道结果是否过期，使用者需要比较tables中记录的版本与表当前的版本
+ */
+class QueryCache {
+public:
+  static const size_t DEFAULT_MEMORY_LIMIT = 16 * 1024 * 1024;
+
+  explicit QueryCache(size_t memory_limit = DEFAULT_MEMORY_LIMIT);
+
+  /**
+   * @param memory_limit 缓存的结果占用的内存上限，0表示不缓存
+   */
+  void set_memory_limit(size_t memory_limit);
+  size_t memory_limit() const {
+    return memory_limit_;
+  }
+
+  std::shared_ptr<const CachedResult> get(const std::string &key);
+
+  /**
+   * 超过max_result_size的结果不缓存，免得一个大结果挤掉所有其它结果
+   */
+  void put(const std::string &key, CachedResult &&result);
+
+  /**
+   * 可以缓存的最大结果：内存上限的1/8
+   */
+  size_t max_result_size() const {
+    return memory_limit_ / 8;
+  }
+  void remove(const std::string &key);
+  void clear();
+  size_t size() const;
+  size_t memory_usage() const;
+
+private:
+  typedef std::list<std::pair<std::string, std::shared_ptr<const CachedResult>>> LruList;
+
+  static size_t entry_size(const std::string &key, const CachedResult &result) {
+    return key.size() + result.memory_size();
+  }
+  void erase(LruList::iterator iter);
+  void evict();
+
+private:
+  mutable std::mutex mutex_;
+  size_t memory_limit_;
+  size_t memory_usage_ = 0;
+  LruList lru_list_;                  /// 最近使用的在前面
+  std::unordered_map<std::string, LruList::iterator> entries_;
+};
+
+#endif // __OBSERVER_SQL_QUERY_CACHE_QUERY_CACHE_H__
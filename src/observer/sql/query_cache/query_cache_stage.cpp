@@ -12,7 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 
+#include <ctype.h>
 #include <string.h>
+#include <strings.h>
 #include <string>
 
 #include "query_cache_stage.h"
@@ -21,10 +23,33 @@ See the Mulan PSL v2 for more details. */
 #include "common/io/io.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "common/metrics/metrics_registry.h"
 #include "common/seda/timer_stage.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "storage/common/table.h"
+#include "storage/default/default_handler.h"
 
 using namespace common;
 
+const std::string QueryCacheStage::HIT_METRIC_TAG = "QueryCacheStage.hit";
+const std::string QueryCacheStage::MISS_METRIC_TAG = "QueryCacheStage.miss";
+static const char *CONF_QUERY_CACHE_MEMORY = "QueryCacheMemory";
+
+/**
+ * 只缓存select的结果。不需要解析语句，看第一个单词就可以
+ */
+static bool is_select(const std::string &sql) {
+  size_t begin = 0;
+  while (begin < sql.size() && isspace((unsigned char)sql[begin])) {
+    begin++;
+  }
+  return sql.size() - begin > 6 && strncasecmp(sql.c_str() + begin, "select", 6) == 0 &&
+         isspace((unsigned char)sql[begin + 6]);
+}
+
 //! Constructor
 QueryCacheStage::QueryCacheStage(const char *tag) : Stage(tag) {}
 
@@ -44,14 +69,15 @@ Stage *QueryCacheStage::make_stage(const std::string &tag) {
 
 //! Set properties for this object set in stage specific properties
 bool QueryCacheStage::set_properties() {
-  //  std::string stageNameStr(stage_name_);
-  //  std::map<std::string, std::string> section = g_properties()->get(
-  //    stageNameStr);
-  //
-  //  std::map<std::string, std::string>::iterator it;
-  //
-  //  std::string key;
-
+  std::string stageNameStr(stage_name_);
+  std::map<std::string, std::string> section = get_properties()->get(stageNameStr);
+
+  std::map<std::string, std::string>::iterator iter = section.find(CONF_QUERY_CACHE_MEMORY);
+  if (iter != section.end()) {
+    long megabytes = atol(iter->second.c_str());
+    query_cache_.set_memory_limit(megabytes > 0 ? (size_t)megabytes * 1024 * 1024 : 0);
+    LOG_INFO("Query cache memory limit is %ldMB", megabytes);
+  }
   return true;
 }
 
@@ -62,6 +88,12 @@ bool QueryCacheStage::initialize() {
   std::list<Stage *>::iterator stgp = next_stage_list_.begin();
   plan_cache_stage = *(stgp++);
 
+  MetricsRegistry &metricsRegistry = get_metrics_registry();
+  hit_metric_ = new Meter();
+  metricsRegistry.register_metric(HIT_METRIC_TAG, hit_metric_);
+  miss_metric_ = new Meter();
+  metricsRegistry.register_metric(MISS_METRIC_TAG, miss_metric_);
+
   LOG_TRACE("Exit");
   return true;
 }
@@ -76,31 +108,69 @@ void QueryCacheStage::cleanup() {
 void QueryCacheStage::handle_event(StageEvent *event) {
   LOG_TRACE("Enter\n");
 
-  // Add callback to update query cache
-  /*
-  CompletionCallback *cb = new (std::nothrow) CompletionCallback(this, nullptr);
-  if (cb == nullptr) {
-    LOG_ERROR("Failed to new callback for SQLStageEvent");
-    event->done_immediate();
+  SQLStageEvent *sql_event = static_cast<SQLStageEvent *>(event);
+  SessionEvent *session_event = sql_event->session_event();
+  Session *session = session_event->get_client()->session;
+  const std::string &sql = sql_event->get_sql();
+  if (query_cache_.memory_limit() == 0 || !session->query_cache_enabled() ||
+      session->is_trx_multi_operation_mode() || !is_select(sql)) {
+    plan_cache_stage->handle_event(event);
+    LOG_TRACE("Exit\n");
     return;
   }
 
-  event->push_callback(cb);
-   */
-  // do nothing here, pass the event to the next stage
+  const std::string key = PlanCache::make_key(session->get_current_db(), sql);
+  if (find_result(sql_event, key)) {
+    hit_metric_->inc();
+    LOG_TRACE("Exit\n");
+    return;
+  }
+  miss_metric_->inc();
+
+  // 查询结果边生成边发送，保留一份副本用于缓存，太大的结果本来也不会缓存
+  session_event->output_buffer().capture(query_cache_.max_result_size());
+
+  // 后续的stage同步执行，返回时结果已经发送。sql_event可能已经释放，只能使用session_event
   plan_cache_stage->handle_event(event);
+  CachedResult result;
+  if (session_event->result_cacheable() && session_event->copy_response(result.response)) {
+    result.tables = std::move(session_event->result_tables());
+    query_cache_.put(key, std::move(result));
+  }
 
   LOG_TRACE("Exit\n");
   return;
 }
 
+/**
+ * 查找缓存的结果，所有表的数据版本都没有变化时直接返回给客户端
+ */
+bool QueryCacheStage::find_result(SQLStageEvent *sql_event, const std::string &key) {
+  std::shared_ptr<const CachedResult> result = query_cache_.get(key);
+  if (result == nullptr) {
+    return false;
+  }
+
+  SessionEvent *session_event = sql_event->session_event();
+  const char *db = session_event->get_client()->session->get_current_db().c_str();
+  for (const auto &table_version : result->tables) {
+    Table *table = DefaultHandler::get_default().find_table(db, table_version.first.c_str());
+    if (table == nullptr || table->data_version() != table_version.second) {
+      query_cache_.remove(key);
+      return false;
+    }
+  }
+
+  session_event->set_response(result->response.data(), result->response.size());
+  session_event->done_immediate();
+  sql_event->done_immediate();
+  return true;
+}
+
 void QueryCacheStage::callback_event(StageEvent *event,
                                     CallbackContext *context) {
   LOG_TRACE("Enter\n");
 
-  // update data to query cache here
-  // event->done_immediate();
-
   LOG_TRACE("Exit\n");
   return;
 }
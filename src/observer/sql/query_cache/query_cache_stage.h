@@ -16,6 +16,10 @@ See the Mulan PSL v2 for more details. */
 #define __OBSERVER_SQL_QUERY_CACHE_STAGE_H__
 
 #include "common/seda/stage.h"
+#include "common/metrics/metrics.h"
+#include "sql/query_cache/query_cache.h"
+
+class SQLStageEvent;
 
 class QueryCacheStage : public common::Stage {
 public:
@@ -34,8 +38,18 @@ protected:
                      common::CallbackContext *context);
 
 protected:
+private:
+  bool find_result(SQLStageEvent *sql_event, const std::string &key);
+
+public:
+  static const std::string HIT_METRIC_TAG;
+  static const std::string MISS_METRIC_TAG;
+
 private:
   Stage *plan_cache_stage = nullptr;
+  QueryCache query_cache_;
+  common::Meter *hit_metric_ = nullptr;
+  common::Meter *miss_metric_ = nullptr;
 };
 
 #endif //__OBSERVER_SQL_QUERY_CACHE_STAGE_H__
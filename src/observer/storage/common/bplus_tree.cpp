@@ -12,12 +12,15 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 #include "storage/common/bplus_tree.h"
+#include "storage/common/null_bitmap.h"
 #include "storage/default/disk_buffer_pool.h"
 #include "rc.h"
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 int float_compare(float f1, float f2) {
   float result = f1 - f2;
@@ -78,19 +81,23 @@ RC BplusTreeHandler::create(const char *file_name, const FieldMeta * field_meta[
   file_header->file_num = field_num;
   file_header->attr_length = new int[field_num];
   file_header->attr_type = new AttrType[field_num];
+  file_header->total_attr_length = 0;
+  file_header->null_mask = 0;
   for(int i =0; i < field_num; i++) {
     file_header->attr_type[i] = field_meta[i]->type();
-    if (field_meta[i]->type() == INTS_NULLABLE 
-      || field_meta[i]->type() == CHARS_NULLABLE
-      || field_meta[i]->type() == FLOATS_NULLABLE
-      || field_meta[i]->type() == DATES_NULLABLE) {
-      file_header->attr_length[i] = field_meta[i]->len() + 4;
+    if (field_meta[i]->dict() != nullptr) {
+      // 字典编码的字段按照int编码比较，避免编码中的0字节截断字符串比较
+      file_header->attr_type[i] = INTS;
     }
-    else {
-      file_header->attr_length[i] = field_meta[i]->len(); 
+    if (field_meta[i]->nullable()) {
+      file_header->null_mask |= (1 << i);
     }
+    file_header->attr_length[i] = field_meta[i]->len(); 
     file_header->total_attr_length += file_header->attr_length[i];
   }
+  if (file_header->null_mask != 0) {
+    file_header->total_attr_length += NULL_BITMAP_SIZE;
+  }
 
   //file_header->attr_length = attr_length;
   //file_header->key_length = attr_length + sizeof(RID);
@@ -180,191 +187,70 @@ static int CmpRid(const RID *rid1, const RID *rid2) {
     return -1;
   return 0;
 }
-int CompareKey(const char *pdata, const char *pkey,AttrType *attr_type,int *attr_length, const int &file_num) { // 简化
-  int i1,i2;
-  float f1,f2;
-  const char *s1,*s2;
-  int is_null1, is_null2;
-
-  std::string pdata_str = pdata;
-  std::string pkey_str = pkey;
-  int len = 0;
-  size_t offset = 0;
-  for(int i= 0; i < file_num; i++) {
-    AttrType my_attr_type = attr_type[i];
-    int my_attr_length = attr_length[i];
-      // std::string temp1 = pdata_str.substr(len,my_attr_length);
-    // std::string temp2 = pkey_str.substr(len,my_attr_length);
+static int compare_attr(AttrType attr_type, int attr_length, const char *data, const char *key) {
+  switch (attr_type) {
+    case INTS:
+    case DATES: {
+      int i1 = *(int *) data;
+      int i2 = *(int *) key;
+      if (i1 > i2)
+        return 1;
+      if (i1 < i2)
+        return -1;
+      return 0;
+    }
+    case FLOATS: {
+      float f1 = *(float *) data;
+      float f2 = *(float *) key;
+      return float_compare(f1, f2);
+    }
+    case TEXT:
+    case CHARS: {
+      return strncmp(data, key, attr_length);
+    }
+    default: {
+      LOG_PANIC("Unknown attr type: %d", attr_type);
+      return -2;//This means error happens
+    }
+  }
+}
+
+/**
+ * 比较两个键。键字段可为null时，键的头部是null位图，null排在所有非null值的后面
+ */
+int CompareKey(const IndexFileHeader &file_header, const char *pdata, const char *pkey) {
+  const bool has_null_bitmap = file_header.null_mask != 0;
+  int offset = has_null_bitmap ? NULL_BITMAP_SIZE : 0;
+  for(int i= 0; i < file_header.file_num; i++) {
+    const int attr_length = file_header.attr_length[i];
     const char *data = pdata + offset;
     const char *key = pkey + offset;
-    offset += my_attr_length;
-    len += my_attr_length;
-    switch(my_attr_type){
-      case INTS: {
-        i1 = *(int *) data;
-        i2 = *(int *) key;
-        if (i1 > i2)
-          return 1;
-        if (i1 < i2)
-          return -1;
-        if (i1 == i2)
-          continue;
-      }
-        break;
-      case INTS_NULLABLE: {
-        i1 = *(int *) data;
-        // i2 = *(int *) pkey;
-        is_null1 = *(int *) (data + my_attr_length - 4);
-        // is_null2 = *(int *) (pkey + attr_length - 4);
-        if (key == nullptr) {
-          i2 = 0;
-          is_null2 = 1;
-        } else {
-          i2 = *(int *) key;
-          is_null2 = *(int *) (key + my_attr_length - 4);
-        }
-        if (is_null1 == 1 && is_null2 == 1) {
-          continue;
-        } else if (is_null1 == 1 && is_null2 != 1) {
-          return 1;
-        } else if (is_null1 != 1 && is_null2 == 1) {
-          continue;
-        }
-        if (i1 > i2)
-          return 1;
-        if (i1 < i2)
-          return -1;
-        if (i1 == i2)
-          continue;
-      }
-        break;
-      case FLOATS: {
-        f1 = *(float *) data;
-        f2 = *(float *) key;
-        //return float_compare(f1, f2);
-        int ret = float_compare(f1, f2);
-        if(ret != 0)
-          return ret;
-        else 
-          continue;
-      }
-        break;
-      case FLOATS_NULLABLE: {
-        f1 = *(float *) data;
-        // f2 = *(float *) pkey;
-        is_null1 = *(int *) (data + my_attr_length - 4);
-        // is_null2 = *(int *) (pkey + attr_length - 4);
-        if (key == nullptr) {
-          f2 = 0;
-          is_null2 = 1;
-        } else {
-          f2 = *(float *) key;
-          is_null2 = *(int *) (key + my_attr_length - 4);
-        }
-        if (is_null1 == 1 && is_null2 == 1) {
-          continue;
-        } else if (is_null1 == 1 && is_null2 != 1) {
-          return 1;
-        } else if (is_null1 != 1 && is_null2 == 1) {
-          continue;
-        }
-        int ret = float_compare(f1, f2);
-        if(ret != 0)
-          return ret;
-        else 
-          continue;
-      }
-        break;
-      case TEXT:
-      case CHARS: {
-        s1 = data;
-        s2 = key;
-        int ret = strncmp(s1, s2, my_attr_length);
-        if(ret != 0)
-          return ret;
-        else 
-          continue;
-      }
-        break;
-      case CHARS_NULLABLE: {
-        s1 = data;
-        // s2 = pkey;
-        is_null1 = *(int *) (data + my_attr_length - 4);
-        // is_null2 = *(int *) (pkey + attr_length - 4);
-        if (key == nullptr) {
-          s2 = 0;
-          is_null2 = 1;
-        } else {
-          s2 = key;
-          is_null2 = *(int *) (key + my_attr_length - 4);
-        }
-        if (is_null1 == 1 && is_null2 == 1) {
-          continue;
-        } else if (is_null1 == 1 && is_null2 != 1) {
-          return 1;
-        } else if (is_null1 != 1 && is_null2 == 1) {
-          continue;
-        }
-        int ret = strncmp(s1, s2, my_attr_length);
-        if(ret != 0)
-          return ret;
-        else 
-          continue;
-      }
-        break;
-      case DATES: {
-        i1 = *(int *) data;
-        i2 = *(int *) key;
-        if (i1 > i2)
-          return 1;
-        if (i1 < i2)
-          return -1;
-        if (i1 == i2)
-          continue;
-      }
-        break;
-      case DATES_NULLABLE: {
-        i1 = *(int *) data;
-        is_null1 = *(int *) (data + my_attr_length - 4);
-        if (key == nullptr) {
-          i2 = 0;
-          is_null2 = 1;
-        } else {
-          i2 = *(int *) key;
-          is_null2 = *(int *) (key + my_attr_length - 4);
-        }
-      
-        if (is_null1 == 1 && is_null2 == 1) {
-          continue;
-        } else if (is_null1 == 1 && is_null2 != 1) {
-          return 1;
-        } else if (is_null1 != 1 && is_null2 == 1) {
+    offset += attr_length;
+    if (has_null_bitmap) {
+      const bool is_null1 = null_bitmap_test(pdata, i);
+      const bool is_null2 = null_bitmap_test(pkey, i);
+      if (is_null1 || is_null2) {
+        if (is_null1 && is_null2) {
           continue;
         }
-        if (i1 > i2)
-          return 1;
-        if (i1 < i2)
-          return -1;
-        if (i1 == i2)
-          continue;
-      }
-        break;
-      default:{
-        LOG_PANIC("Unknown attr type: %d", my_attr_type);
-        return -2;//This means error happens
+        return is_null1 ? 1 : -1;
       }
     }
+    int ret = compare_attr(file_header.attr_type[i], attr_length, data, key);
+    if (ret != 0) {
+      return ret;
+    }
   }
   return 0;
 }
-int CmpKey(AttrType *attr_type, int *attr_length, const char *pdata, const char *pkey, const int &file_num, const int &total_attr_length)
+int CmpKey(const IndexFileHeader &file_header, const char *pdata, const char *pkey)
 {
-  int result = CompareKey(pdata, pkey, attr_type, attr_length, file_num);
+  int result = CompareKey(file_header, pdata, pkey);
   if (0 != result) {
     return result;
   }
-  RID *rid1 = (RID *) (pdata + total_attr_length);//mjy 需要修改
-  RID *rid2 = (RID *) (pkey + total_attr_length);
+  RID *rid1 = (RID *) (pdata + file_header.total_attr_length);//mjy 需要修改
+  RID *rid2 = (RID *) (pkey + file_header.total_attr_length);
   return CmpRid(rid1, rid2);
 }
 
@@ -386,7 +272,7 @@ RC BplusTreeHandler::find_leaf(const char *pkey,PageNum *leaf_page) {
   node = get_index_node(pdata);
   while(0 == node->is_leaf){
     for(i = 0; i < node->key_num; i++){
-      tmp = CmpKey(file_header_.attr_type, file_header_.attr_length,pkey,node->keys + i * file_header_.key_length, file_header_.file_num, file_header_.total_attr_length);
+      tmp = CmpKey(file_header_, pkey, node->keys + i * file_header_.key_length);
       if(tmp < 0)
         break;
     }
@@ -435,7 +321,7 @@ RC BplusTreeHandler::insert_into_leaf(PageNum leaf_page, const char *pkey, const
   node = get_index_node(pdata);
 
   for(insert_pos = 0; insert_pos < node->key_num; insert_pos++){
-    tmp = CmpKey(file_header_.attr_type, file_header_.attr_length, pkey, node->keys + insert_pos * file_header_.key_length, file_header_.file_num, file_header_.total_attr_length);
+    tmp = CmpKey(file_header_, pkey, node->keys + insert_pos * file_header_.key_length);
     if (tmp == 0) {
       return RC::RECORD_DUPLICATE_KEY;
     }
@@ -555,7 +441,7 @@ RC BplusTreeHandler::insert_into_leaf_after_split(PageNum leaf_page, const char
   }
 
   for(insert_pos=0;insert_pos<leaf->key_num;insert_pos++){
-    tmp=CmpKey(file_header_.attr_type, file_header_.attr_length, pkey, leaf->keys+insert_pos*file_header_.key_length, file_header_.file_num, file_header_.total_attr_length);
+    tmp=CmpKey(file_header_, pkey, leaf->keys+insert_pos*file_header_.key_length);
     if(tmp<0)
       break;
   }
@@ -1052,7 +938,7 @@ RC BplusTreeHandler::get_entry(const char *pkey,RID *rid) {
 
   leaf = get_index_node(pdata);
   for(i=0;i<leaf->key_num;i++){
-    if(CmpKey(file_header_.attr_type, file_header_.attr_length,key,leaf->keys+(i*file_header_.key_length), file_header_.file_num, file_header_.total_attr_length)==0){
+    if(CmpKey(file_header_, key, leaf->keys+(i*file_header_.key_length))==0){
       memcpy(rid,leaf->rids+i,sizeof(RID));
       free(key);
       return SUCCESS;
@@ -1097,7 +983,7 @@ RC BplusTreeHandler::search_key(const char *pkey,RID *rid) {
 
   leaf = get_index_node(pdata);
   for(i=0;i<leaf->key_num;i++){
-    if(CompareKey(key,leaf->keys+(i*file_header_.key_length),file_header_.attr_type, file_header_.attr_length, file_header_.file_num)==0){
+    if(CompareKey(file_header_, key, leaf->keys+(i*file_header_.key_length))==0){
       memcpy(rid,leaf->rids+i,sizeof(RID));
       free(key);
       return SUCCESS;
@@ -1127,7 +1013,7 @@ RC BplusTreeHandler::delete_entry_from_node(PageNum node_page,const char *pkey)
   node = get_index_node(pdata);
 
   for(delete_index=0;delete_index<node->key_num;delete_index++){
-    tmp=CmpKey(file_header_.attr_type, file_header_.attr_length, pkey, node->keys+delete_index*file_header_.key_length, file_header_.file_num, file_header_.total_attr_length);
+    tmp=CmpKey(file_header_, pkey, node->keys+delete_index*file_header_.key_length);
     if(tmp==0)
       break;
   }
@@ -1748,7 +1634,7 @@ RC BplusTreeHandler::find_first_index_satisfied(CompOp compop, const char *key,
   RC rc;
   int i,tmp;
   RID rid;
-  if(compop == LESS_THAN || compop == LESS_EQUAL || compop == NOT_EQUAL || compop == IS || compop == IS_NOT){
+  if(compop == NO_OP || compop == LESS_THAN || compop == LESS_EQUAL || compop == NOT_EQUAL || compop == IS || compop == IS_NOT){
     rc = get_first_leaf_page(page_num);
     if(rc != SUCCESS){
       return rc;
@@ -1821,7 +1707,7 @@ RC BplusTreeHandler::find_first_index_satisfied(CompOp compop, const char *key,
       //   }
       //   continue;
       // }
-      tmp=CompareKey(node->keys+i*file_header_.key_length,key,file_header_.attr_type,file_header_.attr_length, file_header_.file_num);
+      tmp=CompareKey(file_header_, node->keys+i*file_header_.key_length, key);
       if(compop == EQUAL_TO ||compop == GREAT_EQUAL){
         if(tmp>=0){
           rc = disk_buffer_pool_->get_page_num(&page_handle, page_num);
@@ -1853,10 +1739,10 @@ RC BplusTreeHandler::find_first_index_satisfied(CompOp compop, const char *key,
 
     }
     next=node->rids[file_header_.order-1].page_num;
-  }
-  rc = disk_buffer_pool_->unpin_page(&page_handle);
-  if(rc != SUCCESS){
-    return rc;
+    rc = disk_buffer_pool_->unpin_page(&page_handle);
+    if(rc != SUCCESS){
+      return rc;
+    }
   }
   return RC::RECORD_EOF;
 }
@@ -1908,6 +1794,54 @@ RC BplusTreeHandler::get_first_leaf_page(PageNum *leaf_page) {
   return SUCCESS;
 }
 
+RC BplusTreeHandler::visit_entries(bool reverse, void *context, bool (*visitor)(const char *key, const RID *rid, void *context)) {
+  // 从根节点到当前节点的路径，记录每个内部节点已经访问过的子节点个数
+  std::vector<std::pair<PageNum, int>> path;
+  path.emplace_back(file_header_.root_page, 0);
+  while (!path.empty()) {
+    BPPageHandle page_handle;
+    RC rc = disk_buffer_pool_->get_this_page(file_id_, path.back().first, &page_handle);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    char *pdata;
+    rc = disk_buffer_pool_->get_data(&page_handle, &pdata);
+    if (rc != RC::SUCCESS) {
+      disk_buffer_pool_->unpin_page(&page_handle);
+      return rc;
+    }
+
+    IndexNode *node = get_index_node(pdata);
+    if (node->is_leaf) {
+      bool stopped = false;
+      for (int i = 0; i < node->key_num && !stopped; i++) {
+        const int index = reverse ? node->key_num - 1 - i : i;
+        stopped = !visitor(node->keys + index * file_header_.key_length, &node->rids[index], context);
+      }
+      disk_buffer_pool_->unpin_page(&page_handle);
+      if (stopped) {
+        return RC::SUCCESS;
+      }
+      path.pop_back();
+      continue;
+    }
+
+    // 内部节点有key_num + 1个子节点
+    int &visited = path.back().second;
+    if (visited > node->key_num) {
+      disk_buffer_pool_->unpin_page(&page_handle);
+      path.pop_back();
+      continue;
+    }
+    const int child = reverse ? node->key_num - visited : visited;
+    const PageNum child_page = node->rids[child].page_num;
+    visited++;
+    disk_buffer_pool_->unpin_page(&page_handle);
+    path.emplace_back(child_page, 0);
+  }
+  return RC::RECORD_EOF;
+}
+
 BplusTreeScanner::BplusTreeScanner(BplusTreeHandler &index_handler) : index_handler_(index_handler){
 }
 
@@ -1951,6 +1885,11 @@ RC BplusTreeScanner::close() {
   if (!opened_) {
     return RC::RECORD_SCANCLOSED;
   }
+  // 提前结束的扫描还固定着页面
+  for(int i = 0; i < pinned_page_count_; i++){
+    index_handler_.disk_buffer_pool_->unpin_page(page_handles_ + i);
+  }
+  pinned_page_count_ = 0;
   free((void *)value_);
   value_ = nullptr;
   opened_ = false;
@@ -2037,461 +1976,101 @@ RC BplusTreeScanner::get_next_idx_in_memory(RID *rid) {
 
     node = index_handler_.get_index_node(pdata);
     for( ; index_in_node_ < node->key_num; index_in_node_++){
-      if(satisfy_condition(node->keys + index_in_node_ * index_handler_.file_header_.key_length)){
+      const char *key = node->keys + index_in_node_ * index_handler_.file_header_.key_length;
+      if(satisfy_condition(key)){
         memcpy(rid,node->rids+index_in_node_,sizeof(RID));
         index_in_node_++;
         return SUCCESS;
       }
+      if(beyond_upper_bound(key)){
+        next_page_num_ = -1;
+        index_in_node_ = -1;
+        return RC::RECORD_EOF;
+      }
     }
 
     index_in_node_ = 0;
   }
   return RC::RECORD_NO_MORE_IDX_IN_MEM;
 }
-bool BplusTreeScanner::satisfy_condition(const char *pkey) {
-  int i1=0,i2=0;
-  float f1=0,f2=0;
-  const char *s1=nullptr,*s2=nullptr;
-  int is_null1=0, is_null2=0;
+bool BplusTreeScanner::beyond_upper_bound(const char *pkey) {
+  if(value_ == nullptr || (comp_op_ != EQUAL_TO && comp_op_ != LESS_THAN && comp_op_ != LESS_EQUAL)){
+    return false;
+  }
+  return CompareKey(index_handler_.file_header_, pkey, value_) > 0;
+}
 
+bool BplusTreeScanner::satisfy_condition(const char *pkey) {
   if(comp_op_ == NO_OP){
     return true;
   }
 
-  AttrType  *attr_type = index_handler_.file_header_.attr_type;
-  int * attr_length = index_handler_.file_header_.attr_length;
-  int file_num = index_handler_.file_header_.file_num;
-  std::string pdata_str = pkey;
-  std::string pkey_str = value_;
-  int len = 0;
-  bool flag=false;
-  for(int i= 0; i < file_num; i++) {
-    AttrType my_attr_type = attr_type[i];
-    int my_attr_length = attr_length[i];
-    std::string temp1 = pdata_str.substr(len,my_attr_length);
-    std::string temp2 = pkey_str.substr(len,my_attr_length);
-    const char *key = temp1.c_str();
-    const char *value = temp2.c_str();
-
-    switch(my_attr_type){
-    case INTS:
-      i1=*(int *)key;
-      i2=*(int *)value;
-      break;
-    case INTS_NULLABLE:
-      i1=*(int *)key;
-      is_null1 = *(int *)(key+4);
-      if (value==nullptr) {
-        i2=0;
-        is_null2 = 1;
-      } else {
-        i2=*(int *)value;
-        is_null2 = *(int *)(value+4);
-      }
-      break;
-    case FLOATS:
-      f1=*(float *)key;
-      f2=*(float *)value;
-      break;
-    case FLOATS_NULLABLE:
-      f1=*(float *)key;
-      // f2=*(float *)value_;
-      is_null1 = *(int *)(key+my_attr_length-4);
-      // is_null2 = *(int *)(value_+index_handler_.file_header_.attr_length-4);
-      if (value==nullptr) {
-        f2=0;
-        is_null2 = 1;
-      } else {
-        f2=*(float *)value;
-        is_null2 = *(int *)(value+my_attr_length-4);
-      }
-      break;
-    case TEXT:
-    case CHARS:
-      s1=key;
-      s2=value;
-      break;
-    case CHARS_NULLABLE:
-      s1=key;
-      // s2=value_;
-      is_null1 = *(int *)(key+my_attr_length-4);
-      // is_null2 = *(int *)value_+index_handler_.file_header_.attr_length-4;
-      if (value==nullptr) {
-        s2=0;
-        is_null2 = 1;
-      } else {
-        s2=value;
-        is_null2 = *(int *)(value+my_attr_length-4);
-      }
-      break;
-    case DATES:
-      i1=*(int *)key;
-      i2=*(int *)value;
-      break;
-    case DATES_NULLABLE:
-      i1=*(int *)key;
-      // i2=*(int *)value_;
-      is_null1 = *(int *)(key+my_attr_length-4);
-      // is_null2 = *(int *)value_+index_handler_.file_header_.attr_length-4;
-      if (value==nullptr) {
-        i2=0;
-        is_null2 = 1;
-      } else {
-        i2=*(int *)value;
-        is_null2 = *(int *)(value+my_attr_length-4);
+  const IndexFileHeader &file_header = index_handler_.file_header_;
+  const bool has_null_bitmap = file_header.null_mask != 0;
+  int offset = has_null_bitmap ? NULL_BITMAP_SIZE : 0;
+  bool flag = false;
+  for(int i= 0; i < file_header.file_num; i++) {
+    const int attr_length = file_header.attr_length[i];
+    const char *key = pkey + offset;
+    const char *value = value_ == nullptr ? nullptr : value_ + offset;
+    offset += attr_length;
+
+    // 键和查找值的null都记录在各自头部的null位图中，没有查找值时当做null
+    const bool is_null1 = has_null_bitmap && null_bitmap_test(pkey, i);
+    const bool is_null2 = value == nullptr || (has_null_bitmap && null_bitmap_test(value_, i));
+    if (comp_op_ == IS) {
+      //多个值的is和is-not判断还需要考虑 mjy
+      flag = is_null1 && is_null2;
+      continue;
+    }
+    if (comp_op_ == IS_NOT) {
+      flag = !is_null1 && is_null2;
+      continue;
+    }
+    if (is_null1 || is_null2) {
+      // 和null的比较都不成立
+      if (comp_op_ == NOT_EQUAL) {
+        flag = false;
+        continue;
       }
-      break;
-    default:
-      LOG_PANIC("Unknown attr type: %d", my_attr_type);
+      return false;
     }
 
-    bool equal;
+    int cmp = compare_attr(file_header.attr_type[i], attr_length, key, value);
     switch(comp_op_){
       case EQUAL_TO:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1==i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1==i2);
-          break;
-          case FLOATS:
-            flag= 0 == float_compare(f1, f2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag= 0 == float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES:
-            flag=(i1==i2);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1==i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
+        flag = (cmp == 0);
         if(flag == false)
           return flag;
         break;
       case LESS_THAN:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1<i2);
-            equal=(i1==i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1<i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS:
-            flag=(f1<f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(f1<f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)<0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)<0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES:
-            flag=(i1<i2);
-            equal=(i1==i2);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1<i2);
-            equal=(i1==i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
-        if(equal == false)
+        flag = (cmp < 0);
+        if(cmp != 0)
           return flag;
         break;
       case GREAT_THAN:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1>i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS:
-            flag=(f1>f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)>0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES:
-            flag=(i1>i2);
-            equal=(i1==i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1>i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(f1>f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)>0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1>i2);
-            equal=(i1==i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
-        if(equal == false)
+        flag = (cmp > 0);
+        if(cmp != 0)
           return flag;
         break;
       case LESS_EQUAL:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1<=i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS:
-            flag=(f1<=f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)<=0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES:
-            flag=(i1<=i2);
-            equal=(i1==i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1<=i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(f1<=f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)<=0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1<=i2);
-            equal=(i1==i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
-        if(equal == false)
+        flag = (cmp <= 0);
+        if(cmp != 0)
           return flag;
         break;
       case GREAT_EQUAL:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1>=i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS:
-            flag=(f1>=f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)>=0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES:
-            flag=(i1>=i2);
-            equal=(i1==i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1>=i2);
-            equal=(i1==i2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(f1>=f2);
-            equal= 0 == float_compare(f1, f2);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)>=0);
-            equal=(strncmp(s1,s2,my_attr_length)==0);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1>=i2);
-            equal=(i1==i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
-        if(equal == false)
+        flag = (cmp >= 0);
+        if(cmp != 0)
           return flag;
         break;
       case NOT_EQUAL:
-        switch(my_attr_type){
-          case INTS:
-            flag=(i1!=i2);
-            break;
-          case FLOATS:
-            flag= 0 != float_compare(f1, f2);
-            break;
-          case TEXT:
-          case CHARS:
-            flag=(strncmp(s1,s2,my_attr_length)!=0);
-            break;
-          case DATES:
-            flag=(i1!=i2);
-            break;
-          case INTS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1!=i2);
-            break;
-          case FLOATS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag= 0 != float_compare(f1, f2);
-            break;
-          case CHARS_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(strncmp(s1,s2,my_attr_length)!=0);
-            break;
-          case DATES_NULLABLE:
-            if (is_null1 == 1 || is_null2 == 1) {
-              flag = false;
-              break;
-            }
-            flag=(i1!=i2);
-            break;
-          default:
-            LOG_PANIC("Unknown attr type: %d", attr_type);
-        }
+        flag = (cmp != 0);
         if(flag == true)
           return flag;
         break;
-      case IS:
-        //多个值的is和is-not判断还需要考虑 mjy
-        if (is_null1 == 1 && is_null2 == 1) {
-          flag = true;
-          break;
-        }
-        flag = false;
-        break;
-      case IS_NOT:
-        if (is_null1 == 0 && is_null2 == 1) {
-          flag = true;
-          break;
-        }
-        flag = false;
-        break;
       default:
         LOG_PANIC("Unknown comp op: %d", comp_op_);
     }
-    
   }
   return flag;
 }
@@ -28,6 +28,7 @@ struct IndexFileHeader {
   int order;
   int total_attr_length;
   int file_num;
+  int null_mask;     // 可为null的键字段，第i位对应第i个字段。不为0时键的头部有一个null位图
 };
 
 struct IndexNode {
@@ -98,6 +99,13 @@ public:
    */
   RC search_key(const char *pkey, RID *rid);
 
+  /**
+   * 按键的顺序访问所有索引项，reverse为true时从最大的键开始。visitor返回false时停止。
+   * 叶子节点只有指向后面的指针，这里从根节点开始深度优先遍历，两个方向都只访问需要的页面
+   * @return visitor停止时返回SUCCESS，访问完所有的索引项时返回RECORD_EOF
+   */
+  RC visit_entries(bool reverse, void *context, bool (*visitor)(const char *key, const RID *rid, void *context));
+
   RC sync();
 public:
   RC print();
@@ -164,6 +172,10 @@ private:
   RC get_next_idx_in_memory(RID *rid);
   RC find_idx_pages();
   bool satisfy_condition(const char *key);
+  /**
+   * 键已经大于等值、小于类条件的比较值。叶子节点中的键有序，后面的键都不会再满足条件
+   */
+  bool beyond_upper_bound(const char *key);
 
 private:
   BplusTreeHandler   & index_handler_;
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/common/bplus_tree_index.h"
+#include "storage/common/null_bitmap.h"
 #include "common/log/log.h"
 
 BplusTreeIndex::~BplusTreeIndex() noexcept {
@@ -66,75 +67,87 @@ RC BplusTreeIndex::close() {
   return RC::SUCCESS;
 }
 
-RC BplusTreeIndex::insert_entry(const char *record, const RID *rid) {
-  std::string key_str = "";
-  int field_num = index_meta_.file_num();
-  const char *keys[field_num];
+char *BplusTreeIndex::make_key(const char *record, bool &has_null) const {
+  // 键的布局与BplusTreeHandler::create中一致：有可为null的字段时，头部是null位图，后面依次是各个字段的值
+  const int field_num = index_meta_.file_num();
+  bool with_null_bitmap = false;
   int total_len = 0;
-  for(int i =0; i < field_num; i++) {
+  for (int i = 0; i < field_num; i++) {
     total_len += field_meta_[i].len();
-    keys[i] = record + field_meta_[i].offset();
-    // key_str += (record + field_meta_[i].offset());
-  }
-  char * key = new char[total_len];
-  size_t offset = 0;
-  for (int i=0; i<field_num; i++) {
-    memcpy(key + offset, keys[i], field_meta_[i].len());
-    offset += field_meta_[i].len();
-  }
-  //const char * key = key_str.c_str();
-  
-  if(unique_) {
-    RID * search_rid = new RID[1];
-    RC rc = index_handler_.search_key(key, search_rid);
-    delete [] search_rid;
-    if(rc == RC::SUCCESS)
+    if (field_meta_[i].nullable()) {
+      with_null_bitmap = true;
+    }
+  }
+  if (with_null_bitmap) {
+    total_len += NULL_BITMAP_SIZE;
+  }
+
+  char *key = new char[total_len];
+  memset(key, 0, total_len);
+  has_null = false;
+  int offset = with_null_bitmap ? NULL_BITMAP_SIZE : 0;
+  for (int i = 0; i < field_num; i++) {
+    const FieldMeta &field = field_meta_[i];
+    if (field.is_null(record)) {
+      null_bitmap_set(key, i, true);
+      has_null = true;
+    } else {
+      memcpy(key + offset, record + field.offset(), field.len());
+    }
+    offset += field.len();
+  }
+  return key;
+}
+
+RC BplusTreeIndex::insert_entry(const char *record, const RID *rid) {
+  bool has_null = false;
+  char *key = make_key(record, has_null);
+
+  // null与任何值都不相等，包含null的键不做唯一性检查
+  if(unique_ && !has_null) {
+    RID search_rid;
+    RC rc = index_handler_.search_key(key, &search_rid);
+    if(rc == RC::SUCCESS) {
+      delete[] key;
       return RC::INVALID_ARGUMENT;
+    }
   }
 
-  return index_handler_.insert_entry(key, rid);
+  RC rc = index_handler_.insert_entry(key, rid);
+  delete[] key;
+  return rc;
 }
 
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid) {
-  std::string key_str = "";
-  int field_num = index_meta_.file_num();
-  const char *keys[field_num];
-  int total_len = 0;
-  for(int i =0; i < field_num; i++) {
-    total_len += field_meta_[i].len();
-    keys[i] = record + field_meta_[i].offset();
-    //key_str += (record + field_meta_[i].offset());
-  }
-  char * key = new char[total_len];
-  size_t offset = 0;
-  for (int i=0; i<field_num; i++) {
-    memcpy(key + offset, keys[i], field_meta_[i].len());
-    offset += field_meta_[i].len();
-  }
-  //const char * key = key_str.c_str();
-
-  return index_handler_.delete_entry(key, rid);
+  bool has_null = false;
+  char *key = make_key(record, has_null);
+  RC rc = index_handler_.delete_entry(key, rid);
+  delete[] key;
+  return rc;
 }
 
-RC BplusTreeIndex::update_entry(const char *record, const RID *rid) {
-  std::string key_str = "";
-  int field_num = index_meta_.file_num();
-  const char *keys[field_num];
-  int total_len = 0;
-  for(int i =0; i < field_num; i++) {
-    total_len += field_meta_[i].len();
-    keys[i] = record + field_meta_[i].offset();
-    //key_str += (record + field_meta_[i].offset());
+RC BplusTreeIndex::update_entry(const char *old_record, const char *new_record, const RID *rid) {
+  bool changed = false;
+  for (int i = 0; i < index_meta_.file_num() && !changed; i++) {
+    const FieldMeta &field = field_meta_[i];
+    const bool old_null = field.is_null(old_record);
+    changed = old_null != field.is_null(new_record) ||
+              (!old_null && 0 != memcmp(old_record + field.offset(), new_record + field.offset(), field.len()));
   }
-  char * key = new char[total_len];
-  size_t offset = 0;
-  for (int i=0; i<field_num; i++) {
-    memcpy(key + offset, keys[i], field_meta_[i].len());
-    offset += field_meta_[i].len();
+  if (!changed) {
+    return RC::SUCCESS;
   }
-  //const char * key = key_str.c_str();
 
-  return index_handler_.insert_entry(key, rid);
+  // 旧的索引项可能不存在，比如记录是在之前没有正确维护索引时更新的
+  RC rc = delete_entry(old_record, rid);
+  if (rc != RC::SUCCESS && rc != RC::RECORD_INVALID_KEY) {
+    return rc;
+  }
+  rc = insert_entry(new_record, rid);
+  if (rc != RC::SUCCESS) {
+    insert_entry(old_record, rid);
+  }
+  return rc;
 }
 
 IndexScanner *BplusTreeIndex::create_scanner(CompOp comp_op, const char *value) {
@@ -150,6 +163,10 @@ IndexScanner *BplusTreeIndex::create_scanner(CompOp comp_op, const char *value)
   return index_scanner;
 }
 
+RC BplusTreeIndex::visit_entries(bool reverse, void *context, bool (*visitor)(const char *key, const RID *rid, void *context)) {
+  return index_handler_.visit_entries(reverse, context, visitor);
+}
+
 RC BplusTreeIndex::sync() {
   return index_handler_.sync();
 }
@@ -29,12 +29,19 @@ public:
 
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
-  RC update_entry(const char *record, const RID *rid) override;
+  RC update_entry(const char *old_record, const char *new_record, const RID *rid) override;
 
   IndexScanner *create_scanner(CompOp comp_op, const char *value) override;
+  RC visit_entries(bool reverse, void *context, bool (*visitor)(const char *key, const RID *rid, void *context)) override;
 
   RC sync() override;
 
+private:
+  /**
+   * 从记录中构造索引键，调用方负责delete[]。has_null表示键中是否有null字段
+   */
+  char *make_key(const char *record, bool &has_null) const;
+
 private:
   bool inited_ = false;
   BplusTreeHandler index_handler_;
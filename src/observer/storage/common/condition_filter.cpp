@@ -18,12 +18,19 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "storage/common/table.h"
 #include "storage/common/mydate.h"
+#include "storage/common/dictionary.h"
+#include "storage/common/null_bitmap.h"
 
 using namespace common;
 
 ConditionFilter::~ConditionFilter()
 {}
 
+bool ConditionFilter::filter_columns(const RecordPageHandler &page, int *selected, int *num) const
+{
+  return false;
+}
+
 DefaultConditionFilter::DefaultConditionFilter()
 {
   left_.is_attr = false;
@@ -55,8 +62,7 @@ RC DefaultConditionFilter::init(const ConDesc &left, const ConDesc &right, AttrT
   right_ = right;
   attr_type_ = attr_type;
   comp_op_ = comp_op;
-  tuple_set_ = tuple_set;
-  tuple_set_left_ = tuple_set_left;
+  init_subquery(tuple_set, tuple_set_left);
   return RC::SUCCESS;
 }
 
@@ -68,6 +74,8 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
 
   AttrType type_left = UNDEFINED;
   AttrType type_right = UNDEFINED;
+  const Dictionary *left_dict = nullptr;
+  const Dictionary *right_dict = nullptr;
 
   if (1 == condition.left_is_attr) {
     left.is_attr = true;
@@ -78,6 +86,9 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
     }
     left.attr_length = field_left->len();
     left.attr_offset = field_left->offset();
+    left.null_offset = field_left->null_offset();
+    left.null_bit = field_left->null_bit();
+    left_dict = field_left->dict();
 
     left.value = nullptr;
 
@@ -101,6 +112,9 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
     }
     right.attr_length = field_right->len();
     right.attr_offset = field_right->offset();
+    right.null_offset = field_right->null_offset();
+    right.null_bit = field_right->null_bit();
+    right_dict = field_right->dict();
     type_right = field_right->type();
     right.type = type_right;
     right.value = nullptr;
@@ -133,57 +147,31 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
   if (condition.is_select) {
     TupleSet *tuple_set = (TupleSet *)condition.tuple_set_;
     TupleSet *tuple_set_left = (TupleSet *)condition.tuple_set_left_;
-    if (tuple_set->size() == 0 || (tuple_set_left_ != nullptr && tuple_set_left->size() == 0)) {
-      return init(left, right, type_left, condition.comp, (TupleSet *)condition.tuple_set_, (TupleSet *)condition.tuple_set_left_);
+    if (tuple_set->size() == 0 || (tuple_set_left != nullptr && tuple_set_left->size() == 0)) {
+      RC rc = init(left, right, type_left, condition.comp, tuple_set, tuple_set_left);
+      if (rc == RC::SUCCESS) {
+        init_dict(left_dict, right_dict, tuple_set);
+      }
+      return rc;
     }
-    if (tuple_set_left_ != nullptr) {
-      type_left = tuple_set_left_->get(0).get(0).type();
+    if (tuple_set_left != nullptr) {
+      type_left = tuple_set_left->get(0).get(0).type();
     }
     type_right = tuple_set->get(0).get(0).type();
-    if (type_left == CHARS) {
+    if (type_left == CHARS || type_left == DATES) {
       if (type_right != CHARS && type_right != IS_NULL) {
         return RC::SCHEMA_FIELD_TYPE_MISMATCH;
       }
-    } else if (type_left == CHARS_NULLABLE) {
-      if (type_right != CHARS && type_right != IS_NULL && type_right != NOT_NULL) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-    } else if (type_left == INTS) {
+    } else if (type_left == INTS || type_left == FLOATS) {
       if (type_right != INTS && type_right != IS_NULL && type_right != FLOATS) {
         return RC::SCHEMA_FIELD_TYPE_MISMATCH;
       }
-    } else if (type_left == INTS_NULLABLE) {
-      if (type_right != INTS && type_right != IS_NULL && type_right != NOT_NULL && type_right != FLOATS) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-    } else if (type_left == FLOATS) {
-      if (type_right != FLOATS && type_right != IS_NULL && type_right != INTS) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-    } else if (type_left == FLOATS_NULLABLE) {
-      if (type_right != INTS && type_right != IS_NULL && type_right != NOT_NULL && type_right != INTS) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-    } else if (type_left == DATES) {
-      if (type_right != CHARS && type_right != IS_NULL) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      MyDate date((char *)right.value);
-      if (date.toInt() == -1) {
-        return RC::GENERIC_ERROR;
-      }
-    } else if (type_left == DATES_NULLABLE) {
-      if (type_right != CHARS && type_right != IS_NULL && type_right != NOT_NULL) {
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      if (type_right == CHARS) {
-        MyDate date((char *)right.value);
-        if (date.toInt() == -1) {
-          return RC::GENERIC_ERROR;
-        }
-      }
     }
-    return init(left, right, type_left, condition.comp, (TupleSet *)condition.tuple_set_, (TupleSet *)condition.tuple_set_left_);
+    RC rc = init(left, right, type_left, condition.comp, tuple_set, tuple_set_left);
+    if (rc == RC::SUCCESS) {
+      init_dict(left_dict, right_dict, tuple_set);
+    }
+    return rc;
   }
 
 
@@ -192,38 +180,18 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
     if (type_right != CHARS && type_right != IS_NULL) {
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-  } else if (type_left == CHARS_NULLABLE) {
-    if (type_right != CHARS && type_right != IS_NULL && type_right != NOT_NULL) {
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
   } else if (type_left == INTS) {
     if (type_right != INTS && type_right != IS_NULL) {
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-  } else if (type_left == INTS_NULLABLE) {
-    if (type_right != INTS && type_right != IS_NULL && type_right != NOT_NULL) {
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
   } else if (type_left == FLOATS) {
     if (type_right != FLOATS && type_right != IS_NULL) {
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-  } else if (type_left == FLOATS_NULLABLE) {
-    if (type_right != INTS && type_right != IS_NULL && type_right != NOT_NULL) {
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
   } else if (type_left == DATES) {
     if (type_right != CHARS && type_right != IS_NULL) {
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    MyDate date((char *)right.value);
-    if (date.toInt() == -1) {
-       return RC::GENERIC_ERROR;
-    }
-  } else if (type_left == DATES_NULLABLE) {
-    if (type_right != CHARS && type_right != IS_NULL && type_right != NOT_NULL) {
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
     if (type_right == CHARS) {
       MyDate date((char *)right.value);
       if (date.toInt() == -1) {
@@ -232,8 +200,146 @@ RC DefaultConditionFilter::init(Table &table, const Condition &condition)
     }
   }
 
+  RC rc = init(left, right, type_left, condition.comp, nullptr, nullptr);
+  if (rc == RC::SUCCESS) {
+    init_dict(left_dict, right_dict, nullptr);
+    init_kernel();
+  }
+  return rc;
+}
+
+void DefaultConditionFilter::init_dict(const Dictionary *left_dict, const Dictionary *right_dict,
+                                       const TupleSet *tuple_set)
+{
+  left_dict_ = left_dict;
+  right_dict_ = right_dict;
+  if (left_dict_ == nullptr || right_.is_attr || subquery_left_) {
+    return;
+  }
 
-  return init(left, right, type_left, condition.comp, nullptr, nullptr);
+  if (!subquery_) {
+    if ((comp_op_ == EQUAL_TO || comp_op_ == NOT_EQUAL) && right_.type == CHARS && right_.value != nullptr) {
+      // 不在字典中的字符串得到INVALID_CODE，不会和任何记录相等
+      dict_code_ = left_dict_->code((const char *)right_.value);
+      dict_fast_path_ = true;
+    }
+    return;
+  }
+
+  if (comp_op_ == IN || comp_op_ == NOT_IN) {
+    // 子查询的结果集转换成编码集合，每条记录只需要查一次哈希表
+    for (int i = 0; i < tuple_set->size(); i++) {
+      const TupleValue &tuple_value = tuple_set->get(i).get(0);
+      if (tuple_value.type() == IS_NULL) {
+        dict_codes_has_null_ = true;
+        continue;
+      }
+      int code = left_dict_->code(tuple_value.to_string().c_str());
+      if (code != Dictionary::INVALID_CODE) {
+        dict_codes_.insert(code);
+      }
+    }
+    dict_fast_path_ = true;
+  }
+}
+
+void DefaultConditionFilter::init_kernel()
+{
+  if (!left_.is_attr || right_.is_attr || subquery_ || subquery_left_ || right_.value == nullptr) {
+    return;
+  }
+  if (dict_fast_path_) {
+    kernel_.compile(INTS, sizeof(int), comp_op_, &dict_code_);
+  } else if (left_dict_ == nullptr) {
+    kernel_.compile(attr_type_, left_.attr_length, comp_op_, right_.value);
+  }
+}
+
+static int compare_float(float left, float right)
+{
+  if (left < right) {
+    return -1;
+  }
+  if (left > right) {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * 子查询结果中的数值转换成与字段比较的值。int字段按double比较，超过float精度的整数也不会被当成相等；
+ * float字段与记录中的值一样按float的精度比较
+ */
+static double subquery_number(AttrType attr_type, const TupleValue &tuple_value)
+{
+  std::string value_str = tuple_value.to_string();
+  if (attr_type == DATES) {
+    char date_str[16] = {0};
+    strncpy(date_str, value_str.c_str(), sizeof(date_str) - 1);
+    MyDate date(date_str);
+    return date.toInt();
+  }
+  if (attr_type == FLOATS) {
+    return std::stof(value_str);
+  }
+  if (tuple_value.type() == INTS) {
+    return tuple_value.int_value();
+  }
+  return std::stod(value_str);
+}
+
+/**
+ * 记录中的数值，与subquery_number的结果比较
+ */
+static double record_number(AttrType attr_type, const char *value)
+{
+  switch (attr_type) {
+    case DATES:
+      return *(int *)value;
+    case INTS:
+      return *(int *)value;
+    case FLOATS:
+      return *(float *)value;
+    default:
+      LOG_PANIC("Unsupported attr type in sub query. type=%d", attr_type);
+      return 0;
+  }
+}
+
+void DefaultConditionFilter::init_subquery(const TupleSet *tuple_set, const TupleSet *tuple_set_left)
+{
+  subquery_ = tuple_set != nullptr;
+  subquery_left_ = tuple_set_left != nullptr;
+  if (!subquery_) {
+    return;
+  }
+  subquery_empty_ = tuple_set->size() == 0;
+  if (subquery_empty_) {
+    return;
+  }
+  subquery_first_null_ = tuple_set->get(0).get(0).type() == IS_NULL;
+  if (subquery_left_ || subquery_first_null_) {
+    return; // 过滤时直接返回false，不需要转换
+  }
+
+  if (comp_op_ != IN && comp_op_ != NOT_IN) {
+    if (attr_type_ == CHARS) {
+      subquery_string_ = tuple_set->get(0).get(0).to_string();
+    } else {
+      subquery_number_ = subquery_number(attr_type_, tuple_set->get(0).get(0));
+    }
+    return;
+  }
+  for (int i = 0; i < tuple_set->size(); i++) {
+    const TupleValue &tuple_value = tuple_set->get(i).get(0);
+    if (tuple_value.type() == IS_NULL) {
+      subquery_has_null_ = true;
+    } else if (attr_type_ == CHARS) {
+      subquery_strings_.insert(tuple_value.to_string());
+    } else {
+      subquery_numbers_.insert(subquery_number(attr_type_, tuple_value));
+    }
+  }
 }
 
 bool DefaultConditionFilter::filter(const Record &rec) const
@@ -247,496 +353,104 @@ bool DefaultConditionFilter::filter(const Record &rec) const
     left_value = (char *)left_.value;
   }
 
-  if (right_.is_attr && tuple_set_ != nullptr) {
+  if (right_.is_attr && subquery_) {
     right_value = (char *)(rec.data + right_.attr_offset);
   } else {
     right_value = (char *)right_.value;
   }
 
-  int cmp_result = 0;
-  switch (attr_type_) {
-    case CHARS: {  // 字符串都是定长的，直接比较
-      // 按照C字符串风格来定
-      if (right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
-        int left = *(int *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            // float right = std::stof(value_str);
-            // float re = left - right;
-            int re = strcmp(left_value, value_str.c_str());
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            int re = strcmp(left_value, value_str.c_str());
-            if (re == 0) {
-              return true;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
-        cmp_result = strcmp(left_value, right_value);
+  // 记录中的null只需要检查null位图中的一位，常量null的value为nullptr。子查询的null在比较时处理
+  const bool left_null = left_.is_attr ? null_bitmap_test(rec.data + left_.null_offset, left_.null_bit)
+                                       : left_value == nullptr;
+  const bool right_null = right_.is_attr ? (subquery_ && null_bitmap_test(rec.data + right_.null_offset, right_.null_bit))
+                                         : (!subquery_ && right_value == nullptr);
+  if (left_null || right_null) {
+    switch (comp_op_) {
+      case IS:
+        return left_null && right_null;
+      case IS_NOT:
+        return !left_null && right_null;
+      default:
+        return false; // 和null的比较都不成立
+    }
+  }
+  if (comp_op_ == IS || comp_op_ == IS_NOT) {
+    return false;
+  }
+
+  if (dict_fast_path_) {
+    int code = *(int *)left_value;
+    switch (comp_op_) {
+      case EQUAL_TO:
+        return code == dict_code_;
+      case NOT_EQUAL:
+        return code != dict_code_;
+      case IN:
+        return dict_codes_.count(code) > 0;
+      case NOT_IN:
+        // 结果集中有NULL时，NOT IN的结果不可能为真
+        return !dict_codes_has_null_ && dict_codes_.count(code) == 0;
+      default:
         break;
+    }
+  }
+  if (left_.is_attr && left_dict_ != nullptr) {
+    left_value = (char *)left_dict_->value(*(int *)left_value);
+  }
+  if (right_.is_attr && subquery_ && right_dict_ != nullptr) {
+    right_value = (char *)right_dict_->value(*(int *)right_value);
+  }
+
+  int cmp_result = 0;
+  if (subquery_) {
+    if (subquery_empty_) {
+      return comp_op_ == NOT_IN;
+    }
+    if (subquery_left_ || subquery_first_null_) {
+      return false;
+    }
+    if (comp_op_ == IN || comp_op_ == NOT_IN) {
+      const bool found = attr_type_ == CHARS ? subquery_strings_.count(left_value) > 0
+                                             : subquery_numbers_.count(record_number(attr_type_, left_value)) > 0;
+      if (found) {
+        return comp_op_ == IN;
       }
-      cmp_result = strcmp(left_value, right_value);
-    } break;
-    case CHARS_NULLABLE: {  // 字符串都是定长的，直接比较
-      // 按照C字符串风格来定
-      int is_null = *(int *)(rec.data + left_.attr_offset + left_.attr_length);
-      if (is_null) {
-        if (comp_op_ == IS && (right_value == nullptr || left_value == nullptr)) {
-          return true;
-        }
-        return false;
-      }
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
-        int left = *(int *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            // float right = std::stof(value_str);
-            // float re = left - right;
-            int re = strcmp(left_value, value_str.c_str());
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            int re = strcmp(left_value, value_str.c_str());
-            if (re == 0) {
-              return true;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
+      // 结果集中有NULL时，NOT IN的结果不可能为真
+      return comp_op_ == NOT_IN && !subquery_has_null_;
+    }
+    if (attr_type_ == CHARS) {
+      cmp_result = strcmp(left_value, subquery_string_.c_str());
+    } else {
+      const double left = record_number(attr_type_, left_value);
+      cmp_result = left < subquery_number_ ? -1 : (left > subquery_number_ ? 1 : 0);
+    }
+  } else {
+    switch (attr_type_) {
+      case CHARS: {  // 字符串都是定长的，直接比较
+        // 按照C字符串风格来定
         cmp_result = strcmp(left_value, right_value);
-        break;
-      }
-      if (left_value == nullptr || right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      cmp_result = strcmp(left_value, right_value);
-    } break;
-    case DATES: { 
-      // Xing 待修改
-      // cmp_result = strcmp(left_value, right_value);
-      // 没有考虑大小端问题
-      // 对int和float，要考虑字节对齐问题,有些平台下直接转换可能会跪
-      if (right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      int left = *(int *)left_value;
-      MyDate date(right_value);
-      int right = date.toInt();
-      cmp_result = left - right;
-    } break;
-    case DATES_NULLABLE: {
-      int is_null = *(int *)(rec.data + left_.attr_offset + left_.attr_length);
-      if (is_null) {
-        if (comp_op_ == IS && (right_value == nullptr || left_value == nullptr)) {
-          return true;
-        }
-        return false;
-      }
-      if (left_value == nullptr || right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      int left = *(int *)left_value;
-      MyDate date(right_value);
-      int right = date.toInt();
-      cmp_result = left - right;
-    } break;
-    case INTS: {
-      // 没有考虑大小端问题
-      // 对int和float，要考虑字节对齐问题,有些平台下直接转换可能会跪
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
+      } break;
+      case DATES: {
+        // 没有考虑大小端问题
         int left = *(int *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return false;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
-        float right = std::stof(value_str);
-        float re = left - right;
-        if (re > 0) {
-          cmp_result = 1;
-        } else if (re == 0) {
-          cmp_result = 0;
-        } else {
-          cmp_result = -1;
-        }
-        break;
-      }
-      if (right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      
-      int left = *(int *)left_value;
-      int right = *(int *)right_value;
-      cmp_result = left - right;
-    } break;
-    case INTS_NULLABLE: {
-      // 没有考虑大小端问题
-      // 对int和float，要考虑字节对齐问题,有些平台下直接转换可能会跪
-      int is_null = *(int *)(rec.data + left_.attr_offset + left_.attr_length);
-      if (is_null) {
-        if (comp_op_ == IS && (right_value == nullptr || left_value == nullptr)) {
-          return true;
-        }
-        return false;
-      }
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
+        MyDate date(right_value);
+        int right = date.toInt();
+        cmp_result = left < right ? -1 : (left > right ? 1 : 0);
+      } break;
+      case INTS: {
+        // 没有考虑大小端问题
+        // 对int和float，要考虑字节对齐问题,有些平台下直接转换可能会跪
         int left = *(int *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return false;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
-        float right = std::stof(value_str);
-        float re = left - right;
-        if (re > 0) {
-          cmp_result = 1;
-        } else if (re == 0) {
-          cmp_result = 0;
-        } else {
-          cmp_result = -1;
-        }
-        break;
-      }
-      if (left_value == nullptr || right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      
-      int left = *(int *)left_value;
-      int right = *(int *)right_value;
-      cmp_result = left - right;
-    } break;
-    case FLOATS: {
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
-        float left = *(float *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return false;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
-        float right = std::stof(value_str);
-        float re = left - right;
-        if (re > 0) {
-          cmp_result = 1;
-        } else if (re == 0) {
-          cmp_result = 0;
-        } else {
-          cmp_result = -1;
-        }
-        break;
-      }
-      if (right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
-      }
-      
-      float left = *(float *)left_value;
-      float right = *(float *)right_value;
-      float ans = left - right;
-      if(ans < 0)
-        cmp_result = -1;
-      else if(ans > 0)
-        cmp_result = 1;
-      else
-        cmp_result = 0;
-      //cmp_result = (int)(left - right);
-    } break;
-    case FLOATS_NULLABLE: {
-      if (tuple_set_ != nullptr) {
-        if (tuple_set_->size() == 0) {
-          if (comp_op_ == NOT_IN) {
-            return true;
-          }
-          return false;
-        }
-        if (tuple_set_left_ != nullptr) {
-          return false;
-        }
+        int right = *(int *)right_value;
+        cmp_result = left < right ? -1 : (left > right ? 1 : 0);
+      } break;
+      case FLOATS: {
         float left = *(float *)left_value;
-        // int right = *(int *)right_value;
-        const TupleValue &tuple_value = tuple_set_->get(0).get(0);
-        AttrType right_type = tuple_value.type();
-        if (right_type == IS_NULL) {
-          switch (comp_op_) {
-            case IN:
-              return false;
-            case NOT_IN:
-              return false;
-            default:
-              return false;
-          }
-        }
-        if (comp_op_ == IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return true;
-            }
-          }
-          return false;
-        } else if (comp_op_ == NOT_IN) {
-          for (int i=0; i<tuple_set_->size(); i++) {
-            const Tuple &tuple = tuple_set_->get(i);
-            std::string value_str = tuple.get(0).to_string();
-            float right = std::stof(value_str);
-            float re = left - right;
-            if (re == 0) {
-              return false;
-            }
-          }
-          return true;
-        }
-        std::string value_str = tuple_value.to_string();
-        float right = std::stof(value_str);
-        float re = left - right;
-        if (re > 0) {
-          cmp_result = 1;
-        } else if (re == 0) {
-          cmp_result = 0;
-        } else {
-          cmp_result = -1;
-        }
-        break;
-      }
-      int is_null = *(int *)(rec.data + left_.attr_offset + left_.attr_length);
-      if (is_null) {
-        if (comp_op_ == IS && (right_value == nullptr || left_value == nullptr)) {
-          return true;
-        }
-        return false;
-      }
-      if (left_value == nullptr || right_value == nullptr) {
-        if (comp_op_ == IS_NOT) {
-          return true;
-        }
-        return false;
+        float right = *(float *)right_value;
+        cmp_result = compare_float(left, right);
+      } break;
+      default: {
       }
-      
-      float left = *(float *)left_value;
-      float right = *(float *)right_value;
-      cmp_result = (int)(left - right);
-    } break;
-    case IS_NULL: {
-      if (comp_op_ == IS && right_value == nullptr) {
-        return true;
-      } else if (comp_op_ == IS_NOT && right_value != nullptr) {
-        return true;
-      }
-      return false;
-    } break;
-    default: {
     }
   }
 
@@ -762,21 +476,64 @@ bool DefaultConditionFilter::filter(const Record &rec) const
   return cmp_result;  // should not go here
 }
 
-bool DefaultConditionFilter::filter(const TupleSchema &schema_, const Tuple &tuple) const
+bool DefaultConditionFilter::filter_columns(const RecordPageHandler &page, int *selected, int *num) const
 {
-  std::shared_ptr<TupleValue> left_value = nullptr;
-  std::shared_ptr<TupleValue> right_value = nullptr;
+  // 只处理属性和常量的比较，子查询等其它条件交给filter(Record)逐条处理
+  if (!left_.is_attr || right_.is_attr || subquery_ || subquery_left_) {
+    return false;
+  }
 
+  ColumnData column;
+  ColumnData null_column;
+  column.data = page.column_data(left_.attr_offset, &column.stride);
+  if (left_.null_bit >= 0) {
+    null_column.data = page.column_data(left_.null_offset, &null_column.stride);
+  }
+  if (column.data == nullptr || (left_.null_bit >= 0 && null_column.data == nullptr)) {
+    return false;
+  }
+
+  if (comp_op_ == IS || comp_op_ == IS_NOT) {
+    if (right_.value != nullptr) {
+      *num = 0; // 和非null的值做IS判断都不成立
+    } else if (null_column.data == nullptr) {
+      *num = comp_op_ == IS ? 0 : *num;
+    } else {
+      *num = select_null(null_column, left_.null_bit, comp_op_ == IS, selected, *num, selected);
+    }
+    return true;
+  }
+
+  if (comp_op_ < EQUAL_TO || comp_op_ > GREAT_THAN) {
+    return false;
+  }
+  if (right_.value == nullptr) {
+    *num = 0; // 和null的比较都不成立
+    return true;
+  }
+  if (!kernel_.compiled()) {
+    return false;
+  }
+
+  if (null_column.data != nullptr) {
+    *num = select_null(null_column, left_.null_bit, false, selected, *num, selected);
+  }
+  *num = kernel_.select(column, selected, *num, selected);
+  return true;
+}
+
+bool DefaultConditionFilter::filter(const TupleSchema &schema_, const Tuple &tuple) const
+{
   int left_index = schema_.index_of_field(left_.table_name, left_.attr_name);
   int right_index = schema_.index_of_field(right_.table_name, right_.attr_name);
-  left_value = tuple.get_pointer(left_index);
-  right_value = tuple.get_pointer(right_index);
+  const TupleValue left_value = tuple.get(left_index);
+  const TupleValue right_value = tuple.get(right_index);
 
-  if (left_value->type() == IS_NULL || right_value->type() == IS_NULL) {
+  if (left_value.type() == IS_NULL || right_value.type() == IS_NULL) {
     return false;
   }
   int cmp_result = 0;
-  cmp_result = left_value->compare(*right_value);
+  cmp_result = left_value.compare(right_value);
 
   switch (comp_op_) {
     case EQUAL_TO:
@@ -867,4 +624,15 @@ bool CompositeConditionFilter::filter(const TupleSchema &schema_, const Tuple &t
     }
   }
   return true;
-}
\ No newline at end of file
+}
+bool CompositeConditionFilter::filter_columns(const RecordPageHandler &page, int *selected, int *num) const
+{
+  // 能按列过滤的条件依次缩小选择向量，只要有一个条件不能按列过滤，剩下的记录就需要逐条过滤
+  bool exact = true;
+  for (int i = 0; i < filter_num_ && *num > 0; i++) {
+    if (!filters_[i]->filter_columns(page, selected, num)) {
+      exact = false;
+    }
+  }
+  return exact;
+}
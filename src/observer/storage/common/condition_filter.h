@@ -15,12 +15,18 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_STORAGE_COMMON_CONDITION_FILTER_H_
 #define __OBSERVER_STORAGE_COMMON_CONDITION_FILTER_H_
 
+#include <string>
+#include <unordered_set>
+
 #include "rc.h"
 #include "sql/parser/parse.h"
 #include "sql/executor/tuple.h"
+#include "storage/common/predicate_kernel.h"
 
 struct Record;
+class RecordPageHandler;
 class Table;
+class Dictionary;
 
 struct ConDesc {
   bool   is_text;
@@ -32,7 +38,10 @@ struct ConDesc {
   char * attr_name;
   char * table_name;
   AttrType type;
-  ConDesc()
+  int    null_offset = 0; // 如果是属性，表示记录中null位图的偏移量
+  int    null_bit = -1;   // 如果是可为null的属性，表示在null位图中的位置
+  ConDesc() : is_text(false), is_attr(false), attr_length(0), attr_offset(0), value(nullptr),
+              attr_name(nullptr), table_name(nullptr), type(UNDEFINED)
   {
   };
   ConDesc(bool is_attr, int attr_length, int attr_offset, void *value):is_attr(is_attr), attr_length(attr_length), attr_offset(attr_offset), value(value)
@@ -52,6 +61,15 @@ public:
    */
   virtual bool filter(const Record &rec) const = 0;
   virtual bool filter(const TupleSchema &schema_, const Tuple &tuple) const = 0;
+
+  /**
+   * 按列过滤页面上的一批记录，只读取条件涉及的列
+   * @param page 已经打开的页面，PAX或者行格式
+   * @param selected 选择向量，按顺序排列的待过滤的槽位号，不满足条件的槽位会被去掉
+   * @param num 输入时是selected中槽位的个数，输出时是剩下的个数
+   * @return true表示过滤结果是精确的；false表示剩下的记录还需要调用filter(Record)逐条过滤
+   */
+  virtual bool filter_columns(const RecordPageHandler &page, int *selected, int *num) const;
 };
 
 class DefaultConditionFilter : public ConditionFilter {
@@ -64,6 +82,7 @@ public:
 
   virtual bool filter(const Record &rec) const;
   virtual bool filter(const TupleSchema &schema_, const Tuple &tuple) const;
+  virtual bool filter_columns(const RecordPageHandler &page, int *selected, int *num) const;
 
 public:
   const ConDesc &left() const {
@@ -78,13 +97,40 @@ public:
     return comp_op_;
   }
 
+private:
+  void init_subquery(const TupleSet *tuple_set, const TupleSet *tuple_set_left);
+  void init_dict(const Dictionary *left_dict, const Dictionary *right_dict, const TupleSet *tuple_set);
+  void init_kernel();
+
 private:
   ConDesc  left_;
   ConDesc  right_;
   AttrType attr_type_ = UNDEFINED;
   CompOp   comp_op_ = NO_OP;
-  TupleSet *tuple_set_ = nullptr;
-  TupleSet *tuple_set_left_ = nullptr;
+
+  // 子查询的结果集在init时转换成与左边字段同类型的值，过滤时不再访问结果集，结果集可以在init之后释放：
+  // IN/NOT IN转换成哈希集合，每条记录只需要查一次哈希表(哈希半连接)；其它比较转换成一个标量
+  bool  subquery_ = false;
+  bool  subquery_left_ = false;
+  bool  subquery_empty_ = false;
+  bool  subquery_first_null_ = false;
+  bool  subquery_has_null_ = false;
+  std::unordered_set<std::string> subquery_strings_;
+  std::unordered_set<double> subquery_numbers_;
+  std::string subquery_string_;
+  double subquery_number_ = 0;
+
+  // 字典编码的字段。可以直接比较编码的条件(=, <>, IN, NOT IN)在init时把常量转换成编码，
+  // 其它条件在比较前把编码还原成字符串
+  const Dictionary *left_dict_ = nullptr;
+  const Dictionary *right_dict_ = nullptr;
+  bool  dict_fast_path_ = false;
+  int   dict_code_ = -1;
+  bool  dict_codes_has_null_ = false;
+  std::unordered_set<int> dict_codes_;
+
+  // 属性和常量的比较在init时编译成按列过滤的核心，不能编译的条件只能逐条过滤
+  PredicateKernel kernel_;
 };
 
 class CompositeConditionFilter : public ConditionFilter {
@@ -96,6 +142,7 @@ public:
   RC init(Table &table, const Condition *conditions, int condition_num);
   virtual bool filter(const Record &rec) const;
   virtual bool filter(const TupleSchema &schema_, const Tuple &tuple) const;
+  virtual bool filter_columns(const RecordPageHandler &page, int *selected, int *num) const;
 
 public:
   int filter_num() const {
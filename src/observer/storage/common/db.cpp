@@ -51,7 +51,8 @@ RC Db::init(const char *name, const char *dbpath) {
   return open_all_tables();
 }
 
-RC Db::create_table(const char *table_name, int attribute_count, const AttrInfo *attributes) {
+RC Db::create_table(const char *table_name, int attribute_count, const AttrInfo *attributes,
+                    StorageFormat storage_format) {
   RC rc = RC::SUCCESS;
   // check table_name
   if (opened_tables_.count(table_name) != 0) {
@@ -60,7 +61,7 @@ RC Db::create_table(const char *table_name, int attribute_count, const AttrInfo
 
   std::string table_file_path = table_meta_file(path_.c_str(), table_name); // 文件路径可以移到Table模块
   Table *table = new Table();
-  rc = table->create(table_file_path.c_str(), table_name, path_.c_str(), attribute_count, attributes);
+  rc = table->create(table_file_path.c_str(), table_name, path_.c_str(), attribute_count, attributes, storage_format);
   if (rc != RC::SUCCESS) {
     delete table;
     return rc;
@@ -136,6 +137,39 @@ RC Db::sync() {
   return rc;
 }
 
+RC Db::vacuum(int fill_factor, int &page_budget, VacuumStat &stat) {
+  RC rc = RC::SUCCESS;
+  for (const auto &table_pair: opened_tables_) {
+    if (page_budget <= 0) {
+      break;
+    }
+    Table *table = table_pair.second;
+    rc = table->vacuum(fill_factor, page_budget, stat);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to vacuum table. table=%s.%s, rc=%d:%s", name_.c_str(), table->name(), rc, strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC Db::analyze(int threshold, int &analyzed_count) {
+  RC rc = RC::SUCCESS;
+  for (const auto &table_pair: opened_tables_) {
+    Table *table = table_pair.second;
+    if (!table->stats_stale(threshold)) {
+      continue;
+    }
+    rc = table->analyze();
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to analyze table. table=%s.%s, rc=%d:%s", name_.c_str(), table->name(), rc, strrc(rc));
+      return rc;
+    }
+    analyzed_count++;
+  }
+  return rc;
+}
+
 RC Db::drop_table(const char *table_name) {
   RC rc = RC::SUCCESS;
   // check table_name
@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/parser/parse_defs.h"
 
 class Table;
+struct VacuumStat;
 
 class Db {
 public:
@@ -31,7 +32,8 @@ public:
 
   RC init(const char *name, const char *dbpath);
 
-  RC create_table(const char *table_name, int attribute_count, const AttrInfo *attributes);
+  RC create_table(const char *table_name, int attribute_count, const AttrInfo *attributes,
+                  StorageFormat storage_format = ROW_FORMAT);
   RC drop_table(const char *table_name);
   Table *find_table(const char *table_name) const;
 
@@ -40,6 +42,8 @@ public:
   void all_tables(std::vector<std::string> &table_names) const;
 
   RC sync();
+  RC vacuum(int fill_factor, int &page_budget, VacuumStat &stat);
+  RC analyze(int threshold, int &analyzed_count);
 private:
   RC open_all_tables();
 
@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "storage/common/dictionary.h"
+#include "common/log/log.h"
+#include "json/json.h"
+
+const static Json::StaticString FIELD_MAX_LEN("max_len");
+const static Json::StaticString FIELD_VALUES("values");
+
+const int Dictionary::INVALID_CODE;
+const int Dictionary::FIRST_CHUNK_BITS;
+const int Dictionary::FIRST_CHUNK_SIZE;
+const int Dictionary::MAX_CHUNKS;
+
+Dictionary::Dictionary(int max_len) : max_len_(max_len) {
+}
+
+int Dictionary::max_len() const {
+  return max_len_;
+}
+
+int Dictionary::size() const {
+  return size_.load(std::memory_order_acquire);
+}
+
+std::string *Dictionary::slot(int code) const {
+  // code + FIRST_CHUNK_SIZE的最高位决定所在的块
+  const unsigned int n = (unsigned int)code + FIRST_CHUNK_SIZE;
+  const int chunk = 31 - __builtin_clz(n) - FIRST_CHUNK_BITS;
+  return &chunks_[chunk][n - ((unsigned int)FIRST_CHUNK_SIZE << chunk)];
+}
+
+std::string Dictionary::normalize(const char *value) const {
+  return std::string(value, strnlen(value, max_len_));
+}
+
+int Dictionary::code(const char *value) const {
+  std::string key = normalize(value);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = codes_.find(key);
+  if (iter == codes_.end()) {
+    return INVALID_CODE;
+  }
+  return iter->second;
+}
+
+int Dictionary::get_or_add(const char *value, bool &added) {
+  std::string key = normalize(value);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = codes_.find(key);
+  if (iter != codes_.end()) {
+    added = false;
+    return iter->second;
+  }
+
+  const int code = size_.load(std::memory_order_relaxed);
+  if (code == INT32_MAX) {
+    LOG_ERROR("Dictionary is full, size=%d", code);
+    added = false;
+    return INVALID_CODE;
+  }
+  const unsigned int n = (unsigned int)code + FIRST_CHUNK_SIZE;
+  const int chunk = 31 - __builtin_clz(n) - FIRST_CHUNK_BITS;
+  if (chunks_[chunk] == nullptr) {
+    chunks_[chunk].reset(new std::string[(size_t)FIRST_CHUNK_SIZE << chunk]);
+  }
+  *slot(code) = key;
+  codes_.emplace(std::move(key), code);
+  size_.store(code + 1, std::memory_order_release);
+  added = true;
+  return code;
+}
+
+const char *Dictionary::value(int code) const {
+  const int size = size_.load(std::memory_order_acquire);
+  if (code < 0 || code >= size) {
+    LOG_ERROR("Invalid dictionary code %d, dictionary size=%d", code, size);
+    return "";
+  }
+  return slot(code)->c_str();
+}
+
+void Dictionary::to_json(Json::Value &json_value) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  json_value[FIELD_MAX_LEN] = max_len_;
+  Json::Value values_value(Json::arrayValue);
+  const int size = size_.load(std::memory_order_relaxed);
+  for (int i = 0; i < size; i++) {
+    values_value.append(*slot(i));
+  }
+  json_value[FIELD_VALUES] = std::move(values_value);
+}
+
+RC Dictionary::from_json(const Json::Value &json_value, Dictionary *&dict) {
+  const Json::Value &max_len_value = json_value[FIELD_MAX_LEN];
+  const Json::Value &values_value = json_value[FIELD_VALUES];
+  if (!max_len_value.isInt()) {
+    LOG_ERROR("Dictionary max len is not an integer. json value=%s", max_len_value.toStyledString().c_str());
+    return RC::GENERIC_ERROR;
+  }
+  if (!values_value.isArray()) {
+    LOG_ERROR("Dictionary values is not an array. json value=%s", values_value.toStyledString().c_str());
+    return RC::GENERIC_ERROR;
+  }
+
+  dict = new Dictionary(max_len_value.asInt());
+  for (Json::Value::ArrayIndex i = 0; i < values_value.size(); i++) {
+    bool added = false;
+    dict->get_or_add(values_value[i].asCString(), added);
+  }
+  return RC::SUCCESS;
+}
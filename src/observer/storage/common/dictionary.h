@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_STORAGE_COMMON_DICTIONARY_H__
+#define __OBSERVER_STORAGE_COMMON_DICTIONARY_H__
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "rc.h"
+
+namespace Json {
+class Value;
+} // namespace Json
+
+/**
+ * CHARS字段的字典。使用字典编码的字段在记录中只保存字符串对应的编码(int)，
+ * 字典本身随表元数据一起持久化。适合取值个数不多的字段，比如状态、地区代码
+ */
+class Dictionary {
+public:
+  static const int INVALID_CODE = -1;
+
+public:
+  explicit Dictionary(int max_len);
+  ~Dictionary() = default;
+
+  /**
+   * 字段声明的最大长度，超过这个长度的字符串会被截断
+   */
+  int max_len() const;
+  int size() const;
+
+  /**
+   * 查找字符串的编码，不存在时返回INVALID_CODE
+   */
+  int code(const char *value) const;
+
+  /**
+   * 查找字符串的编码，不存在时为它分配一个新的编码
+   * @param added 是否分配了新的编码。新增的编码需要由调用者持久化
+   */
+  int get_or_add(const char *value, bool &added);
+
+  /**
+   * 编码对应的字符串，不加锁。字符串保存在分配后不再移动的块中，
+   * 写入之后才发布新的size_，读到的编码范围内的字符串都已经写好
+   */
+  const char *value(int code) const;
+
+public:
+  void to_json(Json::Value &json_value) const;
+  static RC from_json(const Json::Value &json_value, Dictionary *&dict);
+
+private:
+  std::string normalize(const char *value) const;
+  std::string *slot(int code) const;
+
+private:
+  /// 第i个块可以放FIRST_CHUNK_SIZE << i个字符串，块的个数足够放下所有非负的int编码
+  static const int FIRST_CHUNK_BITS = 6;
+  static const int FIRST_CHUNK_SIZE = 1 << FIRST_CHUNK_BITS;
+  static const int MAX_CHUNKS = 32 - FIRST_CHUNK_BITS;
+
+  int                                   max_len_;
+  std::unique_ptr<std::string[]>        chunks_[MAX_CHUNKS];
+  std::atomic<int>                      size_{0};
+  std::unordered_map<std::string, int>  codes_;
+  mutable std::mutex                    mutex_;   /// 保护codes_和新编码的分配
+};
+
+#endif // __OBSERVER_STORAGE_COMMON_DICTIONARY_H__
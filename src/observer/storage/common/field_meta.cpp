@@ -22,23 +22,22 @@ const static Json::StaticString FIELD_TYPE("type");
 const static Json::StaticString FIELD_OFFSET("offset");
 const static Json::StaticString FIELD_LEN("len");
 const static Json::StaticString FIELD_VISIBLE("visible");
+const static Json::StaticString FIELD_NULLABLE("nullable");
+const static Json::StaticString FIELD_DICT("dict");
 
 const char *ATTR_TYPE_NAME[] = {
   "undefined",
   "chars",
-  "chars_nullable",
   "ints",
-  "ints_nullable",
   "floats",
-  "floats_nullable",
   "dates",
-  "dates_nullable",
-  "if_null",
-  "is_null"
+  "is_null",
+  "not_null",
+  "text"
 };
 
 const char *attr_type_to_string(AttrType type) {
-  if (type >= UNDEFINED && type <= IS_NULL) {
+  if (type >= UNDEFINED && type <= TEXT) {
     return ATTR_TYPE_NAME[type];
   }
   return "unknown";
@@ -53,10 +52,11 @@ AttrType attr_type_from_string(const char *s) {
   return UNDEFINED;
 }
 
-FieldMeta::FieldMeta() : attr_type_(AttrType::UNDEFINED), attr_offset_(-1), attr_len_(0), visible_(false) {
+FieldMeta::FieldMeta() : attr_type_(AttrType::UNDEFINED), attr_offset_(-1), attr_len_(0), visible_(false),
+    nullable_(false), null_offset_(0), null_bit_(-1) {
 }
 
-RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible) {
+RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible, bool nullable) {
   if (nullptr == name || '\0' == name[0]) {
     LOG_WARN("Name cannot be empty");
     return RC::INVALID_ARGUMENT;
@@ -73,6 +73,9 @@ RC FieldMeta::init(const char *name, AttrType attr_type, int attr_offset, int at
   attr_len_ = attr_len;
   attr_offset_ = attr_offset;
   visible_ = visible;
+  nullable_ = nullable;
+  null_offset_ = 0;
+  null_bit_ = -1;
 
   LOG_INFO("Init a field with name=%s", name);
   return RC::SUCCESS;
@@ -98,11 +101,40 @@ bool FieldMeta::visible() const {
   return visible_;
 }
 
+bool FieldMeta::nullable() const {
+  return nullable_;
+}
+
+int FieldMeta::null_bit() const {
+  return null_bit_;
+}
+
+int FieldMeta::null_offset() const {
+  return null_offset_;
+}
+
+void FieldMeta::set_null_bit(int null_offset, int null_bit) {
+  null_offset_ = null_offset;
+  null_bit_ = null_bit;
+}
+
+Dictionary *FieldMeta::dict() const {
+  return dict_.get();
+}
+
+void FieldMeta::set_dict(Dictionary *dict) {
+  dict_.reset(dict);
+}
+
 void FieldMeta::desc(std::ostream &os) const {
   os << "field name=" << name_
      << ", type=" << attr_type_to_string(attr_type_)
      << ", len=" << attr_len_
-     << ", visible=" << (visible_ ? "yes" : "no");
+     << ", visible=" << (visible_ ? "yes" : "no")
+     << ", nullable=" << (nullable_ ? "yes" : "no");
+  if (dict_ != nullptr) {
+    os << ", dict=" << dict_->max_len() << "/" << dict_->size();
+  }
 }
 
 void FieldMeta::to_json(Json::Value &json_value) const {
@@ -111,6 +143,10 @@ void FieldMeta::to_json(Json::Value &json_value) const {
   json_value[FIELD_OFFSET] = attr_offset_;
   json_value[FIELD_LEN]  = attr_len_;
   json_value[FIELD_VISIBLE] = visible_;
+  json_value[FIELD_NULLABLE] = nullable_;
+  if (dict_ != nullptr) {
+    dict_->to_json(json_value[FIELD_DICT]);
+  }
 }
 
 RC FieldMeta::from_json(const Json::Value &json_value, FieldMeta &field) {
@@ -158,5 +194,20 @@ RC FieldMeta::from_json(const Json::Value &json_value, FieldMeta &field) {
   int offset = offset_value.asInt();
   int len = len_value.asInt();
   bool visible = visible_value.asBool();
-  return field.init(name, type, offset, len, visible);
+  bool nullable = json_value.isMember(FIELD_NULLABLE) && json_value[FIELD_NULLABLE].asBool();
+  RC rc = field.init(name, type, offset, len, visible, nullable);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (json_value.isMember(FIELD_DICT)) {
+    Dictionary *dict = nullptr;
+    rc = Dictionary::from_json(json_value[FIELD_DICT], dict);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to deserialize dictionary of field %s", name);
+      return rc;
+    }
+    field.set_dict(dict);
+  }
+  return rc;
 }
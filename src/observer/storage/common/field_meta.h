@@ -15,10 +15,13 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_STORAGE_COMMON_FIELD_META_H__
 #define __OBSERVER_STORAGE_COMMON_FIELD_META_H__
 
+#include <memory>
 #include <string>
 
 #include "rc.h"
 #include "sql/parser/parse_defs.h"
+#include "storage/common/dictionary.h"
+#include "storage/common/null_bitmap.h"
 
 namespace Json {
 class Value;
@@ -29,7 +32,7 @@ public:
   FieldMeta();
   ~FieldMeta() = default;
 
-  RC init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible);
+  RC init(const char *name, AttrType attr_type, int attr_offset, int attr_len, bool visible, bool nullable = false);
 
 public:
   const char *name() const;
@@ -38,6 +41,26 @@ public:
   int         len() const;
   bool        visible() const;
 
+  /**
+   * 字典编码的CHARS字段返回对应的字典，记录中保存的是int编码；否则返回nullptr
+   */
+  Dictionary *dict() const;
+  void        set_dict(Dictionary *dict);
+
+  /**
+   * 可为null的字段在记录头部的null位图中占一位。位置由TableMeta按照字段顺序分配，不持久化
+   */
+  bool        nullable() const;
+  int         null_bit() const;
+  int         null_offset() const;
+  void        set_null_bit(int null_offset, int null_bit);
+  bool        is_null(const char *record) const {
+    return null_bitmap_test(record + null_offset_, null_bit_);
+  }
+  void        set_null(char *record, bool is_null) const {
+    null_bitmap_set(record + null_offset_, null_bit_, is_null);
+  }
+
 public:
   void desc(std::ostream &os) const;
 public:
@@ -50,5 +73,9 @@ private:
   int          attr_offset_;
   int          attr_len_;
   bool         visible_;
+  bool         nullable_;
+  int          null_offset_;  // null位图在记录中的偏移
+  int          null_bit_;     // 不可为null的字段为-1
+  std::shared_ptr<Dictionary> dict_; // 字段元数据会被拷贝，字典在拷贝之间共享
 };
 #endif // __OBSERVER_STORAGE_COMMON_FIELD_META_H__
\ No newline at end of file
@@ -44,10 +44,21 @@ public:
 
   virtual RC insert_entry(const char *record, const RID *rid) = 0;
   virtual RC delete_entry(const char *record, const RID *rid) = 0;
-  virtual RC update_entry(const char *record, const RID *rid) = 0;
+
+  /**
+   * 记录从old_record更新成new_record。键变化时删除旧的索引项，插入新的索引项
+   */
+  virtual RC update_entry(const char *old_record, const char *new_record, const RID *rid) = 0;
 
   virtual IndexScanner *create_scanner(CompOp comp_op, const char *value) = 0;
 
+  /**
+   * 按键的顺序访问所有索引项，reverse为true时从最大的键开始。visitor返回false时停止。
+   * key是索引项的键，布局与create_index_scanner的查找值相同
+   * @return 访问完所有的索引项时返回RECORD_EOF
+   */
+  virtual RC visit_entries(bool reverse, void *context, bool (*visitor)(const char *key, const RID *rid, void *context)) = 0;
+
   virtual RC sync() = 0;
 
 protected:
@@ -18,6 +18,14 @@ std::string table_meta_file(const char *base_dir, const char *table_name) {
   return std::string(base_dir) + "/" + table_name + TABLE_META_SUFFIX;
 }
 
+std::string table_stats_file(const char *base_dir, const char *table_name) {
+  return std::string(base_dir) + "/" + table_name + TABLE_STATS_SUFFIX;
+}
+
+std::string table_dict_file(const char *base_dir, const char *table_name) {
+  return std::string(base_dir) + "/" + table_name + TABLE_DICT_SUFFIX;
+}
+
 std::string index_data_file(const char *base_dir, const char *table_name, const char *index_name) {
   return std::string(base_dir) + "/" + table_name + "-" + index_name + TABLE_INDEX_SUFFIX;
 }
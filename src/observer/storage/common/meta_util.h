@@ -20,11 +20,15 @@ static const char *TABLE_META_SUFFIX = ".table";
 static const char *TABLE_META_FILE_PATTERN = ".*\\.table$";
 static const char *TABLE_DATA_SUFFIX = ".data";
 static const char *TABLE_INDEX_SUFFIX = ".index";
+static const char *TABLE_STATS_SUFFIX = ".stats";
+static const char *TABLE_DICT_SUFFIX = ".dict";
 
 static int text_counter = 0;//最多存int个text
 
 std::string table_meta_file(const char *base_dir, const char *table_name);
 std::string index_data_file(const char *base_dir, const char *table_name, const char *index_name);
+std::string table_stats_file(const char *base_dir, const char *table_name);
+std::string table_dict_file(const char *base_dir, const char *table_name);
 std::string text_data_file(const char *table_name, const char *file_name);
 size_t get_text_data_file_len(const char *table_name, const char *file_name);
 
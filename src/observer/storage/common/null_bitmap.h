@@ -0,0 +1,38 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_STORAGE_COMMON_NULL_BITMAP_H__
+#define __OBSERVER_STORAGE_COMMON_NULL_BITMAP_H__
+
+#include <stdint.h>
+
+/**
+ * null位图。记录头部和索引键的头部各有一个4字节的位图，可为null的字段占其中一位，
+ * 位为1表示字段的值为null。不可为null的字段bit为-1
+ */
+static const int NULL_BITMAP_SIZE = sizeof(uint32_t);
+static const int NULL_BITMAP_MAX_BITS = NULL_BITMAP_SIZE * 8;
+
+inline bool null_bitmap_test(const char *bitmap, int bit) {
+  return bit >= 0 && ((*(const uint32_t *)bitmap >> bit) & 1);
+}
+
+inline void null_bitmap_set(char *bitmap, int bit, bool is_null) {
+  if (bit < 0) {
+    return;
+  }
+  if (is_null) {
+    *(uint32_t *)bitmap |= (1u << bit);
+  } else {
+    *(uint32_t *)bitmap &= ~(1u << bit);
+  }
+}
+
+#endif // __OBSERVER_STORAGE_COMMON_NULL_BITMAP_H__
@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <functional>
+#include <type_traits>
+
+#include "storage/common/predicate_kernel.h"
+#include "storage/common/mydate.h"
+#include "storage/common/null_bitmap.h"
+
+/**
+ * 循环中没有分支：每个槽位都写到输出的下一个位置，满足条件时位置才向后移动。
+ * 记录中的字段不一定对齐，用memcpy读取，编译器会生成普通的load指令
+ */
+template <typename T, typename Compare>
+int PredicateKernel::select_values(const ColumnData &column, const int *selected, int num, int *out) const
+{
+  T value;
+  memcpy(&value, std::is_same<T, float>::value ? (const void *)&float_value_ : (const void *)&int_value_, sizeof(T));
+  const char *data = column.data;
+  const int stride = column.stride;
+  Compare compare;
+  int count = 0;
+  for (int i = 0; i < num; i++) {
+    const int slot = selected[i];
+    T field;
+    memcpy(&field, data + slot * stride, sizeof(T));
+    out[count] = slot;
+    count += compare(field, value);
+  }
+  return count;
+}
+
+template <typename Compare>
+int PredicateKernel::select_chars(const ColumnData &column, const int *selected, int num, int *out) const
+{
+  // 字段占满定长时没有结束符，只比较字段长度内的部分
+  const char *value = string_value_.c_str();
+  const int less_on_equal = string_longer_ ? -1 : 0;
+  Compare compare;
+  int count = 0;
+  for (int i = 0; i < num; i++) {
+    const int slot = selected[i];
+    int cmp_result = strncmp(column.data + slot * column.stride, value, attr_length_);
+    cmp_result = cmp_result == 0 ? less_on_equal : cmp_result;
+    out[count] = slot;
+    count += compare(cmp_result, 0);
+  }
+  return count;
+}
+
+template <typename T>
+void PredicateKernel::set_compare(CompOp comp_op)
+{
+  switch (comp_op) {
+    case EQUAL_TO:
+      select_func_ = &PredicateKernel::select_values<T, std::equal_to<T>>;
+      break;
+    case LESS_EQUAL:
+      select_func_ = &PredicateKernel::select_values<T, std::less_equal<T>>;
+      break;
+    case NOT_EQUAL:
+      select_func_ = &PredicateKernel::select_values<T, std::not_equal_to<T>>;
+      break;
+    case LESS_THAN:
+      select_func_ = &PredicateKernel::select_values<T, std::less<T>>;
+      break;
+    case GREAT_EQUAL:
+      select_func_ = &PredicateKernel::select_values<T, std::greater_equal<T>>;
+      break;
+    case GREAT_THAN:
+      select_func_ = &PredicateKernel::select_values<T, std::greater<T>>;
+      break;
+    default:
+      select_func_ = nullptr;
+      break;
+  }
+}
+
+void PredicateKernel::set_chars_compare(CompOp comp_op)
+{
+  switch (comp_op) {
+    case EQUAL_TO:
+      select_func_ = &PredicateKernel::select_chars<std::equal_to<int>>;
+      break;
+    case LESS_EQUAL:
+      select_func_ = &PredicateKernel::select_chars<std::less_equal<int>>;
+      break;
+    case NOT_EQUAL:
+      select_func_ = &PredicateKernel::select_chars<std::not_equal_to<int>>;
+      break;
+    case LESS_THAN:
+      select_func_ = &PredicateKernel::select_chars<std::less<int>>;
+      break;
+    case GREAT_EQUAL:
+      select_func_ = &PredicateKernel::select_chars<std::greater_equal<int>>;
+      break;
+    case GREAT_THAN:
+      select_func_ = &PredicateKernel::select_chars<std::greater<int>>;
+      break;
+    default:
+      select_func_ = nullptr;
+      break;
+  }
+}
+
+bool PredicateKernel::compile(AttrType type, int attr_length, CompOp comp_op, const void *value)
+{
+  select_func_ = nullptr;
+  if (value == nullptr) {
+    return false;
+  }
+
+  attr_length_ = attr_length;
+  switch (type) {
+    case INTS: {
+      int_value_ = *(const int *)value;
+      set_compare<int>(comp_op);
+    } break;
+    case FLOATS: {
+      float_value_ = *(const float *)value;
+      set_compare<float>(comp_op);
+    } break;
+    case DATES: {
+      MyDate date((char *)value);
+      int_value_ = date.toInt();
+      set_compare<int>(comp_op);
+    } break;
+    case CHARS: {
+      string_value_ = (const char *)value;
+      string_longer_ = string_value_.size() > (size_t)attr_length;
+      set_chars_compare(comp_op);
+    } break;
+    default: {
+    } break;
+  }
+  return select_func_ != nullptr;
+}
+
+int select_null(const ColumnData &null_column, int null_bit, bool is_null, const int *selected, int num, int *out)
+{
+  int count = 0;
+  for (int i = 0; i < num; i++) {
+    const int slot = selected[i];
+    out[count] = slot;
+    count += null_bitmap_test(null_column.data + slot * null_column.stride, null_bit) == is_null;
+  }
+  return count;
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_STORAGE_COMMON_PREDICATE_KERNEL_H__
+#define __OBSERVER_STORAGE_COMMON_PREDICATE_KERNEL_H__
+
+#include <string>
+
+#include "sql/parser/parse_defs.h"
+
+/**
+ * 页面上的一列，第i个槽位的值在 data + i * stride 处。
+ * PAX页面上stride是列的长度，行格式的页面上是记录的长度
+ */
+struct ColumnData {
+  const char *data = nullptr;
+  int stride = 0;
+};
+
+/**
+ * 属性和常量比较的过滤核心。在查询开始时根据类型和比较符号选定比较函数，
+ * 过滤时对一批槽位调用一次，不再对每条记录判断类型和比较符号。
+ *
+ * 输入和输出都是选择向量：按顺序排列的槽位号。几个条件AND在一起时，
+ * 后一个条件只处理前一个条件选出来的槽位，得到的就是两个选择向量的交集
+ */
+class PredicateKernel {
+public:
+  /**
+   * @param type 字段的类型。DATES的常量是日期字符串，字典编码的字段按INTS比较编码
+   * @param value 常量的值，不能为nullptr
+   * @return 不支持的类型或者比较符号返回false，这样的条件只能逐条过滤
+   */
+  bool compile(AttrType type, int attr_length, CompOp comp_op, const void *value);
+
+  bool compiled() const {
+    return select_func_ != nullptr;
+  }
+
+  /**
+   * 从selected中选出满足条件的槽位，按顺序写到out中
+   * @param out 可以和selected相同
+   * @return 选出的槽位个数
+   */
+  int select(const ColumnData &column, const int *selected, int num, int *out) const {
+    return (this->*select_func_)(column, selected, num, out);
+  }
+
+private:
+  template <typename T, typename Compare>
+  int select_values(const ColumnData &column, const int *selected, int num, int *out) const;
+  template <typename Compare>
+  int select_chars(const ColumnData &column, const int *selected, int num, int *out) const;
+
+  template <typename T>
+  void set_compare(CompOp comp_op);
+  void set_chars_compare(CompOp comp_op);
+
+private:
+  typedef int (PredicateKernel::*SelectFunc)(const ColumnData &, const int *, int, int *) const;
+
+  SelectFunc select_func_ = nullptr;
+  int int_value_ = 0;
+  float float_value_ = 0;
+  std::string string_value_;
+  int attr_length_ = 0;
+  bool string_longer_ = false; // 常量比字段长，前缀相同时字段更小
+};
+
+/**
+ * 按null位图选择槽位
+ * @param is_null true选出值为null的槽位，false选出不为null的槽位
+ */
+int select_null(const ColumnData &null_column, int null_bit, bool is_null, const int *selected, int num, int *out);
+
+#endif // __OBSERVER_STORAGE_COMMON_PREDICATE_KERNEL_H__
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 #include "storage/common/record_manager.h"
+#include <algorithm>
 #include "rc.h"
 #include "common/log/log.h"
 #include "common/lang/bitmap.h"
@@ -53,6 +54,21 @@ int page_header_size(int record_capacity) {
   const int bitmap_size = page_bitmap_size(record_capacity);
   return align8(page_fix_size() + bitmap_size);
 }
+
+int pax_page_record_capacity(int page_size, const PaxLayout &pax_layout) {
+  // 每个minipage的起始位置按8字节对齐，页头也要对齐，预留出对齐可能浪费的空间
+  const int align_reserved = 8 * (pax_layout.column_num() + 1);
+  return (int)((page_size - page_fix_size() - align_reserved - 1) / (pax_layout.record_size() + 0.125));
+}
+////////////////////////////////////////////////////////////////////////////////
+int PaxLayout::find_column(int record_offset) const {
+  for (size_t i = 0; i < offsets_.size(); i++) {
+    if (offsets_[i] == record_offset) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
 ////////////////////////////////////////////////////////////////////////////////
 RecordPageHandler::RecordPageHandler() : 
     disk_buffer_pool_(nullptr),
@@ -67,7 +83,7 @@ RecordPageHandler::~RecordPageHandler() {
   deinit();
 }
 
-RC RecordPageHandler::init(DiskBufferPool &buffer_pool, int file_id, PageNum page_num) {
+RC RecordPageHandler::init(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, const PaxLayout *pax_layout) {
   if (disk_buffer_pool_ != nullptr) {
     LOG_WARN("Disk buffer pool has been opened for file_id:page_num %d:%d.",
              file_id, page_num);
@@ -92,11 +108,35 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, int file_id, PageNum pag
 
   page_header_ = (PageHeader*)(data);
   bitmap_ = data + page_fix_size();
+
+  if (pax_layout != nullptr) {
+    if (page_header_->record_real_size != pax_layout->record_size()) {
+      LOG_ERROR("PAX layout mismatch. file_id:page_num %d:%d, page record size=%d, layout record size=%d",
+                file_id, page_num, page_header_->record_real_size, pax_layout->record_size());
+      deinit();
+      return RC::RECORD_INVALIDRECSIZE;
+    }
+    pax_layout_ = pax_layout;
+    init_pax_layout();
+  }
   LOG_TRACE("Successfully init file_id:page_num %d:%d.", file_id, page_num);
   return ret;
 }
 
-RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, int record_size) {
+void RecordPageHandler::init_pax_layout() {
+  // minipage依次排列在页头之后，每个都按8字节对齐
+  const int column_num = pax_layout_->column_num();
+  minipage_offsets_.resize(column_num);
+  int offset = page_header_->first_record_offset;
+  for (int i = 0; i < column_num; i++) {
+    minipage_offsets_[i] = offset;
+    offset = align8(offset + page_header_->record_capacity * pax_layout_->column_len(i));
+  }
+  row_buffer_.resize(pax_layout_->record_size());
+}
+
+RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, int record_size,
+                                      const PaxLayout *pax_layout) {
   RC ret = init(buffer_pool, file_id, page_num);
   if (ret != RC::SUCCESS) {
     LOG_ERROR("Failed to init empty page file_id:page_num:record_size %d:%d:%d."
@@ -105,13 +145,23 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, int file_id,
   }
 
   int page_size = sizeof(page_handle_.frame->page.data);
-  int record_phy_size = align8(record_size);
+  if (pax_layout != nullptr) {
+    // PAX页面中记录不再连续存放，record_size只用来记录行的大小
+    page_header_->record_capacity = pax_page_record_capacity(page_size, *pax_layout);
+    page_header_->record_size = record_size;
+  } else {
+    int record_phy_size = align8(record_size);
+    page_header_->record_capacity = page_record_capacity(page_size, record_phy_size);
+    page_header_->record_size = record_phy_size;
+  }
   page_header_->record_num = 0;
-  page_header_->record_capacity = page_record_capacity(page_size, record_phy_size);
   page_header_->record_real_size = record_size;
-  page_header_->record_size = record_phy_size;
   page_header_->first_record_offset = page_header_size(page_header_->record_capacity);
   bitmap_ = page_handle_.frame->page.data + page_fix_size();
+  if (pax_layout != nullptr) {
+    pax_layout_ = pax_layout;
+    init_pax_layout();
+  }
 
   memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
   ret = disk_buffer_pool_->mark_dirty(&page_handle_);
@@ -134,11 +184,33 @@ RC RecordPageHandler::deinit() {
       LOG_ERROR("Failed to unpin page when deinit record page handler. rc=%s", strrc(rc));
     }
     disk_buffer_pool_ = nullptr;
+    page_header_ = nullptr;
   }
+  pax_layout_ = nullptr;
 
   return RC::SUCCESS;
 }
 
+char *RecordPageHandler::record_data(int slot_num) {
+  return page_handle_.frame->page.data + page_header_->first_record_offset + (slot_num * page_header_->record_size);
+}
+
+void RecordPageHandler::write_columns(int slot_num, const char *data) {
+  char *page_data = page_handle_.frame->page.data;
+  for (int i = 0; i < pax_layout_->column_num(); i++) {
+    const int len = pax_layout_->column_len(i);
+    memcpy(page_data + minipage_offsets_[i] + slot_num * len, data + pax_layout_->column_offset(i), len);
+  }
+}
+
+void RecordPageHandler::read_columns(int slot_num, char *data) const {
+  const char *page_data = page_handle_.frame->page.data;
+  for (int i = 0; i < pax_layout_->column_num(); i++) {
+    const int len = pax_layout_->column_len(i);
+    memcpy(data + pax_layout_->column_offset(i), page_data + minipage_offsets_[i] + slot_num * len, len);
+  }
+}
+
 RC RecordPageHandler::insert_record(const char *data, RID *rid) {
 
   if (page_header_->record_num == page_header_->record_capacity) {
@@ -154,9 +226,11 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid) {
   page_header_->record_num++;
 
   // assert index < page_header_->record_capacity
-  char *record_data = page_handle_.frame->page.data +
-      page_header_->first_record_offset + (index * page_header_->record_size);
-  memcpy(record_data, data, page_header_->record_real_size);
+  if (pax_layout_ != nullptr) {
+    write_columns(index, data);
+  } else {
+    memcpy(record_data(index), data, page_header_->record_real_size);
+  }
 
   RC rc = disk_buffer_pool_->mark_dirty(&page_handle_);
   if (rc != RC::SUCCESS) {
@@ -192,9 +266,14 @@ RC RecordPageHandler::update_record(const Record *rec) {
               page_handle_.frame->page.page_num);
     ret = RC::RECORD_RECORD_NOT_EXIST;
   } else {
-    char *record_data = page_handle_.frame->page.data +
-        page_header_->first_record_offset + (rec->rid.slot_num * page_header_->record_size);
-    memcpy(record_data, rec->data, page_header_->record_real_size);
+    if (pax_layout_ != nullptr) {
+      write_columns(rec->rid.slot_num, rec->data);
+    } else {
+      char *data = record_data(rec->rid.slot_num);
+      if (data != rec->data) { // 记录可能是直接在页面上修改的
+        memcpy(data, rec->data, page_header_->record_real_size);
+      }
+    }
     ret = disk_buffer_pool_->mark_dirty(&page_handle_);
     if (ret != RC::SUCCESS) {
       LOG_ERROR("Failed to mark page dirty. ret=%s", strrc(ret));
@@ -261,8 +340,13 @@ RC RecordPageHandler::get_record(const RID *rid, Record *rec) {
     return RC::RECORD_RECORD_NOT_EXIST;
   }
 
-  char *data = page_handle_.frame->page.data +
-      page_header_->first_record_offset + (page_header_->record_size * rid->slot_num);
+  char *data = nullptr;
+  if (pax_layout_ != nullptr) {
+    read_columns(rid->slot_num, row_buffer_.data());
+    data = row_buffer_.data();
+  } else {
+    data = record_data(rid->slot_num);
+  }
 
   // rec->valid = true;
   rec->rid = *rid;
@@ -298,9 +382,12 @@ RC RecordPageHandler::get_next_record(Record *rec) {
   rec->rid.slot_num = index;
   // rec->valid = true;
 
-  char *record_data = page_handle_.frame->page.data +
-      page_header_->first_record_offset + (index * page_header_->record_size);
-  rec->data = record_data;
+  if (pax_layout_ != nullptr) {
+    read_columns(index, row_buffer_.data());
+    rec->data = row_buffer_.data();
+  } else {
+    rec->data = record_data(index);
+  }
   return RC::SUCCESS;
 }
 
@@ -315,6 +402,36 @@ bool RecordPageHandler::is_full() const {
   return page_header_->record_num >= page_header_->record_capacity;
 }
 
+int RecordPageHandler::record_num() const {
+  return page_header_->record_num;
+}
+
+int RecordPageHandler::record_capacity() const {
+  return page_header_->record_capacity;
+}
+
+const char *RecordPageHandler::column_data(int record_offset, int *stride) const {
+  if (pax_layout_ == nullptr) {
+    *stride = page_header_->record_size;
+    return page_handle_.frame->page.data + page_header_->first_record_offset + record_offset;
+  }
+  int index = pax_layout_->find_column(record_offset);
+  if (index < 0) {
+    return nullptr;
+  }
+  *stride = pax_layout_->column_len(index);
+  return page_handle_.frame->page.data + minipage_offsets_[index];
+}
+
+void RecordPageHandler::get_slot_selection(std::vector<int> &selected) const {
+  selected.clear();
+  selected.reserve(page_header_->record_capacity);
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  for (int index = bitmap.next_setted_bit(0); index >= 0; index = bitmap.next_setted_bit(index + 1)) {
+    selected.push_back(index);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileHandler::RecordFileHandler() :
@@ -322,7 +439,7 @@ RecordFileHandler::RecordFileHandler() :
     file_id_(-1) {
 }
 
-RC RecordFileHandler::init(DiskBufferPool &buffer_pool, int file_id) {
+RC RecordFileHandler::init(DiskBufferPool &buffer_pool, int file_id, const PaxLayout *pax_layout) {
 
   RC ret = RC::SUCCESS;
 
@@ -333,6 +450,7 @@ RC RecordFileHandler::init(DiskBufferPool &buffer_pool, int file_id) {
 
   disk_buffer_pool_ = &buffer_pool;
   file_id_ = file_id;
+  pax_layout_ = pax_layout;
 
   LOG_TRACE("Successfully open %d.", file_id);
   return ret;
@@ -357,7 +475,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   if (current_page_num < 0) {
     if (page_count >= 2) { // 当前buffer pool 有页面时才尝试加载第一页
       // 参考diskBufferPool，pageNum从1开始
-      if ((ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, 1)) != RC::SUCCESS) {
+      if ((ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, 1, pax_layout_)) != RC::SUCCESS) {
         LOG_ERROR("Failed to init record page handler.ret=%d", ret);
         return ret;
       }
@@ -375,11 +493,14 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     }
     if (current_page_num != record_page_handler_.get_page_num()) {
       record_page_handler_.deinit();
-      ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, current_page_num);
+      ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, current_page_num, pax_layout_);
       if (ret != RC::SUCCESS && ret != RC::BUFFERPOOL_INVALID_PAGE_NUM) {
         LOG_ERROR("Failed to init record page handler. page number is %d. ret=%d:%s", current_page_num, ret, strrc(ret));
         return ret;
       }
+      if (RC::BUFFERPOOL_INVALID_PAGE_NUM == ret) {
+        continue; // 页面已经被释放
+      }
     }
 
     if (!record_page_handler_.is_full()) {
@@ -399,7 +520,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
 
     current_page_num = page_handle.frame->page.page_num;
     record_page_handler_.deinit();
-    ret = record_page_handler_.init_empty_page(*disk_buffer_pool_, file_id_, current_page_num, record_size);
+    ret = record_page_handler_.init_empty_page(*disk_buffer_pool_, file_id_, current_page_num, record_size, pax_layout_);
     if (ret != RC::SUCCESS) {
       LOG_ERROR("Failed to init empty page. file_id:%d, ret:%d", file_id_, ret);
       if (RC::SUCCESS != disk_buffer_pool_->unpin_page(&page_handle)) {
@@ -421,7 +542,7 @@ RC RecordFileHandler::update_record(const Record *rec) {
   RC ret = RC::SUCCESS;
 
   RecordPageHandler page_handler;
-  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rec->rid.page_num)) != RC::SUCCESS) {
+  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rec->rid.page_num, pax_layout_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init record page handler.page number=%d, file_id=%d",
               rec->rid.page_num, file_id_);
     return ret;
@@ -434,7 +555,7 @@ RC RecordFileHandler::delete_record(const RID *rid) {
 
   RC ret = RC::SUCCESS;
   RecordPageHandler page_handler;
-  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num)) != RC::SUCCESS) {
+  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num, pax_layout_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init record page handler.page number=%d, file_id:%d",
               rid->page_num, file_id_);
     return ret;
@@ -442,7 +563,11 @@ RC RecordFileHandler::delete_record(const RID *rid) {
   return page_handler.delete_record(rid);
 }
 
-RC RecordFileHandler::get_record(const RID *rid, Record *rec) {
+void RecordFileHandler::unpin_insert_page() {
+  record_page_handler_.deinit();
+}
+
+RC RecordFileHandler::get_record(const RID *rid, Record *rec, std::vector<char> &row_buffer) {
   //lock?
   RC ret = RC::SUCCESS;
   if (nullptr == rid || nullptr == rec) {
@@ -450,13 +575,152 @@ RC RecordFileHandler::get_record(const RID *rid, Record *rec) {
     return RC::INVALID_ARGUMENT;
   }
   RecordPageHandler page_handler;
-  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num)) != RC::SUCCESS) {
+  if ((ret != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num, pax_layout_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init record page handler.page number=%d, file_id:%d",
               rid->page_num, file_id_);
     return ret;
   }
 
-  return page_handler.get_record(rid, rec);
+  ret = page_handler.get_record(rid, rec);
+  if (RC::SUCCESS == ret && pax_layout_ != nullptr) {
+    // page_handler中拼装的记录随着它一起释放，需要拷贝出来
+    row_buffer.assign(rec->data, rec->data + pax_layout_->record_size());
+    rec->data = row_buffer.data();
+  }
+  return ret;
+}
+
+RC RecordFileHandler::get_records(const RID *rids, int rid_num, void *context,
+                                  RC (*record_reader)(Record *record, void *context)) {
+  if (rid_num <= 0) {
+    return RC::SUCCESS;
+  }
+  if (nullptr == rids) {
+    LOG_ERROR("Invalid rids, it is null.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  std::vector<RID> sorted_rids(rids, rids + rid_num);
+  std::sort(sorted_rids.begin(), sorted_rids.end(), [](const RID &r1, const RID &r2) {
+    return r1.page_num < r2.page_num || (r1.page_num == r2.page_num && r1.slot_num < r2.slot_num);
+  });
+
+  // 预取的窗口，每次进入新页面时提示后面的几个页面
+  const int prefetch_window = 4;
+  PageNum prefetched_page_num = -1;
+  RC rc = RC::SUCCESS;
+  size_t i = 0;
+  while (i < sorted_rids.size()) {
+    const PageNum page_num = sorted_rids[i].page_num;
+    int prefetched = 0;
+    for (size_t j = i + 1; j < sorted_rids.size() && prefetched < prefetch_window; j++) {
+      if (sorted_rids[j].page_num == sorted_rids[j - 1].page_num) {
+        continue;
+      }
+      if (sorted_rids[j].page_num > prefetched_page_num) {
+        disk_buffer_pool_->prefetch_page(file_id_, sorted_rids[j].page_num);
+        prefetched_page_num = sorted_rids[j].page_num;
+      }
+      prefetched++;
+    }
+
+    RecordPageHandler page_handler;
+    rc = page_handler.init(*disk_buffer_pool_, file_id_, page_num, pax_layout_);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to init record page handler.page number=%d, file_id:%d", page_num, file_id_);
+      return rc;
+    }
+    size_t next = i;
+    for (; next < sorted_rids.size() && sorted_rids[next].page_num == page_num; next++) {
+      Record record;
+      rc = page_handler.get_record(&sorted_rids[next], &record);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      rc = record_reader(&record, context);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    i = next;
+  }
+  return rc;
+}
+
+RC RecordFileHandler::estimate_record_num(int *record_num) {
+  *record_num = 0;
+  int page_count = 0;
+  RC rc = disk_buffer_pool_->get_page_count(file_id_, &page_count);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  // 插入时优先填满前面的页面，只有最后一个页面可能是不满的。页面被释放时跳过
+  RecordPageHandler page_handler;
+  for (PageNum page_num = page_count - 1; page_num >= 1; page_num--) {
+    rc = page_handler.init(*disk_buffer_pool_, file_id_, page_num, pax_layout_);
+    if (rc == RC::BUFFERPOOL_INVALID_PAGE_NUM) {
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    *record_num = (page_num - 1) * page_handler.record_capacity() + page_handler.record_num();
+    break;
+  }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::count_records(int trx_offset, void *context, bool (*trx_checker)(int32_t trx, void *context),
+                                    int64_t *count) {
+  *count = 0;
+  int page_count = 0;
+  RC rc = disk_buffer_pool_->get_page_count(file_id_, &page_count);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  RecordPageHandler page_handler;
+  std::vector<int> slots;
+  for (PageNum page_num = 1; page_num < page_count; page_num++) {
+    page_handler.deinit();
+    rc = page_handler.init(*disk_buffer_pool_, file_id_, page_num, pax_layout_);
+    if (rc == RC::BUFFERPOOL_INVALID_PAGE_NUM) {
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    *count += page_handler.record_num();
+    if (trx_checker == nullptr) {
+      continue;
+    }
+
+    // 已提交的记录事务字段是0，只有其它值才需要判断可见性。PAX页面上事务字段是连续的一列
+    int stride = 0;
+    const char *trx_column = page_handler.column_data(trx_offset, &stride);
+    page_handler.get_slot_selection(slots);
+    for (int slot : slots) {
+      int32_t trx = 0;
+      if (trx_column != nullptr) {
+        memcpy(&trx, trx_column + (size_t)slot * stride, sizeof(trx));
+      } else {
+        RID rid;
+        rid.page_num = page_num;
+        rid.slot_num = slot;
+        Record record;
+        rc = page_handler.get_record(&rid, &record);
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        memcpy(&trx, record.data + trx_offset, sizeof(trx));
+      }
+      if (trx != 0 && !trx_checker(trx, context)) {
+        (*count)--;
+      }
+    }
+  }
+  return RC::SUCCESS;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -467,7 +731,8 @@ RecordFileScanner::RecordFileScanner() :
     condition_filter_(nullptr) {
 }
 
-RC RecordFileScanner::open_scan(DiskBufferPool & buffer_pool, int file_id, ConditionFilter *condition_filter)
+RC RecordFileScanner::open_scan(DiskBufferPool & buffer_pool, int file_id, ConditionFilter *condition_filter,
+                                const PaxLayout *pax_layout)
 {
   close_scan();
 
@@ -475,6 +740,7 @@ RC RecordFileScanner::open_scan(DiskBufferPool & buffer_pool, int file_id, Condi
   file_id_ = file_id;
 
   condition_filter_ = condition_filter;
+  pax_layout_ = pax_layout;
   return RC::SUCCESS;
 }
 
@@ -491,6 +757,8 @@ RC RecordFileScanner::close_scan() {
 }
 
 RC RecordFileScanner::get_first_record(Record *rec) {
+  // 重新开始扫描时第一个页面也要重新过滤
+  record_page_handler_.deinit();
   rec->rid.page_num = 1; // from 1 参考DiskBufferPool
   rec->rid.slot_num = -1;
   // rec->valid = false;
@@ -520,24 +788,31 @@ RC RecordFileScanner::get_next_record(Record *rec) {
 
     if (current_record.rid.page_num != record_page_handler_.get_page_num()) {
       record_page_handler_.deinit();
-      ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, current_record.rid.page_num);
+      ret = record_page_handler_.init(*disk_buffer_pool_, file_id_, current_record.rid.page_num, pax_layout_);
       if (ret != RC::SUCCESS && ret != RC::BUFFERPOOL_INVALID_PAGE_NUM) {
         LOG_ERROR("Failed to init record page handler. page num=%d", current_record.rid.page_num);
         return ret;
       }
 
       if (RC::BUFFERPOOL_INVALID_PAGE_NUM == ret) {
+        // 页面已经被释放。如果它是最后一个页面，扫描结束
         current_record.rid.page_num++;
         current_record.rid.slot_num = -1;
+        ret = RC::RECORD_EOF;
         continue;
       }
+
+      // 进入新的页面时先按列过滤整个页面，得到剩下的槽位。PAX页面上只有剩下的记录才需要拼装成行
+      record_page_handler_.get_slot_selection(selected_);
+      selected_num_ = (int)selected_.size();
+      selected_pos_ = 0;
+      selected_exact_ = condition_filter_ == nullptr ||
+                        condition_filter_->filter_columns(record_page_handler_, selected_.data(), &selected_num_);
     }
-    
-    ret = record_page_handler_.get_next_record(&current_record);
+
+    ret = next_selected_record(&current_record);
     if (RC::SUCCESS == ret) {
-      if (condition_filter_ == nullptr || condition_filter_->filter(current_record)) {
-        break; // got one
-      }
+      break; // got one
     } else if (RC::RECORD_EOF == ret) {
       current_record.rid.page_num++;
       current_record.rid.slot_num = -1;
@@ -551,3 +826,24 @@ RC RecordFileScanner::get_next_record(Record *rec) {
   }
   return ret;
 }
+
+RC RecordFileScanner::next_selected_record(Record *rec) {
+  while (selected_pos_ < selected_num_) {
+    const int slot = selected_[selected_pos_++];
+    if (slot <= rec->rid.slot_num) {
+      continue;
+    }
+    rec->rid.slot_num = slot;
+    RC rc = record_page_handler_.get_record(&rec->rid, rec);
+    if (rc == RC::RECORD_RECORD_NOT_EXIST) {
+      continue; // 过滤之后被删除了
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (selected_exact_ || condition_filter_->filter(*rec)) {
+      return RC::SUCCESS;
+    }
+  }
+  return RC::RECORD_EOF;
+}
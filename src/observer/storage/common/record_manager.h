@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_STORAGE_COMMON_RECORD_MANAGER_H_
 #define __OBSERVER_STORAGE_COMMON_RECORD_MANAGER_H_
 
+#include <vector>
 #include "storage/default/disk_buffer_pool.h"
 
 typedef int SlotNum;
@@ -45,12 +46,53 @@ struct Record
   char *data; // record's data
 };
 
+/**
+ * PAX(Partition Attributes Across)页面的列布局。
+ * 页面内每一列的值连续存放在一个minipage中，扫描时只需要读取条件涉及的列。
+ * 对外仍然按行提供记录，列的顺序和偏移与行格式的记录一致
+ */
+class PaxLayout {
+public:
+  void add_column(int len) {
+    offsets_.push_back(record_size_);
+    lens_.push_back(len);
+    record_size_ += len;
+  }
+
+  int column_num() const {
+    return (int)lens_.size();
+  }
+  int column_offset(int index) const {
+    return offsets_[index];
+  }
+  int column_len(int index) const {
+    return lens_[index];
+  }
+  int record_size() const {
+    return record_size_;
+  }
+
+  /**
+   * 根据列在行记录中的偏移找到列，找不到返回-1
+   */
+  int find_column(int record_offset) const;
+
+private:
+  std::vector<int> offsets_;
+  std::vector<int> lens_;
+  int record_size_ = 0;
+};
+
 class RecordPageHandler {
 public:
   RecordPageHandler();
   ~RecordPageHandler();
-  RC init(DiskBufferPool &buffer_pool, int file_id, PageNum page_num);
-  RC init_empty_page(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, int record_size);
+  /**
+   * pax_layout 不为空时按照PAX格式访问页面，需要与创建页面时的布局一致
+   */
+  RC init(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, const PaxLayout *pax_layout = nullptr);
+  RC init_empty_page(DiskBufferPool &buffer_pool, int file_id, PageNum page_num, int record_size,
+                     const PaxLayout *pax_layout = nullptr);
   RC deinit();
 
   RC insert_record(const char *data, RID *rid);
@@ -64,6 +106,9 @@ public:
       return rc;
     }
     rc = updater(record);
+    if (pax_layout_ != nullptr) {
+      write_columns(rid->slot_num, record.data);
+    }
     disk_buffer_pool_->mark_dirty(&page_handle_);
     return rc;
   }
@@ -77,6 +122,30 @@ public:
   PageNum get_page_num() const;
 
   bool is_full() const;
+  int  record_num() const;
+  int  record_capacity() const;
+
+  bool is_pax() const {
+    return pax_layout_ != nullptr;
+  }
+
+  /**
+   * 页面上的某一列，第i个槽位的值在 column_data + i * stride 处。
+   * PAX页面上是列的minipage，stride是列的长度；行格式的页面上stride是记录占用的空间大小。
+   * 参数是列在行记录中的偏移，PAX页面上没有这一列时返回nullptr
+   */
+  const char *column_data(int record_offset, int *stride) const;
+
+  /**
+   * 页面上所有记录的槽位号，按顺序排列，作为按列过滤的初始选择向量
+   */
+  void get_slot_selection(std::vector<int> &selected) const;
+
+private:
+  void init_pax_layout();
+  char *record_data(int slot_num);
+  void write_columns(int slot_num, const char *data);
+  void read_columns(int slot_num, char *data) const;
 
 private:
   DiskBufferPool * disk_buffer_pool_;
@@ -84,12 +153,16 @@ private:
   BPPageHandle     page_handle_;
   PageHeader    *  page_header_;
   char *           bitmap_;
+
+  const PaxLayout *  pax_layout_ = nullptr;
+  std::vector<int>   minipage_offsets_; // 每一列的minipage在页面中的偏移
+  std::vector<char>  row_buffer_;       // PAX页面上拼装出来的行记录
 };
 
 class RecordFileHandler {
 public:
   RecordFileHandler();
-  RC init(DiskBufferPool &buffer_pool, int file_id);
+  RC init(DiskBufferPool &buffer_pool, int file_id, const PaxLayout *pax_layout = nullptr);
   void close();
 
   /**
@@ -116,19 +189,46 @@ public:
   RC insert_record(const char *data, int record_size, RID *rid);
 
   /**
-   * 获取指定文件中标识符为rid的记录内容到rec指向的记录结构中
+   * 放下插入时缓存的页面。页面上的记录删空后才能释放，vacuum搬迁之前调用，调用方保证没有并发的插入
+   */
+  void unpin_insert_page();
+
+  /**
+   * 获取指定文件中标识符为rid的记录内容到rec指向的记录结构中。
+   * PAX格式的记录拼装在调用者提供的row_buffer中，rec->data在row_buffer下一次使用之前有效。
+   * 多个会话会同时读取同一个文件，所以缓冲区不能放在handler中
    * @param rid
    * @param rec
+   * @param row_buffer 行存格式不使用
    * @return
    */
-  RC get_record(const RID *rid, Record *rec);
+  RC get_record(const RID *rid, Record *rec, std::vector<char> &row_buffer);
+
+  /**
+   * 批量获取记录。rid按照页号排序后每个页面只加载一次，并提前预取后面要访问的页面。
+   * 记录按照rid的顺序交给record_reader，record_reader返回失败时停止
+   * @param rids 记录标识符，不要求有序
+   * @param rid_num rid的个数
+   */
+  RC get_records(const RID *rids, int rid_num, void *context, RC (*record_reader)(Record *record, void *context));
+
+  /**
+   * 估算文件中的记录个数。假设除了最后一个页面之外都是满的，只需要读取最后一个页面
+   */
+  RC estimate_record_num(int *record_num);
+
+  /**
+   * 统计文件中的记录个数，不拼装记录：逐个页面累加页头中的record_num。
+   * trx_checker不为空时再检查页面上每条记录偏移trx_offset处的事务字段，返回false的记录不计数
+   */
+  RC count_records(int trx_offset, void *context, bool (*trx_checker)(int32_t trx, void *context), int64_t *count);
 
   template<class RecordUpdater> // 改成普通模式, 不使用模板
   RC update_record_in_place(const RID *rid, RecordUpdater updater) {
 
     RC rc = RC::SUCCESS;
     RecordPageHandler page_handler;
-    if ((rc != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num)) != RC::SUCCESS) {
+    if ((rc != page_handler.init(*disk_buffer_pool_, file_id_, rid->page_num, pax_layout_)) != RC::SUCCESS) {
       return rc;
     }
 
@@ -138,6 +238,7 @@ public:
 private:
   DiskBufferPool  *   disk_buffer_pool_;
   int                 file_id_;                    // 参考DiskBufferPool中的fileId
+  const PaxLayout *   pax_layout_ = nullptr;
 
   RecordPageHandler   record_page_handler_;        // 目前只有insert record使用
 };
@@ -158,9 +259,11 @@ public:
    * @param file_id 
    * @param condition_num 
    * @param conditions
+   * @param pax_layout 不为空表示文件是PAX格式，会先按列过滤整个页面
    * @return
    */
-  RC open_scan(DiskBufferPool & buffer_pool, int file_id, ConditionFilter *condition_filter);
+  RC open_scan(DiskBufferPool & buffer_pool, int file_id, ConditionFilter *condition_filter,
+               const PaxLayout *pax_layout = nullptr);
 
   /**
    * 关闭一个文件扫描，释放相应的资源
@@ -179,12 +282,24 @@ public:
    */
   RC get_next_record(Record *rec);
 
+private:
+  /**
+   * 在当前页面上找下一条被选中的记录
+   */
+  RC next_selected_record(Record *rec);
+
 private:
   DiskBufferPool  *   disk_buffer_pool_;
   int                 file_id_;                    // 参考DiskBufferPool中的fileId
 
   ConditionFilter *   condition_filter_;
   RecordPageHandler   record_page_handler_;
+
+  const PaxLayout *   pax_layout_ = nullptr;
+  std::vector<int>    selected_;                   // 当前页面按列过滤后剩下的槽位
+  int                 selected_num_ = 0;
+  int                 selected_pos_ = 0;           // 下一个要返回的槽位在selected_中的位置
+  bool                selected_exact_ = false;     // 为true时剩下的槽位不需要再逐条过滤
 };
 
 
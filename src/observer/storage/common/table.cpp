@@ -14,7 +14,9 @@ See the Mulan PSL v2 for more details. */
 
 #include <limits.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <algorithm>
+#include <iterator>
 
 #include "storage/common/table.h"
 #include "storage/common/table_meta.h"
@@ -26,31 +28,61 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/meta_util.h"
 #include "storage/common/index.h"
 #include "storage/common/bplus_tree_index.h"
+#include "storage/common/null_bitmap.h"
 #include "storage/trx/trx.h"
 #include "common/time/datetime.h"
 #include <string>
 #include "mydate.h"
 
+static std::atomic<uint64_t> data_version_clock(0);
+
+/**
+ * 在作用域内持有表的共享闩
+ */
+class TableLatchGuard {
+public:
+  explicit TableLatchGuard(pthread_rwlock_t &latch) : latch_(latch) {
+    pthread_rwlock_rdlock(&latch_);
+  }
+  ~TableLatchGuard() {
+    pthread_rwlock_unlock(&latch_);
+  }
+
+private:
+  pthread_rwlock_t &latch_;
+};
+
 
 Table::Table() : 
     data_buffer_pool_(nullptr),
     file_id_(-1),
-    record_handler_(nullptr) {
+    record_handler_(nullptr),
+    data_version_(++data_version_clock) {
+  pthread_rwlock_init(&latch_, nullptr);
 }
 
 Table::~Table() {
   delete record_handler_;
   record_handler_ = nullptr;
+  delete pax_layout_;
+  pax_layout_ = nullptr;
 
   if (data_buffer_pool_ != nullptr && file_id_ >= 0) {
     data_buffer_pool_->close_file(file_id_);
     data_buffer_pool_ = nullptr;
   }
 
+  if (dict_fd_ >= 0) {
+    close(dict_fd_);
+    dict_fd_ = -1;
+  }
+
+  pthread_rwlock_destroy(&latch_);
   LOG_INFO("Table has been closed: %s", name());
 }
 
-RC Table::create(const char *path, const char *name, const char *base_dir, int attribute_count, const AttrInfo attributes[]) {
+RC Table::create(const char *path, const char *name, const char *base_dir, int attribute_count, const AttrInfo attributes[],
+                 StorageFormat storage_format) {
 
   if (nullptr == name || common::is_blank(name)) {
     LOG_WARN("Name cannot be empty");
@@ -84,7 +116,7 @@ RC Table::create(const char *path, const char *name, const char *base_dir, int a
   close(fd);
 
   // 创建文件
-  if ((rc = table_meta_.init(name, attribute_count, attributes)) != RC::SUCCESS) {
+  if ((rc = table_meta_.init(name, attribute_count, attributes, storage_format)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init table meta. name:%s, ret:%d", name, rc);
     return rc; // delete table file
   }
@@ -130,10 +162,15 @@ RC Table::open(const char *meta_file, const char *base_dir) {
   }
   fs.close();
 
-  // 加载数据文件
-  RC rc = init_record_handler(base_dir);
-
   base_dir_ = base_dir;
+  RC rc = load_dicts();
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to load dictionaries of table %s. rc=%d:%s", name(), rc, strrc(rc));
+    return rc;
+  }
+
+  // 加载数据文件
+  rc = init_record_handler(base_dir);
 
   const int index_num = table_meta_.index_num();
   for (int i = 0; i < index_num; i++) {
@@ -162,23 +199,33 @@ RC Table::open(const char *meta_file, const char *base_dir) {
     }
     indexes_.push_back(index);
   }
+
+  load_stats();
   return rc;
 }
 
 RC Table::commit_insert(Trx *trx, const RID &rid) {
+  TableLatchGuard latch_guard(latch_);
   Record record;
-  RC rc = record_handler_->get_record(&rid, &record);
+  std::vector<char> row_buffer;
+  RC rc = record_handler_->get_record(&rid, &record, row_buffer);
   if (rc != RC::SUCCESS) {
     return rc;
   }
 
-  return trx->commit_insert(this, record);
+  rc = trx->commit_insert(this, record);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  return write_back(&record);
 }
 
 RC Table::rollback_insert(Trx *trx, const RID &rid) {
+  TableLatchGuard latch_guard(latch_);
 
   Record record;
-  RC rc = record_handler_->get_record(&rid, &record);
+  std::vector<char> row_buffer;
+  RC rc = record_handler_->get_record(&rid, &record, row_buffer);
   if (rc != RC::SUCCESS) {
     return rc;
   }
@@ -235,9 +282,12 @@ RC Table::insert_record(Trx *trx, Record *record) {
     }
     return rc;
   }
+  modified_rows_++;
+  bump_data_version();
   return rc;
 }
 RC Table::insert_record(Trx *trx, int value_num, const Value *values, int insert_num) {
+  TableLatchGuard latch_guard(latch_);
   if (value_num <= 0 || nullptr == values || value_num % insert_num != 0) {
     LOG_ERROR("Invalid argument. value num=%d, values=%p", value_num, values);
     return RC::INVALID_ARGUMENT;
@@ -368,6 +418,186 @@ const TableMeta &Table::table_meta() const {
 //   return RC::SUCCESS;
 // }
 
+RC Table::write_meta(const TableMeta &table_meta) {
+  std::lock_guard<std::mutex> lock(meta_mutex_);
+  // 创建元数据临时文件
+  std::string tmp_file = table_meta_file(base_dir_.c_str(), name()) + ".tmp";
+  std::fstream fs;
+  fs.open(tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR;
+  }
+  if (table_meta.serialize(fs) < 0) {
+    LOG_ERROR("Failed to dump new table meta to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
+    return RC::IOERR;
+  }
+  fs.close();
+
+  // 覆盖原始元数据文件
+  std::string meta_file = table_meta_file(base_dir_.c_str(), name());
+  int ret = rename(tmp_file.c_str(), meta_file.c_str());
+  if (ret != 0) {
+    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) on table (%s). " \
+              "system error=%d:%s", tmp_file.c_str(), meta_file.c_str(), name(), errno, strerror(errno));
+    return RC::IOERR;
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::dict_encode(const FieldMeta *field, const char *value, int &code) {
+  Dictionary *dict = field->dict();
+  if (dict == nullptr) {
+    LOG_ERROR("Field %s of table %s is not dictionary encoded", field->name(), name());
+    return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+  }
+
+  code = dict->code(value);
+  if (code != Dictionary::INVALID_CODE) {
+    return RC::SUCCESS;
+  }
+
+  std::lock_guard<std::mutex> lock(dict_mutex_);
+  bool added = false;
+  code = dict->get_or_add(value, added);
+  if (code == Dictionary::INVALID_CODE) {
+    return RC::GENERIC_ERROR;
+  }
+  if (!added) {
+    return RC::SUCCESS;
+  }
+
+  // 新增的编码要在使用它的记录之前持久化，否则重启后记录中的编码无法解析。
+  // 只在字典文件末尾追加这一个字符串，不重写整个元数据文件
+  RC rc = RC::IOERR_WRITE;
+  if (!dict_append_disabled_) {
+    rc = append_dict(field, code, dict->value(code));
+  }
+  if (rc != RC::SUCCESS) {
+    // 编码已经分配，改为把完整的字典随元数据保存
+    rc = write_meta(table_meta_);
+  }
+  return rc;
+}
+
+/**
+ * 字典文件的一项：字段名的长度、字段名、编码、字符串的长度、字符串，长度和编码都是int
+ */
+RC Table::append_dict(const FieldMeta *field, int code, const char *value) {
+  if (dict_fd_ < 0) {
+    std::string dict_file = table_dict_file(base_dir_.c_str(), name());
+    dict_fd_ = ::open(dict_file.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+    if (dict_fd_ < 0) {
+      LOG_ERROR("Failed to open dictionary file %s, errmsg=%d:%s", dict_file.c_str(), errno, strerror(errno));
+      return RC::IOERR;
+    }
+  }
+
+  const int name_len = strlen(field->name());
+  const int value_len = strlen(value);
+  std::string entry;
+  entry.append((const char *)&name_len, sizeof(name_len));
+  entry.append(field->name(), name_len);
+  entry.append((const char *)&code, sizeof(code));
+  entry.append((const char *)&value_len, sizeof(value_len));
+  entry.append(value, value_len);
+  struct stat st;
+  if (fstat(dict_fd_, &st) != 0) {
+    LOG_ERROR("Failed to stat dictionary file of table %s, errmsg=%d:%s", name(), errno, strerror(errno));
+    return RC::IOERR;
+  }
+  // 一次write写入整项，崩溃时最多留下末尾不完整的一项
+  const ssize_t written = write(dict_fd_, entry.data(), entry.size());
+  if (written == (ssize_t)entry.size()) {
+    return RC::SUCCESS;
+  }
+
+  // 写入了一部分时去掉这些字节，否则之后追加的项都会错位。
+  // 截断也可能失败，所以不再追加：文件末尾最多是一个不完整的项，打开表时会截掉，之后的编码都随元数据保存
+  LOG_ERROR("Failed to append dictionary file of table %s, written=%d/%d, errmsg=%d:%s",
+            name(), (int)written, (int)entry.size(), errno, strerror(errno));
+  if (written > 0 && ftruncate(dict_fd_, st.st_size) != 0) {
+    LOG_ERROR("Failed to truncate dictionary file of table %s, errmsg=%d:%s", name(), errno, strerror(errno));
+  }
+  close(dict_fd_);
+  dict_fd_ = -1;
+  dict_append_disabled_ = true;
+  return RC::IOERR_WRITE;
+}
+
+/**
+ * 在元数据中的字典后面补上字典文件中追加的编码。元数据重写时会带上当时完整的字典，这部分编码已经存在
+ */
+RC Table::load_dicts() {
+  std::string dict_file = table_dict_file(base_dir_.c_str(), name());
+  std::fstream fs;
+  fs.open(dict_file, std::ios_base::in | std::ios_base::binary);
+  if (!fs.is_open()) {
+    return RC::SUCCESS; // 还没有新增过编码
+  }
+  std::string data((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  fs.close();
+
+  size_t offset = 0;
+  auto read_int = [&data, &offset](int &value) {
+    if (offset + sizeof(value) > data.size()) {
+      return false;
+    }
+    memcpy(&value, data.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+  };
+  while (offset < data.size()) {
+    const size_t entry_offset = offset;
+    int name_len = 0;
+    int code = 0;
+    int value_len = 0;
+    if (!read_int(name_len) || name_len < 0 || offset + name_len > data.size()) {
+      offset = entry_offset;
+      break;
+    }
+    std::string field_name = data.substr(offset, name_len);
+    offset += name_len;
+    if (!read_int(code) || !read_int(value_len) || value_len < 0 || offset + value_len > data.size()) {
+      offset = entry_offset;
+      break;
+    }
+    std::string value = data.substr(offset, value_len);
+    offset += value_len;
+
+    const FieldMeta *field = table_meta_.field(field_name.c_str());
+    Dictionary *dict = field == nullptr ? nullptr : field->dict();
+    if (dict == nullptr) {
+      LOG_ERROR("Dictionary file of table %s refers to a field without dictionary: %s", name(), field_name.c_str());
+      return RC::GENERIC_ERROR;
+    }
+    if (code < dict->size()) {
+      if (value != dict->value(code)) {
+        LOG_ERROR("Dictionary file of table %s conflicts with table meta. field=%s, code=%d",
+                  name(), field_name.c_str(), code);
+        return RC::GENERIC_ERROR;
+      }
+      continue;
+    }
+    bool added = false;
+    if (code != dict->size() || dict->get_or_add(value.c_str(), added) != code || !added) {
+      LOG_ERROR("Invalid code in dictionary file of table %s. field=%s, code=%d, dictionary size=%d",
+                name(), field_name.c_str(), code, dict->size());
+      return RC::GENERIC_ERROR;
+    }
+  }
+
+  if (offset < data.size()) {
+    // 追加时崩溃留下的不完整的一项，这个编码还没有被记录使用
+    LOG_WARN("Truncate incomplete entry in dictionary file %s, offset=%d", dict_file.c_str(), (int)offset);
+    if (truncate(dict_file.c_str(), offset) != 0) {
+      LOG_ERROR("Failed to truncate dictionary file %s, errmsg=%d:%s", dict_file.c_str(), errno, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC Table::make_record(int value_num, const Value *values, char * &record_out) {
   // 检查字段类型是否一致
   if (value_num + table_meta_.sys_field_num() != table_meta_.field_num()) {
@@ -377,60 +607,27 @@ RC Table::make_record(int value_num, const Value *values, char * &record_out) {
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
     const Value &value = values[i];
+    if (value.type == IS_NULL) {
+      if (!field->nullable()) {
+        LOG_ERROR("Field cannot be null. field name=%s", field->name());
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
+      continue;
+    }
     AttrType type = field->type();
     switch (type)
     {
     case CHARS:
+    case DATES:
       if (value.type != CHARS) {
         LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
                 field->name(), field->type(), value.type);
         return RC::SCHEMA_FIELD_TYPE_MISMATCH;
       }
       break;
-    case CHARS_NULLABLE:
-      if (value.type != CHARS && value.type != IS_NULL) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
     case INTS:
-      if (value.type != INTS) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
-    case INTS_NULLABLE:
-      if (value.type != INTS && value.type != IS_NULL) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
     case FLOATS:
-      if (value.type != FLOATS) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
-    case FLOATS_NULLABLE:
-      if (value.type != FLOATS && value.type != IS_NULL) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
-    case DATES:
-      if (value.type != CHARS) {
-        LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
-                field->name(), field->type(), value.type);
-        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-      }
-      break;
-    case DATES_NULLABLE:
-      if (value.type != CHARS && value.type != IS_NULL) {
+      if (value.type != type) {
         LOG_ERROR("Invalid value type. field name=%s, type=%d, but given=%d",
                 field->name(), field->type(), value.type);
         return RC::SCHEMA_FIELD_TYPE_MISMATCH;
@@ -452,12 +649,15 @@ RC Table::make_record(int value_num, const Value *values, char * &record_out) {
   // 复制所有字段的值
   int record_size = table_meta_.record_size();
   char *record = new char [record_size];
+  memset(record, 0, record_size); // 系统字段(__trx、null位图)需要初始化为0
 
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
     const Value &value = values[i];
 
-    if(field->type() == TEXT){
+    if (value.type == IS_NULL) {
+      field->set_null(record, true);
+    } else if(field->type() == TEXT){
       std::string text_file_name = text_data_file(name(),field->name());
       std::fstream fs;
       fs.open(text_file_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
@@ -479,35 +679,14 @@ RC Table::make_record(int value_num, const Value *values, char * &record_out) {
         return RC::SCHEMA_FIELD_TYPE_MISMATCH;
       }
       memcpy(record + field->offset(), &date_int, field->len()); 
-    } else if (field->type() == DATES_NULLABLE) {
-      if (value.type == IS_NULL) {
-        int is_null = 1;
-        int offset = table_meta_.set_null_offset(i + normal_field_start_index);
-        memcpy(record + offset, &is_null, 4); 
-      } else {
-        MyDate date((char *)value.data);
-        int date_int = date.toInt();
-        if (date_int == -1) {
-          return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-        }
-        memcpy(record + field->offset(), &date_int, field->len()); 
-        int is_null = 0;
-        int offset = table_meta_.set_null_offset(i + normal_field_start_index);
-        memcpy(record + offset, &is_null, 4); 
-      }
-    } else if (field->type() == INTS_NULLABLE 
-            ||field->type() == FLOATS_NULLABLE 
-            ||field->type() == CHARS_NULLABLE) {
-      if (value.type == IS_NULL) {
-        int is_null = 1;
-        int offset = table_meta_.set_null_offset(i + normal_field_start_index);
-        memcpy(record + offset, &is_null, 4); 
-      } else {
-        memcpy(record + field->offset(), value.data, field->len());
-        int is_null = 0;
-        int offset = table_meta_.set_null_offset(i + normal_field_start_index);
-        memcpy(record + offset, &is_null, 4); 
+    } else if (field->dict() != nullptr) {
+      int code = Dictionary::INVALID_CODE;
+      RC rc = dict_encode(field, (const char *)value.data, code);
+      if (rc != RC::SUCCESS) {
+        delete[] record;
+        return rc;
       }
+      memcpy(record + field->offset(), &code, sizeof(code));
     } else{
       memcpy(record + field->offset(), value.data, field->len());
     }
@@ -531,8 +710,15 @@ RC Table::init_record_handler(const char *base_dir) {
     return rc;
   }
 
+  if (table_meta_.storage_format() == PAX_FORMAT) {
+    pax_layout_ = new PaxLayout();
+    for (int i = 0; i < table_meta_.field_num(); i++) {
+      pax_layout_->add_column(table_meta_.field(i)->len());
+    }
+  }
+
   record_handler_ = new RecordFileHandler();
-  rc = record_handler_->init(*data_buffer_pool_, data_buffer_pool_file_id);
+  rc = record_handler_->init(*data_buffer_pool_, data_buffer_pool_file_id, pax_layout_);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init record handler. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -570,6 +756,7 @@ RC Table::scan_record(Trx *trx, ConditionFilter *filter, int limit, void *contex
 }
 
 RC Table::scan_record(Trx *trx, ConditionFilter *filter, int limit, void *context, RC (*record_reader)(Record *record, void *context)) {
+  TableLatchGuard latch_guard(latch_);
   if (nullptr == record_reader) {
     return RC::INVALID_ARGUMENT;
   }
@@ -589,7 +776,7 @@ RC Table::scan_record(Trx *trx, ConditionFilter *filter, int limit, void *contex
 
   RC rc = RC::SUCCESS;
   RecordFileScanner scanner;
-  rc = scanner.open_scan(*data_buffer_pool_, file_id_, filter);
+  rc = scanner.open_scan(*data_buffer_pool_, file_id_, filter, pax_layout_);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. file id=%d. rc=%d:%s", file_id_, rc, strrc(rc));
     return rc;
@@ -617,42 +804,267 @@ RC Table::scan_record(Trx *trx, ConditionFilter *filter, int limit, void *contex
   return rc;
 }
 
+/**
+ * 按索引扫描时批量取记录的上下文，在取到的每条记录上做可见性判断和过滤
+ */
+class IndexScanBatchReader {
+public:
+  IndexScanBatchReader(Table *table, Trx *trx, ConditionFilter *filter, void *context,
+                       RC (*record_reader)(Record *, void *))
+      : table_(table), trx_(trx), filter_(filter), context_(context), record_reader_(record_reader) {
+  }
+
+  RC read(Record *record) {
+    if ((trx_ == nullptr || trx_->is_visible(table_, record)) && (filter_ == nullptr || filter_->filter(*record))) {
+      RC rc = record_reader_(record, context_);
+      if (rc != RC::SUCCESS) {
+        LOG_TRACE("Record reader break the table scanning. rc=%d:%s", rc, strrc(rc));
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  }
+
+private:
+  Table * table_;
+  Trx * trx_;
+  ConditionFilter * filter_;
+  void * context_;
+  RC (*record_reader_)(Record *, void *);
+};
+
+static RC index_scan_batch_reader(Record *record, void *context) {
+  IndexScanBatchReader *reader = (IndexScanBatchReader *)context;
+  return reader->read(record);
+}
+
 RC Table::scan_record_by_index(Trx *trx, IndexScanner *scanner, ConditionFilter *filter, int limit, void *context,
                                RC (*record_reader)(Record *, void *)) {
+  // 先从索引中攒一批rid，按页面批量取记录，避免同一个页面反复加载。批内的记录按rid的顺序返回
+  const int batch_size = 128;
   RC rc = RC::SUCCESS;
   RID rid;
-  Record record;
+  std::vector<RID> rids;
+  rids.reserve(batch_size);
+  IndexScanBatchReader batch_reader(this, trx, filter, context, record_reader);
   int record_count = 0;
-  while (record_count < limit) {
-    rc = scanner->next_entry(&rid);
+  bool index_eof = false;
+  while (record_count < limit && !index_eof) {
+    rids.clear();
+    while ((int)rids.size() < batch_size && record_count + (int)rids.size() < limit) {
+      rc = scanner->next_entry(&rid);
+      if (rc != RC::SUCCESS) {
+        break;
+      }
+      rids.push_back(rid);
+    }
     if (rc != RC::SUCCESS) {
-      if (RC::RECORD_EOF == rc || RC::RECORD_NO_MORE_IDX_IN_MEM == rc) {
-        rc = RC::SUCCESS;
+      if (RC::RECORD_EOF != rc && RC::RECORD_NO_MORE_IDX_IN_MEM != rc) {
+        LOG_ERROR("Failed to scan table by index. rc=%d:%s", rc, strrc(rc));
         break;
       }
-      LOG_ERROR("Failed to scan table by index. rc=%d:%s", rc, strrc(rc));
-      break;
+      rc = RC::SUCCESS;
+      index_eof = true;
     }
 
-    rc = record_handler_->get_record(&rid, &record);
+    rc = record_handler_->get_records(rids.data(), (int)rids.size(), &batch_reader, index_scan_batch_reader);
     if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to fetch record of rid=%d:%d, rc=%d:%s", rid.page_num, rid.slot_num, rc, strrc(rc));
+      LOG_ERROR("Failed to fetch records by index. rc=%d:%s", rc, strrc(rc));
       break;
     }
+    record_count += (int)rids.size();
+  }
 
-    if ((trx == nullptr || trx->is_visible(this, &record)) && (filter == nullptr || filter->filter(record))) {
-      rc = record_reader(&record, context);
+  scanner->destroy();
+  return rc;
+}
+
+static RC table_scanner_batch_reader(Record *record, void *context) {
+  TableScanner *scanner = (TableScanner *)context;
+  scanner->add_batch_record(record);
+  return RC::SUCCESS;
+}
+
+TableScanner::~TableScanner() {
+  close_scan();
+}
+
+void TableScanner::latch(Table *table) {
+  if (!latched_) {
+    pthread_rwlock_rdlock(&table->latch_);
+    latched_ = true;
+  }
+  table_ = table;
+}
+
+RC TableScanner::open_scan(Table *table, Trx *trx, ConditionFilter *filter) {
+  latch(table);
+  IndexScanner *index_scanner = table->find_index_for_scan(filter);
+  if (index_scanner != nullptr) {
+    open_index_scan(table, trx, filter, index_scanner, false);
+    return RC::SUCCESS;
+  }
+
+  table_ = table;
+  trx_ = trx;
+  filter_ = filter;
+
+  RC rc = record_scanner_.open_scan(*table->data_buffer_pool_, table->file_id_, filter, table->pax_layout_);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("failed to open scanner. file id=%d. rc=%d:%s", table->file_id_, rc, strrc(rc));
+    return rc;
+  }
+  record_scan_opened_ = true;
+  record_scan_started_ = false;
+  return RC::SUCCESS;
+}
+
+RC TableScanner::next_record(Record *record) {
+  if (index_scanner_ != nullptr) {
+    return next_index_record(record);
+  }
+  if (!record_scan_opened_) {
+    return RC::RECORD_EOF;
+  }
+
+  // get_next_record从上一条记录的位置继续扫描，所以当前记录保存在扫描器中
+  RC rc = RC::SUCCESS;
+  do {
+    if (!record_scan_started_) {
+      record_scan_started_ = true;
+      rc = record_scanner_.get_first_record(&current_record_);
+    } else {
+      rc = record_scanner_.get_next_record(&current_record_);
+    }
+  } while (rc == RC::SUCCESS && trx_ != nullptr && !trx_->is_visible(table_, &current_record_));
+  if (rc == RC::SUCCESS) {
+    *record = current_record_;
+  }
+  return rc;
+}
+
+RC TableScanner::open_scan(Table *table, Trx *trx, ConditionFilter *filter, const char *field_name, CompOp comp_op,
+                           const char *value, bool keep_index_order) {
+  // 先拿到闩再创建索引扫描器，创建时已经定位到了索引中的位置
+  latch(table);
+  IndexScanner *index_scanner = table->create_index_scanner(field_name, comp_op, value);
+  if (index_scanner == nullptr) {
+    close_scan();
+    return RC::SCHEMA_INDEX_NOT_EXIST;
+  }
+  open_index_scan(table, trx, filter, index_scanner, keep_index_order);
+  return RC::SUCCESS;
+}
+
+void TableScanner::open_index_scan(Table *table, Trx *trx, ConditionFilter *filter, IndexScanner *index_scanner,
+                                   bool keep_index_order) {
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+  }
+  table_ = table;
+  trx_ = trx;
+  filter_ = filter;
+  index_scanner_ = index_scanner;
+  index_eof_ = false;
+  keep_index_order_ = keep_index_order;
+  batch_rids_.clear();
+  batch_data_.clear();
+  batch_pos_ = 0;
+}
+
+void TableScanner::add_batch_record(const Record *record) {
+  const int record_size = table_->table_meta().record_size();
+  batch_rids_.push_back(record->rid);
+  batch_data_.insert(batch_data_.end(), record->data, record->data + record_size);
+}
+
+RC TableScanner::next_index_record(Record *record) {
+  // 与scan_record_by_index相同，攒一批rid后按页面批量取记录
+  const int batch_size = 128;
+  IndexScanBatchReader batch_reader(table_, trx_, filter_, this, table_scanner_batch_reader);
+  while (batch_pos_ >= batch_rids_.size()) {
+    if (index_eof_) {
+      return RC::RECORD_EOF;
+    }
+    batch_rids_.clear();
+    batch_data_.clear();
+    batch_pos_ = 0;
+    rids_.clear();
+
+    RC rc = RC::SUCCESS;
+    RID rid;
+    while ((int)rids_.size() < batch_size) {
+      rc = index_scanner_->next_entry(&rid);
       if (rc != RC::SUCCESS) {
-        LOG_TRACE("Record reader break the table scanning. rc=%d:%s", rc, strrc(rc));
         break;
       }
+      rids_.push_back(rid);
+    }
+    if (rc != RC::SUCCESS) {
+      if (RC::RECORD_EOF != rc && RC::RECORD_NO_MORE_IDX_IN_MEM != rc) {
+        LOG_ERROR("Failed to scan table by index. rc=%d:%s", rc, strrc(rc));
+        return rc;
+      }
+      index_eof_ = true;
     }
 
-    record_count++;
+    rc = table_->record_handler_->get_records(rids_.data(), (int)rids_.size(), &batch_reader, index_scan_batch_reader);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to fetch records by index. rc=%d:%s", rc, strrc(rc));
+      return rc;
+    }
+    if (keep_index_order_) {
+      restore_index_order();
+    }
   }
 
-  scanner->destroy();
-  return rc;
+  const int record_size = table_->table_meta().record_size();
+  record->rid = batch_rids_[batch_pos_];
+  record->data = batch_data_.data() + batch_pos_ * record_size;
+  batch_pos_++;
+  return RC::SUCCESS;
+}
+
+void TableScanner::restore_index_order() {
+  // 取出的记录按rid排好了序，按照索引中rid的顺序重新排列，过滤掉的记录不在其中
+  const int record_size = table_->table_meta().record_size();
+  std::vector<RID> rids;
+  std::vector<char> data;
+  data.reserve(batch_data_.size());
+  for (const RID &rid : rids_) {
+    std::vector<RID>::iterator iter = std::lower_bound(batch_rids_.begin(), batch_rids_.end(), rid,
+        [](const RID &rid1, const RID &rid2) {
+          return rid1.page_num < rid2.page_num || (rid1.page_num == rid2.page_num && rid1.slot_num < rid2.slot_num);
+        });
+    if (iter == batch_rids_.end() || !(*iter == rid)) {
+      continue;
+    }
+    const char *record = batch_data_.data() + (iter - batch_rids_.begin()) * record_size;
+    rids.push_back(rid);
+    data.insert(data.end(), record, record + record_size);
+  }
+  batch_rids_.swap(rids);
+  batch_data_.swap(data);
+}
+
+RC TableScanner::close_scan() {
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
+  if (record_scan_opened_) {
+    record_scanner_.close_scan();
+    record_scan_opened_ = false;
+  }
+  batch_rids_.clear();
+  batch_data_.clear();
+  batch_pos_ = 0;
+  keep_index_order_ = false;
+  if (latched_) {
+    pthread_rwlock_unlock(&table_->latch_);
+    latched_ = false;
+  }
+  return RC::SUCCESS;
 }
 
 class IndexInserter {
@@ -673,6 +1085,7 @@ static RC insert_index_record_reader_adapter(Record *record, void *context) {
 }
 
 RC Table::create_index(Trx *trx, const char *index_name, char * const attribute_name[], const bool unique, const size_t attribute_count) {
+  TableLatchGuard latch_guard(latch_);
   if (index_name == nullptr || common::is_blank(index_name) ||
       attribute_name == nullptr || attribute_count == 0) {
     return RC::INVALID_ARGUMENT;
@@ -723,27 +1136,11 @@ RC Table::create_index(Trx *trx, const char *index_name, char * const attribute_
     LOG_ERROR("Failed to add index (%s) on table (%s). error=%d:%s", index_name, name(), rc, strrc(rc));
     return rc;
   }
-  // 创建元数据临时文件
-  std::string tmp_file = table_meta_file(base_dir_.c_str(), name()) + ".tmp";
-  std::fstream fs;
-  fs.open(tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-  if (!fs.is_open()) {
-    LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
-    return RC::IOERR; // 创建索引中途出错，要做还原操作
-  }
-  if (new_table_meta.serialize(fs) < 0) {
-    LOG_ERROR("Failed to dump new table meta to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
-    return RC::IOERR;
-  }
-  fs.close();
-
-  // 覆盖原始元数据文件
-  std::string meta_file = table_meta_file(base_dir_.c_str(), name());
-  int ret = rename(tmp_file.c_str(), meta_file.c_str());
-  if (ret != 0) {
-    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) while creating index (%s) on table (%s). " \
-              "system error=%d:%s", tmp_file.c_str(), meta_file.c_str(), index_name, name(), errno, strerror(errno));
-    return RC::IOERR;
+  rc = write_meta(new_table_meta);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to write table meta while creating index (%s) on table (%s). rc=%d:%s",
+              index_name, name(), rc, strrc(rc));
+    return rc; // 创建索引中途出错，要做还原操作
   }
 
   table_meta_.swap(new_table_meta);
@@ -757,6 +1154,7 @@ RC Table::create_index(Trx *trx, const char *index_name, char * const attribute_
 class RecordUpdater {
 public:
   RecordUpdater(Table &table, Trx *trx, const ConDesc *update_desc) : table_(table), trx_(trx), update_desc_(update_desc) {
+    field_ = table.table_meta().find_field_by_offset(update_desc->attr_offset);
   }
 
   // RC update_record(Trx *trx, ConditionFilter *filter, const char *attribute_name, const Value *value, int condition_num, const Condition *conditions, int *updated_count) {
@@ -770,10 +1168,18 @@ public:
 
   RC update_record(Record *record) {
     RC rc = RC::SUCCESS;
+    old_data_.assign(record->data, record->data + table_.table_meta().record_size());
     // 更新record内容
     int attr_length = update_desc_->attr_length;
     int attr_offset = update_desc_->attr_offset;
-    if(update_desc_->is_text == true) {
+    if (update_desc_->value == nullptr) {
+      // 更新为null。字段的值清零，保证索引中null的键是确定的
+      if (field_ == nullptr || !field_->nullable()) {
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
+      memset(record->data + attr_offset, 0, attr_length);
+      field_->set_null(record->data, true);
+    } else if(update_desc_->is_text == true) {
       std::string text_file_name = (char *)(record->data + attr_offset);
       std::fstream fs;
       fs.open(text_file_name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
@@ -789,7 +1195,10 @@ public:
     else {
       memcpy(record->data + attr_offset, update_desc_->value, attr_length);
     }
-    rc = table_.update_record(trx_, record);
+    if (update_desc_->value != nullptr && field_ != nullptr) {
+      field_->set_null(record->data, false);
+    }
+    rc = table_.update_record(trx_, old_data_.data(), record);
     if (rc == RC::SUCCESS) {
       updated_count_++;
     }
@@ -804,7 +1213,9 @@ private:
   Table & table_;
   Trx *trx_;
   const ConDesc *update_desc_;
+  const FieldMeta *field_ = nullptr;
   int updated_count_ = 0;
+  std::vector<char> old_data_;          /// 更新前的记录，用来删除旧的索引项
 };
 
 static RC record_reader_update_adapter(Record *record, void *context) {
@@ -865,6 +1276,9 @@ RC Table::delete_record(Trx *trx, Record *record) {
   RC rc = RC::SUCCESS;
   if (trx != nullptr) {
     rc = trx->delete_record(this, record);
+    if (rc == RC::SUCCESS) {
+      rc = write_back(record);
+    }
   } else {
     rc = delete_entry_of_indexes(record->data, record->rid, false);// 重复代码 refer to commit_delete
     if (rc != RC::SUCCESS) {
@@ -874,13 +1288,19 @@ RC Table::delete_record(Trx *trx, Record *record) {
       rc = record_handler_->delete_record(&record->rid);
     }
   }
+  if (rc == RC::SUCCESS) {
+    modified_rows_++;
+    bump_data_version();
+  }
   return rc;
 }
 
 RC Table::commit_delete(Trx *trx, const RID &rid) {
+  TableLatchGuard latch_guard(latch_);
   RC rc = RC::SUCCESS;
   Record record;
-  rc = record_handler_->get_record(&rid, &record);
+  std::vector<char> row_buffer;
+  rc = record_handler_->get_record(&rid, &record, row_buffer);
   if (rc != RC::SUCCESS) {
     return rc;
   }
@@ -899,18 +1319,15 @@ RC Table::commit_delete(Trx *trx, const RID &rid) {
 }
 
 RC Table::commit_update(Trx *trx, const RID &rid) {
+  TableLatchGuard latch_guard(latch_);
   RC rc = RC::SUCCESS;
   Record record;
-  rc = record_handler_->get_record(&rid, &record);
+  std::vector<char> row_buffer;
+  rc = record_handler_->get_record(&rid, &record, row_buffer);
   if (rc != RC::SUCCESS) {
     return rc;
   }
-  rc = update_entry_of_indexes(record.data, record.rid, false);
-  if (rc != RC::SUCCESS) {
-    LOG_ERROR("Failed to delete indexes of record(rid=%d.%d). rc=%d:%s",
-              rid.page_num, rid.slot_num, rc, strrc(rc));// panic?
-  }
-
+  // 索引在更新记录时已经维护过了
   rc = record_handler_->update_record(&record);
   if (rc != RC::SUCCESS) {
     return rc;
@@ -920,14 +1337,28 @@ RC Table::commit_update(Trx *trx, const RID &rid) {
 }
 
 RC Table::rollback_delete(Trx *trx, const RID &rid) {
+  TableLatchGuard latch_guard(latch_);
   RC rc = RC::SUCCESS;
   Record record;
-  rc = record_handler_->get_record(&rid, &record);
+  std::vector<char> row_buffer;
+  rc = record_handler_->get_record(&rid, &record, row_buffer);
   if (rc != RC::SUCCESS) {
     return rc;
   }
 
-  return trx->rollback_delete(this, record); // update record in place
+  rc = trx->rollback_delete(this, record); // update record in place
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  return write_back(&record);
+}
+
+RC Table::write_back(Record *record) {
+  // 行存表的记录直接指向页面，事务在记录上的修改已经生效。PAX格式的记录是拼装出来的，需要写回页面
+  if (pax_layout_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  return record_handler_->update_record(record);
 }
 
 RC Table::insert_entry_of_indexes(const char *record, const RID &rid) {
@@ -963,6 +1394,33 @@ Index *Table::find_index(const char *index_name) const {
   return nullptr;
 }
 
+const IndexMeta *Table::find_single_field_index(const char *field_name) const {
+  char *field_names[] = {(char *)field_name};
+  return table_meta_.find_index_by_fields(field_names, 1);
+}
+
+IndexScanner *Table::create_index_scanner(const char *field_name, CompOp comp_op, const char *value) {
+  const IndexMeta *index_meta = find_single_field_index(field_name);
+  const FieldMeta *field_meta = table_meta_.field(field_name);
+  if (index_meta == nullptr || field_meta == nullptr) {
+    return nullptr;
+  }
+  Index *index = find_index(index_meta->name());
+  if (index == nullptr) {
+    return nullptr;
+  }
+
+  // 查找值的布局与索引键相同：字段可为null时头部是null位图
+  const int offset = field_meta->nullable() ? NULL_BITMAP_SIZE : 0;
+  std::vector<char> key(offset + field_meta->len(), 0);
+  if (value == nullptr) {
+    null_bitmap_set(key.data(), 0, true);
+  } else {
+    memcpy(key.data() + offset, value, field_meta->len());
+  }
+  return index->create_scanner(comp_op, key.data());
+}
+
 IndexScanner *Table::find_index_for_scan(const DefaultConditionFilter &filter) {
   return nullptr;//mjy
   const ConDesc *field_cond_desc = nullptr;
@@ -1004,6 +1462,14 @@ IndexScanner *Table::find_index_for_scan(const DefaultConditionFilter &filter) {
     memcpy(value_cond_desc->value, old_value, 4);
     return index_scanner;
   }
+  if (field_meta->dict() != nullptr) {
+    // 编码的大小顺序与字符串无关，只有等值条件可以走索引
+    if (filter.comp_op() != EQUAL_TO) {
+      return nullptr;
+    }
+    int code = field_meta->dict()->code((const char *)value_cond_desc->value);
+    return index->create_scanner(filter.comp_op(), (const char *)&code);
+  }
   return index->create_scanner(filter.comp_op(), (const char *)value_cond_desc->value);
 }
 
@@ -1031,6 +1497,103 @@ IndexScanner *Table::find_index_for_scan(const ConditionFilter *filter) {
   return nullptr;
 }
 
+int Table::estimate_record_num() {
+  int record_num = 0;
+  RC rc = record_handler_->estimate_record_num(&record_num);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to estimate record number of table %s. rc=%d:%s", name(), rc, strrc(rc));
+  }
+  return record_num;
+}
+
+static bool record_trx_visible(int32_t trx, void *context) {
+  return ((const Trx *)context)->is_visible(trx);
+}
+
+RC Table::count_record(Trx *trx, int64_t *count) {
+  TableLatchGuard latch_guard(latch_);
+  const int trx_offset = table_meta_.trx_field()->offset();
+  if (trx == nullptr) {
+    return record_handler_->count_records(trx_offset, nullptr, nullptr, count);
+  }
+  return record_handler_->count_records(trx_offset, trx, record_trx_visible, count);
+}
+
+/**
+ * 按索引的顺序查找第一条可见并且字段不为null的记录
+ */
+struct ExtremeRecordFinder {
+  Table *table;
+  Trx *trx;
+  RecordFileHandler *record_handler;
+  const FieldMeta *field;
+  void *context;
+  void (*record_reader)(const char *data, void *context);
+  RC rc = RC::SUCCESS;
+  std::vector<char> row_buffer;  /// PAX格式的记录拼装在这里，每次查找复用
+};
+
+/**
+ * 索引项中的值是否与记录中字段当前的值相同。更新记录时不删除旧的索引项，索引中可能有过时的项
+ */
+static bool index_key_matches(const FieldMeta &field, const char *key, const char *record) {
+  const int offset = field.nullable() ? NULL_BITMAP_SIZE : 0;
+  if (field.nullable() && null_bitmap_test(key, 0)) {
+    return field.is_null(record);
+  }
+  if (field.is_null(record)) {
+    return false;
+  }
+  if (field.type() == CHARS) {
+    return 0 == strncmp(key + offset, record + field.offset(), field.len());
+  }
+  return 0 == memcmp(key + offset, record + field.offset(), field.len());
+}
+
+static bool find_extreme_record_visitor(const char *key, const RID *rid, void *context) {
+  ExtremeRecordFinder &finder = *(ExtremeRecordFinder *)context;
+  Record record;
+  RC rc = finder.record_handler->get_record(rid, &record, finder.row_buffer);
+  if (rc == RC::RECORD_RECORD_NOT_EXIST || rc == RC::RECORD_INVALIDRID) {
+    return true;  // 过时的索引项，记录已经删除
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to get record by index entry. rid=%d.%d, rc=%d:%s", rid->page_num, rid->slot_num, rc, strrc(rc));
+    finder.rc = rc;
+    return false;
+  }
+  if ((finder.trx != nullptr && !finder.trx->is_visible(finder.table, &record)) || finder.field->is_null(record.data) ||
+      !index_key_matches(*finder.field, key, record.data)) {
+    return true;
+  }
+  finder.record_reader(record.data, finder.context);
+  return false;
+}
+
+RC Table::find_extreme_record(Trx *trx, const char *field_name, bool max, void *context,
+                              void (*record_reader)(const char *data, void *context)) {
+  TableLatchGuard latch_guard(latch_);
+  const IndexMeta *index_meta = find_single_field_index(field_name);
+  Index *index = index_meta == nullptr ? nullptr : find_index(index_meta->name());
+  if (index == nullptr) {
+    return RC::SCHEMA_INDEX_NOT_EXIST;
+  }
+
+  // 索引中null排在所有值的后面，找最大值时会先遇到null的记录
+  ExtremeRecordFinder finder;
+  finder.table = this;
+  finder.trx = trx;
+  finder.record_handler = record_handler_;
+  finder.field = table_meta_.field(field_name);
+  finder.context = context;
+  finder.record_reader = record_reader;
+  RC rc = index->visit_entries(max, &finder, find_extreme_record_visitor);
+  if (rc == RC::RECORD_EOF) {
+    rc = RC::SUCCESS;
+  }
+  return rc == RC::SUCCESS ? finder.rc : rc;
+}
+
 RC Table::sync() {
   RC rc = data_buffer_pool_->flush_all_pages(file_id_);
   if (rc != RC::SUCCESS) {
@@ -1050,6 +1613,343 @@ RC Table::sync() {
   return rc;
 }
 
+RC Table::vacuum(int fill_factor, int &page_budget, VacuumStat &stat) {
+  // 搬迁记录与前台的查询和修改互斥。表正在被使用时跳过本轮，不让前台请求等待回收
+  if (pthread_rwlock_trywrlock(&latch_) != 0) {
+    LOG_INFO("Table is in use, skip vacuum this round. table=%s", name());
+    return RC::SUCCESS;
+  }
+  // 插入时缓存的页面会pin住页面，搬空后无法释放
+  record_handler_->unpin_insert_page();
+  RC rc = vacuum_pages(fill_factor, page_budget, stat);
+  pthread_rwlock_unlock(&latch_);
+  return rc;
+}
+
+RC Table::vacuum_pages(int fill_factor, int &page_budget, VacuumStat &stat) {
+  int page_count = 0;
+  RC rc = data_buffer_pool_->get_page_count(file_id_, &page_count);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to get page count of table. table=%s, rc=%d:%s", name(), rc, strrc(rc));
+    return rc;
+  }
+
+  // 统计每个页面的记录个数，每轮最多用一半的预算，从上一轮结束的位置继续。
+  // 0号页面是文件头，record_num为-1表示页面还没有统计或者已经释放，不参与搬迁
+  std::vector<int> &record_nums = vacuum_record_nums_;
+  std::vector<int> &capacities = vacuum_capacities_;
+  record_nums.resize(page_count, -1);
+  capacities.resize(page_count, 0);
+  int census_budget = std::max(page_budget / 2, 1);
+  for (int i = 1; i < page_count && census_budget > 0 && page_budget > 0; i++) {
+    if (vacuum_census_cursor_ <= 0 || vacuum_census_cursor_ >= page_count) {
+      vacuum_census_cursor_ = 1;
+    }
+    const PageNum page_num = vacuum_census_cursor_++;
+    census_budget--;
+    page_budget--;
+
+    RecordPageHandler page_handler;
+    rc = page_handler.init(*data_buffer_pool_, file_id_, page_num, pax_layout_);
+    if (RC::BUFFERPOOL_INVALID_PAGE_NUM == rc) {
+      record_nums[page_num] = -1;
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to init record page handler. table=%s, page num=%d, rc=%d:%s",
+                name(), page_num, rc, strrc(rc));
+      return rc;
+    }
+    record_nums[page_num] = page_handler.record_num();
+    capacities[page_num] = page_handler.record_capacity();
+  }
+
+  // 从文件尾部挑选稀疏页面，把记录搬到文件前部有空闲的页面，这样搬空的页面一定可以释放。
+  // 统计的记录个数可能已经过时，搬迁时以页面上的实际情况为准
+  const int record_size = table_meta_.record_size();
+  const FieldMeta *trx_field = table_meta_.trx_field();
+  PageNum target_page_num = 1;
+  RecordPageHandler target_page;
+  std::vector<char> page_data;
+  std::vector<RID> page_rids;
+  for (PageNum page_num = page_count - 1; page_num > target_page_num && page_budget > 0; page_num--) {
+    const int record_num = record_nums[page_num];
+    if (record_num <= 0 || record_num * 100 >= capacities[page_num] * fill_factor) {
+      continue;
+    }
+
+    int free_slots = 0;
+    for (PageNum i = target_page_num; i < page_num && free_slots < record_num; i++) {
+      if (record_nums[i] >= 0) {
+        free_slots += capacities[i] - record_nums[i];
+      }
+    }
+    if (free_slots < record_num) {
+      break; // 更靠前的页面可用的空闲位置只会更少
+    }
+
+    // 先把记录拷贝出来，不能pin住源页面，否则记录删空后页面无法释放
+    page_budget--;
+    page_rids.clear();
+    bool busy = false;
+    {
+      RecordPageHandler page_handler;
+      rc = page_handler.init(*data_buffer_pool_, file_id_, page_num, pax_layout_);
+      if (RC::BUFFERPOOL_INVALID_PAGE_NUM == rc) {
+        record_nums[page_num] = -1;
+        continue;
+      }
+      if (rc != RC::SUCCESS) {
+        LOG_ERROR("Failed to init record page handler. table=%s, page num=%d, rc=%d:%s",
+                  name(), page_num, rc, strrc(rc));
+        return rc;
+      }
+      record_nums[page_num] = page_handler.record_num();
+      page_data.resize((size_t)page_handler.record_num() * record_size);
+      Record record;
+      for (rc = page_handler.get_first_record(&record); RC::SUCCESS == rc; rc = page_handler.get_next_record(&record)) {
+        if (*(int32_t *)(record.data + trx_field->offset()) != Trx::default_trx_id()) {
+          busy = true; // 有未提交事务在操作这条记录，不能搬迁
+          break;
+        }
+        memcpy(page_data.data() + page_rids.size() * record_size, record.data, record_size);
+        page_rids.push_back(record.rid);
+      }
+    }
+    if (busy || page_rids.empty() || (int)page_rids.size() != record_nums[page_num]) {
+      rc = RC::SUCCESS;
+      continue;
+    }
+
+    // 开始搬迁一个页面之后就把它搬完，目标页面不够时停止本轮回收
+    for (size_t i = 0; i < page_rids.size(); ) {
+      if (target_page.get_page_num() < 0) {
+        while (target_page_num < page_num &&
+               (record_nums[target_page_num] < 0 || record_nums[target_page_num] >= capacities[target_page_num])) {
+          target_page_num++;
+        }
+        if (target_page_num >= page_num) {
+          LOG_INFO("Vacuum table over, no more free slots. table=%s, pages released=%d, records moved=%d",
+                   name(), stat.pages_released, stat.records_moved);
+          return RC::SUCCESS;
+        }
+        page_budget--;
+        rc = target_page.init(*data_buffer_pool_, file_id_, target_page_num, pax_layout_);
+        if (RC::BUFFERPOOL_INVALID_PAGE_NUM == rc) {
+          record_nums[target_page_num] = -1;
+          continue;
+        }
+        if (rc != RC::SUCCESS) {
+          LOG_ERROR("Failed to init record page handler. table=%s, page num=%d, rc=%d:%s",
+                    name(), target_page_num, rc, strrc(rc));
+          return rc;
+        }
+        record_nums[target_page_num] = target_page.record_num();
+      }
+      if (target_page.is_full()) {
+        record_nums[target_page_num] = capacities[target_page_num];
+        target_page.deinit();
+        continue;
+      }
+
+      rc = relocate_record(target_page, page_data.data() + i * record_size, page_rids[i]);
+      if (rc != RC::SUCCESS) {
+        LOG_ERROR("Failed to relocate record. table=%s, rid=%d.%d, rc=%d:%s",
+                  name(), page_rids[i].page_num, page_rids[i].slot_num, rc, strrc(rc));
+        return rc;
+      }
+      record_nums[target_page_num]++;
+      record_nums[page_num]--;
+      stat.records_moved++;
+      i++;
+    }
+
+    RecordPageHandler page_handler;
+    if (RC::BUFFERPOOL_INVALID_PAGE_NUM == page_handler.init(*data_buffer_pool_, file_id_, page_num, pax_layout_)) {
+      record_nums[page_num] = -1;
+      stat.pages_released++;
+      stat.bytes_reclaimed += BP_PAGE_SIZE;
+    }
+  }
+
+  LOG_INFO("Vacuum table over. table=%s, pages released=%d, records moved=%d",
+           name(), stat.pages_released, stat.records_moved);
+  return RC::SUCCESS;
+}
+
+RC Table::analyze() {
+  TableLatchGuard latch_guard(latch_);
+  int page_count = 0;
+  RC rc = data_buffer_pool_->get_page_count(file_id_, &page_count);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to get page count of table. table=%s, rc=%d:%s", name(), rc, strrc(rc));
+    return rc;
+  }
+
+  // 等间隔地采样最多ANALYZE_SAMPLE_PAGES个页面，按采样页面上的平均记录数估算整张表的记录数
+  const int64_t modified_rows = modified_rows_.load();
+  const int data_pages = std::max(page_count - 1, 0);
+  const int step = std::max(1, (data_pages + ANALYZE_SAMPLE_PAGES - 1) / ANALYZE_SAMPLE_PAGES);
+  StatsCollector collector(table_meta_);
+  int live_pages = 0;
+  int sampled_pages = 0;
+  int64_t sampled_rows = 0;
+  for (PageNum page_num = 1; page_num < page_count; page_num++) {
+    const bool sample = (page_num - 1) % step == 0;
+    RecordPageHandler page_handler;
+    rc = page_handler.init(*data_buffer_pool_, file_id_, page_num, pax_layout_);
+    if (RC::BUFFERPOOL_INVALID_PAGE_NUM == rc) {
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to init record page handler. table=%s, page num=%d, rc=%d:%s",
+                name(), page_num, rc, strrc(rc));
+      return rc;
+    }
+    live_pages++;
+    if (!sample) {
+      continue;
+    }
+    sampled_pages++;
+    Record record;
+    for (rc = page_handler.get_first_record(&record); RC::SUCCESS == rc; rc = page_handler.get_next_record(&record)) {
+      collector.add_record(record.data);
+      sampled_rows++;
+    }
+  }
+
+  TableStats stats;
+  const int64_t row_count = sampled_pages == 0 ? 0 : sampled_rows * live_pages / sampled_pages;
+  collector.finish(row_count, live_pages, stats);
+  rc = write_stats(stats);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = std::make_shared<const TableStats>(std::move(stats));
+  }
+  modified_rows_ -= modified_rows;
+  LOG_INFO("Analyze table over. table=%s, pages=%d, sampled pages=%d, estimated rows=%lld",
+           name(), live_pages, sampled_pages, (long long)row_count);
+  return RC::SUCCESS;
+}
+
+std::shared_ptr<const TableStats> Table::stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+void Table::bump_data_version() {
+  data_version_ = ++data_version_clock;
+}
+
+bool Table::stats_stale(int threshold) const {
+  std::shared_ptr<const TableStats> stats = this->stats();
+  if (stats == nullptr) {
+    return true;
+  }
+  return modified_rows_.load() * 100 > std::max<int64_t>(stats->row_count, 1) * threshold;
+}
+
+RC Table::write_stats(const TableStats &stats) {
+  std::string stats_file = table_stats_file(base_dir_.c_str(), name());
+  std::string tmp_file = stats_file + ".tmp";
+  std::fstream fs;
+  fs.open(tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR;
+  }
+  if (stats.serialize(fs) < 0) {
+    LOG_ERROR("Failed to dump table stats to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
+    return RC::IOERR;
+  }
+  fs.close();
+
+  if (rename(tmp_file.c_str(), stats_file.c_str()) != 0) {
+    LOG_ERROR("Failed to rename tmp stats file (%s) to stats file (%s) on table (%s). " \
+              "system error=%d:%s", tmp_file.c_str(), stats_file.c_str(), name(), errno, strerror(errno));
+    return RC::IOERR;
+  }
+  return RC::SUCCESS;
+}
+
+void Table::load_stats() {
+  std::string stats_file = table_stats_file(base_dir_.c_str(), name());
+  std::fstream fs;
+  fs.open(stats_file, std::ios_base::in | std::ios_base::binary);
+  if (!fs.is_open()) {
+    return; // 还没有analyze过
+  }
+  std::shared_ptr<TableStats> stats = std::make_shared<TableStats>();
+  if (stats->deserialize(fs) < 0) {
+    LOG_WARN("Failed to load table stats, ignore it. table=%s, file=%s", name(), stats_file.c_str());
+    return;
+  }
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_ = stats;
+}
+
+/**
+ * 把一条记录的索引项从from换到to。插入新索引项失败时恢复旧的索引项
+ */
+static RC move_index_entry(Index *index, const char *data, const RID &from, const RID &to) {
+  RC rc = index->delete_entry(data, &from);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = index->insert_entry(data, &to);
+  if (rc != RC::SUCCESS) {
+    RC rc2 = index->insert_entry(data, &from);
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("Failed to restore index entry. index=%s, rid=%d.%d, rc=%d:%s",
+                index->index_meta().name(), from.page_num, from.slot_num, rc2, strrc(rc2));
+    }
+  }
+  return rc;
+}
+
+RC Table::relocate_record(RecordPageHandler &target_page, const char *data, const RID &rid) {
+  RID new_rid;
+  RC rc = target_page.insert_record(data, &new_rid);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  // 逐个索引把索引项换成新的位置，任何一步失败都把已经换过的索引项和新插入的记录撤销，记录和索引保持一致
+  size_t moved_index_num = 0;
+  for (; moved_index_num < indexes_.size(); moved_index_num++) {
+    rc = move_index_entry(indexes_[moved_index_num], data, rid, new_rid);
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+  if (RC::SUCCESS == rc) {
+    rc = record_handler_->delete_record(&rid);
+    if (RC::SUCCESS == rc) {
+      return rc;
+    }
+  }
+
+  LOG_WARN("Failed to relocate record, undo it. rid=%d.%d->%d.%d, rc=%d:%s",
+           rid.page_num, rid.slot_num, new_rid.page_num, new_rid.slot_num, rc, strrc(rc));
+  for (size_t i = 0; i < moved_index_num; i++) {
+    RC rc2 = move_index_entry(indexes_[i], data, new_rid, rid);
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("Failed to undo index entry of relocated record. index=%s, rid=%d.%d, rc=%d:%s",
+                indexes_[i]->index_meta().name(), rid.page_num, rid.slot_num, rc2, strrc(rc2));
+    }
+  }
+  RC rc2 = target_page.delete_record(&new_rid);
+  if (rc2 != RC::SUCCESS) {
+    LOG_PANIC("Failed to undo relocated record. rid=%d.%d, rc=%d:%s",
+              new_rid.page_num, new_rid.slot_num, rc2, strrc(rc2));
+  }
+  return rc;
+}
+
 RC Table::drop(const char *path, const char *name, const char *base_dir) {
   if (nullptr == name || common::is_blank(name)) {
     LOG_WARN("Name cannot be empty");
@@ -1085,35 +1985,51 @@ RC Table::drop(const char *path, const char *name, const char *base_dir) {
     LOG_INFO("Remove data_file %s failed", path);
   }
 
+  // 统计信息文件不一定存在
+  std::string stats_file = table_stats_file(base_dir, name);
+  remove(stats_file.c_str());
+  // 没有新增过字典编码时没有字典文件
+  std::string dict_file = table_dict_file(base_dir, name);
+  remove(dict_file.c_str());
+
   
   return rc;
 }
 
-RC Table::update_record(Trx *trx, Record *record) {
-  RC rc = RC::SUCCESS;
+RC Table::update_record(Trx *trx, const char *old_data, Record *record) {
+  // 记录的内容已经就地修改，索引要在这里维护：更新之后就找不到旧的键了
+  RC rc = update_entry_of_indexes(old_data, record->data, record->rid);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to update indexes of record (rid=%d.%d). rc=%d:%s",
+             record->rid.page_num, record->rid.slot_num, rc, strrc(rc));
+    memcpy(record->data, old_data, table_meta_.record_size());
+    return rc;
+  }
   if (trx != nullptr) {
     rc = trx->update_record(this, record);
-  } else {
-    rc = update_entry_of_indexes(record->data, record->rid, false);// 重复代码 refer to commit_delete
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to delete indexes of record (rid=%d.%d). rc=%d:%s",
-                record->rid.page_num, record->rid.slot_num, rc, strrc(rc));
-    } else {
-      rc = record_handler_->update_record(record);
+    if (rc == RC::SUCCESS) {
+      rc = write_back(record);
     }
+  } else {
+    rc = record_handler_->update_record(record);
+  }
+  if (rc == RC::SUCCESS) {
+    modified_rows_++;
+    bump_data_version();
   }
   return rc;
 }
 
-RC Table::update_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists) {
-  RC rc = RC::SUCCESS;
-  for (Index *index : indexes_) {
-    rc = index->update_entry(record, &rid);
+RC Table::update_entry_of_indexes(const char *old_record, const char *record, const RID &rid) {
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    RC rc = indexes_[i]->update_entry(old_record, record, &rid);
     if (rc != RC::SUCCESS) {
-      if (rc != RC::RECORD_INVALID_KEY || !error_on_not_exists) {
-        break;
+      // 已经更新的索引恢复成旧的键
+      for (size_t j = 0; j < i; j++) {
+        indexes_[j]->update_entry(record, old_record, &rid);
       }
+      return rc;
     }
   }
-  return rc;
+  return RC::SUCCESS;
 }
\ No newline at end of file
@@ -15,20 +15,33 @@ See the Mulan PSL v2 for more details. */
 #ifndef __OBSERVER_STORAGE_COMMON_TABLE_H__
 #define __OBSERVER_STORAGE_COMMON_TABLE_H__
 
+#include <pthread.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "storage/common/table_meta.h"
 #include "storage/common/condition_filter.h"
+#include "storage/common/record_manager.h"
+#include "storage/common/table_stats.h"
 
-class DiskBufferPool;
-class RecordFileHandler;
 class ConditionFilter;
 class DefaultConditionFilter;
-struct Record;
-struct RID;
 class Index;
 class IndexScanner;
 class RecordDeleter;
 class Trx;
 
+/**
+ * 一轮空间回收(vacuum)的统计信息
+ */
+struct VacuumStat {
+  int  pages_released = 0;  // 释放的页面个数
+  int  records_moved = 0;   // 搬迁的记录个数
+  long bytes_reclaimed = 0; // 回收的空间大小
+};
+
 class Table {
 public:
   Table();
@@ -41,8 +54,10 @@ public:
    * @param base_dir 表数据存放的路径
    * @param attribute_count 字段个数
    * @param attributes 字段
+   * @param storage_format 记录的存储格式
    */
-  RC create(const char *path, const char *name, const char *base_dir, int attribute_count, const AttrInfo attributes[]);
+  RC create(const char *path, const char *name, const char *base_dir, int attribute_count, const AttrInfo attributes[],
+            StorageFormat storage_format = ROW_FORMAT);
 
   /**
    * 创建一个表
@@ -69,6 +84,18 @@ public:
 
   RC create_index(Trx *trx, const char *index_name, char * const attribute_name[], const bool unique, const size_t attribute_count);
 
+  /**
+   * 查找只包含field_name一个字段的索引，没有时返回nullptr
+   */
+  const IndexMeta *find_single_field_index(const char *field_name) const;
+
+  /**
+   * 在field_name的单字段索引上创建扫描器，调用方负责destroy
+   * @param value 与记录中字段格式相同的比较值，为nullptr时表示null
+   * @return 字段上没有单字段索引时返回nullptr
+   */
+  IndexScanner *create_index_scanner(const char *field_name, CompOp comp_op, const char *value);
+
 public:
   const char *name() const;
 
@@ -76,6 +103,65 @@ public:
 
   RC sync();
 
+  /**
+   * 估算表中的记录个数，用来决定连接的顺序等。只读取最后一个数据页面
+   */
+  int estimate_record_num();
+
+  /**
+   * 统计对事务可见的记录个数，结果与全表扫描相同。只读取页头中的记录数和记录上的事务字段，不拼装记录
+   */
+  RC count_record(Trx *trx, int64_t *count);
+
+  /**
+   * 在field_name的单字段索引上按键的顺序找第一条对事务可见、字段不为null的记录交给record_reader，
+   * max为true时从最大的键开始找。没有这样的记录时不调用record_reader
+   * @return 字段上没有单字段索引时返回RC::SCHEMA_INDEX_NOT_EXIST
+   */
+  RC find_extreme_record(Trx *trx, const char *field_name, bool max, void *context,
+                         void (*record_reader)(const char *data, void *context));
+
+  /**
+   * 空间回收。把稀疏页面上的记录搬迁到文件前部有空闲的页面，并释放搬空的页面。
+   * 每个页面的记录个数分多轮统计，每轮从上一轮结束的位置继续。
+   * 回收期间持有表的排他闩，表正在被查询或修改时跳过本轮，不等待前台请求
+   * @param fill_factor 记录个数低于页面容量的百分之fill_factor时，认为页面是稀疏的
+   * @param page_budget 本轮最多读取的页面个数，包括统计和搬迁，用来限制回收占用的IO。返回时扣除已经读取的页面
+   * @param stat 回收的统计信息，在原有数值上累加
+   */
+  RC vacuum(int fill_factor, int &page_budget, VacuumStat &stat);
+
+  static const int ANALYZE_SAMPLE_PAGES = 128;  /// analyze最多采样的数据页面数
+
+  /**
+   * 采样扫描数据页面，收集记录数、每个字段的不同值个数、null的比例和直方图，保存到统计信息文件中
+   */
+  RC analyze();
+
+  /**
+   * 最近一次analyze收集的统计信息，没有收集过时返回nullptr
+   */
+  std::shared_ptr<const TableStats> stats() const;
+
+  /**
+   * 统计信息是否需要更新：没有统计信息，或者上次analyze之后修改的记录数超过记录数的百分之threshold
+   */
+  bool stats_stale(int threshold) const;
+
+  /**
+   * 表中数据的版本。插入、删除、更新以及提交和回滚修改过这张表的事务时，都换成一个全局递增的新值，
+   * 删除后重新创建的同名表也不会与之前的表版本相同
+   */
+  uint64_t data_version() const {
+    return data_version_.load();
+  }
+  void bump_data_version();
+
+  /**
+   * 获取字典编码字段中字符串对应的编码。字符串不在字典中时分配新的编码，并追加到表的字典文件中
+   */
+  RC dict_encode(const FieldMeta *field, const char *value, int &code);
+
 public:
   RC commit_insert(Trx *trx, const RID &rid);
   RC commit_delete(Trx *trx, const RID &rid);
@@ -91,18 +177,28 @@ private:
 
   RC insert_record(Trx *trx, Record *record);
   RC delete_record(Trx *trx, Record *record);
-  RC update_record(Trx *trx, Record *record);   // 更新于record参数的RID相同的record，更新后的record等于传入的参数
+  RC update_record(Trx *trx, const char *old_data, Record *record);   // 更新于record参数的RID相同的record，更新后的record等于传入的参数，old_data是更新前的内容
 
 private:
   friend class RecordUpdater;
   friend class RecordDeleter;
+  friend class TableScanner;
 
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
-  RC update_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
+  RC update_entry_of_indexes(const char *old_record, const char *record, const RID &rid);
 private:
+  RC vacuum_pages(int fill_factor, int &page_budget, VacuumStat &stat);
+  RC relocate_record(RecordPageHandler &target_page, const char *data, const RID &rid);
+
   RC init_record_handler(const char *base_dir);
+  RC write_back(Record *record);
   RC make_record(int value_num, const Value *values, char * &record_out);
+  RC write_meta(const TableMeta &table_meta);
+  RC write_stats(const TableStats &stats);
+  void load_stats();
+  RC load_dicts();
+  RC append_dict(const FieldMeta *field, int code, const char *value);
 
 private:
   Index *find_index(const char *index_name) const;
@@ -113,7 +209,83 @@ private:
   DiskBufferPool *        data_buffer_pool_; /// 数据文件关联的buffer pool
   int                     file_id_;
   RecordFileHandler *     record_handler_;   /// 记录操作
+  PaxLayout *             pax_layout_ = nullptr; /// PAX格式表的列布局，行存表为空
   std::vector<Index *>    indexes_;
+  std::mutex              meta_mutex_;       /// 串行化元数据文件的写入
+  std::mutex              dict_mutex_;       /// 串行化字典新增编码和字典文件的追加，文件中的编码按分配的顺序排列
+  int                     dict_fd_ = -1;     /// 字典文件，第一次新增编码时打开
+  bool                    dict_append_disabled_ = false; /// 追加失败后不再追加，之后新增的编码都随元数据保存
+  mutable std::mutex      stats_mutex_;      /// 保护stats_，analyze在后台线程中替换统计信息
+  std::shared_ptr<const TableStats> stats_;
+  std::atomic<int64_t>    modified_rows_{0}; /// 上次analyze之后插入、删除和更新的记录数
+  std::atomic<uint64_t>   data_version_;
+
+  /// 表级的闩。查询和修改记录时持有共享闩，可以重入；vacuum搬迁记录时持有排他闩，只会try，不会等待
+  pthread_rwlock_t        latch_;
+  std::vector<int>        vacuum_record_nums_;   /// vacuum统计的每个页面的记录个数，-1表示还没有统计或者已经释放
+  std::vector<int>        vacuum_capacities_;
+  PageNum                 vacuum_census_cursor_ = 1; /// 下一轮从这个页面继续统计
+};
+
+/**
+ * 拉取式的表扫描，每次返回一条对当前事务可见并且满足过滤条件的记录。
+ * 与Table::scan_record一样，有可用的索引时按索引扫描，否则顺序扫描数据文件
+ */
+class TableScanner {
+public:
+  TableScanner() = default;
+  ~TableScanner();
+
+  /**
+   * 打开扫描时获取表的共享闩，close_scan时释放，扫描期间vacuum不会搬迁记录
+   */
+  RC open_scan(Table *table, Trx *trx, ConditionFilter *filter);
+
+  /**
+   * 按field_name上的单字段索引扫描表，参数与Table::create_index_scanner相同
+   * @param keep_index_order 是否按索引中的顺序输出记录。否则每批记录按页面顺序输出
+   * @return 字段上没有单字段索引时返回RC::SCHEMA_INDEX_NOT_EXIST
+   */
+  RC open_scan(Table *table, Trx *trx, ConditionFilter *filter, const char *field_name, CompOp comp_op,
+               const char *value, bool keep_index_order);
+
+  /**
+   * 获取下一条记录。record中的数据在下一次调用之前有效
+   * @return 没有更多记录时返回RECORD_EOF
+   */
+  RC next_record(Record *record);
+
+  RC close_scan();
+
+  /**
+   * 按索引批量取记录时，保存一条可见并且满足条件的记录
+   */
+  void add_batch_record(const Record *record);
+
+private:
+  void latch(Table *table);
+  void open_index_scan(Table *table, Trx *trx, ConditionFilter *filter, IndexScanner *index_scanner,
+                       bool keep_index_order);
+  RC next_index_record(Record *record);
+  void restore_index_order();
+
+private:
+  Table *              table_ = nullptr;
+  Trx *                trx_ = nullptr;
+  ConditionFilter *    filter_ = nullptr;
+  RecordFileScanner    record_scanner_;
+  Record               current_record_;
+  bool                 record_scan_opened_ = false;
+  bool                 record_scan_started_ = false;
+  bool                 latched_ = false;
+
+  IndexScanner *       index_scanner_ = nullptr;
+  bool                 index_eof_ = false;
+  bool                 keep_index_order_ = false;
+  std::vector<RID>     rids_;          /// 从索引中攒出的一批rid
+  std::vector<RID>     batch_rids_;    /// 当前批次中取出的记录
+  std::vector<char>    batch_data_;
+  size_t               batch_pos_ = 0;
 };
 
 #endif // __OBSERVER_STORAGE_COMMON_TABLE_H__
\ No newline at end of file
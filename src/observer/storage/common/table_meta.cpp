@@ -23,6 +23,11 @@ See the Mulan PSL v2 for more details. */
 static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
+static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
+
+static const char *STORAGE_FORMAT_NAME[] = {"row", "pax"};
+
+static const char *NULL_FIELD_NAME = "__null";
 
 std::vector<FieldMeta> TableMeta::sys_fields_;
 
@@ -30,7 +35,9 @@ TableMeta::TableMeta(const TableMeta &other) :
         name_(other.name_),
         fields_(other.fields_),
         indexes_(other.indexes_),
-        record_size_(other.record_size_){
+        record_size_(other.record_size_),
+        sys_field_num_(other.sys_field_num_),
+        storage_format_(other.storage_format_){
 }
 
 void TableMeta::swap(TableMeta &other) noexcept{
@@ -38,21 +45,53 @@ void TableMeta::swap(TableMeta &other) noexcept{
   fields_.swap(other.fields_);
   indexes_.swap(other.indexes_);
   std::swap(record_size_, other.record_size_);
+  std::swap(sys_field_num_, other.sys_field_num_);
+  std::swap(storage_format_, other.storage_format_);
 }
 
 RC TableMeta::init_sys_fields() {
-  sys_fields_.reserve(1);
+  sys_fields_.reserve(2);
   FieldMeta field_meta;
   RC rc = field_meta.init(Trx::trx_field_name(), Trx::trx_field_type(), 0, Trx::trx_field_len(), false);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init trx field. rc = %d:%s", rc, strrc(rc));
     return rc;
   }
+  sys_fields_.push_back(field_meta);
 
+  // 紧跟在事务字段后面的是记录的null位图
+  rc = field_meta.init(NULL_FIELD_NAME, INTS, Trx::trx_field_len(), NULL_BITMAP_SIZE, false);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to init null field. rc = %d:%s", rc, strrc(rc));
+    return rc;
+  }
   sys_fields_.push_back(field_meta);
   return rc;
 }
-RC TableMeta::init(const char *name, int field_num, const AttrInfo attributes[]) {
+
+RC TableMeta::init_null_bits() {
+  const FieldMeta *bitmap_field = null_field();
+  int null_bit = 0;
+  for (int i = sys_field_num_; i < (int)fields_.size(); i++) {
+    FieldMeta &field = fields_[i];
+    if (!field.nullable()) {
+      continue;
+    }
+    if (bitmap_field == nullptr) {
+      LOG_ERROR("Table meta has nullable field but no null bitmap field. table name=%s, field name=%s",
+                name_.c_str(), field.name());
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    if (null_bit >= NULL_BITMAP_MAX_BITS) {
+      LOG_ERROR("Too many nullable fields. table name=%s, max=%d", name_.c_str(), NULL_BITMAP_MAX_BITS);
+      return RC::INVALID_ARGUMENT;
+    }
+    field.set_null_bit(bitmap_field->offset(), null_bit++);
+  }
+  return RC::SUCCESS;
+}
+
+RC TableMeta::init(const char *name, int field_num, const AttrInfo attributes[], StorageFormat storage_format) {
   if (nullptr == name || '\0' == name[0]) {
     LOG_ERROR("Name cannot be empty");
     return RC::INVALID_ARGUMENT;
@@ -92,11 +131,21 @@ RC TableMeta::init(const char *name, int field_num, const AttrInfo attributes[])
       continue;
     }
 
-    if (attr_info.type != IF_NULL) {
-      rc = fields_[i + sys_fields_.size()].init(attr_info.name, attr_info.type, field_offset, attr_info.length, true);
-    } else {
-      rc = fields_[i + sys_fields_.size()].init(attr_info.name, attr_info.type, field_offset, attr_info.length, false);
+    if (attr_info.type == CHARS && attr_info.dict) {
+      // 字典编码的字段在记录中只保存int编码，声明的长度记录在字典中
+      FieldMeta &field = fields_[i + sys_fields_.size()];
+      rc = field.init(attr_info.name, attr_info.type, field_offset, sizeof(int), true, attr_info.nullable);
+      if (rc != RC::SUCCESS) {
+        LOG_ERROR("Failed to init field meta. table name=%s, field name: %s", name, attr_info.name);
+        return rc;
+      }
+      field.set_dict(new Dictionary(attr_info.length));
+      field_offset += sizeof(int);
+      continue;
     }
+
+    rc = fields_[i + sys_fields_.size()].init(attr_info.name, attr_info.type, field_offset, attr_info.length, true,
+                                              attr_info.nullable);
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to init field meta. table name=%s, field name: %s", name, attr_info.name);
       return rc;
@@ -106,8 +155,14 @@ RC TableMeta::init(const char *name, int field_num, const AttrInfo attributes[])
   }
 
   record_size_ = field_offset;
+  sys_field_num_ = sys_fields_.size();
+  storage_format_ = storage_format;
 
   name_ = name;
+  rc = init_null_bits();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
   LOG_INFO("Init table meta success. table name=%s", name);
   return RC::SUCCESS;
 }
@@ -125,17 +180,14 @@ const FieldMeta * TableMeta::trx_field() const {
   return &fields_[0];
 }
 
-const FieldMeta * TableMeta::field(int index) const {
-  // int pos = 0;
-  for (int i=0; i<index; i++) {
-    const FieldMeta &field_meta = fields_[i];
-    if (field_meta.type() == INTS_NULLABLE 
-      || field_meta.type() == CHARS_NULLABLE
-      || field_meta.type() == FLOATS_NULLABLE
-      || field_meta.type() == DATES_NULLABLE) {
-      index++;
-    }
+const FieldMeta * TableMeta::null_field() const {
+  if (sys_field_num_ < 2) {
+    return nullptr;
   }
+  return &fields_[1];
+}
+
+const FieldMeta * TableMeta::field(int index) const {
   return &fields_[index];
 }
 const FieldMeta * TableMeta::field(const char *name) const {
@@ -159,31 +211,11 @@ const FieldMeta * TableMeta::find_field_by_offset(int offset) const {
   return nullptr;
 }
 int TableMeta::field_num() const {
-  // return fields_.size();
-  int num = 0;
-  for (const FieldMeta &field:fields_) {
-    AttrType type = field.type();
-    if (type != IF_NULL) {
-      num++;
-    }
-  }
-  return num;
-}
-
-int TableMeta::nullable_field_num() const {
-  int num = 0;
-  for (const FieldMeta &field:fields_) {
-    AttrType type = field.type();
-    if (type == INTS_NULLABLE || type == FLOATS_NULLABLE || type == CHARS_NULLABLE || type == DATES_NULLABLE) {
-      num++;
-    }
-  }
-  return num;
+  return fields_.size();
 }
 
 int TableMeta::sys_field_num() const {
-  return sys_fields_.size();
-  
+  return sys_field_num_;
 }
 
 const IndexMeta * TableMeta::index(const char *name) const {
@@ -234,28 +266,15 @@ int TableMeta::record_size() const {
   return record_size_;
 }
 
-// int set_null_offset(int i);
-int TableMeta::set_null_offset(int index) {
-  // int pos = 0;
-  for (int i=0; i<=index; i++) {
-    const FieldMeta &field_meta = fields_[i];
-    if (field_meta.type() == INTS_NULLABLE 
-      || field_meta.type() == CHARS_NULLABLE
-      || field_meta.type() == FLOATS_NULLABLE
-      || field_meta.type() == DATES_NULLABLE) {
-      index++;
-    }
-    // pos++;
-  }
-  const FieldMeta &field = fields_[index];
-  // memset(record + field.offset(), 1, field.len());
-  return field.offset();
+StorageFormat TableMeta::storage_format() const {
+  return storage_format_;
 }
 
 int TableMeta::serialize(std::ostream &ss) const {
 
   Json::Value table_value;
   table_value[FIELD_TABLE_NAME] = name_;
+  table_value[FIELD_STORAGE_FORMAT] = STORAGE_FORMAT_NAME[storage_format_];
 
   Json::Value fields_value;
   for (const FieldMeta & field : fields_) {
@@ -308,6 +327,22 @@ int TableMeta::deserialize(std::istream &is) {
 
   std::string table_name = table_name_value.asString();
 
+  // 没有记录存储格式的是之前创建的行存表
+  StorageFormat storage_format = ROW_FORMAT;
+  const Json::Value &storage_format_value = table_value[FIELD_STORAGE_FORMAT];
+  if (!storage_format_value.isNull()) {
+    if (!storage_format_value.isString()) {
+      LOG_ERROR("Invalid storage format. json value=%s", storage_format_value.toStyledString().c_str());
+      return -1;
+    }
+    if (0 == strcmp(storage_format_value.asCString(), STORAGE_FORMAT_NAME[PAX_FORMAT])) {
+      storage_format = PAX_FORMAT;
+    } else if (0 != strcmp(storage_format_value.asCString(), STORAGE_FORMAT_NAME[ROW_FORMAT])) {
+      LOG_ERROR("Unknown storage format %s", storage_format_value.asCString());
+      return -1;
+    }
+  }
+
   const Json::Value &fields_value = table_value[FIELD_FIELDS];
   if (!fields_value.isArray() || fields_value.size() <= 0) {
     LOG_ERROR("Invalid table meta. fields is not array, json value=%s", fields_value.toStyledString().c_str());
@@ -334,6 +369,13 @@ int TableMeta::deserialize(std::istream &is) {
   name_.swap(table_name);
   fields_.swap(fields);
   record_size_ = fields_.back().offset() + fields_.back().len();
+  storage_format_ = storage_format;
+  // 事务字段之后是null位图字段。加入null支持之前创建的表没有这个字段，所有字段都不可为null
+  sys_field_num_ = fields_.size() > 1 && 0 == strcmp(fields_[1].name(), NULL_FIELD_NAME) ? 2 : 1;
+  if (init_null_bits() != RC::SUCCESS) {
+    LOG_ERROR("Failed to init null bitmap of table %s", name_.c_str());
+    return -1;
+  }
 
   const Json::Value &indexes_value = table_value[FIELD_INDEXES];
   if (!indexes_value.empty()) {
@@ -379,5 +421,8 @@ void TableMeta::desc(std::ostream &os) const {
     index.desc(os);
     os << std::endl;
   }
+  if (storage_format_ != ROW_FORMAT) {
+    os << "\tstorage_format=" << STORAGE_FORMAT_NAME[storage_format_] << std::endl;
+  }
   os << ')' << std::endl;
 }
@@ -32,18 +32,21 @@ public:
 
   void swap(TableMeta &other) noexcept;
 
-  RC init(const char *name, int field_num, const AttrInfo attributes[]);
+  RC init(const char *name, int field_num, const AttrInfo attributes[], StorageFormat storage_format = ROW_FORMAT);
 
   RC add_index(const IndexMeta &index);
 
 public:
   const char * name() const;
   const FieldMeta * trx_field() const;
+  /**
+   * 记录头部的null位图字段。加入null支持之前创建的表没有这个字段，返回nullptr
+   */
+  const FieldMeta * null_field() const;
   const FieldMeta * field(int index) const;
   const FieldMeta * field(const char *name) const;
   const FieldMeta * find_field_by_offset(int offset) const;
   int field_num() const;
-  int nullable_field_num() const;
   int sys_field_num() const;
 
   const IndexMeta * index(const char *name) const;
@@ -51,9 +54,9 @@ public:
   const IndexMeta * find_index_by_fields(char * const field[], const int &file_num) const;
   const IndexMeta * index(int i) const;
   int index_num() const;
-  int set_null_offset(int i);
 
   int record_size() const;
+  StorageFormat storage_format() const;
 
 public:
   int  serialize(std::ostream &os) const override;
@@ -64,12 +67,15 @@ public:
 
 private:
   static RC init_sys_fields();
+  RC init_null_bits();
 private:
   std::string   name_;
   std::vector<FieldMeta>  fields_; // 包含sys_fields
   std::vector<IndexMeta>  indexes_;
 
   int  record_size_ = 0;
+  int  sys_field_num_ = 0; // 之前创建的表只有事务字段，没有null位图字段
+  StorageFormat storage_format_ = ROW_FORMAT;
 
   static std::vector<FieldMeta> sys_fields_;
 };
@@ -0,0 +1,343 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "json/json.h"
+#include "common/log/log.h"
+#include "storage/common/table_stats.h"
+#include "storage/common/table_meta.h"
+#include "storage/common/field_meta.h"
+#include "storage/common/dictionary.h"
+#include "storage/common/mydate.h"
+
+static const Json::StaticString FIELD_ROW_COUNT("row_count");
+static const Json::StaticString FIELD_PAGE_COUNT("page_count");
+static const Json::StaticString FIELD_SAMPLED_ROWS("sampled_rows");
+static const Json::StaticString FIELD_COLUMNS("columns");
+static const Json::StaticString FIELD_NDV("ndv");
+static const Json::StaticString FIELD_NULL_FRACTION("null_fraction");
+static const Json::StaticString FIELD_HISTOGRAM("histogram");
+
+HyperLogLog::HyperLogLog() : registers_(REGISTER_NUM, 0) {
+}
+
+uint64_t HyperLogLog::hash(const char *data, int len) {
+  // FNV-1a之后用murmur3的finalizer打散各个位
+  uint64_t h = 14695981039346656037ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= (uint8_t)data[i];
+    h *= 1099511628211ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+void HyperLogLog::add(const char *data, int len) {
+  add_hash(hash(data, len));
+}
+
+void HyperLogLog::add_hash(uint64_t hash) {
+  const int index = (int)(hash >> (64 - PRECISION));
+  const uint64_t rest = hash << PRECISION;
+  const uint8_t rank = rest == 0 ? (uint8_t)(64 - PRECISION + 1) : (uint8_t)(__builtin_clzll(rest) + 1);
+  registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) {
+  for (int i = 0; i < REGISTER_NUM; i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+double HyperLogLog::estimate() const {
+  double sum = 0;
+  int zeros = 0;
+  for (uint8_t reg : registers_) {
+    sum += 1.0 / ((uint64_t)1 << reg);
+    zeros += reg == 0;
+  }
+  const double m = REGISTER_NUM;
+  const double alpha = 0.7213 / (1 + 1.079 / m);
+  double estimate = alpha * m * m / sum;
+  // 值较少时很多寄存器还是0，用线性计数更准确
+  if (estimate <= 2.5 * m && zeros > 0) {
+    estimate = m * log(m / zeros);
+  }
+  return estimate;
+}
+
+double order_key(AttrType type, const char *data, int len) {
+  switch (type) {
+    case INTS:
+    case DATES: {
+      int value;
+      memcpy(&value, data, sizeof(value));
+      return value;
+    }
+    case FLOATS: {
+      float value;
+      memcpy(&value, data, sizeof(value));
+      return value;
+    }
+    case CHARS: {
+      // 前6个字节作为256进制的数，double可以精确表示
+      double key = 0;
+      bool ended = false;
+      for (int i = 0; i < 6; i++) {
+        ended = ended || i >= len || data[i] == 0;
+        key = key * 256 + (ended ? 0 : (uint8_t)data[i]);
+      }
+      return key;
+    }
+    default:
+      return 0;
+  }
+}
+
+/**
+ * 条件中常量的order_key。日期常量是日期字符串
+ */
+static bool value_order_key(const FieldMeta &field, const Value &value, double &key) {
+  if (value.data == nullptr) {
+    return false;
+  }
+  switch (field.type()) {
+    case INTS:
+    case FLOATS: {
+      if (value.type == INTS) {
+        key = *(const int *)value.data;
+      } else if (value.type == FLOATS) {
+        key = *(const float *)value.data;
+      } else {
+        return false;
+      }
+    } break;
+    case DATES: {
+      if (value.type != CHARS) {
+        return false;
+      }
+      MyDate date((char *)value.data);
+      if (date.toInt() == -1) {
+        return false;
+      }
+      key = date.toInt();
+    } break;
+    case CHARS: {
+      if (value.type != CHARS) {
+        return false;
+      }
+      key = order_key(CHARS, (const char *)value.data, strlen((const char *)value.data));
+    } break;
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
+
+double ColumnStats::less_fraction(double key) const {
+  if (histogram.size() < 2) {
+    return -1;
+  }
+  const int buckets = (int)histogram.size() - 1;
+  const int index = std::lower_bound(histogram.begin(), histogram.end(), key) - histogram.begin();
+  if (index == 0) {
+    return 0;
+  }
+  if (index > buckets) {
+    return 1;
+  }
+  const double low = histogram[index - 1];
+  const double high = histogram[index];
+  return (index - 1 + (key - low) / (high - low)) / buckets;
+}
+
+double ColumnStats::selectivity(const FieldMeta &field, CompOp comp_op, const Value &value) const {
+  const double not_null = 1 - null_fraction;
+  const double equal = ndv >= 1 ? not_null / ndv : not_null;
+  if (comp_op == IS) {
+    return null_fraction;
+  }
+  if (comp_op == IS_NOT) {
+    return not_null;
+  }
+  if (comp_op == EQUAL_TO) {
+    return equal;
+  }
+  if (comp_op == NOT_EQUAL) {
+    return not_null - equal;
+  }
+
+  double key = 0;
+  double less = -1;
+  if (value_order_key(field, value, key)) {
+    less = less_fraction(key);
+  }
+  if (less < 0) {
+    return not_null / 3;
+  }
+  double fraction = 0;
+  switch (comp_op) {
+    case LESS_THAN:
+      fraction = less;
+      break;
+    case LESS_EQUAL:
+      fraction = less + 1 / std::max(ndv, 1.0);
+      break;
+    case GREAT_THAN:
+      fraction = 1 - less - 1 / std::max(ndv, 1.0);
+      break;
+    case GREAT_EQUAL:
+      fraction = 1 - less;
+      break;
+    default:
+      return not_null / 2;
+  }
+  return not_null * std::min(1.0, std::max(0.0, fraction));
+}
+
+const ColumnStats *TableStats::column(const char *field_name) const {
+  std::map<std::string, ColumnStats>::const_iterator iter = columns.find(field_name);
+  return iter == columns.end() ? nullptr : &iter->second;
+}
+
+int TableStats::serialize(std::ostream &os) const {
+  Json::Value stats_value;
+  stats_value[FIELD_ROW_COUNT] = (Json::Int64)row_count;
+  stats_value[FIELD_PAGE_COUNT] = page_count;
+  stats_value[FIELD_SAMPLED_ROWS] = (Json::Int64)sampled_rows;
+
+  Json::Value columns_value(Json::objectValue);
+  for (const auto &column : columns) {
+    Json::Value column_value;
+    column_value[FIELD_NDV] = column.second.ndv;
+    column_value[FIELD_NULL_FRACTION] = column.second.null_fraction;
+    Json::Value histogram_value(Json::arrayValue);
+    for (double bound : column.second.histogram) {
+      histogram_value.append(bound);
+    }
+    column_value[FIELD_HISTOGRAM] = std::move(histogram_value);
+    columns_value[column.first] = std::move(column_value);
+  }
+  stats_value[FIELD_COLUMNS] = std::move(columns_value);
+
+  Json::StreamWriterBuilder builder;
+  Json::StreamWriter *writer = builder.newStreamWriter();
+  std::streampos old_pos = os.tellp();
+  writer->write(stats_value, &os);
+  int ret = (int)(os.tellp() - old_pos);
+  delete writer;
+  return ret;
+}
+
+int TableStats::deserialize(std::istream &is) {
+  Json::Value stats_value;
+  Json::CharReaderBuilder builder;
+  std::string errors;
+  if (!Json::parseFromStream(builder, is, &stats_value, &errors)) {
+    LOG_ERROR("Failed to deserialize table stats. error=%s", errors.c_str());
+    return -1;
+  }
+
+  const Json::Value &row_count_value = stats_value[FIELD_ROW_COUNT];
+  const Json::Value &page_count_value = stats_value[FIELD_PAGE_COUNT];
+  const Json::Value &columns_value = stats_value[FIELD_COLUMNS];
+  if (!row_count_value.isIntegral() || !page_count_value.isInt() || !columns_value.isObject()) {
+    LOG_ERROR("Invalid table stats. json value=%s", stats_value.toStyledString().c_str());
+    return -1;
+  }
+  row_count = row_count_value.asInt64();
+  page_count = page_count_value.asInt();
+  sampled_rows = stats_value[FIELD_SAMPLED_ROWS].asInt64();
+
+  columns.clear();
+  for (Json::Value::const_iterator iter = columns_value.begin(); iter != columns_value.end(); ++iter) {
+    const Json::Value &column_value = *iter;
+    ColumnStats &column = columns[iter.name()];
+    column.ndv = column_value[FIELD_NDV].asDouble();
+    column.null_fraction = column_value[FIELD_NULL_FRACTION].asDouble();
+    for (const Json::Value &bound : column_value[FIELD_HISTOGRAM]) {
+      column.histogram.push_back(bound.asDouble());
+    }
+  }
+  return 0;
+}
+
+StatsCollector::StatsCollector(const TableMeta &table_meta) {
+  for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+    const FieldMeta *field = table_meta.field(i);
+    if (field->type() == TEXT) {
+      continue;
+    }
+    Column column;
+    column.field = field;
+    columns_.push_back(std::move(column));
+  }
+}
+
+void StatsCollector::add_record(const char *record) {
+  sampled_rows_++;
+  for (Column &column : columns_) {
+    const FieldMeta *field = column.field;
+    if (field->nullable() && field->is_null(record)) {
+      column.null_num++;
+      continue;
+    }
+    const char *data = record + field->offset();
+    const int len = field->type() == CHARS ? strnlen(data, field->len()) : field->len();
+    column.hll.add(data, len);
+    if (field->dict() != nullptr) {
+      // 字典编码的字段按字符串的顺序生成直方图
+      int code;
+      memcpy(&code, data, sizeof(code));
+      const char *value = field->dict()->value(code);
+      column.keys.push_back(value == nullptr ? 0 : order_key(CHARS, value, strlen(value)));
+    } else {
+      column.keys.push_back(order_key(field->type(), data, len));
+    }
+  }
+}
+
+void StatsCollector::finish(int64_t row_count, int page_count, TableStats &stats) {
+  stats.row_count = row_count;
+  stats.page_count = page_count;
+  stats.sampled_rows = sampled_rows_;
+  stats.columns.clear();
+  for (Column &column : columns_) {
+    ColumnStats &column_stats = stats.columns[column.field->name()];
+    const int64_t not_null_num = sampled_rows_ - column.null_num;
+    column_stats.null_fraction = sampled_rows_ > 0 ? (double)column.null_num / sampled_rows_ : 0;
+
+    // 采样中几乎每个值都不同时，认为整张表上也是这样；否则采样中已经见到了大部分不同的值
+    double ndv = std::min(column.hll.estimate(), (double)not_null_num);
+    if (sampled_rows_ < row_count && ndv >= 0.9 * not_null_num) {
+      ndv = ndv * row_count / sampled_rows_;
+    }
+    column_stats.ndv = ndv;
+
+    std::vector<double> &keys = column.keys;
+    if (keys.empty()) {
+      continue;
+    }
+    std::sort(keys.begin(), keys.end());
+    const int buckets = std::min<int>((int)HISTOGRAM_BUCKETS, keys.size());
+    for (int i = 0; i <= buckets; i++) {
+      const size_t pos = std::min(keys.size() - 1, (size_t)((double)i * (keys.size() - 1) / buckets));
+      column_stats.histogram.push_back(keys[pos]);
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#ifndef __OBSERVER_STORAGE_COMMON_TABLE_STATS_H__
+#define __OBSERVER_STORAGE_COMMON_TABLE_STATS_H__
+
+#include <stdint.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rc.h"
+#include "sql/parser/parse_defs.h"
+
+class FieldMeta;
+class TableMeta;
+
+/**
+ * 估算不同值个数的HyperLogLog草图。
+ * 值的hash按前PRECISION位分到各个寄存器，寄存器记录剩余位中第一个1出现的最大位置
+ */
+class HyperLogLog {
+public:
+  static const int PRECISION = 12;
+  static const int REGISTER_NUM = 1 << PRECISION;
+
+  HyperLogLog();
+
+  void add(const char *data, int len);
+  void add_hash(uint64_t hash);
+  void merge(const HyperLogLog &other);
+  double estimate() const;
+
+  static uint64_t hash(const char *data, int len);
+
+private:
+  std::vector<uint8_t> registers_;
+};
+
+/**
+ * 一个字段的统计信息。histogram是等深直方图的边界，相邻两个边界之间的采样值个数相同，
+ * 值按order_key映射成double，保持原来的大小顺序
+ */
+struct ColumnStats {
+  double ndv = 0;            /// 不为null的不同值个数
+  double null_fraction = 0;
+  std::vector<double> histogram;
+
+  /**
+   * "字段 comp_op value"的选择率。value与条件中的常量格式相同
+   */
+  double selectivity(const FieldMeta &field, CompOp comp_op, const Value &value) const;
+
+  /**
+   * 值小于key的比例，不包括null
+   */
+  double less_fraction(double key) const;
+};
+
+struct TableStats {
+  int64_t row_count = 0;
+  int page_count = 0;
+  int64_t sampled_rows = 0;
+  std::map<std::string, ColumnStats> columns;
+
+  const ColumnStats *column(const char *field_name) const;
+
+  int serialize(std::ostream &os) const;
+  int deserialize(std::istream &is);
+};
+
+/**
+ * 从采样的记录中收集统计信息
+ */
+class StatsCollector {
+public:
+  static const int HISTOGRAM_BUCKETS = 32;
+
+  explicit StatsCollector(const TableMeta &table_meta);
+
+  void add_record(const char *record);
+
+  /**
+   * @param row_count 估算的表中的记录数
+   * @param page_count 表的数据页面数
+   */
+  void finish(int64_t row_count, int page_count, TableStats &stats);
+
+private:
+  struct Column {
+    const FieldMeta *field;
+    HyperLogLog hll;
+    int64_t null_num = 0;
+    std::vector<double> keys;  /// 采样值的order_key，用来生成直方图
+  };
+
+  std::vector<Column> columns_;
+  int64_t sampled_rows_ = 0;
+};
+
+/**
+ * 把字段的值映射成double，保持值的大小顺序。字符串取前几个字符，前缀相同的字符串映射成相同的值
+ */
+double order_key(AttrType type, const char *data, int len);
+
+#endif // __OBSERVER_STORAGE_COMMON_TABLE_STATS_H__
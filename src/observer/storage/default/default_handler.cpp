@@ -120,12 +120,13 @@ RC DefaultHandler::execute(const char *sql) {
   return RC::GENERIC_ERROR;
 }
 
-RC DefaultHandler::create_table(const char *dbname, const char *relation_name, int attribute_count, const AttrInfo *attributes) {
+RC DefaultHandler::create_table(const char *dbname, const char *relation_name, int attribute_count, const AttrInfo *attributes,
+                                StorageFormat storage_format) {
   Db *db = find_db(dbname);
   if (db == nullptr) {
     return RC::SCHEMA_DB_NOT_OPENED;
   }
-  return db->create_table(relation_name, attribute_count, attributes);
+  return db->create_table(relation_name, attribute_count, attributes, storage_format);
 }
 
 RC DefaultHandler::drop_table(const char *dbname, const char *relation_name) {
@@ -191,86 +192,31 @@ RC DefaultHandler::update_record(Trx *trx, const char *dbname, const char *relat
       LOG_WARN("No such field in condition. %s.%s", table->name(), attribute_name);
       return RC::SCHEMA_FIELD_MISSING;
   }
-  int is_null = 1;
-  int not_null = 0;
-  switch (field_update->type())
-  {
-  case INTS:
-  {
-    if (value->type != INTS) {
-      LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
+  int dict_code = Dictionary::INVALID_CODE;
+  int date_int = 0;
+  update_desc.is_attr = true;
+  update_desc.is_text = false;
+  update_desc.attr_length = field_update->len();
+  update_desc.attr_offset = field_update->offset();
+  update_desc.value = value->data;
+  if (value->type == IS_NULL) {
+    if (!field_update->nullable()) {
+      LOG_WARN("Field cannot be null. %s.%s", table->name(), attribute_name);
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    update_desc.is_attr = true;
-    update_desc.is_text = false;
-    // update_desc.nullable = false;
-    update_desc.attr_length = field_update->len();
-    update_desc.attr_offset = field_update->offset();
-    update_desc.value = value->data;
+    update_desc.value = nullptr; // 更新为null
+    return table->update_record(trx, &condition_filter, &update_desc, updated_count);
   }
-  break;
-  case INTS_NULLABLE:
+
+  switch (field_update->type())
   {
-    if (value->type != INTS && value->type != IS_NULL) {
-      LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
-    if (value->type == INTS) {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = field_update->len() + 4;
-      update_desc.attr_offset = field_update->offset();
-      update_desc.value = new char[field_update->len() + 4];
-      // update_desc.value = value->data;
-      memcpy(update_desc.value, value->data, field_update->len());
-      memcpy(update_desc.value + field_update->len(), &not_null, 4);
-      // delete update_desc.value;
-    } else {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = 4;
-      update_desc.attr_offset = field_update->offset() + field_update->len();
-      update_desc.value = &is_null;
-    }
-  }
-  break;
+  case INTS:
   case FLOATS:
   {
-    if (value->type != FLOATS) {
-      LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
-    update_desc.is_attr = true;
-    update_desc.is_text = false;
-    update_desc.attr_length = field_update->len();
-    update_desc.attr_offset = field_update->offset();
-    update_desc.value = value->data;
-  }
-  break;
-  case FLOATS_NULLABLE:
-  {
-    if (value->type != FLOATS && value->type != IS_NULL) {
+    if (value->type != field_update->type()) {
       LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    if (value->type == FLOATS) {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = field_update->len() + 4;
-      update_desc.attr_offset = field_update->offset();
-      // update_desc.value = value->data;
-      update_desc.value = new char[field_update->len() + 4];
-      // update_desc.value = value->data;
-      memcpy(update_desc.value, value->data, field_update->len());
-      memcpy(update_desc.value + field_update->len(), &not_null, 4);
-      // delete update_desc.value;
-    } else {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = 4;
-      update_desc.attr_offset = field_update->offset() + field_update->len();
-      update_desc.value = &is_null;
-    }
   }
   break;
   case TEXT:
@@ -279,11 +225,7 @@ RC DefaultHandler::update_record(Trx *trx, const char *dbname, const char *relat
       LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    update_desc.is_attr = true;
     update_desc.is_text = true;
-    update_desc.attr_length = field_update->len();
-    update_desc.attr_offset = field_update->offset();
-    update_desc.value = value->data;
   }
   break;
   case CHARS:
@@ -292,36 +234,13 @@ RC DefaultHandler::update_record(Trx *trx, const char *dbname, const char *relat
       LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    update_desc.is_attr = true;
-    update_desc.is_text = false;
-    update_desc.attr_length = field_update->len();
-    update_desc.attr_offset = field_update->offset();
-    update_desc.value = value->data;
-  }
-  break;
-  case CHARS_NULLABLE:
-  {
-    if (value->type != CHARS && value->type != IS_NULL) {
-      LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
-    if (value->type == CHARS) {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = field_update->len() + 4;
-      update_desc.attr_offset = field_update->offset();
-      // update_desc.value = value->data;
-      update_desc.value = new char[field_update->len() + 4];
-      // update_desc.value = value->data;
-      memcpy(update_desc.value, value->data, field_update->len());
-      memcpy(update_desc.value + field_update->len(), &not_null, 4);
-      // delete update_desc.value;
-    } else {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = 4;
-      update_desc.attr_offset = field_update->offset() + field_update->len();
-      update_desc.value = &is_null;
+    if (field_update->dict() != nullptr) {
+      // 字典编码的字段更新为字符串对应的编码
+      rc = table->dict_encode(field_update, (const char *)value->data, dict_code);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      update_desc.value = &dict_code;
     }
   }
   break;
@@ -331,42 +250,9 @@ RC DefaultHandler::update_record(Trx *trx, const char *dbname, const char *relat
       LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
-    update_desc.is_attr = true;
-    update_desc.is_text = false;
-    update_desc.attr_length = field_update->len();
-    update_desc.attr_offset = field_update->offset();
     MyDate date((char *)value->data);
-    int date_int = date.toInt();
+    date_int = date.toInt();
     update_desc.value = (void *)&date_int;
-    // update_desc.value = value->data;
-  }
-  break;
-  case DATES_NULLABLE:
-  {
-    if (value->type != CHARS && value->type != IS_NULL) {
-      LOG_WARN("Field type mismatch. %d.%d", field_update->type(), value->type);
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
-    }
-    if (value->type == CHARS) {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = field_update->len() + 4;
-      update_desc.attr_offset = field_update->offset();
-      MyDate date((char *)value->data);
-      int date_int = date.toInt();
-      // update_desc.value = (void *)&date_int;
-      update_desc.value = new char[field_update->len() + 4];
-      // update_desc.value = value->data;
-      memcpy(update_desc.value, (void *)&date_int, field_update->len());
-      memcpy(update_desc.value + field_update->len(), &not_null, 4);
-      // delete update_desc.value;
-    } else {
-      update_desc.is_attr = true;
-      update_desc.is_text = false;
-      update_desc.attr_length = 4;
-      update_desc.attr_offset = field_update->offset() + field_update->len();
-      update_desc.value = &is_null;
-    }
   }
   break;
   default:
@@ -421,4 +307,29 @@ RC DefaultHandler::sync() {
     }
   }
   return rc;
-}
\ No newline at end of file
+}
+RC DefaultHandler::vacuum(int fill_factor, int page_budget, VacuumStat &stat) {
+  RC rc = RC::SUCCESS;
+  for (const auto & db_pair: opened_dbs_) {
+    Db *db = db_pair.second;
+    rc = db->vacuum(fill_factor, page_budget, stat);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to vacuum db. name=%s, rc=%d:%s", db->name(), rc, strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC DefaultHandler::analyze(int threshold, int &analyzed_count) {
+  RC rc = RC::SUCCESS;
+  for (const auto & db_pair: opened_dbs_) {
+    Db *db = db_pair.second;
+    rc = db->analyze(threshold, analyzed_count);
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to analyze db. name=%s, rc=%d:%s", db->name(), rc, strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
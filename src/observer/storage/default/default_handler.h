@@ -79,9 +79,11 @@ public:
    * @param relName
    * @param attrCount
    * @param attributes
+   * @param storage_format 记录的存储格式，PAX_FORMAT表示页面内按列存放
    * @return
    */
-  RC create_table(const char *dbname, const char *relation_name, int attribute_count, const AttrInfo *attributes);
+  RC create_table(const char *dbname, const char *relation_name, int attribute_count, const AttrInfo *attributes,
+                  StorageFormat storage_format = ROW_FORMAT);
 
   /**
    * 销毁名为relName的表以及在该表上建立的所有索引
@@ -157,6 +159,19 @@ public:
 
   RC sync();
 
+  /**
+   * 对所有打开的表做一轮空间回收，参考 Table::vacuum
+   * @param fill_factor 稀疏页面的判定阈值(百分比)
+   * @param page_budget 本轮所有表一共最多读取的页面个数
+   */
+  RC vacuum(int fill_factor, int page_budget, VacuumStat &stat);
+
+  /**
+   * 重新收集统计信息过期的表的统计信息，参考 Table::stats_stale
+   * @param threshold 上次analyze之后修改的记录数超过记录数的这个百分比时，认为统计信息过期
+   */
+  RC analyze(int threshold, int &analyzed_count);
+
 public:
   static DefaultHandler &get_default();
 private:
@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "common/seda/timer_stage.h"
 #include "common/metrics/metrics_registry.h"
+#include "common/mm/arena.h"
 #include "rc.h"
 #include "storage/default/default_handler.h"
 #include "storage/common/condition_filter.h"
@@ -33,13 +34,22 @@ See the Mulan PSL v2 for more details. */
 #include "event/session_event.h"
 #include "event/sql_event.h"
 #include "event/storage_event.h"
+#include "event/vacuum_event.h"
+#include "event/analyze_event.h"
 #include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
 
 using namespace common;
 
 const std::string DefaultStorageStage::QUERY_METRIC_TAG = "DefaultStorageStage.query";
+const std::string DefaultStorageStage::VACUUM_METRIC_TAG = "DefaultStorageStage.vacuum_bytes";
 const char * CONF_BASE_DIR = "BaseDir";
 const char * CONF_SYSTEM_DB = "SystemDb";
+const char * CONF_VACUUM_INTERVAL = "VacuumInterval";
+const char * CONF_VACUUM_FILL_FACTOR = "VacuumFillFactor";
+const char * CONF_VACUUM_PAGE_BUDGET = "VacuumPageBudget";
+const char * CONF_ANALYZE_INTERVAL = "AnalyzeInterval";
+const char * CONF_ANALYZE_THRESHOLD = "AnalyzeThreshold";
 
 const char * DEFAULT_SYSTEM_DB = "sys";
 
@@ -107,6 +117,27 @@ bool DefaultStorageStage::set_properties() {
   Session &default_session = Session::default_session();
   default_session.set_current_db(sys_db);
 
+  iter = section.find(CONF_VACUUM_INTERVAL);
+  if (iter != section.end()) {
+    str_to_val(iter->second, vacuum_interval_);
+  }
+  iter = section.find(CONF_VACUUM_FILL_FACTOR);
+  if (iter != section.end()) {
+    str_to_val(iter->second, vacuum_fill_factor_);
+  }
+  iter = section.find(CONF_VACUUM_PAGE_BUDGET);
+  if (iter != section.end()) {
+    str_to_val(iter->second, vacuum_page_budget_);
+  }
+  iter = section.find(CONF_ANALYZE_INTERVAL);
+  if (iter != section.end()) {
+    str_to_val(iter->second, analyze_interval_);
+  }
+  iter = section.find(CONF_ANALYZE_THRESHOLD);
+  if (iter != section.end()) {
+    str_to_val(iter->second, analyze_threshold_);
+  }
+
   LOG_INFO("Open system db success: %s", sys_db);
   return true;
 }
@@ -118,6 +149,26 @@ bool DefaultStorageStage::initialize() {
   MetricsRegistry &metricsRegistry = get_metrics_registry();
   query_metric_ =  new SimpleTimer();
   metricsRegistry.register_metric(QUERY_METRIC_TAG, query_metric_);
+  vacuum_metric_ = new Meter();
+  metricsRegistry.register_metric(VACUUM_METRIC_TAG, vacuum_metric_);
+
+  if (vacuum_interval_ > 0 || analyze_interval_ > 0) {
+    std::list<Stage *>::iterator stgp = next_stage_list_.begin();
+    if (stgp == next_stage_list_.end()) {
+      LOG_WARN("No timer stage configured, vacuum and background analyze are disabled");
+    } else {
+      timer_stage_ = *(stgp++);
+    }
+  }
+  if (timer_stage_ != nullptr && vacuum_interval_ > 0) {
+    add_event(new VacuumEvent());
+    LOG_INFO("Vacuum every %d second(s), fill factor=%d, page budget=%d",
+             vacuum_interval_, vacuum_fill_factor_, vacuum_page_budget_);
+  }
+  if (timer_stage_ != nullptr && analyze_interval_ > 0) {
+    add_event(new AnalyzeEvent());
+    LOG_INFO("Analyze stale tables every %d second(s), threshold=%d%%", analyze_interval_, analyze_threshold_);
+  }
 
   LOG_TRACE("Exit");
   return true;
@@ -136,6 +187,17 @@ void DefaultStorageStage::cleanup() {
 
 void DefaultStorageStage::handle_event(StageEvent *event) {
   LOG_TRACE("Enter\n");
+  if (dynamic_cast<VacuumEvent *>(event) != nullptr) {
+    handle_vacuum_event(event);
+    LOG_TRACE("Exit\n");
+    return;
+  }
+  if (dynamic_cast<AnalyzeEvent *>(event) != nullptr) {
+    handle_analyze_event(event);
+    LOG_TRACE("Exit\n");
+    return;
+  }
+
   TimerStat timerStat(*query_metric_);
 
   StorageEvent *storage_event = static_cast<StorageEvent *>(event);
@@ -189,7 +251,7 @@ void DefaultStorageStage::handle_event(StageEvent *event) {
   case SCF_CREATE_TABLE: { // create table
       const CreateTable &create_table = sql->sstr.create_table;
       rc = handler_->create_table(current_db, create_table.relation_name, 
-              create_table.attribute_count, create_table.attributes);
+              create_table.attribute_count, create_table.attributes, create_table.storage_format);
       snprintf(response, sizeof(response), "%s\n", rc == RC::SUCCESS ? "SUCCESS" : "FAILURE");
     }
     break;
@@ -232,6 +294,17 @@ void DefaultStorageStage::handle_event(StageEvent *event) {
       snprintf(response, sizeof(response), "%s", ss.str().c_str());
     }
     break;
+  case SCF_ANALYZE_TABLE: {
+      const char *table_name = sql->sstr.analyze_table.relation_name;
+      Table *table = handler_->find_table(current_db, table_name);
+      if (table == nullptr) {
+        rc = RC::SCHEMA_TABLE_NOT_EXIST;
+      } else {
+        rc = table->analyze();
+      }
+      snprintf(response, sizeof(response), "%s\n", rc == RC::SUCCESS ? "SUCCESS" : "FAILURE");
+    }
+    break;
 
   case SCF_LOAD_DATA: {
       /*
@@ -259,6 +332,12 @@ void DefaultStorageStage::handle_event(StageEvent *event) {
       break;
   }
 
+  if (rc == RC::SUCCESS && (sql->flag == SCF_CREATE_TABLE || sql->flag == SCF_DROP_TABLE ||
+                            sql->flag == SCF_CREATE_INDEX || sql->flag == SCF_ANALYZE_TABLE)) {
+    // 表结构、索引或者统计信息变化后，缓存的执行计划可能不再正确或者不再是最优的
+    PlanCache::invalidate();
+  }
+
   if (rc == RC::SUCCESS && !session->is_trx_multi_operation_mode()) {
     rc = current_trx->commit();
     if (rc != RC::SUCCESS) {
@@ -275,12 +354,97 @@ void DefaultStorageStage::handle_event(StageEvent *event) {
 void DefaultStorageStage::callback_event(StageEvent *event,
                                         CallbackContext *context) {
   LOG_TRACE("Enter\n");
+  if (dynamic_cast<VacuumEvent *>(event) != nullptr) {
+    vacuum();
+    // 重新注册定时器，等待下一轮
+    add_event(event);
+    LOG_TRACE("Exit\n");
+    return;
+  }
+  if (dynamic_cast<AnalyzeEvent *>(event) != nullptr) {
+    analyze();
+    add_event(event);
+    LOG_TRACE("Exit\n");
+    return;
+  }
+
   StorageEvent *storage_event = static_cast<StorageEvent *>(event);
   storage_event->exe_event()->done_immediate();
   LOG_TRACE("Exit\n");
   return;
 }
 
+void DefaultStorageStage::handle_vacuum_event(StageEvent *event) {
+  CompletionCallback *cb = new (std::nothrow) CompletionCallback(this, nullptr);
+  if (cb == nullptr) {
+    LOG_ERROR("Failed to new callback for VacuumEvent");
+    event->done();
+    return;
+  }
+
+  TimerRegisterEvent *tm_event = new (std::nothrow) TimerRegisterEvent(event, vacuum_interval_ * USEC_PER_SEC);
+  if (tm_event == nullptr) {
+    LOG_ERROR("Failed to new TimerRegisterEvent");
+    delete cb;
+    event->done();
+    return;
+  }
+
+  event->push_callback(cb);
+  timer_stage_->add_event(tm_event);
+}
+
+/**
+ * 做一轮空间回收。每轮读取的页面数受vacuum_page_budget_限制，避免回收占用过多IO影响前台请求
+ */
+void DefaultStorageStage::vacuum() {
+  VacuumStat stat;
+  RC rc = handler_->vacuum(vacuum_fill_factor_, vacuum_page_budget_, stat);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to vacuum. rc=%d:%s", rc, strrc(rc));
+  }
+  if (stat.pages_released > 0 || stat.records_moved > 0) {
+    vacuum_metric_->inc(stat.bytes_reclaimed);
+    LOG_INFO("Vacuum over. pages released=%d, records moved=%d, bytes reclaimed=%ld",
+             stat.pages_released, stat.records_moved, stat.bytes_reclaimed);
+  }
+}
+
+void DefaultStorageStage::handle_analyze_event(StageEvent *event) {
+  CompletionCallback *cb = new (std::nothrow) CompletionCallback(this, nullptr);
+  if (cb == nullptr) {
+    LOG_ERROR("Failed to new callback for AnalyzeEvent");
+    event->done();
+    return;
+  }
+
+  TimerRegisterEvent *tm_event = new (std::nothrow) TimerRegisterEvent(event, analyze_interval_ * USEC_PER_SEC);
+  if (tm_event == nullptr) {
+    LOG_ERROR("Failed to new TimerRegisterEvent");
+    delete cb;
+    event->done();
+    return;
+  }
+
+  event->push_callback(cb);
+  timer_stage_->add_event(tm_event);
+}
+
+/**
+ * 重新收集修改较多的表的统计信息，让优化器的代价估算跟上数据的变化
+ */
+void DefaultStorageStage::analyze() {
+  int analyzed_count = 0;
+  RC rc = handler_->analyze(analyze_threshold_, analyzed_count);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to analyze. rc=%d:%s", rc, strrc(rc));
+  }
+  if (analyzed_count > 0) {
+    PlanCache::invalidate();
+    LOG_INFO("Analyze over. tables analyzed=%d", analyzed_count);
+  }
+}
+
 /**
  * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
  * @param table  要导入的表
@@ -376,6 +540,9 @@ RC insert_record_from_file(Table *table, std::vector<std::string> &file_values,
 std::string DefaultStorageStage::load_data(const char *db_name, 
           const char *table_name, const char *file_name) {
 
+  // 每行的值插入之后立即释放，不放在请求的内存区域中，否则内存随文件大小增长
+  common::ArenaGuard arena_guard(nullptr);
+
   std::stringstream result_string;
   Table *table = handler_->find_table(db_name, table_name);
   if (nullptr == table) {
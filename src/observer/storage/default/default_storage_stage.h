@@ -39,12 +39,26 @@ protected:
 private:
   std::string load_data(const char *db_name, const char *table_name, const char *file_name);
 
+  void handle_vacuum_event(common::StageEvent *event);
+  void vacuum();
+  void handle_analyze_event(common::StageEvent *event);
+  void analyze();
+
 protected:
   common::SimpleTimer *query_metric_ = nullptr;
   static const std::string QUERY_METRIC_TAG;
+  common::Meter *vacuum_metric_ = nullptr;
+  static const std::string VACUUM_METRIC_TAG;
 
 private:
   DefaultHandler * handler_;
+
+  common::Stage *timer_stage_ = nullptr;
+  int vacuum_interval_ = 0;       // 空间回收的间隔(秒)，0表示不做回收
+  int vacuum_fill_factor_ = 50;   // 记录数低于页面容量的这个百分比时，认为是稀疏页面
+  int vacuum_page_budget_ = 64;   // 每轮最多读取的页面个数，限制回收对前台请求的IO干扰
+  int analyze_interval_ = 0;      // 检查统计信息是否过期的间隔(秒)，0表示不在后台更新统计信息
+  int analyze_threshold_ = 10;    // 修改的记录数超过记录数的这个百分比时，认为统计信息过期
 };
 
 #endif //__OBSERVER_STORAGE_DEFAULT_STORAGE_STAGE_H__
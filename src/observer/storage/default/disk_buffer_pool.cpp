@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #include "disk_buffer_pool.h"
 #include <errno.h>
 #include <string.h>
+#include <fcntl.h>
 
 #include "common/log/log.h"
 
@@ -33,6 +34,12 @@ DiskBufferPool *theGlobalDiskBufferPool()
   return instance;
 }
 
+BPAccessStat &thread_bp_access_stat()
+{
+  static thread_local BPAccessStat stat;
+  return stat;
+}
+
 RC DiskBufferPool::create_file(const char *file_name)
 {
   int fd = open(file_name, O_RDWR | O_CREAT | O_EXCL, S_IREAD | S_IWRITE);
@@ -208,6 +215,7 @@ RC DiskBufferPool::get_this_page(int file_id, PageNum page_num, BPPageHandle *pa
       page_handle->frame->pin_count++;
       page_handle->frame->acc_time = current_time();
       page_handle->open = true;
+      thread_bp_access_stat().hits++;
       return RC::SUCCESS;
     }
   }
@@ -229,6 +237,35 @@ RC DiskBufferPool::get_this_page(int file_id, PageNum page_num, BPPageHandle *pa
   }
 
   page_handle->open = true;
+  thread_bp_access_stat().misses++;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::prefetch_page(int file_id, PageNum page_num)
+{
+  RC tmp;
+  if ((tmp = check_file_id(file_id)) != RC::SUCCESS) {
+    return tmp;
+  }
+
+  BPFileHandle *file_handle = open_list_[file_id];
+  if ((tmp = check_page_num(page_num, file_handle)) != RC::SUCCESS) {
+    return tmp;
+  }
+
+  for (int i = 0; i < BP_BUFFER_SIZE; i++) {
+    if (bp_manager_.allocated[i] && bp_manager_.frame[i].file_desc == file_handle->file_desc &&
+        bp_manager_.frame[i].page.page_num == page_num) {
+      return RC::SUCCESS; // 已经在缓冲区中
+    }
+  }
+
+  s64_t offset = ((s64_t)page_num) * sizeof(Page);
+  int ret = posix_fadvise(file_handle->file_desc, offset, sizeof(Page), POSIX_FADV_WILLNEED);
+  if (ret != 0) {
+    LOG_WARN("Failed to prefetch page %s:%d, due to %s", file_handle->file_name, page_num, strerror(ret));
+    return RC::IOERR_READ;
+  }
   return RC::SUCCESS;
 }
 
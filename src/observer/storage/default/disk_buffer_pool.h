@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #define __OBSERVER_STORAGE_COMMON_PAGE_MANAGER_H_
 
 #include <fcntl.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <sys/types.h>
 
@@ -60,6 +61,14 @@ typedef struct {
   Frame *frame;
 } BPPageHandle;
 
+/**
+ * 访问缓冲区的统计。hits是页面已经在缓冲区中，misses是需要从文件中读入
+ */
+struct BPAccessStat {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
 class BPFileHandle{
 public:
   BPFileHandle() {
@@ -143,6 +152,11 @@ public:
    */
   RC get_this_page(int file_id, PageNum page_num, BPPageHandle *page_handle);
 
+  /**
+   * 提示即将访问指定页面。页面不在缓冲区中时让操作系统提前异步读入，不占用缓冲区，也不pin住页面
+   */
+  RC prefetch_page(int file_id, PageNum page_num);
+
   /**
    * 在指定文件中分配一个新的页面，并将其放入缓冲区，返回页面句柄指针。
    * 分配页面时，如果文件中有空闲页，就直接分配一个空闲页；
@@ -216,4 +230,9 @@ private:
 
 DiskBufferPool *theGlobalDiskBufferPool();
 
+/**
+ * 当前线程通过get_this_page访问缓冲区的累计统计，取两次的差就是一段操作访问的页面
+ */
+BPAccessStat &thread_bp_access_stat();
+
 #endif //__OBSERVER_STORAGE_COMMON_PAGE_MANAGER_H_
@@ -97,13 +97,6 @@ void Trx::set_record_trx_id(Table *table, Record &record, int32_t trx_id, bool d
   *ptrx_id = trx_id;
 }
 
-void Trx::get_record_trx_id(Table *table, const Record &record, int32_t &trx_id, bool &deleted) {
-  const FieldMeta *trx_field = table->table_meta().trx_field();
-  int32_t trx = *(int32_t*)(record.data + trx_field->offset());
-  trx_id = trx & TRX_ID_BIT_MASK;
-  deleted = (trx & DELETED_FLAG_BIT_MASK) != 0;
-}
-
 Operation *Trx::find_operation(Table *table, const RID &rid) {
   std::unordered_map<Table *, OperationSet>::iterator table_operations_iter = operations_.find(table);
   if (table_operations_iter == operations_.end()) {
@@ -187,6 +180,8 @@ RC Trx::commit() {
         break;
       }
     }
+    // 提交之后其它事务才能看到修改，表的数据版本要在这里再更新一次
+    table->bump_data_version();
   }
 
   operations_.clear();
@@ -230,6 +225,7 @@ RC Trx::rollback() {
           break;
       }
     }
+    table->bump_data_version();
   }
 
   operations_.clear();
@@ -248,9 +244,13 @@ RC Trx::rollback_delete(Table *table, Record &record) {
 }
 
 bool Trx::is_visible(Table *table, const Record *record) {
-  int32_t record_trx_id;
-  bool record_deleted;
-  get_record_trx_id(table, *record, record_trx_id, record_deleted);
+  const FieldMeta *trx_field = table->table_meta().trx_field();
+  return is_visible(*(int32_t *)(record->data + trx_field->offset()));
+}
+
+bool Trx::is_visible(int32_t record_trx) const {
+  const int32_t record_trx_id = record_trx & TRX_ID_BIT_MASK;
+  const bool record_deleted = (record_trx & DELETED_FLAG_BIT_MASK) != 0;
 
   // 0 表示这条数据已经提交
   if (0 == record_trx_id || record_trx_id == trx_id_) {
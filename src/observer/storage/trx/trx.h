@@ -98,11 +98,15 @@ public:
 
   bool is_visible(Table *table, const Record *record);
 
+  /**
+   * 事务字段的值为record_trx的记录对这个事务是否可见，不需要读取整条记录
+   */
+  bool is_visible(int32_t record_trx) const;
+
   void init_trx_info(Table *table, Record &record);
 
 private:
   void set_record_trx_id(Table *table, Record &record, int32_t trx_id, bool deleted) const;
-  static void get_record_trx_id(Table *table, const Record &record, int32_t &trx_id, bool &deleted);
 
 private:
   using OperationSet = std::unordered_set<Operation, OperationHasher, OperationEqualer>;
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "sql/executor/aggregate_function.h"
+#include "sql/executor/aggregator.h"
+
+// 聚合吞吐量的微基准：按列批量聚合、逐个值聚合，以及经过Tuple的hash聚合
+// 用法: aggregate_performance_test [行数]
+
+static double now_seconds() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void report(const char *name, int row_num, int rounds, double seconds, double check) {
+  printf("%-28s %10.2f M rows/s  (check %.6g)\n", name, (double)row_num * rounds / seconds / 1000000, check);
+}
+
+template <typename T, typename SumT>
+static void bench_numeric(const char *type_name, const std::vector<T> &values, const std::vector<uint8_t> &nulls,
+                          int rounds) {
+  const int row_num = values.size();
+  char name[64];
+
+  double begin = now_seconds();
+  NumericAggregate<T, SumT> batch;
+  for (int r = 0; r < rounds; r++) {
+    batch.update_batch(values.data(), row_num);
+  }
+  snprintf(name, sizeof(name), "%s batch", type_name);
+  report(name, row_num, rounds, now_seconds() - begin, (double)batch.sum());
+
+  begin = now_seconds();
+  NumericAggregate<T, SumT> batch_nulls;
+  for (int r = 0; r < rounds; r++) {
+    batch_nulls.update_batch(values.data(), nulls.data(), row_num);
+  }
+  snprintf(name, sizeof(name), "%s batch with nulls", type_name);
+  report(name, row_num, rounds, now_seconds() - begin, (double)batch_nulls.sum());
+
+  begin = now_seconds();
+  NumericAggregate<T, SumT> row_by_row;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < row_num; i++) {
+      if (nulls[i] == 0) {
+        row_by_row.update(values[i]);
+      }
+    }
+  }
+  snprintf(name, sizeof(name), "%s row by row", type_name);
+  report(name, row_num, rounds, now_seconds() - begin, (double)row_by_row.sum());
+}
+
+static void bench_hash_aggregator(const std::vector<int> &ints, const std::vector<float> &floats, int group_num) {
+  AggregationDesc desc;
+  desc.types = {COUNT, SUM, AVG, MIN, MAX};
+  desc.indexes = {-1, 0, 1, 0, 1};
+  desc.group_by = {2};
+  desc.outputs = {5, 0, 1, 2, 3, 4};
+
+  const int row_num = ints.size();
+  std::vector<Tuple> tuples(row_num);
+  for (int i = 0; i < row_num; i++) {
+    tuples[i].add(ints[i]);
+    tuples[i].add(floats[i]);
+    tuples[i].add(i % group_num);
+  }
+
+  double begin = now_seconds();
+  HashAggregator aggregator(desc);
+  for (const Tuple &tuple : tuples) {
+    aggregator.add(tuple);
+  }
+  std::vector<Tuple> results;
+  aggregator.finish(results);
+  char name[64];
+  snprintf(name, sizeof(name), "tuples, %d groups", group_num);
+  report(name, row_num, 1, now_seconds() - begin, results.size());
+}
+
+int main(int argc, char **argv) {
+  const int row_num = argc > 1 ? atoi(argv[1]) : 1000000;
+  const int rounds = 20;
+
+  std::vector<int> ints(row_num);
+  std::vector<float> floats(row_num);
+  std::vector<uint8_t> nulls(row_num);
+  srand(1);
+  for (int i = 0; i < row_num; i++) {
+    ints[i] = rand() % 100000 - 50000;
+    floats[i] = (rand() % 100000) / 100.0f;
+    nulls[i] = rand() % 10 == 0;
+  }
+
+  printf("%d rows, %d rounds\n", row_num, rounds);
+  bench_numeric<int, int64_t>("int", ints, nulls, rounds);
+  bench_numeric<float, double>("float", floats, nulls, rounds);
+  bench_hash_aggregator(ints, floats, 1);
+  bench_hash_aggregator(ints, floats, 1000);
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "storage/common/condition_filter.h"
+#include "storage/common/predicate_kernel.h"
+#include "storage/common/record_manager.h"
+
+// 过滤速度的微基准：逐条记录调用DefaultConditionFilter，和按列批量调用编译好的过滤核心
+// 记录是行格式：null位图(4) + id(4) + score(4)，与页面上的布局相同
+// 用法: predicate_performance_test [行数]
+
+static const int RECORD_SIZE = 16;
+static const int ID_OFFSET = 4;
+static const int SCORE_OFFSET = 8;
+
+static double now_seconds() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void report(const char *name, int row_num, int rounds, double seconds, long check) {
+  printf("%-28s %8.2f ns/row  (selected %ld)\n", name, seconds * 1000000000 / ((double)row_num * rounds), check);
+}
+
+static ConDesc attr_desc(int offset) {
+  ConDesc desc;
+  desc.is_attr = true;
+  desc.attr_length = 4;
+  desc.attr_offset = offset;
+  return desc;
+}
+
+static ConDesc value_desc(void *value) {
+  ConDesc desc;
+  desc.is_attr = false;
+  desc.value = value;
+  return desc;
+}
+
+int main(int argc, char **argv) {
+  const int row_num = argc > 1 ? atoi(argv[1]) : 1000000;
+  const int rounds = 20;
+
+  std::vector<char> rows(row_num * RECORD_SIZE, 0);
+  srand(1);
+  for (int i = 0; i < row_num; i++) {
+    const int id = rand() % 100000;
+    const float score = (rand() % 10000) / 100.0f;
+    memcpy(rows.data() + i * RECORD_SIZE + ID_OFFSET, &id, sizeof(id));
+    memcpy(rows.data() + i * RECORD_SIZE + SCORE_OFFSET, &score, sizeof(score));
+  }
+
+  // id < 50000 and score >= 20
+  int id_value = 50000;
+  float score_value = 20.0f;
+  DefaultConditionFilter id_filter;
+  DefaultConditionFilter score_filter;
+  id_filter.init(attr_desc(ID_OFFSET), value_desc(&id_value), INTS, LESS_THAN, nullptr, nullptr);
+  score_filter.init(attr_desc(SCORE_OFFSET), value_desc(&score_value), FLOATS, GREAT_EQUAL, nullptr, nullptr);
+  const ConditionFilter *filters[] = {&id_filter, &score_filter};
+  CompositeConditionFilter composite_filter;
+  composite_filter.init(filters, 2);
+
+  printf("%d rows, %d rounds\n", row_num, rounds);
+
+  double begin = now_seconds();
+  long selected_num = 0;
+  for (int r = 0; r < rounds; r++) {
+    Record record;
+    for (int i = 0; i < row_num; i++) {
+      record.data = rows.data() + i * RECORD_SIZE;
+      selected_num += composite_filter.filter(record);
+    }
+  }
+  report("row by row", row_num, rounds, now_seconds() - begin, selected_num);
+
+  PredicateKernel id_kernel;
+  PredicateKernel score_kernel;
+  id_kernel.compile(INTS, sizeof(int), LESS_THAN, &id_value);
+  score_kernel.compile(FLOATS, sizeof(float), GREAT_EQUAL, &score_value);
+  ColumnData id_column;
+  id_column.data = rows.data() + ID_OFFSET;
+  id_column.stride = RECORD_SIZE;
+  ColumnData score_column;
+  score_column.data = rows.data() + SCORE_OFFSET;
+  score_column.stride = RECORD_SIZE;
+
+  std::vector<int> selected(row_num);
+  begin = now_seconds();
+  selected_num = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < row_num; i++) {
+      selected[i] = i;
+    }
+    int num = id_kernel.select(id_column, selected.data(), row_num, selected.data());
+    num = score_kernel.select(score_column, selected.data(), num, selected.data());
+    selected_num += num;
+  }
+  report("kernels, selection vector", row_num, rounds, now_seconds() - begin, selected_num);
+  return 0;
+}
@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <iomanip>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#include "sql/executor/tuple.h"
+#include "sql/executor/value_format.h"
+
+// 输出查询结果的微基准：格式化整数、浮点数、日期和字符串，比较直接格式化与原来逐个值经过ostream的输出
+// 用法: result_print_performance_test [行数]
+
+static double now_seconds() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * 只统计字节数，不保存输出，免得测到内存分配
+ */
+class CountingBuffer : public std::streambuf {
+public:
+  long long bytes() const {
+    return bytes_;
+  }
+
+protected:
+  int_type overflow(int_type ch) override {
+    bytes_++;
+    return traits_type::not_eof(ch);
+  }
+  std::streamsize xsputn(const char *data, std::streamsize len) override {
+    bytes_ += len;
+    return len;
+  }
+
+private:
+  long long bytes_ = 0;
+};
+
+static void report(const char *name, int row_num, int rounds, double seconds, long long bytes) {
+  printf("%-28s %10.2f M rows/s  %8.1f MB/s\n", name, (double)row_num * rounds / seconds / 1000000,
+         bytes / seconds / 1024 / 1024);
+}
+
+/**
+ * 原来的输出方式：每个值都经过ostream的operator<<，浮点数先用std::to_string求整数部分的长度
+ */
+static void print_by_ostream(const TupleSet &tuple_set, std::ostream &os) {
+  for (const Tuple &tuple : tuple_set.tuples()) {
+    const int value_num = tuple.size();
+    for (int i = 0; i < value_num; i++) {
+      const TupleValue value = tuple.get(i);
+      switch (value.type()) {
+        case INTS:
+          os << value.int_value();
+          break;
+        case FLOATS: {
+          std::string str = value.to_string();
+          size_t dot_pos = str.find('.');
+          if (dot_pos == std::string::npos) {
+            os << str;
+          } else {
+            os << std::setprecision(str.substr(0, dot_pos).size() + 2) << value.float_value();
+          }
+        }
+        break;
+        case IS_NULL:
+          os << "NULL";
+          break;
+        default:
+          os.write(value.string_value(), value.length());
+          break;
+      }
+      os << (i == value_num - 1 ? "\n" : " | ");
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  const int row_num = argc > 1 ? atoi(argv[1]) : 1000000;
+  const int rounds = 5;
+
+  TupleSchema schema;
+  schema.add(INTS, "t", "id");
+  schema.add(FLOATS, "t", "price");
+  schema.add(CHARS, "t", "birthday");
+  schema.add(CHARS, "t", "name");
+  schema.add(INTS, "t", "amount");
+  TupleSet tuple_set;
+  tuple_set.set_schema(schema);
+  srand(1);
+  for (int i = 0; i < row_num; i++) {
+    Tuple tuple;
+    tuple.add(i);
+    tuple.add((rand() % 10000000) / 100.0f);
+    char date[DATE_FORMAT_SIZE];
+    tuple.add(date, format_date(19700101 + (rand() % 60) * 10000 + (rand() % 12) * 100 + rand() % 28, date));
+    char name[32];
+    tuple.add(name, snprintf(name, sizeof(name), "name%d", rand() % 100000));
+    if (rand() % 10 == 0) {
+      tuple.add();
+    } else {
+      tuple.add(rand() - RAND_MAX / 2);
+    }
+    tuple_set.add(std::move(tuple));
+  }
+
+  printf("%d rows, %d rounds\n", row_num, rounds);
+
+  CountingBuffer ostream_buffer;
+  std::ostream ostream_os(&ostream_buffer);
+  double begin = now_seconds();
+  for (int r = 0; r < rounds; r++) {
+    print_by_ostream(tuple_set, ostream_os);
+  }
+  report("ostream per value", row_num, rounds, now_seconds() - begin, ostream_buffer.bytes());
+
+  CountingBuffer print_buffer;
+  std::ostream print_os(&print_buffer);
+  begin = now_seconds();
+  for (int r = 0; r < rounds; r++) {
+    tuple_set.print_tuple(print_os);
+  }
+  report("TupleSet::print_tuple", row_num, rounds, now_seconds() - begin, print_buffer.bytes());
+
+  char buf[FLOAT_FORMAT_SIZE];
+  long long bytes = 0;
+  begin = now_seconds();
+  for (int r = 0; r < rounds; r++) {
+    for (const Tuple &tuple : tuple_set.tuples()) {
+      bytes += format_float(tuple.get(1).float_value(), buf);
+    }
+  }
+  report("format_float only", row_num, rounds, now_seconds() - begin, bytes);
+
+  if (ostream_buffer.bytes() != print_buffer.bytes()) {
+    printf("output size mismatch: %lld vs %lld\n", ostream_buffer.bytes(), print_buffer.bytes());
+    return 1;
+  }
+  return 0;
+}
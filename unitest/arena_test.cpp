@@ -0,0 +1,140 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "common/mm/arena.h"
+#include "sql/executor/tuple.h"
+
+using namespace common;
+
+TEST(test_arena, test_alloc) {
+  Arena arena(0, 1024);
+  for (int i = 1; i < 100; i++) {
+    void *p = arena.alloc(i, 8);
+    ASSERT_EQ(0, (uintptr_t)p % 8);
+    memset(p, i, i);
+  }
+  ASSERT_EQ(99 * 100 / 2, (int)arena.used());
+  ASSERT_EQ(99, (int)arena.alloc_count());
+
+  char *s = arena.strdup("hello arena");
+  ASSERT_STREQ("hello arena", s);
+
+  // 大的分配单独占一个块
+  const size_t reserved = arena.reserved();
+  char *large = (char *)arena.alloc(4096);
+  memset(large, 0, 4096);
+  ASSERT_GE(arena.reserved(), reserved + 4096);
+
+  arena.reset();
+  ASSERT_EQ(0, (int)arena.used());
+  ASSERT_EQ(0, (int)arena.reserved());
+  ASSERT_EQ(0, (int)arena.alloc_count());
+}
+
+TEST(test_arena, test_reuse) {
+  Arena arena;
+  void *p = arena.alloc_reusable(100);
+  const size_t used = arena.used();
+  arena.free_reusable(p, 100);
+  // 同一级别的分配复用释放的内存，使用的内存不再增长
+  for (int i = 0; i < 1000; i++) {
+    void *q = arena.alloc_reusable(90 + i % 30);
+    ASSERT_EQ(p, q);
+    arena.free_reusable(q, 90 + i % 30);
+  }
+  ASSERT_EQ(used, arena.used());
+
+  void *small = arena.alloc_reusable(8);
+  ASSERT_NE(p, small);
+  ASSERT_EQ(0, (uintptr_t)small % 16);
+}
+
+TEST(test_arena, test_limit) {
+  Arena arena(100);
+  arena.alloc(100);
+  ASSERT_FALSE(arena.exceeded());
+  arena.alloc(1);
+  ASSERT_TRUE(arena.exceeded());
+  arena.reset();
+  ASSERT_FALSE(arena.exceeded());
+
+  arena.set_limit(0);
+  arena.alloc(1024 * 1024);
+  ASSERT_FALSE(arena.exceeded());
+}
+
+TEST(test_arena, test_guard) {
+  ASSERT_EQ(nullptr, Arena::current());
+  Arena outer;
+  Arena inner;
+  {
+    ArenaGuard outer_guard(&outer);
+    ASSERT_EQ(&outer, Arena::current());
+    {
+      ArenaGuard inner_guard(&inner);
+      ASSERT_EQ(&inner, Arena::current());
+      ArenaGuard no_arena(nullptr);
+      ASSERT_EQ(nullptr, Arena::current());
+    }
+    ASSERT_EQ(&outer, Arena::current());
+  }
+  ASSERT_EQ(nullptr, Arena::current());
+}
+
+TEST(test_arena, test_tuple) {
+  Arena arena;
+  Tuple copy;
+  {
+    ArenaGuard guard(&arena);
+    Tuple tuple;
+    for (int i = 0; i < 100; i++) {
+      tuple.add(i);
+      tuple.add("value", 5);
+    }
+    ASSERT_GT(arena.alloc_count(), 0);
+    ASSERT_EQ(200, tuple.size());
+
+    // 逐行创建和销毁的元组复用同一块内存
+    const size_t used = arena.used();
+    for (int i = 0; i < 1000; i++) {
+      Tuple row;
+      row.add(i);
+      row.add("row", 3);
+    }
+    const size_t row_used = arena.used() - used;
+    for (int i = 0; i < 1000; i++) {
+      Tuple row;
+      row.add(i);
+      row.add("row", 3);
+    }
+    ASSERT_EQ(used + row_used, arena.used());
+
+    // 复制赋值保留原来的分配器，不引用请求的内存
+    copy = tuple;
+  }
+  arena.reset();
+  ASSERT_EQ(200, copy.size());
+  ASSERT_EQ(99, copy.get(198).int_value());
+  ASSERT_EQ("value", copy.get(199).to_string());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,259 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/dictionary.h"
+
+static const char *REGIONS[] = {"east", "west", "north", "south"};
+
+struct ScanResult {
+  const FieldMeta *field;
+  int count;
+  std::string last_value;
+};
+
+static void scan_reader(const char *data, void *context) {
+  ScanResult *result = (ScanResult *)context;
+  result->count++;
+  int code = *(int *)(data + result->field->offset());
+  result->last_value = result->field->dict()->value(code);
+}
+
+static int count_equal(Table &table, const char *value) {
+  Condition condition;
+  memset(&condition, 0, sizeof(condition));
+  condition.left_is_attr = 1;
+  condition.left_attr.attribute_name = (char *)"region";
+  condition.comp = EQUAL_TO;
+  condition.right_is_attr = 0;
+  value_init_string(&condition.right_value, value);
+
+  DefaultConditionFilter filter;
+  EXPECT_EQ(RC::SUCCESS, filter.init(table, condition));
+  ScanResult result{table.table_meta().field("region"), 0, ""};
+  EXPECT_EQ(RC::SUCCESS, table.scan_record(nullptr, &filter, -1, &result, scan_reader));
+  value_destroy(&condition.right_value);
+  if (result.count > 0) {
+    EXPECT_STREQ(value, result.last_value.c_str());
+  }
+  return result.count;
+}
+
+TEST(test_dictionary, test_dictionary) {
+  Dictionary dict(4);
+  bool added = false;
+  ASSERT_EQ(0, dict.get_or_add("east", added));
+  ASSERT_TRUE(added);
+  ASSERT_EQ(0, dict.get_or_add("east", added));
+  ASSERT_FALSE(added);
+  // 超过声明长度的部分被截断
+  ASSERT_EQ(1, dict.get_or_add("westward", added));
+  ASSERT_STREQ("west", dict.value(1));
+  ASSERT_EQ(1, dict.code("west"));
+  ASSERT_EQ(Dictionary::INVALID_CODE, dict.code("north"));
+
+  // 跨过多个块，已经分配的字符串不会移动
+  Dictionary big_dict(8);
+  const char *first = nullptr;
+  for (int i = 0; i < 5000; i++) {
+    ASSERT_EQ(i, big_dict.get_or_add(std::to_string(i).c_str(), added));
+    if (i == 0) {
+      first = big_dict.value(0);
+    }
+  }
+  ASSERT_EQ(first, big_dict.value(0));
+  for (int i = 0; i < 5000; i++) {
+    ASSERT_EQ(std::to_string(i), big_dict.value(i));
+  }
+  ASSERT_STREQ("", big_dict.value(5000));
+}
+
+TEST(test_dictionary, test_dict_column) {
+  std::string base_dir = "./dictionary_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/t.table";
+
+  AttrInfo attrs[2] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"region";
+  attrs[1].type = CHARS;
+  attrs[1].length = 20;
+  attrs[1].dict = true;
+
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "t", base_dir.c_str(), 2, attrs));
+    const FieldMeta *field = table.table_meta().field("region");
+    ASSERT_NE(nullptr, field->dict());
+    ASSERT_EQ((int)sizeof(int), field->len());
+
+    for (int i = 0; i < 100; i++) {
+      Value values[2];
+      value_init_integer(&values[0], i);
+      value_init_string(&values[1], REGIONS[i % 3]);
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+      value_destroy(&values[0]);
+      value_destroy(&values[1]);
+    }
+    ASSERT_EQ(3, field->dict()->size());
+    ASSERT_EQ(34, count_equal(table, "east"));
+    ASSERT_EQ(0, count_equal(table, "south"));
+    table.sync();
+  }
+
+  // 重新打开表，字典随元数据恢复
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", base_dir.c_str()));
+    const FieldMeta *field = table.table_meta().field("region");
+    ASSERT_NE(nullptr, field->dict());
+    ASSERT_EQ(3, field->dict()->size());
+    ASSERT_EQ(33, count_equal(table, "north"));
+
+    // 新增的编码追加到字典文件中，不重写元数据
+    struct stat meta_stat;
+    ASSERT_EQ(0, stat(meta_file.c_str(), &meta_stat));
+    Value values[2];
+    value_init_integer(&values[0], 100);
+    value_init_string(&values[1], "south");
+    ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+    value_destroy(&values[0]);
+    value_destroy(&values[1]);
+    struct stat new_meta_stat;
+    ASSERT_EQ(0, stat(meta_file.c_str(), &new_meta_stat));
+    ASSERT_EQ(meta_stat.st_ino, new_meta_stat.st_ino);
+    ASSERT_EQ(meta_stat.st_size, new_meta_stat.st_size);
+    table.sync();
+  }
+
+  // 字典文件末尾有追加时崩溃留下的不完整的一项
+  std::string dict_file = base_dir + "/t.dict";
+  FILE *fp = fopen(dict_file.c_str(), "ab");
+  ASSERT_NE(nullptr, fp);
+  fwrite("\6\0", 1, 2, fp);
+  fclose(fp);
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", base_dir.c_str()));
+    const FieldMeta *field = table.table_meta().field("region");
+    ASSERT_EQ(4, field->dict()->size());
+    ASSERT_EQ(3, field->dict()->code("south"));
+    ASSERT_EQ(1, count_equal(table, "south"));
+    table.drop(meta_file.c_str(), "t", base_dir.c_str());
+  }
+  ASSERT_NE(0, access(dict_file.c_str(), F_OK));
+  rmdir(base_dir.c_str());
+}
+
+static RC insert_region(Table &table, int id, const char *region) {
+  Value values[2];
+  value_init_integer(&values[0], id);
+  value_init_string(&values[1], region);
+  RC rc = table.insert_record(nullptr, 2, values, 1);
+  value_destroy(&values[0]);
+  value_destroy(&values[1]);
+  return rc;
+}
+
+static off_t file_size(const std::string &file) {
+  struct stat st;
+  return stat(file.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+TEST(test_dictionary, test_dict_append_failure) {
+  std::string base_dir = "./dictionary_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/f.table";
+  std::string dict_file = base_dir + "/f.dict";
+
+  AttrInfo attrs[2] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"region";
+  attrs[1].type = CHARS;
+  attrs[1].length = 20;
+  attrs[1].dict = true;
+
+  const int value_num = 200;
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "f", base_dir.c_str(), 2, attrs));
+    // 字典文件比元数据大，下面限制文件大小时只有字典文件的追加会失败
+    for (int i = 0; i < value_num; i++) {
+      ASSERT_EQ(RC::SUCCESS, insert_region(table, i, ("r" + std::to_string(i)).c_str()));
+    }
+    const off_t dict_size = file_size(dict_file);
+    ASSERT_GT(dict_size, 0);
+
+    // 只能再写入5个字节，追加的一项只写入一部分
+    signal(SIGXFSZ, SIG_IGN);
+    struct rlimit old_limit;
+    ASSERT_EQ(0, getrlimit(RLIMIT_FSIZE, &old_limit));
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = dict_size + 5;
+    ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &limit));
+    const RC rc = insert_region(table, value_num, "partial");
+    ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &old_limit));
+    signal(SIGXFSZ, SIG_DFL);
+
+    // 写入的部分被截掉，编码随元数据保存
+    ASSERT_EQ(RC::SUCCESS, rc);
+    ASSERT_EQ(dict_size, file_size(dict_file));
+    // 之后新增的编码也随元数据保存，不再追加
+    ASSERT_EQ(RC::SUCCESS, insert_region(table, value_num + 1, "after"));
+    ASSERT_EQ(dict_size, file_size(dict_file));
+    table.sync();
+  }
+
+  // 重新打开后继续追加，不完整的项没有留在新追加的项前面
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("f.table", base_dir.c_str()));
+    const off_t dict_size = file_size(dict_file);
+    ASSERT_EQ(RC::SUCCESS, insert_region(table, value_num + 2, "good"));
+    ASSERT_GT(file_size(dict_file), dict_size);
+    table.sync();
+  }
+
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("f.table", base_dir.c_str()));
+    Dictionary *dict = table.table_meta().field("region")->dict();
+    ASSERT_EQ(value_num + 3, dict->size());
+    ASSERT_EQ(value_num, dict->code("partial"));
+    ASSERT_EQ(value_num + 1, dict->code("after"));
+    ASSERT_EQ(value_num + 2, dict->code("good"));
+    ASSERT_STREQ("r7", dict->value(7));
+    ASSERT_EQ(1, count_equal(table, "good"));
+    ASSERT_EQ(1, count_equal(table, "partial"));
+    table.drop(meta_file.c_str(), "f", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,371 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "sql/executor/execution_node.h"
+#include "sql/optimizer/join_planner.h"
+
+static void create_table(Table &table, const std::string &base_dir, const char *name, int record_num) {
+  AttrInfo attrs[2] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"val";
+  attrs[1].type = INTS;
+  attrs[1].length = 4;
+  std::string meta_file = base_dir + "/" + name + ".table";
+  ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), name, base_dir.c_str(), 2, attrs));
+
+  for (int i = 0; i < record_num; i++) {
+    Value values[2];
+    value_init_integer(&values[0], i);
+    value_init_integer(&values[1], i % 3);
+    ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+    value_destroy(&values[0]);
+    value_destroy(&values[1]);
+  }
+}
+
+static SelectExeNode *create_scan(Table &table) {
+  TupleSchema schema;
+  TupleSchema::from_table(&table, schema);
+  SelectExeNode *node = new SelectExeNode;
+  EXPECT_EQ(RC::SUCCESS, node->init(nullptr, &table, std::move(schema), std::vector<DefaultConditionFilter *>()));
+  return node;
+}
+
+static DefaultConditionFilter *create_filter(const char *left_table, const char *left_attr, CompOp comp,
+                                             const char *right_table, const char *right_attr) {
+  ConDesc left;
+  left.is_attr = true;
+  left.table_name = (char *)left_table;
+  left.attr_name = (char *)left_attr;
+  ConDesc right;
+  right.is_attr = true;
+  right.table_name = (char *)right_table;
+  right.attr_name = (char *)right_attr;
+  DefaultConditionFilter *filter = new DefaultConditionFilter;
+  EXPECT_EQ(RC::SUCCESS, filter->init(left, right, INTS, comp, nullptr, nullptr));
+  return filter;
+}
+
+TEST(test_execution_node, test_pull_operators) {
+  std::string base_dir = "./execution_node_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    Table t2;
+    create_table(t1, base_dir, "t1", 100);
+    create_table(t2, base_dir, "t2", 10);
+
+    // 扫描之后直接limit，只拉取需要的记录
+    LimitExeNode limit_node;
+    ASSERT_EQ(RC::SUCCESS, limit_node.init(create_scan(t1), 5, 10));
+    TupleSet tuple_set;
+    ASSERT_EQ(RC::SUCCESS, limit_node.execute(tuple_set));
+    ASSERT_EQ(5, tuple_set.size());
+    ASSERT_EQ(0, tuple_set.get(0).get(0).compare(TupleValue(10)));
+
+    // t1.id = t2.val 的连接，只有t1中id为0,1,2的记录能连上
+    std::vector<DefaultConditionFilter *> join_filters;
+    join_filters.push_back(create_filter("t1", "id", EQUAL_TO, "t2", "val"));
+    NestedLoopJoinExeNode *join_node = new NestedLoopJoinExeNode;
+    ASSERT_EQ(RC::SUCCESS, join_node->init(create_scan(t1), create_scan(t2), std::move(join_filters)));
+    ASSERT_EQ(4, (int)join_node->schema().fields().size());
+
+    // 按t2.id降序排序后投影出t1.id和t2.id
+    SortExeNode *sort_node = new SortExeNode;
+    ASSERT_EQ(RC::SUCCESS, sort_node->init(join_node, std::vector<int>{2}, std::vector<int>{-1}));
+    TupleSchema schema;
+    schema.add(INTS, "t1", "id");
+    schema.add(INTS, "t2", "id");
+    ProjectExeNode project_node;
+    ASSERT_EQ(RC::SUCCESS, project_node.init(sort_node, std::move(schema), std::vector<int>{0, 2}));
+
+    ASSERT_EQ(RC::SUCCESS, project_node.open());
+    Tuple tuple;
+    int count = 0;
+    int last_t2_id = 100;
+    while (RC::SUCCESS == project_node.next(tuple)) {
+      ASSERT_EQ(2, tuple.size());
+      const int t1_id = std::stoi(tuple.get(0).to_string());
+      const int t2_id = std::stoi(tuple.get(1).to_string());
+      ASSERT_LE(t2_id, last_t2_id);
+      ASSERT_EQ(t2_id % 3, t1_id);
+      last_t2_id = t2_id;
+      count++;
+    }
+    ASSERT_EQ(10, count);
+    ASSERT_EQ(RC::SUCCESS, project_node.close());
+
+    t1.drop((base_dir + "/t1.table").c_str(), "t1", base_dir.c_str());
+    t2.drop((base_dir + "/t2.table").c_str(), "t2", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+static int count_tuples(ExecutionNode &node) {
+  TupleSet tuple_set;
+  EXPECT_EQ(RC::SUCCESS, node.execute(tuple_set));
+  return tuple_set.size();
+}
+
+TEST(test_execution_node, test_hash_join) {
+  std::string base_dir = "./execution_node_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    Table t2;
+    create_table(t1, base_dir, "t1", 300);
+    create_table(t2, base_dir, "t2", 30);
+    ASSERT_EQ(300, t1.estimate_record_num());
+    ASSERT_EQ(30, t2.estimate_record_num());
+
+    // t1.val = t2.val，在两侧分别建立hash表，结果的个数和嵌套循环一致
+    for (int build_left = 0; build_left <= 1; build_left++) {
+      HashJoinExeNode hash_join;
+      ASSERT_EQ(RC::SUCCESS, hash_join.init(create_scan(t1), create_scan(t2), std::vector<int>{1}, std::vector<int>{1},
+                                            build_left == 1, std::vector<DefaultConditionFilter *>()));
+      ASSERT_EQ(300 * 10, count_tuples(hash_join));
+    }
+
+    std::vector<DefaultConditionFilter *> filters;
+    filters.push_back(create_filter("t1", "val", EQUAL_TO, "t2", "val"));
+    NestedLoopJoinExeNode nested_loop_join;
+    ASSERT_EQ(RC::SUCCESS, nested_loop_join.init(create_scan(t1), create_scan(t2), std::move(filters)));
+    ASSERT_EQ(300 * 10, count_tuples(nested_loop_join));
+
+    // 多列的连接键，加上一个非等值的条件
+    filters.push_back(create_filter("t1", "id", LESS_THAN, "t2", "id"));
+    HashJoinExeNode multi_key_join;
+    ASSERT_EQ(RC::SUCCESS, multi_key_join.init(create_scan(t1), create_scan(t2), std::vector<int>{0, 1},
+                                               std::vector<int>{0, 1}, false, std::move(filters)));
+    ASSERT_EQ(0, count_tuples(multi_key_join));
+
+    HashJoinExeNode multi_key_join2;
+    ASSERT_EQ(RC::SUCCESS, multi_key_join2.init(create_scan(t1), create_scan(t2), std::vector<int>{0, 1},
+                                                std::vector<int>{0, 1}, true, std::vector<DefaultConditionFilter *>()));
+    ASSERT_EQ(30, count_tuples(multi_key_join2));
+
+    t1.drop((base_dir + "/t1.table").c_str(), "t1", base_dir.c_str());
+    t2.drop((base_dir + "/t2.table").c_str(), "t2", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_execution_node, test_limit_pushdown) {
+  std::string base_dir = "./execution_node_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    create_table(t1, base_dir, "t1", 100);
+
+    // limit下推到扫描中，读够了就结束
+    SelectExeNode *scan = create_scan(t1);
+    scan->set_limit(7);
+    ASSERT_EQ(7, count_tuples(*scan));
+    scan->set_limit(0);
+    ASSERT_EQ(0, count_tuples(*scan));
+    delete scan;
+
+    // order by id desc limit 2 offset 1: 排序只保留前3个元组
+    SortExeNode *sort_node = new SortExeNode;
+    ASSERT_EQ(RC::SUCCESS, sort_node->init(create_scan(t1), std::vector<int>{0}, std::vector<int>{-1}, 3));
+    LimitExeNode limit_node;
+    ASSERT_EQ(RC::SUCCESS, limit_node.init(sort_node, 2, 1));
+    TupleSet tuple_set;
+    ASSERT_EQ(RC::SUCCESS, limit_node.execute(tuple_set));
+    ASSERT_EQ(2, tuple_set.size());
+    ASSERT_EQ(0, tuple_set.get(0).get(0).compare(TupleValue(98)));
+    ASSERT_EQ(0, tuple_set.get(1).get(0).compare(TupleValue(97)));
+
+    t1.drop((base_dir + "/t1.table").c_str(), "t1", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_execution_node, test_explain) {
+  std::string base_dir = "./execution_node_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    Table t2;
+    create_table(t1, base_dir, "t1", 300);
+    create_table(t2, base_dir, "t2", 30);
+
+    HashJoinExeNode *hash_join = new HashJoinExeNode;
+    ASSERT_EQ(RC::SUCCESS, hash_join->init(create_scan(t1), create_scan(t2), std::vector<int>{1}, std::vector<int>{1},
+                                           false, std::vector<DefaultConditionFilter *>()));
+    LimitExeNode limit_node;
+    ASSERT_EQ(RC::SUCCESS, limit_node.init(hash_join, 100, 0));
+
+    std::stringstream plan;
+    limit_node.explain(plan, false);
+    ASSERT_EQ("LIMIT 100 OFFSET 0\n"
+              "  -> HASH JOIN (build right, keys=1)\n"
+              "    -> TABLE SCAN t1\n"
+              "    -> TABLE SCAN t2\n", plan.str());
+
+    // 每个节点统计输入和输出的元组数，limit输出够了之后不再拉取左侧
+    limit_node.enable_analyze();
+    ASSERT_EQ(100, count_tuples(limit_node));
+    std::stringstream analyzed;
+    limit_node.explain(analyzed, true);
+    const std::string output = analyzed.str();
+    ASSERT_NE(std::string::npos, output.find("LIMIT 100 OFFSET 0 (rows in=100 out=100 loops=1"));
+    ASSERT_NE(std::string::npos, output.find("HASH JOIN (build right, keys=1) (rows in=40 out=100 loops=1"));
+    ASSERT_NE(std::string::npos, output.find("TABLE SCAN t1 (rows in=0 out=10 loops=1"));
+    ASSERT_NE(std::string::npos, output.find("TABLE SCAN t2 (rows in=0 out=30 loops=1"));
+    ASSERT_NE(std::string::npos, output.find("hits="));
+
+    t1.drop((base_dir + "/t1.table").c_str(), "t1", base_dir.c_str());
+    t2.drop((base_dir + "/t2.table").c_str(), "t2", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+static void create_index(Table &table, const char *index_name, const char *field_name) {
+  char *index_attrs[] = {(char *)field_name};
+  ASSERT_EQ(RC::SUCCESS, table.create_index(nullptr, index_name, index_attrs, false, 1));
+}
+
+static SelectExeNode *create_ordered_scan(Table &table, const char *field_name) {
+  SelectExeNode *node = create_scan(table);
+  node->set_index_order(field_name);
+  return node;
+}
+
+TEST(test_execution_node, test_index_join) {
+  std::string base_dir = "./execution_node_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    Table t2;
+    create_table(t1, base_dir, "t1", 300);
+    create_table(t2, base_dir, "t2", 30);
+    create_index(t1, "t1_id", "id");
+    create_index(t1, "t1_val", "val");
+    create_index(t2, "t2_val", "val");
+    ASSERT_EQ(nullptr, t2.find_single_field_index("id"));
+
+    // 外侧的t2逐条在t1的索引上查找
+    IndexNestedLoopJoinExeNode unique_join;
+    ASSERT_EQ(RC::SUCCESS, unique_join.init(create_scan(t2), create_scan(t1), 0, "id",
+                                            std::vector<DefaultConditionFilter *>()));
+    ASSERT_EQ(30, count_tuples(unique_join));
+
+    std::vector<DefaultConditionFilter *> filters;
+    filters.push_back(create_filter("t2", "id", LESS_THAN, "t1", "id"));
+    IndexNestedLoopJoinExeNode val_join;
+    ASSERT_EQ(RC::SUCCESS, val_join.init(create_scan(t2), create_scan(t1), 1, "val", std::move(filters)));
+    ASSERT_EQ(300 * 10 - 165, count_tuples(val_join)); // 去掉t1.id <= t2.id的3 * (1 + 2 + ... + 10)个
+
+    IndexNestedLoopJoinExeNode no_index_join;
+    ASSERT_NE(RC::SUCCESS, no_index_join.init(create_scan(t1), create_scan(t2), 0, "id",
+                                              std::vector<DefaultConditionFilter *>()));
+
+    // 两侧都按val上的索引顺序扫描后归并
+    SortMergeJoinExeNode merge_join;
+    ASSERT_EQ(RC::SUCCESS, merge_join.init(create_ordered_scan(t1, "val"), create_ordered_scan(t2, "val"), 1, 1,
+                                           std::vector<DefaultConditionFilter *>()));
+    TupleSet tuple_set;
+    ASSERT_EQ(RC::SUCCESS, merge_join.execute(tuple_set));
+    ASSERT_EQ(300 * 10, tuple_set.size());
+    for (int i = 1; i < tuple_set.size(); i++) {
+      ASSERT_LE(tuple_set.get(i - 1).get(1).compare(tuple_set.get(i).get(1)), 0);
+      ASSERT_EQ(0, tuple_set.get(i).get(1).compare(tuple_set.get(i).get(3)));
+    }
+
+    // 小表在外侧，大表的连接字段上有索引
+    Selects selects;
+    memset(&selects, 0, sizeof(selects));
+    selects.condition_num = 1;
+    Condition &condition = selects.conditions[0];
+    condition.left_is_attr = 1;
+    condition.left_attr.relation_name = (char *)"t1";
+    condition.left_attr.attribute_name = (char *)"id";
+    condition.comp = EQUAL_TO;
+    condition.right_is_attr = 1;
+    condition.right_attr.relation_name = (char *)"t2";
+    condition.right_attr.attribute_name = (char *)"id";
+    JoinPlan join_plan;
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1, &t2}, selects, join_plan));
+    ASSERT_EQ(2, (int)join_plan.steps.size());
+    ASSERT_EQ(1, join_plan.steps[0].table);
+    ASSERT_EQ(0, join_plan.steps[1].table);
+    ASSERT_EQ(INDEX_NESTED_LOOP_JOIN, join_plan.steps[1].method);
+    ASSERT_EQ("id", join_plan.steps[1].inner_field);
+
+    // 两张大小相同的表都可以按id的索引顺序读取，但要全部随机读取，不如顺序扫描后hash join
+    Table t3;
+    create_table(t3, base_dir, "t3", 300);
+    create_index(t3, "t3_id", "id");
+    condition.right_attr.relation_name = (char *)"t3";
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1, &t3}, selects, join_plan));
+    ASSERT_EQ(HASH_JOIN, join_plan.steps[1].method);
+
+    // 两侧的连接字段上都有选择性高的条件时，只按索引顺序读取少量记录后归并
+    int value = 10;
+    selects.relation_num = 2;
+    selects.relations[0] = (char *)"t3";
+    selects.relations[1] = (char *)"t1";
+    selects.condition_num = 3;
+    Condition &range_condition = selects.conditions[1];
+    range_condition.left_is_attr = 1;
+    range_condition.left_attr.relation_name = (char *)"t1";
+    range_condition.left_attr.attribute_name = (char *)"id";
+    range_condition.comp = EQUAL_TO;
+    range_condition.right_is_attr = 0;
+    range_condition.right_value.type = INTS;
+    range_condition.right_value.data = &value;
+    selects.conditions[2] = range_condition;
+    selects.conditions[2].left_attr.relation_name = (char *)"t3";
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1, &t3}, selects, join_plan));
+    ASSERT_EQ(SORT_MERGE_JOIN, join_plan.steps[1].method);
+    selects.relation_num = 0;
+    selects.condition_num = 1;
+
+    // t3.val上没有索引，只能用hash join
+    condition.right_attr.attribute_name = (char *)"val";
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1, &t3}, selects, join_plan));
+    ASSERT_EQ(HASH_JOIN, join_plan.steps[1].method);
+
+    t3.drop((base_dir + "/t3.table").c_str(), "t3", base_dir.c_str());
+    unlink((base_dir + "/t3-t3_id.index").c_str());
+    t1.drop((base_dir + "/t1.table").c_str(), "t1", base_dir.c_str());
+    t2.drop((base_dir + "/t2.table").c_str(), "t2", base_dir.c_str());
+    // drop不会删除索引文件
+    unlink((base_dir + "/t1-t1_id.index").c_str());
+    unlink((base_dir + "/t1-t1_val.index").c_str());
+    unlink((base_dir + "/t2-t2_val.index").c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
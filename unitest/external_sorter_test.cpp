@@ -0,0 +1,134 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sql/executor/sorter.h"
+
+static const int ROW_NUM = 3000;
+
+/**
+ * 输入元组：(id, score, name)，score和name有null，有大量重复的值
+ */
+static void make_rows(std::vector<Tuple> &rows) {
+  srand(7);
+  char name[16];
+  for (int i = 0; i < ROW_NUM; i++) {
+    Tuple tuple;
+    tuple.add(i);
+    if (rand() % 10 == 0) {
+      tuple.add();
+    } else {
+      tuple.add((rand() % 200 - 100) / 4.0f);
+    }
+    if (rand() % 10 == 0) {
+      tuple.add();
+    } else {
+      snprintf(name, sizeof(name), "n%d", rand() % 50);
+      tuple.add(name, strlen(name));
+    }
+    rows.push_back(std::move(tuple));
+  }
+}
+
+static std::string to_string(const Tuple &tuple) {
+  std::string row;
+  for (int i = 0; i < tuple.size(); i++) {
+    row += tuple.get(i).to_string();
+    row += "|";
+  }
+  return row;
+}
+
+static void check_sort(const std::vector<int> &indexes, const std::vector<int> &orders, size_t memory_budget,
+                       int64_t limit, bool expect_spill) {
+  std::vector<Tuple> rows;
+  make_rows(rows);
+
+  std::vector<Tuple> expected = rows;
+  std::stable_sort(expected.begin(), expected.end(), [&](const Tuple &tuple_1, const Tuple &tuple_2) {
+    return tuple_order_less(tuple_1, tuple_2, indexes, orders);
+  });
+  if (limit >= 0 && (size_t)limit < expected.size()) {
+    expected.resize(limit);
+  }
+
+  ExternalSorter sorter(indexes, orders, memory_budget, limit);
+  for (Tuple &tuple : rows) {
+    ASSERT_EQ(RC::SUCCESS, sorter.add(std::move(tuple)));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.finish());
+  ASSERT_EQ(expect_spill, sorter.spilled_runs() > 0);
+
+  // 相同的排序键保持输入的顺序，结果与stable_sort完全一致
+  Tuple tuple;
+  for (const Tuple &expected_tuple : expected) {
+    ASSERT_EQ(RC::SUCCESS, sorter.next(tuple));
+    ASSERT_EQ(to_string(expected_tuple), to_string(tuple));
+  }
+  ASSERT_EQ(RC::RECORD_EOF, sorter.next(tuple));
+}
+
+TEST(test_external_sorter, test_in_memory) {
+  check_sort({1}, {1}, ExternalSorter::DEFAULT_MEMORY_BUDGET, -1, false);
+  check_sort({2, 1}, {-1, 1}, ExternalSorter::DEFAULT_MEMORY_BUDGET, -1, false);
+}
+
+TEST(test_external_sorter, test_spill) {
+  // 每个段几十个元组，段数超过一次归并的路数，需要多轮归并
+  check_sort({1}, {-1}, 4096, -1, true);
+  check_sort({2, 1, 0}, {1, -1, -1}, 4096, -1, true);
+  check_sort({2}, {1}, 64 * 1024, -1, true);
+}
+
+TEST(test_external_sorter, test_top_n) {
+  check_sort({1, 2}, {1, 1}, ExternalSorter::DEFAULT_MEMORY_BUDGET, 10, false);
+  check_sort({2}, {-1}, ExternalSorter::DEFAULT_MEMORY_BUDGET, 0, false);
+  check_sort({1}, {1}, ExternalSorter::DEFAULT_MEMORY_BUDGET, ROW_NUM * 2, false);
+  // 堆超过内存预算时改为外部排序
+  check_sort({1}, {-1}, 4096, 500, true);
+}
+
+TEST(test_external_sorter, test_numeric_keys) {
+  // 整数和浮点数混在一起按数值比较，负数和-0也要正确
+  std::vector<Tuple> rows(6);
+  rows[0].add(3);
+  rows[1].add(-2.5f);
+  rows[2].add(-0.0f);
+  rows[3].add(-7);
+  rows[4].add(2.75f);
+  rows[5].add(0);
+  ExternalSorter sorter({0}, {1});
+  for (Tuple &tuple : rows) {
+    ASSERT_EQ(RC::SUCCESS, sorter.add(std::move(tuple)));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.finish());
+  std::string result;
+  Tuple tuple;
+  while (sorter.next(tuple) == RC::SUCCESS) {
+    result += to_string(tuple);
+  }
+  ASSERT_EQ("-7|-2.500000|-0.000000|0|2.750000|3|", result);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sql/executor/aggregator.h"
+
+static const int ROW_NUM = 1000;
+static const int GROUP_NUM = 100;
+
+/**
+ * 输入元组：(id, grp, name)，grp为GROUP_NUM-1的行是null
+ * select grp, count(*), count(grp), avg(id), max(name), min(id) group by grp
+ */
+static void init_desc(AggregationDesc &desc) {
+  desc.types = {COUNT, COUNT, AVG, MAX, MIN};
+  desc.indexes = {-1, 1, 0, 2, 0};
+  desc.group_by = {1};
+  desc.outputs = {5, 0, 1, 2, 3, 4};
+  desc.schema.add(INTS, "t", "grp");
+  desc.schema.add(INTS, "t", "COUNT(*)");
+  desc.schema.add(INTS, "t", "COUNT(grp)");
+  desc.schema.add(FLOATS, "t", "AVG(id)");
+  desc.schema.add(CHARS, "t", "MAX(name)");
+  desc.schema.add(INTS, "t", "MIN(id)");
+}
+
+static void add_rows(HashAggregator &aggregator) {
+  char name[16];
+  for (int i = 0; i < ROW_NUM; i++) {
+    Tuple tuple;
+    tuple.add(i);
+    if (i % GROUP_NUM == GROUP_NUM - 1) {
+      tuple.add();
+    } else {
+      tuple.add(i % GROUP_NUM);
+    }
+    snprintf(name, sizeof(name), "name_%04d", i);
+    tuple.add(name, strlen(name));
+    ASSERT_EQ(RC::SUCCESS, aggregator.add(tuple));
+  }
+}
+
+static void to_rows(const std::vector<Tuple> &results, std::vector<std::string> &rows) {
+  for (const Tuple &tuple : results) {
+    std::string row;
+    for (int i = 0; i < tuple.size(); i++) {
+      row += tuple.get(i).to_string();
+      row += "|";
+    }
+    rows.push_back(row);
+  }
+}
+
+TEST(test_hash_aggregator, test_group_by) {
+  AggregationDesc desc;
+  init_desc(desc);
+  HashAggregator aggregator(desc);
+  add_rows(aggregator);
+  std::vector<Tuple> results;
+  ASSERT_EQ(RC::SUCCESS, aggregator.finish(results));
+  ASSERT_EQ(0, aggregator.spilled_partitions());
+
+  // 没有超过内存预算时按分组第一次出现的顺序输出，null是单独的一个分组
+  ASSERT_EQ(GROUP_NUM, (int)results.size());
+  for (int g = 0; g < GROUP_NUM; g++) {
+    const Tuple &tuple = results[g];
+    ASSERT_EQ(6, tuple.size());
+    if (g == GROUP_NUM - 1) {
+      ASSERT_EQ(IS_NULL, tuple.get(0).type());
+      ASSERT_EQ("0", tuple.get(2).to_string());
+    } else {
+      ASSERT_EQ(std::to_string(g), tuple.get(0).to_string());
+      ASSERT_EQ("10", tuple.get(2).to_string());
+    }
+    ASSERT_EQ("10", tuple.get(1).to_string());
+    ASSERT_FLOAT_EQ(g + 450, atof(tuple.get(3).to_string().c_str()));
+    char name[16];
+    snprintf(name, sizeof(name), "name_%04d", g + 900);
+    ASSERT_EQ(name, tuple.get(4).to_string());
+    ASSERT_EQ(std::to_string(g), tuple.get(5).to_string());
+  }
+}
+
+TEST(test_hash_aggregator, test_null_aggregation) {
+  // 只有null的分组：COUNT为0，AVG/MAX/MIN为null
+  AggregationDesc desc;
+  desc.types = {COUNT, AVG, MAX, MIN};
+  desc.indexes = {0, 0, 0, 0};
+  desc.outputs = {0, 1, 2, 3};
+  HashAggregator aggregator(desc);
+  for (int i = 0; i < 3; i++) {
+    Tuple tuple;
+    tuple.add();
+    ASSERT_EQ(RC::SUCCESS, aggregator.add(tuple));
+  }
+  std::vector<Tuple> results;
+  ASSERT_EQ(RC::SUCCESS, aggregator.finish(results));
+  ASSERT_EQ(1, (int)results.size());
+  ASSERT_EQ("0", results[0].get(0).to_string());
+  ASSERT_EQ(IS_NULL, results[0].get(1).type());
+  ASSERT_EQ(IS_NULL, results[0].get(2).type());
+  ASSERT_EQ(IS_NULL, results[0].get(3).type());
+}
+
+TEST(test_hash_aggregator, test_spill) {
+  AggregationDesc desc;
+  init_desc(desc);
+
+  std::vector<Tuple> results;
+  std::vector<std::string> expected;
+  HashAggregator in_memory(desc);
+  add_rows(in_memory);
+  ASSERT_EQ(RC::SUCCESS, in_memory.finish(results));
+  to_rows(results, expected);
+
+  // 内存预算很小，第一个分组之后的元组都要分区写到临时文件中
+  results.clear();
+  std::vector<std::string> rows;
+  HashAggregator spilled(desc, 1);
+  add_rows(spilled);
+  ASSERT_EQ(RC::SUCCESS, spilled.finish(results));
+  ASSERT_GT(spilled.spilled_partitions(), 0);
+  to_rows(results, rows);
+
+  ASSERT_EQ(GROUP_NUM, (int)rows.size());
+  std::sort(expected.begin(), expected.end());
+  std::sort(rows.begin(), rows.end());
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(test_hash_aggregator, test_sum) {
+  // 整数的和超过int时用浮点数输出，浮点数按原始值累加不会截断
+  AggregationDesc desc;
+  desc.types = {SUM, SUM, AVG};
+  desc.indexes = {0, 1, 1};
+  desc.outputs = {0, 1, 2};
+  HashAggregator aggregator(desc);
+  for (int i = 0; i < 4; i++) {
+    Tuple tuple;
+    tuple.add(1 << 30);
+    tuple.add(0.25f);
+    ASSERT_EQ(RC::SUCCESS, aggregator.add(tuple));
+  }
+  std::vector<Tuple> results;
+  ASSERT_EQ(RC::SUCCESS, aggregator.finish(results));
+  ASSERT_EQ(1, (int)results.size());
+  ASSERT_EQ(FLOATS, results[0].get(0).type());
+  ASSERT_FLOAT_EQ(4.0f * (1 << 30), results[0].get(0).float_value());
+  ASSERT_FLOAT_EQ(1.0f, results[0].get(1).float_value());
+  ASSERT_FLOAT_EQ(0.25f, results[0].get(2).float_value());
+}
+
+TEST(test_hash_aggregator, test_numeric_aggregate) {
+  const int num = 1000;
+  std::vector<int> values(num);
+  std::vector<uint8_t> nulls(num);
+  IntAggregate row_by_row;
+  for (int i = 0; i < num; i++) {
+    values[i] = i - 500;
+    nulls[i] = i % 10 == 0;
+    if (!nulls[i]) {
+      row_by_row.update(values[i]);
+    }
+  }
+
+  // 分多批更新，结果与逐个值更新一致
+  IntAggregate batch;
+  for (int i = 0; i < num; i += 300) {
+    batch.update_batch(values.data() + i, nulls.data() + i, std::min(300, num - i));
+  }
+  ASSERT_EQ(900, batch.count());
+  ASSERT_EQ(row_by_row.count(), batch.count());
+  ASSERT_EQ(row_by_row.sum(), batch.sum());
+  ASSERT_EQ(-499, batch.min());
+  ASSERT_EQ(499, batch.max());
+
+  IntAggregate all;
+  all.update_batch(values.data(), num);
+  ASSERT_EQ(num, all.count());
+  ASSERT_EQ(-500, all.min());
+  ASSERT_EQ(-500, all.sum());
+
+  IntAggregate merged;
+  merged.merge(batch);
+  merged.merge(all);
+  ASSERT_EQ(batch.count() + all.count(), merged.count());
+  ASSERT_EQ(-500, merged.min());
+
+  FloatAggregate floats;
+  ASSERT_TRUE(floats.empty());
+  std::vector<float> float_values(num, 0.1f);
+  floats.update_batch(float_values.data(), num);
+  ASSERT_NEAR(100.0, floats.sum(), 1e-3);
+  ASSERT_NEAR(0.1, floats.avg(), 1e-6);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,235 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "sql/executor/execution_node.h"
+#include "sql/optimizer/join_planner.h"
+
+static void create_table(Table &table, const std::string &base_dir, const std::string &name, int record_num) {
+  AttrInfo attrs[2] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"val";
+  attrs[1].type = INTS;
+  attrs[1].length = 4;
+  std::string meta_file = base_dir + "/" + name + ".table";
+  ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), name.c_str(), base_dir.c_str(), 2, attrs));
+
+  for (int i = 0; i < record_num; i++) {
+    Value values[2];
+    value_init_integer(&values[0], i);
+    value_init_integer(&values[1], i % 3);
+    ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+    value_destroy(&values[0]);
+    value_destroy(&values[1]);
+  }
+}
+
+/**
+ * 与Db::drop_table一样用新的Table对象删除表。原来的表要先关闭，否则它在buffer pool中的页面还关联着删除的文件
+ */
+static void drop_table(const std::string &base_dir, const std::string &name) {
+  Table table;
+  table.drop((base_dir + "/" + name + ".table").c_str(), name.c_str(), base_dir.c_str());
+}
+
+static void value_condition(Condition &condition, const char *attr_name, CompOp comp, int *value) {
+  memset(&condition, 0, sizeof(condition));
+  condition.left_is_attr = 1;
+  condition.left_attr.attribute_name = (char *)attr_name;
+  condition.comp = comp;
+  condition.right_value.type = INTS;
+  condition.right_value.data = value;
+}
+
+static void join_condition(Condition &condition, const char *left_table, const char *right_table) {
+  memset(&condition, 0, sizeof(condition));
+  condition.left_is_attr = 1;
+  condition.left_attr.relation_name = (char *)left_table;
+  condition.left_attr.attribute_name = (char *)"id";
+  condition.comp = EQUAL_TO;
+  condition.right_is_attr = 1;
+  condition.right_attr.relation_name = (char *)right_table;
+  condition.right_attr.attribute_name = (char *)"id";
+}
+
+static int count_index_scan(Table &table, CompOp comp, int value) {
+  TupleSchema schema;
+  TupleSchema::from_table(&table, schema);
+  SelectExeNode node;
+  EXPECT_EQ(RC::SUCCESS, node.init(nullptr, &table, std::move(schema), std::vector<DefaultConditionFilter *>()));
+  node.set_index_scan("id", comp, std::string((const char *)&value, sizeof(value)));
+  TupleSet tuple_set;
+  EXPECT_EQ(RC::SUCCESS, node.execute(tuple_set));
+  return tuple_set.size();
+}
+
+TEST(test_join_planner, test_access_path) {
+  std::string base_dir = "./join_planner_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table t1;
+    create_table(t1, base_dir, "t1", 300);
+    char *index_attrs[] = {(char *)"id"};
+    ASSERT_EQ(RC::SUCCESS, t1.create_index(nullptr, "t1_id", index_attrs, false, 1));
+
+    // 索引上的等值查找只读取少量记录
+    int value = 5;
+    Selects selects;
+    memset(&selects, 0, sizeof(selects));
+    selects.condition_num = 1;
+    value_condition(selects.conditions[0], "id", EQUAL_TO, &value);
+    JoinPlan join_plan;
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1}, selects, join_plan));
+    ASSERT_EQ(1, (int)join_plan.access_paths.size());
+    ASSERT_EQ("id", join_plan.access_paths[0].index_field);
+    ASSERT_EQ(EQUAL_TO, join_plan.access_paths[0].comp_op);
+    ASSERT_EQ(std::string((const char *)&value, sizeof(value)), join_plan.access_paths[0].value);
+
+    // 范围条件要随机读取大量记录，顺序扫描更便宜
+    value_condition(selects.conditions[0], "id", GREAT_THAN, &value);
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1}, selects, join_plan));
+    ASSERT_TRUE(join_plan.access_paths[0].index_field.empty());
+
+    // val上没有索引
+    value_condition(selects.conditions[0], "val", EQUAL_TO, &value);
+    ASSERT_EQ(RC::SUCCESS, plan_join(std::vector<Table *>{&t1}, selects, join_plan));
+    ASSERT_TRUE(join_plan.access_paths[0].index_field.empty());
+
+    ASSERT_EQ(1, count_index_scan(t1, EQUAL_TO, 5));
+    ASSERT_EQ(49, count_index_scan(t1, GREAT_THAN, 250));
+    ASSERT_EQ(50, count_index_scan(t1, GREAT_EQUAL, 250));
+    ASSERT_EQ(11, count_index_scan(t1, LESS_EQUAL, 10));
+    ASSERT_EQ(10, count_index_scan(t1, LESS_THAN, 10));
+  }
+  drop_table(base_dir, "t1");
+  // drop不会删除索引文件
+  unlink((base_dir + "/t1-t1_id.index").c_str());
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_join_planner, test_join_order) {
+  std::string base_dir = "./join_planner_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    // 链状的连接条件 t0.id = t1.id, t1.id = t2.id, ...，任何顺序都不应该出现笛卡尔积
+    for (int table_num : {4, 12}) {
+      std::vector<Table *> tables;
+      std::vector<std::string> names;
+      for (int i = 0; i < table_num; i++) {
+        names.push_back("t" + std::to_string(i));
+      }
+      for (int i = 0; i < table_num; i++) {
+        Table *table = new Table;
+        create_table(*table, base_dir, names[i], (i % 3 + 1) * 10);
+        tables.push_back(table);
+      }
+
+      Selects selects;
+      memset(&selects, 0, sizeof(selects));
+      selects.condition_num = table_num - 1;
+      for (int i = 0; i + 1 < table_num; i++) {
+        join_condition(selects.conditions[i], names[i].c_str(), names[i + 1].c_str());
+      }
+
+      JoinPlan join_plan;
+      ASSERT_EQ(RC::SUCCESS, plan_join(tables, selects, join_plan));
+      ASSERT_EQ(table_num, (int)join_plan.steps.size());
+      std::set<int> joined;
+      for (size_t i = 0; i < join_plan.steps.size(); i++) {
+        const JoinStep &join_step = join_plan.steps[i];
+        ASSERT_TRUE(joined.insert(join_step.table).second);
+        if (i > 0) {
+          ASSERT_EQ(HASH_JOIN, join_step.method);
+          // 新表与已连接的表之间有连接条件
+          const int table = join_step.table;
+          ASSERT_TRUE(joined.count(table - 1) > 0 || joined.count(table + 1) > 0);
+        }
+      }
+      ASSERT_GT(join_plan.cost, 0);
+
+      for (int i = 0; i < table_num; i++) {
+        delete tables[i];
+        drop_table(base_dir, names[i]);
+      }
+    }
+  }
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_join_planner, test_join_method) {
+  std::string base_dir = "./join_planner_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+
+  {
+    Table m1;
+    Table m2;
+    create_table(m1, base_dir, "m1", 1000);
+    create_table(m2, base_dir, "m2", 1000);
+    char *index_attrs[] = {(char *)"id"};
+    ASSERT_EQ(RC::SUCCESS, m1.create_index(nullptr, "m1_id", index_attrs, false, 1));
+    ASSERT_EQ(RC::SUCCESS, m2.create_index(nullptr, "m2_id", index_attrs, false, 1));
+
+    Selects selects;
+    memset(&selects, 0, sizeof(selects));
+    selects.relation_num = 2;
+    selects.relations[0] = (char *)"m2";
+    selects.relations[1] = (char *)"m1";
+    selects.condition_num = 1;
+    join_condition(selects.conditions[0], "m1", "m2");
+    const std::vector<Table *> tables{&m1, &m2};
+
+    // 两张表都要全部读取时，按索引顺序随机读取比顺序扫描后hash join代价更高
+    JoinPlan join_plan;
+    ASSERT_EQ(RC::SUCCESS, plan_join(tables, selects, join_plan));
+    ASSERT_EQ(2, (int)join_plan.steps.size());
+    ASSERT_EQ(HASH_JOIN, join_plan.steps[1].method);
+    ASSERT_TRUE(join_plan.access_paths[0].index_field.empty());
+    ASSERT_TRUE(join_plan.access_paths[1].index_field.empty());
+
+    // 两张表的连接字段上都有选择性高的条件，只按索引顺序读取范围内的记录后归并，保留选择的访问路径
+    int value = 10;
+    selects.condition_num = 3;
+    value_condition(selects.conditions[1], "id", EQUAL_TO, &value);
+    selects.conditions[1].left_attr.relation_name = (char *)"m1";
+    value_condition(selects.conditions[2], "id", EQUAL_TO, &value);
+    selects.conditions[2].left_attr.relation_name = (char *)"m2";
+    ASSERT_EQ(RC::SUCCESS, plan_join(tables, selects, join_plan));
+    ASSERT_EQ(SORT_MERGE_JOIN, join_plan.steps[1].method);
+    for (const AccessPath &access_path : join_plan.access_paths) {
+      ASSERT_EQ("id", access_path.index_field);
+      ASSERT_EQ(EQUAL_TO, access_path.comp_op);
+    }
+  }
+  drop_table(base_dir, "m1");
+  drop_table(base_dir, "m2");
+  unlink((base_dir + "/m1-m1_id.index").c_str());
+  unlink((base_dir + "/m2-m2_id.index").c_str());
+  rmdir(base_dir.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/null_bitmap.h"
+#include "storage/default/disk_buffer_pool.h"
+
+static void count_reader(const char *data, void *context) {
+  (*(int *)context)++;
+}
+
+static int count_score(Table &table, CompOp comp, Value *value) {
+  Condition condition;
+  memset(&condition, 0, sizeof(condition));
+  condition.left_is_attr = 1;
+  condition.left_attr.attribute_name = (char *)"score";
+  condition.comp = comp;
+  condition.right_is_attr = 0;
+  condition.right_value = *value;
+
+  DefaultConditionFilter filter;
+  EXPECT_EQ(RC::SUCCESS, filter.init(table, condition));
+  int count = 0;
+  EXPECT_EQ(RC::SUCCESS, table.scan_record(nullptr, &filter, -1, &count, count_reader));
+  return count;
+}
+
+TEST(test_null_bitmap, test_null_bitmap) {
+  char bitmap[NULL_BITMAP_SIZE] = {0};
+  null_bitmap_set(bitmap, 3, true);
+  null_bitmap_set(bitmap, 9, true);
+  ASSERT_TRUE(null_bitmap_test(bitmap, 3));
+  ASSERT_TRUE(null_bitmap_test(bitmap, 9));
+  ASSERT_FALSE(null_bitmap_test(bitmap, 4));
+  ASSERT_FALSE(null_bitmap_test(bitmap, -1));
+  null_bitmap_set(bitmap, 3, false);
+  ASSERT_FALSE(null_bitmap_test(bitmap, 3));
+}
+
+TEST(test_null_bitmap, test_nullable_column) {
+  std::string base_dir = "./null_bitmap_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/t.table";
+
+  AttrInfo attrs[2] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"score";
+  attrs[1].type = INTS;
+  attrs[1].length = 4;
+  attrs[1].nullable = true;
+
+  Table table;
+  ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "t", base_dir.c_str(), 2, attrs));
+  ASSERT_FALSE(table.table_meta().field("id")->nullable());
+  ASSERT_EQ(0, table.table_meta().field("score")->null_bit());
+
+  // 唯一索引不检查null，多个null可以共存
+  char *index_attrs[] = {(char *)"score"};
+  ASSERT_EQ(RC::SUCCESS, table.create_index(nullptr, "i_score", index_attrs, true, 1));
+
+  for (int i = 0; i < 10; i++) {
+    Value values[2];
+    value_init_integer(&values[0], i);
+    if (i % 2 == 0) {
+      value_init_null(&values[1]);
+    } else {
+      value_init_integer(&values[1], i);
+    }
+    ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+    value_destroy(&values[0]);
+    value_destroy(&values[1]);
+  }
+
+  // 非空字段不能插入null
+  Value bad_values[2];
+  value_init_null(&bad_values[0]);
+  value_init_integer(&bad_values[1], 100);
+  ASSERT_NE(RC::SUCCESS, table.insert_record(nullptr, 2, bad_values, 1));
+  value_destroy(&bad_values[1]);
+
+  Value null_value;
+  value_init_null(&null_value);
+  ASSERT_EQ(5, count_score(table, IS, &null_value));
+  ASSERT_EQ(5, count_score(table, IS_NOT, &null_value));
+
+  Value int_value;
+  value_init_integer(&int_value, 3);
+  ASSERT_EQ(1, count_score(table, EQUAL_TO, &int_value));
+  // null和任何值比较都不成立
+  ASSERT_EQ(4, count_score(table, NOT_EQUAL, &int_value));
+  value_destroy(&int_value);
+
+  table.drop(meta_file.c_str(), "t", base_dir.c_str());
+  // drop不会删除索引文件
+  unlink((base_dir + "/t-i_score.index").c_str());
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_null_bitmap, test_table_without_null_field) {
+  std::string base_dir = "./null_bitmap_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/old.table";
+
+  // 加入null支持之前创建的表，元数据中只有事务字段，没有null位图字段
+  const char *meta =
+      "{\"table_name\":\"old\",\"fields\":["
+      "{\"name\":\"__trx\",\"type\":\"ints\",\"offset\":0,\"len\":4,\"visible\":false},"
+      "{\"name\":\"id\",\"type\":\"ints\",\"offset\":4,\"len\":4,\"visible\":true},"
+      "{\"name\":\"score\",\"type\":\"ints\",\"offset\":8,\"len\":4,\"visible\":true}]}";
+  FILE *fp = fopen(meta_file.c_str(), "w");
+  ASSERT_NE(nullptr, fp);
+  fputs(meta, fp);
+  fclose(fp);
+  ASSERT_EQ(RC::SUCCESS, theGlobalDiskBufferPool()->create_file((base_dir + "/old.data").c_str()));
+
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("old.table", base_dir.c_str()));
+    ASSERT_EQ(nullptr, table.table_meta().null_field());
+    ASSERT_EQ(1, table.table_meta().sys_field_num());
+    ASSERT_EQ(12, table.table_meta().record_size());
+    ASSERT_EQ(-1, table.table_meta().field("score")->null_bit());
+
+    for (int i = 0; i < 10; i++) {
+      Value values[2];
+      value_init_integer(&values[0], i);
+      value_init_integer(&values[1], i % 3);
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+      value_destroy(&values[0]);
+      value_destroy(&values[1]);
+    }
+
+    Value null_value;
+    value_init_null(&null_value);
+    ASSERT_EQ(0, count_score(table, IS, &null_value));
+    ASSERT_EQ(10, count_score(table, IS_NOT, &null_value));
+    Value int_value;
+    value_init_integer(&int_value, 1);
+    ASSERT_EQ(3, count_score(table, EQUAL_TO, &int_value));
+    value_destroy(&int_value);
+  }
+
+  Table().drop(meta_file.c_str(), "old", base_dir.c_str());
+  rmdir(base_dir.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
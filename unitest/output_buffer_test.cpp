@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "net/output_buffer.h"
+
+struct Client {
+  std::vector<std::string> packets;
+  int fail_after = -1;                /// 发送这么多次之后失败，-1表示不失败
+
+  std::string received() const {
+    std::string data;
+    for (const std::string &packet : packets) {
+      data += packet;
+    }
+    return data;
+  }
+};
+
+static int send_to_client(void *context, const char *data, int len) {
+  Client &client = *(Client *)context;
+  if (client.fail_after >= 0 && (int)client.packets.size() >= client.fail_after) {
+    return -1;
+  }
+  client.packets.emplace_back(data, len);
+  return 0;
+}
+
+TEST(test_output_buffer, test_flush_when_full) {
+  Client client;
+  OutputBuffer buffer(send_to_client, &client, 16);
+  std::ostream os(&buffer);
+
+  // 缓冲区没有满之前不发送
+  os << "id | name" << '\n';
+  ASSERT_TRUE(client.packets.empty());
+  ASSERT_EQ(10, buffer.written_bytes());
+
+  std::string expected = "id | name\n";
+  for (int i = 0; i < 20; i++) {
+    os << i << " | name" << i << '\n';
+    expected += std::to_string(i) + " | name" + std::to_string(i) + "\n";
+  }
+  // 写满一次就发送一次，每次发送的都是完整的缓冲区
+  ASSERT_FALSE(client.packets.empty());
+  for (const std::string &packet : client.packets) {
+    ASSERT_EQ(16, (int)packet.size());
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer.flush());
+  ASSERT_EQ(expected, client.received());
+  ASSERT_EQ((int64_t)expected.size(), buffer.written_bytes());
+  ASSERT_EQ(RC::SUCCESS, buffer.flush());
+  ASSERT_EQ(expected, client.received());
+
+  // 比缓冲区大的一次写入
+  const std::string large(100, 'x');
+  os << large;
+  ASSERT_EQ(RC::SUCCESS, buffer.flush());
+  ASSERT_EQ(expected + large, client.received());
+}
+
+TEST(test_output_buffer, test_capture) {
+  Client client;
+  OutputBuffer buffer(send_to_client, &client, 8);
+  std::ostream os(&buffer);
+  ASSERT_FALSE(buffer.captured());
+
+  buffer.capture(32);
+  os << "0123456789abcdef";
+  ASSERT_EQ(RC::SUCCESS, buffer.flush());
+  ASSERT_TRUE(buffer.captured());
+  ASSERT_EQ("0123456789abcdef", buffer.captured_data());
+
+  // 超过限制之后不再保留副本，数据照常发送
+  os << "0123456789abcdef0123456789abcdef";
+  ASSERT_EQ(RC::SUCCESS, buffer.flush());
+  ASSERT_FALSE(buffer.captured());
+  ASSERT_TRUE(buffer.captured_data().empty());
+  ASSERT_EQ(48, (int)client.received().size());
+}
+
+TEST(test_output_buffer, test_send_failure) {
+  Client client;
+  client.fail_after = 1;
+  OutputBuffer buffer(send_to_client, &client, 4);
+  std::ostream os(&buffer);
+
+  os << "abcdefghijkl";
+  ASSERT_TRUE(buffer.failed());
+  ASSERT_FALSE(os.good());
+  ASSERT_EQ("abcd", client.received());
+
+  // 发送失败之后不再发送
+  os.clear();
+  os << "mnop";
+  ASSERT_NE(RC::SUCCESS, buffer.flush());
+  ASSERT_EQ(1, (int)client.packets.size());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/record_manager.h"
+
+// 只能逐条记录过滤的条件：删除id是奇数的记录
+class OddFilter : public ConditionFilter {
+public:
+  explicit OddFilter(int offset) : offset_(offset) {}
+  bool filter(const Record &rec) const override {
+    return *(int *)(rec.data + offset_) % 2 != 0;
+  }
+  bool filter(const TupleSchema &schema, const Tuple &tuple) const override {
+    return false;
+  }
+private:
+  int offset_;
+};
+
+struct ScanResult {
+  const TableMeta *table_meta;
+  int count;
+  long id_sum;
+};
+
+static void scan_reader(const char *data, void *context) {
+  ScanResult *result = (ScanResult *)context;
+  result->count++;
+  result->id_sum += *(int *)(data + result->table_meta->field("id")->offset());
+  // 拼装出来的行中各列都要和插入时一致
+  int id = *(int *)(data + result->table_meta->field("id")->offset());
+  EXPECT_EQ(id % 7, *(int *)(data + result->table_meta->field("grp")->offset()));
+  EXPECT_STREQ(std::to_string(id).c_str(), data + result->table_meta->field("name")->offset());
+}
+
+static void init_condition(Condition &condition, const char *attr_name, CompOp comp, Value value) {
+  memset(&condition, 0, sizeof(condition));
+  condition.left_is_attr = 1;
+  condition.left_attr.attribute_name = (char *)attr_name;
+  condition.comp = comp;
+  condition.right_is_attr = 0;
+  condition.right_value = value;
+}
+
+static ScanResult scan(Table &table, ConditionFilter *filter) {
+  ScanResult result{&table.table_meta(), 0, 0};
+  EXPECT_EQ(RC::SUCCESS, table.scan_record(nullptr, filter, -1, &result, scan_reader));
+  return result;
+}
+
+TEST(test_pax_table, test_pax_table) {
+  std::string base_dir = "./pax_table_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/t.table";
+
+  AttrInfo attrs[4] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+  attrs[1].name = (char *)"grp";
+  attrs[1].type = INTS;
+  attrs[1].length = 4;
+  attrs[1].nullable = true;
+  attrs[2].name = (char *)"name";
+  attrs[2].type = CHARS;
+  attrs[2].length = 10;
+  attrs[3].name = (char *)"pad";
+  attrs[3].type = CHARS;
+  attrs[3].length = 100;
+
+  const int record_num = 1000;
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "t", base_dir.c_str(), 4, attrs, PAX_FORMAT));
+    ASSERT_EQ(PAX_FORMAT, table.table_meta().storage_format());
+
+    for (int i = 0; i < record_num; i++) {
+      Value values[4];
+      value_init_integer(&values[0], i);
+      value_init_integer(&values[1], i % 7);
+      value_init_string(&values[2], std::to_string(i).c_str());
+      value_init_string(&values[3], "pad");
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 4, values, 1));
+      for (Value &value : values) {
+        value_destroy(&value);
+      }
+    }
+
+    ScanResult all = scan(table, nullptr);
+    ASSERT_EQ(record_num, all.count);
+    ASSERT_EQ((long)record_num * (record_num - 1) / 2, all.id_sum);
+
+    // 按列过滤的条件组合
+    Value id_value;
+    value_init_integer(&id_value, 100);
+    Value grp_value;
+    value_init_integer(&grp_value, 3);
+    Condition conditions[2];
+    init_condition(conditions[0], "id", LESS_THAN, id_value);
+    init_condition(conditions[1], "grp", EQUAL_TO, grp_value);
+    CompositeConditionFilter filter;
+    ASSERT_EQ(RC::SUCCESS, filter.init(table, conditions, 2));
+    ScanResult result = scan(table, &filter);
+    ASSERT_EQ(14, result.count); // 3, 10, ..., 94
+
+    Value name_value;
+    value_init_string(&name_value, "999");
+    Condition name_condition;
+    init_condition(name_condition, "name", EQUAL_TO, name_value);
+    DefaultConditionFilter name_filter;
+    ASSERT_EQ(RC::SUCCESS, name_filter.init(table, name_condition));
+    result = scan(table, &name_filter);
+    ASSERT_EQ(1, result.count);
+    ASSERT_EQ(999, result.id_sum);
+    value_destroy(&id_value);
+    value_destroy(&grp_value);
+    value_destroy(&name_value);
+
+    OddFilter odd_filter(table.table_meta().field("id")->offset());
+    int deleted_count = 0;
+    ASSERT_EQ(RC::SUCCESS, table.delete_record(nullptr, &odd_filter, &deleted_count));
+    ASSERT_EQ(record_num / 2, deleted_count);
+    table.sync();
+  }
+
+  // 重新打开后仍然按PAX格式读取
+  {
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", base_dir.c_str()));
+    ASSERT_EQ(PAX_FORMAT, table.table_meta().storage_format());
+    ScanResult result = scan(table, nullptr);
+    ASSERT_EQ(record_num / 2, result.count);
+
+    Value null_value;
+    value_init_null(&null_value);
+    Condition condition;
+    init_condition(condition, "grp", IS_NOT, null_value);
+    DefaultConditionFilter filter;
+    ASSERT_EQ(RC::SUCCESS, filter.init(table, condition));
+    result = scan(table, &filter);
+    ASSERT_EQ(record_num / 2, result.count);
+    table.drop(meta_file.c_str(), "t", base_dir.c_str());
+  }
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_pax_table, test_get_pax_record) {
+  std::string file_name = "./pax_table_test." + std::to_string(getpid()) + ".pax.data";
+  DiskBufferPool *buffer_pool = theGlobalDiskBufferPool();
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->create_file(file_name.c_str()));
+  int file_id = -1;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->open_file(file_name.c_str(), &file_id));
+
+  PaxLayout pax_layout;
+  pax_layout.add_column(sizeof(int));
+  pax_layout.add_column(sizeof(int));
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*buffer_pool, file_id, &pax_layout));
+
+  std::vector<RID> rids(2);
+  for (int i = 0; i < 2; i++) {
+    int data[2] = {i, i * 10};
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record((const char *)data, sizeof(data), &rids[i]));
+  }
+
+  // 拼装的记录在各自的缓冲区中，后一次读取不会覆盖前一次的结果
+  std::vector<char> buffer0;
+  std::vector<char> buffer1;
+  Record record0;
+  Record record1;
+  ASSERT_EQ(RC::SUCCESS, file_handler.get_record(&rids[0], &record0, buffer0));
+  ASSERT_EQ(RC::SUCCESS, file_handler.get_record(&rids[1], &record1, buffer1));
+  ASSERT_EQ(buffer0.data(), record0.data);
+  ASSERT_EQ(0, ((int *)record0.data)[0]);
+  ASSERT_EQ(0, ((int *)record0.data)[1]);
+  ASSERT_EQ(1, ((int *)record1.data)[0]);
+  ASSERT_EQ(10, ((int *)record1.data)[1]);
+
+  file_handler.close();
+  buffer_pool->close_file(file_id);
+  buffer_pool->drop_file(file_name.c_str());
+  unlink(file_name.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql/plan_cache/plan_cache.h"
+
+static std::shared_ptr<CachedPlan> make_plan(const char *sql) {
+  const uint64_t version = PlanCache::version();
+  Query *query = nullptr;
+  EXPECT_EQ(RC::SUCCESS, heap_query_parse(sql, query));
+  return query == nullptr ? nullptr : std::make_shared<CachedPlan>(query, version);
+}
+
+TEST(test_plan_cache, test_make_key) {
+  // 引号之外的空白规范化，引号中的内容不变
+  ASSERT_EQ(PlanCache::make_key("db", "select * from t where id = 1;"),
+            PlanCache::make_key("db", "  select  *\n from t\twhere id = 1; "));
+  ASSERT_NE(PlanCache::make_key("db", "select * from t where name = 'a b';"),
+            PlanCache::make_key("db", "select * from t where name = 'a  b';"));
+  ASSERT_NE(PlanCache::make_key("db", "select * from T;"), PlanCache::make_key("db", "select * from t;"));
+  ASSERT_NE(PlanCache::make_key("db1", "select * from t;"), PlanCache::make_key("db2", "select * from t;"));
+}
+
+TEST(test_plan_cache, test_lru_and_invalidate) {
+  PlanCache plan_cache(2);
+  std::shared_ptr<CachedPlan> p1 = make_plan("select * from t where id = 1;");
+  std::shared_ptr<CachedPlan> p2 = make_plan("select * from t where id = 2;");
+  std::shared_ptr<CachedPlan> p3 = make_plan("select * from t where id = 3;");
+  plan_cache.put("k1", p1);
+  plan_cache.put("k2", p2);
+  ASSERT_EQ(p1, plan_cache.get("k1"));
+
+  // k2最久没有使用，被淘汰
+  plan_cache.put("k3", p3);
+  ASSERT_EQ(2, (int)plan_cache.size());
+  ASSERT_EQ(nullptr, plan_cache.get("k2"));
+  ASSERT_EQ(p1, plan_cache.get("k1"));
+  ASSERT_EQ(p3, plan_cache.get("k3"));
+
+  // 表结构或者统计信息变化后，之前的计划都失效
+  PlanCache::invalidate();
+  ASSERT_TRUE(p1->stale());
+  ASSERT_EQ(nullptr, plan_cache.get("k1"));
+  ASSERT_EQ(1, (int)plan_cache.size());
+
+  std::shared_ptr<CachedPlan> p4 = make_plan("select * from t where id = 4;");
+  ASSERT_FALSE(p4->stale());
+  plan_cache.put("k1", p4);
+  ASSERT_EQ(p4, plan_cache.get("k1"));
+
+  plan_cache.set_capacity(0);
+  ASSERT_EQ(0, (int)plan_cache.size());
+  plan_cache.put("k1", p4);
+  ASSERT_EQ(nullptr, plan_cache.get("k1"));
+}
+
+TEST(test_plan_cache, test_prepare_and_bind) {
+  std::shared_ptr<CachedPlan> plan = make_plan("prepare p from select * from t where id = ? and name = ?;");
+  ASSERT_NE(nullptr, plan);
+  const Query &prepared = *plan->query();
+  ASSERT_EQ(SCF_SELECT, prepared.flag);
+  ASSERT_STREQ("p", prepared.prepare_name);
+  ASSERT_TRUE(query_cacheable(prepared));
+  ASSERT_EQ(2, plan->param_num());
+
+  Query *execute = nullptr;
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("execute p using 5, 'abc';", execute));
+  ASSERT_EQ(SCF_EXECUTE, execute->flag);
+  ASSERT_STREQ("p", execute->sstr.execution.name);
+  ASSERT_EQ(2, (int)execute->sstr.execution.value_num);
+
+  Query bound;
+  ASSERT_EQ(RC::SUCCESS, bind_parameters(prepared, execute->sstr.execution, bound));
+  ASSERT_EQ(0, query_param_num(bound));
+  int values_found = 0;
+  const Selects &selects = bound.sstr.selection;
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    const Value &value = selects.conditions[i].right_value;
+    if (value.type == INTS) {
+      ASSERT_EQ(5, *(int *)value.data);
+      values_found++;
+    } else if (value.type == CHARS) {
+      ASSERT_STREQ("abc", (const char *)value.data);
+      values_found++;
+    }
+  }
+  ASSERT_EQ(2, values_found);
+  // 模板中的参数不受影响
+  ASSERT_EQ(2, query_param_num(prepared));
+  heap_query_destroy(execute);
+
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("execute p using 5;", execute));
+  ASSERT_NE(RC::SUCCESS, bind_parameters(prepared, execute->sstr.execution, bound));
+  heap_query_destroy(execute);
+
+  plan = make_plan("prepare ins from insert into t values(?, 1, ?);");
+  ASSERT_EQ(SCF_INSERT, plan->query()->flag);
+  ASSERT_EQ(2, plan->param_num());
+
+  Query *query = nullptr;
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("deallocate prepare p;", query));
+  ASSERT_EQ(SCF_DEALLOCATE, query->flag);
+  ASSERT_STREQ("p", query->sstr.deallocation.name);
+  heap_query_destroy(query);
+
+  // 有子查询的语句不能缓存
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("select * from t1 where id in (select id from t2);", query));
+  ASSERT_FALSE(query_cacheable(*query));
+  heap_query_destroy(query);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/common/predicate_kernel.h"
+#include "storage/common/null_bitmap.h"
+
+static const int ROW_NUM = 100;
+
+/**
+ * 行格式的记录：null位图(4) + id(4) + score(4) + name(5)，记录之间按24字节对齐
+ */
+static const int NULL_OFFSET = 0;
+static const int ID_OFFSET = 4;
+static const int SCORE_OFFSET = 8;
+static const int NAME_OFFSET = 12;
+static const int NAME_LEN = 5;
+static const int RECORD_SIZE = 24;
+
+static void init_rows(std::vector<char> &rows) {
+  rows.assign(ROW_NUM * RECORD_SIZE, 0);
+  for (int i = 0; i < ROW_NUM; i++) {
+    char *record = rows.data() + i * RECORD_SIZE;
+    const float score = i / 2.0f;
+    memcpy(record + ID_OFFSET, &i, sizeof(i));
+    memcpy(record + SCORE_OFFSET, &score, sizeof(score));
+    char name[16];
+    snprintf(name, sizeof(name), "n%04d", i); // 占满字段长度，没有结束符
+    memcpy(record + NAME_OFFSET, name, NAME_LEN);
+    null_bitmap_set(record + NULL_OFFSET, 0, i % 10 == 0);
+  }
+}
+
+static ColumnData column(const std::vector<char> &rows, int offset) {
+  ColumnData column;
+  column.data = rows.data() + offset;
+  column.stride = RECORD_SIZE;
+  return column;
+}
+
+static std::vector<int> all_slots() {
+  std::vector<int> selected(ROW_NUM);
+  for (int i = 0; i < ROW_NUM; i++) {
+    selected[i] = i;
+  }
+  return selected;
+}
+
+TEST(test_predicate_kernel, test_compare) {
+  std::vector<char> rows;
+  init_rows(rows);
+  std::vector<int> selected = all_slots();
+  std::vector<int> out(ROW_NUM);
+
+  PredicateKernel kernel;
+  int value = 30;
+  ASSERT_TRUE(kernel.compile(INTS, sizeof(int), LESS_THAN, &value));
+  ASSERT_EQ(30, kernel.select(column(rows, ID_OFFSET), selected.data(), ROW_NUM, out.data()));
+  ASSERT_EQ(29, out[29]);
+
+  ASSERT_TRUE(kernel.compile(INTS, sizeof(int), NOT_EQUAL, &value));
+  ASSERT_EQ(ROW_NUM - 1, kernel.select(column(rows, ID_OFFSET), selected.data(), ROW_NUM, out.data()));
+  ASSERT_EQ(31, out[30]);
+
+  float score = 10.0f;
+  ASSERT_TRUE(kernel.compile(FLOATS, sizeof(float), GREAT_EQUAL, &score));
+  ASSERT_EQ(ROW_NUM - 20, kernel.select(column(rows, SCORE_OFFSET), selected.data(), ROW_NUM, out.data()));
+  ASSERT_EQ(20, out[0]);
+
+  // 字段占满定长，比较时不能越过字段长度
+  ASSERT_TRUE(kernel.compile(CHARS, NAME_LEN, EQUAL_TO, "n0042"));
+  ASSERT_EQ(1, kernel.select(column(rows, NAME_OFFSET), selected.data(), ROW_NUM, out.data()));
+  ASSERT_EQ(42, out[0]);
+  ASSERT_TRUE(kernel.compile(CHARS, NAME_LEN, LESS_THAN, "n00420"));
+  ASSERT_EQ(43, kernel.select(column(rows, NAME_OFFSET), selected.data(), ROW_NUM, out.data()));
+
+  ASSERT_FALSE(kernel.compile(INTS, sizeof(int), IS, &value));
+  ASSERT_FALSE(kernel.compile(INTS, sizeof(int), EQUAL_TO, nullptr));
+}
+
+TEST(test_predicate_kernel, test_and) {
+  std::vector<char> rows;
+  init_rows(rows);
+  std::vector<int> selected = all_slots();
+  int num = ROW_NUM;
+
+  // id >= 20 and score < 30 and id不为null，每个条件在上一个条件的结果上原地过滤
+  PredicateKernel id_kernel;
+  int id = 20;
+  ASSERT_TRUE(id_kernel.compile(INTS, sizeof(int), GREAT_EQUAL, &id));
+  num = id_kernel.select(column(rows, ID_OFFSET), selected.data(), num, selected.data());
+  ASSERT_EQ(80, num);
+
+  PredicateKernel score_kernel;
+  float score = 30.0f;
+  ASSERT_TRUE(score_kernel.compile(FLOATS, sizeof(float), LESS_THAN, &score));
+  num = score_kernel.select(column(rows, SCORE_OFFSET), selected.data(), num, selected.data());
+  ASSERT_EQ(40, num);
+
+  num = select_null(column(rows, NULL_OFFSET), 0, false, selected.data(), num, selected.data());
+  ASSERT_EQ(36, num);
+  for (int i = 0; i < num; i++) {
+    ASSERT_GE(selected[i], 20);
+    ASSERT_LT(selected[i], 60);
+    ASSERT_NE(0, selected[i] % 10);
+    if (i > 0) {
+      ASSERT_LT(selected[i - 1], selected[i]);
+    }
+  }
+
+  std::vector<int> nulls = all_slots();
+  ASSERT_EQ(10, select_null(column(rows, NULL_OFFSET), 0, true, nulls.data(), ROW_NUM, nulls.data()));
+  ASSERT_EQ(90, nulls[9]);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
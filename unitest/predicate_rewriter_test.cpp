@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sql/optimizer/predicate_rewriter.h"
+#include "sql/plan_cache/plan_cache.h"
+
+static bool is_attr(const Condition &condition, bool left, const char *relation, const char *attribute) {
+  const RelAttr &attr = left ? condition.left_attr : condition.right_attr;
+  if (!(left ? condition.left_is_attr : condition.right_is_attr)) {
+    return false;
+  }
+  return attr.relation_name != nullptr && strcmp(attr.relation_name, relation) == 0 &&
+         strcmp(attr.attribute_name, attribute) == 0;
+}
+
+/**
+ * derived中是否有relation.attribute与整数value的比较
+ */
+static bool has_filter(const std::vector<Condition> &derived, const char *relation, const char *attribute,
+                       CompOp comp_op, int value) {
+  for (const Condition &condition : derived) {
+    if (condition.comp != comp_op || condition.right_is_attr || condition.right_value.type != INTS) {
+      continue;
+    }
+    if (is_attr(condition, true, relation, attribute) && *(const int *)condition.right_value.data == value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool has_equality(const std::vector<Condition> &derived, const char *relation1, const char *relation2,
+                         const char *attribute) {
+  for (const Condition &condition : derived) {
+    if (condition.comp != EQUAL_TO) {
+      continue;
+    }
+    if ((is_attr(condition, true, relation1, attribute) && is_attr(condition, false, relation2, attribute)) ||
+        (is_attr(condition, true, relation2, attribute) && is_attr(condition, false, relation1, attribute))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(test_predicate_rewriter, test_classify) {
+  Query *query = nullptr;
+  ASSERT_EQ(RC::SUCCESS,
+            heap_query_parse("select * from a, b where a.x = b.x and a.y < b.y and a.x = a.y and b.x = 1 "
+                             "and a.id in (select id from c);",
+                             query));
+  const Selects &selects = query->sstr.selection;
+  int counts[PREDICATE_NOT_FILTER + 1] = {0};
+  for (size_t i = 0; i < selects.condition_num; i++) {
+    counts[classify_predicate(selects, selects.conditions[i])]++;
+  }
+  ASSERT_EQ(1, counts[PREDICATE_EQUI_JOIN]);
+  ASSERT_EQ(1, counts[PREDICATE_RESIDUAL]);
+  ASSERT_EQ(2, counts[PREDICATE_FILTER]);
+  ASSERT_EQ(1, counts[PREDICATE_SUBQUERY]);
+  heap_query_destroy(query);
+
+  // 单表查询中字段之间的比较都是过滤条件
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("select * from a where x = y;", query));
+  ASSERT_EQ(PREDICATE_FILTER, classify_predicate(query->sstr.selection, query->sstr.selection.conditions[0]));
+  heap_query_destroy(query);
+}
+
+TEST(test_predicate_rewriter, test_derive) {
+  Query *query = nullptr;
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("select * from a, b, c where a.x = b.x and b.x = c.x and b.x > 5;", query));
+  std::vector<Condition> derived;
+  derive_predicates(query->sstr.selection, derived);
+  ASSERT_EQ(3, (int)derived.size());
+  ASSERT_TRUE(has_filter(derived, "a", "x", GREAT_THAN, 5));
+  ASSERT_TRUE(has_filter(derived, "c", "x", GREAT_THAN, 5));
+  ASSERT_TRUE(has_equality(derived, "a", "c", "x"));
+  for (const Condition &condition : derived) {
+    PredicateClass predicate_class = classify_predicate(query->sstr.selection, condition);
+    ASSERT_TRUE(predicate_class == PREDICATE_FILTER || predicate_class == PREDICATE_EQUI_JOIN);
+  }
+  heap_query_destroy(query);
+
+  // 已经存在的条件不重复推导
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("select * from a, b where a.x = b.x and b.x = 5 and a.x = 5;", query));
+  derived.clear();
+  derive_predicates(query->sstr.selection, derived);
+  ASSERT_EQ(0, (int)derived.size());
+  heap_query_destroy(query);
+
+  // 只有等值连接才能传递，null和参数不推导
+  ASSERT_EQ(RC::SUCCESS,
+            heap_query_parse("select * from a, b where a.x < b.x and b.x = 5 and a.y = b.y and b.y is null;", query));
+  derived.clear();
+  derive_predicates(query->sstr.selection, derived);
+  ASSERT_EQ(0, (int)derived.size());
+  heap_query_destroy(query);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
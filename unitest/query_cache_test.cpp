@@ -0,0 +1,124 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql/query_cache/query_cache.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "storage/common/table.h"
+#include "storage/trx/trx.h"
+
+static CachedResult make_result(const std::string &response) {
+  CachedResult result;
+  result.response = response;
+  result.tables.emplace_back("t", 1);
+  return result;
+}
+
+TEST(test_query_cache, test_lru_and_memory_limit) {
+  const size_t entry_size = std::string("k1").size() + make_result(std::string(100, 'a')).memory_size();
+  QueryCache query_cache(entry_size * 8 * 2);
+  query_cache.put("k1", make_result(std::string(100, 'a')));
+  query_cache.put("k2", make_result(std::string(100, 'b')));
+  ASSERT_EQ(2, (int)query_cache.size());
+  ASSERT_EQ(entry_size * 2, query_cache.memory_usage());
+  ASSERT_EQ(std::string(100, 'a'), query_cache.get("k1")->response);
+
+  // 超过内存上限的1/8的结果不缓存
+  query_cache.put("k3", make_result(std::string(entry_size * 2, 'c')));
+  ASSERT_EQ(nullptr, query_cache.get("k3"));
+
+  // 缩小上限之后淘汰最久没有使用的k2
+  query_cache.set_memory_limit(entry_size * 3 / 2);
+  ASSERT_EQ(1, (int)query_cache.size());
+  ASSERT_EQ(nullptr, query_cache.get("k2"));
+  ASSERT_NE(nullptr, query_cache.get("k1"));
+
+  // 替换已有的结果
+  query_cache.set_memory_limit(entry_size * 8 * 2);
+  query_cache.put("k1", make_result(std::string(100, 'd')));
+  ASSERT_EQ(1, (int)query_cache.size());
+  ASSERT_EQ(entry_size, query_cache.memory_usage());
+  ASSERT_EQ(std::string(100, 'd'), query_cache.get("k1")->response);
+
+  query_cache.remove("k1");
+  ASSERT_EQ(0, (int)query_cache.size());
+  ASSERT_EQ(0, (int)query_cache.memory_usage());
+
+  query_cache.set_memory_limit(0);
+  query_cache.put("k1", make_result("x"));
+  ASSERT_EQ(nullptr, query_cache.get("k1"));
+}
+
+TEST(test_query_cache, test_table_data_version) {
+  std::string base_dir = "./query_cache_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/t.table";
+
+  AttrInfo attrs[1] = {};
+  attrs[0].name = (char *)"id";
+  attrs[0].type = INTS;
+  attrs[0].length = 4;
+
+  Table table;
+  ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "t", base_dir.c_str(), 1, attrs));
+  const uint64_t created_version = table.data_version();
+
+  // 插入时和事务提交时都会更新版本，执行期间记下的版本在提交之后一定不再相等
+  Trx trx;
+  Value value;
+  value_init_integer(&value, 1);
+  ASSERT_EQ(RC::SUCCESS, table.insert_record(&trx, 1, &value, 1));
+  value_destroy(&value);
+  const uint64_t inserted_version = table.data_version();
+  ASSERT_NE(created_version, inserted_version);
+  ASSERT_EQ(RC::SUCCESS, trx.commit());
+  ASSERT_NE(inserted_version, table.data_version());
+
+  const uint64_t committed_version = table.data_version();
+  int deleted_count = 0;
+  ASSERT_EQ(RC::SUCCESS, table.delete_record(nullptr, nullptr, &deleted_count));
+  ASSERT_EQ(1, deleted_count);
+  ASSERT_NE(committed_version, table.data_version());
+
+  table.drop(meta_file.c_str(), "t", base_dir.c_str());
+  rmdir(base_dir.c_str());
+}
+
+TEST(test_query_cache, test_set_variable) {
+  Query *query = nullptr;
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("set query_cache = off;", query));
+  ASSERT_EQ(SCF_SET_VARIABLE, query->flag);
+  ASSERT_STREQ("query_cache", query->sstr.set_variable.name);
+  ASSERT_STREQ("off", query->sstr.set_variable.value);
+  heap_query_destroy(query);
+
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("set query_cache = on;", query));
+  ASSERT_STREQ("on", query->sstr.set_variable.value);
+  heap_query_destroy(query);
+
+  ASSERT_EQ(RC::SUCCESS, heap_query_parse("set query_cache = 0;", query));
+  ASSERT_STREQ("0", query->sstr.set_variable.value);
+  heap_query_destroy(query);
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
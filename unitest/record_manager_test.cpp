@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/common/record_manager.h"
+
+struct FetchResult {
+  std::vector<RID> rids;
+  std::vector<int> values;
+};
+
+static RC fetch_reader(Record *record, void *context) {
+  FetchResult *result = (FetchResult *)context;
+  result->rids.push_back(record->rid);
+  result->values.push_back(*(int *)record->data);
+  return RC::SUCCESS;
+}
+
+TEST(test_record_manager, test_get_records) {
+  std::string file_name = "./record_manager_test." + std::to_string(getpid()) + ".data";
+  DiskBufferPool *buffer_pool = theGlobalDiskBufferPool();
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->create_file(file_name.c_str()));
+  int file_id = -1;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->open_file(file_name.c_str(), &file_id));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*buffer_pool, file_id));
+
+  const int record_size = 1000;
+  const int record_num = 50;
+  char data[record_size] = {0};
+  std::vector<RID> rids(record_num);
+  for (int i = 0; i < record_num; i++) {
+    *(int *)data = i;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(data, record_size, &rids[i]));
+  }
+  ASSERT_NE(rids.front().page_num, rids.back().page_num);
+
+  // 模拟索引返回的乱序rid，取出来的记录按照rid排好序
+  std::vector<RID> shuffled;
+  for (int i = record_num - 1; i >= 0; i -= 2) {
+    shuffled.push_back(rids[i]);
+  }
+  FetchResult result;
+  ASSERT_EQ(RC::SUCCESS, file_handler.get_records(shuffled.data(), (int)shuffled.size(), &result, fetch_reader));
+  ASSERT_EQ(shuffled.size(), result.rids.size());
+  for (size_t i = 0; i < result.rids.size(); i++) {
+    const int value = result.values[i];
+    ASSERT_EQ(1, value % 2);
+    ASSERT_TRUE(rids[value] == result.rids[i]);
+    if (i > 0) {
+      ASSERT_LT(result.values[i - 1], value);
+    }
+  }
+
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[1]));
+  ASSERT_NE(RC::SUCCESS, file_handler.get_records(shuffled.data(), (int)shuffled.size(), &result, fetch_reader));
+
+  file_handler.close();
+  buffer_pool->close_file(file_id);
+  buffer_pool->drop_file(file_name.c_str());
+  unlink(file_name.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+
+#include <string.h>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "storage/common/condition_filter.h"
+#include "storage/common/record_manager.h"
+
+static ConDesc attr_desc(AttrType type) {
+  ConDesc desc;
+  desc.is_attr = true;
+  desc.attr_offset = 0;
+  desc.attr_length = 4;
+  desc.type = type;
+  return desc;
+}
+
+static bool filter_int(const DefaultConditionFilter &filter, int value) {
+  char data[8] = {0};
+  memcpy(data, &value, sizeof(value));
+  Record record;
+  record.data = data;
+  return filter.filter(record);
+}
+
+TEST(test_subquery_filter, test_in) {
+  TupleSet tuple_set;
+  for (int i = 0; i < 100; i += 2) {
+    Tuple tuple;
+    tuple.add(i);
+    tuple_set.add(std::move(tuple));
+  }
+
+  // 过滤器在init时把结果集转换成哈希集合，之后不再访问结果集
+  std::unique_ptr<TupleSet> owned(new TupleSet(std::move(tuple_set)));
+  DefaultConditionFilter in_filter;
+  DefaultConditionFilter not_in_filter;
+  ASSERT_EQ(RC::SUCCESS, in_filter.init(attr_desc(INTS), ConDesc(), INTS, IN, owned.get(), nullptr));
+  ASSERT_EQ(RC::SUCCESS, not_in_filter.init(attr_desc(INTS), ConDesc(), INTS, NOT_IN, owned.get(), nullptr));
+  owned.reset();
+
+  for (int i = -5; i < 105; i++) {
+    const bool member = i >= 0 && i < 100 && i % 2 == 0;
+    ASSERT_EQ(member, filter_int(in_filter, i)) << i;
+    ASSERT_EQ(!member, filter_int(not_in_filter, i)) << i;
+  }
+}
+
+TEST(test_subquery_filter, test_null_and_empty) {
+  TupleSet with_null;
+  Tuple tuple;
+  tuple.add(1);
+  with_null.add(std::move(tuple));
+  Tuple null_tuple;
+  null_tuple.add();
+  with_null.add(std::move(null_tuple));
+
+  // 结果集中有NULL时，NOT IN的结果不可能为真
+  DefaultConditionFilter filter;
+  ASSERT_EQ(RC::SUCCESS, filter.init(attr_desc(INTS), ConDesc(), INTS, NOT_IN, &with_null, nullptr));
+  ASSERT_FALSE(filter_int(filter, 1));
+  ASSERT_FALSE(filter_int(filter, 2));
+
+  TupleSet empty;
+  DefaultConditionFilter in_empty;
+  DefaultConditionFilter not_in_empty;
+  ASSERT_EQ(RC::SUCCESS, in_empty.init(attr_desc(INTS), ConDesc(), INTS, IN, &empty, nullptr));
+  ASSERT_EQ(RC::SUCCESS, not_in_empty.init(attr_desc(INTS), ConDesc(), INTS, NOT_IN, &empty, nullptr));
+  ASSERT_FALSE(filter_int(in_empty, 1));
+  ASSERT_TRUE(filter_int(not_in_empty, 1));
+}
+
+TEST(test_subquery_filter, test_scalar) {
+  TupleSet tuple_set;
+  Tuple tuple;
+  tuple.add(2.5f);
+  tuple_set.add(std::move(tuple));
+
+  DefaultConditionFilter filter;
+  ASSERT_EQ(RC::SUCCESS, filter.init(attr_desc(INTS), ConDesc(), INTS, GREAT_THAN, &tuple_set, nullptr));
+  ASSERT_FALSE(filter_int(filter, 2));
+  ASSERT_TRUE(filter_int(filter, 3));
+}
+
+TEST(test_subquery_filter, test_large_int) {
+  // 超过float精度的整数按float比较会被当成相等
+  TupleSet tuple_set;
+  Tuple tuple;
+  tuple.add(16777217);
+  tuple_set.add(std::move(tuple));
+
+  DefaultConditionFilter equal_filter;
+  DefaultConditionFilter in_filter;
+  ASSERT_EQ(RC::SUCCESS, equal_filter.init(attr_desc(INTS), ConDesc(), INTS, EQUAL_TO, &tuple_set, nullptr));
+  ASSERT_EQ(RC::SUCCESS, in_filter.init(attr_desc(INTS), ConDesc(), INTS, IN, &tuple_set, nullptr));
+  ASSERT_TRUE(filter_int(equal_filter, 16777217));
+  ASSERT_FALSE(filter_int(equal_filter, 16777216));
+  ASSERT_TRUE(filter_int(in_filter, 16777217));
+  ASSERT_FALSE(filter_int(in_filter, 16777216));
+  ASSERT_FALSE(filter_int(in_filter, 16777218));
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
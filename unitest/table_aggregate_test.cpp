@@ -0,0 +1,185 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/index.h"
+#include "storage/common/condition_filter.h"
+#include "storage/trx/trx.h"
+
+struct IntReader {
+  int offset;
+  int value = -1;
+  int calls = 0;
+};
+
+static void int_reader(const char *data, void *context) {
+  IntReader &reader = *(IntReader *)context;
+  memcpy(&reader.value, data + reader.offset, sizeof(int));
+  reader.calls++;
+}
+
+static int find_extreme(Table &table, Trx *trx, const char *field_name, bool max) {
+  IntReader reader;
+  reader.offset = table.table_meta().field(field_name)->offset();
+  EXPECT_EQ(RC::SUCCESS, table.find_extreme_record(trx, field_name, max, &reader, int_reader));
+  return reader.calls == 0 ? -1 : reader.value;
+}
+
+static int64_t count(Table &table, Trx *trx) {
+  int64_t count = -1;
+  EXPECT_EQ(RC::SUCCESS, table.count_record(trx, &count));
+  return count;
+}
+
+static void insert(Table &table, Trx *trx, int id, int v) {
+  Value values[2];
+  value_init_integer(&values[0], id);
+  value_init_integer(&values[1], v);
+  ASSERT_EQ(RC::SUCCESS, table.insert_record(trx, 2, values, 1));
+  value_destroy(&values[0]);
+  value_destroy(&values[1]);
+}
+
+static int index_lookup_num(Table &table, const char *field_name, int value) {
+  IndexScanner *scanner = table.create_index_scanner(field_name, EQUAL_TO, (const char *)&value);
+  if (scanner == nullptr) {
+    return -1;
+  }
+  int num = 0;
+  RID rid;
+  while (scanner->next_entry(&rid) == RC::SUCCESS) {
+    num++;
+  }
+  scanner->destroy();
+  return num;
+}
+
+class TableAggregateTest : public testing::Test {
+protected:
+  void SetUp() override {
+    base_dir_ = std::string("./table_aggregate_test.") + testing::UnitTest::GetInstance()->current_test_info()->name() +
+                "." + std::to_string(getpid());
+    ASSERT_EQ(0, mkdir(base_dir_.c_str(), 0755));
+    meta_file_ = base_dir_ + "/t.table";
+    AttrInfo attrs[2] = {};
+    attrs[0].name = (char *)"id";
+    attrs[0].type = INTS;
+    attrs[0].length = 4;
+    attrs[1].name = (char *)"v";
+    attrs[1].type = INTS;
+    attrs[1].length = 4;
+    ASSERT_EQ(RC::SUCCESS, table_.create(meta_file_.c_str(), "t", base_dir_.c_str(), 2, attrs));
+
+    char *id_field[] = {(char *)"id"};
+    char *v_field[] = {(char *)"v"};
+    ASSERT_EQ(RC::SUCCESS, table_.create_index(nullptr, "t_id", id_field, false, 1));
+    ASSERT_EQ(RC::SUCCESS, table_.create_index(nullptr, "t_v", v_field, false, 1));
+  }
+
+  void TearDown() override {
+    table_.drop(meta_file_.c_str(), "t", base_dir_.c_str());
+    // 删表时不会删除索引文件
+    unlink((base_dir_ + "/t-t_id.index").c_str());
+    unlink((base_dir_ + "/t-t_v.index").c_str());
+    rmdir(base_dir_.c_str());
+  }
+
+protected:
+  std::string base_dir_;
+  std::string meta_file_;
+  Table table_;
+};
+
+TEST_F(TableAggregateTest, test_count_visibility) {
+  Trx trx;
+  ASSERT_EQ(0, count(table_, &trx));
+  ASSERT_EQ(-1, find_extreme(table_, &trx, "id", false));
+
+  // 足够多的记录，占用多个数据页面和索引页面
+  const int record_num = 3000;
+  for (int i = 0; i < record_num; i++) {
+    insert(table_, &trx, (i * 7919) % record_num, i);
+  }
+  ASSERT_EQ(RC::SUCCESS, trx.commit());
+  ASSERT_EQ(record_num, count(table_, &trx));
+  ASSERT_EQ(record_num, count(table_, nullptr));
+  ASSERT_EQ(0, find_extreme(table_, &trx, "id", false));
+  ASSERT_EQ(record_num - 1, find_extreme(table_, &trx, "id", true));
+
+  // 未提交的插入只对自己可见
+  // 事务的第一条插入记录时还没有分配事务号，其它事务也能看到
+  Trx writer;
+  insert(table_, &writer, 1, 0);
+  insert(table_, &writer, record_num + 100, 0);
+  insert(table_, &writer, -100, 0);
+  ASSERT_EQ(record_num + 3, count(table_, &writer));
+  ASSERT_EQ(record_num + 100, find_extreme(table_, &writer, "id", true));
+  ASSERT_EQ(-100, find_extreme(table_, &writer, "id", false));
+  ASSERT_EQ(record_num + 1, count(table_, &trx));
+  ASSERT_EQ(record_num - 1, find_extreme(table_, &trx, "id", true));
+  ASSERT_EQ(0, find_extreme(table_, &trx, "id", false));
+  ASSERT_EQ(RC::SUCCESS, writer.rollback());
+  ASSERT_EQ(record_num, count(table_, &trx));
+
+  // 未提交的删除对其它事务仍然可见
+  int deleted_count = 0;
+  ASSERT_EQ(RC::SUCCESS, table_.delete_record(&writer, nullptr, &deleted_count));
+  ASSERT_EQ(record_num, deleted_count);
+  ASSERT_EQ(0, count(table_, &writer));
+  ASSERT_EQ(-1, find_extreme(table_, &writer, "id", true));
+  ASSERT_EQ(record_num, count(table_, &trx));
+  ASSERT_EQ(record_num - 1, find_extreme(table_, &trx, "id", true));
+  ASSERT_EQ(RC::SUCCESS, writer.commit());
+  ASSERT_EQ(0, count(table_, &trx));
+  ASSERT_EQ(-1, find_extreme(table_, &trx, "v", false));
+
+  // 没有单字段索引的字段
+  IntReader reader;
+  ASSERT_EQ(RC::SCHEMA_INDEX_NOT_EXIST, table_.find_extreme_record(&trx, "no_such_field", false, &reader, int_reader));
+}
+
+TEST_F(TableAggregateTest, test_update_index) {
+  for (int i = 0; i < 100; i++) {
+    insert(table_, nullptr, i, i * 10);
+  }
+  ASSERT_EQ(990, find_extreme(table_, nullptr, "v", true));
+
+  // 更新时删除旧的键，插入新的键。没有变化的索引不受影响
+  int value = 5000;
+  ConDesc update_desc;
+  update_desc.attr_length = 4;
+  update_desc.attr_offset = table_.table_meta().field("v")->offset();
+  update_desc.value = &value;
+  int updated_count = 0;
+  ASSERT_EQ(RC::SUCCESS, table_.update_record(nullptr, nullptr, &update_desc, &updated_count));
+  ASSERT_EQ(100, updated_count);
+  ASSERT_EQ(100, index_lookup_num(table_, "v", 5000));
+  ASSERT_EQ(0, index_lookup_num(table_, "v", 990));
+  ASSERT_EQ(1, index_lookup_num(table_, "id", 99));
+  ASSERT_EQ(5000, find_extreme(table_, nullptr, "v", true));
+  ASSERT_EQ(5000, find_extreme(table_, nullptr, "v", false));
+  ASSERT_EQ(99, find_extreme(table_, nullptr, "id", true));
+  ASSERT_EQ(100, count(table_, nullptr));
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/table_stats.h"
+
+TEST(test_table_stats, test_hyper_log_log) {
+  for (int num : {10, 1000, 100000}) {
+    HyperLogLog hll;
+    for (int i = 0; i < num; i++) {
+      hll.add((const char *)&i, sizeof(i));
+      hll.add((const char *)&i, sizeof(i));
+    }
+    ASSERT_NEAR(num, hll.estimate(), num * 0.05 + 1);
+  }
+
+  HyperLogLog left;
+  HyperLogLog right;
+  for (int i = 0; i < 5000; i++) {
+    left.add((const char *)&i, sizeof(i));
+    const int other = i + 2500;
+    right.add((const char *)&other, sizeof(other));
+  }
+  left.merge(right);
+  ASSERT_NEAR(7500, left.estimate(), 7500 * 0.05);
+}
+
+TEST(test_table_stats, test_table_analyze) {
+  std::string base_dir = "./table_stats_test." + std::to_string(getpid());
+  ASSERT_EQ(0, mkdir(base_dir.c_str(), 0755));
+  std::string meta_file = base_dir + "/t.table";
+
+  {
+    AttrInfo attrs[2] = {};
+    attrs[0].name = (char *)"id";
+    attrs[0].type = INTS;
+    attrs[0].length = 4;
+    attrs[1].name = (char *)"val";
+    attrs[1].type = INTS;
+    attrs[1].length = 4;
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.create(meta_file.c_str(), "t", base_dir.c_str(), 2, attrs));
+    ASSERT_EQ(nullptr, table.stats());
+    ASSERT_TRUE(table.stats_stale(10));
+
+    const int record_num = 3000;
+    for (int i = 0; i < record_num; i++) {
+      Value values[2];
+      value_init_integer(&values[0], i);
+      value_init_integer(&values[1], i % 10);
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+      value_destroy(&values[0]);
+      value_destroy(&values[1]);
+    }
+
+    ASSERT_EQ(RC::SUCCESS, table.analyze());
+    std::shared_ptr<const TableStats> stats = table.stats();
+    ASSERT_NE(nullptr, stats);
+    ASSERT_EQ(record_num, stats->row_count);
+    ASSERT_FALSE(table.stats_stale(10));
+
+    const ColumnStats *id = stats->column("id");
+    const ColumnStats *val = stats->column("val");
+    ASSERT_NE(nullptr, id);
+    ASSERT_NE(nullptr, val);
+    ASSERT_NEAR(record_num, id->ndv, record_num * 0.05);
+    ASSERT_NEAR(10, val->ndv, 1);
+    ASSERT_EQ(0, id->null_fraction);
+
+    // 等深直方图估算范围条件的选择率
+    const FieldMeta *id_field = table.table_meta().field("id");
+    Value value;
+    value_init_integer(&value, 300);
+    ASSERT_NEAR(0.1, id->selectivity(*id_field, LESS_THAN, value), 0.02);
+    ASSERT_NEAR(0.9, id->selectivity(*id_field, GREAT_EQUAL, value), 0.02);
+    ASSERT_NEAR(1.0 / record_num, id->selectivity(*id_field, EQUAL_TO, value), 0.0001);
+    value_destroy(&value);
+
+    // 序列化之后可以原样恢复
+    std::stringstream ss;
+    ASSERT_GT(stats->serialize(ss), 0);
+    TableStats copy;
+    ASSERT_EQ(0, copy.deserialize(ss));
+    ASSERT_EQ(stats->row_count, copy.row_count);
+    ASSERT_EQ(stats->page_count, copy.page_count);
+    ASSERT_EQ(id->histogram, copy.column("id")->histogram);
+    ASSERT_DOUBLE_EQ(val->ndv, copy.column("val")->ndv);
+
+    // 修改超过阈值比例的记录后统计信息过期
+    for (int i = 0; i < record_num / 5; i++) {
+      Value values[2];
+      value_init_integer(&values[0], record_num + i);
+      value_init_integer(&values[1], 0);
+      ASSERT_EQ(RC::SUCCESS, table.insert_record(nullptr, 2, values, 1));
+      value_destroy(&values[0]);
+      value_destroy(&values[1]);
+    }
+    ASSERT_TRUE(table.stats_stale(10));
+    ASSERT_FALSE(table.stats_stale(50));
+    ASSERT_EQ(RC::SUCCESS, table.sync());
+  }
+
+  {
+    // 重新打开表时加载统计信息文件
+    Table table;
+    ASSERT_EQ(RC::SUCCESS, table.open("t.table", base_dir.c_str()));
+    ASSERT_NE(nullptr, table.stats());
+    ASSERT_EQ(3000, table.stats()->row_count);
+    table.drop(meta_file.c_str(), "t", base_dir.c_str());
+  }
+  ASSERT_NE(0, access((base_dir + "/t.stats").c_str(), F_OK));
+  rmdir(base_dir.c_str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
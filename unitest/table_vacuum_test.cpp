@@ -0,0 +1,196 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/common/table.h"
+#include "storage/common/record_manager.h"
+#include "storage/default/disk_buffer_pool.h"
+
+// 删除id不是4的倍数的记录
+class ModFilter : public ConditionFilter {
+public:
+  explicit ModFilter(int offset) : offset_(offset) {}
+  bool filter(const Record &rec) const override {
+    return *(int *)(rec.data + offset_) % 4 != 0;
+  }
+  bool filter(const TupleSchema &schema, const Tuple &tuple) const override {
+    return false;
+  }
+private:
+  int offset_;
+};
+
+struct ScanResult {
+  int offset;
+  int count;
+  long sum;
+};
+
+static void scan_reader(const char *data, void *context) {
+  ScanResult *result = (ScanResult *)context;
+  result->count++;
+  result->sum += *(int *)(data + result->offset);
+}
+
+/**
+ * 创建一张有400条记录的表，删掉id不是4的倍数的记录，剩下的页面都是稀疏的
+ */
+class TableVacuumTest : public testing::Test {
+protected:
+  void SetUp() override {
+    base_dir_ = std::string("./table_vacuum_test.") + testing::UnitTest::GetInstance()->current_test_info()->name() +
+                "." + std::to_string(getpid());
+    ASSERT_EQ(0, mkdir(base_dir_.c_str(), 0755));
+    meta_file_ = base_dir_ + "/t.table";
+
+    AttrInfo attrs[2] = {};
+    attrs[0].name = (char *)"id";
+    attrs[0].type = INTS;
+    attrs[0].length = 4;
+    attrs[1].name = (char *)"pad";
+    attrs[1].type = CHARS;
+    attrs[1].length = 200;
+    ASSERT_EQ(RC::SUCCESS, table_.create(meta_file_.c_str(), "t", base_dir_.c_str(), 2, attrs));
+
+    for (int i = 0; i < record_num; i++) {
+      Value values[2];
+      value_init_integer(&values[0], i);
+      value_init_string(&values[1], "pad");
+      ASSERT_EQ(RC::SUCCESS, table_.insert_record(nullptr, 2, values, 1));
+      value_destroy(&values[0]);
+      value_destroy(&values[1]);
+      if (i % 4 == 0) {
+        expect_sum_ += i;
+      }
+    }
+
+    id_offset_ = table_.table_meta().field("id")->offset();
+    ModFilter filter(id_offset_);
+    int deleted_count = 0;
+    ASSERT_EQ(RC::SUCCESS, table_.delete_record(nullptr, &filter, &deleted_count));
+  }
+
+  void TearDown() override {
+    table_.drop(meta_file_.c_str(), "t", base_dir_.c_str());
+    unlink((base_dir_ + "/t-t_id.index").c_str());
+    rmdir(base_dir_.c_str());
+  }
+
+  void check_records() {
+    ScanResult result{id_offset_, 0, 0};
+    ASSERT_EQ(RC::SUCCESS, table_.scan_record(nullptr, nullptr, -1, &result, scan_reader));
+    ASSERT_EQ(record_num / 4, result.count);
+    ASSERT_EQ(expect_sum_, result.sum);
+  }
+
+protected:
+  static const int record_num = 400;
+  std::string base_dir_;
+  std::string meta_file_;
+  Table table_;
+  int id_offset_ = 0;
+  long expect_sum_ = 0;
+};
+
+TEST_F(TableVacuumTest, test_table_vacuum) {
+  Table &table = table_;
+
+  int page_budget = 100;
+  VacuumStat stat;
+  ASSERT_EQ(RC::SUCCESS, table.vacuum(50, page_budget, stat));
+  ASSERT_GT(stat.pages_released, 0);
+  ASSERT_GT(stat.records_moved, 0);
+  ASSERT_EQ(stat.pages_released * (long)BP_PAGE_SIZE, stat.bytes_reclaimed);
+
+  check_records();
+
+  // 页面都已经足够满，再回收一次不会有变化
+  page_budget = 100;
+  VacuumStat stat2;
+  ASSERT_EQ(RC::SUCCESS, table.vacuum(50, page_budget, stat2));
+  ASSERT_EQ(0, stat2.records_moved);
+}
+
+TEST_F(TableVacuumTest, test_vacuum_with_index) {
+  char *attribute_names[] = {(char *)"id"};
+  ASSERT_EQ(RC::SUCCESS, table_.create_index(nullptr, "t_id", attribute_names, true, 1));
+
+  // 每轮的预算很小，统计和搬迁分多轮完成
+  VacuumStat stat;
+  int page_budget = 4;
+  ASSERT_EQ(RC::SUCCESS, table_.vacuum(50, page_budget, stat));
+  ASSERT_EQ(0, page_budget);
+  for (int round = 0; round < 100; round++) {
+    page_budget = 4;
+    ASSERT_EQ(RC::SUCCESS, table_.vacuum(50, page_budget, stat));
+  }
+  ASSERT_GT(stat.pages_released, 0);
+  ASSERT_GT(stat.records_moved, 0);
+  check_records();
+
+  // 搬迁后的记录在唯一索引中仍然存在，删掉的记录在索引中也不存在
+  for (int i = 0; i < record_num; i++) {
+    Value values[2];
+    value_init_integer(&values[0], i);
+    value_init_string(&values[1], "pad");
+    RC rc = table_.insert_record(nullptr, 2, values, 1);
+    value_destroy(&values[0]);
+    value_destroy(&values[1]);
+    if (i % 4 == 0) {
+      ASSERT_NE(RC::SUCCESS, rc);
+    } else {
+      ASSERT_EQ(RC::SUCCESS, rc);
+    }
+  }
+}
+
+struct VacuumInScanContext {
+  Table *table;
+  int count;
+  int records_moved;
+};
+
+static void vacuum_in_scan_reader(const char *data, void *context) {
+  VacuumInScanContext *ctx = (VacuumInScanContext *)context;
+  if (ctx->count++ == 0) {
+    int page_budget = 100;
+    VacuumStat stat;
+    ctx->table->vacuum(50, page_budget, stat);
+    ctx->records_moved = stat.records_moved;
+  }
+}
+
+TEST_F(TableVacuumTest, test_vacuum_skip_table_in_use) {
+  // 扫描期间表的共享闩被持有，vacuum跳过这张表，扫描不会漏掉或者重复读到记录
+  VacuumInScanContext context{&table_, 0, -1};
+  ASSERT_EQ(RC::SUCCESS, table_.scan_record(nullptr, nullptr, -1, &context, vacuum_in_scan_reader));
+  ASSERT_EQ(0, context.records_moved);
+  ASSERT_EQ(record_num / 4, context.count);
+
+  int page_budget = 100;
+  VacuumStat stat;
+  ASSERT_EQ(RC::SUCCESS, table_.vacuum(50, page_budget, stat));
+  ASSERT_GT(stat.records_moved, 0);
+  check_records();
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
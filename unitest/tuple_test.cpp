@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql/executor/tuple.h"
+
+TEST(test_tuple, test_values) {
+  Tuple tuple;
+  tuple.add(10);
+  tuple.add(1.5f);
+  tuple.add("hello", 5);
+  tuple.add();
+  ASSERT_EQ(4, tuple.size());
+
+  ASSERT_EQ(INTS, tuple.get(0).type());
+  ASSERT_EQ(10, tuple.get(0).int_value());
+  ASSERT_EQ(FLOATS, tuple.get(1).type());
+  ASSERT_FLOAT_EQ(1.5f, tuple.get(1).float_value());
+  ASSERT_EQ(CHARS, tuple.get(2).type());
+  ASSERT_EQ("hello", tuple.get(2).to_string());
+  ASSERT_EQ(5, tuple.get(2).length());
+  ASSERT_EQ(IS_NULL, tuple.get(3).type());
+  ASSERT_EQ("NULL", tuple.get(3).to_string());
+
+  std::stringstream ss;
+  tuple.get(1).to_string(ss);
+  ss << "|";
+  tuple.get(2).to_string(ss);
+  ASSERT_EQ("1.5|hello", ss.str());
+
+  // 整数和浮点数之间按数值比较
+  ASSERT_LT(tuple.get(0).compare(TupleValue(11)), 0);
+  ASSERT_GT(tuple.get(0).compare(TupleValue(9.5f)), 0);
+  ASSERT_EQ(0, tuple.get(1).compare(TupleValue(1.5f)));
+  ASSERT_LT(tuple.get(2).compare(TupleValue("world", 5)), 0);
+}
+
+TEST(test_tuple, test_copy_and_append) {
+  Tuple left;
+  left.add("abc", 3);
+  left.add(1);
+  Tuple right;
+  right.add(2);
+  right.add("defg", 4);
+  right.add();
+
+  // 复制之后与原来的元组互不影响
+  Tuple out(left);
+  out.append(right);
+  left.clear();
+  left.add("xyz", 3);
+  ASSERT_EQ(5, out.size());
+  ASSERT_EQ("abc", out.get(0).to_string());
+  ASSERT_EQ(1, out.get(1).int_value());
+  ASSERT_EQ(2, out.get(2).int_value());
+  ASSERT_EQ("defg", out.get(3).to_string());
+  ASSERT_EQ(IS_NULL, out.get(4).type());
+
+  Tuple moved(std::move(out));
+  ASSERT_EQ("defg", moved.get(3).to_string());
+
+  Tuple values;
+  for (int i = 0; i < moved.size(); i++) {
+    values.add(moved.get(i));
+  }
+  for (int i = 0; i < moved.size(); i++) {
+    ASSERT_EQ(moved.get(i).to_string(), values.get(i).to_string());
+  }
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
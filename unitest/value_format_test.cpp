@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 Xie Meiyi(xiemeiyi@hust.edu.cn) and OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql/executor/value_format.h"
+#include "sql/executor/tuple.h"
+
+static std::string int_string(int value) {
+  char buf[INT_FORMAT_SIZE];
+  return std::string(buf, format_int(value, buf));
+}
+
+static std::string float_string(float value) {
+  char buf[FLOAT_FORMAT_SIZE];
+  return std::string(buf, format_float(value, buf));
+}
+
+/**
+ * 原来通过ostream输出浮点数的结果
+ */
+static std::string ostream_float_string(float value) {
+  std::string str = std::to_string(value);
+  size_t dot_pos = str.find('.');
+  if (dot_pos == std::string::npos) {
+    return str;
+  }
+  std::ostringstream os;
+  os << std::setprecision(dot_pos + 2) << value;
+  return os.str();
+}
+
+TEST(test_value_format, test_int) {
+  ASSERT_EQ("0", int_string(0));
+  ASSERT_EQ("7", int_string(7));
+  ASSERT_EQ("-7", int_string(-7));
+  ASSERT_EQ("10", int_string(10));
+  ASSERT_EQ("100", int_string(100));
+  ASSERT_EQ("-12345", int_string(-12345));
+  ASSERT_EQ("2147483647", int_string(INT_MAX));
+  ASSERT_EQ("-2147483648", int_string(INT_MIN));
+  for (int i = -100000; i <= 100000; i += 7) {
+    ASSERT_EQ(std::to_string(i), int_string(i));
+  }
+}
+
+TEST(test_value_format, test_float) {
+  ASSERT_EQ("0", float_string(0.0f));
+  ASSERT_EQ("-0", float_string(-0.0f));
+  ASSERT_EQ("1", float_string(1.0f));
+  ASSERT_EQ("3.5", float_string(3.5f));
+  ASSERT_EQ("12.35", float_string(12.345f));
+  ASSERT_EQ("-1.5", float_string(-1.5f));
+  ASSERT_EQ("0.123", float_string(0.1234f));
+  ASSERT_EQ("100", float_string(99.999f));
+  ASSERT_EQ("1234567", float_string(1234567.0f));
+  ASSERT_EQ("inf", float_string(INFINITY));
+
+  // 舍入、进位、很大和很小的值都与原来的输出相同
+  const float values[] = {0.005f, 0.015f, 0.125f, 2.675f, 9.995f, 0.9995f, 0.00123f, 0.000123f, 1e-30f,
+                          123456.78f, 999999.99f, 1e9f, 3.4e38f, -0.0005f, -0.25f, -999.995f};
+  for (float value : values) {
+    ASSERT_EQ(ostream_float_string(value), float_string(value)) << value;
+    ASSERT_EQ(ostream_float_string(-value), float_string(-value)) << value;
+  }
+  for (int i = -200000; i <= 200000; i++) {
+    const float value = i / 100.0f;
+    ASSERT_EQ(ostream_float_string(value), float_string(value)) << value;
+  }
+  for (uint32_t bits = 0; bits < 0xFF800000U; bits += 999983) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    ASSERT_EQ(ostream_float_string(value), float_string(value)) << value;
+  }
+}
+
+TEST(test_value_format, test_date) {
+  char buf[DATE_FORMAT_SIZE];
+  ASSERT_EQ(DATE_FORMAT_SIZE, format_date(20210514, buf));
+  ASSERT_EQ("2021-05-14", std::string(buf, DATE_FORMAT_SIZE));
+  format_date(19700101, buf);
+  ASSERT_EQ("1970-01-01", std::string(buf, DATE_FORMAT_SIZE));
+}
+
+TEST(test_value_format, test_print_tuple) {
+  TupleSchema schema;
+  schema.add(INTS, "t", "id");
+  schema.add(FLOATS, "t", "score");
+  schema.add(CHARS, "t", "name");
+  TupleSet tuple_set;
+  tuple_set.set_schema(schema);
+  Tuple tuple;
+  tuple.add(-3);
+  tuple.add(2.5f);
+  tuple.add("abc", 3);
+  tuple_set.add(std::move(tuple));
+  Tuple null_tuple;
+  null_tuple.add(4);
+  null_tuple.add();
+  null_tuple.add("", 0);
+  tuple_set.add(std::move(null_tuple));
+
+  std::ostringstream os;
+  tuple_set.print_tuple(os);
+  ASSERT_EQ("-3 | 2.5 | abc\n4 | NULL | \n", os.str());
+}
+
+int main(int argc, char **argv) {
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}